@@ -0,0 +1,158 @@
+class_name LookaheadPacket
+extends RefCounted
+
+## Reader for MultiBiomeLookaheadEngine.evolve_all_lookahead_binary packets.
+##
+## Fields are read by byte offset from the section table, so per-frame access
+## costs no Dictionary key hashing:
+##   var packet := LookaheadPacket.open(engine.evolve_all_lookahead_binary([], 5, 0.1, 0.02))
+##   if packet: var p1 := packet.population(biome_id, step, qubit)
+##
+## Section ids and element types mirror MultiBiomeLookaheadEngine.PacketSection
+## and PacketType (native/src/multi_biome_lookahead_engine.h).
+
+const MAGIC := 0x504C5753  # "SWLP"
+const VERSION := 1
+const HEADER_BYTES := 32
+const ENTRY_BYTES := 24
+
+enum Section {
+	STEP_COUNTS, RHO_OFFSETS, RHO, MI_OFFSETS, MI, BLOCH_OFFSETS, BLOCH, PURITY,
+	NODE_OFFSETS, POSITIONS, VELOCITIES, RHO_DELTA_OFFSETS, RHO_DELTAS, RHO_DELTA_SCALES,
+}
+enum DType { I32, I64, F32, F64, I16 }
+
+const _SECTION_COUNT := 14
+const _TYPE_SIZE := [4, 8, 4, 8, 2]
+
+var bytes: PackedByteArray
+var num_biomes := 0
+var steps := 0
+
+# Per Section id: byte offset (-1 if absent), element type, element count
+var _offset := PackedInt64Array()
+var _dtype := PackedInt32Array()
+var _count := PackedInt64Array()
+
+
+## Parse the header; null if the packet is not a supported version.
+static func open(packet: PackedByteArray) -> LookaheadPacket:
+	if packet.size() < HEADER_BYTES or packet.decode_u32(0) != MAGIC or packet.decode_u32(4) != VERSION:
+		return null
+	var reader := LookaheadPacket.new()
+	reader.bytes = packet
+	reader.num_biomes = packet.decode_u32(8)
+	reader.steps = packet.decode_u32(12)
+	reader._offset.resize(_SECTION_COUNT)
+	reader._offset.fill(-1)
+	reader._dtype.resize(_SECTION_COUNT)
+	reader._count.resize(_SECTION_COUNT)
+	var section_count := packet.decode_u32(16)
+	if packet.size() < HEADER_BYTES + ENTRY_BYTES * section_count:
+		return null
+	for i in section_count:
+		var entry := HEADER_BYTES + ENTRY_BYTES * i
+		var id := packet.decode_u32(entry)
+		if id >= _SECTION_COUNT:
+			continue  # Newer section this reader doesn't know
+		reader._dtype[id] = packet.decode_u32(entry + 4)
+		reader._count[id] = packet.decode_u64(entry + 8)
+		reader._offset[id] = packet.decode_u64(entry + 16)
+	return reader
+
+
+func has_section(section: int) -> bool:
+	return _offset[section] >= 0
+
+
+## Steps actually produced for a biome (0 if inactive).
+func step_count(biome_id: int) -> int:
+	if biome_id < 0 or biome_id >= num_biomes:
+		return 0
+	return bytes.decode_s32(_offset[Section.STEP_COUNTS] + 4 * biome_id)
+
+
+## Dense ρ of one step; empty if the storage policy dropped or delta-encoded it.
+func rho(biome_id: int, step: int) -> PackedFloat64Array:
+	return _slice(Section.RHO, Section.RHO_OFFSETS, biome_id, step).to_float64_array()
+
+
+## [p0,p1,x,y,z,r,theta,phi] per qubit.
+func bloch(biome_id: int, step: int) -> PackedFloat64Array:
+	return _to_float64(Section.BLOCH, _slice(Section.BLOCH, Section.BLOCH_OFFSETS, biome_id, step))
+
+
+func mutual_information(biome_id: int, step: int) -> PackedFloat64Array:
+	return _to_float64(Section.MI, _slice(Section.MI, Section.MI_OFFSETS, biome_id, step))
+
+
+func purity(biome_id: int, step: int) -> float:
+	return _read_float(Section.PURITY, biome_id * steps + step)
+
+
+## P(|1⟩) of a qubit without materializing the Bloch packet.
+func population(biome_id: int, step: int, qubit: int) -> float:
+	var begin := _entry_begin(Section.BLOCH_OFFSETS, biome_id, step)
+	if begin < 0 or 8 * qubit + 1 >= _entry_begin(Section.BLOCH_OFFSETS, biome_id, step + 1) - begin:
+		return 0.0
+	return _read_float(Section.BLOCH, begin + 8 * qubit + 1)
+
+
+func positions(biome_id: int, step: int) -> PackedVector2Array:
+	return _to_vector2(_slice_nodes(Section.POSITIONS, biome_id, step))
+
+
+func velocities(biome_id: int, step: int) -> PackedVector2Array:
+	return _to_vector2(_slice_nodes(Section.VELOCITIES, biome_id, step))
+
+
+# --- internals ---------------------------------------------------------------
+
+func _entry_begin(offsets_section: int, biome_id: int, step: int) -> int:
+	if _offset[offsets_section] < 0 or biome_id < 0 or biome_id >= num_biomes or step < 0 or step > steps:
+		return -1
+	return bytes.decode_s64(_offset[offsets_section] + 8 * (biome_id * steps + step))
+
+
+func _slice(data_section: int, offsets_section: int, biome_id: int, step: int) -> PackedByteArray:
+	if step >= steps or _offset[data_section] < 0:
+		return PackedByteArray()
+	var begin := _entry_begin(offsets_section, biome_id, step)
+	if begin < 0:
+		return PackedByteArray()
+	var end := _entry_begin(offsets_section, biome_id, step + 1)
+	var size: int = _TYPE_SIZE[_dtype[data_section]]
+	return bytes.slice(_offset[data_section] + size * begin, _offset[data_section] + size * end)
+
+
+func _slice_nodes(data_section: int, biome_id: int, step: int) -> PackedByteArray:
+	if step >= steps or _offset[data_section] < 0:
+		return PackedByteArray()
+	var begin := _entry_begin(Section.NODE_OFFSETS, biome_id, step)
+	if begin < 0:
+		return PackedByteArray()
+	var end := _entry_begin(Section.NODE_OFFSETS, biome_id, step + 1)
+	return bytes.slice(_offset[data_section] + 8 * begin, _offset[data_section] + 8 * end)
+
+
+func _read_float(section: int, index: int) -> float:
+	if _offset[section] < 0 or index < 0 or index >= _count[section]:
+		return 0.0
+	if _dtype[section] == DType.F32:
+		return bytes.decode_float(_offset[section] + 4 * index)
+	return bytes.decode_double(_offset[section] + 8 * index)
+
+
+func _to_float64(section: int, raw: PackedByteArray) -> PackedFloat64Array:
+	if _dtype[section] == DType.F32:
+		return PackedFloat64Array(raw.to_float32_array())
+	return raw.to_float64_array()
+
+
+func _to_vector2(raw: PackedByteArray) -> PackedVector2Array:
+	var xy := raw.to_float32_array()
+	var out := PackedVector2Array()
+	out.resize(xy.size() / 2)
+	for i in out.size():
+		out[i] = Vector2(xy[2 * i], xy[2 * i + 1])
+	return out
@@ -0,0 +1,965 @@
+/**
+ * native_bench - Headless benchmark of the Godot-free native cores
+ *
+ * Links only the pure C++ kernels (lindblad_core, partial traces, the LNN,
+ * the SIMD kernel tables and the shared thread pool), so performance work
+ * can be measured and profiled without launching Godot:
+ *
+ *   make bench && ./bin/native_bench [--filter <substr>] [--min-ms <ms>] [--isa baseline|avx2|avx512]
+ *
+ * Each case runs in batches until --min-ms has elapsed; the report is the
+ * best batch mean in ns per call.
+ *
+ * The workloads are a fixed set of reference biomes (synthetic 3-10 qubit
+ * chains and the shapes of the game's heaviest biomes). After timing, each
+ * biome's evolved rho, pairwise MI and Bloch vectors are checked against
+ * bench/golden/reference_biomes.txt (--tol, default 1e-9 absolute) and the
+ * exit status is non-zero on a mismatch, so a faster kernel can be accepted
+ * only if it reproduces them. --write-golden regenerates the file after an
+ * intentional numerical change.
+ *
+ * The parity/ cases run each native kernel next to a scalar reference that
+ * follows the game's GDScript fallback algorithm (dense loop products for
+ * evolution, per-row dot products for the selector, element loops for the
+ * LNN) on the same generated inputs. Each reports both timings and the
+ * speedup, and fails the run when the outputs differ by more than the case's
+ * tolerance or the speedup drops below --min-speedup (default 1), so a
+ * regression in either path is caught.
+ *
+ * lindblad/dopri5_attempt_limit runs the adaptive integrator with an attempt
+ * cap it cannot meet and fails the run unless the early stop is reported.
+ */
+
+#include "../src/lindblad_core.h"
+#include "../src/liquid_neural_net.h"
+#include "../src/native_thread_pool.h"
+#include "../src/operator_registry.h"
+#include "../src/simd_dispatch.h"
+#include "../src/trace_zones.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace godot;
+
+namespace {
+
+typedef lindblad::RhoMatrix RhoMatrix;
+typedef lindblad::SparseCM SparseCM;
+typedef std::complex<double> cd;
+
+struct Options {
+    std::string filter;
+    double min_ms = 200.0;
+    std::string golden_path = "bench/golden/reference_biomes.txt";
+    double tolerance = 1e-9;
+    bool write_golden = false;
+    double min_speedup = 1.0;  // Parity cases fail below this native/reference ratio
+    std::string trace_path;  // Chrome trace of the run (make bench TRACE=1)
+};
+
+// Best batch mean over batches of fn(), ns per call
+double time_ns(const std::function<void()>& fn, double min_ms) {
+    using clock = std::chrono::steady_clock;
+    fn();  // Warm caches and lazily built tables
+    int batch = 1;
+    double best = 0.0;
+    double total_ms = 0.0;
+    bool first = true;
+    while (total_ms < min_ms) {
+        const auto start = clock::now();
+        for (int i = 0; i < batch; i++) {
+            fn();
+        }
+        const double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        total_ms += ns * 1e-6;
+        const double mean = ns / batch;
+        if (first || mean < best) {
+            best = mean;
+            first = false;
+        }
+        if (ns < 1e6) {
+            batch *= 2;  // Grow batches until they are long enough to time
+        }
+    }
+    return best;
+}
+
+void report(const Options& options, const std::string& name, const std::function<void()>& fn) {
+    if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+        return;
+    }
+    NATIVE_TRACE_ZONE("bench_case");
+    const double ns = time_ns(fn, options.min_ms);
+    std::printf("%-40s %14.1f ns/call\n", name.c_str(), ns);
+    std::fflush(stdout);
+}
+
+// σ on one qubit of an n-qubit register (qubit q = basis bit q)
+SparseCM embed(const Eigen::Matrix2cd& op, int qubit, int n) {
+    const int dim = 1 << n;
+    std::vector<Eigen::Triplet<cd>> triplets;
+    for (int i = 0; i < dim; i++) {
+        const int bit = (i >> qubit) & 1;
+        for (int b = 0; b < 2; b++) {
+            const cd v = op(b, bit);
+            if (v != cd(0.0, 0.0)) {
+                triplets.emplace_back((i & ~(1 << qubit)) | (b << qubit), i, v);
+            }
+        }
+    }
+    SparseCM m(dim, dim);
+    m.setFromTriplets(triplets.begin(), triplets.end());
+    m.makeCompressed();
+    return m;
+}
+
+// Deterministic generator (std distributions differ between standard
+// libraries, and the golden file must not)
+struct SplitMix {
+    uint64_t state;
+    explicit SplitMix(uint64_t seed) : state(seed) {}
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    double uniform() { return (next() >> 11) * (2.0 / 9007199254740992.0) - 1.0; }  // [-1, 1)
+};
+
+// Reference workload: transverse-field chain plus num_lindblads jump
+// operators cycling through decay, dephasing and neighbour transfer
+struct BiomeSpec {
+    const char* name;
+    int num_qubits;
+    int num_lindblads;  // <= 0: decay + dephasing on every qubit
+};
+
+const BiomeSpec REFERENCE_BIOMES[] = {
+    {"synthetic_3q", 3, 0},
+    {"synthetic_5q", 5, 0},
+    {"synthetic_6q", 6, 0},
+    {"synthetic_8q", 8, 0},
+    {"synthetic_10q", 10, 0},
+    // Shapes from the per-biome table in CPP_OPTIMIZATION_REPORT.md
+    {"TidalPools", 6, 7},
+    {"CyberDebtMegacity", 5, 9},
+    {"FungalNetworks", 4, 5},
+    {"StellarForges", 3, 2},
+    {"VolcanicWorlds", 3, 5},
+    {"BioticFlux", 3, 6},
+};
+
+struct Biome {
+    BiomeSpec spec;
+    SparseCM heff;
+    OperatorForm heff_form;  // The engine's pick for H_eff·ρ
+    std::vector<lindblad::LocalOperator> no_locals;
+    std::vector<std::shared_ptr<const SharedLindblad>> lindblads;
+    RhoMatrix rho;
+    RhoMatrix drho;
+    RhoMatrix temp;
+
+    explicit Biome(const BiomeSpec& s) : spec(s) {
+        const int n = spec.num_qubits;
+        const int dim = 1 << n;
+        Eigen::Matrix2cd sx, sz, sm, sp;
+        sx << 0, 1, 1, 0;
+        sz << 1, 0, 0, -1;
+        sm << 0, 1, 0, 0;
+        sp << 0, 0, 1, 0;
+
+        SparseCM H(dim, dim);
+        for (int q = 0; q < n; q++) {
+            H += (0.5 + 0.1 * q) * embed(sz, q, n);
+            H += 0.3 * embed(sx, q, n);
+            if (q + 1 < n) {
+                const SparseCM zz = embed(sz, q, n) * embed(sz, q + 1, n);
+                H += 0.2 * zz;
+            }
+        }
+
+        std::vector<SparseCM> jumps;
+        if (spec.num_lindblads <= 0) {
+            for (int q = 0; q < n; q++) {
+                jumps.push_back(std::sqrt(0.05) * embed(sm, q, n));
+                jumps.push_back(std::sqrt(0.02) * embed(sz, q, n));
+            }
+        } else {
+            for (int k = 0; k < spec.num_lindblads; k++) {
+                const int q = k % n;
+                const int r = (k + 1) % n;
+                const double rate = 0.01 * (1 + k % 4);
+                if (k % 3 == 0) {
+                    jumps.push_back(std::sqrt(rate) * embed(sm, q, n));
+                } else if (k % 3 == 1) {
+                    jumps.push_back(std::sqrt(rate) * embed(sz, r, n));
+                } else {
+                    const SparseCM transfer = embed(sp, q, n) * embed(sm, r, n);
+                    jumps.push_back(std::sqrt(rate) * transfer);
+                }
+            }
+        }
+        SparseCM anti(dim, dim);
+        for (SparseCM& L : jumps) {
+            L.makeCompressed();
+            lindblads.push_back(OperatorRegistry::intern(L));
+            anti += lindblads.back()->LdagL;
+        }
+        heff = H - cd(0.0, 0.5) * anti;
+        heff.makeCompressed();
+        heff_form = OperatorForm::build(heff, true);
+
+        // Mixed start state A·A† / Tr with coherences everywhere
+        SplitMix rng(1234 + 31 * n + spec.num_lindblads);
+        Eigen::MatrixXcd A(dim, dim);
+        for (int i = 0; i < dim; i++) {
+            for (int j = 0; j < dim; j++) {
+                const double re = rng.uniform();
+                A(i, j) = cd(re, rng.uniform());
+            }
+        }
+        Eigen::MatrixXcd P = A * A.adjoint();
+        P /= P.trace().real();
+        rho = P;
+        drho = RhoMatrix::Zero(dim, dim);
+        temp = RhoMatrix::Zero(dim, dim);
+    }
+
+    lindblad::Generator generator() const {
+        lindblad::Generator gen;
+        gen.heff = &heff;
+        gen.heff_form = &heff_form;
+        gen.local_heff = &no_locals;
+        gen.lindblads = &lindblads;
+        gen.local_lindblads = &no_locals;
+        return gen;
+    }
+};
+
+// I(p:q) = max(S(p) + S(q) - S(pq), 0) per bit pair (p < q, pair_index
+// order), from one reduction sweep
+void mutual_information(const lindblad::ReducedStates& states, double* out) {
+    const int n = states.num_bits;
+    double singles[32];
+    for (int p = 0; p < n; p++) {
+        double lambda[2];
+        lindblad::hermitian_eigenvalues_2x2(states.singles[p], lambda);
+        singles[p] = lindblad::entropy_from_eigenvalues(lambda, 2);
+    }
+    for (int p = 0; p < n; p++) {
+        for (int q = p + 1; q < n; q++) {
+            double lambda[4];
+            const int idx = states.pair_index(p, q);
+            lindblad::hermitian_eigenvalues_4x4(states.pairs[idx], lambda);
+            out[idx] = std::max(singles[p] + singles[q] - lindblad::entropy_from_eigenvalues(lambda, 4), 0.0);
+        }
+    }
+}
+
+// (x, y, z) per bit, engine convention: x = 2 Re ρ01, y = -2 Im ρ01, z = ρ00 - ρ11
+void bloch_vectors(const lindblad::ReducedStates& states, double* out) {
+    for (int p = 0; p < states.num_bits; p++) {
+        const Eigen::Matrix<cd, 2, 2>& r = states.singles[p];
+        out[3 * p] = 2.0 * r(0, 1).real();
+        out[3 * p + 1] = -2.0 * r(0, 1).imag();
+        out[3 * p + 2] = r(0, 0).real() - r(1, 1).real();
+    }
+}
+
+volatile double g_sink = 0.0;  // Keeps results observable
+
+// Golden outputs: each reference biome is advanced GOLDEN_STEPS Euler steps
+// of GOLDEN_DT, then rho (GOLDEN_SAMPLES fixed elements, plus trace and
+// purity), pairwise MI and the Bloch vectors are compared with the stored
+// values. Lines are "<biome> <field> <count> <values...>".
+const int GOLDEN_STEPS = 5;
+const double GOLDEN_DT = 0.02;
+const int GOLDEN_SAMPLES = 64;
+
+typedef std::map<std::string, std::vector<double>> GoldenSet;
+
+GoldenSet golden_outputs(Biome& biome) {
+    const int n = biome.spec.num_qubits;
+    const int dim = 1 << n;
+    const lindblad::Generator gen = biome.generator();
+    RhoMatrix rho = biome.rho;
+    for (int s = 0; s < GOLDEN_STEPS; s++) {
+        lindblad::compute_drho(gen, rho, biome.drho, biome.temp);
+        rho += GOLDEN_DT * biome.drho;
+    }
+
+    GoldenSet out;
+    const std::string prefix = std::string(biome.spec.name) + " ";
+    std::vector<double>& samples = out[prefix + "rho"];
+    SplitMix pick(99);
+    for (int k = 0; k < GOLDEN_SAMPLES; k++) {
+        // Every element for dim 8, a fixed scatter (diagonal first) above
+        const int64_t flat = (dim * dim <= GOLDEN_SAMPLES) ? k
+                             : (k < 8) ? static_cast<int64_t>(k) * (dim + 1) * (dim / 8)
+                                       : static_cast<int64_t>(pick.next() % (static_cast<uint64_t>(dim) * dim));
+        const cd v = rho(flat / dim, flat % dim);
+        samples.push_back(v.real());
+        samples.push_back(v.imag());
+    }
+
+    lindblad::ReducedStates states;
+    double purity = 0.0;
+    cd trace;
+    lindblad::compute_reduced_states(rho, n, true, states, &purity, &trace);
+    out[prefix + "trace_purity"] = {trace.real(), trace.imag(), purity};
+    std::vector<double>& mi = out[prefix + "mi"];
+    mi.assign(n * (n - 1) / 2, 0.0);
+    mutual_information(states, mi.data());
+    std::vector<double>& bloch = out[prefix + "bloch"];
+    bloch.assign(3 * n, 0.0);
+    bloch_vectors(states, bloch.data());
+    return out;
+}
+
+bool read_golden(const std::string& path, GoldenSet& out) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string biome, field;
+        size_t count = 0;
+        fields >> biome >> field >> count;
+        std::vector<double>& values = out[biome + " " + field];
+        values.resize(count);
+        for (double& v : values) {
+            fields >> v;
+        }
+        if (!fields) {
+            std::fprintf(stderr, "malformed golden line: %s\n", line.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool write_golden(const std::string& path, const GoldenSet& golden) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    std::fprintf(file, "# native_bench golden outputs (%d Euler steps, dt %g); regenerate with --write-golden\n",
+                 GOLDEN_STEPS, GOLDEN_DT);
+    for (const auto& entry : golden) {
+        std::fprintf(file, "%s %zu", entry.first.c_str(), entry.second.size());
+        for (double v : entry.second) {
+            std::fprintf(file, " %.17g", v);
+        }
+        std::fprintf(file, "\n");
+    }
+    return std::fclose(file) == 0;
+}
+
+// Compares every computed field with the stored one; false on any mismatch
+// or missing entry
+bool check_golden(const GoldenSet& expected, const GoldenSet& actual, double tolerance) {
+    bool ok = true;
+    for (const auto& entry : actual) {
+        const auto it = expected.find(entry.first);
+        if (it == expected.end() || it->second.size() != entry.second.size()) {
+            std::printf("golden %-34s MISSING\n", entry.first.c_str());
+            ok = false;
+            continue;
+        }
+        double max_err = 0.0;
+        for (size_t k = 0; k < entry.second.size(); k++) {
+            max_err = std::max(max_err, std::abs(entry.second[k] - it->second[k]));
+        }
+        const bool pass = max_err <= tolerance;
+        std::printf("golden %-34s %s (max err %.3g)\n", entry.first.c_str(), pass ? "ok" : "FAIL", max_err);
+        ok = ok && pass;
+    }
+    return ok;
+}
+
+void bench_biome(const Options& options, Biome& biome) {
+    const int n = biome.spec.num_qubits;
+    const lindblad::Generator gen = biome.generator();
+    const std::string tag = std::string("/") + biome.spec.name;
+
+    report(options, "lindblad/drho" + tag, [&]() {
+        lindblad::compute_drho(gen, biome.rho, biome.drho, biome.temp);
+        g_sink = g_sink + biome.drho(0, 0).real();
+    });
+
+    RhoMatrix rho = biome.rho;
+    report(options, "lindblad/euler_step" + tag, [&]() {
+        lindblad::compute_drho(gen, rho, biome.drho, biome.temp);
+        rho += 1e-4 * biome.drho;
+    });
+
+    lindblad::ReducedStates states;
+    report(options, "traces/reduced_states" + tag, [&]() {
+        double purity = 0.0;
+        lindblad::compute_reduced_states(biome.rho, n, true, states, &purity);
+        g_sink = g_sink + purity;
+    });
+
+    lindblad::compute_reduced_states(biome.rho, n, true, states);
+    std::vector<double> values(std::max(3 * n, n * (n - 1) / 2), 0.0);
+    report(options, "traces/mutual_information" + tag, [&]() {
+        mutual_information(states, values.data());
+        g_sink = g_sink + values[0];
+    });
+    report(options, "traces/bloch" + tag, [&]() {
+        bloch_vectors(states, values.data());
+        g_sink = g_sink + values[0];
+    });
+}
+
+// DOPRI5 over one frame, then the attempt cap: with substeps capped at
+// DOPRI5_LIMIT_H_MAX, DOPRI5_LIMIT_ATTEMPTS attempts cannot cover
+// DOPRI5_LIMIT_T, so the integrator must stop early and report it. False when
+// a run that should complete does not, or the capped one claims it did.
+const double DOPRI5_FRAME = 0.05;
+const double DOPRI5_LIMIT_T = 1.0;
+const double DOPRI5_LIMIT_H_MAX = 0.01;
+const int DOPRI5_LIMIT_ATTEMPTS = 10;
+
+bool bench_dopri5(const Options& options, Biome& biome) {
+    const lindblad::Generator gen = biome.generator();
+    const std::string tag = std::string("/") + biome.spec.name;
+    const auto rhs = [&](lindblad::RhoConstRef y, lindblad::RhoRef dy) {
+        lindblad::compute_drho(gen, y, dy, biome.temp);
+    };
+    std::vector<RhoMatrix> stages;
+
+    RhoMatrix rho = biome.rho;
+    double h = 0.0;
+    bool reached = true;
+    report(options, "lindblad/dopri5" + tag, [&]() {
+        rho = biome.rho;
+        reached = lindblad::integrate_dopri5(rhs, rho, DOPRI5_FRAME, DOPRI5_FRAME, 1e-9, 1e-6, h, stages).reached &&
+                  reached;
+    });
+
+    const std::string limit_name = "lindblad/dopri5_attempt_limit" + tag;
+    if (!options.filter.empty() && limit_name.find(options.filter) == std::string::npos) {
+        return reached;
+    }
+    rho = biome.rho;
+    h = 0.0;
+    const lindblad::Dopri5Result limited = lindblad::integrate_dopri5(
+        rhs, rho, DOPRI5_LIMIT_T, DOPRI5_LIMIT_H_MAX, 1e-9, 1e-6, h, stages, DOPRI5_LIMIT_ATTEMPTS);
+    const bool flagged = !limited.reached && limited.t_reached < DOPRI5_LIMIT_T &&
+                         limited.substeps <= DOPRI5_LIMIT_ATTEMPTS;
+    std::printf("%-40s stopped at t=%.3g of %.3g after %d substeps %s\n", limit_name.c_str(), limited.t_reached,
+                DOPRI5_LIMIT_T, limited.substeps, flagged ? "ok" : "FAIL (limit not reported)");
+    std::fflush(stdout);
+    return reached && flagged;
+}
+
+void bench_lnn(const Options& options) {
+    for (int dim : {32, 64}) {
+        LiquidNeuralNet net(dim, dim / 4, dim);
+        std::vector<double> input(dim, 0.1), output(dim, 0.0);
+        const std::string tag = std::to_string(dim) + "->" + std::to_string(dim / 4) + "->" + std::to_string(dim);
+        report(options, "lnn/forward/" + tag, [&]() {
+            net.forward_into(input.data(), output.data());
+            g_sink = g_sink + output[0];
+        });
+
+        for (bool single : {false, true}) {
+            std::unique_ptr<LnnKernel> kernel = make_lnn_kernel(net, single);
+            if (!kernel) {
+                continue;
+            }
+            std::vector<double> hidden(dim / 4, 0.0);
+            report(options, "lnn/fixed_" + std::string(single ? "f32/" : "f64/") + tag, [&]() {
+                kernel->forward(input.data(), hidden.data(), output.data());
+                g_sink = g_sink + output[0];
+            });
+        }
+    }
+}
+
+void bench_simd(const Options& options) {
+    const SimdKernels& simd = simd_kernels();
+    const int count = 4096, dim = 64;
+    std::vector<float> rows(static_cast<size_t>(count) * dim), q(dim), scores(count);
+    SplitMix rng(7);
+    for (float& v : rows) {
+        v = static_cast<float>(rng.uniform());
+    }
+    for (float& v : q) {
+        v = static_cast<float>(rng.uniform());
+    }
+    report(options, "simd/gemv_f32/4096x64", [&]() {
+        simd.gemv_f32(rows.data(), count, dim, dim, q.data(), scores.data());
+        g_sink = g_sink + scores[0];
+    });
+
+    std::vector<double> z(2 * 1024, 0.5), y(2 * 1024, 0.0);
+    report(options, "simd/norm_sq_c64/1024", [&]() {
+        g_sink = g_sink + simd.norm_sq_c64(z.data(), 1024);
+    });
+    report(options, "simd/axpy_c64/1024", [&]() {
+        simd.axpy_c64(1e-3, z.data(), y.data(), 1024);
+    });
+}
+
+void bench_pool(const Options& options) {
+    NativeThreadPool& pool = NativeThreadPool::shared();
+    std::vector<double> out(64, 0.0);
+    report(options, "pool/parallel_for/64_items", [&]() {
+        pool.parallel_for(0, 64, 0, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                out[i] += 1.0;
+            }
+        });
+    });
+}
+
+// Scheduling of a frame-path job against biome preparation on the shared
+// pool. Chunks sleep for fixed times instead of computing, so the numbers
+// reflect the pool's policy (how many threads each job gets) rather than the
+// host's core count: a frame job of PREP_FRAME_CHUNKS chunks of
+// PREP_FRAME_CHUNK_US, repeated with an idle gap, runs alone, then while a second thread keeps preparing
+// biomes of PREP_BIOME_US each, three ways: with parallel_for on the shared
+// pool, as preparation used to run (the frame job finds the pool busy and
+// runs inline), serially on the preparation thread, and with
+// parallel_for_background, as it runs now (the frame job takes the pool at
+// the next biome boundary). Each line gives the frame time and the
+// preparation throughput, i.e. how fast a scene's biomes finish loading.
+// PREP_WORKERS pool workers are used whatever the host.
+const int PREP_FRAME_CHUNKS = 16;
+const int PREP_FRAME_CHUNK_US = 250;
+const int PREP_FRAME_GAP_US = 4000;
+const int PREP_BIOMES = 16;
+const int PREP_BIOME_US = 2000;
+const int PREP_WORKERS = 3;
+
+void bench_prep_contention(const Options& options) {
+    const std::string prefix = "pool/frame_during_prep/";
+    if (!options.filter.empty() && prefix.find(options.filter) == std::string::npos &&
+        options.filter.find(prefix) == std::string::npos) {
+        return;
+    }
+    NativeThreadPool& pool = NativeThreadPool::shared();
+    pool.set_worker_count(PREP_WORKERS);
+    // Mean duration of the frame job, with PREP_FRAME_GAP_US idle between
+    // frames as in a game loop (so preparation gets the pool in between)
+    const auto frames = [&]() {
+        using clock = std::chrono::steady_clock;
+        double total_ns = 0.0;
+        int count = 0;
+        const auto until = clock::now() + std::chrono::duration<double, std::milli>(std::max(options.min_ms, 100.0));
+        while (clock::now() < until) {
+            const auto start = clock::now();
+            pool.parallel_for(0, PREP_FRAME_CHUNKS, PREP_FRAME_CHUNKS, [](int begin, int end) {
+                std::this_thread::sleep_for(std::chrono::microseconds(PREP_FRAME_CHUNK_US * (end - begin)));
+            });
+            total_ns += std::chrono::duration<double, std::nano>(clock::now() - start).count();
+            count++;
+            std::this_thread::sleep_for(std::chrono::microseconds(PREP_FRAME_GAP_US));
+        }
+        return total_ns / std::max(count, 1);
+    };
+
+    enum PrepMode { PREP_IDLE, PREP_SHARED_POOL, PREP_SERIAL, PREP_BACKGROUND };
+    const char* const names[] = {"idle", "shared_pool", "serial", "background"};
+    for (int mode = PREP_IDLE; mode <= PREP_BACKGROUND; mode++) {
+        std::atomic<bool> stop{false};
+        std::atomic<int64_t> prepared{0};
+        std::thread prep;
+        if (mode != PREP_IDLE) {
+            prep = std::thread([&, mode]() {
+                const NativeThreadPool::RangeFn prepare = [&](int begin, int end) {
+                    for (int b = begin; b < end; b++) {
+                        std::this_thread::sleep_for(std::chrono::microseconds(PREP_BIOME_US));
+                        prepared.fetch_add(1, std::memory_order_relaxed);
+                    }
+                };
+                while (!stop.load(std::memory_order_relaxed)) {
+                    if (mode == PREP_SHARED_POOL) {
+                        pool.parallel_for(0, PREP_BIOMES, PREP_BIOMES, prepare);
+                    } else if (mode == PREP_SERIAL) {
+                        prepare(0, PREP_BIOMES);
+                    } else {
+                        pool.parallel_for_background(0, PREP_BIOMES, prepare);
+                    }
+                }
+            });
+        }
+        const auto start = std::chrono::steady_clock::now();
+        const double ns = frames();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stop.store(true, std::memory_order_relaxed);
+        if (prep.joinable()) {
+            prep.join();
+        }
+        const std::string name = prefix + names[mode];
+        std::printf("%-40s %14.1f ns/call  prep %.0f biomes/s\n", name.c_str(), ns,
+                    prepared.load() / std::max(seconds, 1e-9));
+        std::fflush(stdout);
+    }
+    pool.set_worker_count(0);  // Back to the hardware default
+}
+
+// ---------------------------------------------------------------------------
+// Native vs reference parity
+// ---------------------------------------------------------------------------
+
+// Biomes above this stay out of the evolution parity case (the reference is
+// O(dim³) per jump operator)
+const int PARITY_MAX_QUBITS = 6;
+
+// Times native and reference, then compares their outputs (error() runs after
+// both, on the buffers they last wrote). False on a parity or speedup failure;
+// filtered-out cases pass.
+bool report_parity(const Options& options, const std::string& name, const std::function<void()>& native,
+                   const std::function<void()>& reference, const std::function<double()>& error,
+                   double tolerance) {
+    if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+        return true;
+    }
+    NATIVE_TRACE_ZONE("bench_parity");
+    const double native_ns = time_ns(native, options.min_ms);
+    const double reference_ns = time_ns(reference, options.min_ms);
+    const double speedup = reference_ns / std::max(native_ns, 1e-3);
+    const double max_err = error();
+    const bool parity = max_err <= tolerance;
+    const bool fast = speedup >= options.min_speedup;
+    std::printf("%-40s %14.1f ns/call  ref %14.1f ns  %8.1fx  err %.3g %s\n", name.c_str(), native_ns,
+                reference_ns, speedup, max_err, !parity ? "PARITY FAIL" : !fast ? "SLOW" : "ok");
+    std::fflush(stdout);
+    return parity && fast;
+}
+
+double max_abs_diff(const cd* a, const cd* b, int64_t count) {
+    double err = 0.0;
+    for (int64_t k = 0; k < count; k++) {
+        err = std::max(err, std::abs(a[k] - b[k]));
+    }
+    return err;
+}
+
+// dρ = -i(H_eff ρ - ρ H_eff†) + Σ L ρ L† with dense element loops, as the
+// GDScript DensityMatrix fallback evaluates it
+void reference_drho(const Eigen::MatrixXcd& heff, const std::vector<Eigen::MatrixXcd>& jumps, const RhoMatrix& rho,
+                    RhoMatrix& drho, RhoMatrix& temp) {
+    const int dim = static_cast<int>(rho.rows());
+    const cd minus_i(0.0, -1.0);
+    for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+            cd acc(0.0, 0.0);
+            for (int k = 0; k < dim; k++) {
+                acc += heff(i, k) * rho(k, j) - rho(i, k) * std::conj(heff(j, k));
+            }
+            drho(i, j) = minus_i * acc;
+        }
+    }
+    for (const Eigen::MatrixXcd& L : jumps) {
+        for (int i = 0; i < dim; i++) {
+            for (int j = 0; j < dim; j++) {
+                cd acc(0.0, 0.0);
+                for (int k = 0; k < dim; k++) {
+                    acc += L(i, k) * rho(k, j);
+                }
+                temp(i, j) = acc;
+            }
+        }
+        for (int i = 0; i < dim; i++) {
+            for (int j = 0; j < dim; j++) {
+                cd acc(0.0, 0.0);
+                for (int k = 0; k < dim; k++) {
+                    acc += temp(i, k) * std::conj(L(j, k));
+                }
+                drho(i, j) += acc;
+            }
+        }
+    }
+}
+
+bool parity_biome(const Options& options, Biome& biome) {
+    if (biome.spec.num_qubits > PARITY_MAX_QUBITS) {
+        return true;
+    }
+    const lindblad::Generator gen = biome.generator();
+    const Eigen::MatrixXcd heff(biome.heff);
+    std::vector<Eigen::MatrixXcd> jumps;
+    for (const auto& lindblad : biome.lindblads) {
+        jumps.emplace_back(lindblad->L);
+    }
+    const int64_t dim = biome.rho.rows();
+    RhoMatrix native_drho = RhoMatrix::Zero(dim, dim), reference = RhoMatrix::Zero(dim, dim);
+    RhoMatrix temp = RhoMatrix::Zero(dim, dim);
+    return report_parity(
+        options, std::string("parity/evolution/") + biome.spec.name,
+        [&]() { lindblad::compute_drho(gen, biome.rho, native_drho, biome.temp); },
+        [&]() { reference_drho(heff, jumps, biome.rho, reference, temp); },
+        [&]() { return max_abs_diff(native_drho.data(), reference.data(), dim * dim); }, 1e-12);
+}
+
+bool parity_operator_forms(const Options& options) {
+    // Every OperatorForm forced onto an operator that can take it, so forms
+    // the cost model never picks for the reference biomes stay checked
+    const int n = 6, dim = 1 << n;
+    Eigen::Matrix2cd sz, sm;
+    sz << 1, 0, 0, -1;
+    sm << 0, 1, 0, 0;
+    SparseCM diagonal(dim, dim), banded(dim, dim);
+    for (int q = 0; q < n; q++) {
+        diagonal += (0.3 + 0.1 * q) * embed(sz, q, n);
+        banded += (0.2 + 0.05 * q) * embed(sm, q, n);
+    }
+    SplitMix rng(23);
+    Eigen::MatrixXcd filled(dim, dim);
+    for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+            const double re = rng.uniform();
+            filled(i, j) = (rng.next() % 4 == 0) ? cd(re, rng.uniform()) : cd(0.0, 0.0);
+        }
+    }
+    const SparseCM scattered = filled.sparseView();
+    const struct {
+        OperatorForm::Kind kind;
+        const SparseCM* op;
+    } cases[] = {{OperatorForm::DIAGONAL, &diagonal},
+                 {OperatorForm::DIA, &banded},
+                 {OperatorForm::DENSE, &scattered},
+                 {OperatorForm::SCATTER, &banded}};
+
+    RhoMatrix rho(dim, dim);
+    for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+            rho(i, j) = cd(rng.uniform(), rng.uniform());
+        }
+    }
+    RhoMatrix out = RhoMatrix::Zero(dim, dim), reference = RhoMatrix::Zero(dim, dim);
+    RhoMatrix temp = RhoMatrix::Zero(dim, dim);
+    bool ok = true;
+    for (const auto& c : cases) {
+        OperatorForm form;
+        OperatorForm::build_as(*c.op, c.kind, form);
+        const Eigen::MatrixXcd L(*c.op);
+        const std::vector<Eigen::MatrixXcd> jumps = {L};
+        const Eigen::MatrixXcd heff = Eigen::MatrixXcd::Zero(dim, dim);
+        ok = report_parity(
+                 options, std::string("parity/operator_form/") + OperatorForm::kind_name(c.kind),
+                 [&]() {
+                     out.setZero();
+                     form.apply_sandwich(cd(1.0, 0.0), rho, out, temp);
+                 },
+                 [&]() { reference_drho(heff, jumps, rho, reference, temp); },
+                 [&]() { return max_abs_diff(out.data(), reference.data(), static_cast<int64_t>(dim) * dim); },
+                 1e-12) &&
+             ok;
+    }
+    return ok;
+}
+
+bool parity_selector(const Options& options) {
+    // Cosine scoring of one query against a library, as ParametricSelectorNative
+    // runs it (SIMD gemv over rows) and as the GDScript selector loops it
+    const SimdKernels& simd = simd_kernels();
+    const int count = 4096, dim = 64;
+    std::vector<float> rows(static_cast<size_t>(count) * dim), q(dim), scores(count), reference(count);
+    SplitMix rng(11);
+    for (float& v : rows) {
+        v = static_cast<float>(rng.uniform());
+    }
+    for (float& v : q) {
+        v = static_cast<float>(rng.uniform());
+    }
+    return report_parity(
+        options, "parity/selector/4096x64",
+        [&]() { simd.gemv_f32(rows.data(), count, dim, dim, q.data(), scores.data()); },
+        [&]() {
+            for (int r = 0; r < count; r++) {
+                float dot = 0.0f;
+                for (int c = 0; c < dim; c++) {
+                    dot += rows[static_cast<size_t>(r) * dim + c] * q[c];
+                }
+                reference[r] = dot;
+            }
+        },
+        [&]() {
+            double err = 0.0;
+            for (int r = 0; r < count; r++) {
+                err = std::max(err, static_cast<double>(std::abs(scores[r] - reference[r])));
+            }
+            return err;
+        },
+        1e-3);
+}
+
+bool parity_lnn(const Options& options) {
+    bool ok = true;
+    for (int dim : {32, 64}) {
+        const int hidden_size = dim / 4;
+        LiquidNeuralNet net(dim, hidden_size, dim);
+        std::vector<double> input(dim), output(dim, 0.0), reference(dim, 0.0);
+        std::vector<double> start(hidden_size), hidden(hidden_size), ref_hidden(hidden_size), scratch(hidden_size);
+        SplitMix rng(17 + dim);
+        for (double& v : input) {
+            v = rng.uniform();
+        }
+        for (double& v : start) {
+            v = 0.5 * rng.uniform();
+        }
+        const std::string tag = std::to_string(dim) + "->" + std::to_string(hidden_size) + "->" + std::to_string(dim);
+        ok = report_parity(
+                 options, "parity/lnn/" + tag,
+                 [&]() {
+                     hidden = start;
+                     net.forward_into(input.data(), hidden.data(), output.data(), scratch.data());
+                 },
+                 [&]() {
+                     // Element loops over the same weights (GDScript LiquidNeuralNet.forward)
+                     for (int h = 0; h < hidden_size; h++) {
+                         double act = net.b_hidden(h);
+                         for (int i = 0; i < dim; i++) {
+                             act += net.W_in(i, h) * input[i];
+                         }
+                         for (int k = 0; k < hidden_size; k++) {
+                             act += net.W_rec(k, h) * start[k];
+                         }
+                         ref_hidden[h] = (1.0 - net.leak) * start[h] + net.leak * std::tanh(act);
+                     }
+                     for (int o = 0; o < dim; o++) {
+                         double y = net.b_out(o);
+                         for (int h = 0; h < hidden_size; h++) {
+                             y += net.W_out(h, o) * ref_hidden[h];
+                         }
+                         reference[o] = y;
+                     }
+                 },
+                 [&]() {
+                     double err = 0.0;
+                     for (int o = 0; o < dim; o++) {
+                         err = std::max(err, std::abs(output[o] - reference[o]));
+                     }
+                     return err;
+                 },
+                 1e-12) &&
+             ok;
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    SimdIsa max_isa = SIMD_AVX512;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-ms" && i + 1 < argc) {
+            options.min_ms = std::atof(argv[++i]);
+        } else if (arg == "--isa" && i + 1 < argc) {
+            const std::string isa = argv[++i];
+            max_isa = (isa == "baseline") ? SIMD_BASELINE : (isa == "avx2") ? SIMD_AVX2 : SIMD_AVX512;
+        } else if (arg == "--golden" && i + 1 < argc) {
+            options.golden_path = argv[++i];
+        } else if (arg == "--tol" && i + 1 < argc) {
+            options.tolerance = std::atof(argv[++i]);
+        } else if (arg == "--trace" && i + 1 < argc) {
+            options.trace_path = argv[++i];
+        } else if (arg == "--write-golden") {
+            options.write_golden = true;
+        } else if (arg == "--min-speedup" && i + 1 < argc) {
+            options.min_speedup = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s [--filter <substr>] [--min-ms <ms>] [--isa baseline|avx2|avx512]\n"
+                         "          [--golden <path>] [--tol <abs>] [--write-golden] [--trace <path>]\n"
+                         "          [--min-speedup <ratio>]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    if (!options.trace_path.empty()) {
+        if (!TraceRecorder::compiled_in()) {
+            std::fprintf(stderr, "--trace needs a TRACE=1 build\n");
+            return 2;
+        }
+        TraceRecorder::start(1 << 20);
+    }
+
+    const SimdIsa isa = select_simd_isa(max_isa);
+    std::printf("native_bench: simd=%s threads=%d\n", simd_isa_name(isa), NativeThreadPool::shared().thread_count());
+
+    // Biomes are built one at a time (the 10-qubit state alone is 16 MB)
+    GoldenSet actual;
+    bool parity_ok = true;
+    bool dopri5_ok = true;
+    for (const BiomeSpec& spec : REFERENCE_BIOMES) {
+        Biome biome(spec);
+        if (!options.write_golden) {
+            bench_biome(options, biome);
+            if (spec.num_qubits <= PARITY_MAX_QUBITS) {
+                dopri5_ok = bench_dopri5(options, biome) && dopri5_ok;
+            }
+            parity_ok = parity_biome(options, biome) && parity_ok;
+        }
+        const GoldenSet outputs = golden_outputs(biome);
+        actual.insert(outputs.begin(), outputs.end());
+    }
+
+    if (options.write_golden) {
+        if (!write_golden(options.golden_path, actual)) {
+            std::fprintf(stderr, "cannot write %s\n", options.golden_path.c_str());
+            return 1;
+        }
+        std::printf("wrote %zu golden fields to %s\n", actual.size(), options.golden_path.c_str());
+        return 0;
+    }
+
+    bench_lnn(options);
+    bench_simd(options);
+    bench_pool(options);
+    bench_prep_contention(options);
+    parity_ok = parity_operator_forms(options) && parity_ok;
+    parity_ok = parity_selector(options) && parity_ok;
+    parity_ok = parity_lnn(options) && parity_ok;
+    NativeThreadPool::shutdown();
+
+    if (!options.trace_path.empty()) {
+        TraceRecorder::stop();
+        std::FILE* file = std::fopen(options.trace_path.c_str(), "w");
+        if (file != nullptr) {
+            const std::string json = TraceRecorder::chrome_json();
+            std::fwrite(json.data(), 1, json.size(), file);
+            std::fclose(file);
+        }
+    }
+
+    GoldenSet expected;
+    if (!read_golden(options.golden_path, expected)) {
+        std::printf("golden: cannot read %s (run with --write-golden to create it)\n", options.golden_path.c_str());
+        return 1;
+    }
+    const bool ok = check_golden(expected, actual, options.tolerance);
+    std::printf("golden: %s\n", ok ? "all outputs within tolerance" : "MISMATCH");
+    std::printf("parity: %s\n", parity_ok ? "native matches reference" : "FAILED");
+    std::printf("dopri5: %s\n", dopri5_ok ? "attempt limit reported" : "FAILED");
+    return ok && parity_ok && dopri5_ok ? 0 : 1;
+}
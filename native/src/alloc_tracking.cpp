@@ -0,0 +1,139 @@
+#include "alloc_tracking.h"
+
+using namespace godot;
+
+namespace {
+
+// Plain globals, no constructors: the wrapped allocators can run before any
+// static initializer of this library
+std::atomic<uint64_t> g_heap_allocs{0};
+std::atomic<uint64_t> g_heap_bytes{0};
+std::atomic<uint64_t> g_packed_allocs{0};
+std::atomic<uint64_t> g_packed_bytes{0};
+
+}  // namespace
+
+bool AllocTracker::compiled_in() {
+#ifdef SPACEWHEAT_ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocCounts AllocTracker::totals() {
+    AllocCounts counts;
+    counts.heap_allocs = g_heap_allocs.load(std::memory_order_relaxed);
+    counts.heap_bytes = g_heap_bytes.load(std::memory_order_relaxed);
+    counts.packed_allocs = g_packed_allocs.load(std::memory_order_relaxed);
+    counts.packed_bytes = g_packed_bytes.load(std::memory_order_relaxed);
+    return counts;
+}
+
+void AllocTracker::reset_totals() {
+    g_heap_allocs.store(0, std::memory_order_relaxed);
+    g_heap_bytes.store(0, std::memory_order_relaxed);
+    g_packed_allocs.store(0, std::memory_order_relaxed);
+    g_packed_bytes.store(0, std::memory_order_relaxed);
+}
+
+void AllocTracker::note_heap(size_t bytes) {
+    g_heap_allocs.fetch_add(1, std::memory_order_relaxed);
+    g_heap_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocTracker::note_packed(uint64_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    g_packed_allocs.fetch_add(1, std::memory_order_relaxed);
+    g_packed_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocationStats::record(const AllocCounts& delta) {
+    m_calls.fetch_add(1, std::memory_order_relaxed);
+    m_heap_allocs.fetch_add(delta.heap_allocs, std::memory_order_relaxed);
+    m_heap_bytes.fetch_add(delta.heap_bytes, std::memory_order_relaxed);
+    m_packed_allocs.fetch_add(delta.packed_allocs, std::memory_order_relaxed);
+    m_packed_bytes.fetch_add(delta.packed_bytes, std::memory_order_relaxed);
+    uint64_t seen = m_max_heap_allocs.load(std::memory_order_relaxed);
+    while (delta.heap_allocs > seen &&
+           !m_max_heap_allocs.compare_exchange_weak(seen, delta.heap_allocs, std::memory_order_relaxed)) {
+    }
+}
+
+void AllocationStats::reset() {
+    m_calls.store(0, std::memory_order_relaxed);
+    m_heap_allocs.store(0, std::memory_order_relaxed);
+    m_heap_bytes.store(0, std::memory_order_relaxed);
+    m_packed_allocs.store(0, std::memory_order_relaxed);
+    m_packed_bytes.store(0, std::memory_order_relaxed);
+    m_max_heap_allocs.store(0, std::memory_order_relaxed);
+}
+
+AllocCounts AllocationStats::totals() const {
+    AllocCounts counts;
+    counts.heap_allocs = m_heap_allocs.load(std::memory_order_relaxed);
+    counts.heap_bytes = m_heap_bytes.load(std::memory_order_relaxed);
+    counts.packed_allocs = m_packed_allocs.load(std::memory_order_relaxed);
+    counts.packed_bytes = m_packed_bytes.load(std::memory_order_relaxed);
+    return counts;
+}
+
+#ifdef SPACEWHEAT_ALLOC_TRACKING
+// ---------------------------------------------------------------------------
+// Linker wraps (make ALLOC=1 links with -Wl,--wrap=<symbol> for each): calls
+// from this library's objects land here, everything else in the process
+// still calls the real allocator directly. Frees aren't wrapped; the
+// counters are allocations made, not bytes live.
+// ---------------------------------------------------------------------------
+
+extern "C" {
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+int __real_posix_memalign(void** out, size_t alignment, size_t size);
+void* __real__Znwm(size_t size);                    // operator new(size_t)
+void* __real__Znam(size_t size);                    // operator new[](size_t)
+void* __real__ZnwmSt11align_val_t(size_t size, size_t alignment);  // operator new(size_t, align_val_t)
+
+void* __wrap_malloc(size_t size) {
+    AllocTracker::note_heap(size);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    AllocTracker::note_heap(count * size);
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    // Growing a buffer (Eigen conservativeResize) is a fresh allocation as
+    // far as the hot path is concerned
+    AllocTracker::note_heap(size);
+    return __real_realloc(ptr, size);
+}
+
+int __wrap_posix_memalign(void** out, size_t alignment, size_t size) {
+    AllocTracker::note_heap(size);
+    return __real_posix_memalign(out, alignment, size);
+}
+
+void* __wrap__Znwm(size_t size) {
+    AllocTracker::note_heap(size);
+    return __real__Znwm(size);
+}
+
+void* __wrap__Znam(size_t size) {
+    AllocTracker::note_heap(size);
+    return __real__Znam(size);
+}
+
+void* __wrap__ZnwmSt11align_val_t(size_t size, size_t alignment) {
+    AllocTracker::note_heap(size);
+    return __real__ZnwmSt11align_val_t(size, alignment);
+}
+
+}  // extern "C"
+#endif
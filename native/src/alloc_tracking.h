@@ -0,0 +1,106 @@
+#ifndef ALLOC_TRACKING_H
+#define ALLOC_TRACKING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace godot {
+
+/**
+ * AllocTracker / AllocationStats - Optional allocation counts per engine call
+ *
+ * Built only with -DSPACEWHEAT_ALLOC_TRACKING (make ALLOC=1), which also
+ * links the library with --wrap for malloc/calloc/realloc/posix_memalign and
+ * operator new: every heap allocation made from this library's code (Eigen
+ * temporaries, std::vector growth, scratch buffers) bumps the process-wide
+ * heap counters, while the rest of the process is untouched. Packed arrays
+ * are allocated by Godot, out of reach of the wrap, so the hot packers
+ * (pack_dense, compute_bloch_metrics, compute_mi_adaptive, the lookahead
+ * packets) note their buffers with NATIVE_ALLOC_PACKED.
+ *
+ * Each bound method timed by BIND_TIMED_METHOD (latency_histograms.h) also
+ * gets an AllocationStats: the counter delta across the call, so a method
+ * meant to be allocation-free should show 0 heap_allocs per call. The
+ * counters are global, so calls running concurrently on other threads bleed
+ * into each other's deltas (pool workers of the call itself are counted, as
+ * intended). Without the flag everything here compiles to nothing.
+ */
+struct AllocCounts {
+    uint64_t heap_allocs = 0;
+    uint64_t heap_bytes = 0;
+    uint64_t packed_allocs = 0;
+    uint64_t packed_bytes = 0;
+};
+
+class AllocTracker {
+public:
+    static bool compiled_in();
+    // Counts since load (or the last reset_totals)
+    static AllocCounts totals();
+    static void reset_totals();
+
+    static void note_heap(size_t bytes);
+    static void note_packed(uint64_t bytes);  // 0 (an empty array) is ignored
+};
+
+class AllocationStats {
+public:
+    void record(const AllocCounts& delta);
+    void reset();
+
+    uint64_t calls() const { return m_calls.load(std::memory_order_relaxed); }
+    AllocCounts totals() const;
+    uint64_t max_heap_allocs() const { return m_max_heap_allocs.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_calls{0};
+    std::atomic<uint64_t> m_heap_allocs{0};
+    std::atomic<uint64_t> m_heap_bytes{0};
+    std::atomic<uint64_t> m_packed_allocs{0};
+    std::atomic<uint64_t> m_packed_bytes{0};
+    std::atomic<uint64_t> m_max_heap_allocs{0};  // Worst single call
+};
+
+// Records the counter delta over the scope into stats (if set)
+class ScopedAllocations {
+public:
+    explicit ScopedAllocations(AllocationStats* stats)
+        : m_stats(stats), m_start(stats != nullptr ? AllocTracker::totals() : AllocCounts()) {}
+    ~ScopedAllocations() {
+        if (m_stats != nullptr) {
+            const AllocCounts now = AllocTracker::totals();
+            AllocCounts delta;
+            delta.heap_allocs = now.heap_allocs - m_start.heap_allocs;
+            delta.heap_bytes = now.heap_bytes - m_start.heap_bytes;
+            delta.packed_allocs = now.packed_allocs - m_start.packed_allocs;
+            delta.packed_bytes = now.packed_bytes - m_start.packed_bytes;
+            m_stats->record(delta);
+        }
+    }
+
+private:
+    ScopedAllocations(const ScopedAllocations&) = delete;
+    ScopedAllocations& operator=(const ScopedAllocations&) = delete;
+
+    AllocationStats* m_stats;
+    AllocCounts m_start;
+};
+
+}  // namespace godot
+
+#define NATIVE_ALLOC_CONCAT_INNER(a, b) a##b
+#define NATIVE_ALLOC_CONCAT(a, b) NATIVE_ALLOC_CONCAT_INNER(a, b)
+
+#ifdef SPACEWHEAT_ALLOC_TRACKING
+// Counter delta over the rest of the scope into an AllocationStats*
+#define NATIVE_ALLOC_SCOPE(stats) ::godot::ScopedAllocations NATIVE_ALLOC_CONCAT(alloc_scope_, __LINE__)(stats)
+// A Packed array buffer just sized by resize() (empty arrays hold none)
+#define NATIVE_ALLOC_PACKED(array) \
+    ::godot::AllocTracker::note_packed(static_cast<uint64_t>((array).size()) * sizeof(*(array).ptr()))
+#else
+#define NATIVE_ALLOC_SCOPE(stats) ((void)0)
+#define NATIVE_ALLOC_PACKED(array) ((void)0)
+#endif
+
+#endif  // ALLOC_TRACKING_H
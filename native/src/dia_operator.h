@@ -0,0 +1,56 @@
+#ifndef DIA_OPERATOR_H
+#define DIA_OPERATOR_H
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+
+/**
+ * DiaOperator - Diagonal-offset (DIA) storage for banded operators
+ *
+ * Hamiltonians and jumps built from qubit flips only have nonzeros on a few
+ * fixed diagonals: flipping bit k moves a basis state by ±2^k, so
+ * Σ_k c_k X_k + diagonal terms touches offsets 0 and ±2^k only. Stored by
+ * diagonal, a product with a dense row-major matrix becomes shifted
+ * multiply-adds over contiguous rows (left) or row segments (right),
+ * with no column indices to gather. The right product in·A† is where CSR
+ * hurts most: Eigen walks it column by column through the row-major ρ.
+ *
+ * from_sparse() accepts an operator with at most MAX_DIAGONALS distinct
+ * offsets; whether DIA actually beats the other forms is OperatorForm's
+ * call (operator_form.h). Immutable once built.
+ */
+struct DiaOperator {
+    typedef Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> SparseCM;
+    typedef Eigen::Matrix<std::complex<double>, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> DenseCM;
+    typedef Eigen::Ref<DenseCM> DenseRef;
+    typedef Eigen::Ref<const DenseCM> DenseConstRef;
+
+    static constexpr int MAX_DIAGONALS = 32;  // 0 and ±2^k for up to 15 flipped qubits
+
+    int dim = 0;
+    std::vector<int> offsets;                    // col - row of each stored diagonal, ascending
+    std::vector<std::complex<double>> values;    // Diagonal k at [k·dim, (k+1)·dim), indexed by row
+
+    bool empty() const { return offsets.empty(); }
+    int64_t bytes() const;
+    // Stored entries, Σ (dim - |offset|) over the diagonals
+    int64_t slots() const;
+
+    // DIA form of A (square) if it has few enough diagonals; false (out
+    // cleared) otherwise
+    static bool from_sparse(const SparseCM& A, DiaOperator& out);
+
+    // out += scale · A · in
+    void apply_left(std::complex<double> scale, DenseConstRef in, DenseRef out) const;
+    // out += scale · in · A†
+    void apply_right_adjoint(std::complex<double> scale, DenseConstRef in, DenseRef out) const;
+};
+
+}  // namespace godot
+
+#endif  // DIA_OPERATOR_H
@@ -0,0 +1,109 @@
+#include "emoji_registry.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <mutex>
+#include <unordered_map>
+
+using namespace godot;
+
+namespace {
+
+struct StringHash {
+    size_t operator()(const String& s) const { return s.hash(); }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::unordered_map<String, int, StringHash> ids;
+    std::vector<String> names;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+}  // namespace
+
+void EmojiRegistry::_bind_methods() {
+    ClassDB::bind_static_method("EmojiRegistry", D_METHOD("intern", "emoji"), &EmojiRegistry::intern);
+    ClassDB::bind_static_method("EmojiRegistry", D_METHOD("get_id", "emoji"), &EmojiRegistry::get_id);
+    ClassDB::bind_static_method("EmojiRegistry", D_METHOD("get_emoji", "id"), &EmojiRegistry::get_emoji);
+    ClassDB::bind_static_method("EmojiRegistry", D_METHOD("get_count"), &EmojiRegistry::get_count);
+}
+
+int EmojiRegistry::intern(const String& emoji) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto it = r.ids.find(emoji);
+    if (it != r.ids.end()) {
+        return it->second;
+    }
+    const int id = static_cast<int>(r.names.size());
+    r.names.push_back(emoji);
+    r.ids.emplace(emoji, id);
+    return id;
+}
+
+int EmojiRegistry::get_id(const String& emoji) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto it = r.ids.find(emoji);
+    return it != r.ids.end() ? it->second : -1;
+}
+
+String EmojiRegistry::get_emoji(int id) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    if (id < 0 || id >= static_cast<int>(r.names.size())) {
+        return String();
+    }
+    return r.names[id];
+}
+
+int EmojiRegistry::get_count() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return static_cast<int>(r.names.size());
+}
+
+bool godot::resolve_emoji_layout(const Dictionary& metadata, EmojiLayout& layout) {
+    layout = EmojiLayout();
+    if (metadata.has("emoji_ids")) {
+        const PackedInt32Array ids = metadata.get("emoji_ids", PackedInt32Array());
+        const PackedInt32Array qubits = metadata.get("emoji_qubits", PackedInt32Array());
+        const PackedInt32Array poles = metadata.get("emoji_poles", PackedInt32Array());
+        if (ids.is_empty() || qubits.size() != ids.size() || poles.size() != ids.size()) {
+            return false;
+        }
+        layout.ids.assign(ids.ptr(), ids.ptr() + ids.size());
+        layout.qubits.assign(qubits.ptr(), qubits.ptr() + qubits.size());
+        layout.poles.assign(poles.ptr(), poles.ptr() + poles.size());
+        return true;
+    }
+
+    const Array emoji_list = metadata.get("emoji_list", Array());
+    const Dictionary emoji_to_qubit = metadata.get("emoji_to_qubit", Dictionary());
+    const Dictionary emoji_to_pole = metadata.get("emoji_to_pole", Dictionary());
+    if (emoji_list.is_empty() || emoji_to_qubit.is_empty() || emoji_to_pole.is_empty()) {
+        return false;
+    }
+    const int count = static_cast<int>(emoji_list.size());
+    layout.ids.assign(count, -1);
+    layout.qubits.assign(count, -1);
+    layout.poles.assign(count, -1);
+    for (int i = 0; i < count; i++) {
+        const Variant emoji_var = emoji_list[i];
+        if (emoji_var.get_type() != Variant::STRING) {
+            continue;
+        }
+        const String emoji = emoji_var;
+        layout.ids[i] = EmojiRegistry::intern(emoji);
+        if (emoji_to_qubit.has(emoji) && emoji_to_pole.has(emoji)) {
+            layout.qubits[i] = static_cast<int>(emoji_to_qubit[emoji]);
+            layout.poles[i] = static_cast<int>(emoji_to_pole[emoji]);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef EMOJI_REGISTRY_H
+#define EMOJI_REGISTRY_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <vector>
+
+namespace godot {
+
+/**
+ * EmojiRegistry - Process-wide interned emoji ids
+ *
+ * intern() maps an emoji String to a small dense int that never changes for
+ * the lifetime of the process, so metadata, icon maps and coupling payloads
+ * can carry ints and native hot paths index arrays instead of hashing
+ * Strings. Thread-safe.
+ *
+ *   var wheat := EmojiRegistry.intern("🌾")
+ *   EmojiRegistry.get_emoji(wheat)  # "🌾"
+ */
+class EmojiRegistry : public RefCounted {
+    GDCLASS(EmojiRegistry, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    static int intern(const String& emoji);
+    static int get_id(const String& emoji);  // -1 if never interned
+    static String get_emoji(int id);         // Empty for unknown ids
+    static int get_count();
+};
+
+/**
+ * Per-emoji (registry id, qubit, pole) of a biome's metadata, in emoji_list
+ * order. Two metadata forms are accepted:
+ *   String form: "emoji_list" + "emoji_to_qubit" + "emoji_to_pole"
+ *   integer form: "emoji_ids" + "emoji_qubits" + "emoji_poles" (parallel
+ *     PackedInt32Arrays of registry ids), which skips every String lookup
+ * Entries that aren't Strings get id -1; unresolved emojis get qubit/pole -1.
+ */
+struct EmojiLayout {
+    std::vector<int> ids;
+    std::vector<int> qubits;
+    std::vector<int> poles;
+};
+// false if the metadata has neither complete form
+bool resolve_emoji_layout(const Dictionary& metadata, EmojiLayout& layout);
+
+}  // namespace godot
+
+#endif  // EMOJI_REGISTRY_H
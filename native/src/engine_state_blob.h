@@ -0,0 +1,173 @@
+#ifndef ENGINE_STATE_BLOB_H
+#define ENGINE_STATE_BLOB_H
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace godot {
+
+/**
+ * EngineStateWriter / EngineStateReader - Little-endian engine state blobs
+ *
+ * Used by MultiBiomeLookaheadEngine::save_snapshot / load_snapshot and the
+ * per-engine blocks they contain. Compressed sparse matrices are written as
+ * their raw CSR arrays (u32 rows, cols, nnz; i32 outer[rows + 1]; i32
+ * inner[nnz]; complex<f64> values[nnz]) so reading one back is three
+ * memcpys after validation. Every read is bounds-checked; a reader that
+ * failed stays failed, so callers can chain reads and check ok() once.
+ */
+class EngineStateWriter {
+public:
+    typedef Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> SparseCM;
+
+    std::vector<uint8_t>& bytes() { return m_bytes; }
+
+    void write_raw(const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        m_bytes.insert(m_bytes.end(), p, p + size);
+    }
+    void write_u8(uint8_t v) { m_bytes.push_back(v); }
+    void write_u32(uint32_t v) { write_raw(&v, 4); }
+    void write_i32(int32_t v) { write_raw(&v, 4); }
+    void write_f64(double v) { write_raw(&v, 8); }
+
+    // u32 count, then count doubles
+    void write_doubles(const double* data, uint32_t count) {
+        write_u32(count);
+        write_raw(data, static_cast<size_t>(count) * 8);
+    }
+
+    // u32 count, then count raw bytes
+    void write_bytes(const uint8_t* data, uint32_t count) {
+        write_u32(count);
+        write_raw(data, count);
+    }
+
+    void write_sparse(const SparseCM& m) {
+        if (!m.isCompressed()) {
+            SparseCM compressed = m;
+            compressed.makeCompressed();
+            write_sparse(compressed);
+            return;
+        }
+        const uint32_t nnz = static_cast<uint32_t>(m.nonZeros());
+        write_u32(static_cast<uint32_t>(m.rows()));
+        write_u32(static_cast<uint32_t>(m.cols()));
+        write_u32(nnz);
+        if (m.outerSize() > 0) {
+            write_raw(m.outerIndexPtr(), (static_cast<size_t>(m.outerSize()) + 1) * 4);
+        } else {
+            write_i32(0);
+        }
+        write_raw(m.innerIndexPtr(), static_cast<size_t>(nnz) * 4);
+        write_raw(m.valuePtr(), static_cast<size_t>(nnz) * sizeof(std::complex<double>));
+    }
+
+private:
+    std::vector<uint8_t> m_bytes;
+};
+
+class EngineStateReader {
+public:
+    typedef EngineStateWriter::SparseCM SparseCM;
+
+    EngineStateReader(const uint8_t* data, int64_t size) : m_data(data), m_size(size) {}
+
+    bool ok() const { return m_ok; }
+    bool at_end() const { return m_pos == m_size; }
+    int64_t position() const { return m_pos; }
+    bool has(int64_t bytes) const { return m_ok && bytes >= 0 && m_pos + bytes <= m_size; }
+    void fail() { m_ok = false; }
+
+    bool read_raw(void* out, int64_t size) {
+        if (!has(size)) {
+            m_ok = false;
+            return false;
+        }
+        std::memcpy(out, m_data + m_pos, static_cast<size_t>(size));
+        m_pos += size;
+        return true;
+    }
+    bool read_u8(uint8_t& out) { return read_raw(&out, 1); }
+    bool read_u32(uint32_t& out) { return read_raw(&out, 4); }
+    bool read_i32(int32_t& out) { return read_raw(&out, 4); }
+    bool read_f64(double& out) { return read_raw(&out, 8); }
+
+    // Borrow count bytes in place (nullptr and failed if truncated)
+    const uint8_t* read_span(int64_t count) {
+        if (!has(count)) {
+            m_ok = false;
+            return nullptr;
+        }
+        const uint8_t* span = m_data + m_pos;
+        m_pos += count;
+        return span;
+    }
+
+    // write_doubles layout; out is resized to the count
+    bool read_doubles(std::vector<double>& out) {
+        uint32_t count = 0;
+        if (!read_u32(count) || !has(static_cast<int64_t>(count) * 8)) {
+            m_ok = false;
+            return false;
+        }
+        out.resize(count);
+        return read_raw(out.data(), static_cast<int64_t>(count) * 8);
+    }
+
+    // write_sparse layout, rejecting any shape other than rows × cols and
+    // index arrays Eigen would not accept (non-monotone outer, unsorted or
+    // out-of-range inner)
+    bool read_sparse(SparseCM& out, int rows, int cols) {
+        uint32_t r = 0, c = 0, nnz = 0;
+        if (!read_u32(r) || !read_u32(c) || !read_u32(nnz) || r != static_cast<uint32_t>(rows) ||
+            c != static_cast<uint32_t>(cols) ||
+            !has((static_cast<int64_t>(r) + 1) * 4 + static_cast<int64_t>(nnz) * (4 + sizeof(std::complex<double>)))) {
+            m_ok = false;
+            return false;
+        }
+        out.resize(rows, cols);
+        if (rows == 0) {
+            int32_t zero = 0;
+            if (read_i32(zero) && (zero != 0 || nnz != 0)) {
+                m_ok = false;
+            }
+            return m_ok;
+        }
+        out.resizeNonZeros(static_cast<Eigen::Index>(nnz));
+        read_raw(out.outerIndexPtr(), (static_cast<int64_t>(r) + 1) * 4);
+        read_raw(out.innerIndexPtr(), static_cast<int64_t>(nnz) * 4);
+        read_raw(out.valuePtr(), static_cast<int64_t>(nnz) * sizeof(std::complex<double>));
+
+        const int* outer = out.outerIndexPtr();
+        const int* inner = out.innerIndexPtr();
+        bool valid = outer[0] == 0 && outer[rows] == static_cast<int>(nnz);
+        for (int i = 0; valid && i < rows; i++) {
+            valid = outer[i] <= outer[i + 1];
+        }
+        for (int i = 0; valid && i < rows; i++) {
+            for (int k = outer[i]; valid && k < outer[i + 1]; k++) {
+                valid = inner[k] >= 0 && inner[k] < cols && (k == outer[i] || inner[k - 1] < inner[k]);
+            }
+        }
+        if (!valid) {
+            out.resize(rows, cols);
+            m_ok = false;
+        }
+        return m_ok;
+    }
+
+private:
+    const uint8_t* m_data;
+    int64_t m_size;
+    int64_t m_pos = 0;
+    bool m_ok = true;
+};
+
+}  // namespace godot
+
+#endif  // ENGINE_STATE_BLOB_H
@@ -1,9 +1,255 @@
 #include "force_graph_engine.h"
+#include "native_thread_pool.h"
+#include "native_counters.h"
+#include "trace_zones.h"
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
 #include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <unordered_map>
 
 using namespace godot;
 
+namespace {
+
+constexpr float COINCIDENT_DIST2 = 1e-12f;  // (1e-6)²: pairs closer than this get the fixed push
+
+// Fixed push direction for coincident nodes (alternates by index parity)
+inline void coincident_direction(int node_idx, float& dx, float& dy) {
+    const float s = 0.70710678f;
+    dx = (node_idx % 2 == 0) ? s : -s;
+    dy = (node_idx / 2 % 2 == 0) ? s : -s;
+}
+
+// Spring toward a target distance that shrinks with MI:
+// d_target = max(BASE / (1 + SCALING * mi), MIN). Returns the force
+// magnitude over distance (0 for uncorrelated / coincident pairs).
+struct CorrelationSpring {
+    float k;
+    float base;
+    float scaling;
+    float min_dist;
+
+    float operator()(float mi, float d2) const {
+        if (mi < 1e-6f || d2 < COINCIDENT_DIST2) {
+            return 0.0f;
+        }
+        const float d = std::sqrt(d2);
+        const float target = std::max(base / (1.0f + scaling * mi), min_dist);
+        return k * (d - target) / d;
+    }
+};
+
+// Barnes–Hut quadtree over a set of node indices. Every node is a unit mass;
+// a cell stores its count and centroid. Leaves hold up to LEAF_SIZE nodes
+// (more only at MAX_DEPTH, i.e. for coincident nodes).
+class RepulsionQuadTree {
+public:
+    static constexpr int LEAF_SIZE = 4;
+    static constexpr int MAX_DEPTH = 16;
+
+    RepulsionQuadTree(const float* x, const float* y, std::vector<int> indices)
+        : m_x(x), m_y(y), m_indices(std::move(indices)) {
+        if (m_indices.empty()) {
+            return;
+        }
+        float lo_x = x[m_indices[0]], hi_x = lo_x;
+        float lo_y = y[m_indices[0]], hi_y = lo_y;
+        for (int idx : m_indices) {
+            lo_x = std::min(lo_x, x[idx]);
+            hi_x = std::max(hi_x, x[idx]);
+            lo_y = std::min(lo_y, y[idx]);
+            hi_y = std::max(hi_y, y[idx]);
+        }
+        const float half = std::max(std::max(hi_x - lo_x, hi_y - lo_y) * 0.5f, 1e-3f);
+        m_cells.reserve(m_indices.size());
+        m_cells.emplace_back();
+        build(0, 0, static_cast<int>(m_indices.size()), (lo_x + hi_x) * 0.5f, (lo_y + hi_y) * 0.5f, half, 0);
+    }
+
+    // Force on node_idx at (px, py); cells with (2·half) / dist < theta act as one mass
+    void force_on(int node_idx, float px, float py, float theta, float strength, float& fx, float& fy) const {
+        if (m_cells.empty()) {
+            return;
+        }
+        const float theta2 = theta * theta;
+        int stack[4 * MAX_DEPTH + 4];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Cell& cell = m_cells[stack[--top]];
+            if (cell.first_child < 0) {
+                for (int k = cell.begin; k < cell.end; k++) {
+                    const int j = m_indices[k];
+                    if (j == node_idx) {
+                        continue;
+                    }
+                    const float dx = px - m_x[j];
+                    const float dy = py - m_y[j];
+                    const float d2 = dx * dx + dy * dy;
+                    if (d2 < COINCIDENT_DIST2) {
+                        float ux, uy;
+                        coincident_direction(node_idx, ux, uy);
+                        fx += ux * strength;
+                        fy += uy * strength;
+                        continue;
+                    }
+                    // Inverse square repulsion: F = STRENGTH / dist^2
+                    const float inv = strength / (d2 * std::sqrt(d2));
+                    fx += dx * inv;
+                    fy += dy * inv;
+                }
+                continue;
+            }
+            const float dx = px - cell.cx;
+            const float dy = py - cell.cy;
+            const float d2 = dx * dx + dy * dy;
+            const float size = 2.0f * cell.half;
+            if (d2 > COINCIDENT_DIST2 && size * size < theta2 * d2) {
+                // Far cell: its whole mass at the centroid (it can't contain p)
+                const float inv = strength * cell.count / (d2 * std::sqrt(d2));
+                fx += dx * inv;
+                fy += dy * inv;
+                continue;
+            }
+            for (int c = 0; c < 4; c++) {
+                const int child = cell.first_child + c;
+                if (m_cells[child].count > 0) {
+                    stack[top++] = child;
+                }
+            }
+        }
+    }
+
+private:
+    struct Cell {
+        float half = 0.0f;
+        float cx = 0.0f;  // Centroid
+        float cy = 0.0f;
+        int count = 0;
+        int begin = 0;
+        int end = 0;
+        int first_child = -1;  // Four consecutive cells, or -1 for a leaf
+    };
+
+    // Fill cell id (already allocated) and split it while it holds too many nodes
+    void build(int id, int begin, int end, float center_x, float center_y, float half, int depth) {
+        float sum_x = 0.0f, sum_y = 0.0f;
+        for (int k = begin; k < end; k++) {
+            sum_x += m_x[m_indices[k]];
+            sum_y += m_y[m_indices[k]];
+        }
+        Cell& cell = m_cells[id];
+        cell.half = half;
+        cell.begin = begin;
+        cell.end = end;
+        cell.count = end - begin;
+        cell.cx = cell.count > 0 ? sum_x / cell.count : center_x;
+        cell.cy = cell.count > 0 ? sum_y / cell.count : center_y;
+        if (end - begin <= LEAF_SIZE || depth >= MAX_DEPTH) {
+            return;
+        }
+
+        // Split into quadrants: [left-bottom, right-bottom, left-top, right-top]
+        auto first = m_indices.begin();
+        auto is_low_y = [&](int idx) { return m_y[idx] < center_y; };
+        auto is_low_x = [&](int idx) { return m_x[idx] < center_x; };
+        const int mid_y = static_cast<int>(std::partition(first + begin, first + end, is_low_y) - first);
+        const int mid_lo = static_cast<int>(std::partition(first + begin, first + mid_y, is_low_x) - first);
+        const int mid_hi = static_cast<int>(std::partition(first + mid_y, first + end, is_low_x) - first);
+        const int bounds[5] = {begin, mid_lo, mid_y, mid_hi, end};
+
+        const float q = half * 0.5f;
+        const float off_x[4] = {-q, q, -q, q};
+        const float off_y[4] = {-q, -q, q, q};
+        const int first_child = static_cast<int>(m_cells.size());
+        m_cells.resize(m_cells.size() + 4);  // Invalidates `cell`
+        m_cells[id].first_child = first_child;
+        for (int c = 0; c < 4; c++) {
+            build(first_child + c, bounds[c], bounds[c + 1], center_x + off_x[c], center_y + off_y[c], q, depth + 1);
+        }
+    }
+
+    const float* m_x;
+    const float* m_y;
+    std::vector<int> m_indices;
+    std::vector<Cell> m_cells;
+};
+
+// Uniform grid over a point set with cell size = interaction cutoff, so
+// every pair within the cutoff lies in the same or an adjacent cell.
+// Points are sorted by cell key; each occupied cell maps to its run.
+class SpatialHash {
+public:
+    SpatialHash(const float* x, const float* y, const std::vector<int>& indices, float cell)
+        : m_cell(cell) {
+        m_keyed.reserve(indices.size());
+        for (int i : indices) {
+            m_keyed.emplace_back(key(cell_of(x[i]), cell_of(y[i])), i);
+        }
+        std::sort(m_keyed.begin(), m_keyed.end());
+        m_ranges.reserve(m_keyed.size());
+        for (int k = 0; k < static_cast<int>(m_keyed.size());) {
+            int end = k;
+            while (end < static_cast<int>(m_keyed.size()) && m_keyed[end].first == m_keyed[k].first) {
+                end++;
+            }
+            m_ranges[m_keyed[k].first] = std::make_pair(k, end);
+            k = end;
+        }
+    }
+
+    // fn(j) for every indexed point in the 3×3 cells around (px, py)
+    template <typename Fn>
+    void for_each_near(float px, float py, Fn&& fn) const {
+        const int64_t cx = cell_of(px);
+        const int64_t cy = cell_of(py);
+        for (int64_t dy = -1; dy <= 1; dy++) {
+            for (int64_t dx = -1; dx <= 1; dx++) {
+                auto it = m_ranges.find(key(cx + dx, cy + dy));
+                if (it == m_ranges.end()) {
+                    continue;
+                }
+                for (int k = it->second.first; k < it->second.second; k++) {
+                    fn(m_keyed[k].second);
+                }
+            }
+        }
+    }
+
+private:
+    static int64_t key(int64_t cx, int64_t cy) { return (cx << 32) ^ (cy & 0xffffffffLL); }
+    int64_t cell_of(float v) const { return static_cast<int64_t>(std::floor(v / m_cell)); }
+
+    float m_cell;
+    std::vector<std::pair<int64_t, int>> m_keyed;
+    std::unordered_map<int64_t, std::pair<int, int>> m_ranges;  // key -> [begin, end) in m_keyed
+};
+
+// Inverse-square repulsion on a point at (ddx, ddy) from its neighbour, zero
+// past the cutoff; coincident points use the fixed per-index push
+inline void repulsion_within(int i, float ddx, float ddy, float cutoff2, float strength, float& fx, float& fy) {
+    const float d2 = ddx * ddx + ddy * ddy;
+    if (d2 > cutoff2) {
+        return;
+    }
+    if (d2 < COINCIDENT_DIST2) {
+        float ux, uy;
+        coincident_direction(i, ux, uy);
+        fx += ux * strength;
+        fy += uy * strength;
+        return;
+    }
+    const float inv = strength / (d2 * std::sqrt(d2));
+    fx += ddx * inv;
+    fy += ddy * inv;
+}
+
+}  // namespace
+
 ForceGraphEngine::ForceGraphEngine() {
 }
 
@@ -11,26 +257,88 @@ ForceGraphEngine::~ForceGraphEngine() {
 }
 
 void ForceGraphEngine::_bind_methods() {
-    ClassDB::bind_method(D_METHOD("update_positions", "positions", "velocities", "bloch_packet", "mi_values", "biome_center", "dt", "frozen_mask"),
-                         &ForceGraphEngine::update_positions);
-
-    ClassDB::bind_method(D_METHOD("set_purity_radial_spring", "spring"), &ForceGraphEngine::set_purity_radial_spring);
-    ClassDB::bind_method(D_METHOD("set_phase_angular_spring", "spring"), &ForceGraphEngine::set_phase_angular_spring);
-    ClassDB::bind_method(D_METHOD("set_correlation_spring", "spring"), &ForceGraphEngine::set_correlation_spring);
-    ClassDB::bind_method(D_METHOD("set_mi_spring", "spring"), &ForceGraphEngine::set_mi_spring);
-    ClassDB::bind_method(D_METHOD("set_repulsion_strength", "strength"), &ForceGraphEngine::set_repulsion_strength);
-    ClassDB::bind_method(D_METHOD("set_damping", "damping"), &ForceGraphEngine::set_damping);
-    ClassDB::bind_method(D_METHOD("set_base_distance", "distance"), &ForceGraphEngine::set_base_distance);
-    ClassDB::bind_method(D_METHOD("set_min_distance", "distance"), &ForceGraphEngine::set_min_distance);
-
-    ClassDB::bind_method(D_METHOD("get_purity_radial_spring"), &ForceGraphEngine::get_purity_radial_spring);
-    ClassDB::bind_method(D_METHOD("get_phase_angular_spring"), &ForceGraphEngine::get_phase_angular_spring);
-    ClassDB::bind_method(D_METHOD("get_correlation_spring"), &ForceGraphEngine::get_correlation_spring);
-    ClassDB::bind_method(D_METHOD("get_mi_spring"), &ForceGraphEngine::get_mi_spring);
-    ClassDB::bind_method(D_METHOD("get_repulsion_strength"), &ForceGraphEngine::get_repulsion_strength);
-    ClassDB::bind_method(D_METHOD("get_damping"), &ForceGraphEngine::get_damping);
-    ClassDB::bind_method(D_METHOD("get_base_distance"), &ForceGraphEngine::get_base_distance);
-    ClassDB::bind_method(D_METHOD("get_min_distance"), &ForceGraphEngine::get_min_distance);
+    BIND_TIMED_METHOD(D_METHOD("update_positions", "positions", "velocities", "bloch_packet", "mi_values", "biome_center", "dt", "frozen_mask"),
+                      &ForceGraphEngine::update_positions);
+    BIND_TIMED_METHOD(D_METHOD("update_positions_sparse", "positions", "velocities", "bloch_packet", "mi_edges", "biome_center", "dt", "frozen_mask"),
+                      &ForceGraphEngine::update_positions_sparse);
+    BIND_TIMED_METHOD(D_METHOD("update_positions_batch", "positions", "velocities", "bloch_packets", "mi_values",
+                                  "mi_offsets", "node_offsets", "biome_centers", "dt", "frozen_mask"),
+                      &ForceGraphEngine::update_positions_batch);
+
+    BIND_TIMED_METHOD(D_METHOD("initial_layout", "bloch_packet", "mi_values", "biome_center", "relax_iterations"),
+                      &ForceGraphEngine::initial_layout, DEFVAL(100));
+    BIND_TIMED_METHOD(D_METHOD("place_layout", "handle", "bloch_packet", "mi_edges", "biome_center", "frozen_mask", "relax_iterations"),
+                      &ForceGraphEngine::place_layout, DEFVAL(PackedByteArray()), DEFVAL(100));
+
+    BIND_TIMED_METHOD(D_METHOD("create_layout", "num_nodes"), &ForceGraphEngine::create_layout);
+    BIND_TIMED_METHOD(D_METHOD("destroy_layout", "handle"), &ForceGraphEngine::destroy_layout);
+    BIND_TIMED_METHOD(D_METHOD("set_layout_state", "handle", "positions", "velocities"), &ForceGraphEngine::set_layout_state);
+    BIND_TIMED_METHOD(D_METHOD("set_layout_radii", "handle", "radii"), &ForceGraphEngine::set_layout_radii);
+    BIND_TIMED_METHOD(D_METHOD("step_layout", "handle", "bloch_packet", "mi_values", "biome_center", "dt", "frozen_mask"),
+                      &ForceGraphEngine::step_layout);
+    BIND_TIMED_METHOD(D_METHOD("step_layout_sparse", "handle", "bloch_packet", "mi_edges", "biome_center", "dt", "frozen_mask"),
+                      &ForceGraphEngine::step_layout_sparse);
+    BIND_TIMED_METHOD(D_METHOD("get_layout_positions", "handle"), &ForceGraphEngine::get_layout_positions);
+    BIND_TIMED_METHOD(D_METHOD("get_layout_velocities", "handle"), &ForceGraphEngine::get_layout_velocities);
+    BIND_TIMED_METHOD(D_METHOD("get_layout_size", "handle"), &ForceGraphEngine::get_layout_size);
+    BIND_TIMED_METHOD(D_METHOD("repel_layouts", "handles", "dt"), &ForceGraphEngine::repel_layouts);
+    BIND_TIMED_METHOD(D_METHOD("get_layout_multimesh_buffer", "handle", "bloch_packet"),
+                      &ForceGraphEngine::get_layout_multimesh_buffer);
+    BIND_TIMED_METHOD(D_METHOD("build_multimesh_buffer", "positions", "bloch_packet"),
+                      &ForceGraphEngine::build_multimesh_buffer);
+    BIND_TIMED_METHOD(D_METHOD("run_benchmark", "node_counts", "steps", "mi_density", "frozen_ratio", "seed"),
+                      &ForceGraphEngine::run_benchmark, DEFVAL(PackedInt32Array()), DEFVAL(20), DEFVAL(0.1f),
+                      DEFVAL(0.0f), DEFVAL(1));
+
+    BIND_TIMED_METHOD(D_METHOD("set_purity_radial_spring", "spring"), &ForceGraphEngine::set_purity_radial_spring);
+    BIND_TIMED_METHOD(D_METHOD("set_phase_angular_spring", "spring"), &ForceGraphEngine::set_phase_angular_spring);
+    BIND_TIMED_METHOD(D_METHOD("set_correlation_spring", "spring"), &ForceGraphEngine::set_correlation_spring);
+    BIND_TIMED_METHOD(D_METHOD("set_mi_spring", "spring"), &ForceGraphEngine::set_mi_spring);
+    BIND_TIMED_METHOD(D_METHOD("set_repulsion_strength", "strength"), &ForceGraphEngine::set_repulsion_strength);
+    BIND_TIMED_METHOD(D_METHOD("set_damping", "damping"), &ForceGraphEngine::set_damping);
+    BIND_TIMED_METHOD(D_METHOD("set_base_distance", "distance"), &ForceGraphEngine::set_base_distance);
+    BIND_TIMED_METHOD(D_METHOD("set_min_distance", "distance"), &ForceGraphEngine::set_min_distance);
+    BIND_TIMED_METHOD(D_METHOD("set_repulsion_mode", "mode"), &ForceGraphEngine::set_repulsion_mode);
+    BIND_TIMED_METHOD(D_METHOD("set_barnes_hut_theta", "theta"), &ForceGraphEngine::set_barnes_hut_theta);
+    BIND_TIMED_METHOD(D_METHOD("set_repulsion_cutoff", "cutoff"), &ForceGraphEngine::set_repulsion_cutoff);
+    BIND_TIMED_METHOD(D_METHOD("set_sleep_enabled", "enabled"), &ForceGraphEngine::set_sleep_enabled);
+    BIND_TIMED_METHOD(D_METHOD("set_sleep_velocity_threshold", "speed"), &ForceGraphEngine::set_sleep_velocity_threshold);
+    BIND_TIMED_METHOD(D_METHOD("set_sleep_force_threshold", "force"), &ForceGraphEngine::set_sleep_force_threshold);
+    BIND_TIMED_METHOD(D_METHOD("set_sleep_frames", "frames"), &ForceGraphEngine::set_sleep_frames);
+    BIND_TIMED_METHOD(D_METHOD("set_sleep_input_tolerance", "tolerance"), &ForceGraphEngine::set_sleep_input_tolerance);
+    BIND_TIMED_METHOD(D_METHOD("set_fixed_timestep", "step"), &ForceGraphEngine::set_fixed_timestep);
+    BIND_TIMED_METHOD(D_METHOD("set_max_substeps", "substeps"), &ForceGraphEngine::set_max_substeps);
+    BIND_TIMED_METHOD(D_METHOD("set_bubble_scale", "scale"), &ForceGraphEngine::set_bubble_scale);
+    BIND_TIMED_METHOD(D_METHOD("set_collision_enabled", "enabled"), &ForceGraphEngine::set_collision_enabled);
+    BIND_TIMED_METHOD(D_METHOD("set_collision_radius", "radius"), &ForceGraphEngine::set_collision_radius);
+    BIND_TIMED_METHOD(D_METHOD("set_collision_iterations", "iterations"), &ForceGraphEngine::set_collision_iterations);
+
+    BIND_TIMED_METHOD(D_METHOD("get_purity_radial_spring"), &ForceGraphEngine::get_purity_radial_spring);
+    BIND_TIMED_METHOD(D_METHOD("get_phase_angular_spring"), &ForceGraphEngine::get_phase_angular_spring);
+    BIND_TIMED_METHOD(D_METHOD("get_correlation_spring"), &ForceGraphEngine::get_correlation_spring);
+    BIND_TIMED_METHOD(D_METHOD("get_mi_spring"), &ForceGraphEngine::get_mi_spring);
+    BIND_TIMED_METHOD(D_METHOD("get_repulsion_strength"), &ForceGraphEngine::get_repulsion_strength);
+    BIND_TIMED_METHOD(D_METHOD("get_damping"), &ForceGraphEngine::get_damping);
+    BIND_TIMED_METHOD(D_METHOD("get_base_distance"), &ForceGraphEngine::get_base_distance);
+    BIND_TIMED_METHOD(D_METHOD("get_min_distance"), &ForceGraphEngine::get_min_distance);
+    BIND_TIMED_METHOD(D_METHOD("get_repulsion_mode"), &ForceGraphEngine::get_repulsion_mode);
+    BIND_TIMED_METHOD(D_METHOD("get_barnes_hut_theta"), &ForceGraphEngine::get_barnes_hut_theta);
+    BIND_TIMED_METHOD(D_METHOD("get_repulsion_cutoff"), &ForceGraphEngine::get_repulsion_cutoff);
+    BIND_TIMED_METHOD(D_METHOD("get_sleep_enabled"), &ForceGraphEngine::get_sleep_enabled);
+    BIND_TIMED_METHOD(D_METHOD("get_sleep_velocity_threshold"), &ForceGraphEngine::get_sleep_velocity_threshold);
+    BIND_TIMED_METHOD(D_METHOD("get_sleep_force_threshold"), &ForceGraphEngine::get_sleep_force_threshold);
+    BIND_TIMED_METHOD(D_METHOD("get_sleep_frames"), &ForceGraphEngine::get_sleep_frames);
+    BIND_TIMED_METHOD(D_METHOD("get_sleep_input_tolerance"), &ForceGraphEngine::get_sleep_input_tolerance);
+    BIND_TIMED_METHOD(D_METHOD("get_fixed_timestep"), &ForceGraphEngine::get_fixed_timestep);
+    BIND_TIMED_METHOD(D_METHOD("get_max_substeps"), &ForceGraphEngine::get_max_substeps);
+    BIND_TIMED_METHOD(D_METHOD("get_bubble_scale"), &ForceGraphEngine::get_bubble_scale);
+    BIND_TIMED_METHOD(D_METHOD("get_collision_enabled"), &ForceGraphEngine::get_collision_enabled);
+    BIND_TIMED_METHOD(D_METHOD("get_collision_radius"), &ForceGraphEngine::get_collision_radius);
+    BIND_TIMED_METHOD(D_METHOD("get_collision_iterations"), &ForceGraphEngine::get_collision_iterations);
+
+    BIND_ENUM_CONSTANT(REPULSION_EXACT);
+    BIND_ENUM_CONSTANT(REPULSION_BARNES_HUT);
+    BIND_ENUM_CONSTANT(REPULSION_GRID);
 }
 
 void ForceGraphEngine::set_purity_radial_spring(float spring) { m_purity_radial_spring = spring; }
@@ -41,6 +349,41 @@ void ForceGraphEngine::set_repulsion_strength(float strength) { m_repulsion_stre
 void ForceGraphEngine::set_damping(float damping) { m_damping = damping; }
 void ForceGraphEngine::set_base_distance(float distance) { m_base_distance = distance; }
 void ForceGraphEngine::set_min_distance(float distance) { m_min_distance = distance; }
+void ForceGraphEngine::set_repulsion_mode(int mode) { m_repulsion_mode = std::clamp(mode, (int)REPULSION_EXACT, (int)REPULSION_GRID); }
+void ForceGraphEngine::set_barnes_hut_theta(float theta) { m_barnes_hut_theta = std::max(theta, 0.0f); }
+void ForceGraphEngine::set_repulsion_cutoff(float cutoff) { m_repulsion_cutoff = std::max(cutoff, 1.0f); }
+
+void ForceGraphEngine::set_sleep_enabled(bool enabled) { m_sleep_enabled = enabled; }
+void ForceGraphEngine::set_sleep_velocity_threshold(float speed) { m_sleep_velocity = std::max(speed, 0.0f); }
+void ForceGraphEngine::set_sleep_force_threshold(float force) { m_sleep_force = std::max(force, 0.0f); }
+void ForceGraphEngine::set_sleep_frames(int frames) { m_sleep_frames = std::clamp(frames, 1, 65535); }
+void ForceGraphEngine::set_sleep_input_tolerance(float tolerance) { m_sleep_input_tolerance = std::max(tolerance, 0.0f); }
+void ForceGraphEngine::set_fixed_timestep(float step) { m_fixed_timestep = std::max(step, 0.0f); }
+void ForceGraphEngine::set_max_substeps(int substeps) { m_max_substeps = std::max(substeps, 1); }
+void ForceGraphEngine::set_bubble_scale(float scale) { m_bubble_scale = scale; }
+void ForceGraphEngine::set_collision_enabled(bool enabled) { m_collision_enabled = enabled; }
+void ForceGraphEngine::set_collision_radius(float radius) { m_collision_radius = std::max(radius, 0.0f); }
+void ForceGraphEngine::set_collision_iterations(int iterations) { m_collision_iterations = std::max(iterations, 1); }
+
+void ForceGraphEngine::NodeBuffers::resize(int n) {
+    for (std::vector<float>* v : {&x, &y, &vx, &vy, &fx, &fy, &target_radius, &theta, &weight, &coincident,
+                                  &moving, &mi_sum, &radius, &sleep_target_radius, &sleep_theta, &sleep_mi}) {
+        v->resize(n, 0.0f);
+    }
+    asleep.resize(n, 0);
+    still_frames.resize(n, 0);
+    active.reserve(n);
+    awake.reserve(n);
+}
+
+void ForceGraphEngine::NodeBuffers::wake_all() {
+    std::fill(asleep.begin(), asleep.end(), 0);
+    std::fill(still_frames.begin(), still_frames.end(), 0);
+}
+
+int ForceGraphEngine::NodeBuffers::sleeping_count() const {
+    return static_cast<int>(std::count(asleep.begin(), asleep.end(), 1));
+}
 
 Dictionary ForceGraphEngine::update_positions(
     const PackedVector2Array& positions,
@@ -51,223 +394,1392 @@ Dictionary ForceGraphEngine::update_positions(
     float dt,
     const PackedByteArray& frozen_mask
 ) {
-    int num_nodes = positions.size();
+    StepInputs in;
+    in.bloch = bloch_packet.ptr();
+    in.bloch_size = bloch_packet.size();
+    in.mi = mi_values.ptr();
+    in.mi_size = mi_values.size();
+    in.frozen = frozen_mask.ptr();
+    in.frozen_size = frozen_mask.size();
+    in.center_x = biome_center.x;
+    in.center_y = biome_center.y;
+    in.dt = dt;
+    return _step_packed(positions, velocities, in);
+}
 
-    // Copy input arrays for modification
-    PackedVector2Array new_positions = positions;
-    PackedVector2Array new_velocities = velocities;
+Dictionary ForceGraphEngine::update_positions_sparse(
+    const PackedVector2Array& positions,
+    const PackedVector2Array& velocities,
+    const PackedFloat64Array& bloch_packet,
+    const PackedFloat64Array& mi_edges,
+    Vector2 biome_center,
+    float dt,
+    const PackedByteArray& frozen_mask
+) {
+    StepInputs in;
+    in.bloch = bloch_packet.ptr();
+    in.bloch_size = bloch_packet.size();
+    in.mi_edges = mi_edges.ptr();
+    in.mi_edge_count = mi_edges.size() / 3;
+    in.frozen = frozen_mask.ptr();
+    in.frozen_size = frozen_mask.size();
+    in.center_x = biome_center.x;
+    in.center_y = biome_center.y;
+    in.dt = dt;
+    return _step_packed(positions, velocities, in);
+}
+
+Dictionary ForceGraphEngine::_step_packed(const PackedVector2Array& positions, const PackedVector2Array& velocities,
+                                          StepInputs& in) {
+    const int num_nodes = positions.size();
 
-    // Ensure velocity array matches position array size
-    if (new_velocities.size() != num_nodes) {
-        new_velocities.resize(num_nodes);
+    // Unpack into struct-of-arrays (missing velocities start at rest)
+    NodeBuffers nodes;
+    nodes.resize(num_nodes);
+    for (int i = 0; i < num_nodes; i++) {
+        const Vector2 p = positions[i];
+        nodes.x[i] = p.x;
+        nodes.y[i] = p.y;
+        if (i < velocities.size()) {
+            const Vector2 v = velocities[i];
+            nodes.vx[i] = v.x;
+            nodes.vy[i] = v.y;
+        }
     }
 
-    // Calculate forces for each node
+    step_nodes(nodes, in);
+
+    PackedVector2Array new_positions;
+    PackedVector2Array new_velocities;
+    new_positions.resize(num_nodes);
+    new_velocities.resize(num_nodes);
+    Vector2* pos_out = new_positions.ptrw();
+    Vector2* vel_out = new_velocities.ptrw();
     for (int i = 0; i < num_nodes; i++) {
-        // Skip frozen nodes
-        if (frozen_mask.size() > i && frozen_mask[i] != 0) {
+        pos_out[i] = Vector2(nodes.x[i], nodes.y[i]);
+        vel_out[i] = Vector2(nodes.vx[i], nodes.vy[i]);
+    }
+
+    // Return updated positions and velocities
+    Dictionary result;
+    result["positions"] = new_positions;
+    result["velocities"] = new_velocities;
+    return result;
+}
+
+// ============================================================================
+// INITIAL PLACEMENT
+// ============================================================================
+
+void ForceGraphEngine::place_nodes(NodeBuffers& nodes, const StepInputs& in, int relax_iterations) const {
+    NATIVE_TRACE_ZONE("force_place");
+    _prepare_nodes(nodes, in);
+    nodes.wake_all();
+    nodes.time_accumulator = 0.0f;
+    const int n = nodes.size();
+
+    // Golden-angle spiral: offsets that stay evenly spread for any count
+    const float golden_angle = 2.39996323f;
+    auto spiral = [&](int k, float radius, float& ox, float& oy) {
+        ox = radius * std::cos(golden_angle * k);
+        oy = radius * std::sin(golden_angle * k);
+    };
+
+    // 1. Bloch targets, where the radial and angular springs are at rest
+    std::vector<uint8_t> placed(n, 0);
+    const float nudge = 0.5f * m_min_distance;
+    for (int i : nodes.active) {
+        const float target = nodes.target_radius[i];
+        if (target < 0.0f) {
+            continue;
+        }
+        float ox, oy;
+        spiral(i, nudge, ox, oy);
+        nodes.x[i] = in.center_x + target * std::cos(nodes.theta[i]) + ox;
+        nodes.y[i] = in.center_y + target * std::sin(nodes.theta[i]) + oy;
+        placed[i] = 1;
+    }
+    for (int i = 0; i < n; i++) {
+        placed[i] |= nodes.weight[i] == 0.0f;  // Frozen nodes stay where they are
+    }
+
+    // 2. Nodes without a Bloch entry: MI-weighted mean of placed partners
+    std::vector<float> sum_x(n, 0.0f), sum_y(n, 0.0f), sum_w(n, 0.0f);
+    auto pull = [&](int i, int j, float mi) {
+        if (mi <= 0.0f || placed[i] == placed[j]) {
+            return;
+        }
+        const int to = placed[i] ? j : i;
+        const int from = placed[i] ? i : j;
+        sum_x[to] += mi * nodes.x[from];
+        sum_y[to] += mi * nodes.y[from];
+        sum_w[to] += mi;
+    };
+    if (in.mi_edges) {
+        for (int e = 0; e < in.mi_edge_count; e++) {
+            const double* edge = in.mi_edges + e * 3;
+            const int i = static_cast<int>(edge[0]);
+            const int j = static_cast<int>(edge[1]);
+            if (i >= 0 && j >= 0 && i < n && j < n && i != j) {
+                pull(i, j, static_cast<float>(edge[2]));
+            }
+        }
+    } else {
+        int idx = 0;
+        for (int i = 0; i < n && idx < in.mi_size; i++) {
+            for (int j = i + 1; j < n && idx < in.mi_size; j++, idx++) {
+                pull(i, j, static_cast<float>(in.mi[idx]));
+            }
+        }
+    }
+    int loose = 0;
+    for (int i : nodes.active) {
+        if (placed[i]) {
             continue;
         }
+        float ox, oy;
+        if (sum_w[i] > 0.0f) {
+            spiral(i, nudge, ox, oy);
+            nodes.x[i] = sum_x[i] / sum_w[i] + ox;
+            nodes.y[i] = sum_y[i] / sum_w[i] + oy;
+        } else {
+            spiral(loose, 0.5f * m_base_distance * std::sqrt(static_cast<float>(loose + 1)), ox, oy);
+            nodes.x[i] = in.center_x + ox;
+            nodes.y[i] = in.center_y + oy;
+            loose++;
+        }
+    }
+
+    // 3. Cooled descent on the full model. Moves of 0.5 / (stiffest spring)
+    // per unit force: the repulsion stiffness 2·strength / d³ at
+    // min_distance, or a spring constant
+    const float d_min = std::max(m_min_distance, 1.0f);
+    const float stiffness = std::max({std::abs(m_purity_radial_spring), std::abs(m_phase_angular_spring),
+                                      std::abs(m_mi_spring), 2.0f * std::abs(m_repulsion_strength) / (d_min * d_min * d_min),
+                                      1e-6f});
+    const float scale = 0.5f / stiffness;
+    const float final_step = 0.5f;
+    float max_step = std::max(0.5f * m_base_distance, final_step);
+    const int iterations = std::max(relax_iterations, 0);
+    const float cooling = iterations > 1 ? std::pow(final_step / max_step, 1.0f / (iterations - 1)) : 1.0f;
+    const StepKernel kernel = _select_kernel(in, true);
+    for (int it = 0; it < iterations; it++) {
+        (this->*kernel)(nodes, in, scale, max_step);
+        max_step *= cooling;
+    }
+
+    for (int i : nodes.active) {
+        nodes.vx[i] = 0.0f;
+        nodes.vy[i] = 0.0f;
+    }
+    nodes.wake_all();
+}
+
+PackedVector2Array ForceGraphEngine::initial_layout(const PackedFloat64Array& bloch_packet,
+                                                    const PackedFloat64Array& mi_values, Vector2 biome_center,
+                                                    int relax_iterations) {
+    const int num_nodes = static_cast<int>(bloch_packet.size() / 8);
+    NodeBuffers nodes;
+    nodes.resize(num_nodes);
+    StepInputs in;
+    in.bloch = bloch_packet.ptr();
+    in.bloch_size = bloch_packet.size();
+    in.mi = mi_values.ptr();
+    in.mi_size = mi_values.size();
+    in.center_x = biome_center.x;
+    in.center_y = biome_center.y;
+    place_nodes(nodes, in, relax_iterations);
+
+    PackedVector2Array positions;
+    positions.resize(num_nodes);
+    Vector2* out = positions.ptrw();
+    for (int i = 0; i < num_nodes; i++) {
+        out[i] = Vector2(nodes.x[i], nodes.y[i]);
+    }
+    return positions;
+}
 
-        Vector2 total_force = Vector2(0, 0);
+bool ForceGraphEngine::place_layout(int handle, const PackedFloat64Array& bloch_packet,
+                                    const PackedFloat64Array& mi_edges, Vector2 biome_center,
+                                    const PackedByteArray& frozen_mask, int relax_iterations) {
+    NodeBuffers* nodes = _checked_layout(handle, "place_layout");
+    if (!nodes) {
+        return false;
+    }
+    StepInputs in;
+    in.bloch = bloch_packet.ptr();
+    in.bloch_size = bloch_packet.size();
+    in.mi_edges = mi_edges.ptr();
+    in.mi_edge_count = mi_edges.size() / 3;
+    in.frozen = frozen_mask.ptr();
+    in.frozen_size = frozen_mask.size();
+    in.center_x = biome_center.x;
+    in.center_y = biome_center.y;
+    place_nodes(*nodes, in, relax_iterations);
+    return true;
+}
+
+// ============================================================================
+// PERSISTENT LAYOUTS
+// ============================================================================
+
+int ForceGraphEngine::create_layout(int num_nodes) {
+    auto nodes = std::make_unique<NodeBuffers>();
+    nodes->resize(std::max(num_nodes, 0));
+    if (!m_free_layouts.empty()) {
+        const int handle = m_free_layouts.back();
+        m_free_layouts.pop_back();
+        m_layouts[handle] = std::move(nodes);
+        return handle;
+    }
+    m_layouts.push_back(std::move(nodes));
+    return static_cast<int>(m_layouts.size()) - 1;
+}
 
-        // 1. Purity radial force (pulls to radius based on purity)
-        if (bloch_packet.size() >= (i + 1) * 8) {
-            total_force += _calculate_purity_radial_force(i, new_positions[i], bloch_packet, biome_center);
+void ForceGraphEngine::destroy_layout(int handle) {
+    if (_checked_layout(handle, "destroy_layout")) {
+        m_layouts[handle].reset();
+        m_free_layouts.push_back(handle);
+    }
+}
+
+ForceGraphEngine::NodeBuffers* ForceGraphEngine::get_layout(int handle) {
+    return (handle >= 0 && handle < static_cast<int>(m_layouts.size())) ? m_layouts[handle].get() : nullptr;
+}
+
+const ForceGraphEngine::NodeBuffers* ForceGraphEngine::get_layout(int handle) const {
+    return (handle >= 0 && handle < static_cast<int>(m_layouts.size())) ? m_layouts[handle].get() : nullptr;
+}
+
+ForceGraphEngine::NodeBuffers* ForceGraphEngine::_checked_layout(int handle, const char* method) {
+    NodeBuffers* nodes = get_layout(handle);
+    if (!nodes) {
+        UtilityFunctions::push_warning("ForceGraphEngine: Invalid layout handle for ", method, " ", handle);
+    }
+    return nodes;
+}
+
+void ForceGraphEngine::set_layout_state(int handle, const PackedVector2Array& positions,
+                                        const PackedVector2Array& velocities) {
+    NodeBuffers* nodes = _checked_layout(handle, "set_layout_state");
+    if (!nodes) {
+        return;
+    }
+    const int num_nodes = positions.size();
+    nodes->resize(num_nodes);
+    for (int i = 0; i < num_nodes; i++) {
+        const Vector2 p = positions[i];
+        const Vector2 v = i < velocities.size() ? velocities[i] : Vector2();
+        nodes->x[i] = p.x;
+        nodes->y[i] = p.y;
+        nodes->vx[i] = v.x;
+        nodes->vy[i] = v.y;
+    }
+    nodes->wake_all();
+}
+
+bool ForceGraphEngine::step_layout(int handle, const PackedFloat64Array& bloch_packet,
+                                   const PackedFloat64Array& mi_values, Vector2 biome_center, float dt,
+                                   const PackedByteArray& frozen_mask) {
+    NodeBuffers* nodes = _checked_layout(handle, "step_layout");
+    if (!nodes) {
+        return false;
+    }
+    StepInputs in;
+    in.bloch = bloch_packet.ptr();
+    in.bloch_size = bloch_packet.size();
+    in.mi = mi_values.ptr();
+    in.mi_size = mi_values.size();
+    in.frozen = frozen_mask.ptr();
+    in.frozen_size = frozen_mask.size();
+    in.center_x = biome_center.x;
+    in.center_y = biome_center.y;
+    in.dt = dt;
+    in.accumulate = true;
+    step_nodes(*nodes, in);
+    return true;
+}
+
+bool ForceGraphEngine::step_layout_sparse(int handle, const PackedFloat64Array& bloch_packet,
+                                          const PackedFloat64Array& mi_edges, Vector2 biome_center, float dt,
+                                          const PackedByteArray& frozen_mask) {
+    NodeBuffers* nodes = _checked_layout(handle, "step_layout_sparse");
+    if (!nodes) {
+        return false;
+    }
+    StepInputs in;
+    in.bloch = bloch_packet.ptr();
+    in.bloch_size = bloch_packet.size();
+    in.mi_edges = mi_edges.ptr();
+    in.mi_edge_count = mi_edges.size() / 3;
+    in.frozen = frozen_mask.ptr();
+    in.frozen_size = frozen_mask.size();
+    in.center_x = biome_center.x;
+    in.center_y = biome_center.y;
+    in.dt = dt;
+    in.accumulate = true;
+    step_nodes(*nodes, in);
+    return true;
+}
+
+PackedVector2Array ForceGraphEngine::get_layout_positions(int handle) const {
+    PackedVector2Array out;
+    const NodeBuffers* nodes = get_layout(handle);
+    if (nodes) {
+        out.resize(nodes->size());
+        Vector2* dst = out.ptrw();
+        for (int i = 0; i < nodes->size(); i++) {
+            dst[i] = Vector2(nodes->x[i], nodes->y[i]);
         }
+    }
+    return out;
+}
 
-        // 2. Phase angular force (creates clustering by phase)
-        if (bloch_packet.size() >= (i + 1) * 8) {
-            total_force += _calculate_phase_angular_force(i, new_positions[i], bloch_packet, biome_center);
+PackedVector2Array ForceGraphEngine::get_layout_velocities(int handle) const {
+    PackedVector2Array out;
+    const NodeBuffers* nodes = get_layout(handle);
+    if (nodes) {
+        out.resize(nodes->size());
+        Vector2* dst = out.ptrw();
+        for (int i = 0; i < nodes->size(); i++) {
+            dst[i] = Vector2(nodes->vx[i], nodes->vy[i]);
         }
+    }
+    return out;
+}
+
+int ForceGraphEngine::get_layout_size(int handle) const {
+    const NodeBuffers* nodes = get_layout(handle);
+    return nodes ? nodes->size() : -1;
+}
 
-        // 3. Correlation forces (MI-based springs)
-        if (!mi_values.is_empty()) {
-            total_force += _calculate_correlation_forces(i, new_positions[i], new_positions, mi_values, frozen_mask);
+// ============================================================================
+// MULTIMESH OUTPUT
+// ============================================================================
+
+void ForceGraphEngine::write_multimesh_buffer(const float* x, const float* y, int count, const double* bloch,
+                                              int bloch_size, float* out) const {
+    const float inv_two_pi = 0.159154943f;
+    for (int i = 0; i < count; i++) {
+        float scale = m_bubble_scale;
+        Color color(1.0f, 1.0f, 1.0f, 1.0f);
+        if (bloch_size >= (i + 1) * 8) {
+            const double* b = bloch + i * 8;  // [p0, p1, x, y, z, r, theta, phi]
+            const float radius = std::clamp(static_cast<float>(b[5]), 0.0f, 1.0f);
+            float hue = static_cast<float>(b[7]) * inv_two_pi;
+            hue -= std::floor(hue);
+            scale *= 0.5f + 0.5f * radius;
+            color = Color::from_hsv(hue, radius, 1.0f, 1.0f);
         }
+        // Transform2D rows (x.x, y.x, pad, origin.x, x.y, y.y, pad, origin.y), then color
+        float* dst = out + static_cast<int64_t>(i) * MULTIMESH_STRIDE;
+        dst[0] = scale;
+        dst[1] = 0.0f;
+        dst[2] = 0.0f;
+        dst[3] = x[i];
+        dst[4] = 0.0f;
+        dst[5] = scale;
+        dst[6] = 0.0f;
+        dst[7] = y[i];
+        dst[8] = color.r;
+        dst[9] = color.g;
+        dst[10] = color.b;
+        dst[11] = color.a;
+    }
+}
 
-        // 4. Repulsion forces (prevent overlap)
-        total_force += _calculate_repulsion_forces(i, new_positions[i], new_positions, frozen_mask);
+PackedFloat32Array ForceGraphEngine::get_layout_multimesh_buffer(int handle,
+                                                                 const PackedFloat64Array& bloch_packet) const {
+    PackedFloat32Array out;
+    const NodeBuffers* nodes = get_layout(handle);
+    if (!nodes) {
+        UtilityFunctions::push_warning("ForceGraphEngine: Invalid layout handle for get_layout_multimesh_buffer ", handle);
+        return out;
+    }
+    out.resize(static_cast<int64_t>(nodes->size()) * MULTIMESH_STRIDE);
+    write_multimesh_buffer(nodes->x.data(), nodes->y.data(), nodes->size(), bloch_packet.ptr(), bloch_packet.size(),
+                           out.ptrw());
+    return out;
+}
 
-        // Apply forces via velocity Verlet integration
-        new_velocities[i] += total_force * dt;
-        new_velocities[i] *= m_damping;
-        new_positions[i] += new_velocities[i] * dt;
+PackedFloat32Array ForceGraphEngine::build_multimesh_buffer(const PackedVector2Array& positions,
+                                                            const PackedFloat64Array& bloch_packet) const {
+    // Vector2 is two packed floats: split into x / y for the shared writer
+    const int count = positions.size();
+    std::vector<float> x(count), y(count);
+    for (int i = 0; i < count; i++) {
+        x[i] = positions[i].x;
+        y[i] = positions[i].y;
     }
+    PackedFloat32Array out;
+    out.resize(static_cast<int64_t>(count) * MULTIMESH_STRIDE);
+    write_multimesh_buffer(x.data(), y.data(), count, bloch_packet.ptr(), bloch_packet.size(), out.ptrw());
+    return out;
+}
+
+Dictionary ForceGraphEngine::update_positions_batch(
+    const PackedVector2Array& positions,
+    const PackedVector2Array& velocities,
+    const PackedFloat64Array& bloch_packets,
+    const PackedFloat64Array& mi_values,
+    const PackedInt32Array& mi_offsets,
+    const PackedInt32Array& node_offsets,
+    const PackedVector2Array& biome_centers,
+    float dt,
+    const PackedByteArray& frozen_mask
+) {
+    const int count = node_offsets.size() - 1;
+    const int num_nodes = positions.size();
+    auto offsets_valid = [](const PackedInt32Array& offsets, int limit) {
+        if (offsets.size() < 1 || offsets[0] != 0 || offsets[offsets.size() - 1] > limit) {
+            return false;
+        }
+        for (int b = 1; b < offsets.size(); b++) {
+            if (offsets[b] < offsets[b - 1]) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (count < 0 || !offsets_valid(node_offsets, num_nodes) || biome_centers.size() < count ||
+        (!mi_offsets.is_empty() && (mi_offsets.size() != count + 1 || !offsets_valid(mi_offsets, mi_values.size())))) {
+        UtilityFunctions::push_warning("ForceGraphEngine: update_positions_batch offsets don't match the buffers");
+        return Dictionary();
+    }
+
+    PackedVector2Array new_positions = positions;
+    PackedVector2Array new_velocities = velocities;
+    new_velocities.resize(num_nodes);  // Missing velocities start at rest
+    Vector2* pos_out = new_positions.ptrw();
+    Vector2* vel_out = new_velocities.ptrw();
+    const int32_t* node_off = node_offsets.ptr();
+
+    auto biome_range = [&](int begin, int end) {
+        // One node set per chunk, reused across its biomes
+        NodeBuffers nodes;
+        for (int b = begin; b < end; b++) {
+            const int first = node_off[b];
+            const int n = node_off[b + 1] - first;
+            if (n == 0) {
+                continue;
+            }
+            nodes.resize(n);
+            for (int i = 0; i < n; i++) {
+                nodes.x[i] = pos_out[first + i].x;
+                nodes.y[i] = pos_out[first + i].y;
+                nodes.vx[i] = vel_out[first + i].x;
+                nodes.vy[i] = vel_out[first + i].y;
+            }
+
+            StepInputs in;
+            const int bloch_first = first * 8;
+            in.bloch = bloch_packets.ptr() + std::min(bloch_first, (int)bloch_packets.size());
+            in.bloch_size = std::max(0, std::min(n * 8, (int)bloch_packets.size() - bloch_first));
+            if (!mi_offsets.is_empty()) {
+                in.mi = mi_values.ptr() + mi_offsets[b];
+                in.mi_size = mi_offsets[b + 1] - mi_offsets[b];
+            }
+            in.frozen = frozen_mask.ptr() + std::min(first, (int)frozen_mask.size());
+            in.frozen_size = std::max(0, std::min(n, (int)frozen_mask.size() - first));
+            in.center_x = biome_centers[b].x;
+            in.center_y = biome_centers[b].y;
+            in.dt = dt;
+            step_nodes(nodes, in);
+
+            for (int i = 0; i < n; i++) {
+                pos_out[first + i] = Vector2(nodes.x[i], nodes.y[i]);
+                vel_out[first + i] = Vector2(nodes.vx[i], nodes.vy[i]);
+            }
+        }
+    };
+    // Biomes write disjoint node ranges; a single biome runs inline
+    NativeThreadPool::shared().parallel_for(0, count, count, biome_range);
 
-    // Return updated positions and velocities
     Dictionary result;
     result["positions"] = new_positions;
     result["velocities"] = new_velocities;
     return result;
 }
 
-Vector2 ForceGraphEngine::_calculate_purity_radial_force(
-    int node_idx,
-    Vector2 position,
-    const PackedFloat64Array& bloch_packet,
-    Vector2 biome_center
-) {
-    // Bloch packet: [p0, p1, x, y, z, r, theta, phi] per qubit (stride=8)
-    int offset = node_idx * 8;
-    if (offset + 7 >= bloch_packet.size()) {
-        return Vector2(0, 0);
+void ForceGraphEngine::set_layout_radii(int handle, const PackedFloat32Array& radii) {
+    NodeBuffers* nodes = _checked_layout(handle, "set_layout_radii");
+    if (!nodes) {
+        return;
     }
+    nodes->custom_radii = !radii.is_empty();
+    for (int i = 0; i < nodes->size(); i++) {
+        nodes->radius[i] = i < radii.size() ? radii[i] : 0.0f;
+    }
+}
 
-    // Get purity from p0^2 + p1^2 (populations)
-    double p0 = bloch_packet[offset];
-    double p1 = bloch_packet[offset + 1];
-    double purity = std::abs(p0 - p1);  // Purity ≈ |p0 - p1| for single qubit
+void ForceGraphEngine::step_nodes(NodeBuffers& nodes, const StepInputs& in) const {
+    NATIVE_TRACE_ZONE("force_update");
+    NativeCounters::add(COUNTER_FORCE_NODES, static_cast<uint64_t>(nodes.size()));
+    _prepare_nodes(nodes, in);
 
-    // Target radius: pure states (purity=1) → center, mixed (purity=0) → edge
-    double target_radius = m_max_biome_radius * (1.0 - purity);
+    const StepKernel kernel = _select_kernel(in);
+    if (m_fixed_timestep <= 0.0f || in.dt <= 0.0f) {
+        (this->*kernel)(nodes, in, in.dt, m_damping);
+        return;
+    }
 
-    // Current radius from biome center
-    Vector2 delta = position - biome_center;
-    double current_radius = delta.length();
+    int substeps;
+    float h;
+    if (in.accumulate) {
+        // Whole fixed steps out of the accumulated time; past the cap the
+        // backlog is dropped rather than chased (no spiral of death)
+        h = m_fixed_timestep;
+        nodes.time_accumulator += in.dt;
+        substeps = static_cast<int>(nodes.time_accumulator / h);
+        if (substeps > m_max_substeps) {
+            substeps = m_max_substeps;
+            nodes.time_accumulator = std::fmod(nodes.time_accumulator, h);
+        } else {
+            nodes.time_accumulator -= substeps * h;
+        }
+    } else {
+        substeps = std::clamp(static_cast<int>(std::ceil(in.dt / m_fixed_timestep)), 1, m_max_substeps);
+        h = in.dt / substeps;
+    }
 
-    if (current_radius < 1e-6) {
-        // At center, push outward if target > 0
-        if (target_radius > 1.0) {
-            return Vector2(1, 0) * m_purity_radial_spring * target_radius;
+    // damping is per caller step: spread it so each second loses the same energy
+    const float damping = std::pow(m_damping, h / in.dt);
+    for (int s = 0; s < substeps; s++) {
+        (this->*kernel)(nodes, in, h, damping);
+    }
+}
+
+void ForceGraphEngine::_prepare_nodes(NodeBuffers& nodes, const StepInputs& in) const {
+    const int n = nodes.size();
+    if (static_cast<int>(nodes.fx.size()) != n || static_cast<int>(nodes.asleep.size()) != n) {
+        nodes.resize(n);
+    }
+    // Compact list of non-frozen nodes: pair loops walk it instead of testing
+    // the frozen mask for every j
+    nodes.active.clear();
+    for (int i = 0; i < n; i++) {
+        const bool frozen = i < in.frozen_size && in.frozen[i] != 0;
+        nodes.weight[i] = frozen ? 0.0f : 1.0f;
+        if (!frozen) {
+            nodes.active.push_back(i);
         }
-        return Vector2(0, 0);
     }
+    _gather_node_inputs(nodes, in);
+}
 
-    // Spring force: F = k * (target - current)
-    double radial_error = target_radius - current_radius;
-    Vector2 radial_direction = delta / current_radius;
-    return radial_direction * (m_purity_radial_spring * radial_error);
+ForceGraphEngine::StepKernel ForceGraphEngine::_select_kernel(const StepInputs& in, bool relax) const {
+    // Indexed by radial | angular << 1 | correlation << 2 | repulsion << 3
+    static constexpr StepKernel relax_kernels[16] = {
+        &ForceGraphEngine::_relax_once<false, false, false, false>,
+        &ForceGraphEngine::_relax_once<true, false, false, false>,
+        &ForceGraphEngine::_relax_once<false, true, false, false>,
+        &ForceGraphEngine::_relax_once<true, true, false, false>,
+        &ForceGraphEngine::_relax_once<false, false, true, false>,
+        &ForceGraphEngine::_relax_once<true, false, true, false>,
+        &ForceGraphEngine::_relax_once<false, true, true, false>,
+        &ForceGraphEngine::_relax_once<true, true, true, false>,
+        &ForceGraphEngine::_relax_once<false, false, false, true>,
+        &ForceGraphEngine::_relax_once<true, false, false, true>,
+        &ForceGraphEngine::_relax_once<false, true, false, true>,
+        &ForceGraphEngine::_relax_once<true, true, false, true>,
+        &ForceGraphEngine::_relax_once<false, false, true, true>,
+        &ForceGraphEngine::_relax_once<true, false, true, true>,
+        &ForceGraphEngine::_relax_once<false, true, true, true>,
+        &ForceGraphEngine::_relax_once<true, true, true, true>,
+    };
+    static constexpr StepKernel kernels[16] = {
+        &ForceGraphEngine::_step_once<false, false, false, false>,
+        &ForceGraphEngine::_step_once<true, false, false, false>,
+        &ForceGraphEngine::_step_once<false, true, false, false>,
+        &ForceGraphEngine::_step_once<true, true, false, false>,
+        &ForceGraphEngine::_step_once<false, false, true, false>,
+        &ForceGraphEngine::_step_once<true, false, true, false>,
+        &ForceGraphEngine::_step_once<false, true, true, false>,
+        &ForceGraphEngine::_step_once<true, true, true, false>,
+        &ForceGraphEngine::_step_once<false, false, false, true>,
+        &ForceGraphEngine::_step_once<true, false, false, true>,
+        &ForceGraphEngine::_step_once<false, true, false, true>,
+        &ForceGraphEngine::_step_once<true, true, false, true>,
+        &ForceGraphEngine::_step_once<false, false, true, true>,
+        &ForceGraphEngine::_step_once<true, false, true, true>,
+        &ForceGraphEngine::_step_once<false, true, true, true>,
+        &ForceGraphEngine::_step_once<true, true, true, true>,
+    };
+    const bool has_bloch = in.bloch_size >= 8;
+    const bool radial = has_bloch && m_purity_radial_spring != 0.0f;
+    const bool angular = has_bloch && m_phase_angular_spring != 0.0f;
+    const bool correlation = m_mi_spring != 0.0f && (in.mi_edges ? in.mi_edge_count > 0 : in.mi_size > 0);
+    const bool repulsion = m_repulsion_strength != 0.0f;
+    const int index = radial | angular << 1 | correlation << 2 | repulsion << 3;
+    return relax ? relax_kernels[index] : kernels[index];
 }
 
-Vector2 ForceGraphEngine::_calculate_phase_angular_force(
-    int node_idx,
-    Vector2 position,
-    const PackedFloat64Array& bloch_packet,
-    Vector2 biome_center
-) {
-    // Bloch packet: [p0, p1, x, y, z, r, theta, phi] per qubit
-    int offset = node_idx * 8;
-    if (offset + 7 >= bloch_packet.size()) {
-        return Vector2(0, 0);
+template <bool Radial, bool Angular, bool Correlation, bool Repulsion>
+bool ForceGraphEngine::_accumulate_forces(NodeBuffers& nodes, const StepInputs& in) const {
+    std::fill(nodes.fx.begin(), nodes.fx.end(), 0.0f);
+    std::fill(nodes.fy.begin(), nodes.fy.end(), 0.0f);
+    _update_awake_set(nodes);
+    if (nodes.awake.empty()) {
+        return false;
     }
 
-    // Get theta (polar angle on Bloch sphere)
-    double theta = bloch_packet[offset + 6];
+    // 1 + 2. Purity radial and phase angular forces
+    if (Radial || Angular) {
+        _accumulate_node_forces<Radial, Angular>(nodes, in);
+    }
 
-    // Convert to angular position around biome center
-    Vector2 delta = position - biome_center;
-    double current_radius = delta.length();
+    // 3 + 4. Correlation springs and repulsion. Dense MI and exact repulsion
+    // both walk every active pair, so they share one fused pair loop
+    const bool dense_mi = Correlation && !in.mi_edges;
+    const bool exact = Repulsion && m_repulsion_mode == REPULSION_EXACT;
+    if (Correlation && in.mi_edges) {
+        _accumulate_edge_forces(nodes, in);
+    }
+    if (dense_mi && exact) {
+        _accumulate_pair_forces<true, true>(nodes, in);
+    } else if (dense_mi) {
+        _accumulate_pair_forces<true, false>(nodes, in);
+    } else if (exact) {
+        _accumulate_pair_forces<false, true>(nodes, in);
+    }
+    if (Repulsion && m_repulsion_mode == REPULSION_BARNES_HUT) {
+        _accumulate_repulsion_barnes_hut(nodes);
+    } else if (Repulsion && m_repulsion_mode == REPULSION_GRID) {
+        _accumulate_repulsion_grid(nodes);
+    }
+    return true;
+}
 
-    if (current_radius < 1e-6) {
-        return Vector2(0, 0);
+template <bool Radial, bool Angular, bool Correlation, bool Repulsion>
+void ForceGraphEngine::_step_once(NodeBuffers& nodes, const StepInputs& in, float dt, float damping) const {
+    if (!_accumulate_forces<Radial, Angular, Correlation, Repulsion>(nodes, in)) {
+        return;  // Everything frozen or asleep: the layout is unchanged
     }
 
-    // Current angle
-    double current_angle = std::atan2(delta.y, delta.x);
+    // Semi-implicit Euler with damping; frozen and sleeping nodes keep position and velocity
+    float* x = nodes.x.data();
+    float* y = nodes.y.data();
+    float* vx = nodes.vx.data();
+    float* vy = nodes.vy.data();
+    const float* fx = nodes.fx.data();
+    const float* fy = nodes.fy.data();
+    const float* m = nodes.moving.data();
+    const int n = nodes.size();
+    for (int i = 0; i < n; i++) {
+        const float nvx = (vx[i] + fx[i] * dt) * damping;
+        const float nvy = (vy[i] + fy[i] * dt) * damping;
+        vx[i] = m[i] > 0.0f ? nvx : vx[i];
+        vy[i] = m[i] > 0.0f ? nvy : vy[i];
+        x[i] += m[i] * vx[i] * dt;
+        y[i] += m[i] * vy[i] * dt;
+    }
 
-    // Target angle based on phase
-    double target_angle = theta;
+    if (m_collision_enabled) {
+        _resolve_collisions(nodes);
+    }
+    if (m_sleep_enabled) {
+        _update_sleep_counters(nodes);
+    }
+}
+
+template <bool Radial, bool Angular, bool Correlation, bool Repulsion>
+void ForceGraphEngine::_relax_once(NodeBuffers& nodes, const StepInputs& in, float scale, float max_step) const {
+    if (!_accumulate_forces<Radial, Angular, Correlation, Repulsion>(nodes, in)) {
+        return;
+    }
+    const float max_step2 = max_step * max_step;
+    for (int i : nodes.awake) {
+        float dx = nodes.fx[i] * scale;
+        float dy = nodes.fy[i] * scale;
+        const float len2 = dx * dx + dy * dy;
+        if (len2 > max_step2) {
+            const float shrink = max_step / std::sqrt(len2);
+            dx *= shrink;
+            dy *= shrink;
+        }
+        nodes.x[i] += dx;
+        nodes.y[i] += dy;
+    }
+    if (m_collision_enabled) {
+        _resolve_collisions(nodes);
+    }
+}
 
-    // Angular error (wrap to [-π, π])
-    double angular_error = target_angle - current_angle;
-    while (angular_error > M_PI) angular_error -= 2.0 * M_PI;
-    while (angular_error < -M_PI) angular_error += 2.0 * M_PI;
+void ForceGraphEngine::_resolve_collisions(NodeBuffers& nodes) const {
+    float* x = nodes.x.data();
+    float* y = nodes.y.data();
+    float* vx = nodes.vx.data();
+    float* vy = nodes.vy.data();
+    const float* r = nodes.radius.data();
+    const float* w = nodes.weight.data();
+    // Frozen nodes take part as immovable obstacles
+    const int count = nodes.size();
+    std::vector<int>& sweep = nodes.sweep;
+    sweep.resize(count);
+    std::iota(sweep.begin(), sweep.end(), 0);
 
-    // Tangent force (perpendicular to radial)
-    Vector2 tangent = Vector2(-delta.y, delta.x) / current_radius;
-    return tangent * (m_phase_angular_spring * angular_error * current_radius);
+    for (int pass = 0; pass < m_collision_iterations; pass++) {
+        // Sort-and-sweep on x: after ordering by left edge, i can only touch
+        // the nodes whose left edge starts before its right edge ends
+        std::sort(sweep.begin(), sweep.end(), [x, r](int a, int b) { return x[a] - r[a] < x[b] - r[b]; });
+        bool separated = true;
+        for (int a = 0; a < count; a++) {
+            const int i = sweep[a];
+            for (int b = a + 1; b < count; b++) {
+                const int j = sweep[b];
+                if (x[j] - r[j] > x[i] + r[i]) {
+                    break;
+                }
+                if (nodes.asleep[i] && nodes.asleep[j]) {
+                    continue;  // Neither moved since they were last separated
+                }
+                const float total = w[i] + w[j];
+                const float reach = r[i] + r[j];
+                const float dx = x[j] - x[i];
+                const float dy = y[j] - y[i];
+                const float d2 = dx * dx + dy * dy;
+                if (total == 0.0f || d2 >= reach * reach) {
+                    continue;
+                }
+
+                // Project both to touching along the centre line, shares by
+                // mobility (frozen nodes don't move)
+                float nx, ny, overlap;
+                if (d2 < COINCIDENT_DIST2) {
+                    coincident_direction(j, nx, ny);
+                    overlap = reach;
+                } else {
+                    const float d = std::sqrt(d2);
+                    nx = dx / d;
+                    ny = dy / d;
+                    overlap = reach - d;
+                }
+                const float share_i = w[i] / total;
+                const float share_j = w[j] / total;
+                x[i] -= nx * overlap * share_i;
+                y[i] -= ny * overlap * share_i;
+                x[j] += nx * overlap * share_j;
+                y[j] += ny * overlap * share_j;
+
+                // Inelastic contact: drop the approaching normal velocity
+                const float closing = (vx[j] - vx[i]) * nx + (vy[j] - vy[i]) * ny;
+                if (closing < 0.0f) {
+                    vx[i] += nx * closing * share_i;
+                    vy[i] += ny * closing * share_i;
+                    vx[j] -= nx * closing * share_j;
+                    vy[j] -= ny * closing * share_j;
+                }
+                for (int k : {i, j}) {
+                    if (w[k] > 0.0f) {
+                        nodes.asleep[k] = 0;
+                        nodes.still_frames[k] = 0;
+                    }
+                }
+                separated = false;
+            }
+        }
+        if (separated) {
+            break;
+        }
+    }
 }
 
-Vector2 ForceGraphEngine::_calculate_correlation_forces(
-    int node_idx,
-    Vector2 position,
-    const PackedVector2Array& all_positions,
-    const PackedFloat64Array& mi_values,
-    const PackedByteArray& frozen_mask
-) {
-    Vector2 total_force = Vector2(0, 0);
-    int num_nodes = all_positions.size();
+void ForceGraphEngine::_gather_node_inputs(NodeBuffers& nodes, const StepInputs& in) const {
+    const int n = nodes.size();
 
-    for (int j = 0; j < num_nodes; j++) {
-        if (j == node_idx) continue;
+    // Per-node inputs out of the stride-8 Bloch packet:
+    // [p0, p1, x, y, z, r, theta, phi]. target_radius < 0 marks a missing entry.
+    for (int i = 0; i < n; i++) {
+        if (in.bloch_size >= (i + 1) * 8) {
+            const double* b = in.bloch + i * 8;
+            const double purity = std::abs(b[0] - b[1]);  // Purity ≈ |p0 - p1| for single qubit
+            // Target radius: pure states (purity=1) → center, mixed (purity=0) → edge
+            nodes.target_radius[i] = static_cast<float>(m_max_biome_radius * (1.0 - purity));
+            nodes.theta[i] = static_cast<float>(b[6]);
+        } else {
+            nodes.target_radius[i] = -1.0f;
+            nodes.theta[i] = 0.0f;
+        }
+    }
 
-        // Skip frozen nodes
-        if (frozen_mask.size() > j && frozen_mask[j] != 0) {
+    if (m_collision_enabled) {
+        // Same size rule as the MultiMesh scale, so contacts match the drawn bubbles
+        for (int i = 0; i < n; i++) {
+            if (nodes.custom_radii && nodes.radius[i] > 0.0f) {
+                continue;
+            }
+            float scale = 1.0f;
+            if (in.bloch_size >= (i + 1) * 8) {
+                scale = 0.5f + 0.5f * std::clamp(static_cast<float>(in.bloch[i * 8 + 5]), 0.0f, 1.0f);
+            }
+            nodes.radius[i] = m_collision_radius * scale;
+        }
+    }
+
+    if (!m_sleep_enabled) {
+        return;
+    }
+    std::fill(nodes.mi_sum.begin(), nodes.mi_sum.end(), 0.0f);
+    float* mi_sum = nodes.mi_sum.data();
+    if (in.mi_edges) {
+        for (int e = 0; e < in.mi_edge_count; e++) {
+            const double* edge = in.mi_edges + e * 3;
+            const int i = static_cast<int>(edge[0]);
+            const int j = static_cast<int>(edge[1]);
+            if (i >= 0 && j >= 0 && i < n && j < n) {
+                mi_sum[i] += static_cast<float>(edge[2]);
+                mi_sum[j] += static_cast<float>(edge[2]);
+            }
+        }
+    } else {
+        int idx = 0;
+        for (int i = 0; i < n && idx < in.mi_size; i++) {
+            for (int j = i + 1; j < n && idx < in.mi_size; j++, idx++) {
+                mi_sum[i] += static_cast<float>(in.mi[idx]);
+                mi_sum[j] += static_cast<float>(in.mi[idx]);
+            }
+        }
+    }
+}
+
+void ForceGraphEngine::_update_awake_set(NodeBuffers& nodes) const {
+    if (!m_sleep_enabled) {
+        nodes.wake_all();
+    } else {
+        const float two_pi = 6.28318530718f;
+        const float tol = m_sleep_input_tolerance;
+        const float radius_tol = tol * m_max_biome_radius;  // Target radius is R·(1 - purity)
+        for (int i : nodes.active) {
+            if (!nodes.asleep[i]) {
+                continue;
+            }
+            float phase_delta = nodes.theta[i] - nodes.sleep_theta[i];
+            phase_delta -= two_pi * std::nearbyint(phase_delta / two_pi);
+            if (std::abs(nodes.target_radius[i] - nodes.sleep_target_radius[i]) > radius_tol ||
+                std::abs(phase_delta) > tol || std::abs(nodes.mi_sum[i] - nodes.sleep_mi[i]) > tol) {
+                nodes.asleep[i] = 0;
+                nodes.still_frames[i] = 0;
+            }
+        }
+
+        // A node moving faster than the sleep threshold wakes sleepers within
+        // base_distance (the layout's interaction scale)
+        const float wake_radius2 = m_base_distance * m_base_distance;
+        const float moving2 = m_sleep_velocity * m_sleep_velocity;
+        for (int a : nodes.active) {
+            if (nodes.asleep[a] || nodes.vx[a] * nodes.vx[a] + nodes.vy[a] * nodes.vy[a] <= moving2) {
+                continue;
+            }
+            for (int j : nodes.active) {
+                if (!nodes.asleep[j]) {
+                    continue;
+                }
+                const float dx = nodes.x[j] - nodes.x[a];
+                const float dy = nodes.y[j] - nodes.y[a];
+                if (dx * dx + dy * dy < wake_radius2) {
+                    nodes.asleep[j] = 0;
+                    nodes.still_frames[j] = 0;
+                }
+            }
+        }
+    }
+
+    nodes.awake.clear();
+    std::fill(nodes.moving.begin(), nodes.moving.end(), 0.0f);
+    for (int i : nodes.active) {
+        if (!nodes.asleep[i]) {
+            nodes.moving[i] = 1.0f;
+            nodes.awake.push_back(i);
+        }
+    }
+}
+
+void ForceGraphEngine::_update_sleep_counters(NodeBuffers& nodes) const {
+    const float speed2 = m_sleep_velocity * m_sleep_velocity;
+    const float force2 = m_sleep_force * m_sleep_force;
+    for (int i : nodes.awake) {
+        const float v2 = nodes.vx[i] * nodes.vx[i] + nodes.vy[i] * nodes.vy[i];
+        const float f2 = nodes.fx[i] * nodes.fx[i] + nodes.fy[i] * nodes.fy[i];
+        if (v2 >= speed2 || f2 >= force2) {
+            nodes.still_frames[i] = 0;
             continue;
         }
+        if (++nodes.still_frames[i] < m_sleep_frames) {
+            continue;
+        }
+        nodes.asleep[i] = 1;
+        nodes.vx[i] = 0.0f;
+        nodes.vy[i] = 0.0f;
+        nodes.sleep_target_radius[i] = nodes.target_radius[i];
+        nodes.sleep_theta[i] = nodes.theta[i];
+        nodes.sleep_mi[i] = nodes.mi_sum[i];
+    }
+}
 
-        // Get MI value
-        int mi_idx = _mi_index(node_idx, j, num_nodes);
-        if (mi_idx < 0 || mi_idx >= mi_values.size()) {
+template <bool Radial, bool Angular>
+void ForceGraphEngine::_accumulate_node_forces(NodeBuffers& nodes, const StepInputs& in) const {
+    const float k_radial = m_purity_radial_spring;
+    const float k_angular = m_phase_angular_spring;
+    const float two_pi = 6.28318530718f;
+    for (int i : nodes.awake) {
+        const float target = nodes.target_radius[i];
+        if (target < 0.0f) {
             continue;
         }
+        const float dx = nodes.x[i] - in.center_x;
+        const float dy = nodes.y[i] - in.center_y;
+        float fx = 0.0f;
+        float fy = 0.0f;
+        if (Radial) {
+            const float r = std::sqrt(dx * dx + dy * dy);
+            if (r < 1e-6f) {
+                // At center, push outward if target > 0 (no defined angle)
+                if (target > 1.0f) {
+                    nodes.fx[i] += k_radial * target;
+                }
+                continue;
+            }
+            // Radial spring: F = k * (target - current) along the radius
+            const float radial = k_radial * (target - r) / r;
+            fx += dx * radial;
+            fy += dy * radial;
+        } else if (dx * dx + dy * dy < 1e-12f) {
+            continue;  // No defined angle at the center
+        }
+        if (Angular) {
+            // Angular spring toward the phase angle, wrapped to [-π, π], along
+            // the tangent (-dy, dx)/r with magnitude k * error * r
+            float angular_error = nodes.theta[i] - std::atan2(dy, dx);
+            angular_error -= two_pi * std::nearbyint(angular_error / two_pi);
+            const float tangential = k_angular * angular_error;
+            fx -= dy * tangential;
+            fy += dx * tangential;
+        }
+        nodes.fx[i] += fx;
+        nodes.fy[i] += fy;
+    }
+}
 
-        double mi = mi_values[mi_idx];
-        if (mi < 1e-6) continue;  // Skip if no correlation
+template <bool Correlation, bool Repulsion>
+void ForceGraphEngine::_accumulate_pair_forces(NodeBuffers& nodes, const StepInputs& in) const {
+    const int n = nodes.size();
+    const float* x = nodes.x.data();
+    const float* y = nodes.y.data();
+    const float* m = nodes.moving.data();
+    float* fx = nodes.fx.data();
+    float* fy = nodes.fy.data();
+    float* coincident = nodes.coincident.data();  // Active nodes on top of each node
+    const float strength = m_repulsion_strength;
+    const CorrelationSpring spring{m_mi_spring, m_base_distance, m_correlation_scaling, m_min_distance};
+    const int* active = nodes.active.data();
+    const int active_count = static_cast<int>(nodes.active.size());
+    const int* awake = nodes.awake.data();
+    const int awake_count = static_cast<int>(nodes.awake.size());
+    int awake_cursor = 0;  // First awake index > i
+    if (Repulsion) {
+        for (int a = 0; a < active_count; a++) {
+            coincident[active[a]] = 0.0f;
+        }
+    }
 
-        // Distance between nodes
-        Vector2 delta = all_positions[j] - position;
-        double dist = delta.length();
+    // Force on i from j (minus on j) for one pair: repulsion F = STRENGTH /
+    // dist^2 plus the MI spring. Branch-free; near counts coincident pairs.
+    // MI row i starts at i·n - i(i+1)/2; j at or past j_end has no MI entry
+    auto pair = [&](int i, int j, const double* mi_row, int j_end, float& pfx, float& pfy, float& near) {
+        const float dx = x[i] - x[j];
+        const float dy = y[i] - y[j];
+        const float d2 = dx * dx + dy * dy;
+        float f = 0.0f;
+        if (Repulsion) {
+            const bool is_near = d2 < COINCIDENT_DIST2;
+            f += is_near ? 0.0f : strength / (d2 * std::sqrt(d2));
+            near = is_near ? 1.0f : 0.0f;
+        }
+        if (Correlation) {
+            const float mi = j < j_end ? static_cast<float>(mi_row[j - i - 1]) : 0.0f;
+            f -= spring(mi, d2);  // Spring pulls i toward j
+        }
+        pfx = dx * f;
+        pfy = dy * f;
+    };
 
-        if (dist < 1e-6) continue;
+    for (int a = 0; a < active_count; a++) {
+        const int i = active[a];
+        while (awake_cursor < awake_count && awake[awake_cursor] <= i) {
+            awake_cursor++;
+        }
+        int row = 0;
+        int j_end = 0;
+        if (Correlation) {
+            row = i * n - i * (i + 1) / 2;
+            j_end = row < in.mi_size ? std::min(n, i + 1 + (in.mi_size - row)) : 0;
+            if (!Repulsion && j_end == 0) {
+                break;  // Later rows start further in
+            }
+        }
+        const double* mi_row = Correlation ? in.mi + std::min(row, in.mi_size) : nullptr;
+        // Without repulsion, pairs past the MI row exert nothing
+        const int j_stop = Repulsion ? n : j_end;
 
-        // Target distance decreases with MI: d_target = BASE / (1 + SCALING * mi)
-        double target_distance = m_base_distance / (1.0 + m_correlation_scaling * mi);
-        target_distance = std::max(target_distance, (double)m_min_distance);
+        if (m[i] == 0.0f) {
+            // Sleeping i only acts on the awake nodes after it
+            for (int c = awake_cursor; c < awake_count && awake[c] < j_stop; c++) {
+                const int j = awake[c];
+                float pfx, pfy, near = 0.0f;
+                pair(i, j, mi_row, j_end, pfx, pfy, near);
+                fx[j] -= pfx;
+                fy[j] -= pfy;
+                if (Repulsion) {
+                    coincident[j] += near;
+                }
+            }
+            continue;
+        }
 
-        // Spring force
-        double error = dist - target_distance;
-        Vector2 direction = delta / dist;
-        total_force += direction * (m_mi_spring * error);
+        float fxi = 0.0f;
+        float fyi = 0.0f;
+        float near_i = 0.0f;
+        for (int b = a + 1; b < active_count && active[b] < j_stop; b++) {
+            const int j = active[b];
+            float pfx, pfy, near = 0.0f;
+            pair(i, j, mi_row, j_end, pfx, pfy, near);
+            fxi += pfx;
+            fyi += pfy;
+            fx[j] -= pfx;  // Equal and opposite
+            fy[j] -= pfy;
+            if (Repulsion) {
+                near_i += near;
+                coincident[j] += near;
+            }
+        }
+        fx[i] += fxi;
+        fy[i] += fyi;
+        if (Repulsion) {
+            coincident[i] += near_i;
+        }
     }
 
-    return total_force;
+    if (Repulsion) {
+        // Very close nodes - push apart strongly (each along its own fixed direction)
+        for (int i : nodes.awake) {
+            if (coincident[i] > 0.0f) {
+                float ux, uy;
+                coincident_direction(i, ux, uy);
+                fx[i] += coincident[i] * ux * strength;
+                fy[i] += coincident[i] * uy * strength;
+            }
+        }
+    }
 }
 
-Vector2 ForceGraphEngine::_calculate_repulsion_forces(
-    int node_idx,
-    Vector2 position,
-    const PackedVector2Array& all_positions,
-    const PackedByteArray& frozen_mask
-) {
-    Vector2 total_force = Vector2(0, 0);
-    int num_nodes = all_positions.size();
+void ForceGraphEngine::_accumulate_edge_forces(NodeBuffers& nodes, const StepInputs& in) const {
+    const int n = nodes.size();
+    const float* x = nodes.x.data();
+    const float* y = nodes.y.data();
+    const float* w = nodes.weight.data();
+    const float* m = nodes.moving.data();
+    float* fx = nodes.fx.data();
+    float* fy = nodes.fy.data();
+    const CorrelationSpring spring{m_mi_spring, m_base_distance, m_correlation_scaling, m_min_distance};
 
-    for (int j = 0; j < num_nodes; j++) {
-        if (j == node_idx) continue;
+    for (int e = 0; e < in.mi_edge_count; e++) {
+        const double* edge = in.mi_edges + e * 3;
+        const int i = static_cast<int>(edge[0]);
+        const int j = static_cast<int>(edge[1]);
+        if (i < 0 || j < 0 || i >= n || j >= n || i == j || w[i] == 0.0f || w[j] == 0.0f ||
+            (m[i] == 0.0f && m[j] == 0.0f)) {
+            continue;  // Invalid, frozen end, or both asleep
+        }
+        const float dx = x[j] - x[i];
+        const float dy = y[j] - y[i];
+        const float f = spring(static_cast<float>(edge[2]), dx * dx + dy * dy);
+        fx[i] += dx * f;
+        fy[i] += dy * f;
+        fx[j] -= dx * f;
+        fy[j] -= dy * f;
+    }
+}
 
-        // Skip frozen nodes
-        if (frozen_mask.size() > j && frozen_mask[j] != 0) {
+void ForceGraphEngine::_accumulate_repulsion_barnes_hut(NodeBuffers& nodes) const {
+    const RepulsionQuadTree tree(nodes.x.data(), nodes.y.data(), nodes.active);
+    for (int i : nodes.awake) {
+        tree.force_on(i, nodes.x[i], nodes.y[i], m_barnes_hut_theta, m_repulsion_strength, nodes.fx[i], nodes.fy[i]);
+    }
+}
+
+void ForceGraphEngine::_accumulate_repulsion_grid(NodeBuffers& nodes) const {
+    const float* x = nodes.x.data();
+    const float* y = nodes.y.data();
+    const float strength = m_repulsion_strength;
+    const float cutoff2 = m_repulsion_cutoff * m_repulsion_cutoff;
+    const SpatialHash grid(x, y, nodes.active, m_repulsion_cutoff);
+
+    // Sleeping nodes are in the grid (they exert force) but need none
+    for (int i : nodes.awake) {
+        float fx = 0.0f;
+        float fy = 0.0f;
+        grid.for_each_near(x[i], y[i], [&](int j) {
+            if (j != i) {
+                repulsion_within(i, x[i] - x[j], y[i] - y[j], cutoff2, strength, fx, fy);
+            }
+        });
+        nodes.fx[i] += fx;
+        nodes.fy[i] += fy;
+    }
+}
+
+void ForceGraphEngine::repel_between(const std::vector<NodeBuffers*>& sets, float dt) const {
+    // Flatten every non-frozen node of every set (frozen = weight 0 on the
+    // set's last step) into one point list
+    std::vector<float> px, py;
+    std::vector<int> owner, local, indices;
+    for (int s = 0; s < static_cast<int>(sets.size()); s++) {
+        const NodeBuffers* nodes = sets[s];
+        if (!nodes) {
             continue;
         }
+        for (int i = 0; i < nodes->size(); i++) {
+            if (i < static_cast<int>(nodes->weight.size()) && nodes->weight[i] == 0.0f) {
+                continue;
+            }
+            indices.push_back(static_cast<int>(px.size()));
+            px.push_back(nodes->x[i]);
+            py.push_back(nodes->y[i]);
+            owner.push_back(s);
+            local.push_back(i);
+        }
+    }
+    if (indices.empty()) {
+        return;
+    }
 
-        Vector2 delta = position - all_positions[j];
-        double dist = delta.length();
+    // Only pairs from different sets: in-set pairs are the per-set kernel's job
+    const float strength = m_repulsion_strength;
+    const float cutoff2 = m_repulsion_cutoff * m_repulsion_cutoff;
+    const SpatialHash grid(px.data(), py.data(), indices, m_repulsion_cutoff);
+    std::vector<float> fx(px.size(), 0.0f), fy(px.size(), 0.0f);
+    for (int p : indices) {
+        grid.for_each_near(px[p], py[p], [&](int q) {
+            if (owner[q] != owner[p]) {
+                repulsion_within(local[p], px[p] - px[q], py[p] - py[q], cutoff2, strength, fx[p], fy[p]);
+            }
+        });
+    }
 
-        if (dist < 1e-6) {
-            // Very close nodes - push apart strongly
-            total_force += Vector2((node_idx % 2 == 0) ? 1 : -1, (node_idx / 2 % 2 == 0) ? 1 : -1).normalized() * m_repulsion_strength;
+    // Kick with the integrator's semi-implicit update; a pushed sleeper wakes
+    for (int p : indices) {
+        if (fx[p] == 0.0f && fy[p] == 0.0f) {
             continue;
         }
-
-        // Inverse square repulsion: F = STRENGTH / dist^2
-        double repulsion_mag = m_repulsion_strength / (dist * dist);
-        Vector2 direction = delta / dist;
-        total_force += direction * repulsion_mag;
+        NodeBuffers& nodes = *sets[owner[p]];
+        const int i = local[p];
+        nodes.vx[i] += fx[p] * dt;
+        nodes.vy[i] += fy[p] * dt;
+        nodes.x[i] += fx[p] * dt * dt;
+        nodes.y[i] += fy[p] * dt * dt;
+        if (i < static_cast<int>(nodes.asleep.size())) {
+            nodes.asleep[i] = 0;
+            nodes.still_frames[i] = 0;
+        }
     }
+}
 
-    return total_force;
+void ForceGraphEngine::repel_layouts(const PackedInt32Array& handles, float dt) {
+    std::vector<NodeBuffers*> sets;
+    sets.reserve(handles.size());
+    for (int k = 0; k < handles.size(); k++) {
+        NodeBuffers* nodes = _checked_layout(handles[k], "repel_layouts");
+        if (nodes) {
+            sets.push_back(nodes);
+        }
+    }
+    repel_between(sets, dt);
 }
 
-int ForceGraphEngine::_mi_index(int i, int j, int num_qubits) const {
-    // MI array is upper triangular: [mi_01, mi_02, mi_03, ..., mi_12, mi_13, ...]
-    if (i == j) return -1;
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+namespace {
 
-    int row = std::min(i, j);
-    int col = std::max(i, j);
+// Synthetic biome: Bloch packet, dense MI triangle with its edge list,
+// frozen mask and start positions in a disk around the origin
+struct SyntheticLayout {
+    PackedVector2Array positions;
+    PackedVector2Array velocities;
+    PackedFloat64Array bloch;
+    PackedFloat64Array mi;
+    PackedFloat64Array mi_edges;
+    PackedByteArray frozen;
 
-    // Index = sum(num_qubits - 1 - k for k in 0..row-1) + (col - row - 1)
-    //       = row * num_qubits - row*(row+1)/2 + (col - row - 1)
-    return row * num_qubits - (row * (row + 1)) / 2 + (col - row - 1);
+    SyntheticLayout(int n, float mi_density, float frozen_ratio, std::mt19937& rng) {
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        const double pi = 3.14159265358979;
+        positions.resize(n);
+        velocities.resize(n);
+        bloch.resize(static_cast<int64_t>(n) * 8);
+        frozen.resize(n);
+        for (int i = 0; i < n; i++) {
+            const double angle = 2.0 * pi * unit(rng);
+            const double radius = 250.0 * std::sqrt(unit(rng));
+            positions.set(i, Vector2(radius * std::cos(angle), radius * std::sin(angle)));
+            velocities.set(i, Vector2());
+
+            // Uniform direction, radius in [0, 1]: [p0, p1, x, y, z, r, theta, phi]
+            const double r = unit(rng);
+            const double cos_theta = 2.0 * unit(rng) - 1.0;
+            const double sin_theta = std::sqrt(1.0 - cos_theta * cos_theta);
+            const double phi = 2.0 * pi * unit(rng);
+            const double b[8] = {0.5 * (1.0 + r * cos_theta), 0.5 * (1.0 - r * cos_theta),
+                                 r * sin_theta * std::cos(phi), r * sin_theta * std::sin(phi), r * cos_theta,
+                                 r, std::acos(cos_theta), phi};
+            for (int k = 0; k < 8; k++) {
+                bloch.set(i * 8 + k, b[k]);
+            }
+            frozen.set(i, unit(rng) < frozen_ratio ? 1 : 0);
+        }
+        mi.resize(static_cast<int64_t>(n) * (n - 1) / 2);
+        double* mi_out = mi.ptrw();
+        int64_t idx = 0;
+        for (int i = 0; i < n; i++) {
+            for (int j = i + 1; j < n; j++, idx++) {
+                mi_out[idx] = unit(rng) < mi_density ? 0.5 * unit(rng) : 0.0;
+                if (mi_out[idx] > 0.0) {
+                    mi_edges.push_back(i);
+                    mi_edges.push_back(j);
+                    mi_edges.push_back(mi_out[idx]);
+                }
+            }
+        }
+    }
+};
+
+}  // namespace
+
+Dictionary ForceGraphEngine::run_benchmark(const PackedInt32Array& node_counts, int steps, float mi_density,
+                                           float frozen_ratio, int seed) {
+    typedef std::chrono::steady_clock Clock;
+    const float dt = 1.0f / 60.0f;
+    const int warmup = 2;
+    steps = std::max(steps, 1);
+
+    PackedInt32Array sizes = node_counts;
+    if (sizes.is_empty()) {
+        for (int n = 8; n <= 2048; n *= 2) {
+            sizes.push_back(n);
+        }
+    }
+
+    // Run with the plain integrator; restored below
+    const int saved_mode = m_repulsion_mode;
+    const bool saved_sleep = m_sleep_enabled;
+    const float saved_fixed = m_fixed_timestep;
+    const bool saved_collision = m_collision_enabled;
+    m_sleep_enabled = false;
+    m_fixed_timestep = 0.0f;
+    m_collision_enabled = false;
+
+    const char* variants[] = {"update_positions", "update_positions_sparse", "layout", "barnes_hut", "grid", "batch",
+                              "collision"};
+    const int num_variants = sizeof(variants) / sizeof(variants[0]);
+    std::vector<PackedFloat64Array> results(num_variants);
+    std::mt19937 rng(static_cast<uint32_t>(seed));
+
+    for (int s = 0; s < sizes.size(); s++) {
+        const int n = std::max(sizes[s], 1);
+        const SyntheticLayout data(n, mi_density, frozen_ratio, rng);
+
+        // ns per node per step for one variant; step(k) runs one step
+        auto time_variant = [&](auto&& step) {
+            for (int k = 0; k < warmup; k++) {
+                step();
+            }
+            const Clock::time_point start = Clock::now();
+            for (int k = 0; k < steps; k++) {
+                step();
+            }
+            const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            return ns / (static_cast<double>(n) * steps);
+        };
+
+        m_repulsion_mode = REPULSION_EXACT;
+        PackedVector2Array pos = data.positions;
+        PackedVector2Array vel = data.velocities;
+        results[0].push_back(time_variant([&]() {
+            Dictionary r = update_positions(pos, vel, data.bloch, data.mi, Vector2(), dt, data.frozen);
+            pos = r["positions"];
+            vel = r["velocities"];
+        }));
+
+        pos = data.positions;
+        vel = data.velocities;
+        results[1].push_back(time_variant([&]() {
+            Dictionary r = update_positions_sparse(pos, vel, data.bloch, data.mi_edges, Vector2(), dt, data.frozen);
+            pos = r["positions"];
+            vel = r["velocities"];
+        }));
+
+        const int modes[3] = {REPULSION_EXACT, REPULSION_BARNES_HUT, REPULSION_GRID};
+        for (int v = 0; v < 3; v++) {
+            m_repulsion_mode = modes[v];
+            const int handle = create_layout(n);
+            set_layout_state(handle, data.positions, data.velocities);
+            results[2 + v].push_back(time_variant([&]() {
+                step_layout_sparse(handle, data.bloch, data.mi_edges, Vector2(), dt, data.frozen);
+            }));
+            destroy_layout(handle);
+        }
+
+        // Same node count as 4 biomes (dense MI within each)
+        m_repulsion_mode = REPULSION_EXACT;
+        const int biomes = n >= 4 ? 4 : 1;
+        PackedInt32Array node_offsets, mi_offsets;
+        PackedVector2Array centers;
+        PackedFloat64Array batch_mi;
+        node_offsets.push_back(0);
+        mi_offsets.push_back(0);
+        for (int b = 0; b < biomes; b++) {
+            const int begin = node_offsets[b];
+            const int end = (b + 1 == biomes) ? n : begin + n / biomes;
+            for (int i = begin; i < end; i++) {
+                for (int j = i + 1; j < end; j++) {
+                    batch_mi.push_back(data.mi[static_cast<int64_t>(i) * n - static_cast<int64_t>(i) * (i + 1) / 2 +
+                                               (j - i - 1)]);
+                }
+            }
+            node_offsets.push_back(end);
+            mi_offsets.push_back(batch_mi.size());
+            centers.push_back(Vector2());
+        }
+        pos = data.positions;
+        vel = data.velocities;
+        results[5].push_back(time_variant([&]() {
+            Dictionary r = update_positions_batch(pos, vel, data.bloch, batch_mi, mi_offsets, node_offsets, centers,
+                                                  dt, data.frozen);
+            pos = r["positions"];
+            vel = r["velocities"];
+        }));
+
+        m_collision_enabled = true;
+        const int handle = create_layout(n);
+        set_layout_state(handle, data.positions, data.velocities);
+        results[6].push_back(time_variant([&]() {
+            step_layout_sparse(handle, data.bloch, data.mi_edges, Vector2(), dt, data.frozen);
+        }));
+        destroy_layout(handle);
+        m_collision_enabled = false;
+    }
+
+    m_repulsion_mode = saved_mode;
+    m_sleep_enabled = saved_sleep;
+    m_fixed_timestep = saved_fixed;
+    m_collision_enabled = saved_collision;
+
+    Dictionary result;
+    result["node_counts"] = sizes;
+    result["steps"] = steps;
+    for (int v = 0; v < num_variants; v++) {
+        result[variants[v]] = results[v];
+    }
+    return result;
 }
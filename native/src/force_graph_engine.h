@@ -3,10 +3,17 @@
 
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
 #include <godot_cpp/variant/packed_float64_array.hpp>
 #include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
 #include <godot_cpp/variant/vector2.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "latency_histograms.h"
 
 namespace godot {
 
@@ -19,12 +26,59 @@ namespace godot {
  * - Correlation force (high MI → attract)
  * - Repulsion force (prevent overlap)
  *
+ * Repulsion is exact O(n²) by default. For farm-wide layouts with hundreds of
+ * bubbles it can be approximated with a Barnes–Hut quadtree (cells far enough
+ * away act as one mass at their centroid, O(n log n)) or a uniform grid that
+ * ignores pairs beyond a cutoff radius.
+ *
+ * All terms are evaluated by one struct-of-arrays float kernel (step_nodes)
+ * over separate x / y / vx / vy arrays, from the positions at the start of the
+ * step. update_positions is a thin Dictionary wrapper around it. Pair terms
+ * visit each upper-triangular pair once and apply equal and opposite forces
+ * to both nodes, reading MI sequentially in compute_mi_adaptive's order.
+ *
+ * Optional island-style sleeping (set_sleep_enabled): a node whose speed and
+ * net force stay below thresholds for sleep_frames steps stops being
+ * simulated (it still repels and attracts awake nodes). It wakes when its
+ * Bloch target or MI total moves past the input tolerance, or when a moving
+ * node comes within base_distance. Sleep state lives in NodeBuffers, so it
+ * needs a persistent node set; the stateless Dictionary calls start awake.
+ *
+ * Optional hard contacts (set_collision_enabled): after each integration
+ * step, overlapping bubbles are pushed apart along their centre line to
+ * exactly touching, and their approaching normal velocity is dropped. Radii
+ * follow the MultiMesh scale (collision_radius · (0.5 + 0.5·|r⃗|)) unless a
+ * layout sets its own. Candidate pairs come from a sort-and-sweep on x, so
+ * a pass costs a sort plus the pairs whose x extents overlap. With contacts
+ * guaranteeing separation, repulsion_strength can be set far lower.
+ *
+ * Integration is one damped semi-implicit Euler step per call unless a fixed
+ * timestep is set: then each call runs substeps of that size (at most
+ * max_substeps), so stability no longer depends on the caller's dt.
+ * Persistent layouts carry the leftover time in an accumulator; stateless
+ * calls split dt evenly. Damping is rescaled per substep so the energy lost
+ * per unit time matches the unsubstepped integrator at the caller's dt.
+ *
+ * New node sets can start from place_nodes (initial_layout / place_layout):
+ * Bloch-target placement plus a cooled relaxation, so the first frame is
+ * already close to settled instead of spreading out from a circle.
+ *
+ * Persistent layouts (create_layout / step_layout) keep each node set inside
+ * the engine between steps, addressed by an integer handle: nothing is copied
+ * in per step and positions are only packed when read back.
+ *
  * Integrates with QuantumEvolutionEngine output (MI, Bloch vectors, purity).
  */
-class ForceGraphEngine : public RefCounted {
+class ForceGraphEngine : public RefCounted, public LatencyTracked<ForceGraphEngine> {
     GDCLASS(ForceGraphEngine, RefCounted)
 
 public:
+    enum RepulsionMode {
+        REPULSION_EXACT = 0,        // Every pair (legacy)
+        REPULSION_BARNES_HUT = 1,   // Quadtree, cells with size/dist < theta approximated
+        REPULSION_GRID = 2          // Uniform grid, pairs beyond the cutoff dropped
+    };
+
     ForceGraphEngine();
     ~ForceGraphEngine();
 
@@ -54,6 +108,207 @@ public:
         const PackedByteArray& frozen_mask
     );
 
+    /**
+     * Lay out every biome in one call from flat buffers (biomes stepped in
+     * parallel on the shared native pool).
+     *
+     * Biome b owns nodes [node_offsets[b], node_offsets[b+1]) of positions,
+     * velocities and frozen_mask, Bloch entries from 8·node_offsets[b], and
+     * MI values [mi_offsets[b], mi_offsets[b+1]) (mi_offsets may be empty
+     * when no biome has MI). biome_centers holds one center per biome.
+     *
+     * @return Dictionary with flat "positions" / "velocities" in input order,
+     *         or an empty Dictionary (with a warning) on malformed offsets
+     */
+    Dictionary update_positions_batch(
+        const PackedVector2Array& positions,
+        const PackedVector2Array& velocities,
+        const PackedFloat64Array& bloch_packets,
+        const PackedFloat64Array& mi_values,
+        const PackedInt32Array& mi_offsets,
+        const PackedInt32Array& node_offsets,
+        const PackedVector2Array& biome_centers,
+        float dt,
+        const PackedByteArray& frozen_mask
+    );
+
+    /**
+     * update_positions with correlation springs from a sparse edge list
+     * (QuantumEvolutionEngine::get_mi_edges): mi_edges holds [i, j, mi] per
+     * correlated pair, so the correlation pass costs O(edges) instead of
+     * visiting all n(n-1)/2 pairs.
+     */
+    Dictionary update_positions_sparse(
+        const PackedVector2Array& positions,
+        const PackedVector2Array& velocities,
+        const PackedFloat64Array& bloch_packet,
+        const PackedFloat64Array& mi_edges,
+        Vector2 biome_center,
+        float dt,
+        const PackedByteArray& frozen_mask
+    );
+
+    // Native node set: positions and velocities as separate float arrays, plus
+    // the kernel's per-step scratch, so stepping allocates nothing once sized.
+    // Owned by the caller, or by the engine as a persistent layout.
+    struct NodeBuffers {
+        std::vector<float> x, y, vx, vy;
+        // Kernel scratch: accumulated force, per-node radial target / phase,
+        // 1/0 active weight (frozen nodes neither feel nor exert force) and
+        // the count of coincident neighbours found by the repulsion pass
+        std::vector<float> fx, fy, target_radius, theta, weight, coincident;
+        std::vector<float> moving;  // 1/0: non-frozen and awake (integrated this step)
+        std::vector<int> active;    // Non-frozen indices (awake or asleep), ascending
+        std::vector<int> awake;     // Indices with moving == 1, ascending
+        std::vector<float> mi_sum;  // Total MI per node (sleep input check)
+        // Collision radius per node: from set_layout_radii when custom_radii,
+        // else recomputed from the Bloch packet each step
+        std::vector<float> radius;
+        bool custom_radii = false;
+        std::vector<int> sweep;  // Collision scratch: nodes by left edge
+
+        // Sleep state (persists across steps)
+        std::vector<uint8_t> asleep;
+        std::vector<uint16_t> still_frames;  // Consecutive steps below both thresholds
+        // Inputs when the node fell asleep: wake checks compare against these,
+        // so slow drift can't accumulate unnoticed
+        std::vector<float> sleep_target_radius, sleep_theta, sleep_mi;
+
+        // Time not yet integrated with fixed substeps (accumulating steps only)
+        float time_accumulator = 0.0f;
+
+        int size() const { return static_cast<int>(x.size()); }
+        void resize(int n);
+        void wake_all();
+        int sleeping_count() const;
+    };
+    struct StepInputs {
+        const double* bloch = nullptr;  // [p0,p1,x,y,z,r,θ,φ] per node
+        int bloch_size = 0;
+        const double* mi = nullptr;     // Upper triangular over the node count
+        int mi_size = 0;
+        const double* mi_edges = nullptr;  // [i, j, mi] triples; used instead of mi when set
+        int mi_edge_count = 0;
+        const uint8_t* frozen = nullptr;
+        int frozen_size = 0;
+        float center_x = 0.0f;
+        float center_y = 0.0f;
+        float dt = 0.0f;
+        // With a fixed timestep: carry the remainder in nodes.time_accumulator
+        // (persistent node sets) instead of splitting dt evenly
+        bool accumulate = false;
+    };
+    // Advance every non-frozen node by in.dt: one step, or fixed substeps
+    // when set_fixed_timestep is on. Only reads engine configuration, so
+    // distinct NodeBuffers may be stepped concurrently.
+    void step_nodes(NodeBuffers& nodes, const StepInputs& in) const;
+
+    /**
+     * Near-converged start for a new node set, in one call.
+     *
+     * Every non-frozen node starts at its own Bloch target (radius
+     * R·(1 - purity) at angle θ around the center, where the radial and
+     * angular springs vanish), nudged apart on a golden-angle spiral so
+     * equal targets don't coincide; nodes without a Bloch entry start at the
+     * MI-weighted mean of their placed partners, or on the spiral. Then
+     * relax_iterations evaluations of the full force model (same terms and
+     * repulsion mode as a step) move each node straight down its force,
+     * the move capped by a bound that cools from base_distance / 2 to half
+     * a pixel. Frozen nodes keep their positions; velocities come out zero
+     * and every node awake, so the first frames start at rest, already
+     * close to settled.
+     */
+    void place_nodes(NodeBuffers& nodes, const StepInputs& in, int relax_iterations) const;
+    // Positions for one node per Bloch entry (stateless)
+    PackedVector2Array initial_layout(const PackedFloat64Array& bloch_packet, const PackedFloat64Array& mi_values,
+                                      Vector2 biome_center, int relax_iterations);
+    // place_nodes on a persistent layout, MI as a sparse edge list; false
+    // (with a warning) for a bad handle
+    bool place_layout(int handle, const PackedFloat64Array& bloch_packet, const PackedFloat64Array& mi_edges,
+                      Vector2 biome_center, const PackedByteArray& frozen_mask, int relax_iterations);
+
+    /**
+     * Persistent layouts: engine-owned node sets addressed by handle.
+     *
+     * create_layout(n) returns a handle to n nodes at rest at the origin
+     * (seed them with set_layout_state). step_layout / step_layout_sparse
+     * advance one layout in place from the same inputs as update_positions /
+     * update_positions_sparse and return false (with a warning) for a bad
+     * handle. Distinct handles may be stepped concurrently; creating or
+     * destroying layouts must not overlap with stepping.
+     */
+    int create_layout(int num_nodes);
+    void destroy_layout(int handle);
+    // Replace positions and velocities (node count follows positions; missing
+    // velocities are zero) and wake every node
+    void set_layout_state(int handle, const PackedVector2Array& positions, const PackedVector2Array& velocities);
+    // Per-node collision radii (missing or non-positive entries use the
+    // Bloch-derived radius); an empty array returns to derived radii
+    void set_layout_radii(int handle, const PackedFloat32Array& radii);
+    bool step_layout(int handle, const PackedFloat64Array& bloch_packet, const PackedFloat64Array& mi_values,
+                     Vector2 biome_center, float dt, const PackedByteArray& frozen_mask);
+    bool step_layout_sparse(int handle, const PackedFloat64Array& bloch_packet, const PackedFloat64Array& mi_edges,
+                            Vector2 biome_center, float dt, const PackedByteArray& frozen_mask);
+    PackedVector2Array get_layout_positions(int handle) const;
+    PackedVector2Array get_layout_velocities(int handle) const;
+    int get_layout_size(int handle) const;  // -1 for an invalid handle
+
+    // Native view of a layout (nullptr for an invalid handle); callers in
+    // C++ step it with step_nodes and read x / y directly
+    NodeBuffers* get_layout(int handle);
+    const NodeBuffers* get_layout(int handle) const;
+
+    /**
+     * Farm-wide repulsion between node sets (e.g. neighbouring biomes), run
+     * once per frame after each set has been stepped.
+     *
+     * All non-frozen nodes go into one spatial hash with cell size =
+     * repulsion_cutoff; only pairs from different sets within the cutoff
+     * interact, so the pass is O(total nodes) for bounded density. Forces
+     * are applied as one semi-implicit kick over dt and wake sleepers.
+     */
+    void repel_between(const std::vector<NodeBuffers*>& sets, float dt) const;
+    void repel_layouts(const PackedInt32Array& handles, float dt);
+
+    /**
+     * MultiMesh-ready instance data for RenderingServer.multimesh_set_buffer
+     * (TRANSFORM_2D with use_colors): 12 floats per node,
+     *   [sx, 0, 0, x,  0, sy, 0, y,  r, g, b, a]
+     * Scale is bubble_scale · (0.5 + 0.5·|r⃗|) so pure states draw larger;
+     * color hue is the Bloch azimuth φ, saturation the Bloch radius. Nodes
+     * without a Bloch entry get bubble_scale and white.
+     */
+    PackedFloat32Array get_layout_multimesh_buffer(int handle, const PackedFloat64Array& bloch_packet) const;
+    PackedFloat32Array build_multimesh_buffer(const PackedVector2Array& positions,
+                                              const PackedFloat64Array& bloch_packet) const;
+    static constexpr int MULTIMESH_STRIDE = 12;
+    // Writes count · MULTIMESH_STRIDE floats to out
+    void write_multimesh_buffer(const float* x, const float* y, int count, const double* bloch, int bloch_size,
+                                float* out) const;
+
+    /**
+     * Scaling benchmark on synthetic inputs (seeded, so runs are repeatable).
+     *
+     * For each node count, generates random Bloch vectors, a dense MI
+     * triangle where a mi_density fraction of pairs is correlated (and the
+     * matching edge list), and a frozen_ratio fraction of frozen nodes, then
+     * times `steps` steps (after two warm-up steps) of each variant with the
+     * current spring constants:
+     *   "update_positions" (dense MI, exact), "update_positions_sparse" (MI
+     *   edges, exact), "layout" (persistent step_layout_sparse, exact),
+     *   "barnes_hut" and "grid" (layout with approximate repulsion), and
+     *   "batch" (update_positions_batch over 4 equal biomes), and
+     *   "collision" (exact layout with hard contacts on).
+     * Sleeping, substepping and (outside "collision") contacts are switched
+     * off while it runs.
+     *
+     * @param node_counts Sizes to run (empty = 8, 16, ..., 2048)
+     * @return Dictionary with "node_counts" (PackedInt32Array), "steps", and
+     *         per variant a PackedFloat64Array of ns per node per step
+     */
+    Dictionary run_benchmark(const PackedInt32Array& node_counts, int steps, float mi_density, float frozen_ratio,
+                             int seed);
+
     // Configuration methods
     void set_purity_radial_spring(float spring);
     void set_phase_angular_spring(float spring);
@@ -63,6 +318,20 @@ public:
     void set_damping(float damping);
     void set_base_distance(float distance);
     void set_min_distance(float distance);
+    void set_repulsion_mode(int mode);
+    void set_barnes_hut_theta(float theta);      // Opening angle; 0 = exact traversal
+    void set_repulsion_cutoff(float cutoff);     // Grid cell size / interaction radius
+    void set_sleep_enabled(bool enabled);
+    void set_sleep_velocity_threshold(float speed);
+    void set_sleep_force_threshold(float force);
+    void set_sleep_frames(int frames);           // Still steps before a node sleeps
+    void set_sleep_input_tolerance(float tolerance);  // Purity / phase (rad) / MI total delta that wakes
+    void set_fixed_timestep(float step);         // Substep size in seconds; 0 = one step per call
+    void set_max_substeps(int substeps);         // Cap per call; backlog past it is dropped
+    void set_bubble_scale(float scale);          // MultiMesh instance scale for a pure state
+    void set_collision_enabled(bool enabled);
+    void set_collision_radius(float radius);     // Contact radius (px) of a pure-state bubble
+    void set_collision_iterations(int iterations);  // Sweep passes per step (stops early when clear)
 
     float get_purity_radial_spring() const { return m_purity_radial_spring; }
     float get_phase_angular_spring() const { return m_phase_angular_spring; }
@@ -72,6 +341,20 @@ public:
     float get_damping() const { return m_damping; }
     float get_base_distance() const { return m_base_distance; }
     float get_min_distance() const { return m_min_distance; }
+    int get_repulsion_mode() const { return m_repulsion_mode; }
+    float get_barnes_hut_theta() const { return m_barnes_hut_theta; }
+    float get_repulsion_cutoff() const { return m_repulsion_cutoff; }
+    bool get_sleep_enabled() const { return m_sleep_enabled; }
+    float get_sleep_velocity_threshold() const { return m_sleep_velocity; }
+    float get_sleep_force_threshold() const { return m_sleep_force; }
+    int get_sleep_frames() const { return m_sleep_frames; }
+    float get_sleep_input_tolerance() const { return m_sleep_input_tolerance; }
+    float get_fixed_timestep() const { return m_fixed_timestep; }
+    int get_max_substeps() const { return m_max_substeps; }
+    float get_bubble_scale() const { return m_bubble_scale; }
+    bool get_collision_enabled() const { return m_collision_enabled; }
+    float get_collision_radius() const { return m_collision_radius; }
+    int get_collision_iterations() const { return m_collision_iterations; }
 
 protected:
     static void _bind_methods();
@@ -88,41 +371,70 @@ private:
     float m_min_distance = 15.0f;
     float m_correlation_scaling = 3.0f;
     float m_max_biome_radius = 250.0f;
+    int m_repulsion_mode = REPULSION_EXACT;
+    float m_barnes_hut_theta = 0.7f;
+    float m_repulsion_cutoff = 300.0f;  // 1500/300² ≈ 0.017: negligible past this
+    bool m_sleep_enabled = false;
+    float m_sleep_velocity = 0.5f;   // px/s
+    float m_sleep_force = 1.0f;
+    int m_sleep_frames = 30;
+    float m_sleep_input_tolerance = 0.01f;
+    float m_fixed_timestep = 0.0f;
+    int m_max_substeps = 8;
+    float m_bubble_scale = 1.0f;
+    bool m_collision_enabled = false;
+    float m_collision_radius = 7.5f;  // Two pure bubbles touch at min_distance
+    int m_collision_iterations = 4;
 
-    // Force calculation helpers
-    Vector2 _calculate_purity_radial_force(
-        int node_idx,
-        Vector2 position,
-        const PackedFloat64Array& bloch_packet,
-        Vector2 biome_center
-    );
-
-    Vector2 _calculate_phase_angular_force(
-        int node_idx,
-        Vector2 position,
-        const PackedFloat64Array& bloch_packet,
-        Vector2 biome_center
-    );
-
-    Vector2 _calculate_correlation_forces(
-        int node_idx,
-        Vector2 position,
-        const PackedVector2Array& all_positions,
-        const PackedFloat64Array& mi_values,
-        const PackedByteArray& frozen_mask
-    );
+    // Layouts by handle (index); destroyed slots are null and reused
+    std::vector<std::unique_ptr<NodeBuffers>> m_layouts;
+    std::vector<int> m_free_layouts;
+    NodeBuffers* _checked_layout(int handle, const char* method);
 
-    Vector2 _calculate_repulsion_forces(
-        int node_idx,
-        Vector2 position,
-        const PackedVector2Array& all_positions,
-        const PackedByteArray& frozen_mask
-    );
+    // One damped semi-implicit Euler step of length dt (inputs already
+    // gathered), specialized on which force terms are live so disabled terms
+    // cost nothing. _select_kernel picks the instantiation once per call.
+    typedef void (ForceGraphEngine::*StepKernel)(NodeBuffers&, const StepInputs&, float, float) const;
+    template <bool Radial, bool Angular, bool Correlation, bool Repulsion>
+    void _step_once(NodeBuffers& nodes, const StepInputs& in, float dt, float damping) const;
+    // place_nodes' relaxation move: x += scale · F, at most max_step long
+    template <bool Radial, bool Angular, bool Correlation, bool Repulsion>
+    void _relax_once(NodeBuffers& nodes, const StepInputs& in, float scale, float max_step) const;
+    // Forces on the awake nodes into fx / fy; false when none is awake
+    template <bool Radial, bool Angular, bool Correlation, bool Repulsion>
+    bool _accumulate_forces(NodeBuffers& nodes, const StepInputs& in) const;
+    StepKernel _select_kernel(const StepInputs& in, bool relax = false) const;
+    // Frozen weights, the active list and the per-node inputs for one call
+    void _prepare_nodes(NodeBuffers& nodes, const StepInputs& in) const;
+    // Per-node Bloch targets, and MI totals when sleeping is on
+    void _gather_node_inputs(NodeBuffers& nodes, const StepInputs& in) const;
+    // Wake sleepers whose inputs changed or that a moving node approached,
+    // then rebuild nodes.moving / nodes.awake
+    void _update_awake_set(NodeBuffers& nodes) const;
+    // After integration: count still steps and put settled nodes to sleep
+    void _update_sleep_counters(NodeBuffers& nodes) const;
 
-    // MI indexing helper
-    int _mi_index(int i, int j, int num_qubits) const;
+    // Kernel stages: each adds into nodes.fx / nodes.fy (only awake nodes'
+    // forces are used, so pairs of two sleepers are skipped)
+    template <bool Radial, bool Angular>
+    void _accumulate_node_forces(NodeBuffers& nodes, const StepInputs& in) const;
+    // Every active pair once: dense MI springs and/or exact repulsion
+    template <bool Correlation, bool Repulsion>
+    void _accumulate_pair_forces(NodeBuffers& nodes, const StepInputs& in) const;
+    void _accumulate_edge_forces(NodeBuffers& nodes, const StepInputs& in) const;
+    // Shared body of update_positions / update_positions_sparse
+    Dictionary _step_packed(const PackedVector2Array& positions, const PackedVector2Array& velocities,
+                            StepInputs& in);
+    // Hard contacts after integration: sort-and-sweep broadphase, then
+    // pairwise projection (frozen nodes don't move; pushed sleepers wake)
+    void _resolve_collisions(NodeBuffers& nodes) const;
+    // Approximate repulsion from the same snapshot of positions
+    void _accumulate_repulsion_barnes_hut(NodeBuffers& nodes) const;
+    void _accumulate_repulsion_grid(NodeBuffers& nodes) const;
 };
 
 }  // namespace godot
 
+VARIANT_ENUM_CAST(godot::ForceGraphEngine::RepulsionMode);
+
 #endif  // FORCE_GRAPH_ENGINE_H
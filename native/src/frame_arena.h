@@ -0,0 +1,104 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace godot {
+
+/**
+ * FrameArena - Bump allocator for one call's native scratch memory
+ *
+ * alloc() hands out uninitialized, cache-line aligned slices of one block
+ * with an atomic bump, so tasks on the shared pool can draw from the same
+ * arena without contending (and without false sharing). A request that does
+ * not fit gets its own overflow block under a mutex; reset() frees those
+ * and regrows the main block to the high-water mark, so a steady workload
+ * stops allocating after its first frame. Slices are valid until the next
+ * reset(), which must not race with alloc(). Destructors never run: only
+ * trivially destructible types belong here.
+ */
+class FrameArena {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+
+    FrameArena() = default;
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    ~FrameArena() {
+        release_overflow();
+        free_block(m_block);
+    }
+
+    template <typename T>
+    T* alloc(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+        static_assert(alignof(T) <= ALIGNMENT, "FrameArena alignment too small");
+        return static_cast<T*>(allocate(count * sizeof(T)));
+    }
+
+    void* allocate(size_t bytes) {
+        const size_t size = std::max<size_t>(ALIGNMENT, (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+        const size_t offset = m_used.fetch_add(size, std::memory_order_relaxed);
+        if (offset + size <= m_capacity) {
+            return m_block + offset;
+        }
+        uint8_t* block = new_block(size);
+        std::lock_guard<std::mutex> lock(m_overflow_mutex);
+        m_overflow.push_back(block);
+        m_overflows++;
+        return block;
+    }
+
+    // Start a new frame: everything handed out so far is invalid
+    void reset() {
+        const size_t used = m_used.load(std::memory_order_relaxed);
+        m_high_water = std::max(m_high_water, used);
+        if (!m_overflow.empty()) {
+            release_overflow();
+            free_block(m_block);
+            m_capacity = m_high_water + m_high_water / 4;  // Headroom for jitter
+            m_block = new_block(m_capacity);
+        }
+        m_used.store(0, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return m_capacity; }
+    size_t high_water() const { return std::max(m_high_water, m_used.load(std::memory_order_relaxed)); }
+    uint64_t overflow_count() const { return m_overflows; }  // Overflow blocks ever allocated
+
+private:
+    static uint8_t* new_block(size_t size) {
+        return static_cast<uint8_t*>(::operator new(size, std::align_val_t(ALIGNMENT)));
+    }
+    static void free_block(uint8_t* block) {
+        if (block != nullptr) {
+            ::operator delete(block, std::align_val_t(ALIGNMENT));
+        }
+    }
+    void release_overflow() {
+        for (uint8_t* block : m_overflow) {
+            free_block(block);
+        }
+        m_overflow.clear();
+    }
+
+    uint8_t* m_block = nullptr;
+    size_t m_capacity = 0;
+    std::atomic<size_t> m_used{0};
+    size_t m_high_water = 0;
+
+    std::mutex m_overflow_mutex;
+    std::vector<uint8_t*> m_overflow;
+    uint64_t m_overflows = 0;
+};
+
+}  // namespace godot
+
+#endif  // FRAME_ARENA_H
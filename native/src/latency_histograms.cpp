@@ -0,0 +1,180 @@
+#include "latency_histograms.h"
+
+#include <godot_cpp/variant/string.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+
+using namespace godot;
+
+namespace {
+
+struct MethodStats {
+    LatencyHistogram latency;
+    AllocationStats allocations;
+};
+
+// Stats by "<class>.<method>"; filled during class registration, read
+// (never resized) afterwards
+std::map<std::string, std::unique_ptr<MethodStats>>& registry() {
+    static std::map<std::string, std::unique_ptr<MethodStats>> methods;
+    return methods;
+}
+
+MethodStats& method_stats(const StringName& class_name, const StringName& method_name) {
+    const std::string key = (String(class_name) + "." + String(method_name)).utf8().get_data();
+    std::unique_ptr<MethodStats>& stats = registry()[key];
+    if (!stats) {
+        stats = std::make_unique<MethodStats>();
+    }
+    return *stats;
+}
+
+int highest_bit(uint64_t value) {
+    int bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// LatencyHistogram
+// ---------------------------------------------------------------------------
+
+int LatencyHistogram::bucket_of(uint64_t nanos) {
+    if (nanos < SUB_BUCKETS) {
+        return static_cast<int>(nanos);
+    }
+    const int exponent = highest_bit(nanos);
+    if (exponent > MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+    // Octave [2^e, 2^(e+1)) split into SUB_BUCKETS equal parts
+    const int sub = static_cast<int>((nanos >> (exponent - SUB_BITS)) & (SUB_BUCKETS - 1));
+    return (exponent - SUB_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucket_lower(int bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return static_cast<uint64_t>(bucket);
+    }
+    const int exponent = bucket / SUB_BUCKETS + SUB_BITS - 1;
+    const uint64_t sub = static_cast<uint64_t>(bucket % SUB_BUCKETS);
+    return (SUB_BUCKETS + sub) << (exponent - SUB_BITS);
+}
+
+void LatencyHistogram::record(uint64_t nanos) {
+    m_buckets[bucket_of(nanos)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(nanos, std::memory_order_relaxed);
+    uint64_t seen = m_max.load(std::memory_order_relaxed);
+    while (nanos > seen && !m_max.compare_exchange_weak(seen, nanos, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (std::atomic<uint64_t>& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+Dictionary LatencyHistogram::to_dict() const {
+    // Snapshot the buckets once; the total is taken from the snapshot so the
+    // percentile walk is consistent even while other threads record
+    uint64_t counts[BUCKET_COUNT];
+    uint64_t total = 0;
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+        counts[b] = m_buckets[b].load(std::memory_order_relaxed);
+        total += counts[b];
+    }
+    const uint64_t max_ns = m_max.load(std::memory_order_relaxed);
+
+    const double quantiles[3] = {0.50, 0.95, 0.99};
+    double values[3] = {0.0, 0.0, 0.0};
+    uint64_t cumulative = 0;
+    int q = 0;
+    for (int b = 0; b < BUCKET_COUNT && q < 3 && total > 0; b++) {
+        cumulative += counts[b];
+        while (q < 3 && static_cast<double>(cumulative) >= quantiles[q] * static_cast<double>(total)) {
+            // Upper bound of the bucket, never past the observed max
+            const uint64_t upper = (b + 1 < BUCKET_COUNT) ? bucket_lower(b + 1) - 1 : max_ns;
+            values[q++] = static_cast<double>(std::min(upper, max_ns)) / 1000.0;
+        }
+    }
+
+    Dictionary d;
+    const uint64_t count = m_count.load(std::memory_order_relaxed);
+    d["count"] = static_cast<int64_t>(count);
+    d["mean_usec"] = count > 0 ? static_cast<double>(m_sum.load(std::memory_order_relaxed)) / 1000.0 /
+                                     static_cast<double>(count)
+                               : 0.0;
+    d["p50_usec"] = values[0];
+    d["p95_usec"] = values[1];
+    d["p99_usec"] = values[2];
+    d["max_usec"] = static_cast<double>(max_ns) / 1000.0;
+    return d;
+}
+
+// ---------------------------------------------------------------------------
+// LatencyHistograms
+// ---------------------------------------------------------------------------
+
+LatencyHistogram* LatencyHistograms::slot(const StringName& class_name, const StringName& method_name) {
+    return &method_stats(class_name, method_name).latency;
+}
+
+AllocationStats* LatencyHistograms::allocation_slot(const StringName& class_name, const StringName& method_name) {
+    return &method_stats(class_name, method_name).allocations;
+}
+
+Dictionary LatencyHistograms::snapshot() {
+    Dictionary result;
+    for (const auto& entry : registry()) {
+        if (entry.second->latency.count() > 0) {
+            result[String::utf8(entry.first.c_str())] = entry.second->latency.to_dict();
+        }
+    }
+    return result;
+}
+
+void LatencyHistograms::reset() {
+    for (const auto& entry : registry()) {
+        entry.second->latency.reset();
+    }
+}
+
+Dictionary LatencyHistograms::allocation_snapshot() {
+    Dictionary result;
+    for (const auto& entry : registry()) {
+        const AllocationStats& stats = entry.second->allocations;
+        const uint64_t calls = stats.calls();
+        if (calls == 0) {
+            continue;
+        }
+        const AllocCounts totals = stats.totals();
+        Dictionary d;
+        d["calls"] = static_cast<int64_t>(calls);
+        d["heap_allocs"] = static_cast<int64_t>(totals.heap_allocs);
+        d["heap_bytes"] = static_cast<int64_t>(totals.heap_bytes);
+        d["packed_allocs"] = static_cast<int64_t>(totals.packed_allocs);
+        d["packed_bytes"] = static_cast<int64_t>(totals.packed_bytes);
+        d["heap_allocs_per_call"] = static_cast<double>(totals.heap_allocs) / static_cast<double>(calls);
+        d["max_heap_allocs"] = static_cast<int64_t>(stats.max_heap_allocs());
+        result[String::utf8(entry.first.c_str())] = d;
+    }
+    return result;
+}
+
+void LatencyHistograms::reset_allocations() {
+    for (const auto& entry : registry()) {
+        entry.second->allocations.reset();
+    }
+}
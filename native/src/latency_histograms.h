@@ -0,0 +1,195 @@
+#ifndef LATENCY_HISTOGRAMS_H
+#define LATENCY_HISTOGRAMS_H
+
+#include "alloc_tracking.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+namespace godot {
+
+/**
+ * LatencyHistograms - Per-method call latency of the bound engine APIs
+ *
+ * Averages (ProfileStage, NativeCounters) hide the rare scan-frame spikes
+ * (MI_CACHE_SPIKE_ANALYSIS.md); these keep the whole distribution. Each
+ * method bound with BIND_TIMED_METHOD gets a LatencyHistogram, and every
+ * GDScript call through the binding records its wall time (native callers
+ * calling the C++ method directly are not counted).
+ *
+ * Buckets are HDR-style log-linear: exact below 8 ns, then 8 sub-buckets
+ * per power of two (values within 12.5%), up to ~2^40 ns. A record is a few
+ * relaxed atomic adds plus a CAS loop for the max, so callers on any thread
+ * never lock. Percentiles are read from a racy but monotone snapshot.
+ *
+ *   var h := NativeTrace.get_latency_histograms()
+ *   print(h["MultiBiomeLookaheadEngine.evolve_all_lookahead"]["p99_usec"])
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int MAX_EXPONENT = 40;
+    static constexpr int BUCKET_COUNT = (MAX_EXPONENT - SUB_BITS + 2) * SUB_BUCKETS;
+
+    void record(uint64_t nanos);
+    void reset();
+    uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+
+    // {"count", "mean_usec", "p50_usec", "p95_usec", "p99_usec", "max_usec"};
+    // percentiles are bucket upper bounds
+    Dictionary to_dict() const;
+
+    static int bucket_of(uint64_t nanos);
+    static uint64_t bucket_lower(int bucket);
+
+private:
+    std::atomic<uint64_t> m_buckets[BUCKET_COUNT] = {};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_max{0};
+};
+
+class LatencyHistograms {
+public:
+    // Histogram for "<class>.<method>", created on first use. Bind time only
+    // (single-threaded class registration); the pointer stays valid for the
+    // life of the library.
+    static LatencyHistogram* slot(const StringName& class_name, const StringName& method_name);
+    // The same method's allocation counts (only recorded with ALLOC=1)
+    static AllocationStats* allocation_slot(const StringName& class_name, const StringName& method_name);
+
+    // "<class>.<method>" → LatencyHistogram::to_dict for every method called
+    // at least once
+    static Dictionary snapshot();
+    static void reset();
+
+    // "<class>.<method>" → {"calls", "heap_allocs", "heap_bytes",
+    // "packed_allocs", "packed_bytes", "heap_allocs_per_call",
+    // "max_heap_allocs"} for every method called since the last reset
+    static Dictionary allocation_snapshot();
+    static void reset_allocations();
+
+    // Recording switch (default on); off skips the clock reads entirely
+    static void set_enabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+    static bool is_enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+private:
+    static inline std::atomic<bool> s_enabled{true};
+};
+
+// Histogram and allocation counts of one bound method (set by bind_timed_method)
+template <auto Method>
+struct LatencySlot {
+    static inline LatencyHistogram* histogram = nullptr;
+    static inline AllocationStats* allocations = nullptr;
+};
+
+// Records the scope's wall time into a histogram (no clock reads when the
+// histogram is unset or recording is off)
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyHistogram* histogram)
+        : m_histogram(histogram && LatencyHistograms::is_enabled() ? histogram : nullptr) {
+        if (m_histogram) {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+    ~ScopedLatency() {
+        if (m_histogram) {
+            m_histogram->record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - m_start).count()));
+        }
+    }
+
+private:
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+    LatencyHistogram* m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * Mixin for classes whose bound methods are timed: supplies the wrapper
+ * that BIND_TIMED_METHOD binds in place of each method (same signature,
+ * so Godot sees the same API).
+ *
+ *   class ForceGraphEngine : public RefCounted, public LatencyTracked<ForceGraphEngine>
+ */
+template <typename T>
+class LatencyTracked {
+public:
+    template <auto Method, typename R, typename... A>
+    R _latency_call(A... args) {
+        ScopedLatency scope(LatencySlot<Method>::histogram);
+        NATIVE_ALLOC_SCOPE(LatencySlot<Method>::allocations);
+        return (static_cast<T*>(this)->*Method)(std::forward<A>(args)...);
+    }
+    template <auto Method, typename R, typename... A>
+    R _latency_call_const(A... args) const {
+        ScopedLatency scope(LatencySlot<Method>::histogram);
+        NATIVE_ALLOC_SCOPE(LatencySlot<Method>::allocations);
+        return (static_cast<const T*>(this)->*Method)(std::forward<A>(args)...);
+    }
+};
+
+template <auto Function, typename R, typename... A>
+R latency_static_call(A... args) {
+    ScopedLatency scope(LatencySlot<Function>::histogram);
+    NATIVE_ALLOC_SCOPE(LatencySlot<Function>::allocations);
+    return Function(std::forward<A>(args)...);
+}
+
+// The timed wrapper of a method, as a member pointer of the method's class
+template <auto Method>
+struct LatencyWrapper;
+template <typename T, typename R, typename... A, R (T::*Method)(A...)>
+struct LatencyWrapper<Method> {
+    static constexpr R (T::*pointer)(A...) = &LatencyTracked<T>::template _latency_call<Method, R, A...>;
+};
+template <typename T, typename R, typename... A, R (T::*Method)(A...) const>
+struct LatencyWrapper<Method> {
+    static constexpr R (T::*pointer)(A...) const = &LatencyTracked<T>::template _latency_call_const<Method, R, A...>;
+};
+template <typename R, typename... A, R (*Function)(A...)>
+struct LatencyWrapper<Function> {
+    static constexpr R (*pointer)(A...) = &latency_static_call<Function, R, A...>;
+};
+
+// ClassDB::bind_method / bind_static_method with a latency histogram
+template <auto Method, typename N, typename... VarArgs>
+MethodBind* bind_timed_method(N method_name, VarArgs... default_args) {
+    MethodBind* bind = ClassDB::bind_method(method_name, LatencyWrapper<Method>::pointer, default_args...);
+    if (bind) {
+        LatencySlot<Method>::histogram = LatencyHistograms::slot(bind->get_instance_class(), bind->get_name());
+        LatencySlot<Method>::allocations =
+            LatencyHistograms::allocation_slot(bind->get_instance_class(), bind->get_name());
+    }
+    return bind;
+}
+
+template <auto Function, typename N, typename... VarArgs>
+MethodBind* bind_timed_static_method(const StringName& class_name, N method_name, VarArgs... default_args) {
+    MethodBind* bind =
+        ClassDB::bind_static_method(class_name, method_name, LatencyWrapper<Function>::pointer, default_args...);
+    if (bind) {
+        LatencySlot<Function>::histogram = LatencyHistograms::slot(class_name, bind->get_name());
+        LatencySlot<Function>::allocations = LatencyHistograms::allocation_slot(class_name, bind->get_name());
+    }
+    return bind;
+}
+
+// Drop-in for ClassDB::bind_method(name, &Class::method, defaults...)
+#define BIND_TIMED_METHOD(name, method, ...) godot::bind_timed_method<method>(name, ##__VA_ARGS__)
+#define BIND_TIMED_STATIC_METHOD(class_name, name, method, ...) \
+    godot::bind_timed_static_method<method>(class_name, name, ##__VA_ARGS__)
+
+}  // namespace godot
+
+#endif  // LATENCY_HISTOGRAMS_H
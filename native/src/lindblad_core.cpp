@@ -0,0 +1,465 @@
+#include "lindblad_core.h"
+#include "simd_dispatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace godot {
+namespace lindblad {
+
+void compute_drho(const Generator& gen, RhoConstRef rho, RhoRef drho, RhoMatrix& temp) {
+    compute_drho_units(gen, rho, drho, temp, 0, generator_unit_count(gen));
+}
+
+int generator_unit_count(const Generator& gen) {
+    return 1 + static_cast<int>(gen.lindblads->size()) + static_cast<int>(gen.local_lindblads->size());
+}
+
+void compute_drho_units(const Generator& gen, RhoConstRef rho, RhoRef drho, RhoMatrix& temp, int begin, int end) {
+    const int num_global = static_cast<int>(gen.lindblads->size());
+    const int count = generator_unit_count(gen);
+    end = std::min(end, count);
+
+    // Unit 0, drift: -i(H_eff ρ - ρ H_eff†) = X + X† with X = -i H_eff ρ (ρ
+    // Hermitian), so the Hamiltonian and all K anticommutators cost one
+    // sparse×dense product
+    if (begin <= 0 && end > 0) {
+        const std::complex<double> minus_i(0.0, -1.0);
+        if (gen.heff != nullptr || !gen.local_heff->empty()) {
+            if (gen.heff_form != nullptr && !gen.heff_form->is_csr()) {
+                temp.setZero();
+                gen.heff_form->apply_left(minus_i, rho, temp);
+            } else if (gen.heff != nullptr) {
+                temp.noalias() = minus_i * (*gen.heff * rho);
+            } else {
+                temp.setZero();
+            }
+            for (const auto& entry : *gen.local_heff) {
+                local_apply_left(entry.op, entry.size, entry.mask, entry.offsets, minus_i, rho, temp);
+            }
+            hermitian_sum(temp, drho);
+        } else {
+            drho.setZero();
+        }
+    }
+
+    // Units 1..: jumps L_k ρ L_k†, global operators first
+    const std::complex<double> one(1.0, 0.0);
+    for (int unit = std::max(begin, 1); unit < end; unit++) {
+        const int k = unit - 1;
+        if (k < num_global) {
+            const auto& L = (*gen.lindblads)[k];
+            if (!L->L_form.is_csr()) {
+                L->L_form.apply_sandwich(one, rho, drho, temp);
+            } else {
+                temp.noalias() = L->L * rho;           // Sparse × Dense
+                drho.noalias() += temp * L->L_dag;     // Dense × Sparse
+            }
+        } else {
+            const LocalOperator& L_loc = (*gen.local_lindblads)[k - num_global];
+            temp.setZero();
+            local_apply_left(L_loc.op, L_loc.size, L_loc.mask, L_loc.offsets, one, rho, temp);
+            local_apply_right_adjoint(L_loc.op, L_loc.size, L_loc.mask, L_loc.offsets, one, temp, drho);
+        }
+    }
+}
+
+void compute_reduced_states(
+    RhoConstRef rho, int num_qubits, bool with_pairs, ReducedStates& out,
+    double* purity, std::complex<double>* trace) {
+    reset_reduced_states(num_qubits, with_pairs, out);
+    if (purity) {
+        *purity = 0.0;
+    }
+    if (trace) {
+        *trace = std::complex<double>(0.0, 0.0);
+    }
+    if (num_qubits <= 0 || (1 << num_qubits) > rho.rows()) {
+        return;
+    }
+    accumulate_reduced_states(rho, 0, 1 << num_qubits, out, purity, trace);
+}
+
+void reset_reduced_states(int num_qubits, bool with_pairs, ReducedStates& out) {
+    const int n = std::max(num_qubits, 0);
+    out.num_bits = n;
+    out.singles.assign(n, Eigen::Matrix<std::complex<double>, 2, 2>::Zero());
+    out.pairs.assign(with_pairs ? n * (n - 1) / 2 : 0, Eigen::Matrix<std::complex<double>, 4, 4>::Zero());
+}
+
+namespace {
+
+// The reduction sweep over rows [row_begin, row_end). N > 0 fixes the bit
+// count at compile time, so the bit and pair loops have constant trip
+// counts and pair_index folds to constants (instantiated for N = 1..10,
+// the biome sizes); N = 0 reads it from out.num_bits
+template <int N, bool WithPairs>
+void accumulate_rows(RhoConstRef rho, int row_begin, int row_end, ReducedStates& out,
+                     double* purity, std::complex<double>* trace) {
+    const int n = (N > 0) ? N : out.num_bits;
+    auto pair_index = [n](int p, int q) { return p * n - p * (p + 1) / 2 + (q - p - 1); };
+    Eigen::Matrix<std::complex<double>, 2, 2>* singles = out.singles.data();
+    Eigen::Matrix<std::complex<double>, 4, 4>* pairs = out.pairs.data();
+
+    // ρ(i, j) lands in reduced(local(i), local(j)) of every subsystem that
+    // contains all bits of i ^ j (the traced-out bits must agree)
+    const SimdKernels& simd = simd_kernels();
+    for (int i = row_begin; i < row_end; i++) {
+        // Whole-row terms ride along while row i is in cache
+        if (purity) {
+            *purity += simd.norm_sq_c64(reinterpret_cast<const double*>(rho.row(i).data()), rho.cols());
+        }
+
+        // i == j: diagonal of every single and pair
+        const std::complex<double> d = rho(i, i);
+        if (trace) {
+            *trace += d;
+        }
+        for (int p = 0; p < n; p++) {
+            const int bp = (i >> p) & 1;
+            singles[p](bp, bp) += d;
+            if (WithPairs) {
+                for (int q = p + 1; q < n; q++) {
+                    const int l = (((i >> q) & 1) << 1) | bp;
+                    pairs[pair_index(p, q)](l, l) += d;
+                }
+            }
+        }
+
+        // i ^ j == one bit b: single b, and every pair containing b
+        for (int b = 0; b < n; b++) {
+            const int j = i ^ (1 << b);
+            const std::complex<double> v = rho(i, j);
+            singles[b]((i >> b) & 1, (j >> b) & 1) += v;
+            if (!WithPairs) {
+                continue;
+            }
+            // Pairs (c, b) with b the high digit, then (b, c) with b the low one
+            const int ib = (i >> b) & 1;
+            const int jb = (j >> b) & 1;
+            for (int c = 0; c < b; c++) {
+                const int ic = (i >> c) & 1;  // Equal in j: only bit b differs
+                pairs[pair_index(c, b)]((ib << 1) | ic, (jb << 1) | ic) += v;
+            }
+            for (int c = b + 1; c < n; c++) {
+                const int ic = ((i >> c) & 1) << 1;
+                pairs[pair_index(b, c)](ic | ib, ic | jb) += v;
+            }
+        }
+
+        // i ^ j == two bits p < q: exactly one pair
+        if (WithPairs) {
+            for (int p = 0; p < n; p++) {
+                for (int q = p + 1; q < n; q++) {
+                    const int li = (((i >> q) & 1) << 1) | ((i >> p) & 1);
+                    pairs[pair_index(p, q)](li, li ^ 3) += rho(i, i ^ (1 << p) ^ (1 << q));
+                }
+            }
+        }
+    }
+}
+
+typedef void (*AccumulateRowsFn)(RhoConstRef, int, int, ReducedStates&, double*, std::complex<double>*);
+
+constexpr int FIXED_SWEEP_MAX_BITS = 10;
+
+// [num_bits][with_pairs]; entry 0 is the runtime-n sweep
+const AccumulateRowsFn ACCUMULATE_ROWS[FIXED_SWEEP_MAX_BITS + 1][2] = {
+    {accumulate_rows<0, false>, accumulate_rows<0, true>},
+    {accumulate_rows<1, false>, accumulate_rows<1, true>},
+    {accumulate_rows<2, false>, accumulate_rows<2, true>},
+    {accumulate_rows<3, false>, accumulate_rows<3, true>},
+    {accumulate_rows<4, false>, accumulate_rows<4, true>},
+    {accumulate_rows<5, false>, accumulate_rows<5, true>},
+    {accumulate_rows<6, false>, accumulate_rows<6, true>},
+    {accumulate_rows<7, false>, accumulate_rows<7, true>},
+    {accumulate_rows<8, false>, accumulate_rows<8, true>},
+    {accumulate_rows<9, false>, accumulate_rows<9, true>},
+    {accumulate_rows<10, false>, accumulate_rows<10, true>},
+};
+
+}  // namespace
+
+void accumulate_reduced_states(RhoConstRef rho, int row_begin, int row_end, ReducedStates& out,
+                               double* purity, std::complex<double>* trace) {
+    const int n = out.num_bits;
+    const bool with_pairs = !out.pairs.empty();
+    row_begin = std::max(row_begin, 0);
+    row_end = std::min(row_end, std::min(1 << n, static_cast<int>(rho.rows())));
+    const int fixed = (n <= FIXED_SWEEP_MAX_BITS) ? n : 0;
+    ACCUMULATE_ROWS[fixed][with_pairs ? 1 : 0](rho, row_begin, row_end, out, purity, trace);
+}
+
+// -Σ λ log₂ λ over eigenvalues above the numerical floor
+double entropy_from_eigenvalues(const double* lambda, int count) {
+    const double log2_e = 1.0 / std::log(2.0);
+    double entropy = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (lambda[i] > 1e-15) {
+            entropy -= lambda[i] * std::log(lambda[i]) * log2_e;
+        }
+    }
+    return std::max(entropy, 0.0);
+}
+
+namespace {
+
+// How many of the largest eigenvalues (ascending, as SelfAdjointEigenSolver
+// returns them) lie above tol·λ_max, capped at max_rank
+int dominant_count(const Eigen::VectorXd& lambda, int max_rank, double tol) {
+    const int m = static_cast<int>(lambda.size());
+    const double floor = std::max(0.0, tol * (m > 0 ? lambda(m - 1) : 0.0));
+    int keep = 0;
+    while (keep < std::min(m, std::max(1, max_rank)) && lambda(m - 1 - keep) > floor) {
+        keep++;
+    }
+    return keep;
+}
+
+}  // namespace
+
+void factor_low_rank(RhoConstRef rho, int max_rank, double tol, FactorMatrix& V) {
+    const Eigen::MatrixXcd hermitian = 0.5 * (rho + rho.adjoint());
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> solver(hermitian);
+    const Eigen::VectorXd& lambda = solver.eigenvalues();
+    const int m = static_cast<int>(lambda.size());
+    const int keep = dominant_count(lambda, max_rank, tol);
+    V.resize(hermitian.rows(), keep);
+    for (int k = 0; k < keep; k++) {
+        V.col(k) = solver.eigenvectors().col(m - 1 - k) * std::sqrt(lambda(m - 1 - k));
+    }
+}
+
+void low_rank_step(const Generator& gen, FactorMatrix& V, double h, int max_rank, double tol,
+                   FactorMatrix& work) {
+    const int dim = static_cast<int>(V.rows());
+    const int r = static_cast<int>(V.cols());
+    if (r == 0) {
+        return;
+    }
+    const int kraus = 1 + static_cast<int>(gen.lindblads->size() + gen.local_lindblads->size());
+    work.resize(dim, static_cast<Eigen::Index>(r) * kraus);
+
+    // K_0 = I - i h H_eff
+    const std::complex<double> minus_ih(0.0, -h);
+    auto k0 = work.leftCols(r);
+    k0 = V;
+    if (gen.heff_form != nullptr && !gen.heff_form->is_csr()) {
+        gen.heff_form->apply_left(minus_ih, V, k0);
+    } else if (gen.heff != nullptr) {
+        k0.noalias() += minus_ih * (*gen.heff * V);
+    }
+    for (const auto& entry : *gen.local_heff) {
+        local_apply_left(entry.op, entry.size, entry.mask, entry.offsets, minus_ih, V, k0);
+    }
+
+    // K_k = √h L_k
+    const std::complex<double> sqrt_h(std::sqrt(h), 0.0);
+    int column = r;
+    for (const auto& L : *gen.lindblads) {
+        if (!L->L_form.is_csr()) {
+            auto block = work.middleCols(column, r);
+            block.setZero();
+            L->L_form.apply_left(sqrt_h, V, block);
+        } else {
+            work.middleCols(column, r).noalias() = sqrt_h * (L->L * V);
+        }
+        column += r;
+    }
+    for (const auto& L_loc : *gen.local_lindblads) {
+        auto block = work.middleCols(column, r);
+        block.setZero();
+        local_apply_left(L_loc.op, L_loc.size, L_loc.mask, L_loc.offsets, sqrt_h, V, block);
+        column += r;
+    }
+
+    // W W† and W† W share their nonzero eigenvalues; W u / |W u| = eigenvectors of W W†
+    const double trace = V.squaredNorm();
+    const Eigen::MatrixXcd gram = work.adjoint() * work;
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> solver(gram);
+    const Eigen::VectorXd& lambda = solver.eigenvalues();
+    const int m = static_cast<int>(lambda.size());
+    const int keep = dominant_count(lambda, max_rank, tol);
+    // W u_k already has norm √λ_k, so it is the factor column as is
+    V.resize(dim, keep);
+    for (int k = 0; k < keep; k++) {
+        V.col(k).noalias() = work * solver.eigenvectors().col(m - 1 - k);
+    }
+    const double kept = V.squaredNorm();
+    if (kept > 0.0) {
+        V *= std::sqrt(trace / kept);
+    }
+}
+
+void compute_reduced_states_low_rank(const FactorMatrix& V, int num_qubits, bool with_pairs, ReducedStates& out,
+                                     double* purity, std::complex<double>* trace) {
+    const int n = num_qubits;
+    const int dim = 1 << n;
+    out.num_bits = n;
+    out.singles.assign(n, Eigen::Matrix<std::complex<double>, 2, 2>::Zero());
+    out.pairs.assign(with_pairs ? n * (n - 1) / 2 : 0, Eigen::Matrix<std::complex<double>, 4, 4>::Zero());
+    if (purity) {
+        // Tr(ρ²) = ||V† V||_F², from the r × r Gram matrix
+        *purity = (V.adjoint() * V).squaredNorm();
+    }
+    if (trace) {
+        *trace = std::complex<double>(V.squaredNorm(), 0.0);
+    }
+    if (n <= 0 || dim > V.rows()) {
+        return;
+    }
+
+    // Same element walk as compute_reduced_states, with ρ(i, j) = V_i · V_j†
+    // formed only for the popcount(i ^ j) <= 2 elements it needs
+    auto element = [&V](int i, int j) { return V.row(j).dot(V.row(i)); };
+    for (int i = 0; i < dim; i++) {
+        const std::complex<double> d(V.row(i).squaredNorm(), 0.0);
+        for (int p = 0; p < n; p++) {
+            const int bp = (i >> p) & 1;
+            out.singles[p](bp, bp) += d;
+            if (with_pairs) {
+                for (int q = p + 1; q < n; q++) {
+                    const int l = (((i >> q) & 1) << 1) | bp;
+                    out.pairs[out.pair_index(p, q)](l, l) += d;
+                }
+            }
+        }
+
+        for (int b = 0; b < n; b++) {
+            const int j = i ^ (1 << b);
+            const std::complex<double> v = element(i, j);
+            out.singles[b]((i >> b) & 1, (j >> b) & 1) += v;
+            if (!with_pairs) {
+                continue;
+            }
+            for (int c = 0; c < n; c++) {
+                if (c == b) {
+                    continue;
+                }
+                const int p = std::min(b, c);
+                const int q = std::max(b, c);
+                const int li = (((i >> q) & 1) << 1) | ((i >> p) & 1);
+                const int lj = (((j >> q) & 1) << 1) | ((j >> p) & 1);
+                out.pairs[out.pair_index(p, q)](li, lj) += v;
+            }
+        }
+
+        if (with_pairs) {
+            for (int p = 0; p < n; p++) {
+                for (int q = p + 1; q < n; q++) {
+                    const int j = i ^ (1 << p) ^ (1 << q);
+                    const int li = (((i >> q) & 1) << 1) | ((i >> p) & 1);
+                    const int lj = (((j >> q) & 1) << 1) | ((j >> p) & 1);
+                    out.pairs[out.pair_index(p, q)](li, lj) += element(i, j);
+                }
+            }
+        }
+    }
+}
+
+// Eigenvalues of a Hermitian 2×2: (a + d)/2 ± √(((a - d)/2)² + |b|²)
+void hermitian_eigenvalues_2x2(const Eigen::Matrix<std::complex<double>, 2, 2> & m, double* out) {
+    const double a = m(0, 0).real();
+    const double d = m(1, 1).real();
+    const double half_diff = 0.5 * (a - d);
+    const double radius = std::sqrt(half_diff * half_diff + std::norm(m(0, 1)));
+    const double mean = 0.5 * (a + d);
+    out[0] = mean - radius;
+    out[1] = mean + radius;
+}
+
+// Eigenvalues of a Hermitian 4×4 by cyclic complex Jacobi: each rotation first
+// phases a(p,q) real (D = diag(.., e^{-iφ} at q, ..)), then applies the real
+// Jacobi rotation that zeroes it. Converges quadratically; a few sweeps suffice.
+void hermitian_eigenvalues_4x4(Eigen::Matrix<std::complex<double>, 4, 4> a, double* out) {
+    for (int sweep = 0; sweep < 12; sweep++) {
+        double off = 0.0;
+        double diag = 0.0;
+        for (int p = 0; p < 4; p++) {
+            diag += std::norm(a(p, p));
+            for (int q = p + 1; q < 4; q++) {
+                off += std::norm(a(p, q));
+            }
+        }
+        if (off <= 1e-30 * std::max(diag, 1e-300)) {
+            break;
+        }
+
+        for (int p = 0; p < 3; p++) {
+            for (int q = p + 1; q < 4; q++) {
+                const double g = std::abs(a(p, q));
+                if (g < 1e-300) {
+                    continue;
+                }
+                const std::complex<double> phase = a(p, q) / g;
+                a.col(q) *= std::conj(phase);
+                a.row(q) *= phase;
+
+                const double theta = (a(q, q).real() - a(p, p).real()) / (2.0 * g);
+                const double t = (theta >= 0.0 ? 1.0 : -1.0) /
+                                 (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0);
+                const double s = t * c;
+                for (int k = 0; k < 4; k++) {
+                    const std::complex<double> akp = a(k, p);
+                    const std::complex<double> akq = a(k, q);
+                    a(k, p) = c * akp - s * akq;
+                    a(k, q) = s * akp + c * akq;
+                }
+                for (int k = 0; k < 4; k++) {
+                    const std::complex<double> apk = a(p, k);
+                    const std::complex<double> aqk = a(q, k);
+                    a(p, k) = c * apk - s * aqk;
+                    a(q, k) = s * apk + c * aqk;
+                }
+            }
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        out[i] = a(i, i).real();
+    }
+}
+
+double concurrence_4x4(const Eigen::Matrix<std::complex<double>, 4, 4>& rho) {
+    typedef Eigen::Matrix<std::complex<double>, 4, 4> Matrix4c;
+    // Y⊗Y is antidiagonal with signs (-1, 1, 1, -1), so the spin flip is
+    // ρ̃(i, j) = s_i s_j conj(ρ(3 - i, 3 - j))
+    static const double sign[4] = {-1.0, 1.0, 1.0, -1.0};
+    Matrix4c flipped;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            flipped(i, j) = sign[i] * sign[j] * std::conj(rho(3 - i, 3 - j));
+        }
+    }
+
+    // √ρ from the fixed-size solver (negative round-off clamped)
+    Eigen::SelfAdjointEigenSolver<Matrix4c> solver(rho);
+    const Eigen::Vector4d roots = solver.eigenvalues().cwiseMax(0.0).cwiseSqrt();
+    const Matrix4c sqrt_rho = solver.eigenvectors() * roots.asDiagonal() * solver.eigenvectors().adjoint();
+    const Matrix4c product = sqrt_rho * flipped * sqrt_rho;
+
+    double mu[4];
+    hermitian_eigenvalues_4x4(product, mu);
+    double lambda[4];
+    for (int i = 0; i < 4; i++) {
+        lambda[i] = std::sqrt(std::max(mu[i], 0.0));
+    }
+    std::sort(lambda, lambda + 4);
+    return std::max(0.0, lambda[3] - lambda[2] - lambda[1] - lambda[0]);
+}
+
+double log_negativity_4x4(const Eigen::Matrix<std::complex<double>, 4, 4>& rho) {
+    // Transpose the low local digit: (a_hi a_lo, b_hi b_lo) -> (a_hi b_lo, b_hi a_lo)
+    Eigen::Matrix<std::complex<double>, 4, 4> transposed;
+    for (int a = 0; a < 4; a++) {
+        for (int b = 0; b < 4; b++) {
+            transposed((a & 2) | (b & 1), (b & 2) | (a & 1)) = rho(a, b);
+        }
+    }
+    double mu[4];
+    hermitian_eigenvalues_4x4(transposed, mu);
+    const double trace_norm = std::abs(mu[0]) + std::abs(mu[1]) + std::abs(mu[2]) + std::abs(mu[3]);
+    return std::max(0.0, std::log2(std::max(trace_norm, 1e-300)));
+}
+
+}  // namespace lindblad
+}  // namespace godot
@@ -1,7 +1,11 @@
 #include "liquid_neural_net.h"
 #include <iostream>
+#include <cstring>
 
 LiquidNeuralNet::LiquidNeuralNet(int in_size, int hidden, int out_size)
+    : LiquidNeuralNet(in_size, hidden, out_size, true) {}
+
+LiquidNeuralNet::LiquidNeuralNet(int in_size, int hidden, int out_size, bool initialize)
     : input_size(in_size),
       hidden_size(hidden),
       output_size(out_size),
@@ -15,11 +19,63 @@ LiquidNeuralNet::LiquidNeuralNet(int in_size, int hidden, int out_size)
       leak(0.3),
       learning_rate(0.001),
       l2_reg(0.0001),
-      rng(std::random_device{}()) {
-    initialize_weights();
-    reset_state();
+      rng(std::random_device{}()),
+      m_activation(hidden) {
+    if (initialize) {
+        initialize_weights();
+        reset_state();
+    }
+}
+
+namespace {
+
+struct WeightsHeader {
+    uint32_t magic;
+    uint32_t version;
+    int32_t input_size;
+    int32_t hidden_size;
+    int32_t output_size;
+    uint32_t reserved;
+    double tau;
+    double leak;
+};
+static_assert(sizeof(WeightsHeader) == 40, "LNN weight header layout");
+
+size_t weights_payload(int in, int hidden, int out) {
+    return sizeof(double) * (static_cast<size_t>(in) * hidden + static_cast<size_t>(hidden) * hidden +
+                             static_cast<size_t>(hidden) * out + hidden + out);
+}
+
+// Header of a snapshot, false if it is too short, foreign or malformed
+bool read_weights_header(const uint8_t* data, size_t size, WeightsHeader& header) {
+    if (data == nullptr || size < sizeof(WeightsHeader)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != LiquidNeuralNet::WEIGHTS_MAGIC || header.version != LiquidNeuralNet::WEIGHTS_VERSION ||
+        header.input_size <= 0 || header.hidden_size <= 0 || header.output_size <= 0) {
+        return false;
+    }
+    return size >= sizeof(WeightsHeader) +
+                       weights_payload(header.input_size, header.hidden_size, header.output_size);
 }
 
+template <typename Derived>
+const uint8_t* read_block(const uint8_t* src, Eigen::PlainObjectBase<Derived>& dst) {
+    const size_t bytes = sizeof(double) * dst.size();
+    std::memcpy(dst.data(), src, bytes);
+    return src + bytes;
+}
+
+template <typename Derived>
+uint8_t* write_block(uint8_t* dst, const Eigen::PlainObjectBase<Derived>& src) {
+    const size_t bytes = sizeof(double) * src.size();
+    std::memcpy(dst, src.data(), bytes);
+    return dst + bytes;
+}
+
+}  // namespace
+
 void LiquidNeuralNet::initialize_weights() {
     std::uniform_real_distribution<double> dist(-1.0, 1.0);
 
@@ -57,6 +113,50 @@ void LiquidNeuralNet::reset_state() {
     }
 }
 
+size_t LiquidNeuralNet::weights_byte_size() const {
+    return sizeof(WeightsHeader) + weights_payload(input_size, hidden_size, output_size);
+}
+
+void LiquidNeuralNet::save_weights(uint8_t* out) const {
+    WeightsHeader header = {WEIGHTS_MAGIC, WEIGHTS_VERSION, input_size, hidden_size, output_size, 0, tau, leak};
+    std::memcpy(out, &header, sizeof(header));
+    uint8_t* dst = out + sizeof(header);
+    dst = write_block(dst, W_in);
+    dst = write_block(dst, W_rec);
+    dst = write_block(dst, W_out);
+    dst = write_block(dst, b_hidden);
+    write_block(dst, b_out);
+}
+
+bool LiquidNeuralNet::load_weights(const uint8_t* data, size_t size) {
+    WeightsHeader header;
+    if (!read_weights_header(data, size, header) || header.input_size != input_size ||
+        header.hidden_size != hidden_size || header.output_size != output_size) {
+        return false;
+    }
+    tau = header.tau;
+    leak = header.leak;
+    const uint8_t* src = data + sizeof(header);
+    src = read_block(src, W_in);
+    src = read_block(src, W_rec);
+    src = read_block(src, W_out);
+    src = read_block(src, b_hidden);
+    read_block(src, b_out);
+    return true;
+}
+
+std::shared_ptr<LiquidNeuralNet> LiquidNeuralNet::from_weights(const uint8_t* data, size_t size) {
+    WeightsHeader header;
+    if (!read_weights_header(data, size, header)) {
+        return nullptr;
+    }
+    std::shared_ptr<LiquidNeuralNet> net(
+        new LiquidNeuralNet(header.input_size, header.hidden_size, header.output_size, false));
+    net->load_weights(data, size);
+    net->reset_state();
+    return net;
+}
+
 std::vector<double> LiquidNeuralNet::forward(const std::vector<double>& input_phase) {
     if ((int)input_phase.size() != input_size) {
         std::cerr << "LNN forward: input size mismatch (" << input_phase.size()
@@ -64,32 +164,46 @@ std::vector<double> LiquidNeuralNet::forward(const std::vector<double>& input_ph
         return std::vector<double>(output_size, 0.0);
     }
 
-    // Convert input to Eigen vector
-    VectorXd x_in = VectorXd::Map(const_cast<double*>(input_phase.data()), input_size);
+    std::vector<double> output(output_size);
+    forward_into(input_phase.data(), output.data());
+    return output;
+}
 
-    // x_in = W_in @ input
-    x_in = W_in.transpose() * x_in + b_hidden;
+void LiquidNeuralNet::forward_into(const double* input, double* output) {
+    forward_into(input, hidden_state.data(), output, m_activation.data());
+}
 
-    // x_rec = W_rec @ h_prev
-    VectorXd x_rec = W_rec.transpose() * hidden_state;
+void LiquidNeuralNet::forward_into(const double* input, double* hidden, double* output, double* scratch) const {
+    const Eigen::Map<const VectorXd> x(input, input_size);
+    Eigen::Map<VectorXd> h(hidden, hidden_size);
+    Eigen::Map<VectorXd> activation_in(scratch, hidden_size);
+    Eigen::Map<VectorXd> y(output, output_size);
 
-    // Update hidden state: h_new = (1 - leak) * h_old + leak * tanh(x_in + x_rec)
-    VectorXd activation_in = x_in + x_rec;
-    for (int h = 0; h < hidden_size; ++h) {
-        double act = activation(activation_in(h));
-        hidden_state(h) = (1.0 - leak) * hidden_state(h) + leak * act;
-    }
+    // activation_in = W_in^T x + W_rec^T h_old + b_hidden
+    activation_in.noalias() = W_in.transpose() * x;
+    activation_in.noalias() += W_rec.transpose() * h;
+    activation_in += b_hidden;
 
-    // Compute output: y = W_out @ h_new + b_out
-    VectorXd output_vec = W_out.transpose() * hidden_state + b_out;
+    // Update hidden state: h_new = (1 - leak) * h_old + leak * tanh(activation_in)
+    h = (1.0 - leak) * h + leak * activation_in.array().tanh().matrix();
 
-    // Convert to std::vector
-    std::vector<double> output(output_size);
-    for (int o = 0; o < output_size; ++o) {
-        output[o] = output_vec(o);
-    }
+    // Compute output: y = W_out^T h_new + b_out
+    y.noalias() = W_out.transpose() * h;
+    y += b_out;
+}
 
-    return output;
+void LiquidNeuralNet::forward_batch(const Eigen::Ref<const MatrixXd>& inputs, Eigen::Ref<MatrixXd> hidden,
+                                    Eigen::Ref<MatrixXd> outputs) const {
+    // Same update as forward, column-wise:
+    // h_new = (1 - leak) * h_old + leak * tanh(W_in^T x + b_hidden + W_rec^T h_old)
+    MatrixXd activation_in = W_in.transpose() * inputs;
+    activation_in.noalias() += W_rec.transpose() * hidden;
+    activation_in.colwise() += b_hidden;
+    hidden = (1.0 - leak) * hidden + leak * activation_in.array().tanh().matrix();
+
+    // y = W_out^T h_new + b_out
+    outputs.noalias() = W_out.transpose() * hidden;
+    outputs.colwise() += b_out;
 }
 
 double LiquidNeuralNet::train_batch(const std::vector<std::vector<double>>& target_trajectory) {
@@ -159,6 +273,142 @@ double LiquidNeuralNet::train_batch(const std::vector<std::vector<double>>& targ
     return total_loss;
 }
 
+double LiquidNeuralNet::train_bptt(const Eigen::Ref<const MatrixXd>& inputs, const Eigen::Ref<const MatrixXd>& targets,
+                                   const Eigen::Ref<const VectorXd>& h0, int truncation) {
+    const int T = static_cast<int>(std::min(inputs.cols(), targets.cols()));
+    if (T == 0 || inputs.rows() != input_size || targets.rows() != output_size || h0.size() != hidden_size) {
+        return 0.0;
+    }
+    const int window = std::max(1, std::min(truncation, T));
+    const double max_grad_norm = 5.0;  // Clip so one bad window cannot blow up W_rec
+
+    MatrixXd grad_W_in(input_size, hidden_size);
+    MatrixXd grad_W_rec(hidden_size, hidden_size);
+    MatrixXd grad_W_out(hidden_size, output_size);
+    VectorXd grad_b_hidden(hidden_size);
+    VectorXd grad_b_out(output_size);
+
+    // Per-window activations: hs.col(k) is the state before step k of the
+    // window, hs.col(k + 1) after it; acts.col(k) = tanh of its pre-activation
+    MatrixXd hs(hidden_size, window + 1);
+    MatrixXd acts(hidden_size, window);
+    MatrixXd errors(output_size, window);
+    VectorXd dh(hidden_size);
+    VectorXd dh_next(hidden_size);
+    VectorXd da(hidden_size);
+
+    VectorXd h = h0;
+    double total_loss = 0.0;
+    for (int start = 0; start < T; start += window) {
+        const int len = std::min(window, T - start);
+
+        // Forward through the window
+        hs.col(0) = h;
+        for (int k = 0; k < len; ++k) {
+            const int t = start + k;
+            acts.col(k) = (W_in.transpose() * inputs.col(t) + W_rec.transpose() * hs.col(k) + b_hidden)
+                              .array().tanh().matrix();
+            hs.col(k + 1) = (1.0 - leak) * hs.col(k) + leak * acts.col(k);
+            errors.col(k) = W_out.transpose() * hs.col(k + 1) + b_out - targets.col(t);
+            total_loss += errors.col(k).squaredNorm();
+        }
+
+        // Backward through the window (loss = mean over its steps)
+        grad_W_in.setZero();
+        grad_W_rec.setZero();
+        grad_W_out.setZero();
+        grad_b_hidden.setZero();
+        grad_b_out.setZero();
+        dh_next.setZero();
+        const double scale = 2.0 / len;
+        for (int k = len - 1; k >= 0; --k) {
+            const VectorXd dy = scale * errors.col(k);
+            grad_W_out.noalias() += hs.col(k + 1) * dy.transpose();
+            grad_b_out += dy;
+
+            dh = dh_next;
+            dh.noalias() += W_out * dy;
+            da = leak * dh.array() * (1.0 - acts.col(k).array().square());
+            grad_W_in.noalias() += inputs.col(start + k) * da.transpose();
+            grad_W_rec.noalias() += hs.col(k) * da.transpose();
+            grad_b_hidden += da;
+
+            dh_next = (1.0 - leak) * dh;
+            dh_next.noalias() += W_rec * da;
+        }
+
+        const double grad_norm = std::sqrt(grad_W_in.squaredNorm() + grad_W_rec.squaredNorm() +
+                                           grad_W_out.squaredNorm() + grad_b_hidden.squaredNorm() +
+                                           grad_b_out.squaredNorm());
+        const double step = learning_rate * (grad_norm > max_grad_norm ? max_grad_norm / grad_norm : 1.0);
+        W_in -= step * grad_W_in + learning_rate * l2_reg * W_in;
+        W_rec -= step * grad_W_rec + learning_rate * l2_reg * W_rec;
+        W_out -= step * grad_W_out + learning_rate * l2_reg * W_out;
+        b_hidden -= step * grad_b_hidden;
+        b_out -= step * grad_b_out;
+
+        // Carry the state into the next window (the truncation point)
+        h = hs.col(len);
+    }
+
+    return total_loss / T;
+}
+
+LnnTrainer::~LnnTrainer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_queue.clear();
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+std::shared_ptr<LnnTrainer::Job> LnnTrainer::submit(const std::shared_ptr<const LiquidNeuralNet>& source,
+                                                    MatrixXd inputs, MatrixXd targets, VectorXd h0,
+                                                    int truncation, int epochs) {
+    auto job = std::make_shared<Job>();
+    job->source = source;
+    job->result = std::make_shared<LiquidNeuralNet>(*source);  // Weight snapshot
+    job->inputs = std::move(inputs);
+    job->targets = std::move(targets);
+    job->h0 = std::move(h0);
+    job->truncation = truncation;
+    job->epochs = std::max(1, epochs);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(job);
+        if (!m_thread.joinable()) {
+            m_thread = std::thread([this]() { worker_loop(); });
+        }
+    }
+    m_cv.notify_one();
+    return job;
+}
+
+void LnnTrainer::worker_loop() {
+    while (true) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        // Only this thread touches job->result until done is published
+        for (int epoch = 0; epoch < job->epochs; ++epoch) {
+            job->loss = job->result->train_bptt(job->inputs, job->targets, job->h0, job->truncation);
+        }
+        job->done.store(true, std::memory_order_release);
+    }
+}
+
 void LiquidNeuralNet::set_learning_rate(double lr) {
     learning_rate = std::max(0.0001, std::min(0.1, lr));
 }
@@ -178,3 +428,25 @@ std::vector<double> LiquidNeuralNet::get_hidden_state() const {
     }
     return state;
 }
+
+namespace {
+
+template <int In, int Hidden, int Out>
+std::unique_ptr<LnnKernel> make_fixed(const LiquidNeuralNet& net, bool single_precision) {
+    if (single_precision) {
+        return std::make_unique<LiquidNeuralNetFixed<In, Hidden, Out, float>>(net);
+    }
+    return std::make_unique<LiquidNeuralNetFixed<In, Hidden, Out, double>>(net);
+}
+
+}  // namespace
+
+std::unique_ptr<LnnKernel> make_lnn_kernel(const LiquidNeuralNet& net, bool single_precision) {
+    if (net.input_size == 32 && net.hidden_size == 8 && net.output_size == 32) {
+        return make_fixed<32, 8, 32>(net, single_precision);
+    }
+    if (net.input_size == 64 && net.hidden_size == 16 && net.output_size == 64) {
+        return make_fixed<64, 16, 64>(net, single_precision);
+    }
+    return nullptr;
+}
@@ -5,6 +5,14 @@
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
 #include <Eigen/Dense>
 
 using Eigen::MatrixXd;
@@ -43,9 +51,44 @@ public:
     // Returns output_size values (phase modulation signals)
     std::vector<double> forward(const std::vector<double>& input_phase);
 
+    // Allocation-free forward pass: reads input_size values from input,
+    // advances hidden_state and writes output_size values to output, using
+    // only buffers sized at construction
+    void forward_into(const double* input, double* output);
+
+    // Same step on a caller-owned state (hidden: hidden_size values, advanced
+    // in place) with caller scratch of hidden_size values; does not touch
+    // hidden_state, so any number of threads may share these weights
+    void forward_into(const double* input, double* hidden, double* output, double* scratch) const;
+
+    // Batched forward pass through these weights for B independent states
+    // (e.g. biomes sharing one network): column b of inputs (input_size × B)
+    // advances column b of hidden (hidden_size × B) and writes column b of
+    // outputs (output_size × B). One matrix-matrix product per layer instead
+    // of B matrix-vector products. Does not touch hidden_state.
+    void forward_batch(const Eigen::Ref<const MatrixXd>& inputs, Eigen::Ref<MatrixXd> hidden,
+                       Eigen::Ref<MatrixXd> outputs) const;
+
     // Reset hidden state to small random values
     void reset_state();
 
+    // Binary weight snapshot, uncompressed so a memory-mapped file can be
+    // read in place. Layout (little-endian):
+    //   u32 magic "SWLN", u32 version, i32 input_size, i32 hidden_size,
+    //   i32 output_size, u32 reserved, f64 tau, f64 leak,
+    //   then W_in, W_rec, W_out (column-major), b_hidden, b_out as f64.
+    // The header is 40 bytes, so every weight is 8-byte aligned.
+    static constexpr uint32_t WEIGHTS_MAGIC = 0x4E4C5753;  // "SWLN"
+    static constexpr uint32_t WEIGHTS_VERSION = 1;
+    size_t weights_byte_size() const;
+    void save_weights(uint8_t* out) const;  // Writes weights_byte_size() bytes
+    // Replace the weights from a snapshot with this network's dimensions;
+    // false (weights untouched) on a bad header, version or shape
+    bool load_weights(const uint8_t* data, size_t size);
+    // Network built straight from a snapshot (no Xavier initialization),
+    // nullptr if the snapshot is invalid
+    static std::shared_ptr<LiquidNeuralNet> from_weights(const uint8_t* data, size_t size);
+
     // Setter methods
     void set_learning_rate(double lr);
     void set_leak(double new_leak);
@@ -59,7 +102,19 @@ public:
     // Returns total loss
     double train_batch(const std::vector<std::vector<double>>& target_trajectory);
 
+    // Training: truncated backpropagation through time over every weight.
+    // Column t of inputs (input_size × T) drives step t from hidden state h0;
+    // column t of targets (output_size × T) is the wanted output. The
+    // sequence is cut into windows of `truncation` steps, gradients flow back
+    // through the whole window and one clipped SGD step (with l2_reg) is taken
+    // per window. Does not touch hidden_state. Returns mean squared error.
+    double train_bptt(const Eigen::Ref<const MatrixXd>& inputs, const Eigen::Ref<const MatrixXd>& targets,
+                      const Eigen::Ref<const VectorXd>& h0, int truncation);
+
 private:
+    // initialize = false leaves weights and state unset (from_weights fills them)
+    LiquidNeuralNet(int in_size, int hidden, int out_size, bool initialize);
+
     // Xavier initialization helper
     void initialize_weights();
 
@@ -76,6 +131,109 @@ private:
 
     // Random number generator
     std::mt19937 rng;
+
+    // Pre-activation scratch for forward_into (hidden_size)
+    VectorXd m_activation;
+};
+
+/**
+ * Forward-only LNN kernel with compile-time sizes (see make_lnn_kernel).
+ *
+ * forward() reads input_size phases, advances a hidden state kept by the
+ * caller in double precision and writes output_size deltas, same math as
+ * LiquidNeuralNet::forward. Holds a copy of the weights taken at creation:
+ * rebuild it after the source network is retrained.
+ */
+class LnnKernel {
+public:
+    virtual ~LnnKernel() = default;
+    virtual void forward(const double* input, double* hidden, double* output) const = 0;
 };
 
+// Weights as fixed-size Eigen matrices in Scalar (float or double), stored
+// transposed so each layer is one W·x: no heap use, fully unrollable
+template <int In, int Hidden, int Out, typename Scalar>
+class LiquidNeuralNetFixed : public LnnKernel {
+public:
+    explicit LiquidNeuralNetFixed(const LiquidNeuralNet& source)
+        : W_in_t(source.W_in.transpose().cast<Scalar>()),
+          W_rec_t(source.W_rec.transpose().cast<Scalar>()),
+          W_out_t(source.W_out.transpose().cast<Scalar>()),
+          b_hidden(source.b_hidden.cast<Scalar>()),
+          b_out(source.b_out.cast<Scalar>()),
+          leak(static_cast<Scalar>(source.leak)) {}
+
+    void forward(const double* input, double* hidden, double* output) const override {
+        const Eigen::Map<const Eigen::Matrix<double, In, 1>> x_in(input);
+        const Eigen::Matrix<Scalar, In, 1> x = x_in.template cast<Scalar>();
+        Eigen::Map<Eigen::Matrix<double, Hidden, 1>> h_io(hidden);
+        Eigen::Matrix<Scalar, Hidden, 1> h = h_io.template cast<Scalar>();
+
+        // h_new = (1 - leak) * h_old + leak * tanh(W_in^T x + W_rec^T h_old + b_hidden)
+        const Eigen::Matrix<Scalar, Hidden, 1> pre = W_in_t * x + W_rec_t * h + b_hidden;
+        h = (Scalar(1) - leak) * h + leak * pre.array().tanh().matrix();
+        h_io = h.template cast<double>();
+
+        Eigen::Map<Eigen::Matrix<double, Out, 1>> y(output);
+        y = (W_out_t * h + b_out).template cast<double>();
+    }
+
+private:
+    Eigen::Matrix<Scalar, Hidden, In> W_in_t;
+    Eigen::Matrix<Scalar, Hidden, Hidden> W_rec_t;
+    Eigen::Matrix<Scalar, Out, Hidden> W_out_t;
+    Eigen::Matrix<Scalar, Hidden, 1> b_hidden;
+    Eigen::Matrix<Scalar, Out, 1> b_out;
+    Scalar leak;
+};
+
+/**
+ * LnnTrainer - Background truncated-BPTT training on weight snapshots
+ *
+ * submit() copies the network's weights and returns at once; one worker
+ * thread (started on first use) runs train_bptt on the copy. When a job is
+ * finished its result is published by setting `done` (release): readers that
+ * see done == true (acquire) may take `result` and swap it in for the live
+ * network between forward passes, so inference never waits on training.
+ */
+class LnnTrainer {
+public:
+    struct Job {
+        std::shared_ptr<const LiquidNeuralNet> source;  // Network the snapshot was taken from
+        MatrixXd inputs;
+        MatrixXd targets;
+        VectorXd h0;
+        int truncation = 16;
+        int epochs = 1;
+
+        std::shared_ptr<LiquidNeuralNet> result;  // Trained copy, valid once done
+        double loss = 0.0;                        // Mean squared error of the last epoch
+        std::atomic<bool> done{false};
+    };
+
+    LnnTrainer() = default;
+    ~LnnTrainer();
+    LnnTrainer(const LnnTrainer&) = delete;
+    LnnTrainer& operator=(const LnnTrainer&) = delete;
+
+    // Queue training of a snapshot of `source`; the caller must keep source
+    // unmodified only for the duration of this call
+    std::shared_ptr<Job> submit(const std::shared_ptr<const LiquidNeuralNet>& source, MatrixXd inputs,
+                                MatrixXd targets, VectorXd h0, int truncation, int epochs);
+
+private:
+    void worker_loop();
+
+    std::thread m_thread;
+    std::mutex m_mutex;  // Guards m_queue and m_stopping
+    std::condition_variable m_cv;
+    std::deque<std::shared_ptr<Job>> m_queue;
+    bool m_stopping = false;
+};
+
+// Fixed-size kernel for the shapes biomes use (32→8→32 and 64→16→64, i.e.
+// 5 and 6 qubits with hidden = dim/4) in float or double; nullptr for any
+// other shape (callers keep the dynamic LiquidNeuralNet path)
+std::unique_ptr<LnnKernel> make_lnn_kernel(const LiquidNeuralNet& net, bool single_precision);
+
 #endif // LIQUID_NEURAL_NET_H
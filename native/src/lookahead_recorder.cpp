@@ -0,0 +1,202 @@
+#include "lookahead_recorder.h"
+
+#include <godot_cpp/variant/utility_functions.hpp>
+
+using namespace godot;
+
+bool LookaheadRecorder::open_write(const String& path) {
+    close();
+    m_file = FileAccess::open_compressed(path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+    if (m_file.is_null()) {
+        UtilityFunctions::push_warning("LookaheadRecorder: Cannot open ", path, " for writing (error ",
+                                       static_cast<int>(FileAccess::get_open_error()), ")");
+        return false;
+    }
+    m_file->store_32(MAGIC);
+    m_file->store_32(VERSION);
+    return true;
+}
+
+void LookaheadRecorder::close() {
+    if (m_file.is_valid()) {
+        m_file->close();
+        m_file.unref();
+    }
+}
+
+void LookaheadRecorder::write_doubles(const PackedFloat64Array& data) {
+    m_file->store_32(static_cast<uint32_t>(data.size()));
+    if (!data.is_empty()) {
+        m_file->store_buffer(reinterpret_cast<const uint8_t*>(data.ptr()), data.size() * sizeof(double));
+    }
+}
+
+void LookaheadRecorder::write_register(int dim, const PackedFloat64Array& H_packed, const Array& lindblad_triplets,
+                                       int num_qubits, int num_trajectories, const Dictionary& metadata) {
+    if (!is_open()) {
+        return;
+    }
+    m_file->store_8(RECORD_REGISTER);
+    m_file->store_32(static_cast<uint32_t>(dim));
+    write_doubles(H_packed);
+    m_file->store_32(static_cast<uint32_t>(lindblad_triplets.size()));
+    for (int i = 0; i < lindblad_triplets.size(); i++) {
+        write_doubles(lindblad_triplets[i]);
+    }
+    m_file->store_32(static_cast<uint32_t>(num_qubits));
+    m_file->store_32(static_cast<uint32_t>(num_trajectories));
+    m_file->store_var(metadata);
+}
+
+void LookaheadRecorder::write_metadata(int biome_id, const Dictionary& metadata) {
+    if (!is_open()) {
+        return;
+    }
+    m_file->store_8(RECORD_METADATA);
+    m_file->store_32(static_cast<uint32_t>(biome_id));
+    m_file->store_var(metadata);
+}
+
+void LookaheadRecorder::write_clear() {
+    if (!is_open()) {
+        return;
+    }
+    m_file->store_8(RECORD_CLEAR);
+}
+
+void LookaheadRecorder::write_update_hamiltonian(int biome_id, const PackedFloat64Array& triplets) {
+    if (!is_open()) {
+        return;
+    }
+    m_file->store_8(RECORD_UPDATE_HAMILTONIAN);
+    m_file->store_32(static_cast<uint32_t>(biome_id));
+    write_doubles(triplets);
+}
+
+void LookaheadRecorder::write_replace_lindblad(int biome_id, int k, const PackedFloat64Array& triplets) {
+    if (!is_open()) {
+        return;
+    }
+    m_file->store_8(RECORD_REPLACE_LINDBLAD);
+    m_file->store_32(static_cast<uint32_t>(biome_id));
+    m_file->store_32(static_cast<uint32_t>(k));
+    write_doubles(triplets);
+}
+
+void LookaheadRecorder::write_lookahead(const std::vector<PackedFloat64Array>& rhos, int num_biomes, int steps,
+                                        double dt, double max_dt, bool packed) {
+    if (!is_open()) {
+        return;
+    }
+    m_file->store_8(RECORD_LOOKAHEAD);
+    m_file->store_32(static_cast<uint32_t>(steps));
+    m_file->store_double(dt);
+    m_file->store_double(max_dt);
+    m_file->store_8(packed ? 1 : 0);
+    m_file->store_32(static_cast<uint32_t>(num_biomes));
+    for (int b = 0; b < num_biomes; b++) {
+        write_doubles(rhos[b]);
+    }
+}
+
+bool LookaheadRecorder::open_read(const String& path) {
+    close();
+    m_file = FileAccess::open_compressed(path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+    if (m_file.is_null()) {
+        UtilityFunctions::push_warning("LookaheadRecorder: Cannot open ", path, " for reading (error ",
+                                       static_cast<int>(FileAccess::get_open_error()), ")");
+        return false;
+    }
+    const uint32_t magic = m_file->get_32();
+    const uint32_t version = m_file->get_32();
+    if (magic != MAGIC || version != VERSION) {
+        UtilityFunctions::push_warning("LookaheadRecorder: ", path, " is not a version ",
+                                       static_cast<int>(VERSION), " lookahead recording");
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool LookaheadRecorder::read_doubles(PackedFloat64Array& out) {
+    const uint32_t count = m_file->get_32();
+    const uint64_t remaining = m_file->get_length() - m_file->get_position();
+    if (m_file->eof_reached() || static_cast<uint64_t>(count) * sizeof(double) > remaining) {
+        return false;  // Truncated or corrupt length
+    }
+    out.resize(count);
+    if (count > 0) {
+        m_file->get_buffer(reinterpret_cast<uint8_t*>(out.ptrw()), static_cast<uint64_t>(count) * sizeof(double));
+    }
+    return true;
+}
+
+bool LookaheadRecorder::next(Record& out) {
+    out = Record();
+    if (!is_open() || m_file->get_position() >= m_file->get_length()) {
+        return false;
+    }
+    const uint8_t type = m_file->get_8();
+    switch (type) {
+        case RECORD_REGISTER: {
+            out.dim = static_cast<int>(m_file->get_32());
+            if (!read_doubles(out.hamiltonian)) {
+                return false;
+            }
+            const uint32_t num_ops = m_file->get_32();
+            for (uint32_t i = 0; i < num_ops; i++) {
+                PackedFloat64Array triplets;
+                if (!read_doubles(triplets)) {
+                    return false;
+                }
+                out.triplets.push_back(triplets);
+            }
+            out.num_qubits = static_cast<int>(m_file->get_32());
+            out.num_trajectories = static_cast<int>(m_file->get_32());
+            out.metadata = m_file->get_var();
+            break;
+        }
+        case RECORD_METADATA:
+            out.biome_id = static_cast<int>(m_file->get_32());
+            out.metadata = m_file->get_var();
+            break;
+        case RECORD_CLEAR:
+            break;
+        case RECORD_UPDATE_HAMILTONIAN:
+            out.biome_id = static_cast<int>(m_file->get_32());
+            if (!read_doubles(out.hamiltonian)) {
+                return false;
+            }
+            break;
+        case RECORD_REPLACE_LINDBLAD:
+            out.biome_id = static_cast<int>(m_file->get_32());
+            out.index = static_cast<int>(m_file->get_32());
+            if (!read_doubles(out.hamiltonian)) {
+                return false;
+            }
+            break;
+        case RECORD_LOOKAHEAD: {
+            out.steps = static_cast<int>(m_file->get_32());
+            out.dt = m_file->get_double();
+            out.max_dt = m_file->get_double();
+            out.packed = m_file->get_8() != 0;
+            const uint32_t num_biomes = m_file->get_32();
+            for (uint32_t b = 0; b < num_biomes; b++) {
+                PackedFloat64Array rho;
+                if (!read_doubles(rho)) {
+                    return false;
+                }
+                out.rhos.push_back(rho);
+            }
+            break;
+        }
+        default:
+            UtilityFunctions::push_warning("LookaheadRecorder: Unknown record type ", static_cast<int>(type));
+            return false;
+    }
+    if (m_file->eof_reached()) {
+        return false;
+    }
+    out.type = static_cast<RecordType>(type);
+    return true;
+}
@@ -0,0 +1,85 @@
+#ifndef LOOKAHEAD_RECORDER_H
+#define LOOKAHEAD_RECORDER_H
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace godot {
+
+/**
+ * LookaheadRecorder - Binary trace of MultiBiomeLookaheadEngine inputs
+ *
+ * Captures everything the native kernels consume, in call order: biome
+ * registration (operators as raw doubles), in-place operator patches,
+ * metadata, clears and the exact per-biome rho each lookahead started from,
+ * so a production session can be replayed headlessly against different
+ * engine settings or kernels.
+ *
+ * File: zstd-compressed FileAccess stream, "SWLR" + u32 version, then one
+ * record per call: u8 type followed by its fields. Double arrays are a u32
+ * count and raw little-endian doubles.
+ */
+class LookaheadRecorder {
+public:
+    enum RecordType : uint8_t {
+        RECORD_END = 0,       // Reader only: end of stream or corrupt record
+        RECORD_REGISTER = 1,  // i32 dim, H, u32 n + n triplet arrays, i32 num_qubits, i32 num_trajectories, var metadata
+        RECORD_METADATA = 2,  // i32 biome_id, var metadata
+        RECORD_CLEAR = 3,
+        RECORD_LOOKAHEAD = 4,  // i32 steps, f64 dt, f64 max_dt, u8 packed, u32 n + n rho arrays
+        RECORD_UPDATE_HAMILTONIAN = 5,  // i32 biome_id, triplets (in Record::hamiltonian)
+        RECORD_REPLACE_LINDBLAD = 6,    // i32 biome_id, i32 index, triplets (in Record::hamiltonian)
+    };
+
+    struct Record {
+        RecordType type = RECORD_END;
+        int dim = 0;
+        int num_qubits = 0;
+        int num_trajectories = 0;
+        int biome_id = 0;
+        int index = 0;
+        int steps = 0;
+        double dt = 0.0;
+        double max_dt = 0.0;
+        bool packed = false;
+        PackedFloat64Array hamiltonian;
+        Array triplets;
+        Dictionary metadata;
+        std::vector<PackedFloat64Array> rhos;
+    };
+
+    // Writing
+    bool open_write(const String& path);  // Truncates; false (with a warning) if it can't open
+    void close();
+    bool is_open() const { return m_file.is_valid(); }
+
+    void write_register(int dim, const PackedFloat64Array& H_packed, const Array& lindblad_triplets,
+                        int num_qubits, int num_trajectories, const Dictionary& metadata);
+    void write_metadata(int biome_id, const Dictionary& metadata);
+    void write_clear();
+    void write_update_hamiltonian(int biome_id, const PackedFloat64Array& triplets);
+    void write_replace_lindblad(int biome_id, int k, const PackedFloat64Array& triplets);
+    void write_lookahead(const std::vector<PackedFloat64Array>& rhos, int num_biomes, int steps,
+                         double dt, double max_dt, bool packed);
+
+    // Reading (a separate instance from the writer)
+    bool open_read(const String& path);  // Checks magic and version
+    bool next(Record& out);              // False at end of stream / on a bad record
+
+private:
+    static constexpr uint32_t MAGIC = 0x524C5753;  // "SWLR"
+    static constexpr uint32_t VERSION = 1;
+
+    void write_doubles(const PackedFloat64Array& data);
+    bool read_doubles(PackedFloat64Array& out);
+
+    Ref<FileAccess> m_file;
+};
+
+}  // namespace godot
+
+#endif  // LOOKAHEAD_RECORDER_H
@@ -0,0 +1,51 @@
+#ifndef MEMORY_BYTES_H
+#define MEMORY_BYTES_H
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+
+/**
+ * memory_bytes - Heap bytes held by the containers the engines use
+ *
+ * Capacity, not size, wherever the container keeps spare room (std::vector,
+ * sparse storage), since that is what the allocator actually handed out.
+ * Used by the get_memory_stats() breakdowns; fixed-size members and
+ * allocator overhead are not counted.
+ */
+namespace memory_bytes {
+
+template <typename Derived>
+int64_t dense(const Eigen::PlainObjectBase<Derived>& m) {
+    return static_cast<int64_t>(m.size()) * static_cast<int64_t>(sizeof(typename Derived::Scalar));
+}
+
+template <typename Scalar, int Options, typename Index>
+int64_t sparse(const Eigen::SparseMatrix<Scalar, Options, Index>& m) {
+    int64_t bytes = static_cast<int64_t>(m.data().allocatedSize()) * static_cast<int64_t>(sizeof(Scalar) + sizeof(Index));
+    if (m.outerSize() > 0) {
+        bytes += static_cast<int64_t>(m.outerSize() + 1) * static_cast<int64_t>(sizeof(Index));
+    }
+    if (!m.isCompressed()) {
+        bytes += static_cast<int64_t>(m.outerSize()) * static_cast<int64_t>(sizeof(Index));
+    }
+    return bytes;
+}
+
+template <typename T, typename Alloc>
+int64_t vector(const std::vector<T, Alloc>& v) {
+    return static_cast<int64_t>(v.capacity()) * static_cast<int64_t>(sizeof(T));
+}
+
+inline int64_t vector(const std::vector<bool>& v) {
+    return static_cast<int64_t>((v.capacity() + 7) / 8);
+}
+
+}  // namespace memory_bytes
+
+}  // namespace godot
+
+#endif  // MEMORY_BYTES_H
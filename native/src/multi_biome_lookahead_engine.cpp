@@ -1,56 +1,918 @@
 #include "multi_biome_lookahead_engine.h"
+#include "emoji_registry.h"
+#include "native_thread_pool.h"
+#include "native_counters.h"
+#include "memory_bytes.h"
+#include "simd_dispatch.h"
+#include "trace_zones.h"
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <algorithm>
 #include <numeric>
-#include <thread>  // For pacing (sleep between steps)
+#include <random>
+#include <unordered_set>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 
 using namespace godot;
 
+namespace {
+
+// EMA weight of a new per-step cost sample (sliced compute, ring refill)
+constexpr double STEP_COST_SMOOTHING = 0.25;
+// EMA weight of one advance() in the invalidation-rate estimate (events are rare)
+constexpr double INVALIDATION_SMOOTHING = 0.05;
+// Frame-budget governor: EMA weight of a call's time, fraction of the budget
+// below which a level is recovered, calls between level changes, and the
+// force substep divisor at GOVERNOR_COARSE_FORCE
+constexpr double GOVERNOR_SMOOTHING = 0.25;
+constexpr double GOVERNOR_HEADROOM = 0.6;
+constexpr int GOVERNOR_HOLD_CALLS = 8;
+constexpr int GOVERNOR_SUBSTEP_DIVISOR = 4;
+// Rows of ρ swept per deadline check in a sliced observable pass
+constexpr int SLICED_OBSERVABLE_ROWS = 32;
+
+// register_biomes_bulk blob layout (see the header)
+constexpr uint32_t BULK_MAGIC = 0x42425753;  // "SWBB" read little-endian
+constexpr uint32_t BULK_VERSION = 1;
+constexpr int64_t BULK_ENTRY_BYTES = 24;     // u32 row, u32 col, f64 re, f64 im
+
+// save_snapshot / load_snapshot blob (see the header)
+constexpr uint32_t SNAPSHOT_MAGIC = 0x53455753;  // "SWES" read little-endian
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+// ρ ← Σ_k K_k ρ K_k† with single-qubit Kraus operators on basis bit `bit`
+void apply_qubit_channel(Eigen::Ref<QuantumEvolutionEngine::RhoMatrix> rho, int bit, const Eigen::Matrix2cd* kraus,
+                         int count, QuantumEvolutionEngine::RhoMatrix& work,
+                         QuantumEvolutionEngine::RhoMatrix& branch, QuantumEvolutionEngine::RhoMatrix& acc) {
+    lindblad::LocalOperator op;
+    op.size = 2;
+    op.mask = 1 << bit;
+    op.offsets[1] = 1 << bit;
+    if (count == 1) {
+        op.op.topLeftCorner<2, 2>() = kraus[0];
+        QuantumEvolutionEngine::apply_local_gate(op, rho, work);
+        return;
+    }
+    acc.setZero(rho.rows(), rho.cols());
+    for (int k = 0; k < count; k++) {
+        op.op.topLeftCorner<2, 2>() = kraus[k];
+        branch = rho;
+        QuantumEvolutionEngine::apply_local_gate(op, branch, work);
+        acc += branch;
+    }
+    rho = acc;
+}
+
+// Qubit count limit of register_synthetic_biomes (dense dim 1024)
+constexpr int SYNTHETIC_MAX_QUBITS = 10;
+
+struct SyntheticEntry {
+    uint32_t row;
+    uint32_t col;
+    std::complex<double> value;
+};
+
+// One register_biomes_bulk biome record (see register_synthetic_biomes)
+void write_synthetic_biome(EngineStateWriter& out, int num_qubits, int lindblad_count, double density,
+                           std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const uint32_t dim = 1u << num_qubits;
+
+    std::vector<SyntheticEntry> h;
+    for (uint32_t i = 0; i < dim; i++) {
+        h.push_back({i, i, {2.0 * unit(rng) - 1.0, 0.0}});
+        for (uint32_t j = i + 1; j < dim; j++) {
+            if (unit(rng) < density) {
+                const std::complex<double> v(unit(rng) - 0.5, unit(rng) - 0.5);
+                h.push_back({i, j, v});
+                h.push_back({j, i, std::conj(v)});
+            }
+        }
+    }
+
+    // Decay σ⁻ on even k, dephasing σz on odd k, each on a random qubit
+    std::vector<std::vector<SyntheticEntry>> lindblads(lindblad_count);
+    for (int k = 0; k < lindblad_count; k++) {
+        const uint32_t bit = 1u << static_cast<int>(unit(rng) * num_qubits);
+        const double amplitude = std::sqrt(0.005 + 0.045 * unit(rng));  // γ in [0.005, 0.05]
+        for (uint32_t i = 0; i < dim; i++) {
+            if (k % 2 == 0) {
+                if (i & bit) {
+                    lindblads[k].push_back({i ^ bit, i, {amplitude, 0.0}});
+                }
+            } else {
+                lindblads[k].push_back({i, i, {(i & bit) ? -amplitude : amplitude, 0.0}});
+            }
+        }
+    }
+
+    out.write_u32(dim);
+    out.write_u32(static_cast<uint32_t>(num_qubits));
+    out.write_u32(0);  // Dense engine
+    out.write_u32(static_cast<uint32_t>(h.size()));
+    out.write_u32(static_cast<uint32_t>(lindblad_count));
+    for (const auto& lindblad : lindblads) {
+        out.write_u32(static_cast<uint32_t>(lindblad.size()));
+    }
+    auto write_entries = [&out](const std::vector<SyntheticEntry>& entries) {
+        for (const SyntheticEntry& e : entries) {
+            out.write_u32(e.row);
+            out.write_u32(e.col);
+            out.write_f64(e.value.real());
+            out.write_f64(e.value.imag());
+        }
+    };
+    write_entries(h);
+    for (const auto& lindblad : lindblads) {
+        write_entries(lindblad);
+    }
+}
+
+// ρ = p|ψ⟩⟨ψ| + (1 - p)·I/dim for a random |ψ⟩, with p chosen so
+// Tr(ρ²) = p² (1 - 1/dim) + 1/dim hits the requested purity
+PackedFloat64Array synthetic_rho(int dim, double purity, std::mt19937_64& rng) {
+    std::normal_distribution<double> normal(0.0, 1.0);
+    Eigen::VectorXcd psi(dim);
+    for (int i = 0; i < dim; i++) {
+        psi(i) = std::complex<double>(normal(rng), normal(rng));
+    }
+    psi.normalize();
+    const double floor = 1.0 / dim;
+    const double p = dim > 1 ? std::sqrt((std::clamp(purity, floor, 1.0) - floor) / (1.0 - floor)) : 1.0;
+
+    PackedFloat64Array rho;
+    rho.resize(static_cast<int64_t>(dim) * dim * 2);
+    double* out = rho.ptrw();
+    for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+            std::complex<double> v = p * psi(i) * std::conj(psi(j));
+            if (i == j) {
+                v += (1.0 - p) * floor;
+            }
+            out[(static_cast<int64_t>(i) * dim + j) * 2] = v.real();
+            out[(static_cast<int64_t>(i) * dim + j) * 2 + 1] = v.imag();
+        }
+    }
+    return rho;
+}
+
+double ms_between(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// One lookahead call's telemetry record, appended when the call returns (on
+// whichever path); inert while no telemetry ring is open
+class TelemetryFrame {
+public:
+    TelemetryFrame(TelemetryRing& ring, std::chrono::steady_clock::time_point start)
+        : m_ring(ring.is_open() ? &ring : nullptr), m_start(start) {
+        if (m_ring != nullptr) {
+            record.timestamp_ns = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count());
+        }
+    }
+    ~TelemetryFrame() {
+        if (m_ring != nullptr) {
+            record.total_ms = ms_between(m_start, std::chrono::steady_clock::now());
+            record.marshal_ms = record.evolve_ms > 0.0 ? record.total_ms - record.evolve_ms : 0.0;
+            m_ring->write(record);
+        }
+    }
+    bool active() const { return m_ring != nullptr; }
+
+    FrameTelemetry record;
+
+private:
+    TelemetryFrame(const TelemetryFrame&) = delete;
+    TelemetryFrame& operator=(const TelemetryFrame&) = delete;
+
+    TelemetryRing* m_ring;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+void write_variant(EngineStateWriter& out, const Variant& value) {
+    const PackedByteArray bytes = UtilityFunctions::var_to_bytes(value);
+    out.write_bytes(bytes.ptr(), static_cast<uint32_t>(bytes.size()));
+}
+
+// Dictionary written by write_variant (empty on a truncated blob or another type)
+Dictionary read_dictionary(EngineStateReader& in) {
+    uint32_t size = 0;
+    if (!in.read_u32(size)) {
+        return Dictionary();
+    }
+    const uint8_t* data = in.read_span(size);
+    if (data == nullptr || size == 0) {
+        return Dictionary();
+    }
+    PackedByteArray bytes;
+    bytes.resize(size);
+    std::memcpy(bytes.ptrw(), data, size);
+    const Variant value = UtilityFunctions::bytes_to_var(bytes);
+    return value.get_type() == Variant::DICTIONARY ? Dictionary(value) : Dictionary();
+}
+
+void write_vectors(EngineStateWriter& out, const PackedVector2Array& vectors) {
+    out.write_u32(static_cast<uint32_t>(vectors.size()));
+    for (int64_t i = 0; i < vectors.size(); i++) {
+        out.write_f64(vectors[i].x);
+        out.write_f64(vectors[i].y);
+    }
+}
+
+bool read_vectors(EngineStateReader& in, PackedVector2Array& out) {
+    uint32_t count = 0;
+    if (!in.read_u32(count) || !in.has(static_cast<int64_t>(count) * 16)) {
+        in.fail();
+        return false;
+    }
+    std::vector<double> xy(static_cast<size_t>(count) * 2);
+    if (!in.read_raw(xy.data(), static_cast<int64_t>(xy.size()) * 8)) {
+        return false;
+    }
+    out.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = Vector2(static_cast<real_t>(xy[i * 2]), static_cast<real_t>(xy[i * 2 + 1]));
+    }
+    return true;
+}
+
+// set_operator_cache_dir entries: header, then QuantumEvolutionEngine::write_state
+constexpr uint32_t OPERATOR_CACHE_MAGIC = 0x434F5753;  // "SWOC" read little-endian
+constexpr uint32_t OPERATOR_CACHE_VERSION = 1;
+
+// 64-bit multiply-xorshift over 8-byte words (FNV-1a on the tail): fast
+// enough to key a dense dim² Hamiltonian well below the cost of building it
+uint64_t hash_words(uint64_t h, const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, p + i, 8);
+        h = (h ^ word) * 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 29;
+    }
+    for (; i < size; i++) {
+        h = (h ^ p[i]) * 1099511628211ULL;
+    }
+    return h;
+}
+
+uint64_t operator_cache_key(int dim, const PackedFloat64Array& H_packed, const Array& lindblad_triplets,
+                            bool trajectories) {
+    const int64_t shape[4] = {OPERATOR_CACHE_VERSION, dim, trajectories ? 1 : 0, lindblad_triplets.size()};
+    uint64_t h = hash_words(14695981039346656037ULL, shape, sizeof(shape));
+    const int64_t h_size = H_packed.size();
+    h = hash_words(h, &h_size, sizeof(h_size));
+    h = hash_words(h, H_packed.ptr(), static_cast<size_t>(h_size) * sizeof(double));
+    for (int64_t k = 0; k < lindblad_triplets.size(); k++) {
+        const PackedFloat64Array triplets = lindblad_triplets[k];
+        const int64_t size = triplets.size();
+        h = hash_words(h, &size, sizeof(size));
+        h = hash_words(h, triplets.ptr(), static_cast<size_t>(size) * sizeof(double));
+    }
+    return h;
+}
+
+// Engine restored from a cache entry; null on a missing, stale or foreign file
+Ref<QuantumEvolutionEngine> read_cached_engine(const String& path, int dim) {
+    if (!FileAccess::file_exists(path)) {
+        return Ref<QuantumEvolutionEngine>();
+    }
+    Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ);
+    if (file.is_null()) {
+        return Ref<QuantumEvolutionEngine>();
+    }
+    std::vector<uint8_t> bytes(static_cast<size_t>(file->get_length()));
+    const uint64_t read = file->get_buffer(bytes.data(), bytes.size());
+    file->close();
+
+    EngineStateReader in(bytes.data(), static_cast<int64_t>(read));
+    uint32_t magic = 0, version = 0;
+    in.read_u32(magic);
+    in.read_u32(version);
+    Ref<QuantumEvolutionEngine> engine;
+    engine.instantiate();
+    if (!in.ok() || magic != OPERATOR_CACHE_MAGIC || version != OPERATOR_CACHE_VERSION ||
+        !engine->read_state(in) || !in.at_end() || engine->get_dimension() != dim) {
+        return Ref<QuantumEvolutionEngine>();
+    }
+    return engine;
+}
+
+// Write a cache entry through a temporary file so readers never see a partial one
+bool write_cached_engine(const String& path, const QuantumEvolutionEngine& engine) {
+    static std::atomic<uint32_t> temp_counter{0};
+    EngineStateWriter out;
+    out.write_u32(OPERATOR_CACHE_MAGIC);
+    out.write_u32(OPERATOR_CACHE_VERSION);
+    engine.write_state(out);
+
+    const String temp_path = path + String(".tmp") + String::num_int64(temp_counter.fetch_add(1));
+    Ref<FileAccess> file = FileAccess::open(temp_path, FileAccess::WRITE);
+    if (file.is_null()) {
+        return false;
+    }
+    file->store_buffer(out.bytes().data(), out.bytes().size());
+    file->close();
+    if (DirAccess::rename_absolute(temp_path, path) != OK) {
+        DirAccess::remove_absolute(temp_path);
+        return false;
+    }
+    return true;
+}
+
+// Bounds-checked little-endian reads over a byte blob
+struct BlobReader {
+    const uint8_t* data;
+    int64_t size;
+    int64_t pos = 0;
+
+    bool has(int64_t bytes) const { return bytes >= 0 && pos + bytes <= size; }
+    bool read_u32(uint32_t& out) {
+        if (!has(4)) {
+            return false;
+        }
+        std::memcpy(&out, data + pos, 4);
+        pos += 4;
+        return true;
+    }
+};
+
+// One biome's place in the blob after the structural pass
+struct BulkBiome {
+    int64_t h_offset = 0;
+    uint32_t h_count = 0;
+    std::vector<std::pair<int64_t, uint32_t>> lindblads;  // (offset, entries)
+};
+
+// Decode count entries at offset; false on an index outside [0, dim)
+bool read_bulk_entries(const uint8_t* data, int64_t offset, uint32_t count, int dim,
+                       int* rows, int* cols, std::complex<double>* values) {
+    for (uint32_t k = 0; k < count; k++) {
+        const uint8_t* entry = data + offset + k * BULK_ENTRY_BYTES;
+        uint32_t row, col;
+        double re, im;
+        std::memcpy(&row, entry, 4);
+        std::memcpy(&col, entry + 4, 4);
+        std::memcpy(&re, entry + 8, 8);
+        std::memcpy(&im, entry + 16, 8);
+        if (row >= static_cast<uint32_t>(dim) || col >= static_cast<uint32_t>(dim)) {
+            return false;
+        }
+        rows[k] = static_cast<int>(row);
+        cols[k] = static_cast<int>(col);
+        values[k] = std::complex<double>(re, im);
+    }
+    return true;
+}
+
+// OUTPUT_PRECISION_FLOAT: narrow a visual-only field to the GPU upload format
+PackedFloat32Array to_float32(const PackedFloat64Array& values) {
+    PackedFloat32Array narrow;
+    narrow.resize(values.size());
+    const double* src = values.ptr();
+    float* dst = narrow.ptrw();
+    for (int64_t i = 0; i < values.size(); i++) {
+        dst[i] = static_cast<float>(src[i]);
+    }
+    return narrow;
+}
+
+// QuantumEvolutionEngine mask for one lookahead step under a
+// LookaheadObservables selection (positions and icon maps read Bloch)
+int step_observable_mask(int observables, bool mi_now) {
+    const bool bloch = observables & (MultiBiomeLookaheadEngine::LOOKAHEAD_BLOCH |
+                                      MultiBiomeLookaheadEngine::LOOKAHEAD_POSITIONS |
+                                      MultiBiomeLookaheadEngine::LOOKAHEAD_ICON_MAP);
+    return (bloch ? QuantumEvolutionEngine::OBSERVABLE_BLOCH : 0) |
+           ((observables & MultiBiomeLookaheadEngine::LOOKAHEAD_PURITY) ? QuantumEvolutionEngine::OBSERVABLE_PURITY
+                                                                        : 0) |
+           (mi_now ? QuantumEvolutionEngine::OBSERVABLE_MI : 0);
+}
+
+// Section spans of a compute_observables_into buffer: [bloch][purity][mi]
+struct ObservableSpans {
+    int64_t bloch_len = 0;   // 0 when Bloch is not in the mask
+    int64_t purity_at = -1;  // -1 when purity is not in the mask
+    int64_t mi_at = 0;
+};
+ObservableSpans observable_spans(int num_qubits, int mask) {
+    ObservableSpans spans;
+    if ((mask & QuantumEvolutionEngine::OBSERVABLE_BLOCH) && num_qubits > 0) {
+        spans.bloch_len = static_cast<int64_t>(num_qubits) * 8;
+    }
+    spans.mi_at = spans.bloch_len;
+    if (mask & QuantumEvolutionEngine::OBSERVABLE_PURITY) {
+        spans.purity_at = spans.mi_at++;
+    }
+    return spans;
+}
+
+// count draws of a basis state with probability ρ_ii (Walker / Vose alias
+// table); per_qubit writes each draw as num_qubits bits, qubit 0 first.
+// out stays empty if rho is not dim×dim or has no positive population
+void sample_populations(const PackedFloat64Array& rho, int dim, int num_qubits, int count, uint64_t seed,
+                        bool per_qubit, PackedInt32Array& out) {
+    if (dim <= 0 || rho.size() != static_cast<int64_t>(dim) * dim * 2) {
+        return;
+    }
+    const double* data = rho.ptr();
+    std::vector<double> accept(dim);
+    double total = 0.0;
+    for (int i = 0; i < dim; i++) {
+        accept[i] = std::max(data[2 * (static_cast<int64_t>(i) * dim + i)], 0.0);
+        total += accept[i];
+    }
+    if (!(total > 0.0)) {
+        return;
+    }
+
+    // Scale to mean 1, then top up each under-full column from an over-full one
+    std::vector<int> alias(dim);
+    std::vector<int> small;
+    std::vector<int> large;
+    for (int i = 0; i < dim; i++) {
+        accept[i] *= dim / total;
+        alias[i] = i;
+        (accept[i] < 1.0 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+        const int s = small.back();
+        const int l = large.back();
+        small.pop_back();
+        alias[s] = l;
+        accept[l] -= 1.0 - accept[s];
+        if (accept[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // Leftovers are 1 up to rounding
+    for (int i : small) {
+        accept[i] = 1.0;
+    }
+    for (int i : large) {
+        accept[i] = 1.0;
+    }
+
+    // One 64-bit draw per roll: the high half picks the column, the low
+    // half is the uniform tested against its acceptance
+    std::mt19937_64 rng(seed);
+    const int width = per_qubit ? num_qubits : 1;
+    out.resize(static_cast<int64_t>(count) * width);
+    int32_t* dst = out.ptrw();
+    for (int n = 0; n < count; n++) {
+        const uint64_t r = rng();
+        const int column = static_cast<int>(((r >> 32) * static_cast<uint64_t>(dim)) >> 32);
+        const double u = static_cast<double>(r & 0xffffffffu) * (1.0 / 4294967296.0);
+        const int outcome = u < accept[column] ? column : alias[column];
+        if (!per_qubit) {
+            dst[n] = outcome;
+            continue;
+        }
+        for (int q = 0; q < num_qubits; q++) {
+            dst[static_cast<int64_t>(n) * num_qubits + q] = (outcome >> (num_qubits - 1 - q)) & 1;
+        }
+    }
+}
+
+// RHO_STORAGE_DELTA quantization of rho against decoded: int16 multiples of
+// the returned scale, little-endian on every host. decoded is advanced to
+// what apply_rho_delta rebuilds, so a chain of deltas never drifts.
+double encode_rho_delta(const double* rho, double* decoded, int64_t size, PackedByteArray& bytes) {
+    double max_delta = 0.0;
+    for (int64_t i = 0; i < size; i++) {
+        max_delta = std::max(max_delta, std::abs(rho[i] - decoded[i]));
+    }
+    const double scale = max_delta / 32767.0;
+    bytes.resize(size * 2);
+    uint8_t* out = bytes.ptrw();
+    for (int64_t i = 0; i < size; i++) {
+        const int16_t q = scale > 0.0
+                              ? static_cast<int16_t>(std::max(-32767.0, std::min(32767.0,
+                                                                                 std::round((rho[i] - decoded[i]) / scale))))
+                              : 0;
+        decoded[i] += q * scale;
+        out[2 * i] = static_cast<uint8_t>(q & 0xff);
+        out[2 * i + 1] = static_cast<uint8_t>((static_cast<uint16_t>(q) >> 8) & 0xff);
+    }
+    return scale;
+}
+
+// decoded += an encode_rho_delta result
+void apply_rho_delta(const uint8_t* delta, double scale, double* decoded, int64_t size) {
+    for (int64_t i = 0; i < size; i++) {
+        const int16_t q = static_cast<int16_t>(static_cast<uint16_t>(delta[2 * i]) |
+                                               (static_cast<uint16_t>(delta[2 * i + 1]) << 8));
+        decoded[i] += q * scale;
+    }
+}
+
+}  // namespace
+
 void MultiBiomeLookaheadEngine::_bind_methods() {
-    ClassDB::bind_method(D_METHOD("register_biome", "dim", "H_packed", "lindblad_triplets", "num_qubits"),
-                         &MultiBiomeLookaheadEngine::register_biome);
-    ClassDB::bind_method(D_METHOD("set_biome_metadata", "biome_id", "metadata"),
-                         &MultiBiomeLookaheadEngine::set_biome_metadata);
-    ClassDB::bind_method(D_METHOD("set_biome_couplings", "biome_id", "couplings"),
-                         &MultiBiomeLookaheadEngine::set_biome_couplings);
-    ClassDB::bind_method(D_METHOD("clear_biomes"),
-                         &MultiBiomeLookaheadEngine::clear_biomes);
-    ClassDB::bind_method(D_METHOD("get_biome_count"),
-                         &MultiBiomeLookaheadEngine::get_biome_count);
+    BIND_TIMED_METHOD(D_METHOD("register_biome", "dim", "H_packed", "lindblad_triplets", "num_qubits", "num_trajectories", "metadata"),
+                      &MultiBiomeLookaheadEngine::register_biome, DEFVAL(0), DEFVAL(Dictionary()));
+    BIND_TIMED_METHOD(D_METHOD("register_biomes_bulk", "blob", "metadata"),
+                      &MultiBiomeLookaheadEngine::register_biomes_bulk, DEFVAL(Array()));
+    BIND_TIMED_METHOD(D_METHOD("register_synthetic_biomes", "count", "seed", "min_qubits", "max_qubits",
+                               "lindblad_count", "hamiltonian_density", "initial_purity"),
+                      &MultiBiomeLookaheadEngine::register_synthetic_biomes, DEFVAL(3), DEFVAL(6), DEFVAL(4),
+                      DEFVAL(0.2), DEFVAL(1.0));
+    BIND_TIMED_METHOD(D_METHOD("save_snapshot"), &MultiBiomeLookaheadEngine::save_snapshot);
+    BIND_TIMED_METHOD(D_METHOD("load_snapshot", "blob"), &MultiBiomeLookaheadEngine::load_snapshot);
+    BIND_TIMED_METHOD(D_METHOD("set_operator_cache_dir", "dir"),
+                      &MultiBiomeLookaheadEngine::set_operator_cache_dir);
+    BIND_TIMED_METHOD(D_METHOD("get_operator_cache_dir"),
+                      &MultiBiomeLookaheadEngine::get_operator_cache_dir);
+    BIND_TIMED_METHOD(D_METHOD("get_operator_cache_stats"),
+                      &MultiBiomeLookaheadEngine::get_operator_cache_stats);
+    BIND_TIMED_METHOD(D_METHOD("update_biome_hamiltonian", "biome_id", "triplets"),
+                      &MultiBiomeLookaheadEngine::update_biome_hamiltonian);
+    BIND_TIMED_METHOD(D_METHOD("replace_biome_lindblad", "biome_id", "k", "triplets"),
+                      &MultiBiomeLookaheadEngine::replace_biome_lindblad);
+    BIND_TIMED_METHOD(D_METHOD("is_trajectory_biome", "biome_id"),
+                      &MultiBiomeLookaheadEngine::is_trajectory_biome);
+    BIND_TIMED_METHOD(D_METHOD("set_biome_active", "biome_id", "active"),
+                      &MultiBiomeLookaheadEngine::set_biome_active);
+    BIND_TIMED_METHOD(D_METHOD("is_biome_active", "biome_id"),
+                      &MultiBiomeLookaheadEngine::is_biome_active);
+    BIND_TIMED_METHOD(D_METHOD("set_biome_metadata", "biome_id", "metadata"),
+                      &MultiBiomeLookaheadEngine::set_biome_metadata);
+    BIND_TIMED_METHOD(D_METHOD("acknowledge_payloads", "result"), &MultiBiomeLookaheadEngine::acknowledge_payloads);
+    BIND_TIMED_METHOD(D_METHOD("set_biome_couplings", "biome_id", "couplings"),
+                      &MultiBiomeLookaheadEngine::set_biome_couplings);
+    BIND_TIMED_METHOD(D_METHOD("clear_biomes"),
+                      &MultiBiomeLookaheadEngine::clear_biomes);
+    BIND_TIMED_METHOD(D_METHOD("get_pending_preparations"),
+                      &MultiBiomeLookaheadEngine::get_pending_preparations);
+    BIND_TIMED_METHOD(D_METHOD("get_biome_count"),
+                      &MultiBiomeLookaheadEngine::get_biome_count);
 
     // LNN methods
-    ClassDB::bind_method(D_METHOD("enable_biome_lnn", "biome_id", "hidden_size"),
-                         &MultiBiomeLookaheadEngine::enable_biome_lnn);
-    ClassDB::bind_method(D_METHOD("disable_biome_lnn", "biome_id"),
-                         &MultiBiomeLookaheadEngine::disable_biome_lnn);
-    ClassDB::bind_method(D_METHOD("is_lnn_enabled", "biome_id"),
-                         &MultiBiomeLookaheadEngine::is_lnn_enabled);
-
-    ClassDB::bind_method(D_METHOD("evolve_all_lookahead", "biome_rhos", "steps", "dt", "max_dt"),
-                         &MultiBiomeLookaheadEngine::evolve_all_lookahead);
-    ClassDB::bind_method(D_METHOD("evolve_single_biome", "biome_id", "rho_packed", "steps", "dt", "max_dt"),
-                         &MultiBiomeLookaheadEngine::evolve_single_biome);
+    BIND_TIMED_METHOD(D_METHOD("enable_biome_lnn", "biome_id", "hidden_size", "weights_path"),
+                      &MultiBiomeLookaheadEngine::enable_biome_lnn, DEFVAL(String()));
+    BIND_TIMED_METHOD(D_METHOD("enable_shared_lnn", "biome_ids", "hidden_size"),
+                      &MultiBiomeLookaheadEngine::enable_shared_lnn);
+    BIND_TIMED_METHOD(D_METHOD("disable_biome_lnn", "biome_id"),
+                      &MultiBiomeLookaheadEngine::disable_biome_lnn);
+    BIND_TIMED_METHOD(D_METHOD("is_lnn_enabled", "biome_id"),
+                      &MultiBiomeLookaheadEngine::is_lnn_enabled);
+    BIND_TIMED_METHOD(D_METHOD("set_biome_lnn_stride", "biome_id", "stride"),
+                      &MultiBiomeLookaheadEngine::set_biome_lnn_stride);
+    BIND_TIMED_METHOD(D_METHOD("get_biome_lnn_stride", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_biome_lnn_stride);
+    BIND_TIMED_METHOD(D_METHOD("save_biome_lnn", "biome_id", "path"),
+                      &MultiBiomeLookaheadEngine::save_biome_lnn);
+    BIND_TIMED_METHOD(D_METHOD("load_biome_lnn", "biome_id", "path"),
+                      &MultiBiomeLookaheadEngine::load_biome_lnn);
+    BIND_TIMED_METHOD(D_METHOD("set_lnn_recording", "biome_id", "window"),
+                      &MultiBiomeLookaheadEngine::set_lnn_recording);
+    BIND_TIMED_METHOD(D_METHOD("train_lnn_async", "biome_id", "truncation", "epochs"),
+                      &MultiBiomeLookaheadEngine::train_lnn_async, DEFVAL(16), DEFVAL(1));
+    BIND_TIMED_METHOD(D_METHOD("is_lnn_training", "biome_id"),
+                      &MultiBiomeLookaheadEngine::is_lnn_training);
+    BIND_TIMED_METHOD(D_METHOD("get_lnn_training_loss", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_lnn_training_loss);
+    BIND_TIMED_METHOD(D_METHOD("set_biome_precision", "biome_id", "single_precision", "resync_interval"),
+                      &MultiBiomeLookaheadEngine::set_biome_precision, DEFVAL(8));
+    BIND_TIMED_METHOD(D_METHOD("is_biome_single_precision", "biome_id"),
+                      &MultiBiomeLookaheadEngine::is_biome_single_precision);
+    BIND_TIMED_METHOD(D_METHOD("set_drift_thresholds", "trace_error", "hermiticity_error", "negative_mass"),
+                      &MultiBiomeLookaheadEngine::set_drift_thresholds);
+    BIND_TIMED_METHOD(D_METHOD("get_biome_drift_stats", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_biome_drift_stats);
+    BIND_TIMED_METHOD(D_METHOD("set_mi_audit_interval", "calls"),
+                      &MultiBiomeLookaheadEngine::set_mi_audit_interval);
+    BIND_TIMED_METHOD(D_METHOD("get_mi_audit_interval"), &MultiBiomeLookaheadEngine::get_mi_audit_interval);
+    BIND_TIMED_METHOD(D_METHOD("get_biome_mi_screen_stats", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_biome_mi_screen_stats);
+    BIND_TIMED_METHOD(D_METHOD("set_biome_observable_tolerance", "biome_id", "tolerance"),
+                      &MultiBiomeLookaheadEngine::set_biome_observable_tolerance);
+
+    BIND_TIMED_METHOD(D_METHOD("evolve_all_lookahead", "biome_rhos", "steps", "dt", "max_dt", "observables"),
+                      &MultiBiomeLookaheadEngine::evolve_all_lookahead, DEFVAL(LOOKAHEAD_ALL));
+    BIND_TIMED_METHOD(
+        D_METHOD("evolve_all_lookahead_packed", "biome_rhos", "steps", "dt", "max_dt", "observables"),
+        &MultiBiomeLookaheadEngine::evolve_all_lookahead_packed, DEFVAL(LOOKAHEAD_ALL));
+    BIND_TIMED_METHOD(D_METHOD("evolve_all_lookahead_binary", "biome_rhos", "steps", "dt", "max_dt"),
+                      &MultiBiomeLookaheadEngine::evolve_all_lookahead_binary);
+    BIND_TIMED_METHOD(D_METHOD("release_result", "result"), &MultiBiomeLookaheadEngine::release_result);
+    BIND_TIMED_METHOD(D_METHOD("add_watch", "biome_id", "observable", "index", "comparator", "threshold"),
+                      &MultiBiomeLookaheadEngine::add_watch);
+    BIND_TIMED_METHOD(D_METHOD("remove_watch", "watch_id"), &MultiBiomeLookaheadEngine::remove_watch);
+    BIND_TIMED_METHOD(D_METHOD("clear_watches"), &MultiBiomeLookaheadEngine::clear_watches);
+    BIND_TIMED_METHOD(D_METHOD("get_watch_count"), &MultiBiomeLookaheadEngine::get_watch_count);
+    BIND_TIMED_METHOD(D_METHOD("add_predicate", "expression", "biome_id"), &MultiBiomeLookaheadEngine::add_predicate,
+                      DEFVAL(-1));
+    BIND_TIMED_METHOD(D_METHOD("remove_predicate", "predicate_id"), &MultiBiomeLookaheadEngine::remove_predicate);
+    BIND_TIMED_METHOD(D_METHOD("clear_predicates"), &MultiBiomeLookaheadEngine::clear_predicates);
+    BIND_TIMED_METHOD(D_METHOD("get_predicate_count"), &MultiBiomeLookaheadEngine::get_predicate_count);
+    BIND_TIMED_METHOD(D_METHOD("get_predicate_results"), &MultiBiomeLookaheadEngine::get_predicate_results);
+    ADD_SIGNAL(MethodInfo("watch_triggered", PropertyInfo(Variant::INT, "watch_id"),
+                          PropertyInfo(Variant::INT, "biome_id"), PropertyInfo(Variant::INT, "step"),
+                          PropertyInfo(Variant::FLOAT, "value")));
+    BIND_TIMED_METHOD(D_METHOD("set_output_precision", "precision"),
+                      &MultiBiomeLookaheadEngine::set_output_precision);
+    BIND_TIMED_METHOD(D_METHOD("get_output_precision"), &MultiBiomeLookaheadEngine::get_output_precision);
+    BIND_TIMED_METHOD(D_METHOD("set_rho_storage", "policy"), &MultiBiomeLookaheadEngine::set_rho_storage);
+    BIND_TIMED_METHOD(D_METHOD("get_rho_storage"), &MultiBiomeLookaheadEngine::get_rho_storage);
+    BIND_TIMED_METHOD(D_METHOD("decode_rho_steps", "result", "biome_id"),
+                      &MultiBiomeLookaheadEngine::decode_rho_steps);
+    BIND_TIMED_METHOD(D_METHOD("add_biome_coupling", "source_biome", "source_qubit", "target_biome",
+                                  "target_qubit", "rate", "kind"),
+                      &MultiBiomeLookaheadEngine::add_biome_coupling, DEFVAL(COUPLING_POPULATION));
+    BIND_TIMED_METHOD(D_METHOD("clear_biome_couplings"), &MultiBiomeLookaheadEngine::clear_biome_couplings);
+    BIND_TIMED_METHOD(D_METHOD("get_biome_coupling_count"),
+                      &MultiBiomeLookaheadEngine::get_biome_coupling_count);
+    BIND_TIMED_METHOD(D_METHOD("evolve_coupled_lookahead", "biome_rhos", "steps", "dt", "max_dt"),
+                      &MultiBiomeLookaheadEngine::evolve_coupled_lookahead);
+    BIND_TIMED_METHOD(
+        D_METHOD("evolve_single_biome", "biome_id", "rho_packed", "steps", "dt", "max_dt", "observables"),
+        &MultiBiomeLookaheadEngine::evolve_single_biome, DEFVAL(LOOKAHEAD_ALL));
+    BIND_TIMED_METHOD(D_METHOD("evolve_branches", "biome_id", "base_rho", "actions", "steps", "dt", "max_dt",
+                                  "prefix_steps"),
+                      &MultiBiomeLookaheadEngine::evolve_branches, DEFVAL(0));
+
+    // Engine-resident state
+    BIND_TIMED_METHOD(D_METHOD("set_biome_rho", "biome_id", "rho_packed"),
+                      &MultiBiomeLookaheadEngine::set_biome_rho);
+    BIND_TIMED_METHOD(D_METHOD("get_biome_rho", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_biome_rho);
+    BIND_TIMED_METHOD(D_METHOD("get_biome_observables", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_biome_observables);
+    BIND_TIMED_METHOD(D_METHOD("apply_biome_operator", "biome_id", "op_packed"),
+                      &MultiBiomeLookaheadEngine::apply_biome_operator);
+    BIND_TIMED_METHOD(D_METHOD("sample_outcomes", "biome_id", "count", "seed", "per_qubit"),
+                      &MultiBiomeLookaheadEngine::sample_outcomes, DEFVAL(false));
+    BIND_TIMED_METHOD(D_METHOD("sample_outcomes_all", "counts", "seed", "per_qubit"),
+                      &MultiBiomeLookaheadEngine::sample_outcomes_all, DEFVAL(false));
+    BIND_TIMED_METHOD(D_METHOD("evolve_resident", "steps", "dt", "max_dt"),
+                      &MultiBiomeLookaheadEngine::evolve_resident);
+
+    // Ring-buffer lookahead
+    BIND_TIMED_METHOD(D_METHOD("seed_lookahead_buffer", "biome_rhos", "depth", "dt", "max_dt"),
+                      &MultiBiomeLookaheadEngine::seed_lookahead_buffer);
+    BIND_TIMED_METHOD(D_METHOD("reseed_biome_buffer", "biome_id", "rho_packed"),
+                      &MultiBiomeLookaheadEngine::reseed_biome_buffer);
+    BIND_TIMED_METHOD(D_METHOD("advance", "n"),
+                      &MultiBiomeLookaheadEngine::advance);
+    BIND_TIMED_METHOD(D_METHOD("refill"),
+                      &MultiBiomeLookaheadEngine::refill);
+    BIND_TIMED_METHOD(D_METHOD("invalidate_from", "biome_id", "step", "delta_op"),
+                      &MultiBiomeLookaheadEngine::invalidate_from);
+    BIND_TIMED_METHOD(D_METHOD("get_buffered_steps", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_buffered_steps);
+    BIND_TIMED_METHOD(D_METHOD("get_buffered_frame", "biome_id", "index"),
+                      &MultiBiomeLookaheadEngine::get_buffered_frame);
+    BIND_TIMED_METHOD(D_METHOD("set_adaptive_depth", "enabled"),
+                      &MultiBiomeLookaheadEngine::set_adaptive_depth);
+    BIND_TIMED_METHOD(D_METHOD("get_adaptive_depth"),
+                      &MultiBiomeLookaheadEngine::get_adaptive_depth);
+    BIND_TIMED_METHOD(D_METHOD("set_adaptive_depth_budget_ms", "budget_ms"),
+                      &MultiBiomeLookaheadEngine::set_adaptive_depth_budget_ms);
+    BIND_TIMED_METHOD(D_METHOD("get_adaptive_depth_budget_ms"),
+                      &MultiBiomeLookaheadEngine::get_adaptive_depth_budget_ms);
+    BIND_TIMED_METHOD(D_METHOD("set_adaptive_depth_range", "min_depth", "max_depth"),
+                      &MultiBiomeLookaheadEngine::set_adaptive_depth_range);
+    BIND_TIMED_METHOD(D_METHOD("get_biome_lookahead_depth", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_biome_lookahead_depth);
+    BIND_TIMED_METHOD(D_METHOD("get_biome_invalidation_rate", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_biome_invalidation_rate);
+    BIND_TIMED_METHOD(D_METHOD("get_bloch_at", "biome_id", "qubit", "t"), &MultiBiomeLookaheadEngine::get_bloch_at);
+    BIND_TIMED_METHOD(D_METHOD("get_emoji_prob_at", "biome_id", "emoji_id", "t"),
+                      &MultiBiomeLookaheadEngine::get_emoji_prob_at);
+    BIND_TIMED_METHOD(D_METHOD("get_positions_at", "biome_id", "t"), &MultiBiomeLookaheadEngine::get_positions_at);
+    BIND_TIMED_METHOD(D_METHOD("get_purity_at", "biome_id", "t"), &MultiBiomeLookaheadEngine::get_purity_at);
+
+    // State history
+    BIND_TIMED_METHOD(D_METHOD("set_history", "biome_id", "budget_bytes", "keyframe_interval", "observables_only"),
+                      &MultiBiomeLookaheadEngine::set_history, DEFVAL(16), DEFVAL(false));
+    BIND_TIMED_METHOD(D_METHOD("clear_history", "biome_id"), &MultiBiomeLookaheadEngine::clear_history);
+    BIND_TIMED_METHOD(D_METHOD("record_history", "biome_id", "elapsed"),
+                      &MultiBiomeLookaheadEngine::record_history);
+    BIND_TIMED_METHOD(D_METHOD("get_history_frame", "biome_id", "index"),
+                      &MultiBiomeLookaheadEngine::get_history_frame);
+    BIND_TIMED_METHOD(D_METHOD("get_history_times", "biome_id"), &MultiBiomeLookaheadEngine::get_history_times);
+    BIND_TIMED_METHOD(D_METHOD("get_history_stats", "biome_id"), &MultiBiomeLookaheadEngine::get_history_stats);
+    BIND_TIMED_METHOD(D_METHOD("sample_lookahead", "biome_id", "t"),
+                      &MultiBiomeLookaheadEngine::sample_lookahead);
+
+    // Snapshot channel (lock-free render-thread reads)
+    BIND_TIMED_METHOD(D_METHOD("set_snapshot_capacity", "frames"),
+                      &MultiBiomeLookaheadEngine::set_snapshot_capacity);
+    BIND_TIMED_METHOD(D_METHOD("get_snapshot_capacity"),
+                      &MultiBiomeLookaheadEngine::get_snapshot_capacity);
+    BIND_TIMED_METHOD(D_METHOD("get_snapshot_sequence"),
+                      &MultiBiomeLookaheadEngine::get_snapshot_sequence);
+    BIND_TIMED_METHOD(D_METHOD("read_snapshot", "sequence"),
+                      &MultiBiomeLookaheadEngine::read_snapshot, DEFVAL(-1));
+
+    // Profiling
+    BIND_TIMED_METHOD(D_METHOD("get_profile_stats"),
+                      &MultiBiomeLookaheadEngine::get_profile_stats);
+    BIND_TIMED_METHOD(D_METHOD("reset_profile_stats"),
+                      &MultiBiomeLookaheadEngine::reset_profile_stats);
+    BIND_TIMED_METHOD(D_METHOD("get_memory_stats"),
+                      &MultiBiomeLookaheadEngine::get_memory_stats);
+
+    // Recording / replay
+    BIND_TIMED_METHOD(D_METHOD("start_recording", "path"),
+                      &MultiBiomeLookaheadEngine::start_recording);
+    BIND_TIMED_METHOD(D_METHOD("stop_recording"),
+                      &MultiBiomeLookaheadEngine::stop_recording);
+    BIND_TIMED_METHOD(D_METHOD("is_recording"),
+                      &MultiBiomeLookaheadEngine::is_recording);
+    BIND_TIMED_METHOD(D_METHOD("replay_recording", "path"),
+                      &MultiBiomeLookaheadEngine::replay_recording);
+
+    // Telemetry
+    BIND_TIMED_METHOD(D_METHOD("start_telemetry", "path", "capacity_frames"),
+                      &MultiBiomeLookaheadEngine::start_telemetry, DEFVAL(4096));
+    BIND_TIMED_METHOD(D_METHOD("stop_telemetry"), &MultiBiomeLookaheadEngine::stop_telemetry);
+    BIND_TIMED_METHOD(D_METHOD("is_telemetry_active"), &MultiBiomeLookaheadEngine::is_telemetry_active);
+    BIND_TIMED_METHOD(D_METHOD("get_telemetry_frame_count"),
+                      &MultiBiomeLookaheadEngine::get_telemetry_frame_count);
 
     // Time-sliced computation methods
-    ClassDB::bind_method(D_METHOD("start_sliced_compute", "biome_rhos", "steps", "dt", "max_dt"),
-                         &MultiBiomeLookaheadEngine::start_sliced_compute);
-    ClassDB::bind_method(D_METHOD("continue_sliced_compute", "max_time_ms"),
-                         &MultiBiomeLookaheadEngine::continue_sliced_compute);
-    ClassDB::bind_method(D_METHOD("is_sliced_compute_complete"),
-                         &MultiBiomeLookaheadEngine::is_sliced_compute_complete);
-    ClassDB::bind_method(D_METHOD("get_sliced_compute_result"),
-                         &MultiBiomeLookaheadEngine::get_sliced_compute_result);
-    ClassDB::bind_method(D_METHOD("cancel_sliced_compute"),
-                         &MultiBiomeLookaheadEngine::cancel_sliced_compute);
-    ClassDB::bind_method(D_METHOD("get_sliced_compute_progress"),
-                         &MultiBiomeLookaheadEngine::get_sliced_compute_progress);
-
-    // Pacing methods (CPU-gentle mode)
-    ClassDB::bind_method(D_METHOD("set_pacing_delay_ms", "delay_ms"),
-                         &MultiBiomeLookaheadEngine::set_pacing_delay_ms);
-    ClassDB::bind_method(D_METHOD("get_pacing_delay_ms"),
-                         &MultiBiomeLookaheadEngine::get_pacing_delay_ms);
+    BIND_TIMED_METHOD(D_METHOD("start_sliced_compute", "biome_rhos", "steps", "dt", "max_dt", "observables"),
+                      &MultiBiomeLookaheadEngine::start_sliced_compute, DEFVAL(LOOKAHEAD_ALL));
+    BIND_TIMED_METHOD(D_METHOD("continue_sliced_compute", "max_time_ms"),
+                      &MultiBiomeLookaheadEngine::continue_sliced_compute);
+    BIND_TIMED_METHOD(D_METHOD("continue_sliced_compute_us", "budget_us"),
+                      &MultiBiomeLookaheadEngine::continue_sliced_compute_us);
+    BIND_TIMED_METHOD(D_METHOD("is_sliced_compute_complete"),
+                      &MultiBiomeLookaheadEngine::is_sliced_compute_complete);
+    BIND_TIMED_METHOD(D_METHOD("get_sliced_compute_result"),
+                      &MultiBiomeLookaheadEngine::get_sliced_compute_result);
+    BIND_TIMED_METHOD(D_METHOD("get_partial_result", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_partial_result);
+    BIND_TIMED_METHOD(D_METHOD("cancel_sliced_compute"),
+                      &MultiBiomeLookaheadEngine::cancel_sliced_compute);
+    BIND_TIMED_METHOD(D_METHOD("get_sliced_compute_progress"),
+                      &MultiBiomeLookaheadEngine::get_sliced_compute_progress);
+
+    // Scheduling methods (sliced compute budgets)
+    BIND_TIMED_METHOD(D_METHOD("set_biome_priority", "biome_id", "priority"),
+                      &MultiBiomeLookaheadEngine::set_biome_priority);
+    BIND_TIMED_METHOD(D_METHOD("get_biome_priority", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_biome_priority);
+    BIND_TIMED_METHOD(D_METHOD("set_biome_budget_ms", "biome_id", "budget_ms"),
+                      &MultiBiomeLookaheadEngine::set_biome_budget_ms);
+    BIND_TIMED_METHOD(D_METHOD("get_biome_budget_ms", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_biome_budget_ms);
+    BIND_TIMED_METHOD(D_METHOD("get_biome_step_cost_us", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_biome_step_cost_us);
+    BIND_TIMED_METHOD(D_METHOD("get_cost_estimates"), &MultiBiomeLookaheadEngine::get_cost_estimates);
+    BIND_TIMED_METHOD(D_METHOD("set_biome_lod", "biome_id", "lod"),
+                      &MultiBiomeLookaheadEngine::set_biome_lod);
+    BIND_TIMED_METHOD(D_METHOD("get_biome_lod", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_biome_lod);
+    BIND_TIMED_METHOD(D_METHOD("get_effective_biome_lod", "biome_id"),
+                      &MultiBiomeLookaheadEngine::get_effective_biome_lod);
+    BIND_TIMED_METHOD(D_METHOD("set_focus_biome", "biome_id", "background_lod"),
+                      &MultiBiomeLookaheadEngine::set_focus_biome, DEFVAL(LOD_REDUCED_MI));
+    BIND_TIMED_METHOD(D_METHOD("set_steady_state_detection", "tolerance", "window"),
+                      &MultiBiomeLookaheadEngine::set_steady_state_detection, DEFVAL(8));
+    BIND_TIMED_METHOD(D_METHOD("is_biome_stationary", "biome_id"),
+                      &MultiBiomeLookaheadEngine::is_biome_stationary);
+    BIND_TIMED_METHOD(D_METHOD("solve_biome_steady_state", "biome_id"),
+                      &MultiBiomeLookaheadEngine::solve_biome_steady_state);
+    BIND_TIMED_METHOD(D_METHOD("set_large_biome_qubits", "num_qubits"),
+                      &MultiBiomeLookaheadEngine::set_large_biome_qubits);
+    BIND_TIMED_METHOD(D_METHOD("get_large_biome_qubits"),
+                      &MultiBiomeLookaheadEngine::get_large_biome_qubits);
+    BIND_TIMED_METHOD(D_METHOD("is_large_biome", "biome_id"),
+                      &MultiBiomeLookaheadEngine::is_large_biome);
+    BIND_TIMED_METHOD(D_METHOD("get_focus_biome"),
+                      &MultiBiomeLookaheadEngine::get_focus_biome);
+    BIND_TIMED_METHOD(D_METHOD("set_lod_mi_stride", "stride"),
+                      &MultiBiomeLookaheadEngine::set_lod_mi_stride);
+    BIND_TIMED_METHOD(D_METHOD("get_lod_mi_stride"),
+                      &MultiBiomeLookaheadEngine::get_lod_mi_stride);
+    BIND_TIMED_METHOD(D_METHOD("set_frame_budget_ms", "budget_ms"),
+                      &MultiBiomeLookaheadEngine::set_frame_budget_ms);
+    BIND_TIMED_METHOD(D_METHOD("get_frame_budget_ms"), &MultiBiomeLookaheadEngine::get_frame_budget_ms);
+    BIND_TIMED_METHOD(D_METHOD("get_governor_level"), &MultiBiomeLookaheadEngine::get_governor_level);
+    BIND_TIMED_METHOD(D_METHOD("get_governor_stats"), &MultiBiomeLookaheadEngine::get_governor_stats);
+
+    BIND_ENUM_CONSTANT(LOD_FULL);
+    BIND_ENUM_CONSTANT(LOD_REDUCED_MI);
+    BIND_ENUM_CONSTANT(LOD_COARSE);
+    BIND_ENUM_CONSTANT(LOD_FROZEN);
+
+    BIND_ENUM_CONSTANT(GOVERNOR_FULL);
+    BIND_ENUM_CONSTANT(GOVERNOR_LINEAR_MI);
+    BIND_ENUM_CONSTANT(GOVERNOR_MI_STRIDE);
+    BIND_ENUM_CONSTANT(GOVERNOR_FEWER_STEPS);
+    BIND_ENUM_CONSTANT(GOVERNOR_FLOAT32);
+    BIND_ENUM_CONSTANT(GOVERNOR_COARSE_FORCE);
+
+    BIND_ENUM_CONSTANT(SNAPSHOT_LOOKAHEAD);
+    BIND_ENUM_CONSTANT(SNAPSHOT_PRESENT);
+
+    BIND_ENUM_CONSTANT(PACKET_STEP_COUNTS);
+    BIND_ENUM_CONSTANT(PACKET_RHO_OFFSETS);
+    BIND_ENUM_CONSTANT(PACKET_RHO);
+    BIND_ENUM_CONSTANT(PACKET_MI_OFFSETS);
+    BIND_ENUM_CONSTANT(PACKET_MI);
+    BIND_ENUM_CONSTANT(PACKET_BLOCH_OFFSETS);
+    BIND_ENUM_CONSTANT(PACKET_BLOCH);
+    BIND_ENUM_CONSTANT(PACKET_PURITY);
+    BIND_ENUM_CONSTANT(PACKET_NODE_OFFSETS);
+    BIND_ENUM_CONSTANT(PACKET_POSITIONS);
+    BIND_ENUM_CONSTANT(PACKET_VELOCITIES);
+    BIND_ENUM_CONSTANT(PACKET_RHO_DELTA_OFFSETS);
+    BIND_ENUM_CONSTANT(PACKET_RHO_DELTAS);
+    BIND_ENUM_CONSTANT(PACKET_RHO_DELTA_SCALES);
+    BIND_ENUM_CONSTANT(PACKET_I32);
+    BIND_ENUM_CONSTANT(PACKET_I64);
+    BIND_ENUM_CONSTANT(PACKET_F32);
+    BIND_ENUM_CONSTANT(PACKET_F64);
+    BIND_ENUM_CONSTANT(PACKET_I16);
+    ClassDB::bind_integer_constant(get_class_static(), "", "PACKET_MAGIC", PACKET_MAGIC);
+    ClassDB::bind_integer_constant(get_class_static(), "", "PACKET_VERSION", PACKET_VERSION);
+
+    BIND_ENUM_CONSTANT(WATCH_POPULATION);
+    BIND_ENUM_CONSTANT(WATCH_PURITY);
+    BIND_ENUM_CONSTANT(WATCH_MI);
+    BIND_ENUM_CONSTANT(WATCH_ABOVE);
+    BIND_ENUM_CONSTANT(WATCH_BELOW);
+
+    BIND_ENUM_CONSTANT(LOOKAHEAD_BLOCH);
+    BIND_ENUM_CONSTANT(LOOKAHEAD_PURITY);
+    BIND_ENUM_CONSTANT(LOOKAHEAD_MI);
+    BIND_ENUM_CONSTANT(LOOKAHEAD_POSITIONS);
+    BIND_ENUM_CONSTANT(LOOKAHEAD_ICON_MAP);
+    BIND_ENUM_CONSTANT(LOOKAHEAD_FULL_RHO);
+    BIND_ENUM_CONSTANT(LOOKAHEAD_ALL);
+
+    BIND_ENUM_CONSTANT(OUTPUT_PRECISION_DOUBLE);
+    BIND_ENUM_CONSTANT(OUTPUT_PRECISION_FLOAT);
+
+    BIND_ENUM_CONSTANT(RHO_STORAGE_FULL);
+    BIND_ENUM_CONSTANT(RHO_STORAGE_LAST);
+    BIND_ENUM_CONSTANT(RHO_STORAGE_DELTA);
+
+    BIND_ENUM_CONSTANT(COUPLING_POPULATION);
+    BIND_ENUM_CONSTANT(COUPLING_AMPLITUDE);
+
+    BIND_TIMED_METHOD(D_METHOD("set_pacing_delay_ms", "delay_ms"),
+                      &MultiBiomeLookaheadEngine::set_pacing_delay_ms);
+    BIND_TIMED_METHOD(D_METHOD("get_pacing_delay_ms"),
+                      &MultiBiomeLookaheadEngine::get_pacing_delay_ms);
+    // Async lookahead (background worker thread)
+    BIND_TIMED_METHOD(D_METHOD("submit_lookahead", "biome_rhos", "steps", "dt", "max_dt", "packed"),
+                      &MultiBiomeLookaheadEngine::submit_lookahead, DEFVAL(false));
+    BIND_TIMED_METHOD(D_METHOD("poll_lookahead"),
+                      &MultiBiomeLookaheadEngine::poll_lookahead);
+    BIND_TIMED_METHOD(D_METHOD("cancel_lookahead"),
+                      &MultiBiomeLookaheadEngine::cancel_lookahead);
+    BIND_TIMED_METHOD(D_METHOD("is_lookahead_busy"),
+                      &MultiBiomeLookaheadEngine::is_lookahead_busy);
+
+    // Sliced / async eigenstate analysis
+    BIND_TIMED_METHOD(D_METHOD("start_sliced_eigenstates", "biome_rhos"),
+                      &MultiBiomeLookaheadEngine::start_sliced_eigenstates, DEFVAL(Array()));
+    BIND_TIMED_METHOD(D_METHOD("continue_sliced_eigenstates_us", "budget_us"),
+                      &MultiBiomeLookaheadEngine::continue_sliced_eigenstates_us);
+    BIND_TIMED_METHOD(D_METHOD("is_sliced_eigenstates_complete"),
+                      &MultiBiomeLookaheadEngine::is_sliced_eigenstates_complete);
+    BIND_TIMED_METHOD(D_METHOD("get_sliced_eigenstates_result"),
+                      &MultiBiomeLookaheadEngine::get_sliced_eigenstates_result);
+    BIND_TIMED_METHOD(D_METHOD("cancel_sliced_eigenstates"),
+                      &MultiBiomeLookaheadEngine::cancel_sliced_eigenstates);
+    BIND_TIMED_METHOD(D_METHOD("get_sliced_eigenstates_progress"),
+                      &MultiBiomeLookaheadEngine::get_sliced_eigenstates_progress);
+    BIND_TIMED_METHOD(D_METHOD("submit_eigenstates", "biome_rhos"),
+                      &MultiBiomeLookaheadEngine::submit_eigenstates, DEFVAL(Array()));
+    BIND_TIMED_METHOD(D_METHOD("poll_eigenstates"), &MultiBiomeLookaheadEngine::poll_eigenstates);
+    BIND_TIMED_METHOD(D_METHOD("cancel_eigenstates"), &MultiBiomeLookaheadEngine::cancel_eigenstates);
+    BIND_TIMED_METHOD(D_METHOD("is_eigenstates_busy"), &MultiBiomeLookaheadEngine::is_eigenstates_busy);
+    ADD_SIGNAL(MethodInfo("eigenstates_ready"));
+
+    BIND_TIMED_METHOD(D_METHOD("set_parallel_biomes", "enabled"),
+                      &MultiBiomeLookaheadEngine::set_parallel_biomes);
+    BIND_TIMED_METHOD(D_METHOD("get_parallel_biomes"),
+                      &MultiBiomeLookaheadEngine::get_parallel_biomes);
+    BIND_TIMED_METHOD(D_METHOD("set_batch_equal_dimensions", "enabled"),
+                      &MultiBiomeLookaheadEngine::set_batch_equal_dimensions);
+    BIND_TIMED_METHOD(D_METHOD("set_use_task_graph", "enabled"),
+                      &MultiBiomeLookaheadEngine::set_use_task_graph);
+    BIND_TIMED_METHOD(D_METHOD("get_use_task_graph"),
+                      &MultiBiomeLookaheadEngine::get_use_task_graph);
+    BIND_TIMED_METHOD(D_METHOD("get_batch_equal_dimensions"),
+                      &MultiBiomeLookaheadEngine::get_batch_equal_dimensions);
+    BIND_TIMED_METHOD(D_METHOD("set_cross_biome_repulsion", "enabled"),
+                      &MultiBiomeLookaheadEngine::set_cross_biome_repulsion);
+    BIND_TIMED_METHOD(D_METHOD("get_cross_biome_repulsion"),
+                      &MultiBiomeLookaheadEngine::get_cross_biome_repulsion);
 }
 
 MultiBiomeLookaheadEngine::MultiBiomeLookaheadEngine() {
@@ -61,6 +923,11 @@ MultiBiomeLookaheadEngine::MultiBiomeLookaheadEngine() {
     m_force_engine->set_base_distance(100.0f);
     m_force_engine->set_min_distance(20.0f);
     m_force_engine->set_mi_spring(0.18f);
+    // Layouts persist across refills, so settled bubbles can sleep
+    m_force_engine->set_sleep_enabled(true);
+    // Lookahead steps are 0.1 s: integrate them as 60 Hz substeps
+    m_force_engine->set_fixed_timestep(1.0f / 60.0f);
+    m_force_engine->set_max_substeps(8);
 }
 
 void MultiBiomeLookaheadEngine::set_pacing_delay_ms(int delay_ms) {
@@ -71,586 +938,6049 @@ int MultiBiomeLookaheadEngine::get_pacing_delay_ms() const {
     return m_pacing_delay_ms;
 }
 
-MultiBiomeLookaheadEngine::~MultiBiomeLookaheadEngine() {}
+void MultiBiomeLookaheadEngine::set_biome_priority(int biome_id, int priority) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_biome_priority.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for set_biome_priority");
+        return;
+    }
+    m_biome_priority[biome_id] = priority;
+}
 
-int MultiBiomeLookaheadEngine::register_biome(int dim, const PackedFloat64Array& H_packed,
-                                               const Array& lindblad_triplets, int num_qubits) {
-    // Create new QuantumEvolutionEngine for this biome
-    Ref<QuantumEvolutionEngine> engine;
-    engine.instantiate();
+int MultiBiomeLookaheadEngine::get_biome_priority(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_biome_priority.size())) {
+        return 0;
+    }
+    return m_biome_priority[biome_id];
+}
 
-    // Configure dimension
-    engine->set_dimension(dim);
+void MultiBiomeLookaheadEngine::set_biome_budget_ms(int biome_id, double budget_ms) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_biome_budget_ms.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for set_biome_budget_ms");
+        return;
+    }
+    m_biome_budget_ms[biome_id] = (budget_ms > 0.0) ? budget_ms : 0.0;
+}
 
-    // Set Hamiltonian
-    if (H_packed.size() > 0) {
-        engine->set_hamiltonian(H_packed);
+double MultiBiomeLookaheadEngine::get_biome_step_cost_us(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_biome_step_cost_us.size())) {
+        return 0.0;
     }
+    return m_biome_step_cost_us[biome_id];
+}
 
-    // Add Lindblad operators
-    for (int i = 0; i < lindblad_triplets.size(); i++) {
-        PackedFloat64Array triplets = lindblad_triplets[i];
-        if (triplets.size() > 0) {
-            engine->add_lindblad_triplets(triplets);
+double MultiBiomeLookaheadEngine::_cost_work(int biome_id, int stage) const {
+    const Ref<QuantumEvolutionEngine>& engine = _engine(biome_id);
+    if (engine.is_null()) {
+        return 0.0;
+    }
+    const double candidates = engine->get_mi_candidate_count();
+    switch (stage) {
+        case COST_EVOLVE: {
+            // One SpMV over vec(ρ) with 𝓛, else sparse × dense products with every operator
+            const double nnz = static_cast<double>(std::max<int64_t>(engine->get_operator_nnz(), 1));
+            return engine->has_liouvillian() ? nnz : nnz * engine->get_dimension();
         }
+        case COST_MI:
+            return std::max(1.0, candidates + engine->get_mi_rescreen_budget());
+        case COST_FORCE: {
+            const ForceGraphEngine::NodeBuffers* nodes = m_force_engine->get_layout(m_force_layouts[biome_id]);
+            const double count = nodes ? static_cast<double>(nodes->x.size()) : 0.0;
+            return std::max(1.0, count * count + candidates);
+        }
+        default:
+            return 0.0;
     }
+}
 
-    // Finalize (precompute L†, L†L)
-    engine->finalize();
+MultiBiomeLookaheadEngine::CostSnapshot MultiBiomeLookaheadEngine::_cost_snapshot(int biome_id) const {
+    CostSnapshot snapshot;
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size())) {
+        return snapshot;
+    }
+    // Ensemble biomes evolve on their trajectory engine: its whole stage counts
+    snapshot.stage[COST_EVOLVE] = m_trajectory_engines[biome_id].is_valid() ? m_biome_profile[biome_id].ensemble
+                                                                             : _engine(biome_id)->evolve_profile();
+    snapshot.stage[COST_MI] = _engine(biome_id)->mi_profile();
+    snapshot.stage[COST_FORCE] = m_biome_profile[biome_id].force;
+    return snapshot;
+}
 
-    // Store engine and metadata
-    int biome_id = static_cast<int>(m_engines.size());
-    m_engines.push_back(engine);
-    m_num_qubits.push_back(num_qubits);
-    m_metadata.push_back(Dictionary());
-    m_couplings.push_back(Dictionary());
-    m_lnns.push_back(nullptr);  // LNN disabled by default
+void MultiBiomeLookaheadEngine::_update_cost_model(int biome_id, const CostSnapshot& before) {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_cost_models.size())) {
+        return;
+    }
+    const CostSnapshot after = _cost_snapshot(biome_id);
+    CostModel& model = m_cost_models[biome_id];
+    for (int stage = 0; stage < COST_STAGE_COUNT; stage++) {
+        const uint64_t calls = after.stage[stage].calls - before.stage[stage].calls;
+        const double work = _cost_work(biome_id, stage);
+        if (calls == 0 || work <= 0.0) {
+            continue;
+        }
+        const double per_pass_us =
+            static_cast<double>(after.stage[stage].nanos - before.stage[stage].nanos) / 1000.0 / calls;
+        const double coeff = per_pass_us / work;
+        double& estimate = model.coeff[stage];
+        estimate = (model.samples[stage] == 0) ? coeff : estimate + STEP_COST_SMOOTHING * (coeff - estimate);
+        model.samples[stage] += calls;
+    }
+}
 
-    // Initialize force graph data (positions/velocities for num_qubits nodes)
-    PackedVector2Array initial_positions;
-    PackedVector2Array initial_velocities;
-    initial_positions.resize(num_qubits);
-    initial_velocities.resize(num_qubits);
+Array MultiBiomeLookaheadEngine::get_cost_estimates() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    const int num_biomes = static_cast<int>(m_cost_models.size());
+
+    // Prior for unmeasured stages: mean coefficient of the measured biomes
+    double prior[COST_STAGE_COUNT] = {0.0, 0.0, 0.0};
+    for (int stage = 0; stage < COST_STAGE_COUNT; stage++) {
+        int measured = 0;
+        for (const CostModel& model : m_cost_models) {
+            if (model.samples[stage] > 0) {
+                prior[stage] += model.coeff[stage];
+                measured++;
+            }
+        }
+        prior[stage] = measured > 0 ? prior[stage] / measured : 0.0;
+    }
 
-    // Initialize to random positions in a circle (will be refined by force calculation)
-    for (int i = 0; i < num_qubits; i++) {
-        float angle = (float(i) / float(num_qubits)) * 2.0f * 3.14159f;
-        float radius = 100.0f;
-        initial_positions[i] = Vector2(std::cos(angle) * radius, std::sin(angle) * radius);
-        initial_velocities[i] = Vector2(0, 0);
+    static const char* const stage_keys[COST_STAGE_COUNT] = {"evolve_step_us", "mi_pass_us", "force_pass_us"};
+    static const char* const sample_keys[COST_STAGE_COUNT] = {"evolve_samples", "mi_samples", "force_samples"};
+    Array estimates;
+    for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+        const CostModel& model = m_cost_models[biome_id];
+        const Ref<QuantumEvolutionEngine>& engine = _engine(biome_id);
+        Dictionary estimate;
+        double step_us = 0.0;
+        for (int stage = 0; stage < COST_STAGE_COUNT; stage++) {
+            const double coeff = model.samples[stage] > 0 ? model.coeff[stage] : prior[stage];
+            const double predicted = coeff * _cost_work(biome_id, stage);
+            estimate[stage_keys[stage]] = predicted;
+            estimate[sample_keys[stage]] = static_cast<int64_t>(model.samples[stage]);
+            step_us += predicted;
+        }
+        estimate["step_us"] = step_us;
+        const ForceGraphEngine::NodeBuffers* nodes = m_force_engine->get_layout(m_force_layouts[biome_id]);
+        estimate["dim"] = engine.is_valid() ? engine->get_dimension() : 0;
+        estimate["nnz"] = engine.is_valid() ? engine->get_operator_nnz() : int64_t(0);
+        estimate["mi_candidates"] = engine.is_valid() ? engine->get_mi_candidate_count() : 0;
+        estimate["force_nodes"] = nodes ? static_cast<int64_t>(nodes->x.size()) : int64_t(0);
+        estimates.push_back(estimate);
     }
+    return estimates;
+}
 
-    m_node_positions.push_back(initial_positions);
-    m_node_velocities.push_back(initial_velocities);
-    m_biome_centers.push_back(Vector2(960, 540));  // Default center (will be updated by GDScript)
+double MultiBiomeLookaheadEngine::get_biome_budget_ms(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_biome_budget_ms.size())) {
+        return 0.0;
+    }
+    return m_biome_budget_ms[biome_id];
+}
+
+void MultiBiomeLookaheadEngine::set_biome_lod(int biome_id, int lod) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_biome_lod.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for set_biome_lod");
+        return;
+    }
+    if (lod < LOD_FULL || lod > LOD_FROZEN) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Unknown LOD tier ", lod);
+        return;
+    }
+    m_biome_lod[biome_id] = lod;
+}
 
-    UtilityFunctions::print("MultiBiomeLookaheadEngine: Registered biome ",
-                            biome_id, " (dim=", dim, ", num_qubits=", num_qubits,
-                            ", lindblad_ops=", lindblad_triplets.size(), ")");
+int MultiBiomeLookaheadEngine::get_biome_lod(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_biome_lod.size())) {
+        return LOD_FULL;
+    }
+    return m_biome_lod[biome_id];
+}
 
-    return biome_id;
+int MultiBiomeLookaheadEngine::get_effective_biome_lod(int biome_id) const {
+    if (_is_stationary(biome_id)) {
+        return LOD_FROZEN;
+    }
+    const int lod = get_biome_lod(biome_id);
+    if (m_focus_biome < 0) {
+        return lod;
+    }
+    return (biome_id == m_focus_biome) ? static_cast<int>(LOD_FULL) : std::max(lod, m_background_lod);
+}
+
+void MultiBiomeLookaheadEngine::set_focus_biome(int biome_id, int background_lod) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (background_lod < LOD_FULL || background_lod > LOD_FROZEN) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Unknown LOD tier ", background_lod);
+        return;
+    }
+    m_focus_biome = (biome_id >= 0) ? biome_id : -1;
+    m_background_lod = background_lod;
+}
+
+void MultiBiomeLookaheadEngine::set_steady_state_detection(double tolerance, int window) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_steady_tolerance = std::max(0.0, tolerance);
+    m_steady_window = std::max(1, window);
+    for (SteadyState& steady : m_steady) {
+        steady.still_steps = 0;
+    }
+}
+
+bool MultiBiomeLookaheadEngine::is_biome_stationary(int biome_id) const {
+    return _is_stationary(biome_id);
+}
+
+PackedFloat64Array MultiBiomeLookaheadEngine::solve_biome_steady_state(int biome_id) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size()) || _engine(biome_id).is_null()) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for solve_biome_steady_state");
+        return PackedFloat64Array();
+    }
+    const PackedFloat64Array rho = _engine(biome_id)->compute_steady_state();
+    if (!rho.is_empty()) {
+        SteadyState& steady = m_steady[biome_id];
+        steady.stationary = true;
+        steady.still_steps = 0;
+        steady.rho = rho;
+        steady.drift = 0.0;  // Only this exact state
+    }
+    return rho;
+}
+
+void MultiBiomeLookaheadEngine::set_large_biome_qubits(int num_qubits) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_large_biome_qubits = std::max(0, num_qubits);
+    m_batched_ops.clear();  // Group membership depends on it
+}
+
+int MultiBiomeLookaheadEngine::get_large_biome_qubits() const {
+    return m_large_biome_qubits;
+}
+
+bool MultiBiomeLookaheadEngine::is_large_biome(int biome_id) const {
+    return m_large_biome_qubits > 0 && biome_id >= 0 && biome_id < static_cast<int>(m_num_qubits.size()) &&
+           m_num_qubits[biome_id] >= m_large_biome_qubits;
+}
+
+void MultiBiomeLookaheadEngine::_check_stationary(int biome_id, const PackedFloat64Array& rho) {
+    SteadyState& steady = m_steady[biome_id];
+    if (!steady.stationary) {
+        return;
+    }
+    bool same = rho.size() == steady.rho.size();
+    if (same && rho.ptr() != steady.rho.ptr()) {
+        const Eigen::Map<const Eigen::VectorXd> a(rho.ptr(), rho.size());
+        const Eigen::Map<const Eigen::VectorXd> b(steady.rho.ptr(), steady.rho.size());
+        same = (a - b).norm() <= steady.drift;
+    }
+    if (!same) {
+        steady = SteadyState();
+    }
+}
+
+int MultiBiomeLookaheadEngine::get_focus_biome() const {
+    return m_focus_biome;
+}
+
+void MultiBiomeLookaheadEngine::set_lod_mi_stride(int stride) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_lod_mi_stride = std::max(1, stride);
+}
+
+int MultiBiomeLookaheadEngine::get_lod_mi_stride() const {
+    return m_lod_mi_stride;
+}
+
+int MultiBiomeLookaheadEngine::_mi_stride(int lod) const {
+    const int stride = (lod >= LOD_REDUCED_MI) ? m_lod_mi_stride : 1;
+    return m_governor_level >= GOVERNOR_MI_STRIDE ? std::max(stride, 2) : stride;
+}
+
+void MultiBiomeLookaheadEngine::set_frame_budget_ms(double budget_ms) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_frame_budget_ms = std::max(0.0, budget_ms);
+    m_governor_primed = false;
+    m_governor_hold = 0;
+    if (m_frame_budget_ms == 0.0) {
+        _apply_governor_level(GOVERNOR_FULL);
+    }
+}
+
+double MultiBiomeLookaheadEngine::get_frame_budget_ms() const {
+    return m_frame_budget_ms;
+}
+
+int MultiBiomeLookaheadEngine::get_governor_level() const {
+    return m_governor_level;
+}
+
+Dictionary MultiBiomeLookaheadEngine::get_governor_stats() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    Dictionary stats;
+    stats["level"] = m_governor_level;
+    stats["budget_ms"] = m_frame_budget_ms;
+    stats["smoothed_ms"] = m_governor_primed ? m_governor_ms : 0.0;
+    stats["calls_at_level"] = m_governor_hold;
+    return stats;
+}
+
+void MultiBiomeLookaheadEngine::_governor_observe(double elapsed_ms) {
+    if (m_frame_budget_ms <= 0.0) {
+        return;
+    }
+    m_governor_ms = m_governor_primed ? m_governor_ms + GOVERNOR_SMOOTHING * (elapsed_ms - m_governor_ms)
+                                      : elapsed_ms;
+    m_governor_primed = true;
+    if (++m_governor_hold < GOVERNOR_HOLD_CALLS) {
+        return;
+    }
+    int level = m_governor_level;
+    if (m_governor_ms > m_frame_budget_ms && level < GOVERNOR_COARSE_FORCE) {
+        level++;
+    } else if (m_governor_ms < m_frame_budget_ms * GOVERNOR_HEADROOM && level > GOVERNOR_FULL) {
+        level--;
+    }
+    if (level != m_governor_level) {
+        _apply_governor_level(level);
+        m_governor_hold = 0;
+    }
+}
+
+void MultiBiomeLookaheadEngine::_apply_governor_level(int level) {
+    m_governor_level = level;
+    for (int biome_id = 0; biome_id < static_cast<int>(m_engines.size()); biome_id++) {
+        _apply_governor_biome(biome_id);
+    }
+    // The substep cap is shared by every layout; remember the caller's value
+    const bool coarse = level >= GOVERNOR_COARSE_FORCE;
+    if (coarse && m_governor_base_substeps == 0) {
+        m_governor_base_substeps = m_force_engine->get_max_substeps();
+        m_force_engine->set_max_substeps(std::max(1, m_governor_base_substeps / GOVERNOR_SUBSTEP_DIVISOR));
+    } else if (!coarse && m_governor_base_substeps > 0) {
+        m_force_engine->set_max_substeps(m_governor_base_substeps);
+        m_governor_base_substeps = 0;
+    }
+}
+
+void MultiBiomeLookaheadEngine::_apply_governor_biome(int biome_id) {
+    Ref<QuantumEvolutionEngine> engine = _engine(biome_id);
+    if (engine.is_null()) {
+        return;
+    }
+    engine->set_mi_force_linear(m_governor_level >= GOVERNOR_LINEAR_MI);
+    const bool want_float = m_governor_level >= GOVERNOR_FLOAT32;
+    if (want_float && !engine->get_single_precision()) {
+        engine->set_single_precision(true);
+        m_governor_float[biome_id] = 1;
+        _prepare_lnn(biome_id);
+    } else if (!want_float && m_governor_float[biome_id]) {
+        engine->set_single_precision(false);
+        m_governor_float[biome_id] = 0;
+        _prepare_lnn(biome_id);
+    }
+}
+
+float MultiBiomeLookaheadEngine::_lod_max_dt(int biome_id, int lod, float dt, float max_dt) const {
+    // Legacy Euler advances max_dt per step, so raising it would change the
+    // simulated time, not just the resolution
+    if (lod < LOD_COARSE ||
+        _engine(biome_id)->get_integrator() == QuantumEvolutionEngine::INTEGRATOR_EULER) {
+        return max_dt;
+    }
+    return std::max(max_dt, dt);
+}
+
+void MultiBiomeLookaheadEngine::set_parallel_biomes(bool enabled) {
+    m_parallel_biomes = enabled;
+}
+
+bool MultiBiomeLookaheadEngine::get_parallel_biomes() const {
+    return m_parallel_biomes;
+}
+
+void MultiBiomeLookaheadEngine::set_batch_equal_dimensions(bool enabled) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_batch_equal_dims = enabled;
+    if (!enabled) {
+        m_batched_ops.clear();
+    }
+}
+
+bool MultiBiomeLookaheadEngine::get_batch_equal_dimensions() const {
+    return m_batch_equal_dims;
+}
+
+void MultiBiomeLookaheadEngine::set_use_task_graph(bool enabled) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_use_task_graph = enabled;
+}
+
+bool MultiBiomeLookaheadEngine::get_use_task_graph() const {
+    return m_use_task_graph;
+}
+
+void MultiBiomeLookaheadEngine::set_cross_biome_repulsion(bool enabled) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_cross_biome_repulsion = enabled;
+}
+
+bool MultiBiomeLookaheadEngine::get_cross_biome_repulsion() const {
+    return m_cross_biome_repulsion;
+}
+
+void MultiBiomeLookaheadEngine::_repel_across_biomes(float dt) {
+    if (!m_cross_biome_repulsion || m_force_layouts.size() < 2) {
+        return;
+    }
+    ScopedProfile profile(m_profile_cross_repulsion);
+    NATIVE_TRACE_ZONE("cross_repulsion");
+    std::vector<ForceGraphEngine::NodeBuffers*> layouts;
+    layouts.reserve(m_force_layouts.size());
+    for (int handle : m_force_layouts) {
+        layouts.push_back(m_force_engine->get_layout(handle));
+    }
+    m_force_engine->repel_between(layouts, dt);
+}
+
+bool MultiBiomeLookaheadEngine::_is_batch_eligible(int biome_id, const PackedFloat64Array& rho_packed) const {
+    const Ref<QuantumEvolutionEngine>& engine = _engine(biome_id);
+    if (engine.is_null() || !engine->is_batchable() || m_trajectory_engines[biome_id].is_valid() ||
+        is_lnn_enabled(biome_id) || get_effective_biome_lod(biome_id) == LOD_FROZEN || is_large_biome(biome_id)) {
+        return false;
+    }
+    const int64_t dim = engine->get_dimension();
+    return rho_packed.size() == dim * dim * 2 && m_biome_active[biome_id];
+}
+
+void MultiBiomeLookaheadEngine::_evolve_batched_groups(
+    const std::vector<PackedFloat64Array>& rhos, int num_biomes, int steps,
+    float dt, float max_dt, std::vector<PackedFloat64Array>& frames_out) {
+    frames_out.assign(num_biomes, PackedFloat64Array());
+    if (steps <= 0) {
+        return;
+    }
+
+    std::map<int, std::vector<int>> by_dim;
+    for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+        if (_is_batch_eligible(biome_id, rhos[biome_id])) {
+            by_dim[_engine(biome_id)->get_dimension()].push_back(biome_id);
+        }
+    }
+
+    // Operators per group, built (or fetched) on the caller before fanning out
+    std::vector<std::vector<int>> groups;
+    std::vector<std::shared_ptr<const QuantumEvolutionEngine::BatchedOperators>> group_ops;
+    for (const auto& entry : by_dim) {
+        if (entry.second.size() < 2) {
+            continue;
+        }
+        std::shared_ptr<const QuantumEvolutionEngine::BatchedOperators>& ops = m_batched_ops[entry.second];
+        if (!ops) {
+            std::vector<const QuantumEvolutionEngine*> engines;
+            for (int biome_id : entry.second) {
+                engines.push_back(_engine(biome_id).ptr());
+            }
+            ops = QuantumEvolutionEngine::build_batched_operators(engines);
+        }
+        if (ops) {
+            groups.push_back(entry.second);
+            group_ops.push_back(ops);
+        }
+    }
+
+    // Euler evolve() advances one step of max_dt (dt ignored), so do the same
+    const double h = (max_dt > 0.0f) ? static_cast<double>(max_dt) : static_cast<double>(dt);
+    auto group_range = [&](int begin, int end) {
+        for (int g = begin; g < end; g++) {
+            const std::vector<int>& members = groups[g];
+            const QuantumEvolutionEngine::BatchedOperators& ops = *group_ops[g];
+            const int d = ops.dim;
+            const int64_t stride = static_cast<int64_t>(d) * d * 2;
+
+            QuantumEvolutionEngine::RhoMatrix stack(static_cast<Eigen::Index>(members.size()) * d, d);
+            std::vector<double*> out(members.size());
+            for (size_t i = 0; i < members.size(); i++) {
+                stack.middleRows(i * d, d) = Eigen::Map<const QuantumEvolutionEngine::RhoMatrix>(
+                    reinterpret_cast<const std::complex<double>*>(rhos[members[i]].ptr()), d, d);
+                PackedFloat64Array& frames = frames_out[members[i]];
+                frames.resize(steps * stride);
+                out[i] = frames.ptrw();
+            }
+
+            QuantumEvolutionEngine::BatchedWorkspace work;
+            for (int step = 0; step < steps; step++) {
+                QuantumEvolutionEngine::euler_step_batched(ops, stack, h, work);
+                for (size_t i = 0; i < members.size(); i++) {
+                    Eigen::Map<QuantumEvolutionEngine::RhoMatrix>(
+                        reinterpret_cast<std::complex<double>*>(out[i] + step * stride), d, d) =
+                        stack.middleRows(i * d, d);
+                }
+            }
+        }
+    };
+    const int num_groups = static_cast<int>(groups.size());
+    if (m_parallel_biomes) {
+        NativeThreadPool::shared().parallel_for(0, num_groups, num_groups, group_range);
+    } else {
+        group_range(0, num_groups);
+    }
+}
+
+MultiBiomeLookaheadEngine::~MultiBiomeLookaheadEngine() {
+    {
+        std::lock_guard<std::mutex> lock(m_async_mutex);
+        m_async_stopping = true;
+        m_async_has_job = false;
+        if (m_async_running_cancel) {
+            m_async_running_cancel->store(true);
+        }
+    }
+    m_async_cv.notify_all();
+    if (m_async_thread.joinable()) {
+        m_async_thread.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_eigen_mutex);
+        m_eigen_stopping = true;
+        m_eigen_has_job = false;
+    }
+    m_eigen_cv.notify_all();
+    if (m_eigen_thread.joinable()) {
+        m_eigen_thread.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_prep_mutex);
+        m_prep_stopping = true;
+    }
+    m_prep_cv.notify_all();
+    if (m_prep_thread.joinable()) {
+        m_prep_thread.join();
+    }
+}
+
+int MultiBiomeLookaheadEngine::register_biome(int dim, const PackedFloat64Array& H_packed,
+                                               const Array& lindblad_triplets, int num_qubits,
+                                               int num_trajectories, const Dictionary& metadata) {
+    BiomeBuild build;
+    build.dim = dim;
+    build.num_qubits = num_qubits;
+    build.num_trajectories = num_trajectories;
+    build.H_packed = H_packed;
+    build.lindblad_triplets = lindblad_triplets;
+    build.metadata = metadata;
+    build.defer_finalize = NativeThreadPool::has_threads();
+    {
+        std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+        build.operator_cache = m_operator_cache_dir;
+    }
+    _build_biome(build);
+
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    const int biome_id = _append_biome(build);
+    if (build.preparation) {
+        _queue_preparation(build.preparation);
+    }
+
+    UtilityFunctions::print_verbose("MultiBiomeLookaheadEngine: Registered biome ",
+                                    biome_id, " (dim=", dim, ", num_qubits=", num_qubits,
+                                    ", lindblad_ops=", lindblad_triplets.size(),
+                                    ", trajectories=", num_trajectories, ")");
+
+    return biome_id;
+}
+
+void MultiBiomeLookaheadEngine::_build_biome(BiomeBuild& build) {
+    // Finalized operators from the on-disk cache when this exact input was seen before
+    Ref<QuantumEvolutionEngine> engine;
+    String cache_path;
+    if (!build.operator_cache.is_empty()) {
+        cache_path = build.operator_cache.path_join(
+            String::num_uint64(operator_cache_key(build.dim, build.H_packed, build.lindblad_triplets,
+                                                  build.num_trajectories > 0), 16) + ".swop");
+        engine = read_cached_engine(cache_path, build.dim);
+        build.cache_result = engine.is_valid() ? 1 : 2;
+    }
+    const bool cached = engine.is_valid();
+
+    if (!cached) {
+        // Create new QuantumEvolutionEngine for this biome
+        engine.instantiate();
+
+        // Configure dimension
+        engine->set_dimension(build.dim);
+
+        // Set Hamiltonian
+        if (build.H_packed.size() > 0) {
+            engine->set_hamiltonian(build.H_packed);
+        }
+
+        // Add Lindblad operators
+        for (int i = 0; i < build.lindblad_triplets.size(); i++) {
+            PackedFloat64Array triplets = build.lindblad_triplets[i];
+            if (triplets.size() > 0) {
+                engine->add_lindblad_triplets(triplets);
+            }
+        }
+    }
+
+    // Large biomes opt into a trajectory ensemble with the same operators; the
+    // dense engine is then left unfinalized (no dim² scratch), holding only
+    // the operators for coupling payloads
+    Ref<QuantumTrajectoryEngine> trajectories;
+    if (build.num_trajectories > 0) {
+        trajectories.instantiate();
+        trajectories->set_dimension(build.dim);
+        trajectories->set_operators(engine->hamiltonian_operator(), engine->lindblad_operators());
+        trajectories->set_trajectory_count(build.num_trajectories);
+        trajectories->finalize();
+    } else if (!cached && build.defer_finalize) {
+        // Finalized (and cached) on the preparation thread
+        build.preparation = std::make_shared<Preparation>();
+        build.preparation->engine = engine;
+        build.preparation->cache_path = cache_path;
+    } else if (!cached) {
+        // Finalize (precompute L†, L†L)
+        engine->finalize();
+    }
+
+    if (!cached && !build.preparation && !cache_path.is_empty() && write_cached_engine(cache_path, *engine.ptr())) {
+        build.cache_result = 3;
+    }
+
+    if (!build.metadata.is_empty()) {
+        build.couplings = engine->compute_coupling_payload(build.metadata);
+    }
+    build.engine = engine;
+    build.trajectories = trajectories;
+}
+
+void MultiBiomeLookaheadEngine::_queue_preparation(const std::shared_ptr<Preparation>& preparation) {
+    std::lock_guard<std::mutex> lock(m_prep_mutex);
+    if (!m_prep_thread.joinable()) {
+        m_prep_thread = std::thread([this]() { _prep_worker_loop(); });
+    }
+    m_prep_queue.push_back(preparation);
+    m_prep_cv.notify_one();
+}
+
+void MultiBiomeLookaheadEngine::_prep_worker_loop() {
+    std::vector<std::shared_ptr<Preparation>> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_prep_mutex);
+            m_prep_cv.wait(lock, [this]() { return m_prep_stopping || !m_prep_queue.empty(); });
+            if (m_prep_queue.empty()) {
+                return;  // Stopping, nothing left to prepare
+            }
+            batch.swap(m_prep_queue);
+        }
+        // Everything queued so far as one low-priority pool job, a biome per
+        // chunk: a frame lookahead that arrives meanwhile takes the pool at the
+        // next biome boundary instead of falling back to one thread
+        const int count = static_cast<int>(batch.size());
+        NativeThreadPool::shared().parallel_for_background(0, count, [this, &batch](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                Preparation& preparation = *batch[i];
+                preparation.engine->finalize();
+                if (!preparation.cache_path.is_empty() &&
+                    write_cached_engine(preparation.cache_path, *preparation.engine.ptr())) {
+                    m_operator_cache_writes++;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(preparation.mutex);
+                    preparation.done.store(true, std::memory_order_release);
+                }
+                preparation.cv.notify_all();
+                m_preparations_pending.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        });
+        batch.clear();
+    }
+}
+
+void MultiBiomeLookaheadEngine::_await_prepared(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_preparing.size()) || !m_preparing[biome_id]) {
+        return;
+    }
+    Preparation& preparation = *m_preparing[biome_id];
+    if (preparation.done.load(std::memory_order_acquire)) {
+        return;
+    }
+    NATIVE_TRACE_ZONE_ID("await_prepare", biome_id);
+    std::unique_lock<std::mutex> lock(preparation.mutex);
+    preparation.cv.wait(lock, [&preparation]() { return preparation.done.load(std::memory_order_acquire); });
+}
+
+int MultiBiomeLookaheadEngine::get_pending_preparations() const {
+    return std::max(m_preparations_pending.load(std::memory_order_acquire), 0);
+}
+
+int MultiBiomeLookaheadEngine::_append_biome(const BiomeBuild& build) {
+    const int num_qubits = build.num_qubits;
+
+    // Store engine and metadata
+    int biome_id = static_cast<int>(m_engines.size());
+    m_engines.push_back(build.engine);
+    m_preparing.push_back(build.preparation);
+    if (build.preparation) {
+        m_preparations_pending.fetch_add(1, std::memory_order_acq_rel);
+    }
+    m_trajectory_engines.push_back(build.trajectories);
+    m_num_qubits.push_back(num_qubits);
+    m_biome_active.push_back(build.H_packed.size() > 0 || build.lindblad_triplets.size() > 0);
+    m_biome_profile.push_back(BiomeProfile());
+    m_metadata.push_back(Dictionary());
+    m_icon_index.push_back(IconIndex());
+    m_couplings.push_back(Dictionary());
+    m_payload_versions.push_back(PayloadVersion());
+    m_lnns.push_back(nullptr);  // LNN disabled by default
+    m_lnn_hidden.push_back(Eigen::VectorXd());
+    m_lnn_kernels.push_back(nullptr);
+    m_lnn_scratch.emplace_back();
+    m_lnn_stride.push_back(1);
+    m_lnn_training.emplace_back();
+    m_biome_priority.push_back(0);
+    m_biome_budget_ms.push_back(0.0);
+    m_biome_step_cost_us.push_back(0.0);
+    m_cost_models.push_back(CostModel());
+    m_governor_float.push_back(0);
+    m_biome_invalidation_rate.push_back(0.0);
+    m_biome_invalidations_pending.push_back(0);
+    m_biome_lod.push_back(LOD_FULL);
+    m_steady.emplace_back();
+    m_result_pool.emplace_back();
+    m_resident_rho.push_back(PackedFloat64Array());
+    m_batched_ops.clear();
+
+    // Initialize force graph data (positions/velocities for num_qubits nodes)
+    PackedVector2Array initial_positions;
+    PackedVector2Array initial_velocities;
+    initial_positions.resize(num_qubits);
+    initial_velocities.resize(num_qubits);
+
+    // Initialize to random positions in a circle (will be refined by force calculation)
+    for (int i = 0; i < num_qubits; i++) {
+        float angle = (float(i) / float(num_qubits)) * 2.0f * 3.14159f;
+        float radius = 100.0f;
+        initial_positions[i] = Vector2(std::cos(angle) * radius, std::sin(angle) * radius);
+        initial_velocities[i] = Vector2(0, 0);
+    }
+
+    m_force_layouts.push_back(m_force_engine->create_layout(num_qubits));
+    m_force_engine->set_layout_state(m_force_layouts.back(), initial_positions, initial_velocities);
+    m_biome_centers.push_back(Vector2(960, 540));  // Default center (will be updated by GDScript)
+    _apply_governor_biome(biome_id);
+    if (build.engine.is_valid()) {
+        build.engine->set_drift_thresholds(m_drift_thresholds[0], m_drift_thresholds[1], m_drift_thresholds[2]);
+        build.engine->set_mi_audit_interval(m_mi_audit_interval);
+    }
+
+    if (!build.metadata.is_empty()) {
+        m_metadata[biome_id] = build.metadata;
+        _compile_icon_index(biome_id);
+        m_couplings[biome_id] = build.couplings;
+        _touch_metadata(biome_id);
+        _touch_couplings(biome_id);
+    }
+
+    if (build.cache_result == 1) {
+        m_operator_cache_hits++;
+    } else if (build.cache_result >= 2) {
+        m_operator_cache_misses++;
+        m_operator_cache_writes += build.cache_result == 3 ? 1 : 0;
+    }
+
+    if (!build.restored) {
+        m_recorder.write_register(build.dim, build.H_packed, build.lindblad_triplets, num_qubits,
+                                  build.num_trajectories, build.metadata);
+    }
+    return biome_id;
+}
+
+PackedInt32Array MultiBiomeLookaheadEngine::register_biomes_bulk(const PackedByteArray& blob, const Array& metadata) {
+    // Structural pass: header, per-biome counts and entry offsets. Entries
+    // are decoded (and their indices checked) in the parallel pass.
+    BlobReader reader{blob.ptr(), blob.size()};
+    uint32_t magic = 0, version = 0, count = 0;
+    if (!reader.read_u32(magic) || !reader.read_u32(version) || !reader.read_u32(count) ||
+        magic != BULK_MAGIC || version != BULK_VERSION) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: register_biomes_bulk needs a version ",
+                                       static_cast<int64_t>(BULK_VERSION), " SWBB blob");
+        return PackedInt32Array();
+    }
+
+    std::vector<BiomeBuild> builds;
+    std::vector<BulkBiome> layout;
+    bool ok = reader.has(static_cast<int64_t>(count) * 20);  // Cheap bound before reserving
+    if (ok) {
+        builds.resize(count);
+        layout.resize(count);
+    }
+    for (uint32_t b = 0; ok && b < count; b++) {
+        uint32_t dim, num_qubits, num_trajectories, num_lindblads;
+        ok = reader.read_u32(dim) && reader.read_u32(num_qubits) && reader.read_u32(num_trajectories) &&
+             reader.read_u32(layout[b].h_count) && reader.read_u32(num_lindblads) &&
+             dim > 0 && dim <= (1u << 15) && num_qubits <= 32 && num_trajectories <= INT32_MAX &&
+             reader.has(static_cast<int64_t>(num_lindblads) * 4);
+        if (!ok) {
+            break;
+        }
+        builds[b].dim = static_cast<int>(dim);
+        builds[b].num_qubits = static_cast<int>(num_qubits);
+        builds[b].num_trajectories = static_cast<int>(num_trajectories);
+        layout[b].lindblads.resize(num_lindblads);
+        for (uint32_t k = 0; k < num_lindblads; k++) {
+            reader.read_u32(layout[b].lindblads[k].second);
+        }
+        layout[b].h_offset = reader.pos;
+        int64_t entries = layout[b].h_count;
+        int64_t offset = reader.pos + entries * BULK_ENTRY_BYTES;
+        for (auto& lindblad : layout[b].lindblads) {
+            lindblad.first = offset;
+            entries += lindblad.second;
+            offset += static_cast<int64_t>(lindblad.second) * BULK_ENTRY_BYTES;
+        }
+        ok = reader.has(entries * BULK_ENTRY_BYTES);
+        reader.pos = offset;
+        if (ok && b < static_cast<uint32_t>(metadata.size()) && metadata[b].get_type() == Variant::DICTIONARY) {
+            builds[b].metadata = metadata[b];
+        }
+    }
+    if (!ok || reader.pos != reader.size) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: register_biomes_bulk blob is truncated or malformed");
+        return PackedInt32Array();
+    }
+
+    String operator_cache;
+    {
+        std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+        operator_cache = m_operator_cache_dir;
+    }
+    for (BiomeBuild& build : builds) {
+        build.operator_cache = operator_cache;
+    }
+
+    // Decode and build every biome's engines in parallel; nothing is appended
+    // unless all of them decode
+    std::vector<char> decoded(count, 0);
+    auto biome_range = [&](int begin, int end) {
+        std::vector<int> rows, cols;
+        std::vector<std::complex<double>> values;
+        for (int b = begin; b < end; b++) {
+            BiomeBuild& build = builds[b];
+            const BulkBiome& biome = layout[b];
+            const int dim = build.dim;
+            auto decode = [&](int64_t offset, uint32_t n) {
+                rows.resize(n);
+                cols.resize(n);
+                values.resize(n);
+                return read_bulk_entries(blob.ptr(), offset, n, dim, rows.data(), cols.data(), values.data());
+            };
+
+            if (biome.h_count > 0) {
+                if (!decode(biome.h_offset, biome.h_count)) {
+                    continue;
+                }
+                // Dense packed H as register_biome takes it (a repeated entry keeps the last value)
+                build.H_packed.resize(static_cast<int64_t>(dim) * dim * 2);
+                build.H_packed.fill(0.0);
+                double* h = build.H_packed.ptrw();
+                for (uint32_t k = 0; k < biome.h_count; k++) {
+                    const int64_t idx = (static_cast<int64_t>(rows[k]) * dim + cols[k]) * 2;
+                    h[idx] = values[k].real();
+                    h[idx + 1] = values[k].imag();
+                }
+            }
+            bool lindblads_ok = true;
+            for (const auto& lindblad : biome.lindblads) {
+                if (!decode(lindblad.first, lindblad.second)) {
+                    lindblads_ok = false;
+                    break;
+                }
+                PackedFloat64Array triplets;
+                triplets.resize(static_cast<int64_t>(lindblad.second) * 4);
+                double* t = triplets.ptrw();
+                for (uint32_t k = 0; k < lindblad.second; k++) {
+                    t[k * 4] = rows[k];
+                    t[k * 4 + 1] = cols[k];
+                    t[k * 4 + 2] = values[k].real();
+                    t[k * 4 + 3] = values[k].imag();
+                }
+                build.lindblad_triplets.push_back(triplets);
+            }
+            if (!lindblads_ok) {
+                continue;
+            }
+            _build_biome(build);
+            decoded[b] = 1;
+        }
+    };
+    const int num_biomes = static_cast<int>(count);
+    NativeThreadPool::shared().parallel_for(0, num_biomes, num_biomes, biome_range);
+
+    for (int b = 0; b < num_biomes; b++) {
+        if (!decoded[b]) {
+            UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: register_biomes_bulk entry index out of range in biome ", b);
+            return PackedInt32Array();
+        }
+    }
+
+    PackedInt32Array ids;
+    ids.resize(num_biomes);
+    {
+        std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+        for (int b = 0; b < num_biomes; b++) {
+            ids[b] = _append_biome(builds[b]);
+        }
+    }
+    UtilityFunctions::print("MultiBiomeLookaheadEngine: Registered ", num_biomes, " biomes from a bulk blob");
+    return ids;
+}
+
+PackedInt32Array MultiBiomeLookaheadEngine::register_synthetic_biomes(int count, int seed, int min_qubits,
+                                                                     int max_qubits, int lindblad_count,
+                                                                     double hamiltonian_density,
+                                                                     double initial_purity) {
+    if (count < 1) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: register_synthetic_biomes needs count >= 1");
+        return PackedInt32Array();
+    }
+    min_qubits = std::clamp(min_qubits, 1, SYNTHETIC_MAX_QUBITS);
+    max_qubits = std::clamp(max_qubits, min_qubits, SYNTHETIC_MAX_QUBITS);
+    lindblad_count = std::max(lindblad_count, 0);
+    hamiltonian_density = std::clamp(hamiltonian_density, 0.0, 1.0);
+
+    // Biome b's operators and initial state each come from their own stream
+    enum { OPERATOR_STREAM = 1, STATE_STREAM = 2 };
+    auto biome_rng = [seed](int b, int stream) {
+        std::seed_seq seq{static_cast<uint32_t>(seed), static_cast<uint32_t>(b), static_cast<uint32_t>(stream)};
+        return std::mt19937_64(seq);
+    };
+    EngineStateWriter out;
+    out.write_u32(BULK_MAGIC);
+    out.write_u32(BULK_VERSION);
+    out.write_u32(static_cast<uint32_t>(count));
+    std::vector<int> qubits(count);
+    for (int b = 0; b < count; b++) {
+        std::mt19937_64 rng = biome_rng(b, OPERATOR_STREAM);
+        qubits[b] = min_qubits + static_cast<int>(rng() % static_cast<uint64_t>(max_qubits - min_qubits + 1));
+        write_synthetic_biome(out, qubits[b], lindblad_count, hamiltonian_density, rng);
+    }
+
+    PackedByteArray blob;
+    blob.resize(static_cast<int64_t>(out.bytes().size()));
+    std::memcpy(blob.ptrw(), out.bytes().data(), out.bytes().size());
+    const PackedInt32Array ids = register_biomes_bulk(blob);
+    if (ids.size() != count) {
+        return ids;
+    }
+    for (int b = 0; b < count; b++) {
+        std::mt19937_64 rng = biome_rng(b, STATE_STREAM);
+        set_biome_rho(ids[b], synthetic_rho(1 << qubits[b], initial_purity, rng));
+    }
+    return ids;
+}
+
+PackedByteArray MultiBiomeLookaheadEngine::save_snapshot() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    EngineStateWriter out;
+    const int num_biomes = static_cast<int>(m_engines.size());
+    out.write_u32(SNAPSHOT_MAGIC);
+    out.write_u32(SNAPSHOT_VERSION);
+    out.write_u32(static_cast<uint32_t>(num_biomes));
+
+    for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+        out.write_i32(m_num_qubits[biome_id]);
+        out.write_i32(m_trajectory_engines[biome_id].is_valid()
+                          ? m_trajectory_engines[biome_id]->get_trajectory_count() : 0);
+        out.write_u8(m_biome_active[biome_id] ? 1 : 0);
+        out.write_i32(m_biome_priority[biome_id]);
+        out.write_f64(m_biome_budget_ms[biome_id]);
+        out.write_i32(m_biome_lod[biome_id]);
+        _engine(biome_id)->write_state(out);
+
+        write_variant(out, m_metadata[biome_id]);
+        write_variant(out, m_couplings[biome_id]);
+        const PackedFloat64Array& rho = m_resident_rho[biome_id];
+        out.write_doubles(rho.ptr(), static_cast<uint32_t>(rho.size()));
+
+        const int layout = m_force_layouts[biome_id];
+        write_vectors(out, m_force_engine->get_layout_positions(layout));
+        write_vectors(out, m_force_engine->get_layout_velocities(layout));
+        out.write_f64(m_biome_centers[biome_id].x);
+        out.write_f64(m_biome_centers[biome_id].y);
+
+        // LNN: -1 none, else the first biome holding the same network
+        // (enable_shared_lnn); only that biome stores the weights
+        int owner = -1;
+        if (m_lnns[biome_id]) {
+            owner = biome_id;
+            for (int other = 0; other < biome_id; other++) {
+                if (m_lnns[other] == m_lnns[biome_id]) {
+                    owner = other;
+                    break;
+                }
+            }
+        }
+        out.write_i32(owner);
+        out.write_i32(m_lnn_stride[biome_id]);
+        if (owner == biome_id) {
+            std::vector<uint8_t> weights(m_lnns[biome_id]->weights_byte_size());
+            m_lnns[biome_id]->save_weights(weights.data());
+            out.write_bytes(weights.data(), static_cast<uint32_t>(weights.size()));
+        }
+        if (owner >= 0) {
+            const Eigen::VectorXd& hidden = m_lnn_hidden[biome_id];
+            out.write_doubles(hidden.data(), static_cast<uint32_t>(hidden.size()));
+        }
+    }
+
+    PackedByteArray blob;
+    blob.resize(static_cast<int64_t>(out.bytes().size()));
+    std::memcpy(blob.ptrw(), out.bytes().data(), out.bytes().size());
+    return blob;
+}
+
+bool MultiBiomeLookaheadEngine::load_snapshot(const PackedByteArray& blob) {
+    // Decode everything before touching the registered biomes
+    struct Restored {
+        BiomeBuild build;
+        bool active = true;
+        int priority = 0;
+        double budget_ms = 0.0;
+        int lod = LOD_FULL;
+        PackedFloat64Array rho;
+        PackedVector2Array positions;
+        PackedVector2Array velocities;
+        Vector2 center;
+        int lnn_owner = -1;
+        int lnn_stride = 1;
+        std::shared_ptr<LiquidNeuralNet> lnn;
+        Eigen::VectorXd lnn_hidden;
+    };
+
+    EngineStateReader in(blob.ptr(), blob.size());
+    uint32_t magic = 0, version = 0, count = 0;
+    in.read_u32(magic);
+    in.read_u32(version);
+    in.read_u32(count);
+    if (!in.ok() || magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: load_snapshot needs a version ",
+                                       static_cast<int64_t>(SNAPSHOT_VERSION), " SWES blob");
+        return false;
+    }
+
+    std::vector<Restored> biomes;
+    for (uint32_t b = 0; b < count && in.ok(); b++) {
+        biomes.emplace_back();
+        Restored& r = biomes.back();
+        BiomeBuild& build = r.build;
+        int32_t num_qubits = 0, num_trajectories = 0, priority = 0, lod = 0, owner = -1, stride = 1;
+        uint8_t active = 0;
+        double budget_ms = 0.0, center_x = 0.0, center_y = 0.0;
+        in.read_i32(num_qubits);
+        in.read_i32(num_trajectories);
+        in.read_u8(active);
+        in.read_i32(priority);
+        in.read_f64(budget_ms);
+        in.read_i32(lod);
+        if (!in.ok() || num_qubits < 0 || num_qubits > 32 || num_trajectories < 0 || lod < LOD_FULL ||
+            lod > LOD_FROZEN) {
+            in.fail();
+            break;
+        }
+        build.engine.instantiate();
+        if (!build.engine->read_state(in)) {
+            break;
+        }
+        build.dim = build.engine->get_dimension();
+        build.num_qubits = num_qubits;
+        build.num_trajectories = num_trajectories;
+        build.metadata = read_dictionary(in);
+        build.couplings = read_dictionary(in);
+        build.restored = true;
+
+        std::vector<double> values;
+        if (in.read_doubles(values)) {
+            r.rho.resize(static_cast<int64_t>(values.size()));
+            std::copy(values.begin(), values.end(), r.rho.ptrw());
+        }
+        read_vectors(in, r.positions);
+        read_vectors(in, r.velocities);
+        in.read_f64(center_x);
+        in.read_f64(center_y);
+        in.read_i32(owner);
+        in.read_i32(stride);
+        if (!in.ok() || owner < -1 || owner > static_cast<int32_t>(b) ||
+            (owner >= 0 && owner < static_cast<int32_t>(b) && !biomes[owner].lnn)) {
+            in.fail();
+            break;
+        }
+        if (owner == static_cast<int32_t>(b)) {
+            uint32_t size = 0;
+            const uint8_t* weights = in.read_u32(size) ? in.read_span(size) : nullptr;
+            r.lnn = weights != nullptr ? LiquidNeuralNet::from_weights(weights, size) : nullptr;
+            if (!r.lnn || r.lnn->input_size != build.dim || r.lnn->output_size != build.dim) {
+                in.fail();
+                break;
+            }
+        } else if (owner >= 0) {
+            r.lnn = biomes[owner].lnn;
+        }
+        if (r.lnn) {
+            if (!in.read_doubles(values) || static_cast<int>(values.size()) != r.lnn->hidden_size) {
+                in.fail();
+                break;
+            }
+            r.lnn_hidden = Eigen::Map<const Eigen::VectorXd>(values.data(), static_cast<Eigen::Index>(values.size()));
+        }
+
+        if (num_trajectories > 0) {
+            build.trajectories.instantiate();
+            build.trajectories->set_dimension(build.dim);
+            build.trajectories->set_operators(build.engine->hamiltonian_operator(),
+                                              build.engine->lindblad_operators());
+            build.trajectories->set_trajectory_count(num_trajectories);
+            build.trajectories->finalize();
+        }
+        r.active = active != 0;
+        r.priority = priority;
+        r.budget_ms = budget_ms;
+        r.lod = lod;
+        r.center = Vector2(static_cast<real_t>(center_x), static_cast<real_t>(center_y));
+        r.lnn_owner = owner;
+        r.lnn_stride = std::max(1, static_cast<int>(stride));
+    }
+    if (!in.ok() || !in.at_end() || biomes.size() != count) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: load_snapshot blob is truncated or malformed");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (m_recorder.is_open()) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: load_snapshot is not captured by the active recording");
+    }
+    _clear_biomes();
+    for (Restored& r : biomes) {
+        const int biome_id = _append_biome(r.build);
+        m_biome_active[biome_id] = r.active;
+        m_biome_priority[biome_id] = r.priority;
+        m_biome_budget_ms[biome_id] = r.budget_ms;
+        m_biome_lod[biome_id] = r.lod;
+        m_resident_rho[biome_id] = r.rho;
+        if (r.positions.size() == m_num_qubits[biome_id]) {
+            m_force_engine->set_layout_state(m_force_layouts[biome_id], r.positions, r.velocities);
+        }
+        m_biome_centers[biome_id] = r.center;
+        m_lnn_stride[biome_id] = r.lnn_stride;
+        if (r.lnn) {
+            m_lnns[biome_id] = r.lnn;
+            m_lnn_hidden[biome_id] = r.lnn_hidden;
+            _prepare_lnn(biome_id);
+        }
+    }
+    UtilityFunctions::print("MultiBiomeLookaheadEngine: Restored ", static_cast<int64_t>(count),
+                            " biomes from a snapshot (", blob.size(), " bytes)");
+    return true;
+}
+
+void MultiBiomeLookaheadEngine::set_operator_cache_dir(const String& dir) {
+    if (!dir.is_empty() && DirAccess::make_dir_recursive_absolute(dir) != OK) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Cannot create operator cache directory ", dir);
+        return;
+    }
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_operator_cache_dir = dir;
+}
+
+String MultiBiomeLookaheadEngine::get_operator_cache_dir() const {
+    return m_operator_cache_dir;
+}
+
+Dictionary MultiBiomeLookaheadEngine::get_operator_cache_stats() const {
+    Dictionary stats;
+    stats["hits"] = static_cast<int64_t>(m_operator_cache_hits);
+    stats["misses"] = static_cast<int64_t>(m_operator_cache_misses);
+    stats["writes"] = static_cast<int64_t>(m_operator_cache_writes.load());
+    return stats;
+}
+
+bool MultiBiomeLookaheadEngine::_check_patchable(int biome_id, const char* method) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for ", method, " ", biome_id);
+        return false;
+    }
+    if (is_trajectory_biome(biome_id)) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: ", method,
+                                       " does not support trajectory biomes; re-register biome ", biome_id);
+        return false;
+    }
+    return true;
+}
+
+void MultiBiomeLookaheadEngine::_operators_changed(int biome_id) {
+    if (biome_id < static_cast<int>(m_rings.size())) {
+        LookaheadRing& ring = m_rings[biome_id];
+        while (ring.count > 0) {
+            ring.slots[(ring.head + ring.count - 1) % ring.slots.size()] = LookaheadFrame();
+            ring.count--;
+        }
+        // Frames consumed past a lagging base are re-evolved from it
+        ring.owed += ring.base_lag;
+        ring.base_lag = 0;
+        if (!ring.base_positions.is_empty()) {
+            m_force_engine->set_layout_state(m_force_layouts[biome_id], ring.base_positions, ring.base_velocities);
+        }
+    }
+    m_batched_ops.clear();
+    m_steady[biome_id] = SteadyState();
+    if (!m_metadata[biome_id].is_empty()) {
+        m_couplings[biome_id] = _engine(biome_id)->compute_coupling_payload(m_metadata[biome_id]);
+        _touch_couplings(biome_id);
+    }
+}
+
+bool MultiBiomeLookaheadEngine::update_biome_hamiltonian(int biome_id, const PackedFloat64Array& triplets) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (!_check_patchable(biome_id, "update_biome_hamiltonian") ||
+        !_engine(biome_id)->update_hamiltonian_entries(triplets)) {
+        return false;
+    }
+    m_recorder.write_update_hamiltonian(biome_id, triplets);
+    _operators_changed(biome_id);
+    return true;
+}
+
+bool MultiBiomeLookaheadEngine::replace_biome_lindblad(int biome_id, int k, const PackedFloat64Array& triplets) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (!_check_patchable(biome_id, "replace_biome_lindblad") ||
+        !_engine(biome_id)->replace_lindblad(k, triplets)) {
+        return false;
+    }
+    m_recorder.write_replace_lindblad(biome_id, k, triplets);
+    _operators_changed(biome_id);
+    return true;
+}
+
+bool MultiBiomeLookaheadEngine::is_trajectory_biome(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_trajectory_engines.size())) {
+        return false;
+    }
+    return m_trajectory_engines[biome_id].is_valid();
+}
+
+float MultiBiomeLookaheadEngine::_ensemble_step_span(int biome_id, float dt, float max_dt) const {
+    // Cover the same time per step as the dense engine would: its legacy Euler
+    // mode advances max_dt per evolve(), the other integrators the full dt
+    const Ref<QuantumEvolutionEngine>& engine = _engine(biome_id);
+    if (engine->get_integrator() == QuantumEvolutionEngine::INTEGRATOR_EULER && max_dt > 0.0f) {
+        return max_dt;
+    }
+    return dt;
+}
+
+void MultiBiomeLookaheadEngine::clear_biomes() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    _clear_biomes();
+}
+
+void MultiBiomeLookaheadEngine::_clear_biomes() {
+    m_recorder.write_clear();
+    m_engines.clear();
+    m_history.clear();
+    m_sliced_state.inputs.clear();  // Finished sliced steps no longer match any biome
+    m_preparing.clear();  // Still-queued ones finish on their own; nothing waits on them
+    m_trajectory_engines.clear();
+    m_num_qubits.clear();
+    m_biome_active.clear();
+    m_biome_profile.clear();
+    m_metadata.clear();
+    m_icon_index.clear();
+    m_couplings.clear();
+    m_payload_versions.clear();
+    m_cross_couplings.clear();
+    m_watches.clear();
+    m_predicates.clear();
+    m_predicate_steps.clear();
+    m_predicate_biomes.clear();
+    m_lnns.clear();
+    m_lnn_hidden.clear();
+    m_lnn_kernels.clear();
+    m_lnn_scratch.clear();
+    m_lnn_stride.clear();
+    m_lnn_training.clear();
+    m_biome_priority.clear();
+    m_biome_budget_ms.clear();
+    m_biome_step_cost_us.clear();
+    m_cost_models.clear();
+    m_governor_float.clear();
+    m_biome_invalidation_rate.clear();
+    m_biome_invalidations_pending.clear();
+    m_biome_lod.clear();
+    m_steady.clear();
+    m_result_pool.clear();
+    m_resident_rho.clear();
+    m_batched_ops.clear();
+    m_focus_biome = -1;
+    for (int handle : m_force_layouts) {
+        m_force_engine->destroy_layout(handle);
+    }
+    m_force_layouts.clear();
+    m_biome_centers.clear();
+    m_rings.clear();
+}
+
+int MultiBiomeLookaheadEngine::get_biome_count() const {
+    return static_cast<int>(m_engines.size());
+}
+
+void MultiBiomeLookaheadEngine::set_biome_active(int biome_id, bool active) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_biome_active.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for set_biome_active ", biome_id);
+        return;
+    }
+    m_biome_active[biome_id] = active;
+}
+
+bool MultiBiomeLookaheadEngine::is_biome_active(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_biome_active.size())) {
+        return false;
+    }
+    return m_biome_active[biome_id];
+}
+
+void MultiBiomeLookaheadEngine::set_biome_metadata(int biome_id, const Dictionary& metadata) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_metadata.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for metadata ", biome_id);
+        return;
+    }
+    m_metadata[biome_id] = metadata;
+    m_recorder.write_metadata(biome_id, metadata);
+    _compile_icon_index(biome_id);
+    _touch_metadata(biome_id);
+    if (biome_id < static_cast<int>(m_engines.size())) {
+        m_couplings[biome_id] = _engine(biome_id)->compute_coupling_payload(metadata);
+        _touch_couplings(biome_id);
+    }
+}
+
+void MultiBiomeLookaheadEngine::set_biome_couplings(int biome_id, const Dictionary& couplings) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_couplings.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for couplings ", biome_id);
+        return;
+    }
+    m_couplings[biome_id] = couplings;
+    _touch_couplings(biome_id);
+}
+
+void MultiBiomeLookaheadEngine::acknowledge_payloads(const Dictionary& result) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    const PackedInt64Array metadata_versions = result.get("metadata_versions", PackedInt64Array());
+    const PackedInt64Array coupling_versions = result.get("coupling_versions", PackedInt64Array());
+    const int num_biomes = static_cast<int>(m_payload_versions.size());
+    for (int b = 0; b < std::min(num_biomes, static_cast<int>(metadata_versions.size())); b++) {
+        m_payload_versions[b].metadata_acked = std::max(m_payload_versions[b].metadata_acked, metadata_versions[b]);
+    }
+    for (int b = 0; b < std::min(num_biomes, static_cast<int>(coupling_versions.size())); b++) {
+        m_payload_versions[b].couplings_acked = std::max(m_payload_versions[b].couplings_acked, coupling_versions[b]);
+    }
+}
+
+void MultiBiomeLookaheadEngine::_append_payloads(int biome_id, Array& metadata, Array& couplings,
+                                                 PackedInt64Array& metadata_versions,
+                                                 PackedInt64Array& coupling_versions) const {
+    if (biome_id >= static_cast<int>(m_payload_versions.size())) {
+        metadata.push_back(Dictionary());
+        couplings.push_back(Dictionary());
+        metadata_versions.push_back(0);
+        coupling_versions.push_back(0);
+        return;
+    }
+    const PayloadVersion& version = m_payload_versions[biome_id];
+    metadata.push_back(version.metadata > version.metadata_acked ? m_metadata[biome_id] : Dictionary());
+    couplings.push_back(version.couplings > version.couplings_acked ? m_couplings[biome_id] : Dictionary());
+    metadata_versions.push_back(version.metadata);
+    coupling_versions.push_back(version.couplings);
+}
+
+Dictionary MultiBiomeLookaheadEngine::evolve_all_lookahead(
+    const Array& biome_rhos, int steps, float dt, float max_dt, int observables) {
+    std::vector<PackedFloat64Array> rhos(biome_rhos.size());
+    for (int biome_id = 0; biome_id < biome_rhos.size(); biome_id++) {
+        rhos[biome_id] = biome_rhos[biome_id];
+    }
+    std::vector<WatchEvent> watch_events;
+    Dictionary result = _run_lookahead(rhos, steps, dt, max_dt, false, &watch_events, nullptr, observables);
+    _emit_watch_events(watch_events);
+    return result;
+}
+
+Dictionary MultiBiomeLookaheadEngine::evolve_all_lookahead_packed(
+    const Array& biome_rhos, int steps, float dt, float max_dt, int observables) {
+    std::vector<PackedFloat64Array> rhos(biome_rhos.size());
+    for (int biome_id = 0; biome_id < biome_rhos.size(); biome_id++) {
+        rhos[biome_id] = biome_rhos[biome_id];
+    }
+    std::vector<WatchEvent> watch_events;
+    Dictionary result = _run_lookahead(rhos, steps, dt, max_dt, true, &watch_events, nullptr, observables);
+    _emit_watch_events(watch_events);
+    return result;
+}
+
+void MultiBiomeLookaheadEngine::release_result(Dictionary result) {
+    result.clear();
+}
+
+double* MultiBiomeLookaheadEngine::_take_result_buffer(std::vector<PackedFloat64Array>& slots, int step,
+                                                       int64_t size, PackedFloat64Array& buf) {
+    buf = PackedFloat64Array();
+    if (step < static_cast<int>(slots.size())) {
+        buf = std::move(slots[step]);
+        slots[step] = PackedFloat64Array();
+    }
+    const double* before = (buf.size() == size) ? buf.ptr() : nullptr;
+    buf.resize(size);
+    double* data = buf.ptrw();
+    if (before != nullptr && data == before) {
+        m_result_pool_reused.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        m_result_pool_fresh.fetch_add(1, std::memory_order_relaxed);
+        NATIVE_ALLOC_PACKED(buf);
+    }
+    return data;
+}
+
+void MultiBiomeLookaheadEngine::_keep_result_buffer(std::vector<PackedFloat64Array>& slots, int step,
+                                                    const PackedFloat64Array& buf) {
+    if (step >= static_cast<int>(slots.size())) {
+        slots.resize(step + 1);
+    }
+    slots[step] = buf;
+}
+
+PackedByteArray MultiBiomeLookaheadEngine::evolve_all_lookahead_binary(
+    const Array& biome_rhos, int steps, float dt, float max_dt) {
+    std::vector<PackedFloat64Array> rhos(biome_rhos.size());
+    for (int biome_id = 0; biome_id < biome_rhos.size(); biome_id++) {
+        rhos[biome_id] = biome_rhos[biome_id];
+    }
+    std::vector<WatchEvent> watch_events;
+    PackedByteArray packet;
+    _run_lookahead(rhos, steps, dt, max_dt, true, &watch_events, &packet);
+    _emit_watch_events(watch_events);
+    return packet;
+}
+
+int MultiBiomeLookaheadEngine::add_biome_coupling(int source_biome, int source_qubit, int target_biome,
+                                                  int target_qubit, double rate, int kind) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    const int num_biomes = static_cast<int>(m_engines.size());
+    if (source_biome < 0 || source_biome >= num_biomes || target_biome < 0 || target_biome >= num_biomes ||
+        source_biome == target_biome) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: add_biome_coupling needs two distinct biomes (",
+                                       source_biome, ", ", target_biome, ")");
+        return -1;
+    }
+    if (source_qubit < 0 || source_qubit >= m_num_qubits[source_biome] || target_qubit < 0 ||
+        target_qubit >= m_num_qubits[target_biome]) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: add_biome_coupling qubit out of range");
+        return -1;
+    }
+    if (kind != COUPLING_POPULATION && kind != COUPLING_AMPLITUDE) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Unknown coupling kind ", kind);
+        return -1;
+    }
+    if (!(rate >= 0.0)) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Coupling rate must be >= 0");
+        return -1;
+    }
+    CrossBiomeCoupling coupling;
+    coupling.source_biome = source_biome;
+    coupling.source_qubit = source_qubit;
+    coupling.target_biome = target_biome;
+    coupling.target_qubit = target_qubit;
+    coupling.rate = rate;
+    coupling.kind = kind;
+    m_cross_couplings.push_back(coupling);
+    return static_cast<int>(m_cross_couplings.size()) - 1;
+}
+
+void MultiBiomeLookaheadEngine::clear_biome_couplings() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_cross_couplings.clear();
+}
+
+int MultiBiomeLookaheadEngine::get_biome_coupling_count() const {
+    return static_cast<int>(m_cross_couplings.size());
+}
+
+void MultiBiomeLookaheadEngine::_apply_cross_couplings(std::vector<PackedFloat64Array>& rhos, double dt) const {
+    typedef QuantumEvolutionEngine::RhoMatrix RhoMatrix;
+    const int num_biomes = static_cast<int>(rhos.size());
+    auto holds_state = [&](int biome_id) {
+        if (biome_id >= num_biomes) {
+            return false;
+        }
+        const int64_t dim = _engine(biome_id)->get_dimension();
+        return rhos[biome_id].size() == dim * dim * 2;
+    };
+
+    // Reduce every biome an edge touches first: edges read the pre-coupling
+    // states, writes below never feed into another edge
+    std::vector<lindblad::ReducedStates> states(num_biomes);
+    std::vector<char> reduced(num_biomes, 0);
+    for (const CrossBiomeCoupling& c : m_cross_couplings) {
+        for (int biome_id : {c.source_biome, c.target_biome}) {
+            if (!holds_state(biome_id) || reduced[biome_id]) {
+                continue;
+            }
+            const int dim = _engine(biome_id)->get_dimension();
+            Eigen::Map<const RhoMatrix> rho(reinterpret_cast<const std::complex<double>*>(rhos[biome_id].ptr()),
+                                            dim, dim);
+            lindblad::compute_reduced_states(rho, m_num_qubits[biome_id], false, states[biome_id]);
+            reduced[biome_id] = 1;
+        }
+    }
+
+    const std::complex<double> i_unit(0.0, 1.0);
+    RhoMatrix work, branch, acc;
+    Eigen::Matrix2cd kraus[2];
+    auto map_rho = [&](int biome_id) {
+        const int dim = _engine(biome_id)->get_dimension();
+        return Eigen::Map<RhoMatrix>(reinterpret_cast<std::complex<double>*>(rhos[biome_id].ptrw()), dim, dim);
+    };
+
+    for (const CrossBiomeCoupling& c : m_cross_couplings) {
+        if (c.rate <= 0.0 || !reduced[c.source_biome] || !reduced[c.target_biome]) {
+            continue;
+        }
+        const Eigen::Matrix2cd& source = states[c.source_biome].singles[c.source_qubit];
+        const Eigen::Matrix2cd& target = states[c.target_biome].singles[c.target_qubit];
+
+        if (c.kind == COUPLING_POPULATION) {
+            const double gamma = 1.0 - std::exp(-c.rate * dt);
+            const double room = target(0, 0).real();
+            const double moved = std::min(gamma * source(1, 1).real(), room);
+            if (moved <= 0.0) {
+                continue;
+            }
+            // Source: partial amplitude damping releasing exactly `moved`
+            const double released = moved / source(1, 1).real();
+            kraus[0] << 1.0, 0.0, 0.0, std::sqrt(1.0 - released);
+            kraus[1] << 0.0, std::sqrt(released), 0.0, 0.0;
+            apply_qubit_channel(map_rho(c.source_biome), c.source_qubit, kraus, 2, work, branch, acc);
+            // Target: the mirrored excitation channel absorbing it
+            const double absorbed = std::min(1.0, moved / room);
+            kraus[0] << std::sqrt(1.0 - absorbed), 0.0, 0.0, 1.0;
+            kraus[1] << 0.0, 0.0, std::sqrt(absorbed), 0.0;
+            apply_qubit_channel(map_rho(c.target_biome), c.target_qubit, kraus, 2, work, branch, acc);
+        } else {
+            // ρ01 = (x - iy)/2 of the source drives the target's σx/σy
+            const double x = 2.0 * source(0, 1).real();
+            const double y = -2.0 * source(0, 1).imag();
+            const double transverse = std::hypot(x, y);
+            if (transverse <= 0.0) {
+                continue;
+            }
+            const double phi = 0.5 * c.rate * dt * transverse;
+            const std::complex<double> axis(x / transverse, -y / transverse);  // n_x - i n_y
+            kraus[0] << std::cos(phi), -i_unit * std::sin(phi) * axis,
+                        -i_unit * std::sin(phi) * std::conj(axis), std::cos(phi);
+            apply_qubit_channel(map_rho(c.target_biome), c.target_qubit, kraus, 1, work, branch, acc);
+        }
+    }
+}
+
+int MultiBiomeLookaheadEngine::add_watch(int biome_id, int observable, int index, int comparator,
+                                         double threshold) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for add_watch ", biome_id);
+        return -1;
+    }
+    if (observable < WATCH_POPULATION || observable > WATCH_MI || comparator < WATCH_ABOVE ||
+        comparator > WATCH_BELOW || index < 0) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: add_watch needs a WatchObservable, ",
+                                       "a WatchComparator and index >= 0");
+        return -1;
+    }
+    const int num_qubits = m_num_qubits[biome_id];
+    const int limit = observable == WATCH_POPULATION ? num_qubits
+                      : observable == WATCH_MI      ? num_qubits * (num_qubits - 1) / 2
+                                                    : 1;
+    if (observable != WATCH_PURITY && index >= limit) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: add_watch index ", index,
+                                       " out of range for biome ", biome_id);
+        return -1;
+    }
+    Watch watch;
+    watch.biome_id = biome_id;
+    watch.observable = observable;
+    watch.index = index;
+    watch.comparator = comparator;
+    watch.threshold = threshold;
+    m_watches.push_back(watch);
+    return static_cast<int>(m_watches.size()) - 1;
+}
+
+void MultiBiomeLookaheadEngine::remove_watch(int watch_id) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (watch_id < 0 || watch_id >= static_cast<int>(m_watches.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid watch_id ", watch_id);
+        return;
+    }
+    m_watches[watch_id].active = false;
+}
+
+void MultiBiomeLookaheadEngine::clear_watches() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_watches.clear();
+}
+
+int MultiBiomeLookaheadEngine::get_watch_count() const {
+    int count = 0;
+    for (const Watch& watch : m_watches) {
+        count += watch.active ? 1 : 0;
+    }
+    return count;
+}
+
+void MultiBiomeLookaheadEngine::_evaluate_watches(const std::vector<BiomeStepResult>& biome_results,
+                                                  std::vector<WatchEvent>& events) {
+    for (int watch_id = 0; watch_id < static_cast<int>(m_watches.size()); watch_id++) {
+        Watch& watch = m_watches[watch_id];
+        if (!watch.active || watch.biome_id >= static_cast<int>(biome_results.size())) {
+            continue;
+        }
+        const BiomeStepResult& r = biome_results[watch.biome_id];
+        int fired_step = -1;
+        double fired_value = 0.0;
+        bool tested = false;
+        for (int step = 0; step < static_cast<int>(r.steps.size()) && fired_step < 0; step++) {
+            double value = 0.0;
+            if (watch.observable == WATCH_POPULATION) {
+                if (step >= static_cast<int>(r.bloch_steps.size()) ||
+                    r.bloch_steps[step].size() < 8 * (watch.index + 1)) {
+                    continue;
+                }
+                value = r.bloch_steps[step][8 * watch.index + 1];
+            } else if (watch.observable == WATCH_PURITY) {
+                if (step >= static_cast<int>(r.purity_steps.size())) {
+                    continue;
+                }
+                value = r.purity_steps[step];
+            } else {
+                if (step >= static_cast<int>(r.mi_steps.size()) || r.mi_steps[step].size() <= watch.index) {
+                    continue;
+                }
+                value = r.mi_steps[step][watch.index];
+            }
+            tested = true;
+            const bool hit = watch.comparator == WATCH_ABOVE ? value > watch.threshold : value < watch.threshold;
+            if (hit) {
+                fired_step = step;
+                fired_value = value;
+            }
+        }
+        if (fired_step >= 0) {
+            if (watch.armed) {
+                events.push_back({watch_id, watch.biome_id, fired_step, fired_value});
+            }
+            watch.armed = false;
+        } else if (tested) {
+            watch.armed = true;
+        }
+    }
+}
+
+void MultiBiomeLookaheadEngine::_emit_watch_events(const std::vector<WatchEvent>& events) {
+    for (const WatchEvent& event : events) {
+        emit_signal("watch_triggered", event.watch_id, event.biome_id, event.step, event.value);
+    }
+}
+
+// ============================================================================
+// PREDICATES
+// ============================================================================
+
+// Grammar, loosest first:
+//   or      := and (("||" | "or") and)*
+//   and     := not (("&&" | "and") not)*
+//   not     := ("!" | "not") not | compare
+//   compare := sum (("<" | "<=" | ">" | ">=") sum)?
+//   sum     := product (("+" | "-") product)*
+//   product := unary (("*" | "/") unary)*
+//   unary   := "-" unary | primary
+//   primary := number | "(" or ")" | "purity" | "p(" emoji ")" | "pop(" int ")" | "mi(" int "," int ")"
+struct MultiBiomeLookaheadEngine::PredicateParser {
+    const std::string& text;
+    Predicate& out;
+    size_t pos = 0;
+    int depth = 0;
+    int max_depth = 0;
+    String error;
+
+    PredicateParser(const std::string& p_text, Predicate& p_out) : text(p_text), out(p_out) {}
+
+    bool fail(const String& message) {
+        if (error.is_empty()) {
+            error = message + String(" at byte ") + String::num_int64(static_cast<int64_t>(pos));
+        }
+        return false;
+    }
+    void emit(int code, int a = 0, int b = 0, double value = 0.0) {
+        if (code <= PRED_MI) {
+            depth++;
+        } else if (code != PRED_NEG && code != PRED_NOT) {
+            depth--;
+        }
+        max_depth = std::max(max_depth, depth);
+        PredicateOp op;
+        op.code = code;
+        op.a = a;
+        op.b = b;
+        op.value = value;
+        out.program.push_back(op);
+    }
+    void skip_space() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+            pos++;
+        }
+    }
+    static bool is_word_char(char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    }
+    bool accept(const char* token) {
+        skip_space();
+        const size_t length = std::strlen(token);
+        if (text.compare(pos, length, token) != 0) {
+            return false;
+        }
+        // Whole words only ("order" is not "or" + "der")
+        if (is_word_char(token[0]) && pos + length < text.size() && is_word_char(text[pos + length])) {
+            return false;
+        }
+        pos += length;
+        return true;
+    }
+    bool expect(const char* token) {
+        return accept(token) || fail(String("expected '") + String(token) + String("'"));
+    }
+    bool parse_int(int& value) {
+        skip_space();
+        const size_t start = pos;
+        int64_t v = 0;
+        while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos])) && v < (1 << 20)) {
+            v = v * 10 + (text[pos] - '0');
+            pos++;
+        }
+        value = static_cast<int>(v);
+        return pos > start || fail("expected an index");
+    }
+
+    bool parse_or() {
+        if (!parse_and()) {
+            return false;
+        }
+        while (accept("||") || accept("or")) {
+            if (!parse_and()) {
+                return false;
+            }
+            emit(PRED_OR);
+        }
+        return true;
+    }
+    bool parse_and() {
+        if (!parse_not()) {
+            return false;
+        }
+        while (accept("&&") || accept("and")) {
+            if (!parse_not()) {
+                return false;
+            }
+            emit(PRED_AND);
+        }
+        return true;
+    }
+    bool parse_not() {
+        if (accept("!") || accept("not")) {
+            if (!parse_not()) {
+                return false;
+            }
+            emit(PRED_NOT);
+            return true;
+        }
+        return parse_compare();
+    }
+    bool parse_compare() {
+        if (!parse_sum()) {
+            return false;
+        }
+        int code = -1;
+        if (accept("<=")) {
+            code = PRED_LE;
+        } else if (accept(">=")) {
+            code = PRED_GE;
+        } else if (accept("<")) {
+            code = PRED_LT;
+        } else if (accept(">")) {
+            code = PRED_GT;
+        }
+        if (code < 0) {
+            return true;
+        }
+        if (!parse_sum()) {
+            return false;
+        }
+        emit(code);
+        return true;
+    }
+    bool parse_sum() {
+        if (!parse_product()) {
+            return false;
+        }
+        while (true) {
+            const int code = accept("+") ? PRED_ADD : accept("-") ? PRED_SUB : -1;
+            if (code < 0) {
+                return true;
+            }
+            if (!parse_product()) {
+                return false;
+            }
+            emit(code);
+        }
+    }
+    bool parse_product() {
+        if (!parse_unary()) {
+            return false;
+        }
+        while (true) {
+            const int code = accept("*") ? PRED_MUL : accept("/") ? PRED_DIV : -1;
+            if (code < 0) {
+                return true;
+            }
+            if (!parse_unary()) {
+                return false;
+            }
+            emit(code);
+        }
+    }
+    bool parse_unary() {
+        if (accept("-")) {
+            if (!parse_unary()) {
+                return false;
+            }
+            emit(PRED_NEG);
+            return true;
+        }
+        return parse_primary();
+    }
+    bool parse_primary() {
+        skip_space();
+        if (pos >= text.size()) {
+            return fail("unexpected end");
+        }
+        if (accept("(")) {
+            return parse_or() && expect(")");
+        }
+        const char c = text[pos];
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            const char* start = text.c_str() + pos;
+            char* end = nullptr;
+            const double value = std::strtod(start, &end);
+            if (end == start) {
+                return fail("bad number");
+            }
+            pos += static_cast<size_t>(end - start);
+            emit(PRED_CONST, 0, 0, value);
+            return true;
+        }
+        if (accept("purity")) {
+            emit(PRED_PURITY);
+            out.needs |= PRED_NEEDS_PURITY;
+            return true;
+        }
+        if (accept("pop")) {
+            int qubit = 0;
+            if (!expect("(") || !parse_int(qubit) || !expect(")")) {
+                return false;
+            }
+            emit(PRED_POP, qubit);
+            out.needs |= PRED_NEEDS_BLOCH;
+            return true;
+        }
+        if (accept("mi")) {
+            int a = 0;
+            int b = 0;
+            if (!expect("(") || !parse_int(a) || !expect(",") || !parse_int(b) || !expect(")")) {
+                return false;
+            }
+            if (a == b) {
+                return fail("mi needs two different qubits");
+            }
+            emit(PRED_MI, std::min(a, b), std::max(a, b));
+            out.needs |= PRED_NEEDS_MI;
+            return true;
+        }
+        if (accept("p")) {
+            if (!expect("(")) {
+                return false;
+            }
+            // Raw text up to ')': an emoji (optionally quoted) or a registry id
+            const size_t close = text.find(')', pos);
+            if (close == std::string::npos) {
+                return fail("expected ')'");
+            }
+            std::string name = text.substr(pos, close - pos);
+            pos = close + 1;
+            const size_t first = name.find_first_not_of(" \t\"'");
+            const size_t last = name.find_last_not_of(" \t\"'");
+            name = first == std::string::npos ? std::string() : name.substr(first, last - first + 1);
+            if (name.empty()) {
+                return fail("p() needs an emoji");
+            }
+            const bool numeric = name.find_first_not_of("0123456789") == std::string::npos;
+            const int id = numeric ? std::atoi(name.c_str()) : EmojiRegistry::intern(String::utf8(name.c_str()));
+            emit(PRED_EMOJI, id);
+            out.needs |= PRED_NEEDS_BLOCH;
+            return true;
+        }
+        return fail("unknown term");
+    }
+
+    bool parse() {
+        if (!parse_or()) {
+            return false;
+        }
+        skip_space();
+        if (pos != text.size()) {
+            return fail("unexpected text");
+        }
+        if (max_depth > PREDICATE_MAX_DEPTH) {
+            return fail("expression nests too deeply");
+        }
+        return true;
+    }
+};
+
+int MultiBiomeLookaheadEngine::add_predicate(const String& expression, int biome_id) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < -1 || biome_id >= static_cast<int>(m_engines.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for add_predicate ", biome_id);
+        return -1;
+    }
+    const CharString utf8 = expression.utf8();
+    const std::string text(utf8.get_data(), static_cast<size_t>(utf8.length()));
+    Predicate predicate;
+    predicate.biome_id = biome_id;
+    PredicateParser parser(text, predicate);
+    if (!parser.parse()) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: add_predicate \"", expression, "\": ",
+                                       parser.error);
+        return -1;
+    }
+    m_predicates.push_back(std::move(predicate));
+    m_predicate_steps.push_back(-1);
+    m_predicate_biomes.push_back(-1);
+    return static_cast<int>(m_predicates.size()) - 1;
+}
+
+void MultiBiomeLookaheadEngine::remove_predicate(int predicate_id) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (predicate_id < 0 || predicate_id >= static_cast<int>(m_predicates.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid predicate_id ", predicate_id);
+        return;
+    }
+    m_predicates[predicate_id].active = false;
+    m_predicates[predicate_id].program.clear();
+    m_predicate_steps.set(predicate_id, -1);
+    m_predicate_biomes.set(predicate_id, -1);
+}
+
+void MultiBiomeLookaheadEngine::clear_predicates() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_predicates.clear();
+    m_predicate_steps.clear();
+    m_predicate_biomes.clear();
+}
+
+int MultiBiomeLookaheadEngine::get_predicate_count() const {
+    int count = 0;
+    for (const Predicate& predicate : m_predicates) {
+        count += predicate.active ? 1 : 0;
+    }
+    return count;
+}
+
+Dictionary MultiBiomeLookaheadEngine::get_predicate_results() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    Dictionary results;
+    results["steps"] = m_predicate_steps;
+    results["biomes"] = m_predicate_biomes;
+    return results;
+}
+
+void MultiBiomeLookaheadEngine::_evaluate_predicates(const std::vector<BiomeStepResult>& biome_results) {
+    const int num_biomes = static_cast<int>(biome_results.size());
+    for (int predicate_id = 0; predicate_id < static_cast<int>(m_predicates.size()); predicate_id++) {
+        const Predicate& predicate = m_predicates[predicate_id];
+        int best_step = -1;
+        int best_biome = -1;
+        if (predicate.active) {
+            const int first = predicate.biome_id < 0 ? 0 : predicate.biome_id;
+            const int last = predicate.biome_id < 0 ? num_biomes : std::min(predicate.biome_id + 1, num_biomes);
+            for (int biome_id = first; biome_id < last && best_step != 0; biome_id++) {
+                // Only an earlier step can beat the best so far
+                const int limit = best_step < 0 ? static_cast<int>(biome_results[biome_id].steps.size()) : best_step;
+                const int step = _first_predicate_step(predicate, biome_id, biome_results[biome_id], limit);
+                if (step >= 0) {
+                    best_step = step;
+                    best_biome = biome_id;
+                }
+            }
+        }
+        m_predicate_steps.set(predicate_id, best_step);
+        m_predicate_biomes.set(predicate_id, best_biome);
+    }
+}
+
+int MultiBiomeLookaheadEngine::_first_predicate_step(const Predicate& predicate, int biome_id,
+                                                     const BiomeStepResult& r, int limit) {
+    const int num_qubits = m_num_qubits[biome_id];
+    const int num_pairs = num_qubits * (num_qubits - 1) / 2;
+
+    // Resolve the terms for this biome once, outside the step loop
+    m_predicate_bound = predicate.program;
+    m_predicate_offsets.clear();
+    const IconIndex* icons = biome_id < static_cast<int>(m_icon_index.size()) && m_icon_index[biome_id].valid
+                                 ? &m_icon_index[biome_id]
+                                 : nullptr;
+    for (PredicateOp& op : m_predicate_bound) {
+        if (op.code == PRED_EMOJI) {
+            const int emoji_id = op.a;
+            op.a = static_cast<int>(m_predicate_offsets.size());
+            for (size_t term = 0; icons && term < icons->term_emoji.size(); term++) {
+                if (icons->ids[icons->term_emoji[term]] == emoji_id) {
+                    m_predicate_offsets.push_back(icons->term_offset[term]);
+                }
+            }
+            op.b = static_cast<int>(m_predicate_offsets.size());
+        } else if (op.code == PRED_POP) {
+            if (op.a >= num_qubits) {
+                return -1;
+            }
+            op.a = 8 * op.a + 1;
+        } else if (op.code == PRED_MI) {
+            if (op.b >= num_qubits) {
+                return -1;
+            }
+            op.a = op.a * num_qubits - op.a * (op.a + 1) / 2 + (op.b - op.a - 1);
+        }
+    }
+
+    const int* offsets = m_predicate_offsets.data();
+    double stack[PREDICATE_MAX_DEPTH];
+    limit = std::min(limit, static_cast<int>(r.steps.size()));
+    for (int step = 0; step < limit; step++) {
+        const double* bloch = nullptr;
+        const double* mi = nullptr;
+        if (predicate.needs & PRED_NEEDS_BLOCH) {
+            if (step >= static_cast<int>(r.bloch_steps.size()) || r.bloch_steps[step].size() < 8 * num_qubits) {
+                continue;
+            }
+            bloch = r.bloch_steps[step].ptr();
+        }
+        if ((predicate.needs & PRED_NEEDS_PURITY) && step >= static_cast<int>(r.purity_steps.size())) {
+            continue;
+        }
+        if (predicate.needs & PRED_NEEDS_MI) {
+            if (step >= static_cast<int>(r.mi_steps.size()) || r.mi_steps[step].size() < num_pairs) {
+                continue;
+            }
+            mi = r.mi_steps[step].ptr();
+        }
+
+        int top = 0;
+        for (const PredicateOp& op : m_predicate_bound) {
+            switch (op.code) {
+                case PRED_CONST:
+                    stack[top++] = op.value;
+                    break;
+                case PRED_EMOJI: {
+                    double prob = 0.0;
+                    for (int i = op.a; i < op.b; i++) {
+                        prob += bloch[offsets[i]];
+                    }
+                    stack[top++] = prob;
+                    break;
+                }
+                case PRED_POP:
+                    stack[top++] = bloch[op.a];
+                    break;
+                case PRED_PURITY:
+                    stack[top++] = r.purity_steps[step];
+                    break;
+                case PRED_MI:
+                    stack[top++] = mi[op.a];
+                    break;
+                case PRED_NEG:
+                    stack[top - 1] = -stack[top - 1];
+                    break;
+                case PRED_NOT:
+                    stack[top - 1] = stack[top - 1] == 0.0 ? 1.0 : 0.0;
+                    break;
+                default: {
+                    const double rhs = stack[--top];
+                    double& lhs = stack[top - 1];
+                    switch (op.code) {
+                        case PRED_ADD: lhs += rhs; break;
+                        case PRED_SUB: lhs -= rhs; break;
+                        case PRED_MUL: lhs *= rhs; break;
+                        case PRED_DIV: lhs /= rhs; break;
+                        case PRED_LT: lhs = lhs < rhs ? 1.0 : 0.0; break;
+                        case PRED_LE: lhs = lhs <= rhs ? 1.0 : 0.0; break;
+                        case PRED_GT: lhs = lhs > rhs ? 1.0 : 0.0; break;
+                        case PRED_GE: lhs = lhs >= rhs ? 1.0 : 0.0; break;
+                        case PRED_AND: lhs = (lhs != 0.0 && rhs != 0.0) ? 1.0 : 0.0; break;
+                        case PRED_OR: lhs = (lhs != 0.0 || rhs != 0.0) ? 1.0 : 0.0; break;
+                        default: break;
+                    }
+                    break;
+                }
+            }
+        }
+        if (top == 1 && stack[0] != 0.0) {
+            return step;
+        }
+    }
+    return -1;
+}
+
+Dictionary MultiBiomeLookaheadEngine::evolve_coupled_lookahead(
+    const Array& biome_rhos, int steps, float dt, float max_dt) {
+    std::unique_lock<std::mutex> evolve_lock(m_evolve_mutex);
+    ScopedProfile profile(m_profile_lookahead);
+    NATIVE_TRACE_ZONE("coupled_lookahead");
+
+    int num_biomes = static_cast<int>(biome_rhos.size());
+    if (num_biomes > static_cast<int>(m_engines.size())) {
+        UtilityFunctions::push_warning(
+            "MultiBiomeLookaheadEngine: More rhos than registered biomes (",
+            num_biomes, " vs ", m_engines.size(), ")");
+        num_biomes = static_cast<int>(m_engines.size());
+    }
+    std::vector<PackedFloat64Array> current(num_biomes);
+    for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+        current[biome_id] = biome_rhos[biome_id];
+    }
+
+    m_frame_results.resize(num_biomes);
+    std::vector<BiomeStepResult>& biome_results = m_frame_results;
+    std::vector<int> active;
+    for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+        biome_results[biome_id].clear();
+        if (_should_evolve(biome_id, current[biome_id])) {
+            active.push_back(biome_id);
+        }
+    }
+    const int num_active = static_cast<int>(active.size());
+    std::vector<CostSnapshot> cost_before(num_active);
+    for (int i = 0; i < num_active; i++) {
+        cost_before[i] = _cost_snapshot(active[i]);
+    }
+
+    // Lockstep: one step per biome (independent tasks), then the edges
+    for (int step = 0; step < steps; step++) {
+        if (step > 0 && !m_cross_couplings.empty()) {
+            NATIVE_TRACE_ZONE("couple");
+            _apply_cross_couplings(current, dt);
+        }
+        const bool keep_rho_tail = step + 1 == steps;
+        auto biome_range = [&](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                const int biome_id = active[i];
+                BiomeStepResult single = _evolve_biome_steps(biome_id, current[biome_id], 1, dt, max_dt);
+                if (single.steps.empty()) {
+                    continue;
+                }
+                BiomeStepResult& r = biome_results[biome_id];
+                current[biome_id] = single.steps[0];
+                r.steps.push_back(keep_rho_tail || !is_large_biome(biome_id) ? single.steps[0]
+                                                                             : PackedFloat64Array());
+                r.mi_steps.push_back(single.mi_steps.empty() ? PackedFloat64Array() : single.mi_steps[0]);
+                if (!single.bloch_steps.empty()) r.bloch_steps.push_back(single.bloch_steps[0]);
+                if (!single.purity_steps.empty()) r.purity_steps.push_back(single.purity_steps[0]);
+                if (!single.position_steps.empty()) r.position_steps.push_back(single.position_steps[0]);
+                if (!single.velocity_steps.empty()) r.velocity_steps.push_back(single.velocity_steps[0]);
+                r.icon_map = single.icon_map;
+            }
+        };
+        if (m_parallel_biomes) {
+            NativeThreadPool::shared().parallel_for(0, num_active, num_active, biome_range);
+        } else {
+            biome_range(0, num_active);
+        }
+        _repel_across_biomes(dt);
+    }
+    for (int i = 0; i < num_active; i++) {
+        _update_cost_model(active[i], cost_before[i]);
+    }
+
+    std::vector<WatchEvent> watch_events;
+    _evaluate_watches(biome_results, watch_events);
+    _evaluate_predicates(biome_results);
+    Dictionary packed_result;
+    {
+        ScopedProfile marshal_profile(m_profile_marshal);
+        for (BiomeStepResult& r : biome_results) {
+            _apply_rho_storage(r);
+        }
+        _publish_lookahead_snapshots(biome_results, steps);
+        packed_result = _pack_results(biome_results, steps);
+        for (BiomeStepResult& r : biome_results) {
+            r.clear();
+        }
+    }
+    evolve_lock.unlock();
+    _emit_watch_events(watch_events);
+    return packed_result;
+}
+
+Dictionary MultiBiomeLookaheadEngine::_run_lookahead(
+    const std::vector<PackedFloat64Array>& rhos, int steps, float dt, float max_dt, bool packed,
+    std::vector<WatchEvent>* watch_events, PackedByteArray* binary, int observables,
+    const std::atomic<bool>* cancel) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    // Only the async worker passes a token; cleared on every return so synchronous runs never see it
+    struct StepCancelScope {
+        const std::atomic<bool>*& slot;
+        ~StepCancelScope() { slot = nullptr; }
+    } step_cancel_scope{m_step_cancel};
+    m_step_cancel = cancel;
+    ScopedProfile profile(m_profile_lookahead);
+    NATIVE_TRACE_ZONE("lookahead");
+    const auto governor_start = std::chrono::steady_clock::now();
+    TelemetryFrame telemetry(m_telemetry, governor_start);
+
+    // No rhos passed: run from the engine-resident states (copy-on-write shares)
+    const std::vector<PackedFloat64Array>& input = rhos.empty() ? m_resident_rho : rhos;
+    int num_biomes = static_cast<int>(input.size());
+
+    // Validate input size matches registered biomes
+    if (num_biomes > static_cast<int>(m_engines.size())) {
+        UtilityFunctions::push_warning(
+            "MultiBiomeLookaheadEngine: More rhos than registered biomes (",
+            num_biomes, " vs ", m_engines.size(), ")");
+        num_biomes = static_cast<int>(m_engines.size());
+    }
+    m_recorder.write_lookahead(input, num_biomes, steps, dt, max_dt, packed);
+    if (m_governor_level >= GOVERNOR_FEWER_STEPS && steps > 1) {
+        steps = (steps + 1) / 2;
+    }
+    telemetry.record.steps = steps;
+    telemetry.record.biomes = num_biomes;
+
+    // Biomes are independent until assembly: each writes only its own engine,
+    // LNN, force-graph slots and result entry, so they evolve as separate
+    // tasks on the shared pool (dynamic claiming, one biome per chunk)
+    // Equal-dimension groups get their dense trajectories from one batched
+    // kernel first; observables and forces then run per biome as usual
+    std::vector<PackedFloat64Array> batched_frames;
+    if (m_batch_equal_dims) {
+        ScopedProfile batched_profile(m_profile_batched);
+        NATIVE_TRACE_ZONE("batched_evolve");
+        const auto batched_start = telemetry.active() ? std::chrono::steady_clock::now() : governor_start;
+        _evolve_batched_groups(input, num_biomes, steps, dt, max_dt, batched_frames);
+        if (telemetry.active()) {
+            telemetry.record.batched_ms = ms_between(batched_start, std::chrono::steady_clock::now());
+        }
+    }
+
+    // Native scratch for this call comes from the frame arena; result slots
+    // are reused from the previous call
+    m_frame_arena.reset();
+    m_frame_results.resize(num_biomes);
+    std::vector<BiomeStepResult>& biome_results = m_frame_results;
+    // Drop the Godot payloads once assembled (the caller holds the shares)
+    auto release_results = [&]() {
+        for (BiomeStepResult& r : biome_results) {
+            r.clear();
+        }
+    };
+
+    // Only active biomes become tasks; inactive ones keep an empty result
+    int* active = m_frame_arena.alloc<int>(std::max(num_biomes, 1));
+    int num_active = 0;
+    for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+        biome_results[biome_id].clear();
+        if (_should_evolve(biome_id, input[biome_id])) {
+            active[num_active++] = biome_id;
+        }
+    }
+    std::vector<CostSnapshot> cost_before(num_active);
+    for (int i = 0; i < num_active; i++) {
+        cost_before[i] = _cost_snapshot(active[i]);
+    }
+
+    auto biome_range = [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            const int biome_id = active[i];
+            const bool batched = !batched_frames.empty() && !batched_frames[biome_id].is_empty();
+            _evolve_biome_steps_into(biome_results[biome_id], biome_id, input[biome_id], steps, dt, max_dt, true,
+                                     batched ? &batched_frames[biome_id] : nullptr, &m_frame_arena, observables);
+        }
+    };
+    if (m_use_task_graph && m_parallel_biomes) {
+        // Staged biomes contribute per-step nodes; the rest run whole (as do
+        // all of them under a reduced observables mask, which only the
+        // whole-biome path honours)
+        NativeTaskGraph graph;
+        std::vector<StagedBiome> staged(num_active);
+        for (int i = 0; i < num_active; i++) {
+            const int biome_id = active[i];
+            const bool batched = !batched_frames.empty() && !batched_frames[biome_id].is_empty();
+            _check_stationary(biome_id, input[biome_id]);
+            const int64_t dim = _engine(biome_id)->get_dimension();
+            const bool stageable = !batched && steps > 0 && observables == LOOKAHEAD_ALL &&
+                                   m_trajectory_engines[biome_id].is_null() &&
+                                   !is_large_biome(biome_id) && get_effective_biome_lod(biome_id) != LOD_FROZEN &&
+                                   input[biome_id].size() == dim * dim * 2;
+            if (stageable) {
+                staged[i].biome_id = biome_id;
+                _add_staged_biome(graph, staged[i], biome_results[biome_id], input[biome_id], steps, dt, max_dt, true);
+            } else {
+                graph.add([&biome_range, i]() { biome_range(i, i + 1); });
+            }
+        }
+        graph.run(NativeThreadPool::shared());
+    } else if (m_parallel_biomes) {
+        NativeThreadPool::shared().parallel_for(0, num_active, num_active, biome_range);
+    } else {
+        biome_range(0, num_active);
+    }
+    _repel_across_biomes(dt);
+    for (int i = 0; i < num_active; i++) {
+        _update_cost_model(active[i], cost_before[i]);
+    }
+    if (watch_events) {
+        _evaluate_watches(biome_results, *watch_events);
+        _evaluate_predicates(biome_results);
+    }
+    // The governor's levers only shorten evolution, so marshalling isn't timed
+    const double evolve_ms = ms_between(governor_start, std::chrono::steady_clock::now());
+    _governor_observe(evolve_ms);
+    if (telemetry.active()) {
+        telemetry.record.evolve_ms = evolve_ms;
+        telemetry.record.governor_ms = m_governor_ms;
+        telemetry.record.governor_level = m_governor_level;
+        telemetry.record.active_biomes = num_active;
+        int candidates = 0;
+        for (int i = 0; i < num_active; i++) {
+            const Ref<QuantumEvolutionEngine>& engine = _engine(active[i]);
+            candidates += engine.is_valid() ? engine->last_mi_candidate_count() : 0;
+        }
+        telemetry.record.mi_candidates = candidates;
+    }
+
+    ScopedProfile marshal_profile(m_profile_marshal);
+    NATIVE_TRACE_ZONE("marshal");
+    if (m_rho_storage != RHO_STORAGE_FULL) {
+        NativeThreadPool::shared().parallel_for(0, num_biomes, num_biomes, [&](int begin, int end) {
+            for (int biome_id = begin; biome_id < end; biome_id++) {
+                _apply_rho_storage(biome_results[biome_id]);
+            }
+        });
+    }
+    _publish_lookahead_snapshots(biome_results, steps);
+    for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+        NativeCounters::add(COUNTER_BYTES_MARSHALLED, biome_results[biome_id].payload_bytes());
+    }
+
+    if (binary) {
+        *binary = _pack_binary(biome_results, steps);
+        release_results();
+        return Dictionary();
+    }
+    if (packed) {
+        Dictionary packed_result = _pack_results(biome_results, steps);
+        release_results();
+        return packed_result;
+    }
+
+    Dictionary result;
+    Array all_results;        // Array<Array<PackedFloat64Array>>
+    Array all_mi;             // Array<PackedFloat64Array> (last step)
+    Array all_mi_steps;       // Array<Array<PackedFloat64Array>>
+    Array all_bloch_steps;    // Array<Array<PackedFloat64Array>>
+    Array all_purity_steps;   // Array<Array<float>>
+    Array all_position_steps; // Array<Array<PackedVector2Array>> (NEW: force positions)
+    Array all_velocity_steps; // Array<Array<PackedVector2Array>> (NEW: force velocities)
+    Array all_metadata;       // Array<Dictionary>
+    Array all_couplings;      // Array<Dictionary>
+    PackedInt64Array metadata_versions;
+    PackedInt64Array coupling_versions;
+    Array all_icon_maps;      // Array<Dictionary>
+
+    // Assemble Godot Arrays on the caller once every task has joined
+    for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+        const BiomeStepResult& biome_result = biome_results[biome_id];
+
+        // Convert step_results to Godot Array
+        Array biome_steps;
+        for (const auto& step_rho : biome_result.steps) {
+            biome_steps.push_back(step_rho);
+        }
+
+        all_results.push_back(biome_steps);
+
+        Array biome_mi_steps;
+        for (const auto& mi_step : biome_result.mi_steps) {
+            biome_mi_steps.push_back(_visual_field(mi_step));
+        }
+        all_mi_steps.push_back(biome_mi_steps);
+        if (!biome_result.mi_steps.empty()) {
+            all_mi.push_back(_visual_field(biome_result.mi_steps.back()));
+        } else {
+            all_mi.push_back(_visual_field(PackedFloat64Array()));
+        }
+
+        Array biome_bloch_steps;
+        for (const auto& bloch_step : biome_result.bloch_steps) {
+            biome_bloch_steps.push_back(_visual_field(bloch_step));
+        }
+        all_bloch_steps.push_back(biome_bloch_steps);
+
+        if (m_output_precision == OUTPUT_PRECISION_FLOAT) {
+            PackedFloat32Array biome_purity_steps;
+            for (double purity_val : biome_result.purity_steps) {
+                biome_purity_steps.push_back(static_cast<float>(purity_val));
+            }
+            all_purity_steps.push_back(biome_purity_steps);
+        } else {
+            Array biome_purity_steps;
+            for (double purity_val : biome_result.purity_steps) {
+                biome_purity_steps.push_back(purity_val);
+            }
+            all_purity_steps.push_back(biome_purity_steps);
+        }
+
+        // NEW: Collect force graph position/velocity steps
+        Array biome_position_steps;
+        for (const auto& position_step : biome_result.position_steps) {
+            biome_position_steps.push_back(position_step);
+        }
+        all_position_steps.push_back(biome_position_steps);
+
+        Array biome_velocity_steps;
+        for (const auto& velocity_step : biome_result.velocity_steps) {
+            biome_velocity_steps.push_back(velocity_step);
+        }
+        all_velocity_steps.push_back(biome_velocity_steps);
+
+        _append_payloads(biome_id, all_metadata, all_couplings, metadata_versions, coupling_versions);
+
+        all_icon_maps.push_back(biome_result.icon_map);
+    }
+
+    result["results"] = all_results;
+    result["mi"] = all_mi;
+    result["mi_steps"] = all_mi_steps;
+    result["bloch_steps"] = all_bloch_steps;
+    result["purity_steps"] = all_purity_steps;
+    if (m_rho_storage == RHO_STORAGE_DELTA) {
+        Array all_deltas;  // Array<Array<PackedByteArray>>
+        Array all_scales;  // Array<PackedFloat64Array>
+        for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+            const BiomeStepResult& biome_result = biome_results[biome_id];
+            Array biome_deltas;
+            PackedFloat64Array biome_scales;
+            for (size_t s = 0; s < biome_result.delta_steps.size(); s++) {
+                biome_deltas.push_back(biome_result.delta_steps[s]);
+                biome_scales.push_back(biome_result.delta_scales[s]);
+            }
+            all_deltas.push_back(biome_deltas);
+            all_scales.push_back(biome_scales);
+        }
+        result["rho_deltas"] = all_deltas;
+        result["rho_delta_scales"] = all_scales;
+    }
+    result["position_steps"] = all_position_steps;  // NEW: force positions
+    result["velocity_steps"] = all_velocity_steps;  // NEW: force velocities
+    result["metadata"] = all_metadata;
+    result["couplings"] = all_couplings;
+    result["metadata_versions"] = metadata_versions;
+    result["coupling_versions"] = coupling_versions;
+    result["icon_maps"] = all_icon_maps;
+
+    release_results();
+    return result;
+}
+
+namespace {
+
+// Concatenate per-(biome, step) arrays into one buffer; offsets[i]..offsets[i+1]
+// is entry i = biome * steps + step (empty for steps a biome didn't produce)
+template <typename PackedT>
+PackedT concat_steps(const std::vector<std::vector<PackedT>>& per_biome, int steps,
+                     PackedInt64Array& offsets) {
+    const int num_biomes = static_cast<int>(per_biome.size());
+    offsets.resize(static_cast<int64_t>(num_biomes) * steps + 1);
+    int64_t* off = offsets.ptrw();
+    int64_t total = 0;
+    for (int b = 0; b < num_biomes; b++) {
+        for (int s = 0; s < steps; s++) {
+            off[b * steps + s] = total;
+            if (s < static_cast<int>(per_biome[b].size())) {
+                total += per_biome[b][s].size();
+            }
+        }
+    }
+    off[static_cast<int64_t>(num_biomes) * steps] = total;
+
+    PackedT flat;
+    flat.resize(total);
+    auto* dst = flat.ptrw();
+    for (int b = 0; b < num_biomes; b++) {
+        for (const PackedT& entry : per_biome[b]) {
+            std::copy(entry.ptr(), entry.ptr() + entry.size(), dst);
+            dst += entry.size();
+        }
+    }
+    return flat;
+}
+
+// Binary packet writer: sections are planned first (so the packet is
+// allocated once), then filled in place
+struct PacketWriter {
+    struct Section {
+        uint32_t id;
+        uint32_t type;
+        uint64_t count;
+        uint64_t offset;
+    };
+    static constexpr int64_t HEADER_BYTES = 32;
+    static constexpr int64_t ENTRY_BYTES = 24;
+    std::vector<Section> sections;
+
+    int plan(uint32_t id, uint32_t type, uint64_t count) {
+        sections.push_back({id, type, count, 0});
+        return static_cast<int>(sections.size()) - 1;
+    }
+
+    static uint64_t type_size(uint32_t type) {
+        switch (type) {
+            case MultiBiomeLookaheadEngine::PACKET_I16: return 2;
+            case MultiBiomeLookaheadEngine::PACKET_I32:
+            case MultiBiomeLookaheadEngine::PACKET_F32: return 4;
+            default: return 8;
+        }
+    }
+
+    // Lay out payloads after the table and write header + table
+    PackedByteArray allocate(uint32_t num_biomes, uint32_t steps) {
+        uint64_t cursor = HEADER_BYTES + ENTRY_BYTES * sections.size();
+        for (Section& section : sections) {
+            cursor = (cursor + 7) & ~uint64_t(7);
+            section.offset = cursor;
+            cursor += section.count * type_size(section.type);
+        }
+        PackedByteArray packet;
+        packet.resize(static_cast<int64_t>(cursor));
+        NATIVE_ALLOC_PACKED(packet);
+        packet.fill(0);
+        uint8_t* out = packet.ptrw();
+        const uint32_t header[6] = {MultiBiomeLookaheadEngine::PACKET_MAGIC, MultiBiomeLookaheadEngine::PACKET_VERSION,
+                                    num_biomes, steps, static_cast<uint32_t>(sections.size()), 0};
+        std::memcpy(out, header, sizeof(header));
+        std::memcpy(out + 24, &cursor, 8);
+        for (size_t i = 0; i < sections.size(); i++) {
+            std::memcpy(out + HEADER_BYTES + ENTRY_BYTES * i, &sections[i], ENTRY_BYTES);
+        }
+        return packet;
+    }
+};
+static_assert(sizeof(PacketWriter::Section) == PacketWriter::ENTRY_BYTES, "packet table entry layout");
+
+// Element count of one per-step field over all entries (get(b, s) -> span)
+template <typename Get>
+uint64_t step_field_count(int num_biomes, const PackedInt32Array& step_counts, Get get) {
+    uint64_t total = 0;
+    for (int b = 0; b < num_biomes; b++) {
+        for (int s = 0; s < step_counts[b]; s++) {
+            total += get(b, s).second;
+        }
+    }
+    return total;
+}
+
+// Write one per-step field converted to Dst and, unless off is null, its
+// B·S+1 offsets counted in units of `unit` elements
+template <typename Dst, typename Get>
+void write_step_field(uint8_t* packet, const PacketWriter::Section& data, int64_t* off, int64_t unit,
+                      int num_biomes, int steps, const PackedInt32Array& step_counts, Get get) {
+    Dst* dst = reinterpret_cast<Dst*>(packet + data.offset);
+    int64_t total = 0;
+    for (int b = 0; b < num_biomes; b++) {
+        for (int s = 0; s < steps; s++) {
+            if (off) {
+                off[static_cast<int64_t>(b) * steps + s] = total / unit;
+            }
+            if (s >= step_counts[b]) {
+                continue;
+            }
+            const auto span = get(b, s);
+            for (int64_t i = 0; i < span.second; i++) {
+                dst[total + i] = static_cast<Dst>(span.first[i]);
+            }
+            total += span.second;
+        }
+    }
+    if (off) {
+        off[static_cast<int64_t>(num_biomes) * steps] = total / unit;
+    }
+}
+
+}  // namespace
+
+void MultiBiomeLookaheadEngine::_add_staged_biome(NativeTaskGraph& graph, StagedBiome& staged,
+                                                  BiomeStepResult& out, const PackedFloat64Array& input, int steps,
+                                                  float dt, float max_dt, bool compute_mi) {
+    const int biome_id = staged.biome_id;
+    const int num_qubits = m_num_qubits[biome_id];
+    const int lod = get_effective_biome_lod(biome_id);
+    const bool lnn = is_lnn_enabled(biome_id);
+    staged.steps = steps;
+    staged.dt = dt;
+    staged.max_dt = _lod_max_dt(biome_id, lod, dt, max_dt);
+    staged.mi_stride = _mi_stride(lod);
+    staged.compute_mi = compute_mi;
+    staged.detect_steady = m_steady_tolerance > 0.0 && _ensemble_step_span(biome_id, dt, max_dt) > 0.0 && !lnn;
+    staged.observables_cap = QuantumEvolutionEngine::observables_size(
+        num_qubits, QuantumEvolutionEngine::OBSERVABLE_BLOCH | QuantumEvolutionEngine::OBSERVABLE_PURITY |
+                        QuantumEvolutionEngine::OBSERVABLE_MI);
+    staged.input = input;
+    staged.rho.assign(steps, PackedFloat64Array());
+    staged.evolved.assign(steps, 0);
+    staged.observables.assign(static_cast<size_t>(steps) * staged.observables_cap, 0.0);
+    staged.spans.assign(steps, StepSpan());
+    const ForceGraphEngine::NodeBuffers* nodes = m_force_engine->get_layout(m_force_layouts[biome_id]);
+    staged.layout_nodes = nodes ? nodes->size() : 0;
+    staged.layout.assign(static_cast<size_t>(steps) * staged.layout_nodes * 4, 0.0f);
+    staged.produced = 0;
+    staged.last_mi_step = -1;
+
+    out.steps.reserve(steps);
+    out.bloch_steps.reserve(steps);
+    out.purity_steps.reserve(steps);
+    out.mi_steps.reserve(steps);
+    out.position_steps.reserve(steps);
+    out.velocity_steps.reserve(steps);
+
+    StagedBiome* sb = &staged;
+    BiomeStepResult* result = &out;
+    int state_ready = -1;   // Node after which rho[step - 1] is final
+    int prev_observe = -1;  // Adaptive MI state chains the observables
+    int prev_force = -1;    // Layout and result order chain the forces
+    for (int step = 0; step < steps; step++) {
+        const int evolve = graph.add([this, sb, step]() { _staged_evolve(*sb, step); });
+        graph.precede(state_ready, evolve);
+        state_ready = evolve;
+        if (lnn) {
+            const int modulate = graph.add([this, sb, step]() {
+                if (sb->evolved[step]) {
+                    _apply_lnn_phase_modulation(sb->biome_id, sb->rho[step]);
+                }
+            });
+            graph.precede(evolve, modulate);
+            state_ready = modulate;
+        }
+        const int observe = graph.add([this, sb, step]() { _staged_observe(*sb, step); });
+        graph.precede(state_ready, observe);
+        graph.precede(prev_observe, observe);
+        const int force = graph.add([this, sb, result, step]() { _staged_force(*sb, *result, step); });
+        graph.precede(observe, force);
+        graph.precede(prev_force, force);
+        prev_observe = observe;
+        prev_force = force;
+    }
+}
+
+void MultiBiomeLookaheadEngine::_staged_evolve(StagedBiome& staged, int step) {
+    if ((step > 0 && !staged.evolved[step - 1]) || _step_cancelled()) {
+        return;  // Cancelled: this and every later step stay unproduced
+    }
+    NATIVE_TRACE_ZONE_ID("step", step);
+    NativeCounters::add(COUNTER_LOOKAHEAD_STEPS_COMPUTED, 1);
+    // Copy-on-write share of the previous state, split by evolve_inplace
+    PackedFloat64Array next = (step == 0) ? staged.input : staged.rho[step - 1];
+    if (_engine(staged.biome_id)->evolve_inplace(next, staged.dt, staged.max_dt)) {
+        staged.rho[step] = next;
+        staged.evolved[step] = 1;
+    }
+}
+
+void MultiBiomeLookaheadEngine::_staged_observe(StagedBiome& staged, int step) {
+    if (!staged.evolved[step]) {
+        return;
+    }
+    const Ref<QuantumEvolutionEngine>& engine = _engine(staged.biome_id);
+    const int num_qubits = m_num_qubits[staged.biome_id];
+    const int dim = engine->get_dimension();
+    const bool mi_now = staged.compute_mi && (step % staged.mi_stride == 0);
+    const int mask = QuantumEvolutionEngine::OBSERVABLE_BLOCH | QuantumEvolutionEngine::OBSERVABLE_PURITY |
+                     (mi_now ? QuantumEvolutionEngine::OBSERVABLE_MI : 0);
+    Eigen::Map<const QuantumEvolutionEngine::RhoMatrix> frame(
+        reinterpret_cast<const std::complex<double>*>(staged.rho[step].ptr()), dim, dim);
+    engine->compute_observables_into(frame, num_qubits, mask,
+                                     staged.observables.data() + static_cast<size_t>(step) * staged.observables_cap);
+    const int observables_len = QuantumEvolutionEngine::observables_size(num_qubits, mask);
+    StepSpan& span = staged.spans[step];
+    span.bloch_len = std::min(num_qubits * 8, observables_len);
+    span.mi_at = std::min(span.bloch_len + 1, observables_len);
+    span.mi_len = mi_now ? observables_len - span.mi_at : -1;
+}
+
+MultiBiomeLookaheadEngine::StepOutputs MultiBiomeLookaheadEngine::StagedBiome::outputs() {
+    StepOutputs flat;
+    flat.steps = produced;
+    flat.slot = observables_cap;
+    flat.nodes = layout_nodes;
+    flat.observables = observables.data();
+    flat.spans = spans.data();
+    flat.layout = layout.data();
+    return flat;
+}
+
+void MultiBiomeLookaheadEngine::_staged_force(StagedBiome& staged, BiomeStepResult& out, int step) {
+    const int biome_id = staged.biome_id;
+    if (staged.evolved[step]) {
+        const int num_qubits = m_num_qubits[biome_id];
+        const double* observables = staged.observables.data() + static_cast<size_t>(step) * staged.observables_cap;
+        const StepSpan& span = staged.spans[step];
+        if (span.mi_len >= 0) {
+            staged.last_mi_step = step;
+        }
+
+        // Same entries as _evolve_biome_steps_into; the packed arrays are built at the tail
+        out.purity_steps.push_back(span.bloch_len < span.mi_at ? observables[span.bloch_len] : 0.0);
+
+        const int layout = m_force_layouts[biome_id];
+        ForceGraphEngine::NodeBuffers* nodes = m_force_engine->get_layout(layout);
+        if (nodes) {
+            ScopedProfile force_profile(m_biome_profile[biome_id].force);
+            NATIVE_TRACE_ZONE_ID("force", biome_id);
+            // The MI only changes on MI steps, so the springs carry over between them
+            if (span.mi_len >= 0 || step == 0) {
+                const double* mi = nullptr;
+                int mi_len = 0;
+                if (staged.last_mi_step >= 0) {
+                    const StepSpan& mi_span = staged.spans[staged.last_mi_step];
+                    mi = staged.observables.data() + static_cast<size_t>(staged.last_mi_step) * staged.observables_cap +
+                         mi_span.mi_at;
+                    mi_len = mi_span.mi_len;
+                }
+                _engine(biome_id)->mi_edges_into(mi, mi_len, num_qubits, staged.mi_edges);
+            }
+            ForceGraphEngine::StepInputs in;
+            in.bloch = observables;
+            in.bloch_size = span.bloch_len;
+            in.mi_edges = staged.mi_edges.data();
+            in.mi_edge_count = static_cast<int>(staged.mi_edges.size() / 3);
+            in.center_x = m_biome_centers[biome_id].x;
+            in.center_y = m_biome_centers[biome_id].y;
+            in.dt = staged.dt;
+            in.accumulate = true;
+            m_force_engine->step_nodes(*nodes, in);
+        }
+        StepOutputs flat = staged.outputs();
+        _snapshot_layout(nodes, flat, step);
+        staged.produced++;
+
+        if (staged.detect_steady) {
+            const PackedFloat64Array& before_rho = (step == 0) ? staged.input : staged.rho[step - 1];
+            const int64_t stride = staged.rho[step].size();
+            const double step_time = _ensemble_step_span(biome_id, staged.dt, staged.max_dt);
+            const Eigen::Map<const Eigen::VectorXd> before(before_rho.ptr(), stride);
+            const Eigen::Map<const Eigen::VectorXd> after(staged.rho[step].ptr(), stride);
+            SteadyState& steady = m_steady[biome_id];
+            steady.still_steps = (after - before).norm() < m_steady_tolerance * step_time ? steady.still_steps + 1 : 0;
+        }
+    }
+
+    if (step + 1 == staged.steps) {
+        // Tail of the chain: the step outputs, convergence and the icon map, as the sequential path
+        for (int s = 0; s < staged.produced; s++) {
+            out.steps.push_back(staged.rho[s]);
+        }
+        std::vector<PackedFloat64Array> unused;
+        _assemble_step_outputs(biome_id, staged.outputs(), true, false, true, true, out, unused);
+        SteadyState& steady = m_steady[biome_id];
+        if (staged.detect_steady && steady.still_steps >= m_steady_window && !out.steps.empty()) {
+            const double step_time = _ensemble_step_span(biome_id, staged.dt, staged.max_dt);
+            steady.stationary = true;
+            steady.rho = out.steps.back();
+            steady.drift = m_steady_tolerance * step_time * m_steady_window;
+        }
+        out.icon_map = _build_icon_map(biome_id, out.bloch_steps);
+        staged.rho.clear();  // Results hold their own shares
+        staged.input = PackedFloat64Array();
+    }
+}
+
+Dictionary MultiBiomeLookaheadEngine::_pack_results(
+    const std::vector<BiomeStepResult>& biome_results, int steps) const {
+    const int num_biomes = static_cast<int>(biome_results.size());
+    steps = std::max(steps, 0);
+
+    std::vector<std::vector<PackedFloat64Array>> rho(num_biomes), mi(num_biomes), bloch(num_biomes);
+    std::vector<std::vector<PackedVector2Array>> positions(num_biomes), velocities(num_biomes);
+    PackedInt32Array step_counts;
+    step_counts.resize(num_biomes);
+    PackedFloat64Array purity;
+    purity.resize(static_cast<int64_t>(num_biomes) * steps);
+    purity.fill(0.0);
+    Array icon_maps;
+
+    for (int b = 0; b < num_biomes; b++) {
+        const BiomeStepResult& r = biome_results[b];
+        const int count = std::min(steps, static_cast<int>(r.steps.size()));
+        step_counts.set(b, count);
+        rho[b].assign(r.steps.begin(), r.steps.begin() + count);
+        mi[b].assign(r.mi_steps.begin(), r.mi_steps.begin() + std::min(count, static_cast<int>(r.mi_steps.size())));
+        bloch[b].assign(r.bloch_steps.begin(), r.bloch_steps.begin() + std::min(count, static_cast<int>(r.bloch_steps.size())));
+        positions[b].assign(r.position_steps.begin(), r.position_steps.begin() + std::min(count, static_cast<int>(r.position_steps.size())));
+        velocities[b].assign(r.velocity_steps.begin(), r.velocity_steps.begin() + std::min(count, static_cast<int>(r.velocity_steps.size())));
+        for (int s = 0; s < std::min(count, static_cast<int>(r.purity_steps.size())); s++) {
+            purity.set(static_cast<int64_t>(b) * steps + s, r.purity_steps[s]);
+        }
+        icon_maps.push_back(r.icon_map);
+    }
+
+    PackedInt64Array rho_offsets, mi_offsets, bloch_offsets, node_offsets, unused_offsets;
+    Dictionary result;
+    result["num_biomes"] = num_biomes;
+    result["steps"] = steps;
+    result["step_counts"] = step_counts;
+    result["rho"] = concat_steps(rho, steps, rho_offsets);
+    result["rho_offsets"] = rho_offsets;
+    result["mi"] = _visual_field(concat_steps(mi, steps, mi_offsets));
+    result["mi_offsets"] = mi_offsets;
+    result["bloch"] = _visual_field(concat_steps(bloch, steps, bloch_offsets));
+    result["bloch_offsets"] = bloch_offsets;
+    result["purity"] = _visual_field(purity);
+    result["positions"] = concat_steps(positions, steps, node_offsets);
+    result["velocities"] = concat_steps(velocities, steps, unused_offsets);
+    result["node_offsets"] = node_offsets;  // Velocities share the position layout
+    result["icon_maps"] = icon_maps;
+    if (m_rho_storage == RHO_STORAGE_DELTA) {
+        std::vector<std::vector<PackedByteArray>> deltas(num_biomes);
+        PackedFloat64Array scales;
+        scales.resize(static_cast<int64_t>(num_biomes) * steps);
+        scales.fill(0.0);
+        for (int b = 0; b < num_biomes; b++) {
+            const BiomeStepResult& r = biome_results[b];
+            const int count = std::min(step_counts[b], static_cast<int>(r.delta_steps.size()));
+            deltas[b].assign(r.delta_steps.begin(), r.delta_steps.begin() + count);
+            for (int s = 0; s < count; s++) {
+                scales.set(static_cast<int64_t>(b) * steps + s, r.delta_scales[s]);
+            }
+        }
+        PackedInt64Array delta_offsets;
+        result["rho_deltas"] = concat_steps(deltas, steps, delta_offsets);
+        result["rho_delta_offsets"] = delta_offsets;
+        result["rho_delta_scales"] = scales;
+    }
+    return result;
+}
+
+PackedByteArray MultiBiomeLookaheadEngine::_pack_binary(const std::vector<BiomeStepResult>& biome_results,
+                                                        int steps) const {
+    const int num_biomes = static_cast<int>(biome_results.size());
+    steps = std::max(steps, 0);
+    const uint64_t entries = static_cast<uint64_t>(num_biomes) * steps;
+    PackedInt32Array step_counts;
+    step_counts.resize(num_biomes);
+    for (int b = 0; b < num_biomes; b++) {
+        step_counts.set(b, std::min(steps, static_cast<int>(biome_results[b].steps.size())));
+    }
+
+    typedef std::pair<const double*, int64_t> DoubleSpan;
+    typedef std::pair<const real_t*, int64_t> RealSpan;
+    typedef std::pair<const int16_t*, int64_t> ShortSpan;
+    auto step_of = [](const auto& list, int s) -> decltype(&list[0]) {
+        return s < static_cast<int>(list.size()) ? &list[s] : nullptr;
+    };
+    auto rho = [&](int b, int s) {
+        const PackedFloat64Array& a = biome_results[b].steps[s];
+        return DoubleSpan(a.ptr(), a.size());
+    };
+    auto mi = [&](int b, int s) {
+        const PackedFloat64Array* a = step_of(biome_results[b].mi_steps, s);
+        return a ? DoubleSpan(a->ptr(), a->size()) : DoubleSpan(nullptr, 0);
+    };
+    auto bloch = [&](int b, int s) {
+        const PackedFloat64Array* a = step_of(biome_results[b].bloch_steps, s);
+        return a ? DoubleSpan(a->ptr(), a->size()) : DoubleSpan(nullptr, 0);
+    };
+    // Vector2 is two real_t: nodes travel as flat x,y floats
+    auto positions = [&](int b, int s) {
+        const PackedVector2Array* a = step_of(biome_results[b].position_steps, s);
+        return a ? RealSpan(reinterpret_cast<const real_t*>(a->ptr()), a->size() * 2) : RealSpan(nullptr, 0);
+    };
+    auto velocities = [&](int b, int s) {
+        const PackedVector2Array* a = step_of(biome_results[b].velocity_steps, s);
+        return a ? RealSpan(reinterpret_cast<const real_t*>(a->ptr()), a->size() * 2) : RealSpan(nullptr, 0);
+    };
+    auto deltas = [&](int b, int s) {
+        const PackedByteArray* a = step_of(biome_results[b].delta_steps, s);
+        return a ? ShortSpan(reinterpret_cast<const int16_t*>(a->ptr()), a->size() / 2) : ShortSpan(nullptr, 0);
+    };
+
+    const uint32_t visual = m_output_precision == OUTPUT_PRECISION_FLOAT ? PACKET_F32 : PACKET_F64;
+    const bool has_deltas = m_rho_storage == RHO_STORAGE_DELTA;
+    PacketWriter writer;
+    const int counts_section = writer.plan(PACKET_STEP_COUNTS, PACKET_I32, num_biomes);
+    const int rho_offsets = writer.plan(PACKET_RHO_OFFSETS, PACKET_I64, entries + 1);
+    const int rho_data = writer.plan(PACKET_RHO, PACKET_F64, step_field_count(num_biomes, step_counts, rho));
+    const int mi_offsets = writer.plan(PACKET_MI_OFFSETS, PACKET_I64, entries + 1);
+    const int mi_data = writer.plan(PACKET_MI, visual, step_field_count(num_biomes, step_counts, mi));
+    const int bloch_offsets = writer.plan(PACKET_BLOCH_OFFSETS, PACKET_I64, entries + 1);
+    const int bloch_data = writer.plan(PACKET_BLOCH, visual, step_field_count(num_biomes, step_counts, bloch));
+    const int purity_section = writer.plan(PACKET_PURITY, visual, entries);
+    const int node_offsets = writer.plan(PACKET_NODE_OFFSETS, PACKET_I64, entries + 1);
+    const int position_data =
+        writer.plan(PACKET_POSITIONS, PACKET_F32, step_field_count(num_biomes, step_counts, positions));
+    const int velocity_data =
+        writer.plan(PACKET_VELOCITIES, PACKET_F32, step_field_count(num_biomes, step_counts, velocities));
+    int delta_offsets = -1, delta_data = -1, delta_scales = -1;
+    if (has_deltas) {
+        delta_offsets = writer.plan(PACKET_RHO_DELTA_OFFSETS, PACKET_I64, entries + 1);
+        delta_data = writer.plan(PACKET_RHO_DELTAS, PACKET_I16, step_field_count(num_biomes, step_counts, deltas));
+        delta_scales = writer.plan(PACKET_RHO_DELTA_SCALES, PACKET_F64, entries);
+    }
+    PackedByteArray packet = writer.allocate(static_cast<uint32_t>(num_biomes), static_cast<uint32_t>(steps));
+    uint8_t* out = packet.ptrw();
+    const std::vector<PacketWriter::Section>& sec = writer.sections;
+
+    auto offsets_of = [&](int section) { return reinterpret_cast<int64_t*>(out + sec[section].offset); };
+
+    std::memcpy(out + sec[counts_section].offset, step_counts.ptr(), sizeof(int32_t) * num_biomes);
+    write_step_field<double>(out, sec[rho_data], offsets_of(rho_offsets), 1, num_biomes, steps, step_counts, rho);
+    // Node offsets count x,y pairs, like "node_offsets" of the packed Dictionary
+    write_step_field<float>(out, sec[position_data], offsets_of(node_offsets), 2, num_biomes, steps, step_counts,
+                            positions);
+    write_step_field<float>(out, sec[velocity_data], nullptr, 2, num_biomes, steps, step_counts, velocities);
+    if (visual == PACKET_F32) {
+        write_step_field<float>(out, sec[mi_data], offsets_of(mi_offsets), 1, num_biomes, steps, step_counts, mi);
+        write_step_field<float>(out, sec[bloch_data], offsets_of(bloch_offsets), 1, num_biomes, steps, step_counts,
+                                bloch);
+    } else {
+        write_step_field<double>(out, sec[mi_data], offsets_of(mi_offsets), 1, num_biomes, steps, step_counts, mi);
+        write_step_field<double>(out, sec[bloch_data], offsets_of(bloch_offsets), 1, num_biomes, steps, step_counts,
+                                 bloch);
+    }
+    for (int b = 0; b < num_biomes; b++) {
+        const BiomeStepResult& r = biome_results[b];
+        const int count = std::min(step_counts[b], static_cast<int>(r.purity_steps.size()));
+        for (int s = 0; s < count; s++) {
+            const uint64_t at = sec[purity_section].offset + (static_cast<uint64_t>(b) * steps + s) *
+                                                                PacketWriter::type_size(visual);
+            if (visual == PACKET_F32) {
+                const float value = static_cast<float>(r.purity_steps[s]);
+                std::memcpy(out + at, &value, sizeof(float));
+            } else {
+                std::memcpy(out + at, &r.purity_steps[s], sizeof(double));
+            }
+        }
+    }
+    if (has_deltas) {
+        write_step_field<int16_t>(out, sec[delta_data], offsets_of(delta_offsets), 1, num_biomes, steps, step_counts,
+                                  deltas);
+        double* scales = reinterpret_cast<double*>(out + sec[delta_scales].offset);
+        for (int b = 0; b < num_biomes; b++) {
+            const BiomeStepResult& r = biome_results[b];
+            const int count = std::min(step_counts[b], static_cast<int>(r.delta_scales.size()));
+            for (int s = 0; s < count; s++) {
+                scales[static_cast<int64_t>(b) * steps + s] = r.delta_scales[s];
+            }
+        }
+    }
+    return packet;
+}
+
+void MultiBiomeLookaheadEngine::set_output_precision(int precision) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (precision != OUTPUT_PRECISION_DOUBLE && precision != OUTPUT_PRECISION_FLOAT) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Unknown output precision ", precision);
+        return;
+    }
+    m_output_precision = precision;
+}
+
+int MultiBiomeLookaheadEngine::get_output_precision() const {
+    return m_output_precision;
+}
+
+Variant MultiBiomeLookaheadEngine::_visual_field(const PackedFloat64Array& values) const {
+    if (m_output_precision == OUTPUT_PRECISION_FLOAT) {
+        return to_float32(values);
+    }
+    return values;
+}
+
+void MultiBiomeLookaheadEngine::set_rho_storage(int policy) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (policy < RHO_STORAGE_FULL || policy > RHO_STORAGE_DELTA) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Unknown rho storage policy ", policy);
+        return;
+    }
+    m_rho_storage = policy;
+}
+
+int MultiBiomeLookaheadEngine::get_rho_storage() const {
+    return m_rho_storage;
+}
+
+void MultiBiomeLookaheadEngine::_apply_rho_storage(BiomeStepResult& result) const {
+    const int count = static_cast<int>(result.steps.size());
+    if (m_rho_storage == RHO_STORAGE_FULL || count < 2) {
+        return;
+    }
+    for (const PackedFloat64Array& rho : result.steps) {
+        if (rho.is_empty()) {
+            return;  // Already observables-only (large biome)
+        }
+    }
+    if (m_rho_storage == RHO_STORAGE_LAST) {
+        for (int s = 0; s + 1 < count; s++) {
+            result.steps[s] = PackedFloat64Array();
+        }
+        return;
+    }
+
+    // Deltas against the decoded previous state, so the receiver's
+    // reconstruction matches ours bit for bit and errors never accumulate
+    const int64_t size = result.steps[0].size();
+    std::vector<double> decoded(result.steps[0].ptr(), result.steps[0].ptr() + size);
+    result.delta_steps.assign(count, PackedByteArray());
+    result.delta_scales.assign(count, 0.0);
+    for (int s = 1; s < count; s++) {
+        PackedByteArray bytes;
+        result.delta_scales[s] = encode_rho_delta(result.steps[s].ptr(), decoded.data(), size, bytes);
+        result.delta_steps[s] = bytes;
+        result.steps[s] = PackedFloat64Array();
+    }
+}
+
+Array MultiBiomeLookaheadEngine::decode_rho_steps(const Dictionary& result, int biome_id) const {
+    Array out;
+    const bool packed = result.has("rho_offsets");
+    int count = 0;
+    int steps = 0;
+    if (packed) {
+        const PackedInt32Array step_counts = result.get("step_counts", PackedInt32Array());
+        steps = result.get("steps", 0);
+        if (biome_id < 0 || biome_id >= step_counts.size()) {
+            return out;
+        }
+        count = step_counts[biome_id];
+    } else {
+        const Array all_results = result.get("results", Array());
+        if (biome_id < 0 || biome_id >= all_results.size()) {
+            return out;
+        }
+        count = Array(all_results[biome_id]).size();
+    }
+
+    // Per-step accessors over either layout
+    const PackedFloat64Array flat_rho = result.get("rho", PackedFloat64Array());
+    const PackedInt64Array rho_offsets = result.get("rho_offsets", PackedInt64Array());
+    const PackedByteArray flat_deltas = result.get("rho_deltas", PackedByteArray());
+    const PackedInt64Array delta_offsets = result.get("rho_delta_offsets", PackedInt64Array());
+    const PackedFloat64Array flat_scales = result.get("rho_delta_scales", PackedFloat64Array());
+    const Array nested_rho = packed ? Array() : Array(Array(result.get("results", Array()))[biome_id]);
+    const Array all_deltas = packed ? Array() : Array(result.get("rho_deltas", Array()));
+    const Array all_scales = packed ? Array() : Array(result.get("rho_delta_scales", Array()));
+    const Array nested_deltas = biome_id < all_deltas.size() ? Array(all_deltas[biome_id]) : Array();
+    const PackedFloat64Array nested_scales =
+        biome_id < all_scales.size() ? PackedFloat64Array(all_scales[biome_id]) : PackedFloat64Array();
+
+    PackedFloat64Array previous;
+    for (int s = 0; s < count; s++) {
+        PackedFloat64Array rho;
+        const uint8_t* delta = nullptr;
+        int64_t delta_bytes = 0;
+        double scale = 0.0;
+        PackedByteArray nested_delta;
+        if (packed) {
+            const int64_t entry = static_cast<int64_t>(biome_id) * steps + s;
+            if (entry + 1 < rho_offsets.size() && rho_offsets[entry + 1] > rho_offsets[entry]) {
+                rho = flat_rho.slice(rho_offsets[entry], rho_offsets[entry + 1]);
+            } else if (entry + 1 < delta_offsets.size() && delta_offsets[entry + 1] > delta_offsets[entry]) {
+                delta = flat_deltas.ptr() + delta_offsets[entry];
+                delta_bytes = delta_offsets[entry + 1] - delta_offsets[entry];
+                scale = entry < flat_scales.size() ? flat_scales[entry] : 0.0;
+            }
+        } else {
+            rho = nested_rho[s];
+            if (rho.is_empty() && s < nested_deltas.size()) {
+                nested_delta = nested_deltas[s];
+                delta = nested_delta.ptr();
+                delta_bytes = nested_delta.size();
+                scale = s < nested_scales.size() ? nested_scales[s] : 0.0;
+            }
+        }
+        if (rho.is_empty() && delta != nullptr && previous.size() * 2 == delta_bytes) {
+            rho = previous;
+            apply_rho_delta(delta, scale, rho.ptrw(), previous.size());
+        }
+        out.push_back(rho);
+        previous = rho;
+    }
+    return out;
+}
+
+// ============================================================================
+// ASYNC LOOKAHEAD
+// ============================================================================
+
+bool MultiBiomeLookaheadEngine::submit_lookahead(
+    const Array& biome_rhos, int steps, float dt, float max_dt, bool packed) {
+    // Snapshot now: the caller's Array may change before the worker runs
+    AsyncJob job;
+    job.rhos.resize(biome_rhos.size());
+    for (int biome_id = 0; biome_id < biome_rhos.size(); biome_id++) {
+        job.rhos[biome_id] = biome_rhos[biome_id];
+    }
+    job.steps = steps;
+    job.dt = dt;
+    job.max_dt = max_dt;
+    job.packed = packed;
+
+    {
+        std::lock_guard<std::mutex> lock(m_async_mutex);
+        if (m_async_stopping) {
+            return false;
+        }
+        m_async_job = std::move(job);
+        m_async_has_job = true;
+        if (!m_async_thread.joinable()) {
+            m_async_thread = std::thread([this]() { _async_worker_loop(); });
+        }
+    }
+    m_async_cv.notify_one();
+    return true;
+}
+
+Variant MultiBiomeLookaheadEngine::poll_lookahead() {
+    Dictionary result;
+    std::vector<WatchEvent> watch_events;
+    {
+        std::lock_guard<std::mutex> lock(m_async_mutex);
+        if (!m_async_ready) {
+            return Variant();
+        }
+        m_async_ready = false;
+        result = m_async_front;
+        m_async_front = Dictionary();
+        watch_events.swap(m_async_watch_events);
+    }
+    _emit_watch_events(watch_events);
+    return result;
+}
+
+void MultiBiomeLookaheadEngine::cancel_lookahead() {
+    std::lock_guard<std::mutex> lock(m_async_mutex);
+    m_async_has_job = false;
+    m_async_job = AsyncJob();
+    if (m_async_running && m_async_running_cancel) {
+        m_async_running_cancel->store(true);
+    }
+}
+
+bool MultiBiomeLookaheadEngine::is_lookahead_busy() const {
+    std::lock_guard<std::mutex> lock(m_async_mutex);
+    return m_async_has_job || m_async_running;
+}
+
+void MultiBiomeLookaheadEngine::_async_worker_loop() {
+    while (true) {
+        AsyncJob job;
+        std::shared_ptr<std::atomic<bool>> cancel = std::make_shared<std::atomic<bool>>(false);
+        {
+            std::unique_lock<std::mutex> lock(m_async_mutex);
+            m_async_cv.wait(lock, [this]() { return m_async_stopping || m_async_has_job; });
+            if (m_async_stopping) {
+                return;
+            }
+            job = std::move(m_async_job);
+            m_async_job = AsyncJob();
+            m_async_has_job = false;
+            m_async_running = true;
+            m_async_running_cancel = cancel;
+        }
+
+        // Back buffer: built off-lock, published by swap into the front
+        std::vector<WatchEvent> watch_events;
+        Dictionary result = _run_lookahead(job.rhos, job.steps, job.dt, job.max_dt, job.packed, &watch_events,
+                                           nullptr, LOOKAHEAD_ALL, cancel.get());
+
+        std::lock_guard<std::mutex> lock(m_async_mutex);
+        m_async_running = false;
+        m_async_running_cancel.reset();
+        if (!cancel->load()) {
+            m_async_front = result;
+            // An unpolled front's events still count: the watches disarmed on them
+            m_async_watch_events.insert(m_async_watch_events.end(), watch_events.begin(), watch_events.end());
+            m_async_ready = true;
+        } else {
+            // Requested steps (the run stopped at the next step boundary)
+            NativeCounters::add(COUNTER_LOOKAHEAD_STEPS_DISCARDED,
+                                static_cast<uint64_t>(std::max(job.steps, 0)) * job.rhos.size());
+        }
+    }
+}
+
+// ============================================================================
+// SLICED / ASYNC EIGENSTATE ANALYSIS
+// ============================================================================
+
+Array MultiBiomeLookaheadEngine::_eigen_inputs(const Array& biome_rhos) {
+    if (!biome_rhos.is_empty()) {
+        return biome_rhos;
+    }
+    Array resident;
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    for (const PackedFloat64Array& rho : m_resident_rho) {
+        resident.push_back(rho);
+    }
+    return resident;
+}
+
+void MultiBiomeLookaheadEngine::start_sliced_eigenstates(const Array& biome_rhos) {
+    const Array inputs = _eigen_inputs(biome_rhos);
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_sliced_eigen = SlicedEigenState();
+    QuantumEvolutionEngine::begin_eigen_batch(inputs, m_sliced_eigen.batch);
+    if (m_sliced_eigen.batch.count() == 0) {
+        m_sliced_eigen.complete = true;
+        return;
+    }
+    m_sliced_eigen.in_progress = true;
+}
+
+bool MultiBiomeLookaheadEngine::continue_sliced_eigenstates_us(int64_t budget_us) {
+    {
+        std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+        if (!m_sliced_eigen.in_progress || m_sliced_eigen.complete) {
+            return true;  // Nothing to do or already complete
+        }
+
+        typedef std::chrono::steady_clock Clock;
+        const Clock::time_point frame_start = Clock::now();
+        QuantumEvolutionEngine::EigenBatch& batch = m_sliced_eigen.batch;
+        bool force_one = (m_sliced_eigen.stalled_calls > 0);
+        bool progressed = false;
+        while (m_sliced_eigen.next_biome < batch.count()) {
+            const int b = m_sliced_eigen.next_biome;
+            const double dim3 = std::pow(static_cast<double>(batch.dims[b]), 3.0);
+            if (dim3 > 0.0) {
+                const double left_us = static_cast<double>(budget_us) -
+                                       std::chrono::duration<double, std::micro>(Clock::now() - frame_start).count();
+                if (m_eigen_cost_per_dim3_us * dim3 > left_us && !force_one) {
+                    break;
+                }
+                force_one = false;
+
+                const Clock::time_point start = Clock::now();
+                QuantumEvolutionEngine::run_eigen_batch(batch, b, b + 1, false);
+                const double per_dim3 =
+                    std::chrono::duration<double, std::micro>(Clock::now() - start).count() / dim3;
+                m_eigen_cost_per_dim3_us = (m_eigen_cost_per_dim3_us <= 0.0)
+                                               ? per_dim3
+                                               : m_eigen_cost_per_dim3_us +
+                                                     STEP_COST_SMOOTHING * (per_dim3 - m_eigen_cost_per_dim3_us);
+                progressed = true;
+            }
+            m_sliced_eigen.next_biome++;
+        }
+        m_sliced_eigen.stalled_calls = progressed ? 0 : m_sliced_eigen.stalled_calls + 1;
+        if (m_sliced_eigen.next_biome < batch.count()) {
+            return false;
+        }
+        m_sliced_eigen.complete = true;
+        m_sliced_eigen.in_progress = false;
+    }
+    emit_signal("eigenstates_ready");
+    return true;
+}
+
+bool MultiBiomeLookaheadEngine::is_sliced_eigenstates_complete() const {
+    return m_sliced_eigen.complete || !m_sliced_eigen.in_progress;
+}
+
+Dictionary MultiBiomeLookaheadEngine::get_sliced_eigenstates_result() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (!m_sliced_eigen.complete) {
+        UtilityFunctions::push_warning(
+            "MultiBiomeLookaheadEngine: get_sliced_eigenstates_result called before completion");
+        return Dictionary();
+    }
+    const Dictionary result = QuantumEvolutionEngine::eigen_batch_result(m_sliced_eigen.batch);
+    m_sliced_eigen = SlicedEigenState();
+    return result;
+}
+
+void MultiBiomeLookaheadEngine::cancel_sliced_eigenstates() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_sliced_eigen = SlicedEigenState();
+}
+
+float MultiBiomeLookaheadEngine::get_sliced_eigenstates_progress() const {
+    if (!m_sliced_eigen.in_progress) {
+        return m_sliced_eigen.complete ? 1.0f : 0.0f;
+    }
+    const int count = m_sliced_eigen.batch.count();
+    return count > 0 ? static_cast<float>(m_sliced_eigen.next_biome) / static_cast<float>(count) : 1.0f;
+}
+
+bool MultiBiomeLookaheadEngine::submit_eigenstates(const Array& biome_rhos) {
+    // Snapshot now: the caller's Array may change before the worker runs
+    QuantumEvolutionEngine::EigenBatch job;
+    QuantumEvolutionEngine::begin_eigen_batch(_eigen_inputs(biome_rhos), job);
+    {
+        std::lock_guard<std::mutex> lock(m_eigen_mutex);
+        if (m_eigen_stopping) {
+            return false;
+        }
+        m_eigen_job = std::move(job);
+        m_eigen_has_job = true;
+        if (!m_eigen_thread.joinable()) {
+            m_eigen_thread = std::thread([this]() { _eigen_worker_loop(); });
+        }
+    }
+    m_eigen_cv.notify_one();
+    return true;
+}
+
+Variant MultiBiomeLookaheadEngine::poll_eigenstates() {
+    std::lock_guard<std::mutex> lock(m_eigen_mutex);
+    if (!m_eigen_ready) {
+        return Variant();
+    }
+    m_eigen_ready = false;
+    Dictionary result = m_eigen_front;
+    m_eigen_front = Dictionary();
+    return result;
+}
+
+void MultiBiomeLookaheadEngine::cancel_eigenstates() {
+    std::lock_guard<std::mutex> lock(m_eigen_mutex);
+    m_eigen_has_job = false;
+    m_eigen_job = QuantumEvolutionEngine::EigenBatch();
+    if (m_eigen_running) {
+        m_eigen_cancel = true;
+    }
+}
+
+bool MultiBiomeLookaheadEngine::is_eigenstates_busy() const {
+    std::lock_guard<std::mutex> lock(m_eigen_mutex);
+    return m_eigen_has_job || m_eigen_running;
+}
+
+void MultiBiomeLookaheadEngine::_eigen_worker_loop() {
+    while (true) {
+        QuantumEvolutionEngine::EigenBatch job;
+        {
+            std::unique_lock<std::mutex> lock(m_eigen_mutex);
+            m_eigen_cv.wait(lock, [this]() { return m_eigen_stopping || m_eigen_has_job; });
+            if (m_eigen_stopping) {
+                return;
+            }
+            job = std::move(m_eigen_job);
+            m_eigen_job = QuantumEvolutionEngine::EigenBatch();
+            m_eigen_has_job = false;
+            m_eigen_running = true;
+            m_eigen_cancel = false;
+        }
+
+        QuantumEvolutionEngine::run_eigen_batch(job, 0, job.count(), true);
+        const Dictionary result = QuantumEvolutionEngine::eigen_batch_result(job);
+
+        bool published = false;
+        {
+            std::lock_guard<std::mutex> lock(m_eigen_mutex);
+            m_eigen_running = false;
+            if (!m_eigen_cancel && !m_eigen_stopping) {
+                m_eigen_front = result;
+                m_eigen_ready = true;
+                published = true;
+            }
+            m_eigen_cancel = false;
+        }
+        if (published) {
+            // Signals are main-thread only: queue the emit for the next idle
+            call_deferred("emit_signal", "eigenstates_ready");
+        }
+    }
+}
+
+Dictionary MultiBiomeLookaheadEngine::evolve_branches(int biome_id, const PackedFloat64Array& base_rho,
+                                                      const Array& actions, int steps, float dt, float max_dt,
+                                                      int prefix_steps) {
+    typedef QuantumEvolutionEngine::RhoMatrix RhoMatrix;
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    NATIVE_TRACE_ZONE_ID("branches", biome_id);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for evolve_branches ", biome_id);
+        return Dictionary();
+    }
+    const Ref<QuantumEvolutionEngine>& engine = _engine(biome_id);
+    const int d = engine->get_dimension();
+    const int64_t stride = static_cast<int64_t>(d) * d * 2;
+    if (base_rho.size() != stride) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: evolve_branches base_rho size does not match dimension");
+        return Dictionary();
+    }
+    steps = std::max(steps, 0);
+    const int num_qubits = m_num_qubits[biome_id];
+    const int count = static_cast<int>(actions.size());
+
+    // Shared prefix, evolved once
+    PackedFloat64Array prefix = base_rho;
+    for (int step = 0; step < prefix_steps; step++) {
+        engine->evolve_inplace(prefix, dt, max_dt);
+    }
+
+    // Branch roots
+    std::vector<PackedFloat64Array> branches(count);
+    PackedInt32Array valid;
+    valid.resize(count);
+    for (int b = 0; b < count; b++) {
+        const PackedFloat64Array op = actions[b];
+        branches[b] = op.is_empty() ? prefix : engine->apply_operator(prefix, op);
+        valid.set(b, branches[b].size() == stride ? 1 : 0);
+    }
+
+    PackedFloat64Array bloch, purity, mean_purity;
+    bloch.resize(static_cast<int64_t>(count) * num_qubits * 8);
+    bloch.fill(0.0);
+    purity.resize(count);
+    purity.fill(0.0);
+    mean_purity.resize(count);
+    mean_purity.fill(0.0);
+    double* mean = mean_purity.ptrw();
+
+    std::vector<int> live;
+    for (int b = 0; b < count; b++) {
+        if (valid[b]) {
+            live.push_back(b);
+        }
+    }
+    const int num_live = static_cast<int>(live.size());
+
+    // Blocks of one batch per pool chunk, all sharing one operator set (the
+    // short last chunk is padded with zero blocks, which stay zero)
+    const int chunks = std::max(1, std::min(num_live, NativeThreadPool::shared().thread_count()));
+    const int per_chunk = (num_live + chunks - 1) / chunks;
+    std::shared_ptr<const QuantumEvolutionEngine::BatchedOperators> ops;
+    if (engine->is_batchable() && num_live > 1 && steps > 0) {
+        std::vector<const QuantumEvolutionEngine*> copies(per_chunk, engine.ptr());
+        ops = QuantumEvolutionEngine::build_batched_operators(copies);
+    }
+
+    if (ops) {
+        // Euler evolve() advances one step of max_dt (dt ignored), so do the same
+        const double h = (max_dt > 0.0f) ? static_cast<double>(max_dt) : static_cast<double>(dt);
+        auto chunk_range = [&](int begin, int end) {
+            for (int c = begin; c < end; c++) {
+                const int first = c * per_chunk;
+                const int last = std::min(num_live, first + per_chunk);
+                if (first >= last) {
+                    continue;
+                }
+                RhoMatrix stack = RhoMatrix::Zero(static_cast<Eigen::Index>(per_chunk) * d, d);
+                for (int i = first; i < last; i++) {
+                    stack.middleRows((i - first) * d, d) = Eigen::Map<const RhoMatrix>(
+                        reinterpret_cast<const std::complex<double>*>(branches[live[i]].ptr()), d, d);
+                }
+                QuantumEvolutionEngine::BatchedWorkspace work;
+                for (int step = 0; step < steps; step++) {
+                    QuantumEvolutionEngine::euler_step_batched(*ops, stack, h, work);
+                    for (int i = first; i < last; i++) {
+                        mean[live[i]] += stack.middleRows((i - first) * d, d).squaredNorm();
+                    }
+                }
+                for (int i = first; i < last; i++) {
+                    Eigen::Map<RhoMatrix>(reinterpret_cast<std::complex<double>*>(branches[live[i]].ptrw()), d, d) =
+                        stack.middleRows((i - first) * d, d);
+                }
+            }
+        };
+        NativeThreadPool::shared().parallel_for(0, chunks, chunks, chunk_range);
+    } else {
+        // The engine's integrator keeps per-call scratch: one branch at a time
+        for (int b : live) {
+            for (int step = 0; step < steps; step++) {
+                engine->evolve_inplace(branches[b], dt, max_dt);
+                mean[b] += Eigen::Map<const RhoMatrix>(
+                               reinterpret_cast<const std::complex<double>*>(branches[b].ptr()), d, d)
+                               .squaredNorm();
+            }
+        }
+    }
+
+    for (int b : live) {
+        const PackedFloat64Array final_bloch = engine->compute_bloch_metrics_from_packed(branches[b], num_qubits);
+        std::copy(final_bloch.ptr(), final_bloch.ptr() + final_bloch.size(),
+                  bloch.ptrw() + static_cast<int64_t>(b) * num_qubits * 8);
+        const double final_purity = Eigen::Map<const RhoMatrix>(
+            reinterpret_cast<const std::complex<double>*>(branches[b].ptr()), d, d).squaredNorm();
+        purity.set(b, final_purity);
+        mean[b] = steps > 0 ? mean[b] / steps : final_purity;
+    }
+
+    Dictionary result;
+    result["num_branches"] = count;
+    result["steps"] = steps;
+    result["valid"] = valid;
+    result["bloch"] = bloch;
+    result["purity"] = purity;
+    result["mean_purity"] = mean_purity;
+    return result;
+}
+
+Dictionary MultiBiomeLookaheadEngine::evolve_single_biome(
+    int biome_id, const PackedFloat64Array& rho_packed,
+    int steps, float dt, float max_dt, int observables) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+
+    Dictionary result;
+
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size())) {
+        UtilityFunctions::push_warning(
+            "MultiBiomeLookaheadEngine: Invalid biome_id ", biome_id);
+        return result;
+    }
+
+    BiomeStepResult biome_result;
+    if (_should_evolve(biome_id, rho_packed)) {
+        const CostSnapshot cost_before = _cost_snapshot(biome_id);
+        biome_result = _evolve_biome_steps(biome_id, rho_packed, steps, dt, max_dt, true, nullptr, observables);
+        _update_cost_model(biome_id, cost_before);
+    }
+    // else: inactive, biome_result remains empty
+
+    // Convert to Godot types
+    Array biome_steps;
+    for (const auto& step_rho : biome_result.steps) {
+        biome_steps.push_back(step_rho);
+    }
+
+    result["results"] = biome_steps;
+    if (!biome_result.mi_steps.empty()) {
+        result["mi"] = biome_result.mi_steps.back();
+    } else {
+        result["mi"] = PackedFloat64Array();
+    }
+
+    Array biome_mi_steps;
+    for (const auto& mi_step : biome_result.mi_steps) {
+        biome_mi_steps.push_back(mi_step);
+    }
+    result["mi_steps"] = biome_mi_steps;
+
+    Array biome_bloch_steps;
+    for (const auto& bloch_step : biome_result.bloch_steps) {
+        biome_bloch_steps.push_back(bloch_step);
+    }
+    result["bloch_steps"] = biome_bloch_steps;
+
+    Array biome_purity_steps;
+    for (double purity_val : biome_result.purity_steps) {
+        biome_purity_steps.push_back(purity_val);
+    }
+    result["purity_steps"] = biome_purity_steps;
+
+    if (biome_id >= 0 && biome_id < static_cast<int>(m_metadata.size())) {
+        result["metadata"] = m_metadata[biome_id];
+    }
+    if (biome_id >= 0 && biome_id < static_cast<int>(m_couplings.size())) {
+        result["couplings"] = m_couplings[biome_id];
+    }
+    result["icon_map"] = biome_result.icon_map;
+
+    return result;
+}
+
+MultiBiomeLookaheadEngine::BiomeStepResult
+MultiBiomeLookaheadEngine::_frozen_steps(
+    int biome_id, const PackedFloat64Array& rho_packed, int steps, bool compute_mi, int observables) {
+    BiomeStepResult out;
+    const int num_qubits = m_num_qubits[biome_id];
+    compute_mi = compute_mi && (observables & LOOKAHEAD_MI);
+    const int mask = step_observable_mask(observables, compute_mi);
+    const PackedFloat64Array values =
+        mask ? _engine(biome_id)->compute_observables_from_packed(rho_packed, num_qubits, mask)
+             : PackedFloat64Array();
+    const ObservableSpans spans = observable_spans(num_qubits, mask);
+    const PackedFloat64Array bloch = values.slice(0, std::min<int64_t>(spans.bloch_len, values.size()));
+    const double purity = (spans.purity_at >= 0 && values.size() > spans.purity_at) ? values[spans.purity_at] : 0.0;
+    const PackedFloat64Array mi = compute_mi ? values.slice(spans.mi_at) : PackedFloat64Array();
+    const bool want_positions = observables & LOOKAHEAD_POSITIONS;
+    const PackedVector2Array positions =
+        want_positions ? m_force_engine->get_layout_positions(m_force_layouts[biome_id]) : PackedVector2Array();
+    const PackedVector2Array velocities =
+        want_positions ? m_force_engine->get_layout_velocities(m_force_layouts[biome_id]) : PackedVector2Array();
+
+    // Copy-on-write shares: every step references the same buffers
+    for (int step = 0; step < steps; step++) {
+        out.steps.push_back(rho_packed);
+        if (observables & LOOKAHEAD_BLOCH) {
+            out.bloch_steps.push_back(bloch);
+        }
+        if (observables & LOOKAHEAD_PURITY) {
+            out.purity_steps.push_back(purity);
+        }
+        if (compute_mi) {
+            out.mi_steps.push_back(mi);
+        }
+        if (want_positions) {
+            out.position_steps.push_back(positions);
+            out.velocity_steps.push_back(velocities);
+        }
+    }
+    if (observables & LOOKAHEAD_ICON_MAP) {
+        out.icon_map = _build_icon_map(biome_id, std::vector<PackedFloat64Array>(steps, bloch));
+    }
+    return out;
+}
+
+MultiBiomeLookaheadEngine::BiomeStepResult
+MultiBiomeLookaheadEngine::_evolve_biome_steps(
+    int biome_id, const PackedFloat64Array& rho_packed,
+    int steps, float dt, float max_dt, bool compute_mi,
+    const PackedFloat64Array* batched_frames, int observables) {
+    BiomeStepResult out;
+    _evolve_biome_steps_into(out, biome_id, rho_packed, steps, dt, max_dt, compute_mi, batched_frames, nullptr,
+                             observables);
+    return out;
+}
+
+void MultiBiomeLookaheadEngine::_evolve_biome_steps_into(
+    BiomeStepResult& out, int biome_id, const PackedFloat64Array& rho_packed,
+    int steps, float dt, float max_dt, bool compute_mi,
+    const PackedFloat64Array* batched_frames, FrameArena* arena, int observables) {
+
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size())) {
+        return;
+    }
+
+    ScopedProfile profile(m_biome_profile[biome_id].steps);
+    NATIVE_TRACE_ZONE_ID("biome", biome_id);
+
+    _check_stationary(biome_id, rho_packed);
+    const int lod = get_effective_biome_lod(biome_id);
+    if (lod == LOD_FROZEN) {
+        out = _frozen_steps(biome_id, rho_packed, steps, compute_mi, observables);
+        return;
+    }
+    max_dt = _lod_max_dt(biome_id, lod, dt, max_dt);
+    const int mi_stride = _mi_stride(lod);
+
+    // Stages the observables mask leaves without a consumer are skipped
+    compute_mi = compute_mi && (observables & LOOKAHEAD_MI);
+    const bool want_bloch = observables & LOOKAHEAD_BLOCH;
+    const bool want_purity = observables & LOOKAHEAD_PURITY;
+    const bool want_positions = observables & LOOKAHEAD_POSITIONS;
+    const bool want_icon_map = observables & LOOKAHEAD_ICON_MAP;
+    const bool full_rho = observables & LOOKAHEAD_FULL_RHO;
+    std::vector<PackedFloat64Array> icon_bloch;  // Icon map input when Bloch isn't returned
+
+    Ref<QuantumEvolutionEngine> engine = _engine(biome_id);
+    int num_qubits = m_num_qubits[biome_id];
+
+    // Start with current rho
+    PackedFloat64Array current_rho = rho_packed;
+
+    // This biome's persistent force layout, stepped in place (all nodes active)
+    const int layout = m_force_layouts[biome_id];
+    ForceGraphEngine::NodeBuffers* nodes = m_force_engine->get_layout(layout);
+    Vector2 biome_center = m_biome_centers[biome_id];
+
+    // Without LNN modulation the steps don't feed back through Godot data, so
+    // the whole trajectory is evolved natively into one contiguous buffer and
+    // observables are read straight from each frame
+    // Trajectory-ensemble biomes sample their ensemble from ρ once, then
+    // estimate every observable from the ensemble (no LNN: there is no dense ρ
+    // to modulate between steps)
+    Ref<QuantumTrajectoryEngine> ensemble = m_trajectory_engines[biome_id];
+    const bool use_ensemble = ensemble.is_valid() && ensemble->initialize_from_rho(current_rho);
+    const float ensemble_span = _ensemble_step_span(biome_id, dt, max_dt);
+
+    // Large biomes never materialize the steps·dim² trajectory: one buffer
+    // is evolved in place and only the last state is returned
+    const bool large = is_large_biome(biome_id);
+    const bool native_trajectory = !use_ensemble && !is_lnn_enabled(biome_id) && !large;
+    const int dim = engine->get_dimension();
+    const int64_t stride = static_cast<int64_t>(dim) * dim * 2;
+    // Result arrays come from this biome's pool (see m_result_pool); the
+    // trajectory buffer never leaves the engine, so it is always reused
+    ResultBuffers& pool = m_result_pool[biome_id];
+    const bool own_frames = native_trajectory && !batched_frames;
+    PackedFloat64Array frames;
+    if (native_trajectory) {
+        if (batched_frames) {
+            frames = *batched_frames;  // Already evolved with its equal-dimension group
+        } else {
+            frames = std::move(pool.frames);
+            engine->evolve_trajectory_into(current_rho, steps, dt, max_dt, frames);
+        }
+    }
+
+    // Dense biomes read Bloch, purity and (optionally) MI from one fused
+    // sweep per step: [bloch n·8][purity][mi n(n-1)/2], each section only
+    // when the observables mask needs it
+    // OPTIMIZED MI: Adaptive computation with screening + high-purity approximation
+    // - Candidate pairs (with hysteresis) persist in the engine across refills
+    // - Each call re-screens a small rotating subset of non-candidates
+    // - Uses linear entropy (no eigendecomp) when purity > 0.9
+    const double* last_mi = nullptr;  // Reused between recomputes at reduced LOD
+    int64_t last_mi_len = 0;
+    std::vector<double> mi_edges;  // Force springs [i, j, mi], rebuilt on MI steps only
+
+    // Observables and layout snapshots of every step go to flat native
+    // buffers (from the frame arena when the caller has one); their packed
+    // arrays are built once, after the loop
+    StepOutputs flat;
+    flat.slot = QuantumEvolutionEngine::observables_size(
+        num_qubits, QuantumEvolutionEngine::OBSERVABLE_BLOCH | QuantumEvolutionEngine::OBSERVABLE_PURITY |
+                        QuantumEvolutionEngine::OBSERVABLE_MI);
+    flat.nodes = (nodes && want_positions) ? nodes->size() : 0;
+    const size_t flat_observables = static_cast<size_t>(std::max(steps, 0)) * flat.slot;
+    const size_t flat_layout = static_cast<size_t>(std::max(steps, 0)) * flat.nodes * 4;
+    std::vector<double> observables_local;
+    std::vector<StepSpan> spans_local;
+    std::vector<float> layout_local;
+    if (arena) {
+        flat.observables = arena->alloc<double>(flat_observables);
+        flat.spans = arena->alloc<StepSpan>(std::max(steps, 0));
+        flat.layout = arena->alloc<float>(flat_layout);
+    } else {
+        observables_local.resize(flat_observables);
+        spans_local.resize(std::max(steps, 0));
+        layout_local.resize(flat_layout);
+        flat.observables = observables_local.data();
+        flat.spans = spans_local.data();
+        flat.layout = layout_local.data();
+    }
+
+    out.steps.reserve(steps);
+    out.bloch_steps.reserve(want_bloch ? steps : 0);
+    out.purity_steps.reserve(want_purity ? steps : 0);
+    out.mi_steps.reserve(compute_mi ? steps : 0);
+    out.position_steps.reserve(want_positions ? steps : 0);
+    out.velocity_steps.reserve(want_positions ? steps : 0);
+
+    // Steady-state detection on plain dense evolution (an LNN keeps driving it)
+    SteadyState& steady = m_steady[biome_id];
+    const double step_time = _ensemble_step_span(biome_id, dt, max_dt);  // Time one step covers
+    const bool detect_steady = m_steady_tolerance > 0.0 && step_time > 0.0 && !use_ensemble &&
+                               !is_lnn_enabled(biome_id) && ensemble.is_null() && !large;
+    // Previous state for steady detection (frames aren't sliced without FULL_RHO)
+    const double* previous_ptr = current_rho.size() == stride ? current_rho.ptr() : nullptr;
+
+    // Evolve for each step
+    for (int step = 0; step < steps; step++) {
+        NATIVE_TRACE_ZONE_ID("step", step);
+        NativeCounters::add(COUNTER_LOOKAHEAD_STEPS_COMPUTED, 1);
+        const bool mi_now = compute_mi && (step % mi_stride == 0);
+        // The last state is always kept (it seeds steady-state and the caller's next frame)
+        const bool keep_rho = full_rho || step + 1 == steps || _step_cancelled();
+        const int observable_mask = step_observable_mask(observables, mi_now);
+        const bool need_bloch = observable_mask & QuantumEvolutionEngine::OBSERVABLE_BLOCH;
+        PackedFloat64Array evolved_rho;
+        const double* evolved_ptr = nullptr;
+        double* slot = flat.observables + static_cast<size_t>(step) * flat.slot;
+        StepSpan& span = flat.spans[step];
+        span = StepSpan();
+        double purity = 0.0;
+        if (use_ensemble) {
+            ScopedProfile ensemble_profile(m_biome_profile[biome_id].ensemble);
+            NATIVE_TRACE_ZONE_ID("ensemble", biome_id);
+            ensemble->evolve(ensemble_span, max_dt);
+            if (keep_rho) {
+                evolved_rho = ensemble->get_density_matrix();
+            }
+            if (need_bloch) {
+                const PackedFloat64Array bloch = ensemble->compute_bloch_metrics(num_qubits);
+                span.bloch_len = static_cast<int32_t>(std::min<int64_t>(bloch.size(), flat.slot));
+                std::copy(bloch.ptr(), bloch.ptr() + span.bloch_len, slot);
+            }
+            if (want_purity) {
+                purity = ensemble->compute_purity();
+            }
+            if (mi_now) {
+                const PackedFloat64Array mi = ensemble->compute_all_mutual_information(num_qubits);
+                span.mi_at = span.bloch_len;
+                span.mi_len = static_cast<int32_t>(std::min<int64_t>(mi.size(), flat.slot - span.mi_at));
+                std::copy(mi.ptr(), mi.ptr() + span.mi_len, slot + span.mi_at);
+            }
+        } else {
+            // Observables land straight in the step's flat slot
+            int observables_size = QuantumEvolutionEngine::observables_size(num_qubits, observable_mask);
+            if (native_trajectory) {
+                evolved_ptr = frames.ptr() + step * stride;
+                Eigen::Map<const QuantumEvolutionEngine::RhoMatrix> frame(
+                    reinterpret_cast<const std::complex<double>*>(evolved_ptr), dim, dim);
+                if (keep_rho) {
+                    double* kept = _take_result_buffer(pool.rho, step, stride, evolved_rho);
+                    std::copy(evolved_ptr, evolved_ptr + stride, kept);
+                }
+                if (observables_size > 0) {
+                    engine->compute_observables_into(frame, num_qubits, observable_mask, slot);
+                }
+            } else {
+                // Single evolution step, evolved in place on the step's own buffer
+                // (the copy-on-write share with current_rho is split once, by ptrw;
+                // large biomes keep no per-step copy, so theirs is never shared)
+                if (large) {
+                    engine->evolve_inplace(current_rho, dt, max_dt);
+                    evolved_rho = current_rho;
+                } else if (current_rho.size() == stride) {
+                    double* next = _take_result_buffer(pool.rho, step, stride, evolved_rho);
+                    std::copy(current_rho.ptr(), current_rho.ptr() + stride, next);
+                    engine->evolve_inplace(evolved_rho, dt, max_dt);
+                } else {
+                    evolved_rho = current_rho;
+                    engine->evolve_inplace(evolved_rho, dt, max_dt);
+                }
+
+                // Apply phase-shadow LNN modulation
+                _apply_lnn_phase_modulation(biome_id, evolved_rho);
+
+                if (evolved_rho.size() == stride) {
+                    evolved_ptr = evolved_rho.ptr();
+                    Eigen::Map<const QuantumEvolutionEngine::RhoMatrix> frame(
+                        reinterpret_cast<const std::complex<double>*>(evolved_ptr), dim, dim);
+                    if (observables_size > 0) {
+                        engine->compute_observables_into(frame, num_qubits, observable_mask, slot);
+                    }
+                } else {
+                    observables_size = 0;  // As compute_observables_from_packed's empty result
+                }
+            }
+            const ObservableSpans spans = observable_spans(num_qubits, observable_mask);
+            span.bloch_len = static_cast<int32_t>(std::min<int64_t>(spans.bloch_len, observables_size));
+            purity = (spans.purity_at >= 0 && observables_size > spans.purity_at) ? slot[spans.purity_at] : 0.0;
+            if (mi_now) {
+                span.mi_at = static_cast<int32_t>(std::min<int64_t>(spans.mi_at, observables_size));
+                span.mi_len = static_cast<int32_t>(std::max<int64_t>(0, observables_size - spans.mi_at));
+            }
+        }
+        if (span.mi_len >= 0) {
+            last_mi = slot + span.mi_at;
+            last_mi_len = span.mi_len;
+        }
+
+        // Store result (observables only before a large biome's last step,
+        // or every step but the last without FULL_RHO)
+        out.steps.push_back(((large || !full_rho) && step + 1 < steps) ? PackedFloat64Array() : evolved_rho);
+        if (want_purity) {
+            out.purity_steps.push_back(purity);
+        }
+        if (!use_ensemble && !evolved_rho.is_empty() && (native_trajectory || !large)) {
+            _keep_result_buffer(pool.rho, step, evolved_rho);
+        }
+
+        // Compute force-directed positions using Bloch + MI data
+        if (nodes && want_positions) {
+            ScopedProfile force_profile(m_biome_profile[biome_id].force);
+            NATIVE_TRACE_ZONE_ID("force", biome_id);
+            // Correlation springs only for the adaptive MI candidates; the
+            // list only changes with MI (and the candidate set) itself
+            if (mi_now || step == 0) {
+                engine->mi_edges_into(last_mi, static_cast<int>(last_mi_len), num_qubits, mi_edges);
+            }
+            ForceGraphEngine::StepInputs in;
+            in.bloch = slot;
+            in.bloch_size = span.bloch_len;
+            in.mi_edges = mi_edges.data();
+            in.mi_edge_count = static_cast<int>(mi_edges.size() / 3);
+            in.center_x = biome_center.x;
+            in.center_y = biome_center.y;
+            in.dt = dt;
+            in.accumulate = true;
+            m_force_engine->step_nodes(*nodes, in);
+        }
+        // Frames keep their own snapshot of the layout
+        _snapshot_layout(nodes, flat, step);
+        flat.steps = step + 1;
+
+        if (detect_steady && evolved_ptr && previous_ptr) {
+            const Eigen::Map<const Eigen::VectorXd> before(previous_ptr, stride);
+            const Eigen::Map<const Eigen::VectorXd> after(evolved_ptr, stride);
+            const bool still = (after - before).norm() < m_steady_tolerance * step_time;
+            steady.still_steps = still ? steady.still_steps + 1 : 0;
+        }
+        previous_ptr = evolved_ptr;
+
+        // Update for next step (unsliced trajectory frames stay in frames)
+        if (!evolved_rho.is_empty() || !native_trajectory) {
+            current_rho = evolved_rho;
+        }
+
+        // Async cancel: stop at the step boundary (result is discarded)
+        if (_step_cancelled()) {
+            break;
+        }
+    }
+
+    if (own_frames) {
+        pool.frames = std::move(frames);
+    }
+
+    // Converged: the next evolve from this state is skipped
+    if (detect_steady && steady.still_steps >= m_steady_window) {
+        steady.stationary = true;
+        steady.rho = current_rho;
+        steady.drift = m_steady_tolerance * step_time * m_steady_window;
+    }
+
+    _assemble_step_outputs(biome_id, flat, want_bloch, want_icon_map && !want_bloch, compute_mi, want_positions, out,
+                           icon_bloch);
+    if (want_icon_map) {
+        out.icon_map = _build_icon_map(biome_id, want_bloch ? out.bloch_steps : icon_bloch);
+    }
+}
+
+void MultiBiomeLookaheadEngine::_snapshot_layout(const ForceGraphEngine::NodeBuffers* nodes, StepOutputs& flat,
+                                                 int step) {
+    if (!nodes || flat.nodes <= 0) {
+        return;
+    }
+    float* dst = flat.layout + static_cast<size_t>(step) * flat.nodes * 4;
+    const int count = std::min(flat.nodes, nodes->size());
+    for (int i = 0; i < count; i++) {
+        dst[i * 4 + 0] = nodes->x[i];
+        dst[i * 4 + 1] = nodes->y[i];
+        dst[i * 4 + 2] = nodes->vx[i];
+        dst[i * 4 + 3] = nodes->vy[i];
+    }
+}
+
+void MultiBiomeLookaheadEngine::_assemble_step_outputs(int biome_id, const StepOutputs& flat, bool bloch,
+                                                       bool icon_bloch_only, bool mi, bool positions,
+                                                       BiomeStepResult& out,
+                                                       std::vector<PackedFloat64Array>& icon_bloch) {
+    ResultBuffers& pool = m_result_pool[biome_id];
+    PackedFloat64Array last_mi;  // Steps between MI recomputes share the last one
+    for (int step = 0; step < flat.steps; step++) {
+        const double* slot = flat.observables + static_cast<size_t>(step) * flat.slot;
+        const StepSpan& span = flat.spans[step];
+        if (bloch || icon_bloch_only) {
+            PackedFloat64Array packet;
+            std::copy(slot, slot + span.bloch_len, _take_result_buffer(pool.bloch, step, span.bloch_len, packet));
+            _keep_result_buffer(pool.bloch, step, packet);
+            (bloch ? out.bloch_steps : icon_bloch).push_back(packet);
+        }
+        if (mi) {
+            if (span.mi_len >= 0) {
+                std::copy(slot + span.mi_at, slot + span.mi_at + span.mi_len,
+                          _take_result_buffer(pool.mi, step, span.mi_len, last_mi));
+                _keep_result_buffer(pool.mi, step, last_mi);
+            }
+            out.mi_steps.push_back(last_mi);
+        }
+        if (positions) {
+            PackedVector2Array position, velocity;
+            if (flat.nodes > 0) {
+                position.resize(flat.nodes);
+                velocity.resize(flat.nodes);
+                Vector2* p = position.ptrw();
+                Vector2* v = velocity.ptrw();
+                const float* src = flat.layout + static_cast<size_t>(step) * flat.nodes * 4;
+                for (int i = 0; i < flat.nodes; i++) {
+                    p[i] = Vector2(src[i * 4 + 0], src[i * 4 + 1]);
+                    v[i] = Vector2(src[i * 4 + 2], src[i * 4 + 3]);
+                }
+            }
+            out.position_steps.push_back(position);
+            out.velocity_steps.push_back(velocity);
+        }
+    }
+}
+
+// ============================================================================
+// PHASE-SHADOW LNN METHODS
+// ============================================================================
+
+void MultiBiomeLookaheadEngine::enable_biome_lnn(int biome_id, int hidden_size, const String& weights_path) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for LNN ", biome_id);
+        return;
+    }
+
+    // Get dimension from the engine
+    int dim = _engine(biome_id)->get_dimension();
+    if (dim <= 0) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid dimension for LNN");
+        return;
+    }
+
+    // Create LNN: input = dim phases, output = dim phase modulations, from
+    // the snapshot when one is given and fits
+    std::shared_ptr<LiquidNeuralNet> lnn;
+    if (!weights_path.is_empty()) {
+        lnn = _read_lnn_file(weights_path, dim, hidden_size);
+    }
+    const bool warm = (lnn != nullptr);
+    if (!warm) {
+        lnn = std::make_shared<LiquidNeuralNet>(dim, hidden_size, dim);
+    }
+    m_lnns[biome_id] = lnn;
+    m_lnn_hidden[biome_id] = lnn->hidden_state;
+    _prepare_lnn(biome_id);
+
+    UtilityFunctions::print("MultiBiomeLookaheadEngine: LNN enabled for biome ", biome_id,
+                            " (dim=", dim, ", hidden=", hidden_size, warm ? ", warm start" : "", ")");
+}
+
+std::shared_ptr<LiquidNeuralNet> MultiBiomeLookaheadEngine::_read_lnn_file(const String& path, int dim,
+                                                                           int hidden_size) {
+    const PackedByteArray bytes = FileAccess::get_file_as_bytes(path);
+    std::shared_ptr<LiquidNeuralNet> lnn = LiquidNeuralNet::from_weights(bytes.ptr(), bytes.size());
+    if (!lnn) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: ", path, " is not a version ",
+                                       static_cast<int>(LiquidNeuralNet::WEIGHTS_VERSION), " LNN weight snapshot");
+        return nullptr;
+    }
+    if (lnn->input_size != dim || lnn->output_size != dim || (hidden_size >= 0 && lnn->hidden_size != hidden_size)) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: LNN snapshot ", path, " is ", lnn->input_size,
+                                       "->", lnn->hidden_size, "->", lnn->output_size, ", biome needs ", dim, "->",
+                                       hidden_size >= 0 ? hidden_size : lnn->hidden_size, "->", dim);
+        return nullptr;
+    }
+    return lnn;
+}
+
+bool MultiBiomeLookaheadEngine::save_biome_lnn(int biome_id, const String& path) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_lnns.size()) || !m_lnns[biome_id]) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: save_biome_lnn needs an LNN-enabled biome");
+        return false;
+    }
+    const LiquidNeuralNet& lnn = *m_lnns[biome_id];
+    PackedByteArray bytes;
+    bytes.resize(static_cast<int64_t>(lnn.weights_byte_size()));
+    lnn.save_weights(bytes.ptrw());
+
+    Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+    if (file.is_null()) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Cannot open ", path, " for writing (error ",
+                                       static_cast<int>(FileAccess::get_open_error()), ")");
+        return false;
+    }
+    file->store_buffer(bytes);
+    file->close();
+    return true;
+}
+
+bool MultiBiomeLookaheadEngine::load_biome_lnn(int biome_id, const String& path) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size()) || _engine(biome_id).is_null()) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for load_biome_lnn");
+        return false;
+    }
+    std::shared_ptr<LiquidNeuralNet> lnn = _read_lnn_file(path, _engine(biome_id)->get_dimension(), -1);
+    if (!lnn) {
+        return false;
+    }
+    m_lnns[biome_id] = lnn;
+    m_lnn_hidden[biome_id] = lnn->hidden_state;
+    _prepare_lnn(biome_id);
+    return true;
+}
+
+void MultiBiomeLookaheadEngine::enable_shared_lnn(const PackedInt32Array& biome_ids, int hidden_size) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    int dim = -1;
+    for (int k = 0; k < biome_ids.size(); k++) {
+        const int biome_id = biome_ids[k];
+        if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size())) {
+            UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for shared LNN ", biome_id);
+            return;
+        }
+        const int biome_dim = _engine(biome_id)->get_dimension();
+        if (biome_dim <= 0 || (dim >= 0 && biome_dim != dim)) {
+            UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Shared LNN needs biomes of one dimension");
+            return;
+        }
+        dim = biome_dim;
+    }
+    if (dim < 0) {
+        return;
+    }
+
+    auto lnn = std::make_shared<LiquidNeuralNet>(dim, hidden_size, dim);
+    for (int k = 0; k < biome_ids.size(); k++) {
+        m_lnns[biome_ids[k]] = lnn;
+        lnn->reset_state();  // Independent random start per biome
+        m_lnn_hidden[biome_ids[k]] = lnn->hidden_state;
+        _prepare_lnn(biome_ids[k]);
+    }
+
+    UtilityFunctions::print("MultiBiomeLookaheadEngine: Shared LNN enabled for ", biome_ids.size(),
+                            " biomes (dim=", dim, ", hidden=", hidden_size, ")");
+}
+
+void MultiBiomeLookaheadEngine::disable_biome_lnn(int biome_id) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_lnns.size())) {
+        return;
+    }
+    m_lnns[biome_id].reset();
+    m_lnn_hidden[biome_id] = Eigen::VectorXd();
+    m_lnn_kernels[biome_id].reset();
+    m_lnn_scratch[biome_id] = LnnScratch();
+    m_lnn_training[biome_id] = LnnTraining();
+}
+
+void MultiBiomeLookaheadEngine::_prepare_lnn(int biome_id) {
+    if (!m_lnns[biome_id]) {
+        m_lnn_kernels[biome_id].reset();
+        return;
+    }
+    const LiquidNeuralNet& lnn = *m_lnns[biome_id];
+    m_lnn_kernels[biome_id] = make_lnn_kernel(lnn, _engine(biome_id)->get_single_precision());
+    LnnScratch& scratch = m_lnn_scratch[biome_id];
+    scratch.phases.resize(lnn.input_size);
+    scratch.deltas.resize(lnn.output_size);
+    scratch.activation.resize(lnn.hidden_size);
+    scratch.work.resize(2 * std::max(lnn.input_size, lnn.output_size));
+    scratch.prev_deltas.setZero(lnn.output_size);
+    scratch.deltas.setZero();
+    scratch.interp_deltas.resize(lnn.output_size);
+    scratch.substep = 0;
+    LnnTraining& training = m_lnn_training[biome_id];
+    if (training.window > 0 && (training.phases.rows() != lnn.input_size ||
+                                training.hidden.rows() != lnn.hidden_size)) {
+        // New network shape: restart the recording
+        training.phases.resize(lnn.input_size, training.window);
+        training.hidden.resize(lnn.hidden_size, training.window);
+        training.head = 0;
+        training.count = 0;
+    }
+}
+
+void MultiBiomeLookaheadEngine::set_lnn_recording(int biome_id, int window) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_lnn_training.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for set_lnn_recording");
+        return;
+    }
+    LnnTraining& training = m_lnn_training[biome_id];
+    training.window = std::max(0, window);
+    training.head = 0;
+    training.count = 0;
+    if (training.window == 0 || !m_lnns[biome_id]) {
+        training.phases = Eigen::MatrixXd();
+        training.hidden = Eigen::MatrixXd();
+        return;
+    }
+    training.phases.resize(m_lnns[biome_id]->input_size, training.window);
+    training.hidden.resize(m_lnns[biome_id]->hidden_size, training.window);
+}
+
+bool MultiBiomeLookaheadEngine::train_lnn_async(int biome_id, int truncation, int epochs) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_lnns.size()) || !m_lnns[biome_id]) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: train_lnn_async needs an LNN-enabled biome");
+        return false;
+    }
+    _adopt_trained_lnn(biome_id);
+    LnnTraining& training = m_lnn_training[biome_id];
+    if (training.job || training.count < 2 || training.phases.rows() != m_lnns[biome_id]->input_size) {
+        return false;
+    }
+
+    // Unroll the ring oldest-first: input t = phases t, target t = wrapped
+    // phase change from pass t to pass t + 1
+    const std::shared_ptr<LiquidNeuralNet>& lnn = m_lnns[biome_id];
+    const int samples = training.count - 1;
+    const int oldest = (training.head - training.count + training.window) % training.window;
+    const int rows = std::min(lnn->input_size, lnn->output_size);
+    Eigen::MatrixXd inputs(lnn->input_size, samples);
+    Eigen::MatrixXd targets = Eigen::MatrixXd::Zero(lnn->output_size, samples);
+    for (int t = 0; t < samples; t++) {
+        const int col = (oldest + t) % training.window;
+        const int next = (col + 1) % training.window;
+        inputs.col(t) = training.phases.col(col);
+        for (int i = 0; i < rows; i++) {
+            targets(i, t) = std::remainder(training.phases(i, next) - training.phases(i, col), 2.0 * Math_PI);
+        }
+    }
+    Eigen::VectorXd h0 = training.hidden.col(oldest);
+
+    auto job = m_lnn_trainer.submit(lnn, std::move(inputs), std::move(targets), std::move(h0), truncation, epochs);
+    for (size_t b = 0; b < m_lnns.size(); b++) {
+        if (m_lnns[b] == lnn) {
+            m_lnn_training[b].job = job;  // Every biome sharing the network adopts the result
+        }
+    }
+    return true;
+}
+
+bool MultiBiomeLookaheadEngine::is_lnn_training(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_lnn_training.size())) {
+        return false;
+    }
+    const std::shared_ptr<LnnTrainer::Job>& job = m_lnn_training[biome_id].job;
+    return job && !job->done.load(std::memory_order_acquire);
+}
+
+double MultiBiomeLookaheadEngine::get_lnn_training_loss(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_lnn_training.size())) {
+        return -1.0;
+    }
+    const std::shared_ptr<LnnTrainer::Job>& job = m_lnn_training[biome_id].job;
+    if (job && job->done.load(std::memory_order_acquire)) {
+        return job->loss;
+    }
+    return m_lnn_training[biome_id].last_loss;
+}
+
+void MultiBiomeLookaheadEngine::_lnn_record(int biome_id, const double* phases, const double* hidden) {
+    LnnTraining& training = m_lnn_training[biome_id];
+    if (training.window == 0) {
+        return;
+    }
+    training.phases.col(training.head) = Eigen::Map<const Eigen::VectorXd>(phases, training.phases.rows());
+    training.hidden.col(training.head) = Eigen::Map<const Eigen::VectorXd>(hidden, training.hidden.rows());
+    training.head = (training.head + 1) % training.window;
+    training.count = std::min(training.count + 1, training.window);
+}
+
+void MultiBiomeLookaheadEngine::_adopt_trained_lnn(int biome_id) {
+    LnnTraining& training = m_lnn_training[biome_id];
+    if (!training.job || !training.job->done.load(std::memory_order_acquire)) {
+        return;
+    }
+    if (m_lnns[biome_id] && m_lnns[biome_id].get() == training.job->source.get()) {
+        m_lnns[biome_id] = training.job->result;
+        _prepare_lnn(biome_id);
+    }
+    training.last_loss = training.job->loss;
+    training.job.reset();
+}
+
+void MultiBiomeLookaheadEngine::set_biome_lnn_stride(int biome_id, int stride) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_lnn_stride.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for set_biome_lnn_stride");
+        return;
+    }
+    m_lnn_stride[biome_id] = std::max(1, stride);
+    m_lnn_scratch[biome_id].substep = 0;
+}
+
+int MultiBiomeLookaheadEngine::get_biome_lnn_stride(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_lnn_stride.size())) {
+        return 1;
+    }
+    return m_lnn_stride[biome_id];
+}
+
+bool MultiBiomeLookaheadEngine::is_lnn_enabled(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_lnns.size())) {
+        return false;
+    }
+    return m_lnns[biome_id] != nullptr;
+}
+
+void MultiBiomeLookaheadEngine::set_biome_precision(int biome_id, bool single_precision,
+                                                    int resync_interval) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size()) || _engine(biome_id).is_null()) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for set_biome_precision");
+        return;
+    }
+    _engine(biome_id)->set_precision_resync_interval(resync_interval);
+    _engine(biome_id)->set_single_precision(single_precision);
+    m_governor_float[biome_id] = 0;  // The caller's choice outlives the governor
+    _prepare_lnn(biome_id);
+}
+
+bool MultiBiomeLookaheadEngine::is_biome_single_precision(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size()) || _engine(biome_id).is_null()) {
+        return false;
+    }
+    return _engine(biome_id)->get_single_precision();
+}
+
+void MultiBiomeLookaheadEngine::set_drift_thresholds(double trace_error, double hermiticity_error,
+                                                     double negative_mass) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_drift_thresholds[0] = trace_error;
+    m_drift_thresholds[1] = hermiticity_error;
+    m_drift_thresholds[2] = negative_mass;
+    for (const Ref<QuantumEvolutionEngine>& engine : m_engines) {
+        if (engine.is_valid()) {
+            engine->set_drift_thresholds(trace_error, hermiticity_error, negative_mass);
+        }
+    }
+}
+
+Dictionary MultiBiomeLookaheadEngine::get_biome_drift_stats(int biome_id) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size()) || _engine(biome_id).is_null()) {
+        return Dictionary();
+    }
+    return _engine(biome_id)->get_drift_stats();
+}
+
+void MultiBiomeLookaheadEngine::set_mi_audit_interval(int calls) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_mi_audit_interval = std::max(0, calls);
+    for (const Ref<QuantumEvolutionEngine>& engine : m_engines) {
+        if (engine.is_valid()) {
+            engine->set_mi_audit_interval(m_mi_audit_interval);
+        }
+    }
+}
+
+int MultiBiomeLookaheadEngine::get_mi_audit_interval() const {
+    return m_mi_audit_interval;
+}
+
+Dictionary MultiBiomeLookaheadEngine::get_biome_mi_screen_stats(int biome_id) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size()) || _engine(biome_id).is_null()) {
+        return Dictionary();
+    }
+    return _engine(biome_id)->get_mi_screen_stats();
+}
+
+void MultiBiomeLookaheadEngine::set_biome_observable_tolerance(int biome_id, double tolerance) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size()) || _engine(biome_id).is_null()) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for set_biome_observable_tolerance");
+        return;
+    }
+    _engine(biome_id)->set_observable_reuse_tolerance(tolerance);
+}
+
+namespace {
+
+// Phase math for the LNN diagonal, written as Eigen array expressions so it
+// runs in packets. Quadrant/octant fix-ups are arithmetic blends on 0/1
+// masks rather than select(), which Eigen evaluates one coefficient at a time.
+
+// atan2 via the Abramowitz & Stegun 4.4.49 polynomial on [0, 1] (|error|
+// below 1e-7); out must not alias x or y
+void fast_atan2(const Eigen::Ref<const Eigen::ArrayXd>& y, const Eigen::Ref<const Eigen::ArrayXd>& x,
+                Eigen::Ref<Eigen::ArrayXd> out) {
+    out = x.abs().min(y.abs()) / x.abs().max(y.abs()).max(1e-300);
+    out = out * (0.9999993329 + out.square() * (-0.3332985605 + out.square() * (0.1994653599 +
+          out.square() * (-0.1390853351 + out.square() * (0.0964200441 + out.square() * (-0.0559098861 +
+          out.square() * (0.0218612288 + out.square() * -0.0040540580)))))));
+    out += (y.abs() > x.abs()).cast<double>() * (Math_PI / 2.0 - 2.0 * out);
+    out += (x < 0.0).cast<double>() * (Math_PI - 2.0 * out);
+    out *= 1.0 - 2.0 * (y < 0.0).cast<double>();
+}
+
+// sin and cos by Taylor polynomials through x^9 / x^10 (|error| below 1e-9
+// for |x| <= π/4); false, with s and c unspecified, if any |x| is larger.
+// s may alias x
+bool fast_sincos_small(const Eigen::Ref<const Eigen::ArrayXd>& x, Eigen::Ref<Eigen::ArrayXd> s,
+                       Eigen::Ref<Eigen::ArrayXd> c) {
+    if (x.size() > 0 && x.abs().maxCoeff() > Math_PI / 4.0) {
+        return false;
+    }
+    c = x.square();
+    c = 1.0 + c * (-1.0 / 2 + c * (1.0 / 24 + c * (-1.0 / 720 + c * (1.0 / 40320 - c / 3628800))));
+    s = x * (1.0 + x.square() * (-1.0 / 6 + x.square() * (1.0 / 120 + x.square() * (-1.0 / 5040 +
+             x.square() / 362880))));
+    return true;
+}
+
+}  // namespace
+
+bool MultiBiomeLookaheadEngine::_lnn_read_phases(const PackedFloat64Array& rho_packed, int dim, double* phases,
+                                                 double* work) {
+    if (static_cast<int64_t>(dim) * dim * 2 != rho_packed.size()) {
+        return false;
+    }
+    // Extract diagonal phases: phase[i] = arg(rho[i,i]). The diagonal is
+    // gathered into contiguous re/im runs first so atan2 vectorizes
+    const double* rho = rho_packed.ptr();
+    const Eigen::InnerStride<> diagonal(2 * (static_cast<int64_t>(dim) + 1));
+    Eigen::Map<Eigen::ArrayXd> re(work, dim);
+    Eigen::Map<Eigen::ArrayXd> im(work + dim, dim);
+    re = Eigen::Map<const Eigen::ArrayXd, 0, Eigen::InnerStride<>>(rho, dim, diagonal);
+    im = Eigen::Map<const Eigen::ArrayXd, 0, Eigen::InnerStride<>>(rho + 1, dim, diagonal);
+    fast_atan2(im, re, Eigen::Map<Eigen::ArrayXd>(phases, dim));
+    return true;
+}
+
+void MultiBiomeLookaheadEngine::_lnn_apply_deltas(PackedFloat64Array& rho_packed, int dim, const double* deltas,
+                                                  double* work) {
+    // Apply phase modulation to diagonal elements
+    // rho[i,i] *= exp(i * delta_phase[i]), delta scaled to a small modulation
+    // (0.01 radians per unit of LNN output)
+    Eigen::Map<Eigen::ArrayXd> sin_d(work, dim);
+    Eigen::Map<Eigen::ArrayXd> cos_d(work + dim, dim);
+    sin_d = Eigen::Map<const Eigen::ArrayXd>(deltas, dim) * 0.01;
+    if (!fast_sincos_small(sin_d, sin_d, cos_d)) {
+        // Outlier output: exact per-element path
+        for (int i = 0; i < dim; i++) {
+            const double delta = deltas[i] * 0.01;
+            sin_d[i] = std::sin(delta);
+            cos_d[i] = std::cos(delta);
+        }
+    }
+
+    // (re + i*im) * (cos_d + i*sin_d) = (re*cos_d - im*sin_d) + i*(re*sin_d + im*cos_d)
+    double* rho = rho_packed.ptrw();
+    for (int i = 0; i < dim; i++) {
+        const int64_t idx = (static_cast<int64_t>(i) * dim + i) * 2;
+        const double re = rho[idx];
+        const double im = rho[idx + 1];
+        rho[idx] = re * cos_d[i] - im * sin_d[i];
+        rho[idx + 1] = re * sin_d[i] + im * cos_d[i];
+    }
+}
+
+void MultiBiomeLookaheadEngine::_apply_lnn_phase_modulation(int biome_id, PackedFloat64Array& rho_packed) {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_lnns.size()) || !m_lnns[biome_id]) {
+        return;
+    }
+    _adopt_trained_lnn(biome_id);
+
+    ScopedProfile profile(m_biome_profile[biome_id].lnn);
+    NATIVE_TRACE_ZONE_ID("lnn", biome_id);
+    const LiquidNeuralNet& lnn = *m_lnns[biome_id];
+    const int dim = lnn.input_size;
+    const int apply_dim = std::min(dim, lnn.output_size);
+    LnnScratch& scratch = m_lnn_scratch[biome_id];
+    const int stride = m_lnn_stride[biome_id];
+    const bool infer = (stride <= 1 || scratch.substep == 0);
+    if (infer) {
+        if (!_lnn_read_phases(rho_packed, dim, scratch.phases.data(), scratch.work.data())) {
+            return;
+        }
+
+        // Forward pass through LNN on this biome's hidden state, straight from
+        // the diagonal into the preallocated buffers
+        double* hidden = m_lnn_hidden[biome_id].data();
+        _lnn_record(biome_id, scratch.phases.data(), hidden);
+        if (stride > 1) {
+            scratch.prev_deltas = scratch.deltas;  // Same size: no allocation
+        }
+        if (m_lnn_kernels[biome_id]) {
+            m_lnn_kernels[biome_id]->forward(scratch.phases.data(), hidden, scratch.deltas.data());
+        } else {
+            lnn.forward_into(scratch.phases.data(), hidden, scratch.deltas.data(), scratch.activation.data());
+        }
+        if (stride <= 1) {
+            _lnn_apply_deltas(rho_packed, apply_dim, scratch.deltas.data(), scratch.work.data());
+            return;
+        }
+    } else if (static_cast<int64_t>(dim) * dim * 2 != rho_packed.size()) {
+        return;
+    }
+
+    // Subsampled: step j of each stride-long interval applies the deltas
+    // blended from the previous forward pass to the latest one, reaching the
+    // latest on the interval's last step (one interval of latency)
+    scratch.substep++;
+    const double t = static_cast<double>(scratch.substep) / stride;
+    scratch.interp_deltas = scratch.prev_deltas + t * (scratch.deltas - scratch.prev_deltas);
+    if (scratch.substep >= stride) {
+        scratch.substep = 0;
+    }
+    _lnn_apply_deltas(rho_packed, apply_dim, scratch.interp_deltas.data(), scratch.work.data());
+}
+
+void MultiBiomeLookaheadEngine::_evolve_lnn_group(const std::vector<int>& biome_ids, int steps, float dt,
+                                                  float max_dt) {
+    const LiquidNeuralNet& lnn = *m_lnns[biome_ids.front()];
+    const int members = static_cast<int>(biome_ids.size());
+    const int dim = lnn.input_size;
+
+    // Column b holds biome_ids[b]; hidden states are gathered once and
+    // written back after the last step
+    Eigen::MatrixXd phases(dim, members);
+    Eigen::MatrixXd hidden(lnn.hidden_size, members);
+    Eigen::MatrixXd deltas(lnn.output_size, members);
+    Eigen::VectorXd work(2 * dim);
+    std::vector<float> lod_max_dt(members);
+    for (int b = 0; b < members; b++) {
+        hidden.col(b) = m_lnn_hidden[biome_ids[b]];
+        lod_max_dt[b] = _lod_max_dt(biome_ids[b], get_effective_biome_lod(biome_ids[b]), dt, max_dt);
+    }
+
+    for (int step = 0; step < steps; step++) {
+        for (int b = 0; b < members; b++) {
+            PackedFloat64Array& rho = m_resident_rho[biome_ids[b]];
+            _engine(biome_ids[b])->evolve_inplace(rho, dt, lod_max_dt[b]);
+            _lnn_read_phases(rho, dim, phases.col(b).data(), work.data());
+        }
+        for (int b = 0; b < members; b++) {
+            _lnn_record(biome_ids[b], phases.col(b).data(), hidden.col(b).data());
+        }
+        {
+            ScopedProfile profile(m_biome_profile[biome_ids.front()].lnn);
+            NATIVE_TRACE_ZONE("lnn_batch");
+            lnn.forward_batch(phases, hidden, deltas);
+        }
+        for (int b = 0; b < members; b++) {
+            _lnn_apply_deltas(m_resident_rho[biome_ids[b]], std::min(dim, lnn.output_size), deltas.col(b).data(),
+                              work.data());
+        }
+    }
+
+    for (int b = 0; b < members; b++) {
+        m_lnn_hidden[biome_ids[b]] = hidden.col(b);
+    }
+}
+
+// ============================================================================
+// ICON MAP BUILDING
+// ============================================================================
+
+void MultiBiomeLookaheadEngine::_compile_icon_index(int biome_id) {
+    IconIndex& index = m_icon_index[biome_id];
+    index = IconIndex();
+
+    const Dictionary& metadata = m_metadata[biome_id];
+    EmojiLayout layout;
+    if (metadata.is_empty() || !resolve_emoji_layout(metadata, layout)) {
+        return;
+    }
+
+    // All string lookups happen here, once per metadata change; every icon
+    // map afterwards is a gather over (emoji, bloch offset) pairs
+    const int num_qubits = m_num_qubits[biome_id];
+    const int stride = 8;
+    const int count = static_cast<int>(layout.ids.size());
+    index.valid = true;
+    index.ids_only = metadata.get("ids_only", false);
+    index.ids = layout.ids;
+    if (!index.ids_only) {
+        index.names.resize(count);
+        for (int i = 0; i < count; i++) {
+            if (layout.ids[i] >= 0) {
+                index.names[i] = EmojiRegistry::get_emoji(layout.ids[i]);
+            }
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        const int qubit = layout.qubits[i];
+        const int pole = layout.poles[i];
+        if (layout.ids[i] < 0 || qubit < 0 || qubit >= num_qubits || (pole != 0 && pole != 1)) {
+            continue;
+        }
+        index.term_emoji.push_back(i);
+        index.term_offset.push_back(qubit * stride + pole);  // p0 or p1 of the qubit's packet
+    }
+}
+
+Dictionary MultiBiomeLookaheadEngine::_build_icon_map(
+    int biome_id, const std::vector<PackedFloat64Array>& bloch_steps) {
+
+    Dictionary icon_map;
+
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_num_qubits.size())) {
+        return icon_map;
+    }
+    if (bloch_steps.empty()) {
+        return icon_map;
+    }
+    if (biome_id >= static_cast<int>(m_icon_index.size()) || !m_icon_index[biome_id].valid) {
+        return icon_map;
+    }
+    ScopedProfile profile(m_biome_profile[biome_id].icon_map);
+    NATIVE_TRACE_ZONE_ID("icon_map", biome_id);
+    const IconIndex& index = m_icon_index[biome_id];
+
+    int num_qubits = m_num_qubits[biome_id];
+    const int stride = 8;
+    const int expected = num_qubits * stride;
+
+    std::vector<double> totals;
+    totals.resize(index.ids.size(), 0.0);
+
+    const size_t num_terms = index.term_emoji.size();
+    for (const auto& bloch_step : bloch_steps) {
+        if (bloch_step.is_empty() || bloch_step.size() < expected) {
+            continue;
+        }
+
+        const double* ptr = bloch_step.ptr();
+        for (size_t t = 0; t < num_terms; t++) {
+            totals[index.term_emoji[t]] += ptr[index.term_offset[t]];
+        }
+    }
+
+    std::vector<int> order(totals.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&totals](int a, int b) {
+        return totals[a] > totals[b];
+    });
+
+    Array sorted_emojis;
+    PackedInt32Array sorted_ids;
+    PackedFloat64Array sorted_weights;
+    sorted_weights.resize(static_cast<int>(order.size()));
+    sorted_ids.resize(static_cast<int>(order.size()));
+
+    Dictionary by_emoji;
+    double total_sum = 0.0;
+    int out_idx = 0;
+    for (int idx : order) {
+        if (index.ids[idx] < 0) {
+            continue;
+        }
+        double weight = totals[idx];
+        sorted_ids.set(out_idx, index.ids[idx]);
+        sorted_weights.set(out_idx, weight);
+        out_idx += 1;
+        if (!index.ids_only) {
+            const String& emoji = index.names[idx];
+            sorted_emojis.push_back(emoji);
+            by_emoji[emoji] = weight;
+        }
+        total_sum += weight;
+    }
+    sorted_ids.resize(out_idx);
+    sorted_weights.resize(out_idx);
+
+    icon_map["emoji_ids"] = sorted_ids;
+    icon_map["weights"] = sorted_weights;
+    if (!index.ids_only) {
+        icon_map["emojis"] = sorted_emojis;
+        icon_map["by_emoji"] = by_emoji;
+    }
+    icon_map["steps"] = static_cast<int>(bloch_steps.size());
+    icon_map["total"] = total_sum;
+    icon_map["num_qubits"] = num_qubits;
+
+    return icon_map;
+}
+
+// ============================================================================
+// ENGINE-RESIDENT STATE
+// ============================================================================
+
+void MultiBiomeLookaheadEngine::set_biome_rho(int biome_id, const PackedFloat64Array& rho_packed) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_resident_rho.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for set_biome_rho");
+        return;
+    }
+    const int64_t dim = _engine(biome_id)->get_dimension();
+    if (!rho_packed.is_empty() && rho_packed.size() != dim * dim * 2) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: set_biome_rho size does not match biome dimension");
+        return;
+    }
+    m_resident_rho[biome_id] = rho_packed;
+    m_biome_active[biome_id] = !rho_packed.is_empty();
+    if (biome_id < static_cast<int>(m_rings.size())) {
+        // The buffered future no longer follows from the present
+        LookaheadRing& ring = m_rings[biome_id];
+        ring.reset(ring.depth(), rho_packed);
+    }
+}
+
+PackedFloat64Array MultiBiomeLookaheadEngine::get_biome_rho(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_resident_rho.size())) {
+        return PackedFloat64Array();
+    }
+    return m_resident_rho[biome_id];
+}
+
+Dictionary MultiBiomeLookaheadEngine::get_biome_observables(int biome_id) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    Dictionary result;
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_resident_rho.size()) ||
+        m_resident_rho[biome_id].is_empty()) {
+        return result;
+    }
+    const int num_qubits = m_num_qubits[biome_id];
+    PackedFloat64Array observables = _engine(biome_id)->compute_observables_from_packed(
+        m_resident_rho[biome_id], num_qubits,
+        QuantumEvolutionEngine::OBSERVABLE_BLOCH | QuantumEvolutionEngine::OBSERVABLE_PURITY |
+            QuantumEvolutionEngine::OBSERVABLE_MI);
+    const int64_t bloch_len = static_cast<int64_t>(num_qubits) * 8;
+    result["bloch"] = observables.slice(0, bloch_len);
+    result["purity"] = observables.size() > bloch_len ? observables[bloch_len] : 0.0;
+    result["mi"] = observables.slice(bloch_len + 1);
+    return result;
+}
+
+bool MultiBiomeLookaheadEngine::apply_biome_operator(int biome_id, const PackedFloat64Array& op_packed) {
+    {
+        std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+        if (biome_id < 0 || biome_id >= static_cast<int>(m_resident_rho.size()) ||
+            m_resident_rho[biome_id].is_empty()) {
+            UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: apply_biome_operator needs a resident rho (set_biome_rho)");
+            return false;
+        }
+        if (biome_id >= static_cast<int>(m_rings.size())) {
+            PackedFloat64Array acted = _engine(biome_id)->apply_operator(m_resident_rho[biome_id], op_packed);
+            if (acted.is_empty()) {
+                return false;  // apply_operator warned
+            }
+            m_resident_rho[biome_id] = acted;
+            return true;
+        }
+    }
+    // Buffered biome: act at the present checkpoint and recompute the window
+    return !invalidate_from(biome_id, 0, op_packed).is_empty();
+}
+
+PackedInt32Array MultiBiomeLookaheadEngine::sample_outcomes(int biome_id, int count, int64_t seed,
+                                                            bool per_qubit) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_resident_rho.size()) ||
+        m_resident_rho[biome_id].is_empty()) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: sample_outcomes needs a resident rho (set_biome_rho)");
+        return PackedInt32Array();
+    }
+    PackedInt32Array out;
+    sample_populations(m_resident_rho[biome_id], _engine(biome_id)->get_dimension(), m_num_qubits[biome_id],
+                       std::max(count, 0), static_cast<uint64_t>(seed), per_qubit, out);
+    return out;
+}
+
+Array MultiBiomeLookaheadEngine::sample_outcomes_all(const PackedInt32Array& counts, int64_t seed, bool per_qubit) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    const int num_biomes = static_cast<int>(std::min<int64_t>(counts.size(), m_resident_rho.size()));
+    std::vector<PackedInt32Array> outcomes(num_biomes);
+    NativeThreadPool::shared().parallel_for(0, num_biomes, num_biomes, [&](int begin, int end) {
+        for (int biome_id = begin; biome_id < end; biome_id++) {
+            if (!m_resident_rho[biome_id].is_empty()) {
+                sample_populations(m_resident_rho[biome_id], _engine(biome_id)->get_dimension(),
+                                   m_num_qubits[biome_id], std::max(counts[biome_id], 0),
+                                   static_cast<uint64_t>(seed) + biome_id, per_qubit, outcomes[biome_id]);
+            }
+        }
+    });
+    Array result;
+    for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+        result.push_back(outcomes[biome_id]);
+    }
+    return result;
+}
+
+void MultiBiomeLookaheadEngine::evolve_resident(int steps, float dt, float max_dt) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    const int num_biomes = std::min(static_cast<int>(m_resident_rho.size()), static_cast<int>(m_engines.size()));
+
+    // Work units: a biome on its own, or every evolving biome sharing one LNN
+    // (stepped together so their forward passes batch)
+    std::vector<std::vector<int>> units;
+    std::map<const LiquidNeuralNet*, int> shared_unit;
+    for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+        const PackedFloat64Array& rho = m_resident_rho[biome_id];
+        _check_stationary(biome_id, rho);
+        if (!_should_evolve(biome_id, rho) || get_effective_biome_lod(biome_id) == LOD_FROZEN) {
+            continue;
+        }
+        if (m_lnns[biome_id]) {
+            _adopt_trained_lnn(biome_id);  // Before grouping by network
+        }
+        const std::shared_ptr<LiquidNeuralNet>& lnn = m_lnns[biome_id];
+        const int64_t dim = _engine(biome_id)->get_dimension();
+        if (lnn && lnn.use_count() > 1 && m_lnn_stride[biome_id] <= 1 && rho.size() == dim * dim * 2) {
+            auto it = shared_unit.find(lnn.get());
+            if (it != shared_unit.end()) {
+                units[it->second].push_back(biome_id);
+                continue;
+            }
+            shared_unit[lnn.get()] = static_cast<int>(units.size());
+        }
+        units.push_back({biome_id});
+    }
+
+    auto unit_range = [&](int begin, int end) {
+        for (int u = begin; u < end; u++) {
+            const std::vector<int>& unit = units[u];
+            if (unit.size() > 1) {
+                _evolve_lnn_group(unit, steps, dt, max_dt);
+            } else {
+                const int biome_id = unit.front();
+                PackedFloat64Array& rho = m_resident_rho[biome_id];
+                const float lod_max_dt = _lod_max_dt(biome_id, get_effective_biome_lod(biome_id), dt, max_dt);
+                for (int step = 0; step < steps; step++) {
+                    _engine(biome_id)->evolve_inplace(rho, dt, lod_max_dt);
+                    _apply_lnn_phase_modulation(biome_id, rho);
+                }
+            }
+            for (int biome_id : unit) {
+                _record_history(biome_id, static_cast<double>(steps) * dt);
+                if (biome_id < static_cast<int>(m_rings.size())) {
+                    // Present moved outside the ring: restart its window from here
+                    LookaheadRing& ring = m_rings[biome_id];
+                    ring.reset(ring.depth(), m_resident_rho[biome_id]);
+                }
+            }
+        }
+    };
+    const int num_units = static_cast<int>(units.size());
+    if (m_parallel_biomes) {
+        NativeThreadPool::shared().parallel_for(0, num_units, num_units, unit_range);
+    } else {
+        unit_range(0, num_units);
+    }
+}
+
+// ============================================================================
+// STATE HISTORY
+// ============================================================================
+
+void MultiBiomeLookaheadEngine::set_history(int biome_id, int64_t budget_bytes, int keyframe_interval,
+                                            bool observables_only) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for set_history ", biome_id);
+        return;
+    }
+    if (biome_id >= static_cast<int>(m_history.size())) {
+        m_history.resize(m_engines.size());
+    }
+    HistoryRing& history = m_history[biome_id];
+    history = HistoryRing();
+    history.budget = std::max<int64_t>(budget_bytes, 0);
+    history.keyframe_interval = std::max(keyframe_interval, 1);
+    history.observables_only = observables_only;
+}
+
+void MultiBiomeLookaheadEngine::clear_history(int biome_id) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_history.size())) {
+        return;
+    }
+    HistoryRing& history = m_history[biome_id];
+    HistoryRing cleared;
+    cleared.budget = history.budget;
+    cleared.keyframe_interval = history.keyframe_interval;
+    cleared.observables_only = history.observables_only;
+    history = std::move(cleared);
+}
+
+void MultiBiomeLookaheadEngine::record_history(int biome_id, double elapsed) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for record_history ", biome_id);
+        return;
+    }
+    _record_history(biome_id, std::max(elapsed, 0.0));
+}
+
+void MultiBiomeLookaheadEngine::_record_history(int biome_id, double elapsed) {
+    if (biome_id >= static_cast<int>(m_history.size()) || m_history[biome_id].budget <= 0 ||
+        biome_id >= static_cast<int>(m_resident_rho.size()) || m_resident_rho[biome_id].is_empty()) {
+        return;
+    }
+    HistoryRing& history = m_history[biome_id];
+    const PackedFloat64Array& rho = m_resident_rho[biome_id];
+    NATIVE_TRACE_ZONE_ID("history", biome_id);
+
+    HistoryFrame frame;
+    history.time += elapsed;
+    frame.time = history.time;
+    if (history.observables_only) {
+        frame.values = _engine(biome_id)->compute_observables_from_packed(
+            rho, m_num_qubits[biome_id],
+            QuantumEvolutionEngine::OBSERVABLE_BLOCH | QuantumEvolutionEngine::OBSERVABLE_PURITY);
+    } else {
+        const int64_t size = rho.size();
+        if (history.frames.empty() || history.since_keyframe + 1 >= history.keyframe_interval ||
+            static_cast<int64_t>(history.decoded.size()) != size) {
+            frame.values = rho;  // Copy-on-write share
+            history.decoded.assign(rho.ptr(), rho.ptr() + size);
+            history.since_keyframe = 0;
+        } else {
+            frame.scale = encode_rho_delta(rho.ptr(), history.decoded.data(), size, frame.delta);
+            history.since_keyframe++;
+        }
+    }
+    history.bytes += frame.bytes();
+    history.frames.push_back(std::move(frame));
+    history.recorded++;
+
+    // Over budget: drop the oldest keyframe with its deltas, never the
+    // group still being appended to
+    while (history.bytes > history.budget) {
+        size_t group = 1;
+        while (group < history.frames.size() && !history.frames[group].is_keyframe()) {
+            group++;
+        }
+        if (group >= history.frames.size()) {
+            break;
+        }
+        for (size_t i = 0; i < group; i++) {
+            history.bytes -= history.frames.front().bytes();
+            history.frames.pop_front();
+        }
+        history.evicted += static_cast<int64_t>(group);
+    }
+}
+
+Dictionary MultiBiomeLookaheadEngine::get_history_frame(int biome_id, int index) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    Dictionary out;
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_history.size())) {
+        return out;
+    }
+    const HistoryRing& history = m_history[biome_id];
+    const int count = static_cast<int>(history.frames.size());
+    if (index < 0) {
+        index += count;
+    }
+    if (index < 0 || index >= count) {
+        return out;
+    }
+    const int num_qubits = m_num_qubits[biome_id];
+    const int64_t bloch_len = static_cast<int64_t>(num_qubits) * 8;
+    out["time"] = history.frames[index].time;
+
+    PackedFloat64Array observables = history.frames[index].values;
+    if (!history.observables_only) {
+        // Nearest keyframe at or before index, then forward through the deltas
+        int key = index;
+        while (!history.frames[key].is_keyframe()) {
+            key--;
+        }
+        PackedFloat64Array rho = history.frames[key].values;
+        if (index > key) {
+            double* dst = rho.ptrw();
+            for (int i = key + 1; i <= index; i++) {
+                const HistoryFrame& frame = history.frames[i];
+                apply_rho_delta(frame.delta.ptr(), frame.scale, dst, rho.size());
+            }
+        }
+        observables = _engine(biome_id)->compute_observables_from_packed(
+            rho, num_qubits, QuantumEvolutionEngine::OBSERVABLE_BLOCH | QuantumEvolutionEngine::OBSERVABLE_PURITY);
+        out["rho"] = rho;
+    }
+    out["bloch"] = observables.slice(0, bloch_len);
+    out["purity"] = observables.size() > bloch_len ? observables[bloch_len] : 0.0;
+    return out;
+}
+
+PackedFloat64Array MultiBiomeLookaheadEngine::get_history_times(int biome_id) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    PackedFloat64Array times;
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_history.size())) {
+        return times;
+    }
+    const HistoryRing& history = m_history[biome_id];
+    times.resize(static_cast<int64_t>(history.frames.size()));
+    double* dst = times.ptrw();
+    for (const HistoryFrame& frame : history.frames) {
+        *dst++ = frame.time;
+    }
+    return times;
+}
+
+Dictionary MultiBiomeLookaheadEngine::get_history_stats(int biome_id) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    Dictionary stats;
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_history.size())) {
+        return stats;
+    }
+    const HistoryRing& history = m_history[biome_id];
+    int keyframes = 0;
+    for (const HistoryFrame& frame : history.frames) {
+        keyframes += frame.is_keyframe() ? 1 : 0;
+    }
+    stats["frames"] = static_cast<int64_t>(history.frames.size());
+    stats["keyframes"] = keyframes;
+    stats["bytes"] = history.bytes;
+    stats["budget"] = history.budget;
+    stats["recorded"] = history.recorded;
+    stats["evicted"] = history.evicted;
+    return stats;
+}
+
+// ============================================================================
+// RING-BUFFER LOOKAHEAD
+// ============================================================================
+
+void MultiBiomeLookaheadEngine::seed_lookahead_buffer(
+    const Array& biome_rhos, int depth, float dt, float max_dt) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (depth <= 0) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: seed_lookahead_buffer depth must be > 0");
+        return;
+    }
+
+    const bool resident = biome_rhos.is_empty();
+    int num_biomes = resident ? static_cast<int>(m_resident_rho.size()) : static_cast<int>(biome_rhos.size());
+    if (num_biomes > static_cast<int>(m_engines.size())) {
+        num_biomes = static_cast<int>(m_engines.size());
+    }
+
+    m_ring_depth = depth;
+    m_ring_dt = dt;
+    m_ring_max_dt = max_dt;
+    m_rings.assign(num_biomes, LookaheadRing());
+    for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+        m_rings[biome_id].slots.resize(depth);
+        m_rings[biome_id].base = resident ? m_resident_rho[biome_id] : PackedFloat64Array(biome_rhos[biome_id]);
+        if (!resident) {
+            m_resident_rho[biome_id] = m_rings[biome_id].base;
+        }
+    }
+}
+
+void MultiBiomeLookaheadEngine::reseed_biome_buffer(int biome_id, const PackedFloat64Array& rho_packed) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_rings.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for reseed_biome_buffer");
+        return;
+    }
+    LookaheadRing& ring = m_rings[biome_id];
+    ring.reset(ring.depth(), rho_packed);
+    m_resident_rho[biome_id] = rho_packed;
+    if (biome_id < static_cast<int>(m_biome_invalidations_pending.size())) {
+        m_biome_invalidations_pending[biome_id]++;
+    }
+}
+
+int MultiBiomeLookaheadEngine::advance(int n) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (n <= 0) {
+        return 0;
+    }
+    int popped_max = 0;
+    const bool publish = m_snapshots.enabled();
+    std::vector<LookaheadFrame> present(publish ? m_rings.size() : 0);
+    for (size_t biome_id = 0; biome_id < m_rings.size(); biome_id++) {
+        LookaheadRing& ring = m_rings[biome_id];
+        const int popped = std::min(n, ring.count);
+        if (publish && popped > 0) {
+            present[biome_id] = ring.at(popped - 1);  // The frame that becomes the present
+        }
+        for (int i = 0; i < popped; i++) {
+            ring.pop();
+        }
+        ring.owed += n - popped;
+        popped_max = std::max(popped_max, popped);
+    }
+    if (publish && popped_max > 0) {
+        std::vector<SnapshotBiome> biomes(present.size());
+        for (size_t biome_id = 0; biome_id < present.size(); biome_id++) {
+            if (!present[biome_id].bloch.is_empty()) {
+                biomes[biome_id].purity = present[biome_id].purity;
+                biomes[biome_id].bloch = &present[biome_id].bloch;
+                biomes[biome_id].positions = &present[biome_id].positions;
+            }
+        }
+        _publish_snapshot(SNAPSHOT_PRESENT, 0, 1, biomes);
+    }
+    // The ring base is the present: keep the resident state on it
+    for (size_t biome_id = 0; biome_id < m_rings.size() && biome_id < m_resident_rho.size(); biome_id++) {
+        m_resident_rho[biome_id] = m_rings[biome_id].base;
+        _record_history(static_cast<int>(biome_id), static_cast<double>(n) * m_ring_dt);
+    }
+    for (size_t biome_id = 0; biome_id < m_biome_invalidation_rate.size(); biome_id++) {
+        double& rate = m_biome_invalidation_rate[biome_id];
+        const double sample = static_cast<double>(m_biome_invalidations_pending[biome_id]) / n;
+        rate += INVALIDATION_SMOOTHING * (sample - rate);
+        m_biome_invalidations_pending[biome_id] = 0;
+    }
+    return popped_max;
 }
 
-void MultiBiomeLookaheadEngine::clear_biomes() {
-    m_engines.clear();
-    m_num_qubits.clear();
-    m_metadata.clear();
-    m_couplings.clear();
-    m_lnns.clear();
-    m_node_positions.clear();
-    m_node_velocities.clear();
-    m_biome_centers.clear();
+void MultiBiomeLookaheadEngine::set_adaptive_depth(bool enabled) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_adaptive_depth = enabled;
+    if (!enabled) {
+        for (LookaheadRing& ring : m_rings) {
+            if (ring.depth() != m_ring_depth) {
+                ring.resize(m_ring_depth);
+            }
+        }
+    }
 }
 
-int MultiBiomeLookaheadEngine::get_biome_count() const {
-    return static_cast<int>(m_engines.size());
+bool MultiBiomeLookaheadEngine::get_adaptive_depth() const {
+    return m_adaptive_depth;
 }
 
-void MultiBiomeLookaheadEngine::set_biome_metadata(int biome_id, const Dictionary& metadata) {
-    if (biome_id < 0 || biome_id >= static_cast<int>(m_metadata.size())) {
-        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for metadata ", biome_id);
+void MultiBiomeLookaheadEngine::set_adaptive_depth_budget_ms(double budget_ms) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (budget_ms <= 0.0) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: adaptive depth budget must be > 0");
         return;
     }
-    m_metadata[biome_id] = metadata;
-    if (biome_id < static_cast<int>(m_engines.size())) {
-        m_couplings[biome_id] = m_engines[biome_id]->compute_coupling_payload(metadata);
-    }
+    m_adaptive_budget_ms = budget_ms;
 }
 
-void MultiBiomeLookaheadEngine::set_biome_couplings(int biome_id, const Dictionary& couplings) {
-    if (biome_id < 0 || biome_id >= static_cast<int>(m_couplings.size())) {
-        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for couplings ", biome_id);
+double MultiBiomeLookaheadEngine::get_adaptive_depth_budget_ms() const {
+    return m_adaptive_budget_ms;
+}
+
+void MultiBiomeLookaheadEngine::set_adaptive_depth_range(int min_depth, int max_depth) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (min_depth < 1 || (max_depth > 0 && max_depth < min_depth)) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid adaptive depth range [",
+                                       min_depth, ", ", max_depth, "]");
         return;
     }
-    m_couplings[biome_id] = couplings;
+    m_adaptive_min_depth = min_depth;
+    m_adaptive_max_depth = max_depth;
 }
 
-Dictionary MultiBiomeLookaheadEngine::evolve_all_lookahead(
-    const Array& biome_rhos, int steps, float dt, float max_dt) {
+int MultiBiomeLookaheadEngine::get_biome_lookahead_depth(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_rings.size())) {
+        return 0;
+    }
+    return m_rings[biome_id].depth();
+}
 
-    Dictionary result;
-    Array all_results;        // Array<Array<PackedFloat64Array>>
-    Array all_mi;             // Array<PackedFloat64Array> (last step)
-    Array all_mi_steps;       // Array<Array<PackedFloat64Array>>
-    Array all_bloch_steps;    // Array<Array<PackedFloat64Array>>
-    Array all_purity_steps;   // Array<Array<float>>
-    Array all_position_steps; // Array<Array<PackedVector2Array>> (NEW: force positions)
-    Array all_velocity_steps; // Array<Array<PackedVector2Array>> (NEW: force velocities)
-    Array all_metadata;       // Array<Dictionary>
-    Array all_couplings;      // Array<Dictionary>
-    Array all_icon_maps;      // Array<Dictionary>
+double MultiBiomeLookaheadEngine::get_biome_invalidation_rate(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_biome_invalidation_rate.size())) {
+        return 0.0;
+    }
+    return m_biome_invalidation_rate[biome_id];
+}
 
-    int num_biomes = static_cast<int>(biome_rhos.size());
+int MultiBiomeLookaheadEngine::_adaptive_depth_for(int biome_id) const {
+    const int max_depth = (m_adaptive_max_depth > 0) ? m_adaptive_max_depth : m_ring_depth;
+    const int min_depth = std::min(m_adaptive_min_depth, max_depth);
+    double depth = max_depth;
 
-    // Validate input size matches registered biomes
-    if (num_biomes > static_cast<int>(m_engines.size())) {
-        UtilityFunctions::push_warning(
-            "MultiBiomeLookaheadEngine: More rhos than registered biomes (",
-            num_biomes, " vs ", m_engines.size(), ")");
-        num_biomes = static_cast<int>(m_engines.size());
+    // A full window rebuild should fit the budget (unknown cost: no limit yet)
+    const double cost_us = (biome_id < static_cast<int>(m_biome_step_cost_us.size()))
+                               ? m_biome_step_cost_us[biome_id] : 0.0;
+    if (cost_us > 0.0) {
+        depth = std::min(depth, m_adaptive_budget_ms * 1000.0 / cost_us);
     }
 
-    // Process each biome
-    for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
-        PackedFloat64Array rho_packed = biome_rhos[biome_id];
-
-        // Skip empty or all-zero rhos (inactive biomes - no Hamiltonian meaning)
-        // Don't try to unpack - just return empty results and continue
-        bool is_zero = rho_packed.is_empty();
-        if (!is_zero) {
-            // Check if all zeros
-            bool all_zeros = true;
-            for (int64_t i = 0; i < rho_packed.size(); i++) {
-                if (rho_packed[i] != 0.0) {
-                    all_zeros = false;
-                    break;
-                }
-            }
-            is_zero = all_zeros;
-        }
-
-        BiomeStepResult biome_result;
-        if (!is_zero) {
-            // Evolve this biome for all steps (only if valid state)
-            biome_result = _evolve_biome_steps(biome_id, rho_packed, steps, dt, max_dt);
-        }
-        // else: biome_result remains empty (skip calculation)
+    // Frames past the next expected invalidation are most likely wasted
+    const double rate = (biome_id < static_cast<int>(m_biome_invalidation_rate.size()))
+                            ? m_biome_invalidation_rate[biome_id] : 0.0;
+    if (rate > 0.0) {
+        depth = std::min(depth, std::ceil(1.0 / rate));
+    }
 
-        // Convert step_results to Godot Array
-        Array biome_steps;
-        for (const auto& step_rho : biome_result.steps) {
-            biome_steps.push_back(step_rho);
-        }
+    return std::max(min_depth, std::min(max_depth, static_cast<int>(depth)));
+}
 
-        all_results.push_back(biome_steps);
+MultiBiomeLookaheadEngine::BiomeStepResult MultiBiomeLookaheadEngine::_refill_ring(int biome_id) {
+    BiomeStepResult tail;
+    LookaheadRing& ring = m_rings[biome_id];
+    if (ring.count == 0 && ring.base_lag > 0) {
+        ring.owed += ring.base_lag;  // Restarting from a lagging base: replay the lag
+        ring.base_lag = 0;
+    }
+    const int missing = ring.depth() - ring.count;
+    const PackedFloat64Array& from = (ring.count > 0) ? ring.at(ring.count - 1).rho : ring.base;
+    if (missing <= 0 || !_should_evolve(biome_id, from)) {
+        return tail;
+    }
 
-        Array biome_mi_steps;
-        for (const auto& mi_step : biome_result.mi_steps) {
-            biome_mi_steps.push_back(mi_step);
-        }
-        all_mi_steps.push_back(biome_mi_steps);
-        if (!biome_result.mi_steps.empty()) {
-            all_mi.push_back(biome_result.mi_steps.back());
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+    const CostSnapshot cost_before = _cost_snapshot(biome_id);
+    BiomeStepResult evolved = _evolve_biome_steps(
+        biome_id, from, ring.owed + missing, m_ring_dt, m_ring_max_dt);
+    _update_cost_model(biome_id, cost_before);
+    const int produced = static_cast<int>(evolved.steps.size());
+    if (produced > 0 && biome_id < static_cast<int>(m_biome_step_cost_us.size())) {
+        // Same estimate the sliced scheduler uses; adaptive depth reads it
+        const double per_step =
+            std::chrono::duration<double, std::micro>(Clock::now() - start).count() / produced;
+        double& estimate = m_biome_step_cost_us[biome_id];
+        estimate = (estimate <= 0.0) ? per_step : estimate + STEP_COST_SMOOTHING * (per_step - estimate);
+    }
+    const int skip = std::min(ring.owed, produced);
+    if (skip > 0) {
+        // Owed frames were already consumed; only advance through them (a
+        // large biome's skipped state may not be kept: the base then lags)
+        if (evolved.steps[skip - 1].is_empty()) {
+            ring.base_lag += skip;
         } else {
-            all_mi.push_back(PackedFloat64Array());
+            ring.base = evolved.steps[skip - 1];
+            ring.base_lag = 0;
         }
+        ring.base_positions = evolved.position_steps[skip - 1];
+        ring.base_velocities = evolved.velocity_steps[skip - 1];
+        ring.base_bloch = evolved.bloch_steps[skip - 1];
+        ring.base_purity = evolved.purity_steps[skip - 1];
+    }
+    ring.owed -= skip;
+
+    for (int s = skip; s < produced; s++) {
+        LookaheadFrame frame;
+        frame.rho = evolved.steps[s];
+        frame.mi = (s < static_cast<int>(evolved.mi_steps.size())) ? evolved.mi_steps[s] : PackedFloat64Array();
+        frame.bloch = evolved.bloch_steps[s];
+        frame.purity = evolved.purity_steps[s];
+        frame.positions = evolved.position_steps[s];
+        frame.velocities = evolved.velocity_steps[s];
+        ring.push(frame);
+
+        tail.steps.push_back(frame.rho);
+        tail.mi_steps.push_back(frame.mi);
+        tail.bloch_steps.push_back(frame.bloch);
+        tail.purity_steps.push_back(frame.purity);
+        tail.position_steps.push_back(frame.positions);
+        tail.velocity_steps.push_back(frame.velocities);
+    }
 
-        Array biome_bloch_steps;
-        for (const auto& bloch_step : biome_result.bloch_steps) {
-            biome_bloch_steps.push_back(bloch_step);
-        }
-        all_bloch_steps.push_back(biome_bloch_steps);
+    std::vector<PackedFloat64Array> window_bloch(ring.count);
+    for (int i = 0; i < ring.count; i++) {
+        window_bloch[i] = ring.at(i).bloch;
+    }
+    tail.icon_map = _build_icon_map(biome_id, window_bloch);
+    return tail;
+}
 
-        Array biome_purity_steps;
-        for (double purity_val : biome_result.purity_steps) {
-            biome_purity_steps.push_back(purity_val);
-        }
-        all_purity_steps.push_back(biome_purity_steps);
+Dictionary MultiBiomeLookaheadEngine::refill() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    ScopedProfile profile(m_profile_refill);
+    NATIVE_TRACE_ZONE("refill");
 
-        // NEW: Collect force graph position/velocity steps
-        Array biome_position_steps;
-        for (const auto& position_step : biome_result.position_steps) {
-            biome_position_steps.push_back(position_step);
-        }
-        all_position_steps.push_back(biome_position_steps);
+    int num_biomes = static_cast<int>(m_rings.size());
+    if (num_biomes > static_cast<int>(m_engines.size())) {
+        num_biomes = static_cast<int>(m_engines.size());
+    }
 
-        Array biome_velocity_steps;
-        for (const auto& velocity_step : biome_result.velocity_steps) {
-            biome_velocity_steps.push_back(velocity_step);
+    if (m_adaptive_depth) {
+        for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+            const int depth = _adaptive_depth_for(biome_id);
+            if (depth != m_rings[biome_id].depth()) {
+                m_rings[biome_id].resize(depth);  // Shrinking drops tail frames only
+            }
         }
-        all_velocity_steps.push_back(biome_velocity_steps);
+    }
 
-        if (biome_id < static_cast<int>(m_metadata.size())) {
-            all_metadata.push_back(m_metadata[biome_id]);
-        } else {
-            all_metadata.push_back(Dictionary());
+    // Same per-biome independence as _run_lookahead: each task touches only
+    // its own ring, engine and force-graph slots
+    std::vector<BiomeStepResult> tails(num_biomes);
+    auto biome_range = [&](int begin, int end) {
+        for (int biome_id = begin; biome_id < end; biome_id++) {
+            tails[biome_id] = _refill_ring(biome_id);
+            if (biome_id < static_cast<int>(m_resident_rho.size())) {
+                m_resident_rho[biome_id] = m_rings[biome_id].base;  // Owed frames may have moved it
+            }
         }
+    };
+    if (m_parallel_biomes) {
+        NativeThreadPool::shared().parallel_for(0, num_biomes, num_biomes, biome_range);
+    } else {
+        biome_range(0, num_biomes);
+    }
+    _repel_across_biomes(m_ring_dt);
 
-        if (biome_id < static_cast<int>(m_couplings.size())) {
-            all_couplings.push_back(m_couplings[biome_id]);
-        } else {
-            all_couplings.push_back(Dictionary());
+    PackedInt32Array refilled;
+    refilled.resize(num_biomes);
+    Array all_results;
+    Array all_mi_steps;
+    Array all_bloch_steps;
+    Array all_purity_steps;
+    Array all_position_steps;
+    Array all_velocity_steps;
+    Array all_icon_maps;
+    for (int biome_id = 0; biome_id < num_biomes; biome_id++) {
+        const BiomeStepResult& tail = tails[biome_id];
+        refilled.set(biome_id, static_cast<int32_t>(tail.steps.size()));
+
+        Array biome_steps, biome_mi, biome_bloch, biome_purity, biome_positions, biome_velocities;
+        for (size_t s = 0; s < tail.steps.size(); s++) {
+            biome_steps.push_back(tail.steps[s]);
+            biome_mi.push_back(tail.mi_steps[s]);
+            biome_bloch.push_back(tail.bloch_steps[s]);
+            biome_purity.push_back(tail.purity_steps[s]);
+            biome_positions.push_back(tail.position_steps[s]);
+            biome_velocities.push_back(tail.velocity_steps[s]);
         }
-
-        all_icon_maps.push_back(biome_result.icon_map);
+        all_results.push_back(biome_steps);
+        all_mi_steps.push_back(biome_mi);
+        all_bloch_steps.push_back(biome_bloch);
+        all_purity_steps.push_back(biome_purity);
+        all_position_steps.push_back(biome_positions);
+        all_velocity_steps.push_back(biome_velocities);
+        all_icon_maps.push_back(tail.icon_map);
     }
 
+    Dictionary result;
+    result["refilled"] = refilled;
     result["results"] = all_results;
-    result["mi"] = all_mi;
     result["mi_steps"] = all_mi_steps;
     result["bloch_steps"] = all_bloch_steps;
     result["purity_steps"] = all_purity_steps;
-    result["position_steps"] = all_position_steps;  // NEW: force positions
-    result["velocity_steps"] = all_velocity_steps;  // NEW: force velocities
-    result["metadata"] = all_metadata;
-    result["couplings"] = all_couplings;
+    result["position_steps"] = all_position_steps;
+    result["velocity_steps"] = all_velocity_steps;
     result["icon_maps"] = all_icon_maps;
-
     return result;
 }
 
-Dictionary MultiBiomeLookaheadEngine::evolve_single_biome(
-    int biome_id, const PackedFloat64Array& rho_packed,
-    int steps, float dt, float max_dt) {
-
+Dictionary MultiBiomeLookaheadEngine::invalidate_from(int biome_id, int step, const PackedFloat64Array& delta_op) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
     Dictionary result;
 
-    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size())) {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_rings.size()) ||
+        biome_id >= static_cast<int>(m_engines.size())) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for invalidate_from");
+        return result;
+    }
+    LookaheadRing& ring = m_rings[biome_id];
+    if (step < 0 || step > ring.count) {
         UtilityFunctions::push_warning(
-            "MultiBiomeLookaheadEngine: Invalid biome_id ", biome_id);
+            "MultiBiomeLookaheadEngine: invalidate_from step ", step, " outside buffered range [0, ", ring.count, "]");
         return result;
     }
 
-    // Skip empty or all-zero rhos (no Hamiltonian meaning)
-    bool is_zero = rho_packed.is_empty();
-    if (!is_zero) {
-        // Check if all zeros
-        bool all_zeros = true;
-        for (int64_t i = 0; i < rho_packed.size(); i++) {
-            if (rho_packed[i] != 0.0) {
-                all_zeros = false;
-                break;
-            }
-        }
-        is_zero = all_zeros;
+    // Checkpoint `step`: 0 = ring base (the current state), k = buffered frame k-1
+    const PackedFloat64Array& checkpoint = (step == 0) ? ring.base : ring.at(step - 1).rho;
+    if (checkpoint.is_empty() || (step == 0 && ring.base_lag > 0)) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: invalidate_from step ", step,
+                                       " holds no state (large biome, see set_large_biome_qubits)");
+        return result;
     }
-
-    BiomeStepResult biome_result;
-    if (!is_zero) {
-        // Evolve this biome (only if valid state)
-        biome_result = _evolve_biome_steps(biome_id, rho_packed, steps, dt, max_dt);
+    PackedFloat64Array acted = _engine(biome_id)->apply_operator(checkpoint, delta_op);
+    if (acted.is_empty()) {
+        return result;  // apply_operator warned
     }
-    // else: biome_result remains empty (skip calculation)
 
-    // Convert to Godot types
-    Array biome_steps;
-    for (const auto& step_rho : biome_result.steps) {
-        biome_steps.push_back(step_rho);
+    if (biome_id < static_cast<int>(m_biome_invalidations_pending.size())) {
+        m_biome_invalidations_pending[biome_id]++;
     }
 
-    result["results"] = biome_steps;
-    if (!biome_result.mi_steps.empty()) {
-        result["mi"] = biome_result.mi_steps.back();
+    // Drop the now-invalid suffix; everything before the checkpoint stays
+    NativeCounters::add(COUNTER_LOOKAHEAD_STEPS_DISCARDED, static_cast<uint64_t>(ring.count - step));
+    while (ring.count > step) {
+        ring.slots[(ring.head + ring.count - 1) % ring.slots.size()] = LookaheadFrame();
+        ring.count--;
+    }
+    const int num_qubits = m_num_qubits[biome_id];
+    PackedFloat64Array observables = _engine(biome_id)->compute_observables_from_packed(
+        acted, num_qubits,
+        QuantumEvolutionEngine::OBSERVABLE_BLOCH | QuantumEvolutionEngine::OBSERVABLE_PURITY |
+            QuantumEvolutionEngine::OBSERVABLE_MI);
+    const int64_t bloch_len = static_cast<int64_t>(num_qubits) * 8;
+    if (step == 0) {
+        ring.base = acted;
+        ring.base_bloch = observables.slice(0, bloch_len);
+        ring.base_purity = observables.size() > bloch_len ? observables[bloch_len] : 0.0;
+        m_resident_rho[biome_id] = acted;
+        if (!ring.base_positions.is_empty()) {
+            m_force_engine->set_layout_state(m_force_layouts[biome_id], ring.base_positions, ring.base_velocities);
+        }
     } else {
-        result["mi"] = PackedFloat64Array();
+        // Replace the checkpoint frame's state with the acted one, and resume
+        // the force graph from that frame rather than the discarded tail
+        LookaheadFrame& frame = ring.slots[(ring.head + step - 1) % ring.slots.size()];
+        frame.rho = acted;
+        frame.bloch = observables.slice(0, bloch_len);
+        frame.purity = observables.size() > bloch_len ? observables[bloch_len] : 0.0;
+        frame.mi = observables.slice(bloch_len + 1);
+        m_force_engine->set_layout_state(m_force_layouts[biome_id], frame.positions, frame.velocities);
     }
 
-    Array biome_mi_steps;
-    for (const auto& mi_step : biome_result.mi_steps) {
-        biome_mi_steps.push_back(mi_step);
+    BiomeStepResult tail = _refill_ring(biome_id);
+
+    Array biome_steps, biome_mi, biome_bloch, biome_purity, biome_positions, biome_velocities;
+    for (size_t s = 0; s < tail.steps.size(); s++) {
+        biome_steps.push_back(tail.steps[s]);
+        biome_mi.push_back(tail.mi_steps[s]);
+        biome_bloch.push_back(tail.bloch_steps[s]);
+        biome_purity.push_back(tail.purity_steps[s]);
+        biome_positions.push_back(tail.position_steps[s]);
+        biome_velocities.push_back(tail.velocity_steps[s]);
     }
-    result["mi_steps"] = biome_mi_steps;
+    result["from_step"] = step;
+    result["rho_after"] = acted;
+    result["results"] = biome_steps;
+    result["mi_steps"] = biome_mi;
+    result["bloch_steps"] = biome_bloch;
+    result["purity_steps"] = biome_purity;
+    result["position_steps"] = biome_positions;
+    result["velocity_steps"] = biome_velocities;
+    result["icon_map"] = tail.icon_map;
+    return result;
+}
 
-    Array biome_bloch_steps;
-    for (const auto& bloch_step : biome_result.bloch_steps) {
-        biome_bloch_steps.push_back(bloch_step);
+int MultiBiomeLookaheadEngine::get_buffered_steps(int biome_id) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_rings.size())) {
+        return 0;
     }
-    result["bloch_steps"] = biome_bloch_steps;
+    return m_rings[biome_id].count;
+}
 
-    Array biome_purity_steps;
-    for (double purity_val : biome_result.purity_steps) {
-        biome_purity_steps.push_back(purity_val);
+Dictionary MultiBiomeLookaheadEngine::get_buffered_frame(int biome_id, int index) const {
+    Dictionary result;
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_rings.size()) ||
+        index < 0 || index >= m_rings[biome_id].count) {
+        return result;
     }
-    result["purity_steps"] = biome_purity_steps;
+    const LookaheadFrame& frame = m_rings[biome_id].at(index);
+    result["rho"] = frame.rho;
+    result["mi"] = frame.mi;
+    result["bloch"] = frame.bloch;
+    result["purity"] = frame.purity;
+    result["positions"] = frame.positions;
+    result["velocities"] = frame.velocities;
+    return result;
+}
 
-    if (biome_id >= 0 && biome_id < static_cast<int>(m_metadata.size())) {
-        result["metadata"] = m_metadata[biome_id];
+bool MultiBiomeLookaheadEngine::_ring_segment(int biome_id, float t, RingSegment& seg) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_rings.size()) || m_rings[biome_id].count == 0) {
+        return false;
     }
-    if (biome_id >= 0 && biome_id < static_cast<int>(m_couplings.size())) {
-        result["couplings"] = m_couplings[biome_id];
+    const LookaheadRing& ring = m_rings[biome_id];
+
+    // Uniformly spaced samples: the base (if its observables are known), then the frames
+    const bool has_base = !ring.base_bloch.is_empty();
+    if (has_base) {
+        seg.base.bloch = ring.base_bloch;
+        seg.base.purity = ring.base_purity;
+        seg.base.positions = ring.base_positions;
+    }
+    auto frame = [&](int i) -> const LookaheadFrame* {
+        return has_base ? (i == 0 ? &seg.base : &ring.at(i - 1)) : &ring.at(i);
+    };
+
+    const double dt = m_ring_dt > 0.0f ? m_ring_dt : 1.0;
+    const double t0 = has_base ? 0.0 : dt;
+    const int n = ring.count + (has_base ? 1 : 0);
+    const double u = std::min(std::max((t - t0) / dt, 0.0), static_cast<double>(n - 1));
+    const int i1 = std::min(static_cast<int>(u), std::max(n - 2, 0));
+    const double f = u - i1;
+    seg.t = t0 + u * dt;
+    seg.single = (n == 1);
+    if (seg.single) {
+        for (int k = 0; k < 4; k++) {
+            seg.p[k] = frame(0);
+        }
+        seg.nearest = 1;
+        return true;
     }
-    result["icon_map"] = biome_result.icon_map;
 
-    return result;
+    // Catmull-Rom neighbourhood p0..p3 around segment [i1, i1 + 1]; missing
+    // end neighbours are extrapolated (2·p1 - p2), giving one-sided tangents
+    seg.p[0] = frame(std::max(i1 - 1, 0));
+    seg.p[1] = frame(i1);
+    seg.p[2] = frame(i1 + 1);
+    seg.p[3] = frame(std::min(i1 + 2, n - 1));
+    seg.lo_edge = (i1 == 0);
+    seg.hi_edge = (i1 + 2 > n - 1);
+    const double f2 = f * f;
+    const double f3 = f2 * f;
+    seg.h00 = 2.0 * f3 - 3.0 * f2 + 1.0;
+    seg.h10 = f3 - 2.0 * f2 + f;
+    seg.h01 = -2.0 * f3 + 3.0 * f2;
+    seg.h11 = f3 - f2;
+    seg.nearest = (f < 0.5) ? 1 : 2;
+    // Base positions are unknown until a frame has been consumed: hold the first frame's
+    seg.first_positions = &frame(1)->positions;
+    return true;
 }
 
-MultiBiomeLookaheadEngine::BiomeStepResult
-MultiBiomeLookaheadEngine::_evolve_biome_steps(
-    int biome_id, const PackedFloat64Array& rho_packed,
-    int steps, float dt, float max_dt, bool compute_mi) {
-
-    BiomeStepResult out;
+double MultiBiomeLookaheadEngine::RingSegment::hermite(double v0, double v1, double v2, double v3) const {
+    if (single) return v1;
+    if (lo_edge) v0 = 2.0 * v1 - v2;
+    if (hi_edge) v3 = 2.0 * v2 - v1;
+    return h00 * v1 + h10 * 0.5 * (v2 - v0) + h01 * v2 + h11 * 0.5 * (v3 - v1);
+}
 
-    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size())) {
-        return out;
+bool MultiBiomeLookaheadEngine::_sample_bloch_packet(const RingSegment& seg, int64_t base, double* out) {
+    const int64_t bloch_len = seg.p[1]->bloch.size();
+    if (base < 0 || base + 8 > bloch_len) {
+        return false;
     }
+    const double* b[4] = {seg.p[0]->bloch.ptr(), seg.p[1]->bloch.ptr(), seg.p[2]->bloch.ptr(), seg.p[3]->bloch.ptr()};
+    if (seg.single || bloch_len % 8 != 0 || seg.p[0]->bloch.size() != bloch_len ||
+        seg.p[2]->bloch.size() != bloch_len || seg.p[3]->bloch.size() != bloch_len) {
+        // Shape changed mid-window (e.g. inactive frame)
+        const PackedFloat64Array& nearest = seg.p[seg.nearest]->bloch;
+        if (base + 8 > nearest.size()) {
+            return false;
+        }
+        std::copy(nearest.ptr() + base, nearest.ptr() + base + 8, out);
+        return true;
+    }
+    double v[5];  // p0, p1, x, y, z: linear in rho, so z = p0 - p1 survives interpolation
+    for (int k = 0; k < 5; k++) {
+        v[k] = seg.hermite(b[0][base + k], b[1][base + k], b[2][base + k], b[3][base + k]);
+    }
+    double r = std::sqrt(v[2] * v[2] + v[3] * v[3] + v[4] * v[4]);
+    if (r > 1.0) {
+        // Overshoot outside the Bloch ball: pull x, y, z back onto it
+        const double trace = v[0] + v[1];
+        v[2] /= r;
+        v[3] /= r;
+        v[4] /= r;
+        v[0] = 0.5 * (trace + v[4]);
+        v[1] = 0.5 * (trace - v[4]);
+        r = 1.0;
+    }
+    double theta = 0.0;
+    double phi = 0.0;
+    if (r > 1e-12) {
+        theta = std::acos(std::min(std::max(v[4] / r, -1.0), 1.0));
+        phi = std::atan2(v[3], v[2]);
+    }
+    for (int k = 0; k < 5; k++) {
+        out[k] = v[k];
+    }
+    out[5] = r;
+    out[6] = theta;
+    out[7] = phi;
+    return true;
+}
 
-    Ref<QuantumEvolutionEngine> engine = m_engines[biome_id];
-    int num_qubits = m_num_qubits[biome_id];
-
-    // Start with current rho
-    PackedFloat64Array current_rho = rho_packed;
+double MultiBiomeLookaheadEngine::_sample_purity(const RingSegment& seg) {
+    const LookaheadFrame* const* p = seg.p;
+    return std::min(std::max(seg.hermite(p[0]->purity, p[1]->purity, p[2]->purity, p[3]->purity), 0.0), 1.0);
+}
 
-    // Get current force positions/velocities for this biome
-    PackedVector2Array current_positions = m_node_positions[biome_id];
-    PackedVector2Array current_velocities = m_node_velocities[biome_id];
-    Vector2 biome_center = m_biome_centers[biome_id];
+PackedVector2Array MultiBiomeLookaheadEngine::_sample_positions(const RingSegment& seg) {
+    const PackedVector2Array* pos[4];
+    for (int k = 0; k < 4; k++) {
+        pos[k] = (seg.p[k]->positions.is_empty() && seg.p[k] == &seg.base && seg.first_positions)
+                     ? seg.first_positions
+                     : &seg.p[k]->positions;
+    }
+    const int64_t nodes = pos[1]->size();
+    if (seg.single || pos[0]->size() != nodes || pos[2]->size() != nodes || pos[3]->size() != nodes) {
+        return *pos[seg.nearest];
+    }
+    PackedVector2Array positions;
+    positions.resize(nodes);
+    Vector2* out = positions.ptrw();
+    for (int64_t k = 0; k < nodes; k++) {
+        const Vector2 a = (*pos[0])[k], b = (*pos[1])[k], c = (*pos[2])[k], d = (*pos[3])[k];
+        out[k] = Vector2(static_cast<real_t>(seg.hermite(a.x, b.x, c.x, d.x)),
+                         static_cast<real_t>(seg.hermite(a.y, b.y, c.y, d.y)));
+    }
+    return positions;
+}
 
-    // Create frozen mask (all nodes active for now)
-    PackedByteArray frozen_mask;
-    frozen_mask.resize(num_qubits);
-    for (int i = 0; i < num_qubits; i++) {
-        frozen_mask[i] = 0;  // 0 = active, 1 = frozen
+Dictionary MultiBiomeLookaheadEngine::sample_lookahead(int biome_id, float t) const {
+    Dictionary result;
+    RingSegment seg;
+    if (!_ring_segment(biome_id, t, seg)) {
+        return result;
     }
+    result["t"] = seg.t;
+    result["purity"] = _sample_purity(seg);
 
-    // Evolve for each step
-    for (int step = 0; step < steps; step++) {
-        // Single evolution step (with subcycling inside)
-        PackedFloat64Array evolved_rho = engine->evolve(current_rho, dt, max_dt);
-
-        // Apply phase-shadow LNN modulation (if enabled)
-        _apply_lnn_phase_modulation(biome_id, evolved_rho);
-
-        // Store result
-        out.steps.push_back(evolved_rho);
-        PackedFloat64Array bloch_packet = engine->compute_bloch_metrics_from_packed(evolved_rho, num_qubits);
-        out.bloch_steps.push_back(bloch_packet);
-        double purity = engine->compute_purity_from_packed(evolved_rho);
-        out.purity_steps.push_back(purity);
-
-        // OPTIMIZED MI: Adaptive computation with screening + high-purity approximation
-        // - Step 0: Full scan to identify candidate pairs (pairs with MI > threshold)
-        // - Steps 1+: Only compute for candidates, skip negligible pairs
-        // - Uses linear entropy (no eigendecomp) when purity > 0.9
-        PackedFloat64Array mi_values;
-        if (compute_mi) {
-            bool force_full_scan = (step == 0);  // Screen on first step only
-            mi_values = engine->compute_mi_adaptive(
-                evolved_rho, num_qubits, purity, force_full_scan);
-            out.mi_steps.push_back(mi_values);
-        } else {
-            mi_values = PackedFloat64Array();  // Empty placeholder
-            out.mi_steps.push_back(mi_values);
-        }
-
-        // NEW: Compute force-directed positions using Bloch + MI data
-        if (m_force_engine.is_valid()) {
-            Dictionary force_result = m_force_engine->update_positions(
-                current_positions,
-                current_velocities,
-                bloch_packet,
-                mi_values,
-                biome_center,
-                dt,
-                frozen_mask
-            );
-
-            // Extract updated positions/velocities
-            current_positions = force_result.get("positions", current_positions);
-            current_velocities = force_result.get("velocities", current_velocities);
-
-            // Store for this step
-            out.position_steps.push_back(current_positions);
-            out.velocity_steps.push_back(current_velocities);
-        } else {
-            // No force engine - use previous positions
-            out.position_steps.push_back(current_positions);
-            out.velocity_steps.push_back(current_velocities);
+    const int64_t bloch_len = seg.p[1]->bloch.size();
+    PackedFloat64Array bloch;
+    if (bloch_len % 8 != 0) {
+        bloch = seg.p[seg.nearest]->bloch;
+    } else {
+        bloch.resize(bloch_len);
+        double* out = bloch.ptrw();
+        for (int64_t base = 0; base < bloch_len; base += 8) {
+            if (!_sample_bloch_packet(seg, base, out + base)) {
+                bloch = seg.p[seg.nearest]->bloch;  // Nearest frame has a different shape too
+                break;
+            }
         }
+    }
+    result["bloch"] = bloch;
+    result["positions"] = _sample_positions(seg);
+    return result;
+}
 
-        // Update for next step
-        current_rho = evolved_rho;
+PackedFloat64Array MultiBiomeLookaheadEngine::get_bloch_at(int biome_id, int qubit, float t) const {
+    PackedFloat64Array packet;
+    RingSegment seg;
+    if (qubit < 0 || !_ring_segment(biome_id, t, seg)) {
+        return packet;
+    }
+    packet.resize(8);
+    if (!_sample_bloch_packet(seg, static_cast<int64_t>(qubit) * 8, packet.ptrw())) {
+        return PackedFloat64Array();
+    }
+    return packet;
+}
 
-        // CPU-gentle pacing: sleep between steps to spread load
-        if (m_pacing_delay_ms > 0) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(m_pacing_delay_ms));
+double MultiBiomeLookaheadEngine::get_emoji_prob_at(int biome_id, int emoji_id, float t) const {
+    if (biome_id < 0 || biome_id >= static_cast<int>(m_icon_index.size()) || !m_icon_index[biome_id].valid) {
+        return 0.0;
+    }
+    RingSegment seg;
+    if (!_ring_segment(biome_id, t, seg)) {
+        return 0.0;
+    }
+    // Sum of the emoji's pole populations; each is linear in ρ, so it is
+    // interpolated directly instead of through a whole Bloch packet
+    const IconIndex& index = m_icon_index[biome_id];
+    double prob = 0.0;
+    for (size_t term = 0; term < index.term_emoji.size(); term++) {
+        if (index.ids[index.term_emoji[term]] != emoji_id) {
+            continue;
+        }
+        const int offset = index.term_offset[term];
+        const LookaheadFrame* const* p = seg.p;
+        if (p[0]->bloch.size() <= offset || p[1]->bloch.size() <= offset || p[2]->bloch.size() <= offset ||
+            p[3]->bloch.size() <= offset) {
+            const PackedFloat64Array& nearest = p[seg.nearest]->bloch;
+            prob += offset < nearest.size() ? nearest[offset] : 0.0;
+            continue;
         }
+        prob += seg.hermite(p[0]->bloch[offset], p[1]->bloch[offset], p[2]->bloch[offset], p[3]->bloch[offset]);
     }
+    return std::min(std::max(prob, 0.0), 1.0);
+}
 
-    out.icon_map = _build_icon_map(biome_id, out.bloch_steps);
-
-    // Update stored positions/velocities for next refill
-    m_node_positions[biome_id] = current_positions;
-    m_node_velocities[biome_id] = current_velocities;
+PackedVector2Array MultiBiomeLookaheadEngine::get_positions_at(int biome_id, float t) const {
+    RingSegment seg;
+    if (!_ring_segment(biome_id, t, seg)) {
+        return PackedVector2Array();
+    }
+    return _sample_positions(seg);
+}
 
-    return out;
+double MultiBiomeLookaheadEngine::get_purity_at(int biome_id, float t) const {
+    RingSegment seg;
+    if (!_ring_segment(biome_id, t, seg)) {
+        return 0.0;
+    }
+    return _sample_purity(seg);
 }
 
 // ============================================================================
-// PHASE-SHADOW LNN METHODS
+// PROFILING
 // ============================================================================
 
-void MultiBiomeLookaheadEngine::enable_biome_lnn(int biome_id, int hidden_size) {
-    if (biome_id < 0 || biome_id >= static_cast<int>(m_engines.size())) {
-        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid biome_id for LNN ", biome_id);
-        return;
+namespace {
+
+// totals[name] += stage (both {"calls", "usec", "avg_usec"})
+void accumulate_stage(Dictionary& totals, const String& name, const Dictionary& stage) {
+    Dictionary sum = totals.get(name, Dictionary());
+    const int64_t calls = static_cast<int64_t>(sum.get("calls", 0)) + static_cast<int64_t>(stage.get("calls", 0));
+    const double usec = static_cast<double>(sum.get("usec", 0.0)) + static_cast<double>(stage.get("usec", 0.0));
+    sum["calls"] = calls;
+    sum["usec"] = usec;
+    sum["avg_usec"] = calls > 0 ? usec / static_cast<double>(calls) : 0.0;
+    totals[name] = sum;
+}
+
+// Heap bytes of a Godot packed array (element storage only)
+template <typename Packed>
+int64_t packed_bytes(const Packed& a) {
+    return static_cast<int64_t>(a.size()) * static_cast<int64_t>(sizeof(decltype(a[0])));
+}
+
+}  // namespace
+
+Dictionary MultiBiomeLookaheadEngine::get_profile_stats() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    Array biomes;
+    Dictionary totals;
+    for (size_t biome_id = 0; biome_id < m_biome_profile.size(); biome_id++) {
+        const BiomeProfile& bp = m_biome_profile[biome_id];
+        Dictionary stats = _engine(biome_id).is_valid() ? _engine(biome_id)->get_profile_stats() : Dictionary();
+        stats["steps"] = bp.steps.to_dict();
+        stats["force"] = bp.force.to_dict();
+        stats["lnn"] = bp.lnn.to_dict();
+        stats["icon_map"] = bp.icon_map.to_dict();
+        stats["ensemble"] = bp.ensemble.to_dict();
+
+        const Array names = stats.keys();
+        for (int i = 0; i < names.size(); i++) {
+            accumulate_stage(totals, names[i], stats[names[i]]);
+        }
+        biomes.push_back(stats);
+    }
+
+    Dictionary result;
+    result["biomes"] = biomes;
+    result["totals"] = totals;
+    result["lookahead"] = m_profile_lookahead.to_dict();
+    result["batched_evolve"] = m_profile_batched.to_dict();
+    result["refill"] = m_profile_refill.to_dict();
+    result["marshal"] = m_profile_marshal.to_dict();
+    result["cross_repulsion"] = m_profile_cross_repulsion.to_dict();
+    Dictionary arena;
+    arena["capacity"] = static_cast<int64_t>(m_frame_arena.capacity());
+    arena["high_water"] = static_cast<int64_t>(m_frame_arena.high_water());
+    arena["overflows"] = static_cast<int64_t>(m_frame_arena.overflow_count());
+    result["frame_arena"] = arena;
+    Dictionary pool;
+    pool["reused"] = m_result_pool_reused.load(std::memory_order_relaxed);
+    pool["fresh"] = m_result_pool_fresh.load(std::memory_order_relaxed);
+    result["result_pool"] = pool;
+    result["simd_isa"] = simd_isa_name(active_simd_isa());
+    return result;
+}
+
+Dictionary MultiBiomeLookaheadEngine::get_memory_stats() {
+    using namespace memory_bytes;
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+
+    std::unordered_set<const SharedLindblad*> operators_seen;
+    std::unordered_set<const LiquidNeuralNet*> lnns_seen;
+    Array biomes;
+    int64_t total = 0;
+    for (size_t biome_id = 0; biome_id < m_engines.size(); biome_id++) {
+        Dictionary stats;
+        int64_t biome_total = 0;
+        if (_engine(biome_id).is_valid()) {
+            biome_total += _engine(biome_id)->collect_memory_stats(stats, &operators_seen);
+        }
+
+        int64_t lookahead = 0;
+        if (biome_id < m_rings.size()) {
+            const LookaheadRing& ring = m_rings[biome_id];
+            lookahead += vector(ring.slots);
+            for (const LookaheadFrame& frame : ring.slots) {
+                lookahead += packed_bytes(frame.rho) + packed_bytes(frame.mi) + packed_bytes(frame.bloch) +
+                             packed_bytes(frame.positions) + packed_bytes(frame.velocities);
+            }
+            lookahead += packed_bytes(ring.base) + packed_bytes(ring.base_positions) +
+                         packed_bytes(ring.base_velocities) + packed_bytes(ring.base_bloch);
+        }
+        const int64_t resident_rho = biome_id < m_resident_rho.size() ? packed_bytes(m_resident_rho[biome_id]) : 0;
+
+        int64_t lnn_weights = 0;
+        const LiquidNeuralNet* lnn = biome_id < m_lnns.size() ? m_lnns[biome_id].get() : nullptr;
+        if (lnn != nullptr && lnns_seen.insert(lnn).second) {
+            lnn_weights = dense(lnn->W_in) + dense(lnn->W_rec) + dense(lnn->W_out) +
+                          dense(lnn->b_hidden) + dense(lnn->b_out) + dense(lnn->hidden_state);
+        }
+        int64_t lnn_state = 0;
+        if (biome_id < m_lnn_hidden.size()) {
+            lnn_state += dense(m_lnn_hidden[biome_id]);
+        }
+        if (biome_id < m_lnn_scratch.size()) {
+            const LnnScratch& scratch = m_lnn_scratch[biome_id];
+            lnn_state += dense(scratch.phases) + dense(scratch.deltas) + dense(scratch.activation) +
+                         dense(scratch.work) + dense(scratch.prev_deltas) + dense(scratch.interp_deltas);
+        }
+
+        stats["lookahead"] = lookahead;
+        stats["resident_rho"] = resident_rho;
+        stats["lnn_weights"] = lnn_weights;
+        stats["lnn_state"] = lnn_state;
+        biome_total += lookahead + resident_rho + lnn_weights + lnn_state;
+        stats["total"] = biome_total;
+        total += biome_total;
+        biomes.push_back(stats);
+    }
+
+    int64_t frame_results = vector(m_frame_results);
+    for (const BiomeStepResult& result : m_frame_results) {
+        frame_results += static_cast<int64_t>(result.payload_bytes());
+    }
+    int64_t batched_operators = 0;
+    for (const auto& entry : m_batched_ops) {
+        const QuantumEvolutionEngine::BatchedOperators& ops = *entry.second;
+        batched_operators += vector(entry.first) + sparse(ops.heff) + vector(ops.jumps) + vector(ops.shared_jumps);
+        for (const auto& jump : ops.jumps) {
+            batched_operators += sparse(jump);
+        }
     }
 
-    // Get dimension from the engine
-    int dim = m_engines[biome_id]->get_dimension();
-    if (dim <= 0) {
-        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid dimension for LNN");
-        return;
+    int64_t result_pool = vector(m_result_pool);
+    for (const ResultBuffers& buffers : m_result_pool) {
+        result_pool += vector(buffers.rho) + vector(buffers.bloch) + vector(buffers.mi) + packed_bytes(buffers.frames);
+        for (const auto& a : buffers.rho) result_pool += packed_bytes(a);
+        for (const auto& a : buffers.bloch) result_pool += packed_bytes(a);
+        for (const auto& a : buffers.mi) result_pool += packed_bytes(a);
     }
 
-    // Create LNN: input = dim phases, output = dim phase modulations
-    m_lnns[biome_id] = std::make_unique<LiquidNeuralNet>(dim, hidden_size, dim);
+    Dictionary shared;
+    shared["frame_arena"] = static_cast<int64_t>(m_frame_arena.capacity());
+    shared["frame_results"] = frame_results;
+    shared["snapshot_scratch"] = vector(m_snapshot_scratch);
+    shared["batched_operators"] = batched_operators;
+    shared["result_pool"] = result_pool;
+    total += static_cast<int64_t>(m_frame_arena.capacity()) + frame_results + vector(m_snapshot_scratch) +
+             batched_operators + result_pool;
 
-    UtilityFunctions::print("MultiBiomeLookaheadEngine: LNN enabled for biome ", biome_id,
-                            " (dim=", dim, ", hidden=", hidden_size, ")");
+    Dictionary result;
+    result["biomes"] = biomes;
+    result["shared"] = shared;
+    result["total"] = total;
+    return result;
 }
 
-void MultiBiomeLookaheadEngine::disable_biome_lnn(int biome_id) {
-    if (biome_id < 0 || biome_id >= static_cast<int>(m_lnns.size())) {
-        return;
+void MultiBiomeLookaheadEngine::reset_profile_stats() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    for (size_t biome_id = 0; biome_id < m_biome_profile.size(); biome_id++) {
+        m_biome_profile[biome_id] = BiomeProfile();
+        if (_engine(biome_id).is_valid()) {
+            _engine(biome_id)->reset_profile_stats();
+            _engine(biome_id)->reset_mi_screen_stats();
+        }
     }
-    m_lnns[biome_id].reset();
+    m_profile_lookahead = ProfileStage();
+    m_profile_batched = ProfileStage();
+    m_profile_refill = ProfileStage();
+    m_profile_marshal = ProfileStage();
+    m_profile_cross_repulsion = ProfileStage();
 }
 
-bool MultiBiomeLookaheadEngine::is_lnn_enabled(int biome_id) const {
-    if (biome_id < 0 || biome_id >= static_cast<int>(m_lnns.size())) {
-        return false;
+// ============================================================================
+// RECORDING / REPLAY
+// ============================================================================
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t bytes) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < bytes; i++) {
+        hash = (hash ^ p[i]) * FNV_PRIME;
     }
-    return m_lnns[biome_id] != nullptr;
+    return hash;
 }
 
-void MultiBiomeLookaheadEngine::_apply_lnn_phase_modulation(int biome_id, PackedFloat64Array& rho_packed) {
-    if (biome_id < 0 || biome_id >= static_cast<int>(m_lnns.size()) || !m_lnns[biome_id]) {
-        return;
-    }
+uint64_t fnv1a_doubles(uint64_t hash, const PackedFloat64Array& data) {
+    return fnv1a(hash, data.ptr(), static_cast<size_t>(data.size()) * sizeof(double));
+}
 
-    LiquidNeuralNet* lnn = m_lnns[biome_id].get();
-    int dim = static_cast<int>(std::sqrt(rho_packed.size() / 2));
-    if (dim * dim * 2 != rho_packed.size()) {
-        return;
+// Hash the numeric payload of an evolve_all_lookahead[_packed] result
+uint64_t lookahead_checksum(const Dictionary& result, bool packed) {
+    uint64_t hash = FNV_OFFSET;
+    if (packed) {
+        hash = fnv1a_doubles(hash, result.get("rho", PackedFloat64Array()));
+        hash = fnv1a_doubles(hash, result.get("bloch", PackedFloat64Array()));
+        return fnv1a_doubles(hash, result.get("purity", PackedFloat64Array()));
     }
-
-    // Extract diagonal phases: phase[i] = arg(rho[i,i])
-    std::vector<double> phases(dim);
-    for (int i = 0; i < dim; i++) {
-        int idx = (i * dim + i) * 2;  // Diagonal element rho[i,i]
-        double re = rho_packed[idx];
-        double im = rho_packed[idx + 1];
-        phases[i] = std::atan2(im, re);
+    const Array rho = result.get("results", Array());
+    const Array bloch = result.get("bloch_steps", Array());
+    const Array purity = result.get("purity_steps", Array());
+    for (int b = 0; b < rho.size(); b++) {
+        const Array rho_steps = rho[b];
+        for (int s = 0; s < rho_steps.size(); s++) {
+            hash = fnv1a_doubles(hash, rho_steps[s]);
+        }
+        const Array bloch_steps = bloch[b];
+        for (int s = 0; s < bloch_steps.size(); s++) {
+            hash = fnv1a_doubles(hash, bloch_steps[s]);
+        }
+        const Array purity_steps = purity[b];
+        for (int s = 0; s < purity_steps.size(); s++) {
+            const double value = purity_steps[s];
+            hash = fnv1a(hash, &value, sizeof(value));
+        }
     }
+    return hash;
+}
 
-    // Forward pass through LNN
-    std::vector<double> phase_deltas = lnn->forward(phases);
+}  // namespace
 
-    // Apply phase modulation to diagonal elements
-    // rho[i,i] *= exp(i * delta_phase[i])
-    for (int i = 0; i < dim && i < static_cast<int>(phase_deltas.size()); i++) {
-        int idx = (i * dim + i) * 2;
-        double re = rho_packed[idx];
-        double im = rho_packed[idx + 1];
+bool MultiBiomeLookaheadEngine::start_recording(const String& path) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    return m_recorder.open_write(path);
+}
 
-        // Scale delta to be small modulation (0.01 radians max)
-        double delta = phase_deltas[i] * 0.01;
+void MultiBiomeLookaheadEngine::stop_recording() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_recorder.close();
+}
 
-        // exp(i*delta) = cos(delta) + i*sin(delta)
-        double cos_d = std::cos(delta);
-        double sin_d = std::sin(delta);
+bool MultiBiomeLookaheadEngine::is_recording() const {
+    return m_recorder.is_open();
+}
 
-        // (re + i*im) * (cos_d + i*sin_d) = (re*cos_d - im*sin_d) + i*(re*sin_d + im*cos_d)
-        rho_packed[idx] = re * cos_d - im * sin_d;
-        rho_packed[idx + 1] = re * sin_d + im * cos_d;
+bool MultiBiomeLookaheadEngine::start_telemetry(const String& path, int capacity_frames) {
+    const String file = ProjectSettings::get_singleton()->globalize_path(path);
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (!m_telemetry.open(file.utf8().get_data(), capacity_frames)) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: start_telemetry: ",
+                                       String::utf8(m_telemetry.error().c_str()));
+        return false;
     }
+    return true;
 }
 
-// ============================================================================
-// ICON MAP BUILDING
-// ============================================================================
+void MultiBiomeLookaheadEngine::stop_telemetry() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_telemetry.close();
+}
 
-Dictionary MultiBiomeLookaheadEngine::_build_icon_map(
-    int biome_id, const std::vector<PackedFloat64Array>& bloch_steps) {
+bool MultiBiomeLookaheadEngine::is_telemetry_active() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    return m_telemetry.is_open();
+}
 
-    Dictionary icon_map;
+int64_t MultiBiomeLookaheadEngine::get_telemetry_frame_count() {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    return m_telemetry.is_open() ? static_cast<int64_t>(m_telemetry.frames_written()) : 0;
+}
 
-    if (biome_id < 0 || biome_id >= static_cast<int>(m_num_qubits.size())) {
-        return icon_map;
-    }
-    if (bloch_steps.empty()) {
-        return icon_map;
+Dictionary MultiBiomeLookaheadEngine::replay_recording(const String& path) {
+    Dictionary result;
+    if (is_recording()) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: stop_recording before replay_recording");
+        return result;
     }
-    if (biome_id < 0 || biome_id >= static_cast<int>(m_metadata.size())) {
-        return icon_map;
+    LookaheadRecorder reader;
+    if (!reader.open_read(path)) {
+        return result;  // open_read warned
     }
 
-    Dictionary metadata = m_metadata[biome_id];
-    if (metadata.is_empty()) {
-        return icon_map;
+    clear_biomes();
+    typedef std::chrono::steady_clock Clock;
+    PackedFloat64Array frame_usec;
+    PackedInt64Array frame_checksums;
+    uint64_t combined = FNV_OFFSET;
+    double total_usec = 0.0;
+
+    LookaheadRecorder::Record record;
+    while (reader.next(record)) {
+        switch (record.type) {
+            case LookaheadRecorder::RECORD_REGISTER:
+                register_biome(record.dim, record.hamiltonian, record.triplets, record.num_qubits,
+                               record.num_trajectories, record.metadata);
+                break;
+            case LookaheadRecorder::RECORD_METADATA:
+                set_biome_metadata(record.biome_id, record.metadata);
+                break;
+            case LookaheadRecorder::RECORD_CLEAR:
+                clear_biomes();
+                break;
+            case LookaheadRecorder::RECORD_UPDATE_HAMILTONIAN:
+                update_biome_hamiltonian(record.biome_id, record.hamiltonian);
+                break;
+            case LookaheadRecorder::RECORD_REPLACE_LINDBLAD:
+                replace_biome_lindblad(record.biome_id, record.index, record.hamiltonian);
+                break;
+            case LookaheadRecorder::RECORD_LOOKAHEAD: {
+                const Clock::time_point start = Clock::now();
+                const Dictionary frame = _run_lookahead(record.rhos, record.steps, static_cast<float>(record.dt),
+                                                        static_cast<float>(record.max_dt), record.packed);
+                const double usec = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+                const uint64_t checksum = lookahead_checksum(frame, record.packed);
+                frame_usec.push_back(usec);
+                frame_checksums.push_back(static_cast<int64_t>(checksum));
+                combined = fnv1a(combined, &checksum, sizeof(checksum));
+                total_usec += usec;
+                break;
+            }
+            default:
+                break;
+        }
     }
 
-    Array emoji_list = metadata.get("emoji_list", Array());
-    Dictionary emoji_to_qubit = metadata.get("emoji_to_qubit", Dictionary());
-    Dictionary emoji_to_pole = metadata.get("emoji_to_pole", Dictionary());
-
-    if (emoji_list.is_empty() || emoji_to_qubit.is_empty() || emoji_to_pole.is_empty()) {
-        return icon_map;
-    }
+    result["lookaheads"] = static_cast<int>(frame_usec.size());
+    result["biomes"] = get_biome_count();
+    result["total_usec"] = total_usec;
+    result["frame_usec"] = frame_usec;
+    result["frame_checksums"] = frame_checksums;
+    result["checksum"] = static_cast<int64_t>(combined);
+    return result;
+}
 
-    int num_qubits = m_num_qubits[biome_id];
-    const int stride = 8;
-    const int expected = num_qubits * stride;
+// ============================================================================
+// SNAPSHOT CHANNEL IMPLEMENTATION
+// ============================================================================
 
-    std::vector<double> totals;
-    totals.resize(emoji_list.size(), 0.0);
+void MultiBiomeLookaheadEngine::set_snapshot_capacity(int frames) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    if (frames < 0) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: Invalid snapshot capacity ", frames);
+        return;
+    }
+    m_snapshots.set_capacity(frames);
+}
 
-    for (const auto& bloch_step : bloch_steps) {
-        if (bloch_step.is_empty() || bloch_step.size() < expected) {
-            continue;
-        }
+int MultiBiomeLookaheadEngine::get_snapshot_capacity() const {
+    return m_snapshots.capacity();
+}
 
-        const double* ptr = bloch_step.ptr();
-        for (int i = 0; i < emoji_list.size(); i++) {
-            Variant emoji_var = emoji_list[i];
-            if (emoji_var.get_type() != Variant::STRING) {
-                continue;
-            }
-            String emoji = emoji_var;
-            if (!emoji_to_qubit.has(emoji) || !emoji_to_pole.has(emoji)) {
-                continue;
-            }
+int64_t MultiBiomeLookaheadEngine::get_snapshot_sequence() const {
+    return static_cast<int64_t>(m_snapshots.latest_sequence());
+}
 
-            int qubit = static_cast<int>(emoji_to_qubit[emoji]);
-            int pole = static_cast<int>(emoji_to_pole[emoji]);
-            if (qubit < 0 || qubit >= num_qubits || (pole != 0 && pole != 1)) {
-                continue;
-            }
+PackedByteArray MultiBiomeLookaheadEngine::read_snapshot(int64_t sequence) const {
+    // No m_evolve_mutex: the channel's seqlock makes this safe against the producer
+    std::vector<uint8_t> bytes;
+    bool ok;
+    if (sequence < 0) {
+        ok = m_snapshots.read_latest(bytes) != 0;
+    } else {
+        ok = m_snapshots.read(static_cast<uint64_t>(sequence), bytes);
+    }
+    PackedByteArray out;
+    if (ok) {
+        out.resize(static_cast<int64_t>(bytes.size()));
+        std::memcpy(out.ptrw(), bytes.data(), bytes.size());
+    }
+    return out;
+}
 
-            int base = qubit * stride;
-            double p0 = ptr[base + 0];
-            double p1 = ptr[base + 1];
-            double prob = (pole == 0) ? p0 : p1;
-            totals[i] += prob;
+void MultiBiomeLookaheadEngine::_publish_snapshot(int kind, int step, int step_count,
+                                                  const std::vector<SnapshotBiome>& biomes) {
+    const int num_biomes = static_cast<int>(biomes.size());
+    size_t floats = 0;
+    for (const SnapshotBiome& biome : biomes) {
+        floats += 1;
+        if (biome.bloch) {
+            floats += biome.bloch->size() + 2 * (biome.positions ? biome.positions->size() : 0);
         }
     }
-
-    std::vector<int> order(totals.size());
-    std::iota(order.begin(), order.end(), 0);
-    std::sort(order.begin(), order.end(), [&totals](int a, int b) {
-        return totals[a] > totals[b];
-    });
-
-    Array sorted_emojis;
-    PackedFloat64Array sorted_weights;
-    sorted_weights.resize(static_cast<int>(order.size()));
-
-    Dictionary by_emoji;
-    double total_sum = 0.0;
-    int out_idx = 0;
-    for (int idx : order) {
-        Variant emoji_var = emoji_list[idx];
-        if (emoji_var.get_type() != Variant::STRING) {
-            continue;
+    const size_t header = 24 + 8 * static_cast<size_t>(num_biomes);
+    m_snapshot_scratch.resize(header + 4 * floats);
+    uint8_t* bytes = m_snapshot_scratch.data();
+
+    const int64_t sequence = static_cast<int64_t>(m_snapshots.next_sequence());
+    const int32_t fields[4] = {kind, step, step_count, num_biomes};
+    std::memcpy(bytes, &sequence, 8);
+    std::memcpy(bytes + 8, fields, sizeof(fields));
+
+    int32_t* counts = reinterpret_cast<int32_t*>(bytes + 24);
+    float* out = reinterpret_cast<float*>(bytes + header);
+    for (int b = 0; b < num_biomes; b++) {
+        const SnapshotBiome& biome = biomes[b];
+        const int32_t bloch_len = biome.bloch ? static_cast<int32_t>(biome.bloch->size()) : 0;
+        const int32_t nodes = (biome.bloch && biome.positions) ? static_cast<int32_t>(biome.positions->size()) : 0;
+        counts[2 * b] = bloch_len;
+        counts[2 * b + 1] = nodes;
+        *out++ = static_cast<float>(biome.purity);
+        for (int32_t i = 0; i < bloch_len; i++) {
+            *out++ = static_cast<float>((*biome.bloch)[i]);
+        }
+        for (int32_t i = 0; i < nodes; i++) {
+            const Vector2 p = (*biome.positions)[i];
+            *out++ = static_cast<float>(p.x);
+            *out++ = static_cast<float>(p.y);
         }
-        String emoji = emoji_var;
-        double weight = totals[idx];
-        sorted_emojis.push_back(emoji);
-        sorted_weights.set(out_idx, weight);
-        out_idx += 1;
-        by_emoji[emoji] = weight;
-        total_sum += weight;
     }
+    m_snapshots.publish(bytes, m_snapshot_scratch.size());
+}
 
-    icon_map["emojis"] = sorted_emojis;
-    icon_map["weights"] = sorted_weights;
-    icon_map["by_emoji"] = by_emoji;
-    icon_map["steps"] = static_cast<int>(bloch_steps.size());
-    icon_map["total"] = total_sum;
-    icon_map["num_qubits"] = num_qubits;
-
-    return icon_map;
+void MultiBiomeLookaheadEngine::_publish_lookahead_snapshots(
+    const std::vector<BiomeStepResult>& biome_results, int steps) {
+    if (!m_snapshots.enabled()) {
+        return;
+    }
+    const int num_biomes = static_cast<int>(biome_results.size());
+    std::vector<SnapshotBiome> biomes(num_biomes);
+    for (int s = 0; s < steps; s++) {
+        for (int b = 0; b < num_biomes; b++) {
+            const BiomeStepResult& r = biome_results[b];
+            SnapshotBiome& biome = biomes[b];
+            biome = SnapshotBiome();
+            if (s < static_cast<int>(r.bloch_steps.size())) {
+                biome.bloch = &r.bloch_steps[s];
+                biome.purity = (s < static_cast<int>(r.purity_steps.size())) ? r.purity_steps[s] : 0.0;
+                biome.positions = (s < static_cast<int>(r.position_steps.size())) ? &r.position_steps[s] : nullptr;
+            }
+        }
+        _publish_snapshot(SNAPSHOT_LOOKAHEAD, s, steps, biomes);
+    }
 }
 
 // ============================================================================
@@ -658,9 +6988,19 @@ Dictionary MultiBiomeLookaheadEngine::_build_icon_map(
 // ============================================================================
 
 void MultiBiomeLookaheadEngine::start_sliced_compute(
-    const Array& biome_rhos, int steps, float dt, float max_dt) {
+    const Array& biome_rhos_in, int steps, float dt, float max_dt, int observables) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+
+    // No rhos passed: slice the engine-resident states
+    Array biome_rhos = biome_rhos_in;
+    if (biome_rhos.is_empty()) {
+        for (const PackedFloat64Array& rho : m_resident_rho) {
+            biome_rhos.push_back(rho);
+        }
+    }
 
-    // Cancel any existing computation
+    // Cancel any existing computation, keeping its finished steps to reuse
+    SlicedComputeState previous = std::move(m_sliced_state);
     m_sliced_state.reset();
 
     int num_biomes = static_cast<int>(biome_rhos.size());
@@ -679,55 +7019,202 @@ void MultiBiomeLookaheadEngine::start_sliced_compute(
     m_sliced_state.total_steps = steps;
     m_sliced_state.dt = dt;
     m_sliced_state.max_dt = max_dt;
-
-    // Initialize progress
-    m_sliced_state.current_biome = 0;
-    m_sliced_state.current_step = 0;
-    m_sliced_state.current_rho = biome_rhos[0];
-
-    // Pre-allocate result storage for all biomes
-    m_sliced_state.biome_results.resize(num_biomes);
+    m_sliced_state.observables = observables & ~LOOKAHEAD_POSITIONS;  // Sliced steps have no force layout
+
+    // Initialize progress and result storage; biomes whose inputs match the
+    // previous run resume from its finished steps
+    m_sliced_state.num_biomes = num_biomes;
+    m_sliced_state.biome_step.assign(num_biomes, 0);
+    m_sliced_state.biome_rho.resize(num_biomes);
+    m_sliced_state.biome_results.assign(num_biomes, BiomeStepResult());
+    m_sliced_state.partial.assign(num_biomes, SlicedComputeState::PartialStep());
+    m_sliced_state.inputs.resize(num_biomes);
     for (int i = 0; i < num_biomes; i++) {
-        m_sliced_state.biome_results[i] = BiomeStepResult();
+        SlicedComputeState::BiomeInput& input = m_sliced_state.inputs[i];
+        input.rho = biome_rhos[i];
+        if (i < static_cast<int>(m_engines.size())) {
+            Ref<QuantumEvolutionEngine> engine = _engine(i);
+            input.engine = engine.ptr();
+            input.operator_version = engine->get_operator_version();
+            input.lod = get_effective_biome_lod(i);
+            input.reusable = m_trajectory_engines[i].is_null() &&
+                             (i >= static_cast<int>(m_lnns.size()) || !m_lnns[i]);
+        }
+        m_sliced_state.biome_rho[i] = input.rho;
+        if (!_should_evolve(i, m_sliced_state.biome_rho[i])) {
+            m_sliced_state.biome_step[i] = steps;  // Inactive: done before it starts
+            continue;
+        }
+        _adopt_sliced_prefix(previous, i);
     }
 
     m_sliced_state.in_progress = true;
     m_sliced_state.complete = false;
 }
 
+int MultiBiomeLookaheadEngine::_adopt_sliced_prefix(SlicedComputeState& previous, int biome_id) {
+    const SlicedComputeState::BiomeInput& input = m_sliced_state.inputs[biome_id];
+    if (!input.reusable || previous.dt != m_sliced_state.dt || previous.max_dt != m_sliced_state.max_dt ||
+        previous.observables != m_sliced_state.observables ||
+        biome_id >= static_cast<int>(previous.inputs.size()) ||
+        biome_id >= static_cast<int>(previous.biome_results.size())) {
+        return 0;
+    }
+    const SlicedComputeState::BiomeInput& before = previous.inputs[biome_id];
+    if (!before.reusable || before.engine != input.engine ||
+        before.operator_version != input.operator_version || before.lod != input.lod ||
+        before.rho.size() != input.rho.size() ||
+        (before.rho.ptr() != input.rho.ptr() &&
+         std::memcmp(before.rho.ptr(), input.rho.ptr(), sizeof(double) * input.rho.size()) != 0)) {
+        return 0;
+    }
+
+    BiomeStepResult& done = previous.biome_results[biome_id];
+    int kept = previous.biome_step[biome_id];
+    if (kept <= 0 || static_cast<int>(done.steps.size()) != kept) {
+        return 0;  // Nothing finished, or an inactive biome with no steps
+    }
+    const int total_steps = m_sliced_state.total_steps;
+    if (kept > total_steps) {
+        // A shorter run ends on a step whose ρ was not kept unless all were
+        if (done.steps[total_steps - 1].is_empty()) {
+            return 0;
+        }
+        kept = total_steps;
+    }
+
+    const PackedFloat64Array last_rho = (kept == previous.biome_step[biome_id]) ? previous.biome_rho[biome_id]
+                                                                                : done.steps[kept - 1];
+    done.steps.resize(kept);
+    done.bloch_steps.resize(std::min<size_t>(done.bloch_steps.size(), kept));
+    done.purity_steps.resize(std::min<size_t>(done.purity_steps.size(), kept));
+    done.mi_steps.resize(std::min<size_t>(done.mi_steps.size(), kept));
+    done.icon_map = Dictionary();  // Rebuilt once the biome finishes
+    if (kept < total_steps && !(m_sliced_state.observables & LOOKAHEAD_FULL_RHO)) {
+        done.steps[kept - 1] = PackedFloat64Array();  // Only the last step keeps ρ
+    }
+
+    m_sliced_state.biome_results[biome_id] = std::move(done);
+    m_sliced_state.biome_rho[biome_id] = last_rho;
+    m_sliced_state.biome_step[biome_id] = kept;
+    return kept;
+}
+
 bool MultiBiomeLookaheadEngine::continue_sliced_compute(int max_time_ms) {
+    return continue_sliced_compute_us(static_cast<int64_t>(max_time_ms) * 1000);
+}
+
+bool MultiBiomeLookaheadEngine::continue_sliced_compute_us(int64_t budget_us) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
     if (!m_sliced_state.in_progress || m_sliced_state.complete) {
         return true;  // Nothing to do or already complete
     }
 
-    auto start_time = std::chrono::high_resolution_clock::now();
-    int num_biomes = static_cast<int>(m_sliced_state.biome_rhos.size());
-    if (num_biomes > static_cast<int>(m_engines.size())) {
-        num_biomes = static_cast<int>(m_engines.size());
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point frame_start = Clock::now();
+    auto elapsed_us = [](Clock::time_point since) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - since).count();
+    };
+    const int num_biomes = m_sliced_state.num_biomes;
+    const double frame_budget_us = static_cast<double>(budget_us);
+
+    // Pass order: the focused (viewed) biome, then highest priority first
+    // (stable: ties keep biome order)
+    std::vector<int> order;
+    order.reserve(num_biomes);
+    for (int i = 0; i < num_biomes; i++) {
+        if (m_sliced_state.biome_step[i] < m_sliced_state.total_steps) {
+            order.push_back(i);
+        }
     }
-
-    // Process steps until time budget exhausted or computation complete
-    while (m_sliced_state.current_biome < num_biomes) {
-        // Check time budget
-        auto now = std::chrono::high_resolution_clock::now();
-        auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time).count();
-        if (elapsed_ms >= max_time_ms) {
-            // Time budget exhausted - yield
-            return false;
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        if ((a == m_focus_biome) != (b == m_focus_biome)) {
+            return a == m_focus_biome;
         }
+        return get_biome_priority(a) > get_biome_priority(b);
+    });
+    std::vector<CostSnapshot> cost_before(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        cost_before[i] = _cost_snapshot(order[i]);
+    }
 
-        // Do one step
-        bool biome_complete = _do_one_sliced_step();
-
-        if (biome_complete) {
-            // Move to next biome
-            m_sliced_state.current_biome++;
-            m_sliced_state.current_step = 0;
-
-            if (m_sliced_state.current_biome < num_biomes) {
-                // Initialize next biome
-                m_sliced_state.current_rho = m_sliced_state.biome_rhos[m_sliced_state.current_biome];
+    // Round-robin: one step per unfinished biome per pass, each started only
+    // if its predicted cost fits what is left of the frame and of its own cap
+    std::vector<double> spent_us(num_biomes, 0.0);
+    bool force_one = (m_sliced_state.stalled_calls > 0);
+    bool progressed = false;
+    bool started = true;
+    while (started) {
+        started = false;
+        for (int biome_id : order) {
+            if (m_sliced_state.biome_step[biome_id] >= m_sliced_state.total_steps) {
+                continue;
+            }
+            const double predicted = (biome_id < static_cast<int>(m_biome_step_cost_us.size()))
+                                         ? m_biome_step_cost_us[biome_id] : 0.0;
+            const double cap_us = get_biome_budget_ms(biome_id) * 1000.0;
+
+            // A step that can never fit the frame is sliced itself: it runs
+            // for whatever time is left and resumes on the next call
+            SlicedComputeState::PartialStep& partial = m_sliced_state.partial[biome_id];
+            if (partial.phase != SlicedComputeState::PARTIAL_IDLE ||
+                (predicted > frame_budget_us && _can_slice_within_step(biome_id))) {
+                double left_us = frame_budget_us - elapsed_us(frame_start);
+                if (cap_us > 0.0) {
+                    left_us = std::min(left_us, cap_us - spent_us[biome_id]);
+                }
+                if (left_us <= 0.0 && !force_one) {
+                    continue;
+                }
+                force_one = false;
+
+                const Clock::time_point slice_start = Clock::now();
+                const bool finished = _do_partial_sliced_step(biome_id, left_us);
+                const double cost = elapsed_us(slice_start);
+                spent_us[biome_id] += cost;
+                partial.spent_us += cost;
+                if (finished) {
+                    double& estimate = m_biome_step_cost_us[biome_id];
+                    estimate = (estimate <= 0.0) ? partial.spent_us
+                                                 : estimate + STEP_COST_SMOOTHING * (partial.spent_us - estimate);
+                    partial.spent_us = 0.0;
+                    started = true;  // Time may be left for another pass
+                }
+                progressed = true;
+                continue;
+            }
+            const bool fits = predicted <= frame_budget_us - elapsed_us(frame_start) &&
+                              (cap_us <= 0.0 || spent_us[biome_id] + predicted <= cap_us);
+            if (!fits && !force_one) {
+                continue;
             }
+            force_one = false;
+
+            const Clock::time_point step_start = Clock::now();
+            const int steps_before = m_sliced_state.biome_step[biome_id];
+            _do_one_sliced_step(biome_id);
+            const double cost = elapsed_us(step_start);
+            spent_us[biome_id] += cost;
+
+            // Frozen biomes fill every remaining step in one go; learn per step
+            const int advanced = std::max(1, m_sliced_state.biome_step[biome_id] - steps_before);
+            if (biome_id < static_cast<int>(m_biome_step_cost_us.size())) {
+                double& estimate = m_biome_step_cost_us[biome_id];
+                const double per_step = cost / advanced;
+                estimate = (estimate <= 0.0) ? per_step : estimate + STEP_COST_SMOOTHING * (per_step - estimate);
+            }
+            started = true;
+            progressed = true;
+        }
+    }
+    m_sliced_state.stalled_calls = progressed ? 0 : m_sliced_state.stalled_calls + 1;
+    for (size_t i = 0; i < order.size(); i++) {
+        _update_cost_model(order[i], cost_before[i]);
+    }
+
+    for (int i = 0; i < num_biomes; i++) {
+        if (m_sliced_state.biome_step[i] < m_sliced_state.total_steps) {
+            return false;
         }
     }
 
@@ -735,56 +7222,203 @@ bool MultiBiomeLookaheadEngine::continue_sliced_compute(int max_time_ms) {
     m_sliced_state.complete = true;
     m_sliced_state.in_progress = false;
 
-    // Build icon maps for all biomes
-    for (int i = 0; i < num_biomes; i++) {
-        m_sliced_state.biome_results[i].icon_map =
-            _build_icon_map(i, m_sliced_state.biome_results[i].bloch_steps);
+    // Build icon maps for all biomes (Bloch kept only for them stays in the
+    // state, so a resumed run can rebuild them, but is not returned)
+    if (m_sliced_state.observables & LOOKAHEAD_ICON_MAP) {
+        for (int i = 0; i < num_biomes; i++) {
+            BiomeStepResult& biome_result = m_sliced_state.biome_results[i];
+            biome_result.icon_map = _build_icon_map(i, biome_result.bloch_steps);
+        }
     }
 
     return true;
 }
 
-bool MultiBiomeLookaheadEngine::_do_one_sliced_step() {
-    int biome_id = m_sliced_state.current_biome;
-    int step = m_sliced_state.current_step;
+bool MultiBiomeLookaheadEngine::_do_one_sliced_step(int biome_id) {
+    int step = m_sliced_state.biome_step[biome_id];
 
     if (biome_id >= static_cast<int>(m_engines.size())) {
-        return true;  // Invalid biome, skip
+        m_sliced_state.biome_step[biome_id] = m_sliced_state.total_steps;
+        return true;  // Invalid biome (cleared mid-compute), skip
     }
 
-    Ref<QuantumEvolutionEngine> engine = m_engines[biome_id];
+    Ref<QuantumEvolutionEngine> engine = _engine(biome_id);
     int num_qubits = m_num_qubits[biome_id];
     BiomeStepResult& result = m_sliced_state.biome_results[biome_id];
+    // Icon maps are built from bloch_steps once every biome finishes
+    const int observables = m_sliced_state.observables;
+    const bool keep_bloch = observables & (LOOKAHEAD_BLOCH | LOOKAHEAD_ICON_MAP);
+    const bool keep_rho = (observables & LOOKAHEAD_FULL_RHO) || step + 1 == m_sliced_state.total_steps;
+
+    _check_stationary(biome_id, m_sliced_state.biome_rho[biome_id]);
+    const int lod = get_effective_biome_lod(biome_id);
+    if (lod == LOD_FROZEN) {
+        // Nothing to evolve: the remaining steps all repeat the current state
+        // (the frozen result's own icon map is not needed)
+        const int remaining = m_sliced_state.total_steps - step;
+        BiomeStepResult frozen = _frozen_steps(biome_id, m_sliced_state.biome_rho[biome_id], remaining, true,
+                                               (observables & ~LOOKAHEAD_ICON_MAP) |
+                                                   (keep_bloch ? LOOKAHEAD_BLOCH : 0));
+        result.steps.insert(result.steps.end(), frozen.steps.begin(), frozen.steps.end());
+        result.bloch_steps.insert(result.bloch_steps.end(), frozen.bloch_steps.begin(), frozen.bloch_steps.end());
+        result.purity_steps.insert(result.purity_steps.end(), frozen.purity_steps.begin(), frozen.purity_steps.end());
+        result.mi_steps.insert(result.mi_steps.end(), frozen.mi_steps.begin(), frozen.mi_steps.end());
+        m_sliced_state.biome_step[biome_id] = m_sliced_state.total_steps;
+        return true;
+    }
+    const float max_dt = _lod_max_dt(biome_id, lod, m_sliced_state.dt, m_sliced_state.max_dt);
+    const int mi_stride = _mi_stride(lod);
+    const bool want_mi = observables & LOOKAHEAD_MI;
+    const bool mi_now = want_mi && ((step % mi_stride == 0) || result.mi_steps.empty());
+
+    Ref<QuantumTrajectoryEngine> ensemble = m_trajectory_engines[biome_id];
+    if (ensemble.is_valid() &&
+        (step > 0 || ensemble->initialize_from_rho(m_sliced_state.biome_rho[biome_id]))) {
+        // Trajectory ensemble persists across slices; sampled from ρ on step 0
+        ensemble->evolve(_ensemble_step_span(biome_id, m_sliced_state.dt, max_dt), max_dt);
+        PackedFloat64Array evolved_rho = ensemble->get_density_matrix();
+        result.steps.push_back(keep_rho ? evolved_rho : PackedFloat64Array());
+        if (keep_bloch) {
+            result.bloch_steps.push_back(ensemble->compute_bloch_metrics(num_qubits));
+        }
+        if (observables & LOOKAHEAD_PURITY) {
+            result.purity_steps.push_back(ensemble->compute_purity());
+        }
+        if (want_mi) {
+            result.mi_steps.push_back(mi_now ? ensemble->compute_all_mutual_information(num_qubits)
+                                             : result.mi_steps.back());
+        }
+
+        m_sliced_state.biome_rho[biome_id] = evolved_rho;
+        m_sliced_state.biome_step[biome_id]++;
+        return (m_sliced_state.biome_step[biome_id] >= m_sliced_state.total_steps);
+    }
 
-    // Evolve one step
-    PackedFloat64Array evolved_rho = engine->evolve(
-        m_sliced_state.current_rho,
-        m_sliced_state.dt,
-        m_sliced_state.max_dt
-    );
+    // Evolve one step (in place on a copy-on-write split of the biome state)
+    PackedFloat64Array evolved_rho = m_sliced_state.biome_rho[biome_id];
+    engine->evolve_inplace(evolved_rho, m_sliced_state.dt, max_dt);
 
     // Apply LNN phase modulation if enabled
     _apply_lnn_phase_modulation(biome_id, evolved_rho);
 
-    // Store results
-    result.steps.push_back(evolved_rho);
-    result.bloch_steps.push_back(
-        engine->compute_bloch_metrics_from_packed(evolved_rho, num_qubits));
-
-    double purity = engine->compute_purity_from_packed(evolved_rho);
-    result.purity_steps.push_back(purity);
-
-    // Adaptive MI computation (full scan on first step only)
-    bool force_full_scan = (step == 0);
-    result.mi_steps.push_back(
-        engine->compute_mi_adaptive(evolved_rho, num_qubits, purity, force_full_scan));
+    // Store results: Bloch, purity and adaptive MI (incremental candidates +
+    // rotating re-screen) from one fused sweep [bloch n·8][purity][mi],
+    // each section only when selected
+    const int mask = step_observable_mask(observables, mi_now);
+    const PackedFloat64Array values =
+        mask ? engine->compute_observables_from_packed(evolved_rho, num_qubits, mask) : PackedFloat64Array();
+    const ObservableSpans spans = observable_spans(num_qubits, mask);
+    result.steps.push_back(keep_rho ? evolved_rho : PackedFloat64Array());
+    if (keep_bloch) {
+        result.bloch_steps.push_back(values.slice(0, std::min<int64_t>(spans.bloch_len, values.size())));
+    }
+    if (observables & LOOKAHEAD_PURITY) {
+        result.purity_steps.push_back(values.size() > spans.purity_at ? values[spans.purity_at] : 0.0);
+    }
+    if (want_mi) {
+        result.mi_steps.push_back(mi_now ? values.slice(spans.mi_at) : result.mi_steps.back());
+    }
 
     // Update state for next step
-    m_sliced_state.current_rho = evolved_rho;
-    m_sliced_state.current_step++;
+    m_sliced_state.biome_rho[biome_id] = evolved_rho;
+    m_sliced_state.biome_step[biome_id]++;
 
     // Check if this biome is complete
-    return (m_sliced_state.current_step >= m_sliced_state.total_steps);
+    return (m_sliced_state.biome_step[biome_id] >= m_sliced_state.total_steps);
+}
+
+bool MultiBiomeLookaheadEngine::_can_slice_within_step(int biome_id) const {
+    return biome_id < static_cast<int>(m_engines.size()) && m_trajectory_engines[biome_id].is_null() &&
+           get_effective_biome_lod(biome_id) != LOD_FROZEN && _engine(biome_id)->is_batchable() &&
+           biome_id < static_cast<int>(m_biome_step_cost_us.size());
+}
+
+bool MultiBiomeLookaheadEngine::_do_partial_sliced_step(int biome_id, double budget_us) {
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point deadline =
+        Clock::now() + std::chrono::microseconds(static_cast<int64_t>(std::max(budget_us, 0.0)));
+    SlicedComputeState::PartialStep& partial = m_sliced_state.partial[biome_id];
+    Ref<QuantumEvolutionEngine> engine = _engine(biome_id);
+    const int num_qubits = m_num_qubits[biome_id];
+    BiomeStepResult& result = m_sliced_state.biome_results[biome_id];
+
+    if (partial.phase == SlicedComputeState::PARTIAL_IDLE) {
+        const int step = m_sliced_state.biome_step[biome_id];
+        _check_stationary(biome_id, m_sliced_state.biome_rho[biome_id]);
+        const int lod = get_effective_biome_lod(biome_id);
+        const float max_dt = _lod_max_dt(biome_id, lod, m_sliced_state.dt, m_sliced_state.max_dt);
+        const int mi_stride = _mi_stride(lod);
+        partial.mi_now = (m_sliced_state.observables & LOOKAHEAD_MI) &&
+                         ((step % mi_stride == 0) || result.mi_steps.empty());
+        if (lod == LOD_FROZEN || !engine->begin_sliced_step(m_sliced_state.biome_rho[biome_id],
+                                                            m_sliced_state.dt, max_dt, partial.evolve)) {
+            // Not sliceable (any more): one whole step
+            _do_one_sliced_step(biome_id);
+            return true;
+        }
+        partial.phase = SlicedComputeState::PARTIAL_EVOLVE;
+    }
+
+    if (partial.phase == SlicedComputeState::PARTIAL_EVOLVE) {
+        while (!engine->continue_sliced_step(partial.evolve, 1)) {
+            if (Clock::now() >= deadline) {
+                return false;
+            }
+        }
+        const int dim = engine->get_dimension();
+        partial.evolved.resize(static_cast<int64_t>(dim) * dim * 2);
+        Eigen::Map<QuantumEvolutionEngine::RhoMatrix>(
+            reinterpret_cast<std::complex<double>*>(partial.evolved.ptrw()), dim, dim) = partial.evolve.rho;
+        _apply_lnn_phase_modulation(biome_id, partial.evolved);
+        engine->begin_sliced_observables(
+            num_qubits, step_observable_mask(m_sliced_state.observables, partial.mi_now), partial.observe);
+        partial.phase = SlicedComputeState::PARTIAL_OBSERVE;
+        if (Clock::now() >= deadline) {
+            return false;
+        }
+    }
+
+    // Observable sweep, a few rows at a time (pairs for MI ride along)
+    const int dim = engine->get_dimension();
+    Eigen::Map<const QuantumEvolutionEngine::RhoMatrix> rho(
+        reinterpret_cast<const std::complex<double>*>(partial.evolved.ptr()), dim, dim);
+    while (!engine->continue_sliced_observables(rho, partial.observe, SLICED_OBSERVABLE_ROWS)) {
+        if (Clock::now() >= deadline) {
+            return false;
+        }
+    }
+    std::vector<double> observables(QuantumEvolutionEngine::observables_size(num_qubits, partial.observe.mask));
+    engine->finish_sliced_observables(partial.observe, observables.data());
+
+    // Same result entries as _do_one_sliced_step
+    const int selected = m_sliced_state.observables;
+    const ObservableSpans spans = observable_spans(num_qubits, partial.observe.mask);
+    const bool last_step = m_sliced_state.biome_step[biome_id] + 1 == m_sliced_state.total_steps;
+    result.steps.push_back(((selected & LOOKAHEAD_FULL_RHO) || last_step) ? partial.evolved
+                                                                           : PackedFloat64Array());
+    if (selected & (LOOKAHEAD_BLOCH | LOOKAHEAD_ICON_MAP)) {
+        PackedFloat64Array bloch;
+        bloch.resize(spans.bloch_len);
+        std::copy(observables.begin(), observables.begin() + spans.bloch_len, bloch.ptrw());
+        result.bloch_steps.push_back(bloch);
+    }
+    if (spans.purity_at >= 0) {
+        result.purity_steps.push_back(observables[spans.purity_at]);
+    }
+    if (partial.mi_now) {
+        PackedFloat64Array mi;
+        mi.resize(static_cast<int64_t>(observables.size()) - spans.mi_at);
+        std::copy(observables.begin() + spans.mi_at, observables.end(), mi.ptrw());
+        result.mi_steps.push_back(mi);
+    } else if (selected & LOOKAHEAD_MI) {
+        result.mi_steps.push_back(result.mi_steps.back());
+    }
+
+    m_sliced_state.biome_rho[biome_id] = partial.evolved;
+    m_sliced_state.biome_step[biome_id]++;
+    partial.evolved = PackedFloat64Array();
+    partial.phase = SlicedComputeState::PARTIAL_IDLE;
+    return true;
 }
 
 bool MultiBiomeLookaheadEngine::is_sliced_compute_complete() const {
@@ -792,6 +7426,7 @@ bool MultiBiomeLookaheadEngine::is_sliced_compute_complete() const {
 }
 
 Dictionary MultiBiomeLookaheadEngine::get_sliced_compute_result() {
+    std::unique_lock<std::mutex> evolve_lock(m_evolve_mutex);
     Dictionary result;
 
     if (!m_sliced_state.complete) {
@@ -800,6 +7435,11 @@ Dictionary MultiBiomeLookaheadEngine::get_sliced_compute_result() {
         return result;
     }
 
+    _publish_lookahead_snapshots(m_sliced_state.biome_results, m_sliced_state.total_steps);
+    std::vector<WatchEvent> watch_events;
+    _evaluate_watches(m_sliced_state.biome_results, watch_events);
+    _evaluate_predicates(m_sliced_state.biome_results);
+
     Array all_results;
     Array all_mi;
     Array all_mi_steps;
@@ -807,6 +7447,8 @@ Dictionary MultiBiomeLookaheadEngine::get_sliced_compute_result() {
     Array all_purity_steps;
     Array all_metadata;
     Array all_couplings;
+    PackedInt64Array metadata_versions;
+    PackedInt64Array coupling_versions;
     Array all_icon_maps;
 
     int num_biomes = static_cast<int>(m_sliced_state.biome_results.size());
@@ -835,8 +7477,10 @@ Dictionary MultiBiomeLookaheadEngine::get_sliced_compute_result() {
 
         // Bloch steps
         Array biome_bloch_steps;
-        for (const auto& bloch_step : biome_result.bloch_steps) {
-            biome_bloch_steps.push_back(bloch_step);
+        if (m_sliced_state.observables & LOOKAHEAD_BLOCH) {
+            for (const auto& bloch_step : biome_result.bloch_steps) {
+                biome_bloch_steps.push_back(bloch_step);
+            }
         }
         all_bloch_steps.push_back(biome_bloch_steps);
 
@@ -847,19 +7491,8 @@ Dictionary MultiBiomeLookaheadEngine::get_sliced_compute_result() {
         }
         all_purity_steps.push_back(biome_purity_steps);
 
-        // Metadata
-        if (biome_id < static_cast<int>(m_metadata.size())) {
-            all_metadata.push_back(m_metadata[biome_id]);
-        } else {
-            all_metadata.push_back(Dictionary());
-        }
-
-        // Couplings
-        if (biome_id < static_cast<int>(m_couplings.size())) {
-            all_couplings.push_back(m_couplings[biome_id]);
-        } else {
-            all_couplings.push_back(Dictionary());
-        }
+        // Metadata and couplings (only those the consumer hasn't acknowledged)
+        _append_payloads(biome_id, all_metadata, all_couplings, metadata_versions, coupling_versions);
 
         // Icon maps
         all_icon_maps.push_back(biome_result.icon_map);
@@ -872,16 +7505,70 @@ Dictionary MultiBiomeLookaheadEngine::get_sliced_compute_result() {
     result["purity_steps"] = all_purity_steps;
     result["metadata"] = all_metadata;
     result["couplings"] = all_couplings;
+    result["metadata_versions"] = metadata_versions;
+    result["coupling_versions"] = coupling_versions;
     result["icon_maps"] = all_icon_maps;
 
-    // Clear state after retrieving result
-    m_sliced_state.reset();
+    // Done; finished steps stay for a restart with the same inputs
+    m_sliced_state.retire();
+
+    evolve_lock.unlock();
+    _emit_watch_events(watch_events);
+    return result;
+}
+
+Dictionary MultiBiomeLookaheadEngine::get_partial_result(int biome_id) {
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    Dictionary result;
+    if (!m_sliced_state.in_progress && !m_sliced_state.complete) {
+        return result;
+    }
+    if (biome_id < 0 || biome_id >= m_sliced_state.num_biomes) {
+        UtilityFunctions::push_warning("MultiBiomeLookaheadEngine: get_partial_result biome " +
+                                       String::num_int64(biome_id) + " out of range");
+        return result;
+    }
+    if (m_sliced_state.biome_step[biome_id] < m_sliced_state.total_steps) {
+        return result;  // Still stepping
+    }
+
+    BiomeStepResult& biome_result = m_sliced_state.biome_results[biome_id];
+    const int observables = m_sliced_state.observables;
+    if ((observables & LOOKAHEAD_ICON_MAP) && biome_result.icon_map.is_empty()) {
+        biome_result.icon_map = _build_icon_map(biome_id, biome_result.bloch_steps);
+    }
 
+    Array steps;
+    for (const auto& step_rho : biome_result.steps) {
+        steps.push_back(step_rho);
+    }
+    Array mi_steps;
+    for (const auto& mi_step : biome_result.mi_steps) {
+        mi_steps.push_back(mi_step);
+    }
+    Array bloch_steps;
+    if (observables & LOOKAHEAD_BLOCH) {
+        for (const auto& bloch_step : biome_result.bloch_steps) {
+            bloch_steps.push_back(bloch_step);
+        }
+    }
+    Array purity_steps;
+    for (double purity_val : biome_result.purity_steps) {
+        purity_steps.push_back(purity_val);
+    }
+
+    result["results"] = steps;
+    result["mi"] = biome_result.mi_steps.empty() ? PackedFloat64Array() : biome_result.mi_steps.back();
+    result["mi_steps"] = mi_steps;
+    result["bloch_steps"] = bloch_steps;
+    result["purity_steps"] = purity_steps;
+    result["icon_map"] = biome_result.icon_map;
     return result;
 }
 
 void MultiBiomeLookaheadEngine::cancel_sliced_compute() {
-    m_sliced_state.reset();
+    std::lock_guard<std::mutex> evolve_lock(m_evolve_mutex);
+    m_sliced_state.retire();
 }
 
 float MultiBiomeLookaheadEngine::get_sliced_compute_progress() const {
@@ -889,18 +7576,14 @@ float MultiBiomeLookaheadEngine::get_sliced_compute_progress() const {
         return m_sliced_state.complete ? 1.0f : 0.0f;
     }
 
-    int num_biomes = static_cast<int>(m_sliced_state.biome_rhos.size());
-    if (num_biomes > static_cast<int>(m_engines.size())) {
-        num_biomes = static_cast<int>(m_engines.size());
-    }
-
+    const int num_biomes = m_sliced_state.num_biomes;
     if (num_biomes == 0 || m_sliced_state.total_steps == 0) {
         return 1.0f;
     }
 
     int total_work = num_biomes * m_sliced_state.total_steps;
-    int completed_work = m_sliced_state.current_biome * m_sliced_state.total_steps
-                       + m_sliced_state.current_step;
+    int completed_work = std::accumulate(m_sliced_state.biome_step.begin(),
+                                         m_sliced_state.biome_step.end(), 0);
 
     return static_cast<float>(completed_work) / static_cast<float>(total_work);
 }
@@ -3,14 +3,30 @@
 
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
 #include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include "latency_histograms.h"
 #include "quantum_evolution_engine.h"
+#include "quantum_trajectory_engine.h"
 #include "liquid_neural_net.h"
 #include "force_graph_engine.h"
+#include "snapshot_channel.h"
+#include "native_task_graph.h"
+#include "profile_counters.h"
+#include "lookahead_recorder.h"
+#include "telemetry_ring.h"
+#include "frame_arena.h"
 #include <vector>
+#include <map>
+#include <deque>
+#include <algorithm>
 #include <memory>
 #include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 namespace godot {
 
@@ -25,10 +41,28 @@ namespace godot {
  * Performance gain: 4ms bridge cost amortized over (biomes × steps) evolutions
  * Example: 6 biomes × 5 steps = 30 evolutions for cost of 1 bridge crossing
  */
-class MultiBiomeLookaheadEngine : public RefCounted {
+class MultiBiomeLookaheadEngine : public RefCounted, public LatencyTracked<MultiBiomeLookaheadEngine> {
     GDCLASS(MultiBiomeLookaheadEngine, RefCounted)
 
 public:
+    // Per-biome level of detail, cheapest last
+    enum BiomeLOD {
+        LOD_FULL = 0,        // Every step, MI every step
+        LOD_REDUCED_MI = 1,  // Every step, MI every lod_mi_stride steps (reused between)
+        LOD_COARSE = 2,      // Reduced MI + one substep per step (max_dt raised to dt)
+        LOD_FROZEN = 3       // No evolution: the current state is repeated for every step
+    };
+
+    // Frame-budget governor levels, each including the ones before it
+    enum GovernorLevel {
+        GOVERNOR_FULL = 0,          // No degradation
+        GOVERNOR_LINEAR_MI = 1,     // Linear-entropy MI at every purity
+        GOVERNOR_MI_STRIDE = 2,     // MI at most every other step
+        GOVERNOR_FEWER_STEPS = 3,   // Lookahead calls run half the requested steps
+        GOVERNOR_FLOAT32 = 4,       // Every biome evolves in single precision
+        GOVERNOR_COARSE_FORCE = 5   // Force-graph substep cap divided by 4
+    };
+
     MultiBiomeLookaheadEngine();
     ~MultiBiomeLookaheadEngine();
 
@@ -44,10 +78,129 @@ public:
      * @param H_packed Hamiltonian (packed complex matrix)
      * @param lindblad_triplets Array of PackedFloat64Array (triplets for each L_k)
      * @param num_qubits Number of qubits in this biome (for MI computation)
+     * @param num_trajectories > 0 opts the biome into QuantumTrajectoryEngine
+     *        (Monte Carlo wavefunctions, O(dim) per trajectory) instead of the
+     *        dense density-matrix engine; for biomes beyond ~8 qubits
+     * @param metadata Optional biome metadata (same as set_biome_metadata);
+     *        when given, the icon index and coupling payload are built here
+     *        once instead of on the first metadata push
      * @return biome_id for referencing in evolve calls
+     *
+     * The dense engine's finalize() (L†, L†L, H_eff, operator forms) is
+     * queued on a background preparation thread, which runs the queued
+     * biomes across the shared pool as a low-priority job (a frame
+     * lookahead takes the pool over at the next biome boundary), so a
+     * scene registering many biomes returns at once. Anything that touches
+     * the biome's engine first waits for its preparation; see
+     * get_pending_preparations.
      */
     int register_biome(int dim, const PackedFloat64Array& H_packed,
-                       const Array& lindblad_triplets, int num_qubits);
+                       const Array& lindblad_triplets, int num_qubits,
+                       int num_trajectories = 0, const Dictionary& metadata = Dictionary());
+
+    /**
+     * Patch a registered biome's operators in place instead of re-registering.
+     * update_biome_hamiltonian assigns H(row, col) for each [row, col, re, im]
+     * quadruple (send both halves of an off-diagonal pair); replace_biome_lindblad
+     * swaps Lindblad operator k for new triplets (same layout as
+     * register_biome). The biome keeps its rho, metadata, LNN and force graph;
+     * buffered lookahead frames computed with the old operators are dropped
+     * and the coupling payload is recomputed. Dense biomes only.
+     *
+     * @return false (with a warning) on a bad biome, index or triplet
+     */
+    bool update_biome_hamiltonian(int biome_id, const PackedFloat64Array& triplets);
+    bool replace_biome_lindblad(int biome_id, int k, const PackedFloat64Array& triplets);
+
+    /**
+     * Register many biomes from one packed blob: the whole blob is validated
+     * first, then every biome's engines are built and finalized in parallel
+     * and appended in order (one log line for the batch). Little-endian:
+     *
+     *   header: u32 magic 'SWBB' (0x42425753), u32 version (1), u32 count
+     *   biome:  u32 dim, u32 num_qubits, u32 num_trajectories,
+     *           u32 H entry count, u32 Lindblad count L,
+     *           u32 entry count per Lindblad operator × L,
+     *           then the entries, H first: {u32 row, u32 col, f64 re, f64 im}
+     *
+     * @param metadata Optional Array of per-biome Dictionaries (as
+     *        register_biome's metadata)
+     * @return new biome ids in blob order; empty (with a warning and nothing
+     *         registered) if the blob is malformed
+     */
+    PackedInt32Array register_biomes_bulk(const PackedByteArray& blob, const Array& metadata = Array());
+
+    /**
+     * Stress workload: register `count` synthetic dense biomes without any
+     * GDScript assembly (built as an SWBB blob and registered through
+     * register_biomes_bulk, so finalize runs in parallel). Biome b depends
+     * only on (seed, b), so a run is reproducible and a larger count extends
+     * a smaller one.
+     *
+     * Each biome draws its qubit count from [min_qubits, max_qubits]
+     * (clamped to 1..10); H has random diagonal energies plus a
+     * hamiltonian_density fraction of the off-diagonal pairs coupled
+     * (Hermitian); lindblad_count single-qubit operators alternate decay σ⁻
+     * and dephasing σz on random qubits; the initial rho mixes a random pure
+     * state with I/dim to Tr(ρ²) = initial_purity (clamped to [1/dim, 1]).
+     *
+     * @return new biome ids (empty, with a warning, for count < 1)
+     */
+    PackedInt32Array register_synthetic_biomes(int count, int seed, int min_qubits = 3, int max_qubits = 6,
+                                               int lindblad_count = 4, double hamiltonian_density = 0.2,
+                                               double initial_purity = 1.0);
+
+    /**
+     * Save / restore every biome in one versioned binary blob, so a scene
+     * reload or save game skips GDScript operator assembly and finalize().
+     * Per biome: engine settings, compressed H, Lindblad operators with
+     * their cached L†/L†L, H_eff and the Liouvillian (restored as is, not
+     * recomputed), metadata and coupling payload, resident rho, force
+     * positions / velocities and center, LNN weights and hidden state
+     * (shared LNNs stay shared), priority, budget, LOD and active flag.
+     * Lookahead frames are not stored (reseed after loading), trajectory
+     * ensembles are rebuilt from the restored operators, and engine-wide
+     * settings (force parameters, lookahead depth, ...) are left as they are.
+     *
+     *   header: u32 magic 'SWES' (0x53455753), u32 version (1), u32 count
+     *
+     * load_snapshot replaces every registered biome.
+     * @return false (with a warning, biomes unchanged) on a foreign,
+     *         truncated or malformed blob
+     */
+    PackedByteArray save_snapshot();
+    bool load_snapshot(const PackedByteArray& blob);
+
+    /**
+     * On-disk cache of finalized operators, keyed by a content hash of each
+     * biome's register_biome inputs (dim, H, Lindblad triplets, trajectory
+     * opt-in). On a hit the compressed operators, L†/L†L, H_eff and
+     * Liouvillian are read back from the file (one buffered read) instead of
+     * being rebuilt; a miss builds as usual and writes the entry. Applies to
+     * register_biome and register_biomes_bulk.
+     *
+     * @param dir Cache directory, e.g. "user://native_operator_cache"
+     *        (created if missing); "" disables the cache (the default)
+     */
+    void set_operator_cache_dir(const String& dir);
+    String get_operator_cache_dir() const;
+    // {"hits", "misses", "writes"} since the engine was created
+    Dictionary get_operator_cache_stats() const;
+
+    /**
+     * Check if a biome evolves as a quantum-trajectory ensemble.
+     */
+    bool is_trajectory_biome(int biome_id) const;
+
+    /**
+     * Mark a biome active or inactive. Inactive biomes are skipped by every
+     * evolve path (no task, no step results, nothing to assemble) without
+     * looking at their rho. register_biome starts a biome active when it has
+     * any operator (H or Lindblad); set_biome_rho with an empty array clears
+     * it and a non-empty one sets it. An empty rho is always skipped.
+     */
+    void set_biome_active(int biome_id, bool active);
+    bool is_biome_active(int biome_id) const;
 
     /**
      * Clear all registered biomes (for reinitialization).
@@ -59,14 +212,35 @@ public:
      */
     int get_biome_count() const;
 
+    /**
+     * Registered biomes whose operator preparation is still queued or
+     * running (0 once every engine is finalized). Loading screens can poll
+     * this instead of blocking in the first evolve call.
+     */
+    int get_pending_preparations() const;
+
     /**
      * Enable phase-shadow LNN for a biome.
      * Creates a LiquidNeuralNet that modulates density matrix phases.
      *
      * @param biome_id Which biome to enable LNN for
      * @param hidden_size Number of hidden neurons (typically dim/4)
+     * @param weights_path Optional save_biome_lnn snapshot to warm start from;
+     *        used instead of Xavier initialization when its dims match
+     *        (dim → hidden_size → dim), otherwise ignored with a warning
+     */
+    void enable_biome_lnn(int biome_id, int hidden_size, const String& weights_path = String());
+
+    /**
+     * Enable one phase-shadow LNN shared by several equal-dimension biomes.
+     * Each biome keeps its own hidden state; evolve_resident steps the group
+     * in lockstep and runs one batched forward pass (matrix-matrix products)
+     * per step for all of them instead of one matrix-vector pass each.
+     *
+     * @param biome_ids Biomes to share the network (all the same dimension)
+     * @param hidden_size Number of hidden neurons (typically dim/4)
      */
-    void enable_biome_lnn(int biome_id, int hidden_size);
+    void enable_shared_lnn(const PackedInt32Array& biome_ids, int hidden_size);
 
     /**
      * Disable phase-shadow LNN for a biome.
@@ -78,28 +252,395 @@ public:
      */
     bool is_lnn_enabled(int biome_id) const;
 
+    /**
+     * Run a biome's LNN forward pass only every `stride` steps (default 1 =
+     * every step). In between, the applied phase deltas are interpolated
+     * linearly from the previous pass's output to the latest one, so the
+     * modulation lags by up to one stride; the hidden state also advances
+     * once per stride. Biomes with stride > 1 leave shared-LNN batching.
+     */
+    void set_biome_lnn_stride(int biome_id, int stride);
+    int get_biome_lnn_stride(int biome_id) const;
+
+    /**
+     * Write a biome's LNN weights as a binary snapshot (see
+     * LiquidNeuralNet::save_weights for the layout).
+     * @return false if the LNN is disabled or the file can't be written
+     */
+    bool save_biome_lnn(int biome_id, const String& path) const;
+
+    /**
+     * Replace a biome's LNN with one loaded from a save_biome_lnn snapshot
+     * (enabling it if needed). The snapshot's input/output size must equal
+     * the biome dimension; the hidden size comes from the file.
+     * @return false (LNN unchanged) on a missing, foreign or mismatched file
+     */
+    bool load_biome_lnn(int biome_id, const String& path);
+
+    /**
+     * Record a biome's LNN inputs for training: the phases and hidden state
+     * of the last `window` forward passes are kept in a ring (0 = stop).
+     */
+    void set_lnn_recording(int biome_id, int window);
+
+    /**
+     * Train a biome's LNN in the background on its recorded trajectory.
+     * The weights are snapshotted and trained with truncated BPTT on a worker
+     * thread to predict the per-step phase drift of the diagonal; inference
+     * keeps using the current weights meanwhile. Once finished, each biome
+     * sharing the network swaps the trained copy in before its next forward
+     * pass (no lock on the frame path).
+     *
+     * @param biome_id Biome whose recording is used
+     * @param truncation BPTT window length in steps
+     * @param epochs Passes over the recording
+     * @return false if the LNN is disabled, already training or has fewer
+     *         than two recorded steps
+     */
+    bool train_lnn_async(int biome_id, int truncation = 16, int epochs = 1);
+
+    /**
+     * Check if a training job for a biome's LNN is still running.
+     */
+    bool is_lnn_training(int biome_id) const;
+
+    /**
+     * Mean squared error of the last completed training job (-1 if none).
+     */
+    double get_lnn_training_loss(int biome_id) const;
+
+    /**
+     * Run a biome's lookahead in single precision (complex<float>).
+     * Lookahead frames mostly drive visuals, so float is sufficient; the engine
+     * resyncs in double every resync_interval steps to bound drift.
+     *
+     * @param biome_id Which biome to configure
+     * @param single_precision true = float evolution (and float LNN forward
+     *        for the fixed-size shapes), false = double (default)
+     * @param resync_interval Steps between double-precision resyncs
+     */
+    void set_biome_precision(int biome_id, bool single_precision, int resync_interval = 8);
+
+    /**
+     * Check if a biome evolves in single precision.
+     */
+    bool is_biome_single_precision(int biome_id) const;
+
+    /**
+     * Euler drift thresholds of every biome engine (see
+     * QuantumEvolutionEngine.set_drift_thresholds); biomes registered later
+     * get them too. A biome whose sampled drift exceeds one escalates to
+     * Euler substeps, then the Kraus integrator.
+     */
+    void set_drift_thresholds(double trace_error, double hermiticity_error, double negative_mass);
+
+    /**
+     * A biome's drift metrics and fallback level
+     * (QuantumEvolutionEngine.get_drift_stats); empty for an invalid id.
+     */
+    Dictionary get_biome_drift_stats(int biome_id);
+
+    /**
+     * MI screening audits every `calls` adaptive MI calls on every biome
+     * engine, biomes registered later included (see
+     * QuantumEvolutionEngine.set_mi_audit_interval); 0 = off (default).
+     */
+    void set_mi_audit_interval(int calls);
+    int get_mi_audit_interval() const;
+
+    /**
+     * A biome's MI screening counters (QuantumEvolutionEngine.get_mi_screen_stats:
+     * pairs screened / kept / skipped, linear vs eigen calls, audited
+     * false-negative rate); empty for an invalid id. Cleared by
+     * reset_profile_stats.
+     */
+    Dictionary get_biome_mi_screen_stats(int biome_id);
+
+    /**
+     * Reuse cached Bloch/MI entries for a settled biome.
+     *
+     * @param biome_id Which biome to configure
+     * @param tolerance Max reduced-matrix change before recompute (0 = always recompute)
+     */
+    void set_biome_observable_tolerance(int biome_id, double tolerance);
+
     // ========================================================================
-    // PACING CONFIGURATION (CPU-gentle mode)
+    // SCHEDULING (per-frame CPU budget for time-sliced compute)
     // ========================================================================
 
     /**
-     * Set pacing delay between evolution steps (milliseconds).
-     * When > 0, C++ sleeps between steps to spread CPU load over time.
-     * This prevents CPU spikes without requiring more GDScript↔C++ calls.
+     * Set a biome's scheduling priority for continue_sliced_compute.
+     * Higher priorities are stepped first each frame; ties go by biome_id.
      *
-     * @param delay_ms Milliseconds to sleep between steps (0 = disabled, default 1)
+     * @param biome_id Which biome to configure
+     * @param priority Scheduling priority (default 0)
      */
-    void set_pacing_delay_ms(int delay_ms);
+    void set_biome_priority(int biome_id, int priority);
+    int get_biome_priority(int biome_id) const;
+
+    /**
+     * Cap the CPU time a biome may use per continue_sliced_compute call.
+     * Steps the biome can't fit are deferred to later frames.
+     *
+     * @param biome_id Which biome to configure
+     * @param budget_ms Milliseconds per frame (0 = no cap below the frame budget, default)
+     */
+    void set_biome_budget_ms(int biome_id, double budget_ms);
+    double get_biome_budget_ms(int biome_id) const;
+
+    /**
+     * Running estimate of one sliced step's cost for a biome (microseconds,
+     * exponential moving average; 0 until the biome has been stepped).
+     */
+    double get_biome_step_cost_us(int biome_id) const;
+
+    /**
+     * Predicted per-pass costs per biome from an online cost model. Each
+     * stage's cost is modelled as coefficient × work, where work follows the
+     * biome's current shape (evolve: operator nnz, × dim unless the
+     * Liouvillian is assembled; MI: candidate pairs + re-screen budget;
+     * force: nodes² + candidate springs). The coefficient is an exponential
+     * moving average of measured µs / work from every evolve path (batched,
+     * single, sliced, ring refill, async); a biome not yet measured for a
+     * stage borrows the mean coefficient of the biomes that were. So a
+     * biome whose couplings or MI candidates change is re-predicted at once,
+     * before it is stepped again.
+     *
+     * @return Array (index = biome_id) of Dictionaries:
+     *   "evolve_step_us", "mi_pass_us", "force_pass_us": predicted µs
+     *         (0 when no biome has measured that stage yet)
+     *   "step_us": their sum, one full lookahead step
+     *   "dim", "nnz", "mi_candidates", "force_nodes": current work inputs
+     *   "evolve_samples", "mi_samples", "force_samples": passes measured
+     */
+    Array get_cost_estimates();
+
+    /**
+     * Set a biome's level of detail (BiomeLOD). Applies to every evolve path
+     * (batched, single, sliced, ring refill, async).
+     */
+    void set_biome_lod(int biome_id, int lod);
+    int get_biome_lod(int biome_id) const;  // Explicit tier, as set
+
+    /**
+     * Tier a biome actually runs at: with a focus biome set, the focus runs
+     * LOD_FULL and every other biome at least background_lod. A stationary
+     * biome (see set_steady_state_detection) runs LOD_FROZEN.
+     */
+    int get_effective_biome_lod(int biome_id) const;
+
+    /**
+     * Detect biomes that have relaxed to a fixed point: when ||ρ(t+δ) − ρ(t)||_F / δ
+     * stays below tolerance for window consecutive dense steps, the biome is
+     * marked stationary and runs as LOD_FROZEN (its state repeated, nothing
+     * evolved) until it is perturbed: an operator patch, or an input state
+     * farther than tolerance·δ·window from the stationary one. Biomes with an
+     * LNN or a trajectory ensemble are never marked.
+     *
+     * @param tolerance Rate threshold per unit time (0 = off, the default)
+     * @param window Consecutive steps below it
+     */
+    void set_steady_state_detection(double tolerance, int window = 8);
+    bool is_biome_stationary(int biome_id) const;
 
     /**
-     * Get current pacing delay.
+     * Solve a biome's steady state directly (sparse LU on its Liouvillian,
+     * see QuantumEvolutionEngine::compute_steady_state) and mark the biome
+     * stationary at exactly that state, so lookahead from it costs nothing.
+     * @return packed ρ_ss, empty (biome unchanged) if there is no unique one
+     */
+    PackedFloat64Array solve_biome_steady_state(int biome_id);
+
+    /**
+     * Large-biome mode: biomes of at least num_qubits qubits (10 qubits is
+     * 16 MB per ρ) keep observables only. Their lookahead results carry the
+     * full state for the last step alone (earlier "rho" entries are empty),
+     * they are evolved step by step on one resident buffer instead of a
+     * steps·dim² trajectory, and ring frames store ρ only at each refill's
+     * tail. The ring base then stays at the last materialized state while
+     * earlier frames are consumed, so invalidate_from() accepts only
+     * checkpoints that still hold a state. Memory per biome is O(dim²) no
+     * matter the lookahead depth.
+     *
+     * @param num_qubits Threshold (0 = off, the default)
+     */
+    void set_large_biome_qubits(int num_qubits);
+    int get_large_biome_qubits() const;
+    bool is_large_biome(int biome_id) const;
+
+    /**
+     * Derive tiers from camera focus. The focused biome is also stepped first
+     * by continue_sliced_compute, ahead of priorities.
+     *
+     * @param biome_id Biome being viewed (-1 = no focus, explicit tiers only)
+     * @param background_lod Minimum tier for every other biome
+     */
+    void set_focus_biome(int biome_id, int background_lod = LOD_REDUCED_MI);
+    int get_focus_biome() const;
+
+    /**
+     * Steps between MI recomputes at LOD_REDUCED_MI / LOD_COARSE (default 4).
+     */
+    void set_lod_mi_stride(int stride);
+    int get_lod_mi_stride() const;
+
+    /**
+     * Frame-budget governor: keep lookahead calls within budget_ms by walking
+     * down the GovernorLevel ladder. Each evolve_all_lookahead-style call is
+     * timed (up to marshalling); when the smoothed time exceeds the budget the
+     * level rises by one, and when it falls below 60% of the budget it drops
+     * by one, with at least 8 calls between changes so each level settles
+     * before the next decision. Levels override per-biome settings only while
+     * active: precision the governor forced is restored on recovery, and
+     * biomes the caller already set to float stay float.
+     *
+     * @param budget_ms Target time per lookahead call (0 = off, back to full quality)
      */
+    void set_frame_budget_ms(double budget_ms);
+    double get_frame_budget_ms() const;
+    int get_governor_level() const;
+    // {"level", "budget_ms", "smoothed_ms", "calls_at_level"}
+    Dictionary get_governor_stats();
+
+    /**
+     * Deprecated: the engine no longer sleeps between steps. Throttle with the
+     * sliced scheduler (frame budget + per-biome budgets/priorities) or move
+     * the work off the caller with submit_lookahead. The value is only stored.
+     */
+    void set_pacing_delay_ms(int delay_ms);
     int get_pacing_delay_ms() const;
 
+    // ========================================================================
+    // ENGINE-RESIDENT STATE (authoritative rho lives native-side)
+    // ========================================================================
+
+    /**
+     * Hand a biome's authoritative state to the engine. Batched entry points
+     * (evolve_all_lookahead[_packed], start_sliced_compute, submit_lookahead,
+     * seed_lookahead_buffer) called with an EMPTY biome_rhos Array then run
+     * from the resident states, so rho stops crossing the bridge every frame.
+     * Resets that biome's lookahead ring, if seeded.
+     *
+     * @param rho_packed Dense packed rho (2·dim² doubles); empty = inactive
+     *        (also sets the biome's activity flag, see set_biome_active)
+     */
+    void set_biome_rho(int biome_id, const PackedFloat64Array& rho_packed);
+
+    /**
+     * Current resident state (copy-on-write share; no copy until modified).
+     * Kept on the ring base by advance() when the ring buffer is in use.
+     */
+    PackedFloat64Array get_biome_rho(int biome_id) const;
+
+    /**
+     * Read-only observables of the resident state.
+     *
+     * @return Dictionary with "bloch", "purity", "mi"; empty if no resident state
+     */
+    Dictionary get_biome_observables(int biome_id);
+
+    /**
+     * Gameplay mutation without a rho round-trip: ρ ← A ρ A† / Tr on the
+     * resident state; a seeded ring is rolled back and refilled from it.
+     *
+     * @param op_packed Dense packed operator (same layout as H_packed)
+     * @return false if the biome has no resident state or the op was rejected
+     */
+    bool apply_biome_operator(int biome_id, const PackedFloat64Array& op_packed);
+
+    /**
+     * Measurement rolls (harvest, yield) from the resident state's
+     * populations: count draws of a basis state with probability ρ_ii, from
+     * a Walker alias table built once per call (O(dim), then O(1) a draw).
+     * Negative populations from drift count as 0. Same seed, same rolls.
+     *
+     * @param per_qubit false: basis indices (qubit 0 is the top bit);
+     *        true: count × num_qubits bits, one row of qubit outcomes per draw
+     * @return Empty if the biome has no resident state
+     */
+    PackedInt32Array sample_outcomes(int biome_id, int count, int64_t seed, bool per_qubit = false);
+    /**
+     * sample_outcomes for many biomes at once, one task per biome:
+     * entry i equals sample_outcomes(i, counts[i], seed + i, per_qubit)
+     */
+    Array sample_outcomes_all(const PackedInt32Array& counts, int64_t seed, bool per_qubit = false);
+
+    /**
+     * Advance every resident state by steps·dt natively (no observables).
+     * For callers not using the ring buffer; rings are restarted from the new state.
+     */
+    void evolve_resident(int steps, float dt, float max_dt);
+
+    /**
+     * Evolve biomes concurrently on the shared native pool in evolve_all_lookahead.
+     * Biomes are independent until results are assembled (on the caller).
+     *
+     * @param enabled true = one pool task per biome (default), false = serial
+     */
+    void set_parallel_biomes(bool enabled);
+    bool get_parallel_biomes() const;
+
+    /**
+     * Evolve equal-dimension biomes together in evolve_all_lookahead: their
+     * rho are stacked into one tall matrix and the (block-diagonal) operators
+     * applied as a few wide sparse × dense products per step. Covers biomes
+     * on the default double-precision Euler integrator without LNN or
+     * trajectory ensembles; the rest evolve individually as before.
+     *
+     * @param enabled true = batch groups of >= 2 equal-dimension biomes (default false)
+     */
+    void set_batch_equal_dimensions(bool enabled);
+    bool get_batch_equal_dimensions() const;
+
+    /**
+     * Run evolve_all_lookahead as a task graph instead of one task per
+     * biome. Each biome's lookahead becomes evolve → (LNN) → observables →
+     * force nodes per step, ordered only by their real dependencies: step
+     * k+1 evolves once step k has (and its LNN modulation), observables of
+     * step k need its state (and the previous step's adaptive MI state),
+     * and the force layout of step k needs its observables and step k-1's
+     * layout. So the observables of step k overlap the evolution of step
+     * k+1, across biomes as well. Ensemble, large, frozen and batched
+     * biomes run whole as single nodes of the same graph.
+     *
+     * @param enabled true = task graph (default false: one task per biome)
+     */
+    void set_use_task_graph(bool enabled);
+    bool get_use_task_graph() const;
+
+    /**
+     * Repel bubbles of different biomes from each other. After every
+     * biome's force layout has been evolved (evolve_all_lookahead, refill),
+     * one farm-wide pass over all layouts pushes apart nodes of different
+     * biomes within the force engine's repulsion cutoff (spatial hash, O(n)).
+     * The push shows up in the frames evolved after it.
+     *
+     * @param enabled true = run the cross-biome pass (default false)
+     */
+    void set_cross_biome_repulsion(bool enabled);
+    bool get_cross_biome_repulsion() const;
+
     // ========================================================================
     // BATCHED EVOLUTION (single call for ALL biomes, ALL steps)
     // ========================================================================
 
+    // Per-call observables bitmask (evolve_all_lookahead[_packed],
+    // evolve_single_biome, start_sliced_compute). A stage whose outputs are
+    // all deselected is not run: without BLOCH, POSITIONS and ICON_MAP no
+    // single-qubit reductions are taken; without POSITIONS the force layout
+    // is not stepped (it holds its pose); without FULL_RHO only the last
+    // step's ρ is kept (the rest are never copied out). Deselected fields
+    // come back as empty per-biome arrays.
+    enum LookaheadObservables {
+        LOOKAHEAD_BLOCH = 1,      // "bloch_steps"
+        LOOKAHEAD_PURITY = 2,     // "purity_steps"
+        LOOKAHEAD_MI = 4,         // "mi_steps" / "mi"
+        LOOKAHEAD_POSITIONS = 8,  // "position_steps" / "velocity_steps"
+        LOOKAHEAD_ICON_MAP = 16,  // "icon_maps" / "icon_map"
+        LOOKAHEAD_FULL_RHO = 32,  // Every step of "results" (else the last only)
+        LOOKAHEAD_ALL = 63
+    };
+
     /**
      * Evolve all registered biomes forward by 'steps' timesteps.
      *
@@ -111,6 +652,7 @@ public:
      * @param steps Number of lookahead steps (e.g., 5 for 0.5s at 10Hz)
      * @param dt Time step per step (e.g., 0.1s for 10Hz physics)
      * @param max_dt Maximum substep for numerical stability (e.g., 0.02)
+     * @param observables LookaheadObservables bits to compute
      *
      * @return Dictionary with:
      *   "results": Array<Array<PackedFloat64Array>>
@@ -135,11 +677,233 @@ public:
      *         icon_maps[biome_id] = cumulative emoji probability map (sorted)
      */
     Dictionary evolve_all_lookahead(const Array& biome_rhos, int steps,
-                                    float dt, float max_dt);
+                                    float dt, float max_dt, int observables = LOOKAHEAD_ALL);
+
+    /**
+     * evolve_all_lookahead with flat output: one contiguous array per field
+     * instead of nested Arrays, so a frame costs a handful of Variants rather
+     * than one per (biome, step, field). Entry i = biome_id * steps + step.
+     *
+     * @return Dictionary with:
+     *   "num_biomes", "steps": int
+     *   "step_counts": PackedInt32Array, steps actually produced per biome
+     *         (0 for inactive biomes)
+     *   "rho" + "rho_offsets": PackedFloat64Array + PackedInt64Array (B·S+1);
+     *         entry i spans rho[rho_offsets[i] .. rho_offsets[i+1]) (empty if missing)
+     *   "mi" + "mi_offsets", "bloch" + "bloch_offsets": same scheme
+     *   "purity": PackedFloat64Array (B·S), purity[i] (0 if missing)
+     *   "positions", "velocities" + "node_offsets": PackedVector2Array, shared offsets
+     *   "icon_maps": Array<Dictionary>
+     * Metadata/couplings are not repeated; the caller already owns them.
+     */
+    Dictionary evolve_all_lookahead_packed(const Array& biome_rhos, int steps,
+                                           float dt, float max_dt, int observables = LOOKAHEAD_ALL);
+
+    /**
+     * Hand a lookahead result back once it has been consumed. The per-step
+     * rho, Bloch and MI arrays come from a per-biome pool and are written in
+     * place on the next call when nothing else still shares them (a shared
+     * one is copied on write, as a fresh allocation would be); dropping the
+     * result does that implicitly, this clears it right away so a Dictionary
+     * kept alive in a member variable doesn't pin last frame's buffers.
+     */
+    void release_result(Dictionary result);
+
+    // Sections and element types of evolve_all_lookahead_binary packets
+    enum PacketSection {
+        PACKET_STEP_COUNTS = 0,        // I32 (B)
+        PACKET_RHO_OFFSETS = 1,        // I64 (B·S+1), element offsets into PACKET_RHO
+        PACKET_RHO = 2,                // F64
+        PACKET_MI_OFFSETS = 3,         // I64 (B·S+1)
+        PACKET_MI = 4,                 // F64 or F32 (set_output_precision)
+        PACKET_BLOCH_OFFSETS = 5,      // I64 (B·S+1)
+        PACKET_BLOCH = 6,              // F64 or F32
+        PACKET_PURITY = 7,             // F64 or F32 (B·S)
+        PACKET_NODE_OFFSETS = 8,       // I64 (B·S+1), in nodes (2 floats each)
+        PACKET_POSITIONS = 9,          // F32 x,y pairs
+        PACKET_VELOCITIES = 10,        // F32 x,y pairs
+        PACKET_RHO_DELTA_OFFSETS = 11, // I64 (B·S+1), RHO_STORAGE_DELTA only
+        PACKET_RHO_DELTAS = 12,        // I16
+        PACKET_RHO_DELTA_SCALES = 13   // F64 (B·S)
+    };
+    enum PacketType {
+        PACKET_I32 = 0,
+        PACKET_I64 = 1,
+        PACKET_F32 = 2,
+        PACKET_F64 = 3,
+        PACKET_I16 = 4
+    };
+    static constexpr uint32_t PACKET_MAGIC = 0x504C5753;  // "SWLP" little-endian
+    static constexpr uint32_t PACKET_VERSION = 1;
+
+    /**
+     * evolve_all_lookahead_packed as one fixed-schema binary packet, so the
+     * hot path reads fields by offset (LookaheadPacket.gd) instead of hashing
+     * Dictionary keys. All values little-endian:
+     *   header (32 bytes): u32 magic, u32 version, u32 num_biomes, u32 steps,
+     *     u32 section_count, u32 reserved, u64 total_bytes
+     *   section table (24 bytes each): u32 PacketSection, u32 PacketType,
+     *     u64 element count, u64 byte offset from packet start (8-aligned)
+     *   section payloads
+     * Entry i = biome_id·steps + step; offset sections index elements of their
+     * data section exactly like the packed Dictionary. Readers must skip
+     * section ids they don't know; a new layout bumps PACKET_VERSION.
+     * Icon maps (Dictionaries) are not included.
+     */
+    PackedByteArray evolve_all_lookahead_binary(const Array& biome_rhos, int steps,
+                                                float dt, float max_dt);
+
+    // Numeric type of visual-only lookahead fields (set_output_precision)
+    enum OutputPrecision {
+        OUTPUT_PRECISION_DOUBLE = 0,  // PackedFloat64Array / float (default)
+        OUTPUT_PRECISION_FLOAT = 1    // PackedFloat32Array
+    };
+
+    /**
+     * With OUTPUT_PRECISION_FLOAT, lookahead results (evolve_all_lookahead(_packed),
+     * async and coupled lookahead) emit "mi", "bloch" and "purity" (packed) or
+     * "mi", "mi_steps", "bloch_steps" and per-biome "purity_steps" (nested) as
+     * PackedFloat32Array: half the bridge bytes and the renderer's upload format.
+     * ρ stays double (it feeds back into evolution); positions/velocities are
+     * Vector2 and already single precision in standard builds.
+     */
+    void set_output_precision(int precision);
+    int get_output_precision() const;
+
+    // How lookahead results carry ρ (set_rho_storage)
+    enum RhoStorage {
+        RHO_STORAGE_FULL = 0,   // Every step's dense ρ (default)
+        RHO_STORAGE_LAST = 1,   // Only the last step's ρ; earlier entries empty
+        RHO_STORAGE_DELTA = 2   // Step 0 dense, later steps as quantized deltas
+    };
+
+    /**
+     * Storage policy for the ρ entries of evolve_all_lookahead(_packed),
+     * async and coupled lookahead results (observables are unaffected;
+     * rings, sliced compute and evolve_single_biome keep full states).
+     *   RHO_STORAGE_LAST: earlier "rho" entries are empty, as for large biomes
+     *   RHO_STORAGE_DELTA: step 0 keeps its dense ρ, each later step k ships
+     *     q_k (int16 little-endian, 2 bytes per double) and scale_k with
+     *     ρ_k = ρ_(k-1) + scale_k · q_k, ρ_(k-1) being the decoded state, so
+     *     rounding never accumulates (error <= scale_k / 2 per element). Results
+     *     gain "rho_deltas" + "rho_delta_offsets" (PackedByteArray + offsets,
+     *     entry layout as "rho") and "rho_delta_scales" (PackedFloat64Array);
+     *     the nested layout gets Array<Array<PackedByteArray>> and
+     *     Array<PackedFloat64Array> under the same keys.
+     * Biomes whose steps already lack ρ (large biomes) are left as they are.
+     */
+    void set_rho_storage(int policy);
+    int get_rho_storage() const;
+
+    /**
+     * Dense ρ of every produced step of biome_id from a lookahead result
+     * (nested or packed, any storage policy). Steps a policy dropped
+     * (RHO_STORAGE_LAST) come back empty.
+     */
+    Array decode_rho_steps(const Dictionary& result, int biome_id) const;
+
+    // Cross-biome coupling kinds (add_biome_coupling)
+    enum CouplingKind {
+        COUPLING_POPULATION = 0,  // Incoherent |1⟩ transfer from the source qubit to the target qubit
+        COUPLING_AMPLITUDE = 1    // Coherent exchange: the source's transverse Bloch vector drives the target
+    };
+
+    /**
+     * Add a directed edge to the cross-biome coupling graph. Biomes evolve
+     * as separate density matrices, so an edge acts on reduced states
+     * between steps of evolve_coupled_lookahead (mean-field):
+     *   COUPLING_POPULATION: the source qubit is amplitude-damped with
+     *     γ = 1 - e^(-rate·dt) and the target qubit is excited by exactly the
+     *     population that left (capped at its |0⟩ population)
+     *   COUPLING_AMPLITUDE: the target qubit precesses under
+     *     H = rate/2 · (x_s σx + y_s σy) from the source's Bloch vector
+     * Every edge reads the pre-coupling states, so edge order does not matter.
+     * Qubit q is basis bit q, as for the engine's local operators.
+     *
+     * @return Coupling index, -1 if rejected
+     */
+    int add_biome_coupling(int source_biome, int source_qubit, int target_biome, int target_qubit,
+                           double rate, int kind = COUPLING_POPULATION);
+    void clear_biome_couplings();
+    int get_biome_coupling_count() const;
+
+    /**
+     * evolve_all_lookahead_packed with the coupling graph applied natively
+     * between steps: every biome advances one step (in parallel), then all
+     * edges are applied, then the next step starts from the coupled states.
+     * Same result layout as evolve_all_lookahead_packed; with no edges it
+     * matches it up to batching. Large biomes still return ρ for the last
+     * step only.
+     */
+    Dictionary evolve_coupled_lookahead(const Array& biome_rhos, int steps,
+                                        float dt, float max_dt);
+
+    // Observables a watch can test (add_watch)
+    enum WatchObservable {
+        WATCH_POPULATION = 0,  // P(|1⟩) of qubit index (Bloch p1)
+        WATCH_PURITY = 1,      // Tr(ρ²); index unused
+        WATCH_MI = 2           // Mutual information of pair index (upper-triangular order)
+    };
+    enum WatchComparator {
+        WATCH_ABOVE = 0,  // Fires when value > threshold
+        WATCH_BELOW = 1   // Fires when value < threshold
+    };
+
+    /**
+     * Register a gameplay predicate evaluated natively on every lookahead
+     * (evolve_all_lookahead(_packed), async, coupled and sliced results).
+     * When a step of the biome satisfies it, "watch_triggered"(watch_id,
+     * biome_id, step, value) is emitted with the first such step, and the
+     * watch disarms; it re-arms after a lookahead in which no step satisfies
+     * it, so a predicted crossing is reported once rather than every frame.
+     * Steps without the observable (skipped MI, LOD) are not tested.
+     * The signal is emitted on the calling thread after the lookahead
+     * returns (from poll_lookahead for async results).
+     *
+     * @return Watch id (stable until clear_watches / clear_biomes), -1 if rejected
+     */
+    int add_watch(int biome_id, int observable, int index, int comparator, double threshold);
+    void remove_watch(int watch_id);
+    void clear_watches();
+    int get_watch_count() const;
+
+    /**
+     * Compile a quest/hint predicate evaluated natively after every
+     * lookahead that tests the watches. Terms:
+     *   p(🌾)      summed pole probability of an emoji (also p(<registry id>))
+     *   pop(q)     P(|1⟩) of qubit q
+     *   purity     Tr(ρ²)
+     *   mi(a, b)   mutual information of qubits a and b
+     * combined with numbers, + - * /, < <= > >=, and / or / not (or && || !)
+     * and parentheses, e.g. "p(🌾) > 0.6 and purity < 0.9". Nonzero is true.
+     * The expression is compiled once to a postfix program; each lookahead
+     * then runs it over the steps of the biome (biome_id -1: every biome)
+     * without building any Variant. Steps missing a term it reads (skipped
+     * MI, LOD) are not tested; an emoji absent from a biome's layout reads 0,
+     * a qubit outside it excludes that biome.
+     *
+     * @return Predicate id (stable until clear_predicates / clear_biomes), -1 if rejected
+     */
+    int add_predicate(const String& expression, int biome_id = -1);
+    void remove_predicate(int predicate_id);
+    void clear_predicates();
+    int get_predicate_count() const;
+    /**
+     * First satisfying step of each predicate in the lookahead that finished
+     * last: {"steps": PackedInt32Array, "biomes": PackedInt32Array}, indexed
+     * by predicate id, -1 where it never held (or was removed). Across
+     * biomes the earliest step wins, the lower biome id on a tie.
+     */
+    Dictionary get_predicate_results();
 
     /**
      * Store per-biome metadata payload (emoji mapping, axes, etc.).
      * This is returned verbatim in evolve_* results.
+     * The emoji layout may be given as Strings (emoji_list, emoji_to_qubit,
+     * emoji_to_pole) or as EmojiRegistry ids (emoji_ids, emoji_qubits,
+     * emoji_poles); see resolve_emoji_layout. Icon maps always carry
+     * "emoji_ids" (sorted like "weights"); with "ids_only": true they omit
+     * the String-keyed "emojis" and "by_emoji".
      */
     void set_biome_metadata(int biome_id, const Dictionary& metadata);
 
@@ -149,6 +913,20 @@ public:
      */
     void set_biome_couplings(int biome_id, const Dictionary& couplings);
 
+    /**
+     * Metadata and coupling payloads are versioned (every set_biome_metadata,
+     * set_biome_couplings or operator patch bumps the biome's version).
+     * evolve_all_lookahead, async and sliced results carry
+     * "metadata_versions" and "coupling_versions" (PackedInt64Array per
+     * biome) and include a biome's Dictionary in "metadata"/"couplings" only
+     * when its version is newer than the one acknowledged here; otherwise the
+     * entry is an empty Dictionary. Until a consumer acknowledges, every
+     * result carries the full payloads.
+     *
+     * @param result A lookahead result whose payloads the consumer has stored
+     */
+    void acknowledge_payloads(const Dictionary& result);
+
     // ========================================================================
     // SINGLE-BIOME EVOLUTION (for on-demand refill after user action)
     // ========================================================================
@@ -161,12 +939,36 @@ public:
      * @param steps Number of lookahead steps
      * @param dt Time step per step
      * @param max_dt Maximum substep
+     * @param observables LookaheadObservables bits to compute
      *
      * @return Dictionary with "results", "mi", "mi_steps", "bloch_steps", "purity_steps",
      *         and "icon_map" for this biome only
      */
     Dictionary evolve_single_biome(int biome_id, const PackedFloat64Array& rho_packed,
-                                   int steps, float dt, float max_dt);
+                                   int steps, float dt, float max_dt, int observables = LOOKAHEAD_ALL);
+
+    /**
+     * What-if lookahead for candidate actions: base_rho is evolved
+     * prefix_steps once (the shared part of every future), then each action
+     * is applied to that state (ρ ← AρA†/Tr, as apply_biome_operator) and
+     * its branch evolved `steps` more. Branches of an Euler biome evolve as
+     * one block-diagonal batch split across the worker pool; other
+     * integrators step the branches one after another on the biome's engine.
+     * The biome's LNN, LOD and ensemble are not used: branches are plain
+     * dense evolution. No trajectory is returned, only summaries.
+     *
+     * @param actions Array of dense packed operators; an empty entry is the
+     *        "do nothing" branch
+     * @return Dictionary with:
+     *   "num_branches", "steps": int
+     *   "valid": PackedInt32Array, 0 where the action was rejected (size
+     *         mismatch or zero-probability projector; its entries are zero)
+     *   "bloch": PackedFloat64Array (branch · n·8), final state
+     *   "purity": PackedFloat64Array, final Tr(ρ²) per branch
+     *   "mean_purity": PackedFloat64Array, Tr(ρ²) averaged over the steps
+     */
+    Dictionary evolve_branches(int biome_id, const PackedFloat64Array& base_rho, const Array& actions,
+                               int steps, float dt, float max_dt, int prefix_steps = 0);
 
     // ========================================================================
     // TIME-SLICED COMPUTATION (yields CPU periodically)
@@ -182,17 +984,43 @@ public:
      * @param steps Number of lookahead steps to compute
      * @param dt Time step per step
      * @param max_dt Maximum substep for numerical stability
+     * @param observables LookaheadObservables bits to compute (sliced steps
+     *        have no force positions either way)
      */
-    void start_sliced_compute(const Array& biome_rhos, int steps, float dt, float max_dt);
+    void start_sliced_compute(const Array& biome_rhos, int steps, float dt, float max_dt,
+                              int observables = LOOKAHEAD_ALL);
 
     /**
-     * Continue time-sliced computation for up to max_time_ms.
+     * Continue time-sliced computation for up to max_time_ms (the frame budget).
+     * Same as continue_sliced_compute_us(max_time_ms * 1000).
      *
      * @param max_time_ms Maximum milliseconds to compute before yielding (e.g., 5)
      * @return true if computation completed, false if more work remains
      */
     bool continue_sliced_compute(int max_time_ms);
 
+    /**
+     * Continue time-sliced computation within a microsecond budget.
+     *
+     * Unfinished biomes are stepped round-robin, one step each per pass (the
+     * focused biome, then priority order, within a pass), so a slow biome
+     * can't starve the others. A step only starts if the biome's running cost
+     * estimate fits both the remaining frame budget and its own budget; the
+     * rest is deferred to the next call. A call that could fit nothing forces
+     * one step on the following call, so work never stalls.
+     *
+     * A dense Euler biome whose step alone costs more than the budget (9-10
+     * qubits) is sliced below one step: its evolve units (drift, then each
+     * jump operator) and its observable sweep (row ranges carrying the MI
+     * pair reductions) run until the budget is spent and resume on the next
+     * call, so small budgets hold regardless of biome size. Other
+     * integrators and trajectory ensembles still step whole.
+     *
+     * @param budget_us Maximum microseconds to compute before yielding
+     * @return true if computation completed, false if more work remains
+     */
+    bool continue_sliced_compute_us(int64_t budget_us);
+
     /**
      * Check if sliced computation is complete.
      */
@@ -206,8 +1034,24 @@ public:
      */
     Dictionary get_sliced_compute_result();
 
+    /**
+     * Results of one biome of the running sliced computation, available as
+     * soon as that biome has finished (before the whole batch is done):
+     * {"results", "mi", "mi_steps", "bloch_steps", "purity_steps",
+     * "icon_map"}, each as in get_sliced_compute_result() for that biome.
+     * Empty while the biome is still stepping.
+     */
+    Dictionary get_partial_result(int biome_id);
+
     /**
      * Cancel an in-progress sliced computation.
+     *
+     * Steps already finished are kept (as they are after
+     * get_sliced_compute_result()): the next start_sliced_compute() with the
+     * same dt, max_dt and observables resumes every biome whose input ρ,
+     * operators and LOD are unchanged from where it stopped, and recomputes
+     * the rest. Trajectory and LNN biomes carry state between steps and
+     * always start over.
      */
     void cancel_sliced_compute();
 
@@ -216,32 +1060,755 @@ public:
      */
     float get_sliced_compute_progress() const;
 
+    // ========================================================================
+    // ASYNC LOOKAHEAD (persistent native worker thread)
+    // ========================================================================
+
+    /**
+     * Queue a full evolve_all_lookahead job on the background worker.
+     * The rhos are snapshotted on submit; a job submitted while another is
+     * running replaces any not-yet-started one (latest wins).
+     *
+     * Engine access is serialized: evolve, sliced and configuration calls
+     * made while a job runs wait for it, so a main loop should use either the
+     * async path or the synchronous one for a given frame.
+     *
+     * @param packed true = evolve_all_lookahead_packed layout
+     * @return true if queued
+     */
+    bool submit_lookahead(const Array& biome_rhos, int steps, float dt, float max_dt,
+                          bool packed = false);
+
+    /**
+     * Latest completed async result (same Dictionary as evolve_all_lookahead),
+     * handed over once; null if none is ready. Never blocks on physics.
+     */
+    Variant poll_lookahead();
+
+    /**
+     * Drop the queued job and stop the running one at its next step (its
+     * result is discarded).
+     */
+    void cancel_lookahead();
+
+    /**
+     * True while a job is queued or running.
+     */
+    bool is_lookahead_busy() const;
+
+    // ========================================================================
+    // SLICED / ASYNC EIGENSTATE ANALYSIS
+    // ========================================================================
+
+    /**
+     * Start a time-sliced compute_batch_eigenstates_packed over biome_rhos
+     * (empty = the engine-resident states). Call
+     * continue_sliced_eigenstates_us() each frame until it returns true, then
+     * get_sliced_eigenstates_result(). Starting again drops an unfinished run.
+     */
+    void start_sliced_eigenstates(const Array& biome_rhos = Array());
+
+    /**
+     * Decompose biomes within a microsecond budget. One decomposition is the
+     * unit of work: a biome starts only if its predicted cost (a running
+     * per-dim³ estimate) fits what is left of the budget, and a call that
+     * could fit nothing forces one biome on the following call. Emits
+     * eigenstates_ready when the run completes.
+     *
+     * @return true once every biome is decomposed
+     */
+    bool continue_sliced_eigenstates_us(int64_t budget_us);
+
+    bool is_sliced_eigenstates_complete() const;
+
+    /**
+     * Result of a completed run, handed over once (same Dictionary as
+     * QuantumEvolutionEngine.compute_batch_eigenstates_packed); empty before
+     * completion.
+     */
+    Dictionary get_sliced_eigenstates_result();
+
+    void cancel_sliced_eigenstates();
+
+    // Fraction of biomes decomposed (0.0 to 1.0)
+    float get_sliced_eigenstates_progress() const;
+
+    /**
+     * Queue the same analysis on a background worker, decomposing biomes in
+     * parallel on the shared pool. The rhos are snapshotted on submit; a
+     * submit while a batch runs replaces any not-yet-started one (latest
+     * wins). When a batch finishes, eigenstates_ready is emitted on the main
+     * thread (deferred) and poll_eigenstates() hands the result over.
+     * Touches no engine state: only an empty biome_rhos (resident states)
+     * waits for a running evolve call.
+     *
+     * @return true if queued
+     */
+    bool submit_eigenstates(const Array& biome_rhos = Array());
+
+    // Latest completed async result, handed over once; null if none is ready
+    Variant poll_eigenstates();
+
+    // Drop the queued batch; a running one finishes but is discarded
+    void cancel_eigenstates();
+
+    // True while a batch is queued or running
+    bool is_eigenstates_busy() const;
+
+    // ========================================================================
+    // RING-BUFFER LOOKAHEAD (incremental tail refill)
+    // ========================================================================
+
+    /**
+     * Seed a per-biome ring buffer of future frames. Nothing is evolved yet;
+     * call refill() to fill the window.
+     *
+     * @param biome_rhos Current density matrix per biome (biome_id = index)
+     * @param depth Frames kept per biome (the lookahead window)
+     * @param dt Time step per frame
+     * @param max_dt Maximum substep
+     */
+    void seed_lookahead_buffer(const Array& biome_rhos, int depth, float dt, float max_dt);
+
+    /**
+     * Drop one biome's buffered frames and restart it from rho_packed
+     * (e.g. after a user action). Other biomes keep their windows.
+     */
+    void reseed_biome_buffer(int biome_id, const PackedFloat64Array& rho_packed);
+
+    /**
+     * Consume n frames from the head of every biome's buffer (time advanced
+     * by n·dt). Frames that weren't buffered yet are still owed: the next
+     * refill evolves through them without storing them.
+     *
+     * @return Frames actually popped from the fullest biome
+     */
+    int advance(int n);
+
+    /**
+     * Evolve only the missing frames onto each buffer's tail, starting from
+     * the last buffered state. In steady state (advance(1) per frame) that is
+     * one step per biome instead of the whole window.
+     *
+     * @return Dictionary with the NEW tail frames only:
+     *   "refilled": PackedInt32Array, frames appended per biome
+     *   "results", "mi_steps", "bloch_steps", "purity_steps", "position_steps",
+     *   "velocity_steps": as evolve_all_lookahead, restricted to the new frames
+     *   "icon_maps": Array<Dictionary> over each biome's full buffered window
+     */
+    Dictionary refill();
+
+    /**
+     * Apply a player action to a biome's buffered trajectory and recompute
+     * only the suffix after it, without a rho round-trip through GDScript.
+     * The buffered frames act as checkpoints: step 0 is the ring base (the
+     * current state), step k is buffered frame k-1. Frames from `step` on are
+     * discarded, ρ' = A ρ A† / Tr is applied at the checkpoint, and the window
+     * is refilled from there.
+     *
+     * @param biome_id Which biome the action hit
+     * @param step Checkpoint index in [0, get_buffered_steps(biome_id)]
+     * @param delta_op Action operator A, dense packed (same layout as H_packed)
+     * @return Dictionary with "from_step", "rho_after" (the acted state),
+     *         "results", "mi_steps", "bloch_steps", "purity_steps",
+     *         "position_steps", "velocity_steps" for the recomputed frames and
+     *         "icon_map"; empty on error
+     */
+    Dictionary invalidate_from(int biome_id, int step, const PackedFloat64Array& delta_op);
+
+    /**
+     * Frames currently buffered for a biome.
+     */
+    int get_buffered_steps(int biome_id) const;
+
+    /**
+     * One buffered frame (index 0 = head, the next frame to be consumed).
+     *
+     * @return Dictionary with "rho", "mi", "bloch", "purity", "positions",
+     *         "velocities"; empty if out of range
+     */
+    Dictionary get_buffered_frame(int biome_id, int index) const;
+
+    /**
+     * Let refill() pick each biome's window depth instead of using the seeded
+     * depth for all. Per biome the depth is the smaller of
+     *   - budget / measured step cost (rebuilding the whole window after an
+     *     invalidation fits one frame budget), and
+     *   - the expected frames between invalidations (1 / invalidation rate,
+     *     with invalidate_from / reseed_biome_buffer counted per consumed
+     *     frame), since frames beyond that are likely thrown away,
+     * clamped to [min_depth, max_depth]. Cheap, rarely-disturbed biomes see
+     * further ahead; expensive or constantly poked ones stay shallow.
+     */
+    void set_adaptive_depth(bool enabled);
+    bool get_adaptive_depth() const;
+
+    /**
+     * Frame budget (ms) one biome's full window rebuild may take (default 4).
+     */
+    void set_adaptive_depth_budget_ms(double budget_ms);
+    double get_adaptive_depth_budget_ms() const;
+
+    /**
+     * Depth bounds for adaptive mode. max_depth <= 0 uses the seeded depth.
+     */
+    void set_adaptive_depth_range(int min_depth, int max_depth);
+
+    /**
+     * Current window depth of a biome's ring (the seeded depth unless adaptive).
+     */
+    int get_biome_lookahead_depth(int biome_id) const;
+
+    /**
+     * Smoothed invalidations per consumed frame for a biome.
+     */
+    double get_biome_invalidation_rate(int biome_id) const;
+
+    /**
+     * Sample a biome's buffered trajectory at fractional time t, for
+     * rendering between coarse physics steps. t is seconds after the present
+     * (the ring base): buffered frame k sits at (k + 1)·dt. Values between
+     * frames are cubic Hermite (Catmull-Rom tangents); angles and radius are
+     * rederived from the interpolated x, y, z, which are pulled back into the
+     * Bloch ball if the spline overshoots.
+     *
+     * @return Dictionary with "bloch" ([p0,p1,x,y,z,r,theta,phi] per qubit),
+     *         "purity", "positions" and "t" (the clamped time actually
+     *         sampled); empty if the biome has nothing buffered
+     */
+    Dictionary sample_lookahead(int biome_id, float t) const;
+
+    /**
+     * Point queries over the same buffered trajectory and interpolation as
+     * sample_lookahead, for UI code that needs one value per frame rather
+     * than a whole Dictionary. All return empty / 0 if nothing is buffered.
+     *   get_bloch_at: one qubit's [p0,p1,x,y,z,r,theta,phi]
+     *   get_emoji_prob_at: probability of an EmojiRegistry id (the summed
+     *     pole populations its metadata maps it to, clamped to [0, 1])
+     *   get_positions_at: force-graph node positions
+     *   get_purity_at: Tr(ρ²)
+     */
+    PackedFloat64Array get_bloch_at(int biome_id, int qubit, float t) const;
+    double get_emoji_prob_at(int biome_id, int emoji_id, float t) const;
+    PackedVector2Array get_positions_at(int biome_id, float t) const;
+    double get_purity_at(int biome_id, float t) const;
+
+    // ========================================================================
+    // STATE HISTORY (rewind, analytics)
+    // ========================================================================
+
+    /**
+     * Keep a biome's past states natively, within a fixed memory budget
+     * (0 = off, the default). A frame is recorded whenever the present moves:
+     * after evolve_resident, and after advance() (the ring base it moved to,
+     * n·dt later). record_history adds one for callers driving ρ themselves.
+     *
+     * Every keyframe_interval-th frame holds the dense ρ; the frames between
+     * hold int16 deltas against the previous frame as a reader decodes it
+     * (the RHO_STORAGE_DELTA encoding), about a quarter of the size. With
+     * observables_only, frames hold just Bloch packets and purity. Past the
+     * budget the oldest keyframe and its deltas are dropped together.
+     * Changing the settings clears the biome's history.
+     */
+    void set_history(int biome_id, int64_t budget_bytes, int keyframe_interval = 16,
+                     bool observables_only = false);
+    void clear_history(int biome_id);
+    // Record the resident state as a frame elapsed seconds after the last one
+    void record_history(int biome_id, double elapsed);
+
+    /**
+     * Random access into the history: index 0 is the oldest retained frame,
+     * negative indices count back from the newest (-1). ρ is rebuilt from
+     * the frame's keyframe with at most keyframe_interval - 1 deltas.
+     *
+     * @return Dictionary with "time" (simulated seconds since the history
+     *         was set), "bloch", "purity" and, unless observables_only,
+     *         "rho"; empty if the index is out of range
+     */
+    Dictionary get_history_frame(int biome_id, int index);
+    // Time of every retained frame, oldest first (for seeking by time)
+    PackedFloat64Array get_history_times(int biome_id);
+    // {"frames", "keyframes", "bytes", "budget", "recorded", "evicted"}
+    Dictionary get_history_stats(int biome_id);
+
+    // ========================================================================
+    // SNAPSHOT CHANNEL (render-thread reads without the evolve lock)
+    // ========================================================================
+
+    /**
+     * Keep the last `frames` render snapshots in a lock-free ring (0 = off,
+     * the default). Every lookahead step (sync, async or packed) publishes
+     * one snapshot, and advance() publishes the frame it moved the present
+     * to, so a render thread can pick up Bloch/position/purity data while
+     * the main thread or the async worker is still busy.
+     */
+    void set_snapshot_capacity(int frames);
+    int get_snapshot_capacity() const;
+
+    /**
+     * Sequence number of the newest snapshot (0 = none yet). Lock-free.
+     */
+    int64_t get_snapshot_sequence() const;
+
+    /**
+     * Copy one snapshot out of the ring. Lock-free; never waits on evolution.
+     *
+     * @param sequence Snapshot to read, -1 = newest
+     * @return Empty if that snapshot was overwritten or isn't published yet,
+     *   otherwise little-endian bytes:
+     *     int64 sequence
+     *     int32 kind (SNAPSHOT_LOOKAHEAD or SNAPSHOT_PRESENT)
+     *     int32 step, int32 step_count  (position within its lookahead batch;
+     *                                    the batch's first snapshot is sequence - step)
+     *     int32 num_biomes
+     *     num_biomes × (int32 bloch_len, int32 node_count)
+     *   then float32 per biome: purity, bloch[bloch_len], xy[node_count × 2].
+     *   A biome with no data this step has bloch_len = node_count = 0 (purity
+     *   still present, 0). The float section starts at 24 + 8·num_biomes and
+     *   can be viewed with slice(offset).to_float32_array().
+     */
+    PackedByteArray read_snapshot(int64_t sequence = -1) const;
+
+    enum SnapshotKind {
+        SNAPSHOT_LOOKAHEAD = 0,  // Step of an evolve_all_lookahead / async result
+        SNAPSHOT_PRESENT = 1,    // Frame advance() just consumed
+    };
+
+    // ========================================================================
+    // PROFILING (always-on scoped timers)
+    // ========================================================================
+
+    /**
+     * Accumulated hot-path timings since the last reset. Every stage is
+     * {"calls", "usec", "avg_usec"}.
+     *
+     * @return Dictionary with:
+     *   "biomes": Array<Dictionary> per biome_id with "steps" (whole
+     *       _evolve_biome_steps call), "force", "lnn", "icon_map", "ensemble"
+     *       (trajectory biomes) and the biome engine's "evolve", "reduce"
+     *       (fused purity/trace sweep), "bloch", "mi", "entanglement"
+     *   "totals": the same stages summed over biomes
+     *   "lookahead", "batched_evolve", "refill", "marshal" (Variant result
+     *       assembly), "cross_repulsion": engine-wide stages
+     *   "frame_arena": {"capacity", "high_water", "overflows"} bytes / count
+     *       of the per-call lookahead scratch arena (not reset with the timers)
+     *   "result_pool": {"reused", "fresh"} result buffers written in place /
+     *       newly allocated (see release_result)
+     *   "simd_isa": kernel variant picked at load ("avx512", "avx2", "baseline")
+     */
+    Dictionary get_profile_stats();
+    void reset_profile_stats();
+
+    /**
+     * Heap bytes held by the engine:
+     *   "biomes": per biome, the QuantumEvolutionEngine categories (see
+     *       QuantumEvolutionEngine::get_memory_stats) plus "lookahead" (ring
+     *       frames and base), "resident_rho", "lnn_weights", "lnn_state" and
+     *       "total"
+     *   "shared": "frame_arena", "frame_results", "snapshot_scratch",
+     *       "batched_operators", "result_pool"
+     *   "total": everything above
+     * Registry operators and LNNs shared between biomes are reported by the
+     * first biome holding them only, so the totals count them once.
+     */
+    Dictionary get_memory_stats();
+
+    // ========================================================================
+    // RECORDING / REPLAY (offline benchmark on production traces)
+    // ========================================================================
+
+    /**
+     * Record registration, metadata, clears and the exact per-biome rho each
+     * lookahead starts from (sync, async and resident runs alike) to a
+     * compressed binary file until stop_recording().
+     *
+     * @return false if the file can't be opened
+     */
+    bool start_recording(const String& path);
+    void stop_recording();
+    bool is_recording() const;
+
+    /**
+     * Re-run a recording headlessly on this engine with its current settings
+     * (parallelism, batching, LOD...), for A/B timing of native kernels.
+     * REPLACES this engine's biomes. Trajectory-ensemble biomes sample
+     * randomly, so only their timings (not checksums) are comparable.
+     *
+     * @return Dictionary with "lookaheads" (count), "biomes" (registered),
+     *         "total_usec", "frame_usec" (PackedFloat64Array per lookahead),
+     *         "frame_checksums" (PackedInt64Array, FNV-1a of each result's
+     *         rho/bloch/purity) and "checksum" (all frames combined);
+     *         empty on error
+     */
+    Dictionary replay_recording(const String& path);
+
+    /**
+     * Opt-in soak-test telemetry: every lookahead call (sync, packed, binary
+     * and async) appends one record (stage timings, steps, active biomes,
+     * governor level, MI candidates) to a memory-mapped ring file that
+     * external tools can tail while the game runs; layout in
+     * telemetry_ring.h. Nothing goes through GDScript per frame.
+     *
+     * @param path "user://" / "res://" paths are globalized
+     * @param capacity_frames Records kept before the oldest is overwritten
+     * @return false (with a warning) if the file can't be created or mapped
+     */
+    bool start_telemetry(const String& path, int capacity_frames = 4096);
+    void stop_telemetry();
+    bool is_telemetry_active();
+    int64_t get_telemetry_frame_count();  // Records written since start_telemetry
+
 protected:
     static void _bind_methods();
 
 private:
     // Registered biome engines (created during register_biome)
     std::vector<Ref<QuantumEvolutionEngine>> m_engines;
+    // Trajectory ensembles (null unless registered with num_trajectories > 0).
+    // The biome's QuantumEvolutionEngine then only holds operators/couplings.
+    std::vector<Ref<QuantumTrajectoryEngine>> m_trajectory_engines;
     std::vector<int> m_num_qubits;  // num_qubits per biome for MI
+    std::vector<char> m_biome_active;  // See set_biome_active
+
+    // get_profile_stats: per-biome stages (written only by that biome's task)
+    struct BiomeProfile {
+        ProfileStage steps;
+        ProfileStage force;
+        ProfileStage lnn;
+        ProfileStage icon_map;
+        ProfileStage ensemble;
+    };
+    std::vector<BiomeProfile> m_biome_profile;
+    ProfileStage m_profile_lookahead;
+    ProfileStage m_profile_batched;
+    ProfileStage m_profile_refill;
+    ProfileStage m_profile_marshal;
+    ProfileStage m_profile_cross_repulsion;
+
+    LookaheadRecorder m_recorder;  // Written under m_evolve_mutex
+    TelemetryRing m_telemetry;     // Written under m_evolve_mutex
+
+    // set_operator_cache_dir ("" = off) and its counters (under m_evolve_mutex)
+    String m_operator_cache_dir;
+    uint64_t m_operator_cache_hits = 0;
+    uint64_t m_operator_cache_misses = 0;
+    std::atomic<uint64_t> m_operator_cache_writes{0};  // Also bumped by the preparation thread
+
+    // Active and given a state: the one check every evolve path makes
+    bool _should_evolve(int biome_id, const PackedFloat64Array& rho_packed) const {
+        return m_biome_active[biome_id] && !rho_packed.is_empty();
+    }
     std::vector<Dictionary> m_metadata;
     std::vector<Dictionary> m_couplings;
+    // acknowledge_payloads: versions from one engine-wide serial, so a
+    // re-registered biome id never repeats an acknowledged version
+    struct PayloadVersion {
+        int64_t metadata = 0;
+        int64_t couplings = 0;
+        int64_t metadata_acked = 0;
+        int64_t couplings_acked = 0;
+    };
+    std::vector<PayloadVersion> m_payload_versions;
+    int64_t m_payload_serial = 0;
+    void _touch_metadata(int biome_id) { m_payload_versions[biome_id].metadata = ++m_payload_serial; }
+    void _touch_couplings(int biome_id) { m_payload_versions[biome_id].couplings = ++m_payload_serial; }
+    // Nested-result "metadata"/"couplings" (unacknowledged only) and their versions
+    void _append_payloads(int biome_id, Array& metadata, Array& couplings, PackedInt64Array& metadata_versions,
+                          PackedInt64Array& coupling_versions) const;
+
+    // Authoritative per-biome state (empty = none / inactive)
+    std::vector<PackedFloat64Array> m_resident_rho;
+
+    // Per-biome scheduling for continue_sliced_compute
+    std::vector<int> m_biome_priority;
+    std::vector<double> m_biome_budget_ms;  // 0 = no per-biome cap
+    std::vector<double> m_biome_step_cost_us;  // EMA of sliced / refill step cost, 0 = unknown
+
+    // get_cost_estimates: per-biome µs-per-work coefficients (0 = no sample),
+    // fed by diffing cumulative stage timers around each evolve (caller
+    // thread, after the biome's tasks have joined)
+    enum CostStage { COST_EVOLVE = 0, COST_MI = 1, COST_FORCE = 2, COST_STAGE_COUNT = 3 };
+    struct CostModel {
+        double coeff[COST_STAGE_COUNT] = {0.0, 0.0, 0.0};
+        uint64_t samples[COST_STAGE_COUNT] = {0, 0, 0};
+    };
+    struct CostSnapshot {
+        ProfileStage stage[COST_STAGE_COUNT];
+    };
+    std::vector<CostModel> m_cost_models;
+    double _cost_work(int biome_id, int stage) const;
+    CostSnapshot _cost_snapshot(int biome_id) const;
+    void _update_cost_model(int biome_id, const CostSnapshot& before);
+
+    int m_pacing_delay_ms = 0;  // Deprecated, unused (see set_pacing_delay_ms)
+
+    // Level of detail (explicit per biome, plus camera-focus derivation)
+    std::vector<int> m_biome_lod;
+    // Steady-state detection: consecutive slow steps, and once stationary the
+    // state it holds and the input distance that still counts as that state.
+    // Written only by the biome's own evolve task (or under m_evolve_mutex).
+    struct SteadyState {
+        int still_steps = 0;
+        bool stationary = false;
+        PackedFloat64Array rho;
+        double drift = 0.0;
+    };
+    std::vector<SteadyState> m_steady;
+    double m_steady_tolerance = 0.0;
+    int m_steady_window = 8;
+    int m_large_biome_qubits = 0;  // set_large_biome_qubits (0 = off)
+
+    // Cross-biome coupling graph (add_biome_coupling)
+    struct CrossBiomeCoupling {
+        int source_biome = 0;
+        int source_qubit = 0;
+        int target_biome = 0;
+        int target_qubit = 0;
+        double rate = 0.0;
+        int kind = COUPLING_POPULATION;
+    };
+    std::vector<CrossBiomeCoupling> m_cross_couplings;
+    // Apply every edge once to rhos (one coupled step of length dt)
+    void _apply_cross_couplings(std::vector<PackedFloat64Array>& rhos, double dt) const;
+    bool _is_stationary(int biome_id) const {
+        return biome_id >= 0 && biome_id < static_cast<int>(m_steady.size()) && m_steady[biome_id].stationary &&
+               !m_lnns[biome_id] && m_trajectory_engines[biome_id].is_null();
+    }
+    // Leave the stationary state when rho is no longer the state it holds
+    void _check_stationary(int biome_id, const PackedFloat64Array& rho);
+    int m_focus_biome = -1;
+    int m_background_lod = LOD_REDUCED_MI;
+    int m_lod_mi_stride = 4;
+    // MI stride for a tier, widened to 2 at GOVERNOR_MI_STRIDE
+    int _mi_stride(int lod) const;
+
+    // Frame-budget governor (set_frame_budget_ms), all under m_evolve_mutex
+    double m_frame_budget_ms = 0.0;   // 0 = off
+    int m_governor_level = GOVERNOR_FULL;
+    double m_governor_ms = 0.0;       // EMA of lookahead call time
+    bool m_governor_primed = false;   // m_governor_ms holds a sample
+    int m_governor_hold = 0;          // Calls since the last level change
+    int m_governor_base_substeps = 0; // Force substep cap before coarsening (0 = not coarsened)
+    std::vector<char> m_governor_float;  // Per biome: single precision forced by the governor
+
+    double m_drift_thresholds[3] = {1e-5, 1e-5, 1e-5};  // set_drift_thresholds
+    int m_mi_audit_interval = 0;  // set_mi_audit_interval
+    // Feed one call's time and move at most one level
+    void _governor_observe(double elapsed_ms);
+    void _apply_governor_level(int level);
+    // Engine-level knobs of the current level for one biome
+    void _apply_governor_biome(int biome_id);
+
+    // max_dt to integrate with at a tier (COARSE raises it to dt where that
+    // doesn't change the time a step covers)
+    float _lod_max_dt(int biome_id, int lod, float dt, float max_dt) const;
 
-    // Pacing: sleep between steps to spread CPU load (0 = disabled)
-    int m_pacing_delay_ms = 1;  // Default: 1ms sleep between steps (gentle)
+    // evolve_all_lookahead: one native pool task per biome
+    bool m_parallel_biomes = true;
+
+    // Equal-dimension batching: block-diagonal operators per group (member ids
+    // as key), rebuilt when membership changes or biomes are re-registered
+    bool m_batch_equal_dims = false;
+
+    // Farm-wide repulsion between biome layouts, once per evolve / refill
+    bool m_cross_biome_repulsion = false;
+    void _repel_across_biomes(float dt);
+    std::map<std::vector<int>, std::shared_ptr<const QuantumEvolutionEngine::BatchedOperators>> m_batched_ops;
+    bool _is_batch_eligible(int biome_id, const PackedFloat64Array& rho_packed) const;
+    // Evolve every eligible group for `steps` Euler steps; frames_out[b] gets
+    // biome b's trajectory (evolve_trajectory_into layout), empty if not batched
+    void _evolve_batched_groups(const std::vector<PackedFloat64Array>& rhos, int num_biomes, int steps,
+                                float dt, float max_dt, std::vector<PackedFloat64Array>& frames_out);
+
+    // Phase-shadow LNN per biome (nullptr if disabled; biomes enabled with
+    // enable_shared_lnn hold the same network) and each biome's hidden state
+    std::vector<std::shared_ptr<LiquidNeuralNet>> m_lnns;
+    std::vector<Eigen::VectorXd> m_lnn_hidden;
+    // Fixed-size forward kernel for common shapes (float when the biome runs
+    // in single precision), nullptr otherwise; rebuilt with the LNN/precision
+    std::vector<std::unique_ptr<LnnKernel>> m_lnn_kernels;
+    // Per-biome phases/deltas/pre-activation buffers, sized with the LNN so
+    // the per-step modulation allocates nothing
+    struct LnnScratch {
+        Eigen::VectorXd phases;
+        Eigen::VectorXd deltas;
+        Eigen::VectorXd activation;
+        Eigen::VectorXd work;  // 2 × max(input, output): diagonal gather / sin, cos
+        // Stride > 1: output of the pass before the latest, the blend applied
+        // this step, and steps taken since the latest pass
+        Eigen::VectorXd prev_deltas;
+        Eigen::VectorXd interp_deltas;
+        int substep = 0;
+    };
+    std::vector<LnnScratch> m_lnn_scratch;
+    std::vector<int> m_lnn_stride;  // set_biome_lnn_stride (kept across enable/disable)
+    // Rebuild biome_id's kernel and scratch after its LNN or precision changed
+    void _prepare_lnn(int biome_id);
+    // Network from a weight snapshot file with dim inputs/outputs (and the
+    // given hidden size if >= 0); nullptr with a warning otherwise
+    static std::shared_ptr<LiquidNeuralNet> _read_lnn_file(const String& path, int dim, int hidden_size);
 
-    // Phase-shadow LNN (one per biome, nullptr if disabled)
-    std::vector<std::unique_ptr<LiquidNeuralNet>> m_lnns;
+    // Background training: per-biome recording ring (column per forward
+    // pass) and the job whose result the biome adopts when done
+    struct LnnTraining {
+        int window = 0;
+        int head = 0;
+        int count = 0;
+        Eigen::MatrixXd phases;  // input_size × window
+        Eigen::MatrixXd hidden;  // hidden_size × window (state before the pass)
+        std::shared_ptr<LnnTrainer::Job> job;
+        double last_loss = -1.0;
+    };
+    std::vector<LnnTraining> m_lnn_training;
+    LnnTrainer m_lnn_trainer;
+    void _lnn_record(int biome_id, const double* phases, const double* hidden);
+    // Swap in biome_id's finished training result; touches only biome_id's
+    // slots, so it is safe from the parallel per-biome loops
+    void _adopt_trained_lnn(int biome_id);
 
     // Force graph engine for computing node positions (shared across all biomes)
     Ref<ForceGraphEngine> m_force_engine;
 
-    // Current node positions/velocities per biome (for force integration)
-    std::vector<PackedVector2Array> m_node_positions;
-    std::vector<PackedVector2Array> m_node_velocities;
+    // Persistent force layout per biome (handle into m_force_engine); holds
+    // the current node positions/velocities between refills
+    std::vector<int> m_force_layouts;
     std::vector<Vector2> m_biome_centers;  // Center position per biome
 
+    // Time a trajectory-ensemble step covers (matches the dense engine's mode)
+    float _ensemble_step_span(int biome_id, float dt, float max_dt) const;
+
     // Apply LNN phase modulation to density matrix diagonal
     void _apply_lnn_phase_modulation(int biome_id, PackedFloat64Array& rho_packed);
+    // The two halves: phases[i] = arg(ρ_ii), then ρ_ii *= exp(i·0.01·delta_i).
+    // Both return false if rho is not dim×dim
+    // (work: 2 × dim doubles of scratch)
+    static bool _lnn_read_phases(const PackedFloat64Array& rho_packed, int dim, double* phases, double* work);
+    static void _lnn_apply_deltas(PackedFloat64Array& rho_packed, int dim, const double* deltas, double* work);
+    // evolve_resident for biomes sharing one LNN: members step in lockstep
+    // with one batched forward pass per step
+    void _evolve_lnn_group(const std::vector<int>& biome_ids, int steps, float dt, float max_dt);
+
+    // add_watch predicates (guarded by m_evolve_mutex); removed ones stay as
+    // inactive slots so ids are stable
+    struct Watch {
+        int biome_id = 0;
+        int observable = WATCH_POPULATION;
+        int index = 0;
+        int comparator = WATCH_ABOVE;
+        double threshold = 0.0;
+        bool active = true;
+        bool armed = true;
+    };
+    struct WatchEvent {
+        int watch_id;
+        int biome_id;
+        int step;
+        double value;
+    };
+    std::vector<Watch> m_watches;
+
+    // add_predicate programs (guarded by m_evolve_mutex), postfix over a
+    // stack of doubles
+    enum PredicateCode {
+        PRED_CONST,   // value
+        PRED_EMOJI,   // a = EmojiRegistry id
+        PRED_POP,     // a = qubit
+        PRED_PURITY,
+        PRED_MI,      // a < b qubits
+        PRED_ADD, PRED_SUB, PRED_MUL, PRED_DIV, PRED_NEG,
+        PRED_LT, PRED_LE, PRED_GT, PRED_GE,
+        PRED_AND, PRED_OR, PRED_NOT
+    };
+    enum PredicateNeeds {
+        PRED_NEEDS_BLOCH = 1,
+        PRED_NEEDS_PURITY = 2,
+        PRED_NEEDS_MI = 4
+    };
+    static constexpr int PREDICATE_MAX_DEPTH = 32;
+    struct PredicateOp {
+        int code = PRED_CONST;
+        int a = 0;
+        int b = 0;
+        double value = 0.0;
+    };
+    struct Predicate {
+        int biome_id = -1;  // -1: every biome
+        std::vector<PredicateOp> program;
+        int needs = 0;      // PredicateNeeds of the terms read
+        bool active = true;
+    };
+    struct PredicateParser;  // Recursive descent, multi_biome_lookahead_engine.cpp
+    std::vector<Predicate> m_predicates;
+    PackedInt32Array m_predicate_steps;
+    PackedInt32Array m_predicate_biomes;
+    // A program with its terms resolved for one biome (PRED_EMOJI: [a, b)
+    // into m_predicate_offsets; PRED_POP: Bloch offset; PRED_MI: pair index)
+    std::vector<PredicateOp> m_predicate_bound;
+    std::vector<int> m_predicate_offsets;
+    // Emit "watch_triggered" per event; call without m_evolve_mutex held
+    void _emit_watch_events(const std::vector<WatchEvent>& events);
+
+    // Shared body of evolve_all_lookahead and the async worker (takes m_evolve_mutex).
+    // With watch_events, fired watches are appended there for the caller to emit;
+    // with binary, the result is written there as a packet and an empty Dictionary returned
+    Dictionary _run_lookahead(const std::vector<PackedFloat64Array>& rhos, int steps, float dt, float max_dt,
+                              bool packed, std::vector<WatchEvent>* watch_events = nullptr,
+                              PackedByteArray* binary = nullptr, int observables = LOOKAHEAD_ALL,
+                              const std::atomic<bool>* cancel = nullptr);
+
+    // Serializes engine/biome state between caller threads and the async worker
+    std::mutex m_evolve_mutex;
+
+    // Async lookahead: one persistent worker, one pending job, one front buffer
+    struct AsyncJob {
+        std::vector<PackedFloat64Array> rhos;
+        int steps = 0;
+        float dt = 0.1f;
+        float max_dt = 0.02f;
+        bool packed = false;
+    };
+    std::thread m_async_thread;
+    mutable std::mutex m_async_mutex;  // Guards every m_async_* below
+    std::condition_variable m_async_cv;
+    AsyncJob m_async_job;
+    bool m_async_has_job = false;
+    bool m_async_running = false;
+    bool m_async_stopping = false;
+    Dictionary m_async_front;  // Latest completed result (back buffer is the worker's local)
+    std::vector<WatchEvent> m_async_watch_events;  // Fired by m_async_front, emitted by poll_lookahead
+    bool m_async_ready = false;
+    // Cancel token of the running job; each job gets a fresh one so a late cancel never leaks into the next run
+    std::shared_ptr<std::atomic<bool>> m_async_running_cancel;
+    // Token of the current _run_lookahead (null for synchronous calls), polled between steps under m_evolve_mutex
+    const std::atomic<bool>* m_step_cancel = nullptr;
+    bool _step_cancelled() const { return m_step_cancel && m_step_cancel->load(std::memory_order_relaxed); }
+    void _async_worker_loop();
+
+    // Sliced eigenstate analysis (guarded by m_evolve_mutex like m_sliced_state)
+    struct SlicedEigenState {
+        bool in_progress = false;
+        bool complete = false;
+        QuantumEvolutionEngine::EigenBatch batch;
+        int next_biome = 0;
+        int stalled_calls = 0;  // Consecutive continue calls that fit no biome
+    };
+    SlicedEigenState m_sliced_eigen;
+    double m_eigen_cost_per_dim3_us = 0.0;  // EMA of one decomposition's cost / dim³, 0 = unknown
+
+    // Async eigenstate analysis: its own worker, one pending batch, one front
+    std::thread m_eigen_thread;
+    mutable std::mutex m_eigen_mutex;  // Guards every m_eigen_* below
+    std::condition_variable m_eigen_cv;
+    QuantumEvolutionEngine::EigenBatch m_eigen_job;
+    bool m_eigen_has_job = false;
+    bool m_eigen_running = false;
+    bool m_eigen_stopping = false;
+    bool m_eigen_cancel = false;  // Discard the running batch's result
+    Dictionary m_eigen_front;
+    bool m_eigen_ready = false;
+    void _eigen_worker_loop();
+    // biome_rhos, or the resident states when it is empty
+    Array _eigen_inputs(const Array& biome_rhos);
 
     // Helper: evolve one biome for multiple steps
     struct BiomeStepResult {
@@ -251,16 +1818,383 @@ private:
         std::vector<double> purity_steps;
         std::vector<PackedVector2Array> position_steps;
         std::vector<PackedVector2Array> velocity_steps;
+        // RHO_STORAGE_DELTA: int16 deltas and scales per step (empty at step 0)
+        std::vector<PackedByteArray> delta_steps;
+        std::vector<double> delta_scales;
         Dictionary icon_map;
+
+        // Empty every field, keeping the vectors' capacity
+        void clear() {
+            steps.clear();
+            mi_steps.clear();
+            bloch_steps.clear();
+            purity_steps.clear();
+            position_steps.clear();
+            velocity_steps.clear();
+            delta_steps.clear();
+            delta_scales.clear();
+            icon_map = Dictionary();
+        }
+        // Bytes of the packed arrays and purities (icon map not counted)
+        uint64_t payload_bytes() const {
+            uint64_t bytes = purity_steps.size() * sizeof(double);
+            for (const auto& a : steps) bytes += a.size() * sizeof(double);
+            for (const auto& a : mi_steps) bytes += a.size() * sizeof(double);
+            for (const auto& a : bloch_steps) bytes += a.size() * sizeof(double);
+            for (const auto& a : position_steps) bytes += a.size() * sizeof(Vector2);
+            for (const auto& a : velocity_steps) bytes += a.size() * sizeof(Vector2);
+            for (const auto& a : delta_steps) bytes += a.size();
+            bytes += delta_scales.size() * sizeof(double);
+            return bytes;
+        }
+    };
+
+    // Per-step observables and layout snapshots of one biome's lookahead,
+    // written to flat native buffers while stepping; _assemble_step_outputs
+    // turns them into the BiomeStepResult packed arrays once, after the last
+    // step. A slot is laid out as compute_observables_into writes it:
+    // [bloch][purity][mi], each section only when that step computed it.
+    struct StepSpan {
+        int32_t bloch_len = 0;  // At the slot start
+        int32_t mi_at = 0;
+        int32_t mi_len = -1;  // -1: MI not recomputed this step (the last one carries over)
+    };
+    struct StepOutputs {
+        int steps = 0;                  // Steps written so far
+        int64_t slot = 0;               // Doubles per observables slot
+        int nodes = 0;                  // Nodes per layout snapshot (0: no layout)
+        double* observables = nullptr;  // [step · slot]
+        StepSpan* spans = nullptr;      // [step]
+        float* layout = nullptr;        // [step · nodes · 4]: x, y, vx, vy
     };
+    // Copy the layout's positions and velocities into flat's step snapshot
+    static void _snapshot_layout(const ForceGraphEngine::NodeBuffers* nodes, StepOutputs& flat, int step);
+    // Bloch (into out.bloch_steps, or icon_bloch when only the icon map needs
+    // it), MI and layout packed arrays of flat's steps, appended to out;
+    // Bloch and MI reuse the biome's result pool
+    void _assemble_step_outputs(int biome_id, const StepOutputs& flat, bool bloch, bool icon_bloch_only, bool mi,
+                                bool positions, BiomeStepResult& out, std::vector<PackedFloat64Array>& icon_bloch);
 
     BiomeStepResult
     _evolve_biome_steps(int biome_id, const PackedFloat64Array& rho_packed,
-                        int steps, float dt, float max_dt, bool compute_mi = true);
+                        int steps, float dt, float max_dt, bool compute_mi = true,
+                        const PackedFloat64Array* batched_frames = nullptr, int observables = LOOKAHEAD_ALL);
+    // Same, filling a cleared out (its capacity is reused) and drawing
+    // per-step native scratch from arena when given
+    void _evolve_biome_steps_into(BiomeStepResult& out, int biome_id, const PackedFloat64Array& rho_packed,
+                                  int steps, float dt, float max_dt, bool compute_mi,
+                                  const PackedFloat64Array* batched_frames, FrameArena* arena,
+                                  int observables = LOOKAHEAD_ALL);
+
+    // set_use_task_graph: one biome's lookahead laid out as graph stages.
+    // Nodes of a biome write only their own step's slots; the force chain
+    // runs in step order and its tail assembles the BiomeStepResult.
+    bool m_use_task_graph = false;
+    struct StagedBiome {
+        int biome_id = 0;
+        int steps = 0;
+        float dt = 0.0f;
+        float max_dt = 0.0f;
+        int mi_stride = 1;
+        bool compute_mi = true;
+        bool detect_steady = false;
+        int observables_cap = 0;
+        PackedFloat64Array input;
+        std::vector<PackedFloat64Array> rho;  // [step]
+        std::vector<char> evolved;            // [step], false once cancelled
+        std::vector<double> observables;      // [step · observables_cap]
+        std::vector<StepSpan> spans;          // [step]
+        std::vector<float> layout;            // [step · nodes · 4], StepOutputs::layout
+        int layout_nodes = 0;
+        int produced = 0;                     // Force chain: steps with results, in order
+        int last_mi_step = -1;                // Force chain: step whose MI the springs use
+        std::vector<double> mi_edges;         // Force springs [i, j, mi], rebuilt on MI steps only
+        StepOutputs outputs();                // Flat view of the buffers above
+    };
+    // Add biome's evolve/LNN/observables/force nodes for steps to graph
+    void _add_staged_biome(NativeTaskGraph& graph, StagedBiome& staged, BiomeStepResult& out,
+                           const PackedFloat64Array& input, int steps, float dt, float max_dt, bool compute_mi);
+    void _staged_evolve(StagedBiome& staged, int step);
+    void _staged_observe(StagedBiome& staged, int step);
+    void _staged_force(StagedBiome& staged, BiomeStepResult& out, int step);
+
+    int m_output_precision = OUTPUT_PRECISION_DOUBLE;
+    Variant _visual_field(const PackedFloat64Array& values) const;
+
+    // set_rho_storage: applied to each result before it is marshalled
+    int m_rho_storage = RHO_STORAGE_FULL;
+    void _apply_rho_storage(BiomeStepResult& result) const;
+    // evolve_all_lookahead_binary packet of a finished lookahead
+    PackedByteArray _pack_binary(const std::vector<BiomeStepResult>& biome_results, int steps) const;
+    // Test every armed add_watch predicate against a finished lookahead (updates arming)
+    void _evaluate_watches(const std::vector<BiomeStepResult>& biome_results, std::vector<WatchEvent>& events);
+    // Refresh m_predicate_steps / m_predicate_biomes from the same lookahead
+    void _evaluate_predicates(const std::vector<BiomeStepResult>& biome_results);
+    // First step of r before limit satisfying predicate, -1 if none
+    int _first_predicate_step(const Predicate& predicate, int biome_id, const BiomeStepResult& r, int limit);
+
+    // Per-call scratch of _run_lookahead: the arena is reset at the start of
+    // every evolve_all_lookahead(_packed) and the result slots keep their
+    // capacity between calls (their Godot payloads are released on return)
+    FrameArena m_frame_arena;
+    std::vector<BiomeStepResult> m_frame_results;
+
+    // Result buffer pool: the packed arrays each biome's last lookahead
+    // returned, per step, plus its trajectory buffer. The next call moves a
+    // slot's buffer out and writes it through ptrw(): unique again once the
+    // caller dropped (or release_result()ed) its share, it is reused in
+    // place; still shared, copy-on-write hands over a fresh one
+    struct ResultBuffers {
+        std::vector<PackedFloat64Array> rho;    // [step]
+        std::vector<PackedFloat64Array> bloch;  // [step]
+        std::vector<PackedFloat64Array> mi;     // [step]
+        PackedFloat64Array frames;
+    };
+    std::vector<ResultBuffers> m_result_pool;  // [biome_id], touched only by the biome's own task
+    std::atomic<int64_t> m_result_pool_reused{0};
+    std::atomic<int64_t> m_result_pool_fresh{0};
+    // buf ← slots[step] resized to size (counted as reused if written in place); returns buf.ptrw()
+    double* _take_result_buffer(std::vector<PackedFloat64Array>& slots, int step, int64_t size,
+                                PackedFloat64Array& buf);
+    void _keep_result_buffer(std::vector<PackedFloat64Array>& slots, int step, const PackedFloat64Array& buf);
+
+    // LOD_FROZEN: steps copies of rho with observables computed once
+    BiomeStepResult _frozen_steps(int biome_id, const PackedFloat64Array& rho_packed, int steps, bool compute_mi,
+                                  int observables = LOOKAHEAD_ALL);
+
+    // evolve_all_lookahead_packed layout (see its doc comment)
+    Dictionary _pack_results(const std::vector<BiomeStepResult>& biome_results, int steps) const;
+
+    // set_biome_metadata compiles the emoji layout (resolve_emoji_layout) into
+    // flat (emoji index, bloch offset) terms so _build_icon_map never hashes strings
+    struct IconIndex {
+        bool valid = false;               // Metadata had a complete emoji layout
+        bool ids_only = false;            // Metadata "ids_only": skip String keys in icon maps
+        std::vector<int> ids;             // EmojiRegistry id per entry (-1: not an emoji)
+        std::vector<String> names;        // Registry name per entry (empty when ids_only)
+        std::vector<int> term_emoji;      // Emoji index per resolvable term
+        std::vector<int> term_offset;     // qubit * 8 + pole into a Bloch packet
+    };
+    std::vector<IconIndex> m_icon_index;
+    void _compile_icon_index(int biome_id);
 
     Dictionary _build_icon_map(int biome_id,
                                const std::vector<PackedFloat64Array>& bloch_steps);
 
+    // ========================================================================
+    // RING-BUFFER LOOKAHEAD STATE
+    // ========================================================================
+
+    struct LookaheadFrame {
+        PackedFloat64Array rho;
+        PackedFloat64Array mi;
+        PackedFloat64Array bloch;
+        double purity = 0.0;
+        PackedVector2Array positions;
+        PackedVector2Array velocities;
+    };
+
+    // Catmull-Rom window of a ring at time t (sample_lookahead, point queries).
+    // p[] may point at base, so a segment must not be copied once filled
+    struct RingSegment {
+        LookaheadFrame base;  // Ring base as a frame (when its observables are known)
+        const LookaheadFrame* p[4] = {nullptr, nullptr, nullptr, nullptr};
+        const PackedVector2Array* first_positions = nullptr;  // Stand-in for unknown base positions
+        bool single = false;  // One sample: every p is it
+        bool lo_edge = false;
+        bool hi_edge = false;
+        double h00 = 0.0, h10 = 0.0, h01 = 0.0, h11 = 0.0;
+        int nearest = 1;  // p index closest to t
+        double t = 0.0;   // Clamped time actually sampled
+        double hermite(double v0, double v1, double v2, double v3) const;
+
+        RingSegment() = default;
+        RingSegment(const RingSegment&) = delete;
+        RingSegment& operator=(const RingSegment&) = delete;
+    };
+    bool _ring_segment(int biome_id, float t, RingSegment& seg) const;
+    // One qubit packet at Bloch offset base; false if the frames don't have it
+    static bool _sample_bloch_packet(const RingSegment& seg, int64_t base, double* out);
+    static double _sample_purity(const RingSegment& seg);
+    static PackedVector2Array _sample_positions(const RingSegment& seg);
+
+    // Fixed-capacity ring of future frames for one biome
+    struct LookaheadRing {
+        std::vector<LookaheadFrame> slots;  // Capacity = this biome's depth
+        int head = 0;
+        int count = 0;
+        int owed = 0;             // Consumed-but-never-buffered frames to evolve through
+        int base_lag = 0;         // Consumed frames past base that kept no ρ (large biomes)
+        PackedFloat64Array base;  // State just before the head (last consumed / seed)
+        PackedVector2Array base_positions;  // Force graph at base (empty until a frame is consumed)
+        PackedVector2Array base_velocities;
+        PackedFloat64Array base_bloch;  // Observables at base (empty until known)
+        double base_purity = 0.0;
+
+        int depth() const { return static_cast<int>(slots.size()); }
+
+        // Change capacity keeping the first min(count, depth) frames
+        void resize(int new_depth) {
+            std::vector<LookaheadFrame> kept(new_depth);
+            const int keep = std::min(count, new_depth);
+            for (int i = 0; i < keep; i++) {
+                kept[i] = std::move(slots[(head + i) % slots.size()]);
+            }
+            slots.swap(kept);
+            head = 0;
+            count = keep;
+        }
+
+        void reset(int depth, const PackedFloat64Array& new_base) {
+            slots.assign(depth, LookaheadFrame());
+            head = 0;
+            count = 0;
+            owed = 0;
+            base_lag = 0;
+            base = new_base;
+            base_positions = PackedVector2Array();
+            base_velocities = PackedVector2Array();
+            base_bloch = PackedFloat64Array();
+            base_purity = 0.0;
+        }
+        const LookaheadFrame& at(int i) const { return slots[(head + i) % slots.size()]; }
+        void push(LookaheadFrame frame) { slots[(head + count++) % slots.size()] = std::move(frame); }
+        void pop() {
+            if (slots[head].rho.is_empty()) {
+                base_lag++;  // Observables-only frame: base stays the last full state
+            } else {
+                base = slots[head].rho;
+                base_lag = 0;
+            }
+            base_positions = slots[head].positions;
+            base_velocities = slots[head].velocities;
+            base_bloch = slots[head].bloch;
+            base_purity = slots[head].purity;
+            slots[head] = LookaheadFrame();
+            head = (head + 1) % static_cast<int>(slots.size());
+            count--;
+        }
+    };
+
+    // Evolve a ring's missing frames onto its tail; returns only the new frames
+    BiomeStepResult _refill_ring(int biome_id);
+
+    // Shared tail of the operator patches: drop the biome's buffered frames
+    // (the base stays the current state) and rebuild what depends on operators
+    void _operators_changed(int biome_id);
+    bool _check_patchable(int biome_id, const char* method) const;
+
+    // register_biome in two halves: the engines are built without touching
+    // engine state (safe to run for several biomes at once), then appended
+    // to the per-biome tables under m_evolve_mutex
+    // register_biome's deferred finalize: one per queued biome, shared with
+    // the preparation thread until done
+    struct Preparation {
+        Ref<QuantumEvolutionEngine> engine;
+        String cache_path;  // Write the finalized operators here ("" = off)
+        std::atomic<bool> done{false};
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    std::vector<std::shared_ptr<Preparation>> m_preparing;  // Per biome; nullptr if finalized inline
+    std::atomic<int> m_preparations_pending{0};
+    std::thread m_prep_thread;
+    std::mutex m_prep_mutex;  // Guards m_prep_queue and m_prep_stopping
+    std::condition_variable m_prep_cv;
+    std::vector<std::shared_ptr<Preparation>> m_prep_queue;
+    bool m_prep_stopping = false;
+    void _queue_preparation(const std::shared_ptr<Preparation>& preparation);
+    void _prep_worker_loop();
+    void _await_prepared(int biome_id) const;
+    // m_engines[biome_id] once its queued finalize has finished (waits if not)
+    const Ref<QuantumEvolutionEngine>& _engine(int biome_id) const {
+        if (m_preparations_pending.load(std::memory_order_acquire) > 0) {
+            _await_prepared(biome_id);
+        }
+        return m_engines[biome_id];
+    }
+
+    struct BiomeBuild {
+        int dim = 0;
+        int num_qubits = 0;
+        int num_trajectories = 0;
+        PackedFloat64Array H_packed;
+        Array lindblad_triplets;
+        Dictionary metadata;
+        Ref<QuantumEvolutionEngine> engine;
+        Ref<QuantumTrajectoryEngine> trajectories;
+        Dictionary couplings;  // From metadata, when given
+        bool restored = false;  // From load_snapshot: no source arrays to record
+        String operator_cache;  // Cache directory ("" = off)
+        int cache_result = 0;   // 0 no cache, 1 hit, 2 miss, 3 miss written
+        bool defer_finalize = false;  // Leave finalize to a Preparation
+        std::shared_ptr<Preparation> preparation;  // Set by _build_biome when deferred
+    };
+    static void _build_biome(BiomeBuild& build);
+    int _append_biome(const BiomeBuild& build);
+    void _clear_biomes();  // clear_biomes() with m_evolve_mutex already held
+
+    // ========================================================================
+    // HISTORY RING STATE
+    // ========================================================================
+
+    struct HistoryFrame {
+        double time = 0.0;
+        PackedFloat64Array values;  // Keyframe ρ, or Bloch packets + purity (observables_only)
+        PackedByteArray delta;      // Otherwise: int16 deltas against the previous frame
+        double scale = 0.0;         // Delta quantum
+        bool is_keyframe() const { return delta.is_empty(); }
+        int64_t bytes() const { return values.size() * 8 + delta.size() + 32; }
+    };
+    struct HistoryRing {
+        int64_t budget = 0;  // Bytes; 0 = off
+        int keyframe_interval = 16;
+        bool observables_only = false;
+        std::deque<HistoryFrame> frames;  // Oldest first; front is always a keyframe
+        int64_t bytes = 0;
+        double time = 0.0;            // Of the newest frame
+        int since_keyframe = 0;       // Deltas recorded since the newest keyframe
+        std::vector<double> decoded;  // Newest frame's ρ as get_history_frame rebuilds it
+        int64_t recorded = 0;
+        int64_t evicted = 0;
+    };
+    std::vector<HistoryRing> m_history;  // Per biome (may be shorter), under m_evolve_mutex
+    // Append the resident state of biome_id (touches only its own slots, so
+    // the parallel per-biome loops may call it)
+    void _record_history(int biome_id, double elapsed);
+
+    // ========================================================================
+    // SNAPSHOT CHANNEL STATE
+    // ========================================================================
+
+    // Borrowed per-biome data for one snapshot (null = no data this step)
+    struct SnapshotBiome {
+        double purity = 0.0;
+        const PackedFloat64Array* bloch = nullptr;
+        const PackedVector2Array* positions = nullptr;
+    };
+
+    // Encode and publish one snapshot (caller holds m_evolve_mutex, the single producer)
+    void _publish_snapshot(int kind, int step, int step_count, const std::vector<SnapshotBiome>& biomes);
+    void _publish_lookahead_snapshots(const std::vector<BiomeStepResult>& biome_results, int steps);
+
+    SnapshotChannel m_snapshots;
+    std::vector<uint8_t> m_snapshot_scratch;  // Encode buffer, reused
+
+    std::vector<LookaheadRing> m_rings;  // Empty until seed_lookahead_buffer
+    int m_ring_depth = 0;  // Seeded depth (per-ring depth may differ when adaptive)
+    float m_ring_dt = 0.1f;
+    float m_ring_max_dt = 0.02f;
+
+    // Adaptive depth (see set_adaptive_depth)
+    bool m_adaptive_depth = false;
+    double m_adaptive_budget_ms = 4.0;
+    int m_adaptive_min_depth = 2;
+    int m_adaptive_max_depth = 0;              // <= 0: m_ring_depth
+    std::vector<double> m_biome_invalidation_rate;  // EMA of invalidations per consumed frame
+    std::vector<int> m_biome_invalidations_pending;  // Since the last advance()
+    int _adaptive_depth_for(int biome_id) const;
+
     // ========================================================================
     // TIME-SLICED COMPUTATION STATE
     // ========================================================================
@@ -275,34 +2209,94 @@ private:
         int total_steps = 0;
         float dt = 0.1f;
         float max_dt = 0.02f;
+        int observables = LOOKAHEAD_ALL;
 
-        // Progress tracking
-        int current_biome = 0;      // Which biome we're processing
-        int current_step = 0;       // Which step within current biome
-        PackedFloat64Array current_rho;  // Current state being evolved
+        // Progress tracking (biomes advance independently, interleaved by the scheduler)
+        int num_biomes = 0;
+        int stalled_calls = 0;  // Consecutive continue calls that fit no step
+        std::vector<int> biome_step;               // Steps done per biome
+        std::vector<PackedFloat64Array> biome_rho;  // Latest state per biome
 
         // Accumulated results per biome
         std::vector<BiomeStepResult> biome_results;
 
+        // Step in flight per biome when one step is sliced itself (a biome
+        // whose step costs more than the frame budget): evolve units, then
+        // observable row ranges, resumed across continue calls
+        enum PartialPhase { PARTIAL_IDLE = 0, PARTIAL_EVOLVE = 1, PARTIAL_OBSERVE = 2 };
+        struct PartialStep {
+            int phase = PARTIAL_IDLE;
+            bool mi_now = false;
+            double spent_us = 0.0;  // Cost so far, learned once the step completes
+            QuantumEvolutionEngine::SlicedStep evolve;
+            QuantumEvolutionEngine::SlicedObservables observe;
+            PackedFloat64Array evolved;
+        };
+        std::vector<PartialStep> partial;
+
+        // What each biome's steps were computed from; a restart whose biome
+        // matches keeps the steps finished so far
+        struct BiomeInput {
+            PackedFloat64Array rho;
+            const QuantumEvolutionEngine* engine = nullptr;
+            uint64_t operator_version = 0;
+            int lod = 0;
+            bool reusable = false;  // No trajectory ensemble or LNN (both carry state across steps)
+        };
+        std::vector<BiomeInput> inputs;
+
+        // Ends the run but keeps finished steps for a matching restart
+        void retire() {
+            in_progress = false;
+            complete = false;
+            partial.clear();
+        }
+
         void reset() {
             in_progress = false;
             complete = false;
             biome_rhos = Array();
             total_steps = 0;
-            current_biome = 0;
-            current_step = 0;
-            current_rho = PackedFloat64Array();
+            observables = LOOKAHEAD_ALL;
+            num_biomes = 0;
+            stalled_calls = 0;
+            biome_step.clear();
+            biome_rho.clear();
             biome_results.clear();
+            partial.clear();
+            inputs.clear();
         }
     };
 
     SlicedComputeState m_sliced_state;
 
-    // Helper: do one evolution step for current biome, update state
+    // Steps of previous's biome_id that a start with these parameters can
+    // keep (0 if its inputs changed); moves them into m_sliced_state
+    int _adopt_sliced_prefix(SlicedComputeState& previous, int biome_id);
+
+    // Helper: do one evolution step for biome_id, update state
     // Returns true if this biome is complete
-    bool _do_one_sliced_step();
+    bool _do_one_sliced_step(int biome_id);
+    // True if biome_id's steps can be split below one step (dense Euler
+    // engine, no trajectory ensemble, not frozen)
+    bool _can_slice_within_step(int biome_id) const;
+    // Advance biome_id's in-flight step until it completes or budget_us runs
+    // out (at least one unit always runs). Returns true once the step is done.
+    bool _do_partial_sliced_step(int biome_id, double budget_us);
 };
 
 }  // namespace godot
 
+VARIANT_ENUM_CAST(godot::MultiBiomeLookaheadEngine::BiomeLOD);
+VARIANT_ENUM_CAST(godot::MultiBiomeLookaheadEngine::GovernorLevel);
+VARIANT_ENUM_CAST(godot::MultiBiomeLookaheadEngine::SnapshotKind);
+VARIANT_ENUM_CAST(godot::MultiBiomeLookaheadEngine::CouplingKind);
+VARIANT_ENUM_CAST(godot::MultiBiomeLookaheadEngine::RhoStorage);
+VARIANT_ENUM_CAST(godot::MultiBiomeLookaheadEngine::OutputPrecision);
+VARIANT_ENUM_CAST(godot::MultiBiomeLookaheadEngine::WatchObservable);
+VARIANT_ENUM_CAST(godot::MultiBiomeLookaheadEngine::WatchComparator);
+VARIANT_ENUM_CAST(godot::MultiBiomeLookaheadEngine::PacketSection);
+VARIANT_ENUM_CAST(godot::MultiBiomeLookaheadEngine::PacketType);
+VARIANT_ENUM_CAST(godot::MultiBiomeLookaheadEngine::LookaheadObservables);
+
 #endif  // MULTI_BIOME_LOOKAHEAD_ENGINE_H
@@ -0,0 +1,64 @@
+#ifndef NATIVE_COUNTERS_H
+#define NATIVE_COUNTERS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace godot {
+
+/**
+ * NativeCounters - Process-wide work counters behind the Performance monitors
+ *
+ * Monotonic totals summed over every engine instance, bumped with one
+ * relaxed atomic add at stage granularity (per evolve, per MI sweep, per
+ * force step, per lookahead step), so they are cheap enough to stay on in
+ * release builds. native_monitors turns them into rates for Godot's
+ * Performance custom monitors; anything else (the bench, telemetry) can
+ * read total() directly.
+ */
+enum NativeCounter {
+    COUNTER_EVOLVE_NANOS = 0,           // Wall time inside evolve_matrix
+    COUNTER_MI_PAIRS_EVALUATED,         // Pair entropies actually computed
+    COUNTER_MI_PAIRS_SKIPPED,           // Screened out or served from the reuse cache
+    COUNTER_FORCE_NODES,                // Nodes advanced, summed over force steps
+    COUNTER_LOOKAHEAD_STEPS_COMPUTED,   // Biome steps evolved for lookahead
+    COUNTER_LOOKAHEAD_STEPS_DISCARDED,  // Buffered steps dropped (invalidation, cancel)
+    COUNTER_BYTES_MARSHALLED,           // Result payload handed back to GDScript
+    COUNTER_COUNT
+};
+
+class NativeCounters {
+public:
+    static void add(NativeCounter counter, uint64_t amount) {
+        s_totals[counter].fetch_add(amount, std::memory_order_relaxed);
+    }
+    static uint64_t total(NativeCounter counter) {
+        return s_totals[counter].load(std::memory_order_relaxed);
+    }
+
+private:
+    static inline std::atomic<uint64_t> s_totals[COUNTER_COUNT] = {};
+};
+
+// Adds the scope's wall time (ns) to a counter
+class ScopedCounterNanos {
+public:
+    explicit ScopedCounterNanos(NativeCounter counter)
+        : m_counter(counter), m_start(std::chrono::steady_clock::now()) {}
+    ~ScopedCounterNanos() {
+        NativeCounters::add(m_counter, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_start).count()));
+    }
+
+private:
+    ScopedCounterNanos(const ScopedCounterNanos&) = delete;
+    ScopedCounterNanos& operator=(const ScopedCounterNanos&) = delete;
+
+    NativeCounter m_counter;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+}  // namespace godot
+
+#endif  // NATIVE_COUNTERS_H
@@ -0,0 +1,97 @@
+#include "native_monitors.h"
+#include "native_counters.h"
+
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <godot_cpp/variant/string_name.hpp>
+#include <chrono>
+#include <mutex>
+
+using namespace godot;
+
+namespace {
+
+const double RESAMPLE_SECONDS = 0.25;
+
+struct MonitorSpec {
+    const char* id;
+    NativeCounter counter;
+    double scale;  // Applied to the per-second delta
+};
+
+const MonitorSpec MONITORS[] = {
+    {"native/evolution_ms_per_sec", COUNTER_EVOLVE_NANOS, 1e-6},
+    {"native/mi_pairs_evaluated_per_sec", COUNTER_MI_PAIRS_EVALUATED, 1.0},
+    {"native/mi_pairs_skipped_per_sec", COUNTER_MI_PAIRS_SKIPPED, 1.0},
+    {"native/force_nodes_per_sec", COUNTER_FORCE_NODES, 1.0},
+    {"native/lookahead_steps_computed_per_sec", COUNTER_LOOKAHEAD_STEPS_COMPUTED, 1.0},
+    {"native/lookahead_steps_discarded_per_sec", COUNTER_LOOKAHEAD_STEPS_DISCARDED, 1.0},
+    {"native/marshalled_kb_per_sec", COUNTER_BYTES_MARSHALLED, 1.0 / 1024.0},
+};
+const int NUM_MONITORS = sizeof(MONITORS) / sizeof(MONITORS[0]);
+
+struct RateState {
+    uint64_t last_total = 0;
+    std::chrono::steady_clock::time_point last_time;
+    double rate = 0.0;
+    bool started = false;
+};
+
+std::mutex g_rate_mutex;
+RateState g_rates[NUM_MONITORS];
+
+template <int Index>
+double monitor_rate() {
+    const MonitorSpec& spec = MONITORS[Index];
+    const uint64_t total = NativeCounters::total(spec.counter);
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(g_rate_mutex);
+    RateState& state = g_rates[Index];
+    if (!state.started) {
+        state.started = true;
+        state.last_total = total;
+        state.last_time = now;
+        return 0.0;
+    }
+    const double elapsed = std::chrono::duration<double>(now - state.last_time).count();
+    if (elapsed >= RESAMPLE_SECONDS) {
+        state.rate = static_cast<double>(total - state.last_total) / elapsed * spec.scale;
+        state.last_total = total;
+        state.last_time = now;
+    }
+    return state.rate;
+}
+
+template <int Index>
+void add_monitors(Performance* performance) {
+    if constexpr (Index < NUM_MONITORS) {
+        const StringName id(MONITORS[Index].id);
+        if (!performance->has_custom_monitor(id)) {
+            performance->add_custom_monitor(id, callable_mp_static(&monitor_rate<Index>));
+        }
+        add_monitors<Index + 1>(performance);
+    }
+}
+
+}  // namespace
+
+void godot::register_native_monitors() {
+    Performance* performance = Performance::get_singleton();
+    if (performance == nullptr) {
+        return;
+    }
+    add_monitors<0>(performance);
+}
+
+void godot::unregister_native_monitors() {
+    Performance* performance = Performance::get_singleton();
+    if (performance == nullptr) {
+        return;
+    }
+    for (const MonitorSpec& spec : MONITORS) {
+        const StringName id(spec.id);
+        if (performance->has_custom_monitor(id)) {
+            performance->remove_custom_monitor(id);
+        }
+    }
+}
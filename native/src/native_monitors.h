@@ -0,0 +1,15 @@
+#ifndef NATIVE_MONITORS_H
+#define NATIVE_MONITORS_H
+
+namespace godot {
+
+// Register / remove the NativeCounters monitors ("native/..." in the
+// debugger's Monitors tab, also readable with Performance.get_custom_monitor).
+// Values are per-second rates of each counter, re-sampled at most every
+// quarter second, so any number of readers see the same value.
+void register_native_monitors();
+void unregister_native_monitors();
+
+}  // namespace godot
+
+#endif  // NATIVE_MONITORS_H
@@ -0,0 +1,83 @@
+#include "native_task_graph.h"
+#include "native_thread_pool.h"
+
+#include <algorithm>
+
+using namespace godot;
+
+int NativeTaskGraph::add(Task fn) {
+    Node node;
+    node.fn = std::move(fn);
+    m_nodes.push_back(std::move(node));
+    return static_cast<int>(m_nodes.size()) - 1;
+}
+
+void NativeTaskGraph::precede(int before, int after) {
+    if (before < 0 || after < 0 || before >= size() || after >= size() || before == after) {
+        return;
+    }
+    m_nodes[before].successors.push_back(after);
+    m_nodes[after].num_predecessors++;
+}
+
+void NativeTaskGraph::clear() {
+    m_nodes.clear();
+    m_ready.clear();
+    m_pending.clear();
+    m_remaining = 0;
+}
+
+void NativeTaskGraph::run(NativeThreadPool& pool) {
+    const int count = size();
+    if (count == 0) {
+        return;
+    }
+    m_pending.resize(count);
+    m_ready.clear();
+    for (int i = 0; i < count; i++) {
+        m_pending[i] = m_nodes[i].num_predecessors;
+        if (m_nodes[i].num_predecessors == 0) {
+            m_ready.push_back(i);
+        }
+    }
+    m_remaining = count;
+
+    // One worker loop per pool thread; a loop run inline drains the whole graph
+    const int workers = std::max(1, std::min(pool.thread_count(), count));
+    pool.parallel_for(0, workers, workers, [this](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            worker();
+        }
+    });
+}
+
+void NativeTaskGraph::worker() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_cv.wait(lock, [this] { return !m_ready.empty() || m_remaining == 0; });
+        if (m_remaining == 0) {
+            return;
+        }
+        const int task = m_ready.back();
+        m_ready.pop_back();
+        lock.unlock();
+
+        m_nodes[task].fn();
+
+        // Release successors whose last predecessor this was
+        int released = 0;
+        lock.lock();
+        for (int next : m_nodes[task].successors) {
+            if (--m_pending[next] == 0) {
+                m_ready.push_back(next);
+                released++;
+            }
+        }
+        m_remaining--;
+        if (m_remaining == 0 || released > 1) {
+            m_cv.notify_all();
+        } else if (released == 1) {
+            m_cv.notify_one();
+        }
+    }
+}
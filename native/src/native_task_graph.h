@@ -0,0 +1,57 @@
+#ifndef NATIVE_TASK_GRAPH_H
+#define NATIVE_TASK_GRAPH_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace godot {
+
+class NativeThreadPool;
+
+/**
+ * NativeTaskGraph - Dependency-ordered tasks on the shared NativeThreadPool
+ *
+ * Tasks are added with add(), ordered with precede(before, after), then
+ * run() executes every task once, each only after all of its predecessors
+ * have finished. Every pool thread claims ready tasks from one shared queue,
+ * so independent chains (e.g. observables of step k and evolution of step
+ * k+1, or different biomes) overlap instead of waiting for a whole stage.
+ *
+ * Like parallel_for, run() called from inside a pool job executes inline on
+ * the calling thread (in a valid topological order). The graph must be
+ * acyclic; tasks must only touch state their edges order.
+ */
+class NativeTaskGraph {
+public:
+    typedef std::function<void()> Task;
+
+    int add(Task fn);
+    void precede(int before, int after);
+    int size() const { return static_cast<int>(m_nodes.size()); }
+    void clear();
+
+    // Blocks until every task has run
+    void run(NativeThreadPool& pool);
+
+private:
+    struct Node {
+        Task fn;
+        std::vector<int> successors;
+        int num_predecessors = 0;
+    };
+    std::vector<Node> m_nodes;
+
+    // run() state, guarded by m_mutex
+    std::vector<int> m_pending;  // Unfinished predecessors per node
+    std::vector<int> m_ready;    // Runnable now (taken last-in first-out: depth first)
+    int m_remaining = 0;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    void worker();
+};
+
+}  // namespace godot
+
+#endif  // NATIVE_TASK_GRAPH_H
@@ -0,0 +1,281 @@
+#include "native_thread_pool.h"
+
+#include <algorithm>
+
+using namespace godot;
+
+namespace {
+// Set while this thread runs a chunk: nested parallel_for calls run inline
+thread_local bool tl_inside_job = false;
+}  // namespace
+
+NativeThreadPool& NativeThreadPool::shared() {
+    static NativeThreadPool pool;
+    return pool;
+}
+
+void NativeThreadPool::shutdown() {
+    shared().stop();
+}
+
+NativeThreadPool::~NativeThreadPool() {
+    stop();
+}
+
+int NativeThreadPool::thread_count() const {
+    if (!has_threads()) {
+        return 1;
+    }
+    if (m_executor.load() != nullptr) {
+        return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    return worker_count() + 1;
+}
+
+int NativeThreadPool::worker_count() const {
+    if (!has_threads()) {
+        return 0;
+    }
+    const int target = m_worker_target.load();
+    if (target > 0) {
+        return target;
+    }
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency())) - 1;
+}
+
+void NativeThreadPool::set_worker_count(int count) {
+    std::lock_guard<std::mutex> submit(m_submit_mutex);
+    m_worker_target.store(std::max(0, count));
+    if (!m_workers.empty() && static_cast<int>(m_workers.size()) != worker_count()) {
+        stop_workers();  // Restarted at the new size by the next job
+    }
+}
+
+void NativeThreadPool::set_external_executor(ExternalExecutor executor) {
+    std::lock_guard<std::mutex> submit(m_submit_mutex);
+    m_executor.store(executor);
+    if (executor != nullptr) {
+        stop_workers();
+    }
+}
+
+bool NativeThreadPool::has_external_executor() const {
+    return m_executor.load() != nullptr;
+}
+
+void NativeThreadPool::start() {
+    // Called with m_submit_mutex held, so no job is in flight
+    if (!m_workers.empty()) {
+        return;
+    }
+    const int workers = worker_count();
+    if (workers == 0) {
+        return;  // parallel_for runs the job inline
+    }
+    m_stopping = false;
+    m_workers.reserve(workers);
+    for (int w = 0; w < workers; w++) {
+        m_workers.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+void NativeThreadPool::stop() {
+    std::lock_guard<std::mutex> submit(m_submit_mutex);
+    stop_workers();
+}
+
+void NativeThreadPool::stop_workers() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_job_cv.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+    m_stopping = false;
+}
+
+void NativeThreadPool::worker_loop() {
+    unsigned seen = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        seen = m_generation;
+    }
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_job_cv.wait(lock, [&]() { return m_stopping || m_generation != seen; });
+            if (m_stopping) {
+                return;
+            }
+            seen = m_generation;
+            m_active++;
+        }
+        run_chunks();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_active--;
+        }
+        m_done_cv.notify_all();
+    }
+}
+
+void NativeThreadPool::run_chunk(int c) {
+    const int b = m_begin + c * m_chunk;
+    const int e = std::min(m_end, b + m_chunk);
+    (*m_fn)(b, e);
+}
+
+void NativeThreadPool::run_chunks() {
+    tl_inside_job = true;
+    int c;
+    while (!(m_preemptible && m_foreground_waiting.load() > 0) && (c = m_next_chunk.fetch_add(1)) < m_num_chunks) {
+        run_chunk(c);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_chunks_done++;
+    }
+    tl_inside_job = false;
+}
+
+void NativeThreadPool::external_chunk(void* pool, uint32_t index) {
+    // Executor threads may already be inside one of our chunks (nested
+    // group tasks), so restore rather than clear the flag
+    const bool was_inside = tl_inside_job;
+    tl_inside_job = true;
+    static_cast<NativeThreadPool*>(pool)->run_chunk(static_cast<int>(index));
+    tl_inside_job = was_inside;
+}
+
+void NativeThreadPool::parallel_for(int begin, int end, int max_chunks, const RangeFn& fn) {
+    if (end <= begin) {
+        return;
+    }
+    if (tl_inside_job) {
+        fn(begin, end);
+        return;
+    }
+    std::unique_lock<std::mutex> submit(m_submit_mutex, std::try_to_lock);
+    if (!submit.owns_lock()) {
+        if (!m_background_running.load()) {
+            // Pool busy with another engine's job: don't queue behind it
+            fn(begin, end);
+            return;
+        }
+        // A background round yields at its next chunk boundary
+        m_foreground_waiting.fetch_add(1);
+        submit.lock();
+        m_foreground_waiting.fetch_sub(1);
+    }
+    const ExternalExecutor executor = m_executor.load();
+    const int count = end - begin;
+    int chunks = (max_chunks > 0) ? max_chunks : thread_count();
+    chunks = std::min(chunks, count);
+    if (chunks <= 1) {
+        fn(begin, end);
+        return;
+    }
+
+    if (executor != nullptr) {
+        // One executor task per chunk
+        m_fn = &fn;
+        m_begin = begin;
+        m_end = end;
+        m_chunk = (count + chunks - 1) / chunks;
+        m_num_chunks = (count + m_chunk - 1) / m_chunk;
+        const bool ran = executor(&NativeThreadPool::external_chunk, this, m_num_chunks);
+        m_fn = nullptr;
+        if (ran) {
+            return;
+        }
+    }
+
+    start();
+    if (m_workers.empty()) {
+        fn(begin, end);
+        return;
+    }
+
+    {
+        // Stragglers from the previous job must be out of run_chunks before
+        // its counter is reset
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done_cv.wait(lock, [&]() { return m_active == 0; });
+        m_fn = &fn;
+        m_begin = begin;
+        m_end = end;
+        m_chunk = (count + chunks - 1) / chunks;
+        m_num_chunks = (count + m_chunk - 1) / m_chunk;
+        m_chunks_done = 0;
+        m_next_chunk.store(0);
+        m_preemptible = false;
+        m_generation++;
+    }
+    m_job_cv.notify_all();
+
+    run_chunks();  // The caller works too
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait(lock, [&]() { return m_chunks_done == m_num_chunks && m_active == 0; });
+    m_fn = nullptr;
+}
+
+void NativeThreadPool::parallel_for_background(int begin, int end, const RangeFn& fn) {
+    const auto run_inline = [&fn](int index) {
+        const bool was_inside = tl_inside_job;
+        tl_inside_job = true;  // Nested calls stay off the pool
+        fn(index, index + 1);
+        tl_inside_job = was_inside;
+    };
+    if (tl_inside_job || m_executor.load() != nullptr || worker_count() == 0) {
+        for (int i = begin; i < end; i++) {
+            run_inline(i);
+        }
+        return;
+    }
+
+    int next = begin;
+    while (next < end) {
+        // Foreground callers first: take the pool only when none is waiting
+        std::unique_lock<std::mutex> submit(m_submit_mutex, std::defer_lock);
+        if (m_foreground_waiting.load() > 0 || !submit.try_lock()) {
+            run_inline(next++);
+            continue;
+        }
+        start();
+        if (m_workers.empty()) {
+            run_inline(next++);
+            continue;
+        }
+        m_background_running.store(true);
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done_cv.wait(lock, [&]() { return m_active == 0; });
+            m_fn = &fn;
+            m_begin = next;
+            m_end = end;
+            m_chunk = 1;
+            m_num_chunks = end - next;
+            m_chunks_done = 0;
+            m_next_chunk.store(0);
+            m_preemptible = true;
+            m_generation++;
+        }
+        m_job_cv.notify_all();
+
+        run_chunks();
+
+        // Done or preempted: either way no chunk is claimed once every
+        // claimer has left, and chunks are claimed in order, so the first
+        // m_chunks_done indices ran
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done_cv.wait(lock, [&]() { return m_active == 0; });
+        next += m_chunks_done;
+        m_next_chunk.store(m_num_chunks);  // Late-waking workers find nothing to claim
+        m_preemptible = false;
+        m_fn = nullptr;
+        lock.unlock();
+        m_background_running.store(false);
+    }
+}
@@ -0,0 +1,126 @@
+#ifndef NATIVE_THREAD_POOL_H
+#define NATIVE_THREAD_POOL_H
+
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+// Web builds without -pthread (make web) cannot start threads: the pool then
+// runs every job inline on the calling thread
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define NATIVE_THREAD_POOL_THREADS 0
+#else
+#define NATIVE_THREAD_POOL_THREADS 1
+#endif
+
+namespace godot {
+
+/**
+ * NativeThreadPool - Process-wide worker pool for data-parallel native kernels
+ *
+ * One pool (hardware_concurrency - 1 workers, started on first use) is shared
+ * by every engine, so independent biomes don't each spin up their own threads.
+ * parallel_for splits [begin, end) into contiguous chunks that the workers and
+ * the calling thread claim until none are left, then returns.
+ *
+ * Only one parallel_for runs at a time; a call made while the pool is busy
+ * (another engine's job, or a nested call from inside a chunk) runs inline on
+ * the caller instead of waiting, so the pool can never deadlock on itself.
+ * The exception is a job started with parallel_for_background: it yields the
+ * pool to a parallel_for that arrives while it runs.
+ * Chunk bodies must only write disjoint outputs.
+ *
+ * The worker count is configurable, and the pool can instead hand each job
+ * to an external executor (its own workers are joined while one is set).
+ * The pool itself is plain C++ so headless tools can link it; the Godot
+ * WorkerThreadPool executor and GDScript settings live in NativeWorkerPool.
+ */
+class NativeThreadPool {
+public:
+    // fn(chunk_begin, chunk_end): scratch declared inside the body is per-thread
+    typedef std::function<void(int, int)> RangeFn;
+    // An executor must call run(ctx, i) once for every i in [0, count) and
+    // return when all calls have finished; false if it is unavailable (the
+    // job then runs on our own workers)
+    typedef void (*ChunkRunner)(void* ctx, uint32_t index);
+    typedef bool (*ExternalExecutor)(ChunkRunner run, void* ctx, int count);
+
+    static NativeThreadPool& shared();
+    static void shutdown();  // Join workers (module uninitialize); restarts lazily if used again
+    static constexpr bool has_threads() { return NATIVE_THREAD_POOL_THREADS != 0; }
+
+    int thread_count() const;  // Workers + the calling thread
+
+    // Worker threads besides the caller; <= 0 restores the default
+    // (hardware_concurrency - 1). Applied on the next parallel_for. Always 0
+    // without threads.
+    void set_worker_count(int count);
+    int worker_count() const;
+    // Run jobs on executor instead of our workers; nullptr switches back
+    void set_external_executor(ExternalExecutor executor);
+    bool has_external_executor() const;
+
+    // Run fn over [begin, end) in at most max_chunks chunks (<= 0: thread_count).
+    // More chunks than threads are claimed dynamically, which balances uneven
+    // work (e.g. one chunk per biome).
+    void parallel_for(int begin, int end, int max_chunks, const RangeFn& fn);
+
+    // Low-priority parallel_for, one index per chunk (e.g. biome preparation).
+    // A parallel_for that finds it holding the pool waits for the chunks in
+    // flight instead of running inline and takes the pool before any further
+    // index is claimed; the rest resumes afterwards, running on the caller
+    // while the pool is taken. Nested parallel_for calls inside fn run inline.
+    void parallel_for_background(int begin, int end, const RangeFn& fn);
+
+    ~NativeThreadPool();
+
+private:
+    NativeThreadPool() = default;
+    NativeThreadPool(const NativeThreadPool&) = delete;
+    NativeThreadPool& operator=(const NativeThreadPool&) = delete;
+
+    void start();
+    void stop();
+    void stop_workers();  // stop() with m_submit_mutex already held
+    void worker_loop();
+    void run_chunks();  // Claim and run chunks of the current job
+    void run_chunk(int c);
+    static void external_chunk(void* pool, uint32_t index);
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_submit_mutex;  // Held for the duration of one parallel_for
+    std::mutex m_mutex;
+    std::condition_variable m_job_cv;
+    std::condition_variable m_done_cv;
+    bool m_stopping = false;
+    unsigned m_generation = 0;  // Bumped per job; workers wake on change
+
+    // Settings (written under m_submit_mutex, read lock-free for reporting)
+    std::atomic<int> m_worker_target{0};  // <= 0: hardware default
+    std::atomic<ExternalExecutor> m_executor{nullptr};
+
+    // Current job (valid while m_submit_mutex is held)
+    const RangeFn* m_fn = nullptr;
+    int m_begin = 0;
+    int m_chunk = 0;
+    int m_num_chunks = 0;
+    int m_end = 0;
+    std::atomic<int> m_next_chunk{0};
+    bool m_preemptible = false;  // Current job is a parallel_for_background round
+    int m_chunks_done = 0;  // Guarded by m_mutex
+    int m_active = 0;       // Workers inside run_chunks, guarded by m_mutex
+
+    // parallel_for_background state: a round holds m_submit_mutex; foreground
+    // callers that find it there count themselves in m_foreground_waiting,
+    // which stops further chunk claims
+    std::atomic<bool> m_background_running{false};
+    std::atomic<int> m_foreground_waiting{0};
+};
+
+}  // namespace godot
+
+#endif  // NATIVE_THREAD_POOL_H
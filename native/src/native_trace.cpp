@@ -0,0 +1,243 @@
+#include "native_trace.h"
+#include "latency_histograms.h"
+#include "native_thread_pool.h"
+#include "simd_dispatch.h"
+#include "trace_zones.h"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <Eigen/Core>
+
+using namespace godot;
+
+namespace {
+// Set by set_kernel_override, cleared by "" (module init selects the widest)
+bool g_kernel_override = false;
+
+const char* build_platform() {
+#if defined(__EMSCRIPTEN__)
+    return "web";
+#elif defined(_WIN32)
+    return "windows";
+#elif defined(__APPLE__)
+    return "macos";
+#elif defined(__linux__)
+    return "linux";
+#else
+    return "unknown";
+#endif
+}
+}  // namespace
+
+void NativeTrace::_bind_methods() {
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("is_compiled_in"), &NativeTrace::is_compiled_in);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("start_capture", "max_events_per_thread"), &NativeTrace::start_capture, DEFVAL(262144));
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("stop_capture"), &NativeTrace::stop_capture);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("is_capturing"), &NativeTrace::is_capturing);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("clear"), &NativeTrace::clear);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("get_event_count"), &NativeTrace::get_event_count);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("get_dropped_count"), &NativeTrace::get_dropped_count);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("get_chrome_trace_json"), &NativeTrace::get_chrome_trace_json);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("save_chrome_trace", "path"), &NativeTrace::save_chrome_trace);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("get_latency_histograms"), &NativeTrace::get_latency_histograms);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("reset_latency_histograms"), &NativeTrace::reset_latency_histograms);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("set_latency_histograms_enabled", "enabled"), &NativeTrace::set_latency_histograms_enabled);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("is_latency_histograms_enabled"), &NativeTrace::is_latency_histograms_enabled);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("is_alloc_tracking_compiled_in"), &NativeTrace::is_alloc_tracking_compiled_in);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("get_allocation_stats"), &NativeTrace::get_allocation_stats);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("get_allocation_totals"), &NativeTrace::get_allocation_totals);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("reset_allocation_stats"), &NativeTrace::reset_allocation_stats);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("get_native_capabilities"), &NativeTrace::get_native_capabilities);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("set_kernel_override", "isa"), &NativeTrace::set_kernel_override);
+    ClassDB::bind_static_method("NativeTrace", D_METHOD("get_kernel_override"), &NativeTrace::get_kernel_override);
+}
+
+bool NativeTrace::is_compiled_in() {
+    return TraceRecorder::compiled_in();
+}
+
+void NativeTrace::start_capture(int max_events_per_thread) {
+    if (!TraceRecorder::compiled_in()) {
+        UtilityFunctions::push_warning("NativeTrace: extension built without trace zones (make TRACE=1)");
+        return;
+    }
+    TraceRecorder::start(max_events_per_thread);
+}
+
+void NativeTrace::stop_capture() {
+    TraceRecorder::stop();
+}
+
+bool NativeTrace::is_capturing() {
+    return TraceRecorder::capturing();
+}
+
+void NativeTrace::clear() {
+    TraceRecorder::clear();
+}
+
+int NativeTrace::get_event_count() {
+    return static_cast<int>(TraceRecorder::event_count());
+}
+
+int NativeTrace::get_dropped_count() {
+    return static_cast<int>(TraceRecorder::dropped_count());
+}
+
+String NativeTrace::get_chrome_trace_json() {
+    return String::utf8(TraceRecorder::chrome_json().c_str());
+}
+
+bool NativeTrace::save_chrome_trace(const String& path) {
+    Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+    if (file.is_null()) {
+        UtilityFunctions::push_warning("NativeTrace.save_chrome_trace: cannot open ", path);
+        return false;
+    }
+    const std::string json = TraceRecorder::chrome_json();
+    PackedByteArray bytes;
+    bytes.resize(static_cast<int64_t>(json.size()));
+    std::copy(json.begin(), json.end(), bytes.ptrw());
+    file->store_buffer(bytes);
+    return true;
+}
+
+Dictionary NativeTrace::get_latency_histograms() {
+    return LatencyHistograms::snapshot();
+}
+
+void NativeTrace::reset_latency_histograms() {
+    LatencyHistograms::reset();
+}
+
+void NativeTrace::set_latency_histograms_enabled(bool enabled) {
+    LatencyHistograms::set_enabled(enabled);
+}
+
+bool NativeTrace::is_latency_histograms_enabled() {
+    return LatencyHistograms::is_enabled();
+}
+
+bool NativeTrace::is_alloc_tracking_compiled_in() {
+    return AllocTracker::compiled_in();
+}
+
+Dictionary NativeTrace::get_allocation_stats() {
+    if (!AllocTracker::compiled_in()) {
+        UtilityFunctions::push_warning("NativeTrace: extension built without allocation tracking (make ALLOC=1)");
+        return Dictionary();
+    }
+    return LatencyHistograms::allocation_snapshot();
+}
+
+Dictionary NativeTrace::get_allocation_totals() {
+    const AllocCounts totals = AllocTracker::totals();
+    Dictionary d;
+    d["heap_allocs"] = static_cast<int64_t>(totals.heap_allocs);
+    d["heap_bytes"] = static_cast<int64_t>(totals.heap_bytes);
+    d["packed_allocs"] = static_cast<int64_t>(totals.packed_allocs);
+    d["packed_bytes"] = static_cast<int64_t>(totals.packed_bytes);
+    return d;
+}
+
+void NativeTrace::reset_allocation_stats() {
+    AllocTracker::reset_totals();
+    LatencyHistograms::reset_allocations();
+}
+
+Dictionary NativeTrace::get_native_capabilities() {
+    Dictionary simd;
+    simd["detected"] = simd_isa_name(detect_simd_isa());
+    simd["active"] = simd_isa_name(active_simd_isa());
+    simd["override"] = get_kernel_override();
+    PackedStringArray available;
+    for (int isa = SIMD_BASELINE; isa <= SIMD_AVX512; isa++) {
+        if (simd_isa_available(static_cast<SimdIsa>(isa))) {
+            available.push_back(simd_isa_name(static_cast<SimdIsa>(isa)));
+        }
+    }
+    simd["available"] = available;
+    // Every hot kernel comes from the one active table
+    Dictionary kernels;
+    kernels["gemv_f32"] = simd["active"];
+    kernels["norm_sq_c64"] = simd["active"];
+    kernels["axpy_c64"] = simd["active"];
+    simd["kernels"] = kernels;
+
+    const NativeThreadPool& pool = NativeThreadPool::shared();
+    Dictionary threads;
+    threads["has_threads"] = NativeThreadPool::has_threads();
+    threads["worker_count"] = pool.worker_count();
+    threads["thread_count"] = pool.thread_count();
+    threads["godot_pool"] = pool.has_external_executor();
+
+    Dictionary eigen;
+    eigen["version"] = vformat("%d.%d.%d", EIGEN_WORLD_VERSION, EIGEN_MAJOR_VERSION, EIGEN_MINOR_VERSION);
+#ifdef EIGEN_VECTORIZE
+    eigen["vectorized"] = true;
+#else
+    eigen["vectorized"] = false;
+#endif
+    eigen["instruction_sets"] = Eigen::SimdInstructionSetsInUse();
+    eigen["max_align_bytes"] = EIGEN_MAX_ALIGN_BYTES;
+
+    Dictionary build;
+    build["platform"] = build_platform();
+    build["pointer_bits"] = static_cast<int>(sizeof(void*) * 8);
+#if defined(__clang__)
+    build["compiler"] = vformat("clang %s", __clang_version__);
+#elif defined(__GNUC__)
+    build["compiler"] = vformat("gcc %s", __VERSION__);
+#elif defined(_MSC_VER)
+    build["compiler"] = vformat("msvc %d", _MSC_VER);
+#endif
+#ifdef __OPTIMIZE__
+    build["optimized"] = true;
+#else
+    build["optimized"] = false;
+#endif
+#ifdef __FAST_MATH__
+    build["fast_math"] = true;
+#else
+    build["fast_math"] = false;
+#endif
+#ifdef NDEBUG
+    build["ndebug"] = true;
+#else
+    build["ndebug"] = false;
+#endif
+    build["trace_zones"] = is_compiled_in();
+    build["alloc_tracking"] = AllocTracker::compiled_in();
+
+    Dictionary d;
+    d["simd"] = simd;
+    d["threads"] = threads;
+    d["eigen"] = eigen;
+    d["build"] = build;
+    return d;
+}
+
+bool NativeTrace::set_kernel_override(const String& isa) {
+    if (isa.is_empty()) {
+        g_kernel_override = false;
+        select_simd_isa();
+        return true;
+    }
+    SimdIsa target = SIMD_BASELINE;
+    if (!simd_isa_from_name(isa.utf8().get_data(), &target)) {
+        UtilityFunctions::push_warning("NativeTrace: unknown kernel variant '", isa, "'");
+        return false;
+    }
+    if (!force_simd_isa(target)) {
+        UtilityFunctions::push_warning("NativeTrace: kernel variant '", isa, "' is not available on this build or host");
+        return false;
+    }
+    g_kernel_override = true;
+    return true;
+}
+
+String NativeTrace::get_kernel_override() {
+    return g_kernel_override ? String(simd_isa_name(active_simd_isa())) : String();
+}
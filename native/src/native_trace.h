@@ -0,0 +1,70 @@
+#ifndef NATIVE_TRACE_H
+#define NATIVE_TRACE_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+namespace godot {
+
+/**
+ * NativeTrace - GDScript control of the native trace-zone capture
+ *
+ *   NativeTrace.start_capture()
+ *   ... frames ...
+ *   NativeTrace.stop_capture()
+ *   NativeTrace.save_chrome_trace("user://native_trace.json")
+ *
+ * Zones exist only in builds made with TRACE=1 (is_compiled_in());
+ * otherwise start_capture warns and records nothing. See trace_zones.h.
+ *
+ * Per-method latency histograms of the engine classes are always on
+ * (latency_histograms.h): get_latency_histograms() returns p50/p95/p99/max
+ * per "<class>.<method>" called since start or the last reset. Builds made
+ * with ALLOC=1 also count heap and Packed array allocations per call of the
+ * same methods (get_allocation_stats(), alloc_tracking.h).
+ *
+ * get_native_capabilities() reports what this machine actually runs: the
+ * detected and active SIMD kernel table, pool threads, Eigen's
+ * vectorization and the build flags. set_kernel_override("avx2") pins one
+ * kernel table for A/B timing; "" returns to automatic selection.
+ */
+class NativeTrace : public RefCounted {
+    GDCLASS(NativeTrace, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    static bool is_compiled_in();
+    static void start_capture(int max_events_per_thread = 262144);
+    static void stop_capture();
+    static bool is_capturing();
+    static void clear();
+    static int get_event_count();
+    static int get_dropped_count();
+    static String get_chrome_trace_json();
+    static bool save_chrome_trace(const String& path);
+
+    static Dictionary get_latency_histograms();
+    static void reset_latency_histograms();
+    static void set_latency_histograms_enabled(bool enabled);
+    static bool is_latency_histograms_enabled();
+
+    static bool is_alloc_tracking_compiled_in();
+    static Dictionary get_allocation_stats();
+    // {"heap_allocs", "heap_bytes", "packed_allocs", "packed_bytes"} since load
+    static Dictionary get_allocation_totals();
+    static void reset_allocation_stats();
+
+    // {"simd": {...}, "threads": {...}, "eigen": {...}, "build": {...}}
+    static Dictionary get_native_capabilities();
+    // Kernel table by simd_isa_name ("baseline", "avx2", "avx512"); false
+    // (warning, table unchanged) if this build or host lacks it
+    static bool set_kernel_override(const String& isa);
+    static String get_kernel_override();  // "" while automatic
+};
+
+}  // namespace godot
+
+#endif  // NATIVE_TRACE_H
@@ -0,0 +1,53 @@
+#include "native_worker_pool.h"
+#include "native_thread_pool.h"
+
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+namespace {
+// One group element per chunk; Godot's workers claim them
+bool godot_executor(NativeThreadPool::ChunkRunner run, void* ctx, int count) {
+    WorkerThreadPool* pool = WorkerThreadPool::get_singleton();
+    if (pool == nullptr) {
+        return false;
+    }
+    const WorkerThreadPool::GroupID group = pool->add_native_group_task(run, ctx, count, -1, true, "NativeThreadPool");
+    pool->wait_for_group_task_completion(group);
+    return true;
+}
+}  // namespace
+
+void NativeWorkerPool::_bind_methods() {
+    ClassDB::bind_static_method("NativeWorkerPool", D_METHOD("set_worker_count", "count"), &NativeWorkerPool::set_worker_count);
+    ClassDB::bind_static_method("NativeWorkerPool", D_METHOD("get_worker_count"), &NativeWorkerPool::get_worker_count);
+    ClassDB::bind_static_method("NativeWorkerPool", D_METHOD("set_use_godot_pool", "enabled"), &NativeWorkerPool::set_use_godot_pool);
+    ClassDB::bind_static_method("NativeWorkerPool", D_METHOD("is_using_godot_pool"), &NativeWorkerPool::is_using_godot_pool);
+    ClassDB::bind_static_method("NativeWorkerPool", D_METHOD("get_thread_count"), &NativeWorkerPool::get_thread_count);
+    ClassDB::bind_static_method("NativeWorkerPool", D_METHOD("has_threads"), &NativeWorkerPool::has_threads);
+}
+
+void NativeWorkerPool::set_worker_count(int count) {
+    NativeThreadPool::shared().set_worker_count(count);
+}
+
+int NativeWorkerPool::get_worker_count() {
+    return NativeThreadPool::shared().worker_count();
+}
+
+void NativeWorkerPool::set_use_godot_pool(bool enabled) {
+    NativeThreadPool::shared().set_external_executor(enabled ? &godot_executor : nullptr);
+}
+
+bool NativeWorkerPool::is_using_godot_pool() {
+    return NativeThreadPool::shared().has_external_executor();
+}
+
+int NativeWorkerPool::get_thread_count() {
+    return NativeThreadPool::shared().thread_count();
+}
+
+bool NativeWorkerPool::has_threads() {
+    return NativeThreadPool::has_threads();
+}
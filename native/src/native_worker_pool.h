@@ -0,0 +1,36 @@
+#ifndef NATIVE_WORKER_POOL_H
+#define NATIVE_WORKER_POOL_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+
+namespace godot {
+
+/**
+ * NativeWorkerPool - GDScript access to the shared NativeThreadPool settings
+ *
+ *   NativeWorkerPool.set_worker_count(4)
+ *   NativeWorkerPool.set_use_godot_pool(true)
+ *
+ * set_use_godot_pool installs an executor that runs each job as a
+ * WorkerThreadPool group task, so the extension and the engine share one
+ * set of threads. has_threads() is false in the single-threaded web build,
+ * where every job runs inline.
+ */
+class NativeWorkerPool : public RefCounted {
+    GDCLASS(NativeWorkerPool, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    static void set_worker_count(int count);
+    static int get_worker_count();
+    static void set_use_godot_pool(bool enabled);
+    static bool is_using_godot_pool();
+    static int get_thread_count();
+    static bool has_threads();
+};
+
+}  // namespace godot
+
+#endif  // NATIVE_WORKER_POOL_H
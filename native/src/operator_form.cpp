@@ -0,0 +1,194 @@
+#include "operator_form.h"
+
+using namespace godot;
+
+namespace {
+
+// Cost model, in ns-scale units per product with a dim×dim row-major ρ,
+// fitted to timings of diagonal, σ-, σ+σ-, flip-Hamiltonian and random-fill
+// operators at 4-10 qubits (baseline x86-64 build, Eigen's GEMM included):
+//   - CSR × ρ is a row axpy per nonzero plus a per-row overhead, and ρ × CSR†
+//     walks the row-major ρ by columns, about twice that again;
+//   - DIA skips zeros on the left but runs full diagonals on the right;
+//   - DIAGONAL's sandwich is one elementwise pass;
+//   - DENSE is one GEMM (~1 unit per multiply-add) per product;
+//   - SCATTER is one multiply-add per pair of nonzeros.
+constexpr double CSR_SANDWICH_PER_NNZ = 3.0;  // × (nnz + dim)·dim
+constexpr double DIA_LEFT_PER_NNZ = 1.5;      // × nnz·dim (sandwich)
+constexpr double DIA_RIGHT_PER_SLOT = 2.0;    // × slots·dim (sandwich)
+constexpr double DIAGONAL_PASS = 2.0;         // × dim²
+constexpr double CSR_LEFT_PER_NNZ = 1.0;      // × nnz·dim (left product only)
+constexpr double DIA_LEFT_ONLY_PER_NNZ = 0.9;
+constexpr double LEFT_PER_ROW = 0.4;          // × dim² (left product only, CSR and DIA)
+constexpr double GEMM_PER_MADD = 0.9;
+constexpr double SCATTER_PER_PAIR = 3.0;      // × nnz² (sandwich)
+
+bool diagonal_only(const DiaOperator& dia) {
+    return dia.offsets.size() == 1 && dia.offsets[0] == 0;
+}
+
+}  // namespace
+
+int64_t OperatorForm::bytes() const {
+    return dia.bytes() + static_cast<int64_t>(dense.size()) * static_cast<int64_t>(sizeof(std::complex<double>)) +
+           static_cast<int64_t>(entries.capacity()) * static_cast<int64_t>(sizeof(Entry));
+}
+
+const char* OperatorForm::kind_name(Kind kind) {
+    switch (kind) {
+        case DIAGONAL:
+            return "diagonal";
+        case DIA:
+            return "dia";
+        case DENSE:
+            return "dense";
+        case SCATTER:
+            return "scatter";
+        default:
+            return "csr";
+    }
+}
+
+double OperatorForm::cost(const SparseCM& A, Kind kind, bool left_only) {
+    const double n = static_cast<double>(A.rows());
+    const double nnz = static_cast<double>(A.nonZeros());
+    if (kind == CSR) {
+        return left_only ? (CSR_LEFT_PER_NNZ * nnz + LEFT_PER_ROW * n) * n
+                         : CSR_SANDWICH_PER_NNZ * (nnz + n) * n;
+    }
+    if (kind == DENSE) {
+        return (left_only ? 1.0 : 2.0) * GEMM_PER_MADD * n * n * n;
+    }
+    if (kind == SCATTER) {
+        return left_only ? -1.0 : SCATTER_PER_PAIR * nnz * nnz;
+    }
+    DiaOperator dia;
+    if (!DiaOperator::from_sparse(A, dia) || (kind == DIAGONAL && !diagonal_only(dia))) {
+        return -1.0;
+    }
+    if (left_only) {
+        return (DIA_LEFT_ONLY_PER_NNZ * nnz + LEFT_PER_ROW * n) * n;
+    }
+    if (kind == DIAGONAL) {
+        return DIAGONAL_PASS * n * n;
+    }
+    return (DIA_LEFT_PER_NNZ * nnz + DIA_RIGHT_PER_SLOT * static_cast<double>(dia.slots())) * n;
+}
+
+OperatorForm OperatorForm::build(const SparseCM& A, bool left_only) {
+    Kind best = CSR;
+    double best_cost = cost(A, CSR, left_only);
+    for (Kind kind : {DIAGONAL, DIA, DENSE, SCATTER}) {
+        const double c = cost(A, kind, left_only);
+        if (c >= 0.0 && c < best_cost) {
+            best = kind;
+            best_cost = c;
+        }
+    }
+    OperatorForm form;
+    build_as(A, best, form);
+    return form;
+}
+
+bool OperatorForm::build_as(const SparseCM& A, Kind kind, OperatorForm& out) {
+    out = OperatorForm();
+    if (A.rows() == 0 || A.rows() != A.cols()) {
+        return kind == CSR;
+    }
+    switch (kind) {
+        case CSR:
+            return true;
+        case DIAGONAL:
+        case DIA:
+            if (!DiaOperator::from_sparse(A, out.dia) || (kind == DIAGONAL && !diagonal_only(out.dia))) {
+                out.dia = DiaOperator();
+                return false;
+            }
+            break;
+        case DENSE:
+            out.dense = DenseCM(A);
+            break;
+        case SCATTER:
+            out.entries.reserve(static_cast<size_t>(A.nonZeros()));
+            for (int r = 0; r < A.outerSize(); r++) {
+                for (SparseCM::InnerIterator it(A, r); it; ++it) {
+                    if (it.value() != std::complex<double>(0.0, 0.0)) {
+                        out.entries.push_back({r, static_cast<int>(it.col()), it.value()});
+                    }
+                }
+            }
+            break;
+        default:
+            return false;
+    }
+    out.kind = kind;
+    return true;
+}
+
+void OperatorForm::apply_left(std::complex<double> scale, DenseConstRef in, DenseRef out) const {
+    if (kind == SCATTER) {
+        for (const Entry& e : entries) {
+            out.row(e.row) += (scale * e.value) * in.row(e.col);
+        }
+    } else if (kind == DENSE) {
+        out.noalias() += scale * (dense * in);
+    } else {
+        dia.apply_left(scale, in, out);
+    }
+}
+
+void OperatorForm::apply_right_adjoint(std::complex<double> scale, DenseConstRef in, DenseRef out) const {
+    if (kind == SCATTER) {
+        for (const Entry& e : entries) {
+            out.col(e.row) += (scale * std::conj(e.value)) * in.col(e.col);
+        }
+    } else if (kind == DENSE) {
+        out.noalias() += scale * (in * dense.adjoint());
+    } else {
+        dia.apply_right_adjoint(scale, in, out);
+    }
+}
+
+void OperatorForm::apply_sandwich(std::complex<double> scale, DenseConstRef in, DenseRef out, DenseCM& temp) const {
+    switch (kind) {
+        case DIAGONAL: {
+            // (A ρ A†)(i, j) = a_i ρ(i, j) conj(a_j): one pass, no scratch
+            const int n = static_cast<int>(in.rows());
+            const Eigen::Map<const Eigen::RowVectorXcd> diagonal(dia.values.data(), n);
+            for (int i = 0; i < n; i++) {
+                const std::complex<double> c = scale * dia.values[i];
+                if (c != std::complex<double>(0.0, 0.0)) {
+                    out.row(i) += c * in.row(i).cwiseProduct(diagonal.conjugate());
+                }
+            }
+            break;
+        }
+        case DIA:
+            temp.setZero();
+            dia.apply_left(std::complex<double>(1.0, 0.0), in, temp);
+            dia.apply_right_adjoint(scale, temp, out);
+            break;
+        case DENSE:
+            temp.noalias() = dense * in;
+            out.noalias() += scale * (temp * dense.adjoint());
+            break;
+        case SCATTER: {
+            // (A ρ A†)(a, c) = Σ A(a, b) ρ(b, d) conj(A(c, d)) over nonzero
+            // pairs; the inner walk stays on rows a of out and b of ρ
+            const int count = static_cast<int>(entries.size());
+            for (int p = 0; p < count; p++) {
+                const Entry& e = entries[p];
+                const std::complex<double> s = scale * e.value;
+                const std::complex<double>* in_row = in.data() + static_cast<int64_t>(e.col) * in.outerStride();
+                std::complex<double>* out_row = out.data() + static_cast<int64_t>(e.row) * out.outerStride();
+                for (int q = 0; q < count; q++) {
+                    const Entry& f = entries[q];
+                    out_row[f.row] += s * in_row[f.col] * std::conj(f.value);
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef OPERATOR_FORM_H
+#define OPERATOR_FORM_H
+
+#include "dia_operator.h"
+
+namespace godot {
+
+/**
+ * OperatorForm - The representation an operator's products with ρ run in
+ *
+ * The CSR matrices stay the source of truth (patching, snapshots, the
+ * Liouvillian); build() estimates what one L ρ L† sandwich (or, for
+ * H_eff, one left product) with a dense dim×dim ρ costs in each form and
+ * keeps a copy in the cheapest:
+ *
+ *   CSR       the CSR matrix itself, no copy (scattered, irregular fill)
+ *   DIAGONAL  one vector; L ρ L† is a single elementwise pass over ρ
+ *   DIA       DiaOperator: a few full diagonals (qubit flips, ±2^k)
+ *   DENSE     a dense copy, so both products are GEMMs (heavy fill)
+ *   SCATTER   the nonzeros as a list; L ρ L† is a gather/scatter over
+ *             pairs of them, nnz² terms straight into the output with no
+ *             dim×dim temporary (single-entry and other very sparse jumps)
+ *
+ * The cost constants are fitted to measured timings (operator_form.cpp);
+ * build_as() forces one form for A/B timing.
+ */
+struct OperatorForm {
+    typedef DiaOperator::SparseCM SparseCM;
+    typedef DiaOperator::DenseCM DenseCM;
+    typedef DiaOperator::DenseRef DenseRef;
+    typedef DiaOperator::DenseConstRef DenseConstRef;
+
+    enum Kind {
+        CSR = 0,
+        DIAGONAL = 1,
+        DIA = 2,
+        DENSE = 3,
+        SCATTER = 4
+    };
+
+    struct Entry {
+        int row;
+        int col;
+        std::complex<double> value;
+    };
+
+    Kind kind = CSR;
+    DiaOperator dia;  // DIAGONAL (the offset-0 diagonal only) and DIA
+    DenseCM dense;    // DENSE
+    std::vector<Entry> entries;  // SCATTER, in row-major order
+
+    bool is_csr() const { return kind == CSR; }
+    int64_t bytes() const;
+    static const char* kind_name(Kind kind);
+
+    // Cheapest form for A by the cost model: for the L ρ L† sandwich, or
+    // for A·ρ alone (H_eff, whose drift is X + X† with X = -i H_eff ρ)
+    static OperatorForm build(const SparseCM& A, bool left_only = false);
+    // A in exactly this form; false (out left CSR) if A cannot take it
+    static bool build_as(const SparseCM& A, Kind kind, OperatorForm& out);
+    // Estimated cost of one sandwich (or left product) in kind; < 0 if A
+    // cannot take the form (SCATTER is sandwich-only)
+    static double cost(const SparseCM& A, Kind kind, bool left_only = false);
+
+    // The products below are for the non-CSR forms; CSR callers keep their
+    // Eigen sparse products
+    // out += scale · A · in
+    void apply_left(std::complex<double> scale, DenseConstRef in, DenseRef out) const;
+    // out += scale · in · A†
+    void apply_right_adjoint(std::complex<double> scale, DenseConstRef in, DenseRef out) const;
+    // out += scale · A · in · A†; temp is scratch the size of in (DIA and DENSE only)
+    void apply_sandwich(std::complex<double> scale, DenseConstRef in, DenseRef out, DenseCM& temp) const;
+};
+
+}  // namespace godot
+
+#endif  // OPERATOR_FORM_H
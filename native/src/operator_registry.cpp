@@ -0,0 +1,159 @@
+#include "operator_registry.h"
+#include "memory_bytes.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+using namespace godot;
+
+namespace {
+
+typedef SharedLindblad::SparseCM SparseCM;
+
+// FNV-1a over raw bytes
+inline void hash_bytes(uint64_t& h, const void* data, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+}
+
+uint64_t hash_operator(const SparseCM& L) {
+    uint64_t h = 14695981039346656037ULL;
+    const int64_t shape[3] = {L.rows(), L.cols(), L.nonZeros()};
+    hash_bytes(h, shape, sizeof(shape));
+    hash_bytes(h, L.outerIndexPtr(), sizeof(int) * (L.outerSize() + 1));
+    hash_bytes(h, L.innerIndexPtr(), sizeof(int) * L.nonZeros());
+    for (int64_t k = 0; k < L.nonZeros(); k++) {
+        // + 0.0 folds -0.0 into 0.0 so equal operators hash equally
+        const double parts[2] = {L.valuePtr()[k].real() + 0.0, L.valuePtr()[k].imag() + 0.0};
+        hash_bytes(h, parts, sizeof(parts));
+    }
+    return h;
+}
+
+bool equal_operator(const SparseCM& a, const SparseCM& b) {
+    if (a.rows() != b.rows() || a.cols() != b.cols() || a.nonZeros() != b.nonZeros()) {
+        return false;
+    }
+    return std::equal(a.outerIndexPtr(), a.outerIndexPtr() + a.outerSize() + 1, b.outerIndexPtr()) &&
+           std::equal(a.innerIndexPtr(), a.innerIndexPtr() + a.nonZeros(), b.innerIndexPtr()) &&
+           std::equal(a.valuePtr(), a.valuePtr() + a.nonZeros(), b.valuePtr());
+}
+
+struct Registry {
+    std::mutex mutex;
+    std::unordered_map<uint64_t, std::vector<std::weak_ptr<const SharedLindblad>>> buckets;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+}  // namespace
+
+void SharedLindblad::build_single() const {
+    std::call_once(m_single_once, [this]() {
+        m_L_f = L.cast<std::complex<float>>();
+        m_L_dag_f = L_dag.cast<std::complex<float>>();
+        m_single_built.store(true, std::memory_order_release);
+    });
+}
+
+int64_t SharedLindblad::operator_bytes() const {
+    return memory_bytes::sparse(L);
+}
+
+int64_t SharedLindblad::derived_bytes() const {
+    int64_t bytes = memory_bytes::sparse(L_dag) + memory_bytes::sparse(LdagL) + L_form.bytes();
+    if (m_single_built.load(std::memory_order_acquire)) {
+        bytes += memory_bytes::sparse(m_L_f) + memory_bytes::sparse(m_L_dag_f);
+    }
+    return bytes;
+}
+
+const SharedLindblad::SparseCF& SharedLindblad::lindblad_f() const {
+    build_single();
+    return m_L_f;
+}
+
+const SharedLindblad::SparseCF& SharedLindblad::lindblad_dag_f() const {
+    build_single();
+    return m_L_dag_f;
+}
+
+std::shared_ptr<const SharedLindblad> OperatorRegistry::intern(const SparseCM& L) {
+    SparseCM compressed = L;
+    compressed.makeCompressed();
+    return intern_with_products(std::move(compressed), SparseCM(), SparseCM());
+}
+
+std::shared_ptr<const SharedLindblad> OperatorRegistry::intern_with_products(SparseCM L, SparseCM L_dag,
+                                                                             SparseCM LdagL) {
+    L.makeCompressed();
+    const uint64_t h = hash_operator(L);
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<std::weak_ptr<const SharedLindblad>>& bucket = reg.buckets[h];
+    for (auto it = bucket.begin(); it != bucket.end();) {
+        std::shared_ptr<const SharedLindblad> entry = it->lock();
+        if (!entry) {
+            it = bucket.erase(it);  // Last engine let go
+            continue;
+        }
+        if (equal_operator(entry->L, L)) {
+            reg.hits++;
+            return entry;
+        }
+        ++it;
+    }
+
+    auto entry = std::make_shared<SharedLindblad>();
+    entry->L = std::move(L);
+    if (L_dag.rows() == entry->L.cols() && LdagL.rows() == entry->L.cols() && entry->L.rows() > 0) {
+        entry->L_dag = std::move(L_dag);
+        entry->LdagL = std::move(LdagL);
+    } else {
+        entry->L_dag = entry->L.adjoint();
+        entry->LdagL = entry->L_dag * entry->L;
+    }
+    entry->L_dag.makeCompressed();
+    entry->LdagL.makeCompressed();
+    entry->L_form = OperatorForm::build(entry->L);
+    entry->hash = h;
+    bucket.push_back(entry);
+    reg.misses++;
+    return entry;
+}
+
+OperatorRegistry::Stats OperatorRegistry::stats() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    Stats out;
+    for (auto it = reg.buckets.begin(); it != reg.buckets.end();) {
+        auto& bucket = it->second;
+        bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                                    [](const std::weak_ptr<const SharedLindblad>& w) { return w.expired(); }),
+                     bucket.end());
+        if (bucket.empty()) {
+            it = reg.buckets.erase(it);
+            continue;
+        }
+        out.live += static_cast<int>(bucket.size());
+        for (const auto& weak : bucket) {
+            if (std::shared_ptr<const SharedLindblad> entry = weak.lock()) {
+                out.bytes += entry->operator_bytes() + entry->derived_bytes();
+            }
+        }
+        ++it;
+    }
+    out.hits = reg.hits;
+    out.misses = reg.misses;
+    return out;
+}
@@ -0,0 +1,84 @@
+#ifndef OPERATOR_REGISTRY_H
+#define OPERATOR_REGISTRY_H
+
+#include "operator_form.h"
+
+#include <Eigen/Sparse>
+#include <complex>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace godot {
+
+/**
+ * SharedLindblad - One registered jump operator with its derived products
+ *
+ * Holds L, L† and L†L in compressed row-major form, plus a copy of L in
+ * whichever form runs L ρ L† fastest (operator_form.h). Immutable once built
+ * (the single-precision mirrors are filled once, on first request), so a
+ * handle can be read from any thread and by any number of engines.
+ */
+struct SharedLindblad {
+    typedef Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> SparseCM;
+    typedef Eigen::SparseMatrix<std::complex<float>, Eigen::RowMajor> SparseCF;
+
+    SparseCM L;
+    SparseCM L_dag;   // L†
+    SparseCM LdagL;   // L†L
+    OperatorForm L_form;  // L in its cheapest form for L ρ L† (CSR: use L, L_dag)
+    uint64_t hash = 0;
+
+    // complex<float> copies of L and L† (built on first call)
+    const SparseCF& lindblad_f() const;
+    const SparseCF& lindblad_dag_f() const;
+
+    // Heap bytes of L, and of everything derived from it (L†, L†L and the
+    // single-precision copies once built)
+    int64_t operator_bytes() const;
+    int64_t derived_bytes() const;
+
+private:
+    void build_single() const;
+    mutable std::once_flag m_single_once;
+    mutable std::atomic<bool> m_single_built{false};
+    mutable SparseCF m_L_f;
+    mutable SparseCF m_L_dag_f;
+};
+
+/**
+ * OperatorRegistry - Content-hashed store of Lindblad operators
+ *
+ * Biomes register many structurally identical jump operators (dephasing or
+ * decay on each qubit), and every engine used to keep its own L, L†, L†L.
+ * intern() hashes the compressed pattern and values, returns the existing
+ * entry when an equal operator is already live and registers a new one
+ * otherwise. The registry only holds weak references: an operator is freed
+ * once the last engine drops its handle.
+ *
+ * Engines compare handles by pointer, so "same operator" checks (e.g. the
+ * batched kernel sharing one jump across biomes) are O(1).
+ */
+class OperatorRegistry {
+public:
+    typedef SharedLindblad::SparseCM SparseCM;
+
+    // Shared handle for L (compressed, dim×dim). Thread-safe.
+    static std::shared_ptr<const SharedLindblad> intern(const SparseCM& L);
+    // Same, with L† and L†L supplied (e.g. restored from a snapshot) instead
+    // of recomputed when L is new. They must be L's adjoint and L†L.
+    static std::shared_ptr<const SharedLindblad> intern_with_products(SparseCM L, SparseCM L_dag, SparseCM LdagL);
+
+    struct Stats {
+        int live = 0;         // Distinct operators currently referenced
+        uint64_t hits = 0;    // intern() calls served by an existing entry
+        uint64_t misses = 0;  // intern() calls that built a new entry
+        int64_t bytes = 0;    // Heap bytes of the live operators and their derived products
+    };
+    static Stats stats();
+};
+
+}  // namespace godot
+
+#endif  // OPERATOR_REGISTRY_H
@@ -1,18 +1,92 @@
 #include "parametric_selector_native.h"
+#include "native_thread_pool.h"
+#include "simd_dispatch.h"
 
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <numeric>
 #include <random>
 
 namespace godot {
 
-// Random number generator for weighted random selection
-static std::random_device rd;
-static std::mt19937 gen(rd());
+namespace {
 
-ParametricSelectorNative::ParametricSelectorNative() {}
+// Queries scored per matrix-matrix product in select_best_batch (one block
+// of scores stays cache-resident for libraries of a few thousand entries)
+constexpr int QUERY_BLOCK = 64;
+
+// Below this many candidates the exact scan beats probing an LSH index
+constexpr int ANN_MIN_CANDIDATES = 256;
+
+// Float rounding allowance taken off a selector session's reuse radius
+constexpr float SESSION_SLACK = 1e-4f;
+
+// Slot for a new handle-addressed entry, reusing freed handles first
+template <typename T>
+int store_handle(std::vector<std::unique_ptr<T>> &r_slots, std::vector<int> &r_free, std::unique_ptr<T> p_entry) {
+	if (!r_free.empty()) {
+		const int handle = r_free.back();
+		r_free.pop_back();
+		r_slots[handle] = std::move(p_entry);
+		return handle;
+	}
+	r_slots.push_back(std::move(p_entry));
+	return static_cast<int>(r_slots.size()) - 1;
+}
+
+} // namespace
+
+void SelectorRng::seed(uint64_t p_seed) {
+	// SplitMix64 expands the seed so nearby seeds give unrelated streams
+	for (uint64_t &word : state) {
+		p_seed += 0x9E3779B97F4A7C15ULL;
+		uint64_t z = p_seed;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		word = z ^ (z >> 31);
+	}
+}
+
+uint64_t SelectorRng::next() {
+	auto rotl = [](uint64_t x, int k) { return (x << k) | (x >> (64 - k)); };
+	const uint64_t result = rotl(state[1] * 5, 7) * 9;
+	const uint64_t t = state[1] << 17;
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+	state[2] ^= t;
+	state[3] = rotl(state[3], 45);
+	return result;
+}
+
+namespace {
+
+uint64_t entropy_seed() {
+	std::random_device rd;
+	return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+}
+
+} // namespace
+
+SelectorRng &ParametricSelectorNative::_thread_rng() {
+	thread_local SelectorRng rng(entropy_seed());
+	return rng;
+}
+
+void ParametricSelectorNative::seed_thread_rng(int64_t p_seed) {
+	_thread_rng().seed(static_cast<uint64_t>(p_seed));
+}
+
+void ParametricSelectorNative::set_seed(int64_t p_seed) {
+	m_rng.seed(static_cast<uint64_t>(p_seed));
+}
+
+ParametricSelectorNative::ParametricSelectorNative() :
+		m_rng(entropy_seed()) {}
 ParametricSelectorNative::~ParametricSelectorNative() {}
 
 // ============================================================================
@@ -101,6 +175,44 @@ double ParametricSelectorNative::_cosine_similarity(const Dictionary &p_v1, cons
 	return cos_theta * cos_theta;
 }
 
+double ParametricSelectorNative::_cosine_similarity_prepared(const Dictionary &p_query, double p_query_norm_sq, const Dictionary &p_candidate) {
+	if (p_query.is_empty() || p_candidate.is_empty() || p_query_norm_sq < 1e-9) {
+		return 0.0;
+	}
+
+	double norm_sq = 0.0;
+	double dot = 0.0;
+	Array keys = p_candidate.keys();
+	for (int i = 0; i < keys.size(); i++) {
+		Variant key = keys[i];
+		double val = p_candidate[key];
+		norm_sq += val * val;
+		Variant query_val = p_query.get(key, Variant());
+		if (query_val.get_type() != Variant::NIL) {
+			dot += val * static_cast<double>(query_val);
+		}
+	}
+
+	if (norm_sq < 1e-9) {
+		return 0.0;
+	}
+	double cos_theta = dot / std::sqrt(p_query_norm_sq * norm_sq);
+	return cos_theta * cos_theta;
+}
+
+double ParametricSelectorNative::_candidate_similarity(
+	const Dictionary &p_query,
+	double p_query_norm_sq,
+	const Dictionary &p_candidate,
+	int p_metric,
+	const Dictionary &p_params
+) {
+	if (p_metric == METRIC_COSINE) {
+		return _cosine_similarity_prepared(p_query, p_query_norm_sq, p_candidate);
+	}
+	return compute_similarity(p_query, p_candidate, p_metric, p_params);
+}
+
 // ============================================================================
 // INTERNAL: CONNECTION STRENGTH
 // ============================================================================
@@ -247,12 +359,13 @@ Dictionary ParametricSelectorNative::select_best(
 
 	Dictionary best_candidate;
 	double best_similarity = -std::numeric_limits<double>::infinity();
+	const double query_norm_sq = p_metric == METRIC_COSINE ? dot_product(p_vector, p_vector) : 0.0;
 
 	for (int i = 0; i < p_candidates.size(); i++) {
 		Dictionary candidate = p_candidates[i];
 		Dictionary candidate_vector = candidate.get("vector", Dictionary());
 
-		double similarity = compute_similarity(p_vector, candidate_vector, p_metric, p_params);
+		double similarity = _candidate_similarity(p_vector, query_norm_sq, candidate_vector, p_metric, p_params);
 
 		if (similarity > best_similarity) {
 			best_similarity = similarity;
@@ -267,6 +380,20 @@ Dictionary ParametricSelectorNative::select_best(
 	return best_candidate;
 }
 
+std::vector<int> ParametricSelectorNative::_top_k_indices(const std::vector<double> &p_scores, int p_k) {
+	const int count = static_cast<int>(p_scores.size());
+	const int k = (p_k > 0 && p_k < count) ? p_k : count;
+	std::vector<int> order(count);
+	std::iota(order.begin(), order.end(), 0);
+
+	// Descending score, ties in input order (what the old stable sort gave)
+	std::partial_sort(order.begin(), order.begin() + k, order.end(), [&p_scores](int a, int b) {
+		return p_scores[a] > p_scores[b] || (p_scores[a] == p_scores[b] && a < b);
+	});
+	order.resize(k);
+	return order;
+}
+
 Array ParametricSelectorNative::select_top_k(
 	const Dictionary &p_vector,
 	const Array &p_candidates,
@@ -280,38 +407,23 @@ Array ParametricSelectorNative::select_top_k(
 		return results;
 	}
 
-	// Compute similarity for all candidates
+	// Score every candidate into a plain array; only the winners are
+	// materialized as Dictionaries
+	std::vector<double> scores(p_candidates.size());
+	const double query_norm_sq = p_metric == METRIC_COSINE ? dot_product(p_vector, p_vector) : 0.0;
 	for (int i = 0; i < p_candidates.size(); i++) {
 		Dictionary candidate = p_candidates[i];
 		Dictionary candidate_vector = candidate.get("vector", Dictionary());
+		scores[i] = _candidate_similarity(p_vector, query_norm_sq, candidate_vector, p_metric, p_params);
+	}
 
-		double similarity = compute_similarity(p_vector, candidate_vector, p_metric, p_params);
-
+	for (int index : _top_k_indices(scores, p_k)) {
+		Dictionary candidate = p_candidates[index];
 		Dictionary result = candidate.duplicate();
-		result["similarity"] = similarity;
+		result["similarity"] = scores[index];
 		results.append(result);
 	}
 
-	// Sort by similarity (descending) - bubble sort for simplicity
-	for (int i = 0; i < results.size() - 1; i++) {
-		for (int j = 0; j < results.size() - i - 1; j++) {
-			Dictionary a = results[j];
-			Dictionary b = results[j + 1];
-			double sim_a = a.get("similarity", 0.0);
-			double sim_b = b.get("similarity", 0.0);
-
-			if (sim_a < sim_b) {
-				results[j] = b;
-				results[j + 1] = a;
-			}
-		}
-	}
-
-	// Return top K
-	if (p_k > 0 && p_k < results.size()) {
-		return results.slice(0, p_k);
-	}
-
 	return results;
 }
 
@@ -330,8 +442,7 @@ String ParametricSelectorNative::select_weighted_random(const Array &p_candidate
 		return String();
 	}
 
-	std::uniform_real_distribution<> dis(0.0, total_weight);
-	double roll = dis(gen);
+	double roll = _thread_rng().next_double() * total_weight;
 	double cumulative = 0.0;
 
 	for (int i = 0; i < p_candidates.size(); i++) {
@@ -362,8 +473,7 @@ Dictionary ParametricSelectorNative::select_weighted_random_full(const Array &p_
 		return Dictionary();
 	}
 
-	std::uniform_real_distribution<> dis(0.0, total_weight);
-	double roll = dis(gen);
+	double roll = _thread_rng().next_double() * total_weight;
 	double cumulative = 0.0;
 
 	for (int i = 0; i < p_candidates.size(); i++) {
@@ -379,6 +489,978 @@ Dictionary ParametricSelectorNative::select_weighted_random_full(const Array &p_
 	return last.duplicate();
 }
 
+// ============================================================================
+// REGISTERED LIBRARIES
+// ============================================================================
+
+int ParametricSelectorNative::_intern_key(const Variant &p_key) {
+	Variant id = m_key_ids.get(p_key, Variant());
+	if (id.get_type() == Variant::INT) {
+		return id;
+	}
+	const int new_id = m_keys.size();
+	m_key_ids[p_key] = new_id;
+	m_keys.append(p_key);
+	return new_id;
+}
+
+void ParametricSelectorNative::_intern_vector(const Dictionary &p_vector, std::vector<std::pair<int, float>> &r_entries) {
+	Array keys = p_vector.keys();
+	r_entries.clear();
+	r_entries.reserve(keys.size());
+	for (int k = 0; k < keys.size(); k++) {
+		Variant key = keys[k];
+		double value = p_vector[key];
+		r_entries.emplace_back(_intern_key(key), static_cast<float>(value));
+	}
+}
+
+void ParametricSelectorNative::Library::set_row(int p_row, const std::vector<std::pair<int, float>> &p_entries) {
+	vectors.row(p_row).setZero();
+	for (const std::pair<int, float> &entry : p_entries) {
+		vectors(p_row, entry.first) = entry.second;
+	}
+	const float norm_sq = vectors.row(p_row).squaredNorm();
+	if (norm_sq < 1e-9f) {
+		vectors.row(p_row).setZero();
+		norms[p_row] = 0.0f;
+		norms_sq[p_row] = std::numeric_limits<float>::infinity();
+	} else {
+		norms[p_row] = std::sqrt(norm_sq);
+		norms_sq[p_row] = norm_sq;
+		vectors.row(p_row) /= norms[p_row];
+	}
+}
+
+int ParametricSelectorNative::register_library(const Array &p_candidates) {
+	auto library = std::make_unique<Library>();
+	library->candidates = p_candidates.duplicate();
+
+	// Intern every key first so the matrix is sized once
+	const int count = p_candidates.size();
+	std::vector<std::vector<std::pair<int, float>>> rows(count);
+	for (int i = 0; i < count; i++) {
+		Dictionary candidate = p_candidates[i];
+		_intern_vector(candidate.get("vector", Dictionary()), rows[i]);
+		library->weights.push_back(candidate.get("weight", 0.0));
+	}
+
+	library->vectors.resize(count, m_keys.size());
+	library->norms.resize(count);
+	library->norms_sq.resize(count);
+	for (int i = 0; i < count; i++) {
+		library->set_row(i, rows[i]);
+	}
+	library->version = ++m_library_version;
+
+	return store_handle(m_libraries, m_free_libraries, std::move(library));
+}
+
+int ParametricSelectorNative::library_add(int p_handle, const Dictionary &p_candidate) {
+	Library *library = _checked_library(p_handle, "library_add");
+	if (!library) {
+		return -1;
+	}
+
+	std::vector<std::pair<int, float>> entries;
+	_intern_vector(p_candidate.get("vector", Dictionary()), entries);
+
+	// Geometric growth keeps both resizes amortized O(dims) per add; new
+	// columns start at zero, so existing rows (and their hashes) are unchanged
+	const Eigen::Index cols = library->vectors.cols();
+	if (m_keys.size() > cols) {
+		const Eigen::Index new_cols = std::max<Eigen::Index>(m_keys.size(), 2 * cols);
+		library->vectors.conservativeResize(Eigen::NoChange, new_cols);
+		library->vectors.rightCols(new_cols - cols).setZero();
+		if (library->index) {
+			LshIndex &index = *library->index;
+			std::normal_distribution<float> normal(0.0f, 1.0f);
+			index.planes.conservativeResize(Eigen::NoChange, new_cols);
+			for (Eigen::Index c = cols; c < new_cols; c++) {
+				for (Eigen::Index r = 0; r < index.planes.rows(); r++) {
+					index.planes(r, c) = normal(index.rng);
+				}
+			}
+		}
+	}
+	const int row = library->size();
+	if (row == library->vectors.rows()) {
+		const Eigen::Index capacity = std::max<Eigen::Index>(4, 2 * library->vectors.rows());
+		library->vectors.conservativeResize(capacity, Eigen::NoChange);
+		library->norms.conservativeResize(capacity);
+		library->norms_sq.conservativeResize(capacity);
+	}
+
+	library->set_row(row, entries);
+	library->candidates.append(p_candidate);
+	library->weights.push_back(p_candidate.get("weight", 0.0));
+	if (library->index) {
+		library->index->insert(row, library->projections(row));
+	}
+	library->version = ++m_library_version;
+	return row;
+}
+
+void ParametricSelectorNative::library_remove(int p_handle, int p_index) {
+	Library *library = _checked_library(p_handle, "library_remove");
+	if (!library) {
+		return;
+	}
+	if (p_index < 0 || p_index >= library->size()) {
+		UtilityFunctions::push_warning("ParametricSelectorNative: Invalid library index for library_remove ", p_index);
+		return;
+	}
+
+	// Swap-remove: the last candidate takes over p_index
+	const int last = library->size() - 1;
+	if (library->index) {
+		library->index->erase(p_index, library->projections(p_index));
+		if (p_index != last) {
+			const Eigen::VectorXf projections = library->projections(last);
+			library->index->erase(last, projections);
+			library->index->insert(p_index, projections);
+		}
+	}
+	if (p_index != last) {
+		library->vectors.row(p_index) = library->vectors.row(last);
+		library->norms[p_index] = library->norms[last];
+		library->norms_sq[p_index] = library->norms_sq[last];
+		library->candidates[p_index] = library->candidates[last];
+		library->weights.set(p_index, library->weights.weights[last]);
+	}
+	library->candidates.resize(last);
+	library->weights.pop_back();
+	library->version = ++m_library_version;
+}
+
+void ParametricSelectorNative::library_update_weight(int p_handle, int p_index, double p_weight) {
+	Library *library = _checked_library(p_handle, "library_update_weight");
+	if (!library) {
+		return;
+	}
+	if (p_index < 0 || p_index >= library->size()) {
+		UtilityFunctions::push_warning("ParametricSelectorNative: Invalid library index for library_update_weight ", p_index);
+		return;
+	}
+	Dictionary candidate = library->candidates[p_index];
+	candidate["weight"] = p_weight;
+	library->weights.set(p_index, p_weight);
+}
+
+PackedInt32Array ParametricSelectorNative::library_sample(int p_handle, int p_count) {
+	PackedInt32Array indices;
+	Library *library = _checked_library(p_handle, "library_sample");
+	if (!library || p_count <= 0) {
+		return indices;
+	}
+	const double total = library->weights.total();
+	if (total < 1e-9) {
+		return indices;  // Same cut-off as select_weighted_random
+	}
+
+	indices.resize(p_count);
+	int32_t *out = indices.ptrw();
+	for (int i = 0; i < p_count; i++) {
+		out[i] = library->weights.find(m_rng.next_double() * total);
+	}
+	return indices;
+}
+
+// ============================================================================
+// LIBRARY WEIGHT TREE
+// ============================================================================
+
+void ParametricSelectorNative::WeightTree::push_back(double p_weight) {
+	// Node i covers (i - lowbit(i), i]: the new weight plus the nodes that
+	// tile the rest of that range
+	const int i = static_cast<int>(weights.size()) + 1;
+	weights.push_back(std::max(p_weight, 0.0));
+	double sum = weights.back();
+	for (int step = 1; step < (i & -i); step <<= 1) {
+		sum += tree[i - step - 1];
+	}
+	tree.push_back(sum);
+}
+
+void ParametricSelectorNative::WeightTree::pop_back() {
+	// No node covers an index past its own, so the prefix stays intact
+	weights.pop_back();
+	tree.pop_back();
+}
+
+void ParametricSelectorNative::WeightTree::set(int p_index, double p_weight) {
+	const double weight = std::max(p_weight, 0.0);
+	const double delta = weight - weights[p_index];
+	weights[p_index] = weight;
+	const int count = static_cast<int>(tree.size());
+	for (int i = p_index + 1; i <= count; i += i & -i) {
+		tree[i - 1] += delta;
+	}
+}
+
+double ParametricSelectorNative::WeightTree::total() const {
+	double sum = 0.0;
+	for (int i = static_cast<int>(tree.size()); i > 0; i -= i & -i) {
+		sum += tree[i - 1];
+	}
+	return sum;
+}
+
+int ParametricSelectorNative::WeightTree::find(double p_target) const {
+	const int count = static_cast<int>(tree.size());
+	int step = 1;
+	while (step * 2 <= count) {
+		step *= 2;
+	}
+	int pos = 0;
+	double remaining = p_target;
+	for (; step > 0; step >>= 1) {
+		if (pos + step <= count && tree[pos + step - 1] <= remaining) {
+			pos += step;
+			remaining -= tree[pos - 1];
+		}
+	}
+	// Rounding can run past the last positive weight
+	pos = std::min(pos, count - 1);
+	while (pos > 0 && weights[pos] <= 0.0) {
+		pos--;
+	}
+	return pos;
+}
+
+void ParametricSelectorNative::unregister_library(int p_handle) {
+	if (_checked_library(p_handle, "unregister_library")) {
+		m_libraries[p_handle].reset();
+		m_free_libraries.push_back(p_handle);
+	}
+}
+
+int ParametricSelectorNative::get_library_size(int p_handle) const {
+	const Library *library = _checked_library(p_handle, "get_library_size");
+	return library ? library->candidates.size() : 0;
+}
+
+const ParametricSelectorNative::Library *ParametricSelectorNative::_checked_library(int p_handle, const char *p_method) const {
+	if (p_handle < 0 || p_handle >= static_cast<int>(m_libraries.size()) || !m_libraries[p_handle]) {
+		UtilityFunctions::push_warning("ParametricSelectorNative: Invalid library handle for ", p_method, " ", p_handle);
+		return nullptr;
+	}
+	return m_libraries[p_handle].get();
+}
+
+ParametricSelectorNative::Library *ParametricSelectorNative::_checked_library(int p_handle, const char *p_method) {
+	return const_cast<Library *>(static_cast<const ParametricSelectorNative *>(this)->_checked_library(p_handle, p_method));
+}
+
+bool ParametricSelectorNative::_dense_query(const Library &p_library, const Dictionary &p_vector, Eigen::VectorXf &r_query, float *r_norm) const {
+	const int dims = static_cast<int>(p_library.vectors.cols());
+	r_query.setZero(dims);
+	double norm_sq = 0.0;
+	Array keys = p_vector.keys();
+	for (int k = 0; k < keys.size(); k++) {
+		Variant key = keys[k];
+		double value = p_vector[key];
+		norm_sq += value * value;
+		Variant id = m_key_ids.get(key, Variant());
+		if (id.get_type() == Variant::INT && static_cast<int>(id) < dims) {
+			r_query[static_cast<int>(id)] = static_cast<float>(value);
+		}
+	}
+	if (norm_sq < 1e-9) {
+		return false;
+	}
+	const float norm = static_cast<float>(std::sqrt(norm_sq));
+	r_query /= norm;
+	if (r_norm) {
+		*r_norm = norm;
+	}
+	return true;
+}
+
+bool ParametricSelectorNative::_check_library_metric(int p_metric, const char *p_method) {
+	if (p_metric != METRIC_COSINE && p_metric != METRIC_GAUSSIAN) {
+		UtilityFunctions::push_warning("ParametricSelectorNative: ", p_method, " does not support metric ", p_metric);
+		return false;
+	}
+	return true;
+}
+
+Eigen::VectorXf ParametricSelectorNative::_library_scores(const Library &p_library, const Eigen::VectorXf &p_query) {
+	Eigen::VectorXf scores(p_library.size());
+	simd_kernels().gemv_f32(p_library.vectors.data(), p_library.size(), (int)p_query.size(), p_library.vectors.cols(), p_query.data(), scores.data());
+	return scores;
+}
+
+void ParametricSelectorNative::_gaussian_distances(
+	const Library &p_library,
+	const Eigen::Ref<const Eigen::VectorXf> &p_cosines,
+	float p_query_norm,
+	Eigen::VectorXf &r_dist_sq
+) {
+	// |q|² + |v|² - 2|q||v|cos; zero rows carry +inf in norms_sq
+	const float query_norm_sq = p_query_norm * p_query_norm;
+	const int count = p_library.size();
+	r_dist_sq = p_library.norms_sq.head(count).array() + query_norm_sq -
+			(2.0f * p_query_norm) * p_library.norms.head(count).array() * p_cosines.array();
+	r_dist_sq = r_dist_sq.cwiseMax(0.0f);
+}
+
+Dictionary ParametricSelectorNative::_library_result(const Library &p_library, int p_index, double p_similarity) {
+	Dictionary candidate = p_library.candidates[p_index];
+	Dictionary result = candidate.duplicate();
+	result["similarity"] = p_similarity;
+	result["index"] = p_index;
+	return result;
+}
+
+Dictionary ParametricSelectorNative::library_select_best(int p_handle, const Dictionary &p_vector, int p_metric, const Dictionary &p_params) const {
+	const Library *library = _checked_library(p_handle, "library_select_best");
+	if (!library || library->candidates.is_empty() || !_check_library_metric(p_metric, "library_select_best")) {
+		return Dictionary();
+	}
+
+	// Rows and query are unit vectors: scores are cosines, similarity is cos²
+	// (a zero query scores every candidate 0, so the first one wins as in
+	// select_best)
+	Eigen::VectorXf query;
+	float query_norm = 0.0f;
+	int best = 0;
+	double best_similarity = 0.0;
+	if (!_dense_query(*library, p_vector, query, &query_norm)) {
+		return _library_result(*library, best, best_similarity);
+	}
+
+	if (p_metric == METRIC_GAUSSIAN) {
+		// exp(-d²/2σ²) falls with distance: the nearest row wins
+		const double sigma = p_params.get("sigma", 0.3);
+		Eigen::VectorXf dist_sq;
+		_gaussian_distances(*library, _library_scores(*library, query), query_norm, dist_sq);
+		const double nearest = dist_sq.minCoeff(&best);
+		return _library_result(*library, best, std::exp(-nearest / (2.0 * sigma * sigma)));
+	}
+
+	if (library->index && library->candidates.size() >= ANN_MIN_CANDIDATES) {
+		// Score only the rows the query's buckets hold
+		const Eigen::VectorXf projections = library->index->planes * query;
+		std::vector<int> rows;
+		library->index->gather(projections, rows);
+		if (!rows.empty()) {
+			std::sort(rows.begin(), rows.end());
+			rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+			best = rows.front();
+			best_similarity = -1.0;
+			for (int row : rows) {
+				const float cosine = library->vectors.row(row).dot(query);
+				if (cosine * cosine > best_similarity) {
+					best_similarity = cosine * cosine;
+					best = row;
+				}
+			}
+			return _library_result(*library, best, best_similarity);
+		}
+	}
+
+	const Eigen::VectorXf scores = _library_scores(*library, query);
+	best_similarity = scores.array().square().maxCoeff(&best);
+	return _library_result(*library, best, best_similarity);
+}
+
+// ============================================================================
+// SELECTOR SESSIONS
+// ============================================================================
+
+int ParametricSelectorNative::create_selector_session(int p_library, int p_metric, const Dictionary &p_params) {
+	if (!_checked_library(p_library, "create_selector_session") || !_check_library_metric(p_metric, "create_selector_session")) {
+		return -1;
+	}
+	auto session = std::make_unique<SelectorSession>();
+	session->library = p_library;
+	session->metric = p_metric;
+	session->sigma = p_params.get("sigma", 0.3);
+	return store_handle(m_sessions, m_free_sessions, std::move(session));
+}
+
+void ParametricSelectorNative::release_selector_session(int p_session) {
+	if (_checked_session(p_session, "release_selector_session")) {
+		m_sessions[p_session].reset();
+		m_free_sessions.push_back(p_session);
+	}
+}
+
+const ParametricSelectorNative::SelectorSession *ParametricSelectorNative::_checked_session(int p_handle, const char *p_method) const {
+	if (p_handle < 0 || p_handle >= static_cast<int>(m_sessions.size()) || !m_sessions[p_handle]) {
+		UtilityFunctions::push_warning("ParametricSelectorNative: Invalid selector session handle for ", p_method, " ", p_handle);
+		return nullptr;
+	}
+	return m_sessions[p_handle].get();
+}
+
+ParametricSelectorNative::SelectorSession *ParametricSelectorNative::_checked_session(int p_handle, const char *p_method) {
+	return const_cast<SelectorSession *>(static_cast<const ParametricSelectorNative *>(this)->_checked_session(p_handle, p_method));
+}
+
+Dictionary ParametricSelectorNative::get_session_stats(int p_session) const {
+	Dictionary stats;
+	const SelectorSession *session = _checked_session(p_session, "get_session_stats");
+	if (session) {
+		stats["queries"] = session->queries;
+		stats["rescored"] = session->rescored;
+	}
+	return stats;
+}
+
+Dictionary ParametricSelectorNative::session_select_best(int p_session, const Dictionary &p_vector) {
+	SelectorSession *session = _checked_session(p_session, "session_select_best");
+	if (!session) {
+		return Dictionary();
+	}
+	const Library *library = _checked_library(session->library, "session_select_best");
+	if (!library || library->candidates.is_empty()) {
+		session->winner = -1;
+		return Dictionary();
+	}
+	session->queries++;
+
+	Eigen::VectorXf query;
+	float query_norm = 0.0f;
+	if (!_dense_query(*library, p_vector, query, &query_norm)) {
+		// Zero query: the first candidate, as library_select_best
+		session->winner = -1;
+		return _library_result(*library, 0, 0.0);
+	}
+
+	// Gaussian distances live in the unnormalized space; the keys without
+	// a column add one more coordinate, zero for every row
+	const bool gaussian = session->metric == METRIC_GAUSSIAN;
+	const double two_sigma_sq = 2.0 * session->sigma * session->sigma;
+	Eigen::VectorXf point;
+	float point_rest = 0.0f;
+	if (gaussian) {
+		point = query * query_norm;
+		point_rest = std::sqrt(std::max(0.0f, 1.0f - query.squaredNorm())) * query_norm;
+	}
+	const Eigen::VectorXf &position = gaussian ? point : query;
+
+	if (session->winner >= 0 && session->library_version == library->version) {
+		float drift_sq = (position - session->query).squaredNorm();
+		if (gaussian) {
+			drift_sq += (point_rest - session->query_rest) * (point_rest - session->query_rest);
+		}
+		if (drift_sq < session->radius * session->radius) {
+			const int winner = session->winner;
+			const double cosine = library->vectors.row(winner).dot(query);
+			if (!gaussian) {
+				return _library_result(*library, winner, cosine * cosine);
+			}
+			const double dist_sq = std::max(0.0, library->norms_sq[winner] + static_cast<double>(query_norm) * query_norm -
+					2.0 * query_norm * library->norms[winner] * cosine);
+			return _library_result(*library, winner, std::exp(-dist_sq / two_sigma_sq));
+		}
+	}
+
+	// Full rescore: the winner as library_select_best's exact scan, and its
+	// margin over the runner-up
+	session->rescored++;
+	const Eigen::VectorXf scores = _library_scores(*library, query);
+	const int count = library->size();
+	int best = 0;
+	double best_similarity = 0.0;
+	float radius = std::numeric_limits<float>::infinity();
+	if (gaussian) {
+		Eigen::VectorXf dist_sq;
+		_gaussian_distances(*library, scores, query_norm, dist_sq);
+		const double nearest = dist_sq.minCoeff(&best);
+		best_similarity = std::exp(-nearest / two_sigma_sq);
+		int runner = -1;
+		for (int i = 0; i < count; i++) {
+			if (i != best && (runner < 0 || dist_sq[i] < dist_sq[runner])) {
+				runner = i;
+			}
+		}
+		// The two distances that set the margin are recomputed directly: the
+		// |q|² + |v|² - 2|q||v|cos form loses precision near zero
+		auto distance = [&](int p_row) {
+			if (library->norms[p_row] == 0.0f) {
+				return std::numeric_limits<float>::infinity();
+			}
+			const float off_row = (point - library->norms[p_row] * library->vectors.row(p_row).transpose()).squaredNorm();
+			return std::sqrt(off_row + point_rest * point_rest);
+		};
+		const float best_distance = distance(best);
+		if (!std::isfinite(best_distance)) {
+			radius = 0.0f;  // Every row is zero: nothing to hold on to
+		} else if (runner >= 0) {
+			radius = 0.5f * (distance(runner) - best_distance) - SESSION_SLACK * (1.0f + query_norm + library->norms[best]);
+		}
+	} else {
+		const Eigen::VectorXf magnitudes = scores.cwiseAbs();
+		const float top = magnitudes.maxCoeff(&best);
+		best_similarity = top * top;
+		float runner_up = -1.0f;
+		for (int i = 0; i < count; i++) {
+			if (i != best) {
+				runner_up = std::max(runner_up, magnitudes[i]);
+			}
+		}
+		if (runner_up >= 0.0f) {
+			radius = 0.5f * (magnitudes[best] - runner_up) - SESSION_SLACK;
+		}
+	}
+
+	session->library_version = library->version;
+	session->winner = best;
+	session->query = position;
+	session->query_rest = point_rest;
+	session->radius = std::max(0.0f, radius);
+	return _library_result(*library, best, best_similarity);
+}
+
+// ============================================================================
+// LSH INDEX
+// ============================================================================
+
+uint32_t ParametricSelectorNative::LshIndex::hash(const Eigen::VectorXf &p_projections, int p_table) const {
+	uint32_t code = 0;
+	for (int b = 0; b < bits; b++) {
+		if (p_projections[p_table * bits + b] >= 0.0f) {
+			code |= 1u << b;
+		}
+	}
+	return code;
+}
+
+void ParametricSelectorNative::LshIndex::insert(int p_row, const Eigen::VectorXf &p_projections) {
+	for (int t = 0; t < tables; t++) {
+		buckets[t][hash(p_projections, t)].push_back(p_row);
+	}
+}
+
+void ParametricSelectorNative::LshIndex::erase(int p_row, const Eigen::VectorXf &p_projections) {
+	for (int t = 0; t < tables; t++) {
+		auto it = buckets[t].find(hash(p_projections, t));
+		if (it == buckets[t].end()) {
+			continue;
+		}
+		std::vector<int> &rows = it->second;
+		auto row = std::find(rows.begin(), rows.end(), p_row);
+		if (row != rows.end()) {
+			*row = rows.back();
+			rows.pop_back();
+		}
+		if (rows.empty()) {
+			buckets[t].erase(it);
+		}
+	}
+}
+
+void ParametricSelectorNative::LshIndex::gather(const Eigen::VectorXf &p_projections, std::vector<int> &r_rows) const {
+	const uint32_t mask = bits >= 32 ? 0xFFFFFFFFu : ((1u << bits) - 1u);
+	std::vector<int> order(bits);
+	for (int t = 0; t < tables; t++) {
+		const uint32_t code = hash(p_projections, t);
+
+		// Base bucket, then single-bit flips from the least certain bit up
+		std::iota(order.begin(), order.end(), 0);
+		const float *proj = p_projections.data() + t * bits;
+		std::sort(order.begin(), order.end(), [proj](int a, int b) { return std::abs(proj[a]) < std::abs(proj[b]); });
+		for (int probe = 0; probe <= std::min(probes, bits); probe++) {
+			const uint32_t probe_code = probe == 0 ? code : (code ^ (1u << order[probe - 1]));
+			// -query lands in the complementary bucket
+			for (uint32_t bucket : { probe_code, ~probe_code & mask }) {
+				auto it = buckets[t].find(bucket);
+				if (it != buckets[t].end()) {
+					r_rows.insert(r_rows.end(), it->second.begin(), it->second.end());
+				}
+			}
+		}
+	}
+}
+
+void ParametricSelectorNative::library_build_index(int p_handle, int p_tables, int p_bits, int p_probes, int p_seed) {
+	if (!_checked_library(p_handle, "library_build_index")) {
+		return;
+	}
+	Library &library = *m_libraries[p_handle];
+	auto index = std::make_unique<LshIndex>();
+	index->tables = std::max(1, p_tables);
+	index->bits = std::max(1, std::min(p_bits, 30));
+	index->probes = std::max(0, p_probes);
+	index->buckets.resize(index->tables);
+
+	// Gaussian hyperplanes: sign(plane · v) is an LSH for angle
+	index->rng.seed(static_cast<uint32_t>(p_seed));
+	std::normal_distribution<float> normal(0.0f, 1.0f);
+	index->planes.resize(index->tables * index->bits, library.vectors.cols());
+	for (int i = 0; i < index->planes.size(); i++) {
+		index->planes.data()[i] = normal(index->rng);
+	}
+
+	const Eigen::MatrixXf projections = index->planes * library.rows().transpose();
+	for (int row = 0; row < library.size(); row++) {
+		index->insert(row, projections.col(row));
+	}
+	library.index = std::move(index);
+}
+
+void ParametricSelectorNative::library_clear_index(int p_handle) {
+	if (_checked_library(p_handle, "library_clear_index")) {
+		m_libraries[p_handle]->index.reset();
+	}
+}
+
+Array ParametricSelectorNative::library_select_top_k(int p_handle, const Dictionary &p_vector, int p_k, int p_metric, const Dictionary &p_params) const {
+	Array results;
+	const Library *library = _checked_library(p_handle, "library_select_top_k");
+	if (!library || library->candidates.is_empty() || !_check_library_metric(p_metric, "library_select_top_k")) {
+		return results;
+	}
+
+	// Gaussian ranks by -d² (-inf, i.e. similarity 0, for a zero query)
+	const bool gaussian = p_metric == METRIC_GAUSSIAN;
+	std::vector<double> scores(library->candidates.size(), gaussian ? -std::numeric_limits<double>::infinity() : 0.0);
+	Eigen::VectorXf query;
+	float query_norm = 0.0f;
+	if (_dense_query(*library, p_vector, query, &query_norm)) {
+		const Eigen::VectorXf cosines = _library_scores(*library, query);
+		if (gaussian) {
+			Eigen::VectorXf dist_sq;
+			_gaussian_distances(*library, cosines, query_norm, dist_sq);
+			for (int i = 0; i < dist_sq.size(); i++) {
+				scores[i] = -dist_sq[i];
+			}
+		} else {
+			for (int i = 0; i < cosines.size(); i++) {
+				scores[i] = cosines[i] * cosines[i];
+			}
+		}
+	}
+
+	const double sigma = gaussian ? static_cast<double>(p_params.get("sigma", 0.3)) : 1.0;
+	for (int index : _top_k_indices(scores, p_k)) {
+		const double similarity = gaussian ? std::exp(scores[index] / (2.0 * sigma * sigma)) : scores[index];
+		results.append(_library_result(*library, index, similarity));
+	}
+	return results;
+}
+
+Dictionary ParametricSelectorNative::select_best_batch(const Array &p_queries, int p_handle, int p_metric, const Dictionary &p_params) const {
+	Dictionary result;
+	const Library *library = _checked_library(p_handle, "select_best_batch");
+	if (!library || !_check_library_metric(p_metric, "select_best_batch")) {
+		return result;
+	}
+
+	const int num_queries = p_queries.size();
+	PackedInt32Array indices;
+	PackedFloat64Array similarities;
+	indices.resize(num_queries);
+	similarities.resize(num_queries);
+	indices.fill(library->candidates.is_empty() ? -1 : 0);
+	similarities.fill(0.0);
+	if (library->candidates.is_empty() || num_queries == 0) {
+		result["indices"] = indices;
+		result["similarities"] = similarities;
+		return result;
+	}
+
+	// Dictionary reads stay on this thread: one normalized column per query
+	// (zero for a zero query, which then keeps index 0 / similarity 0)
+	Eigen::MatrixXf queries = Eigen::MatrixXf::Zero(library->vectors.cols(), num_queries);
+	std::vector<float> query_norms(num_queries, 0.0f);
+	Eigen::VectorXf query;
+	for (int q = 0; q < num_queries; q++) {
+		if (_dense_query(*library, p_queries[q], query, &query_norms[q])) {
+			queries.col(q) = query;
+		}
+	}
+
+	const bool gaussian = p_metric == METRIC_GAUSSIAN;
+	const double sigma = gaussian ? static_cast<double>(p_params.get("sigma", 0.3)) : 1.0;
+	int32_t *best_index = indices.ptrw();
+	double *best_similarity = similarities.ptrw();
+	const int num_blocks = (num_queries + QUERY_BLOCK - 1) / QUERY_BLOCK;
+	NativeThreadPool::shared().parallel_for(0, num_blocks, 0, [&](int begin, int end) {
+		Eigen::MatrixXf scores;
+		Eigen::VectorXf dist_sq;
+		for (int block = begin; block < end; block++) {
+			const int first = block * QUERY_BLOCK;
+			const int width = std::min(QUERY_BLOCK, num_queries - first);
+			scores.noalias() = library->rows() * queries.middleCols(first, width);
+			for (int j = 0; j < width; j++) {
+				if (query_norms[first + j] == 0.0f) {
+					continue;  // Zero query keeps index 0 / similarity 0
+				}
+				int best = 0;
+				if (gaussian) {
+					_gaussian_distances(*library, scores.col(j), query_norms[first + j], dist_sq);
+					const double nearest = dist_sq.minCoeff(&best);
+					best_similarity[first + j] = std::exp(-nearest / (2.0 * sigma * sigma));
+				} else {
+					best_similarity[first + j] = scores.col(j).array().square().maxCoeff(&best);
+				}
+				best_index[first + j] = best;
+			}
+		}
+	});
+
+	result["indices"] = indices;
+	result["similarities"] = similarities;
+	return result;
+}
+
+// ============================================================================
+// SPARSE VECTORS
+// ============================================================================
+
+int ParametricSelectorNative::create_sparse_vector(const Dictionary &p_vector) {
+	auto vector = std::make_unique<SparseVector>();
+	std::vector<std::pair<int, float>> entries;
+	Array keys = p_vector.keys();
+	entries.reserve(keys.size());
+	for (int k = 0; k < keys.size(); k++) {
+		Variant key = keys[k];
+		double value = p_vector[key];
+		entries.emplace_back(_intern_key(key), static_cast<float>(value));
+		vector->norm_sq += value * value;
+	}
+	std::sort(entries.begin(), entries.end());
+	vector->ids.reserve(entries.size());
+	vector->values.reserve(entries.size());
+	for (const std::pair<int, float> &entry : entries) {
+		vector->ids.push_back(entry.first);
+		vector->values.push_back(entry.second);
+	}
+	return store_handle(m_sparse_vectors, m_free_sparse_vectors, std::move(vector));
+}
+
+void ParametricSelectorNative::release_sparse_vector(int p_handle) {
+	if (_checked_sparse(p_handle, "release_sparse_vector")) {
+		m_sparse_vectors[p_handle].reset();
+		m_free_sparse_vectors.push_back(p_handle);
+	}
+}
+
+const ParametricSelectorNative::SparseVector *ParametricSelectorNative::_checked_sparse(int p_handle, const char *p_method) const {
+	if (p_handle < 0 || p_handle >= static_cast<int>(m_sparse_vectors.size()) || !m_sparse_vectors[p_handle]) {
+		UtilityFunctions::push_warning("ParametricSelectorNative: Invalid sparse vector handle for ", p_method, " ", p_handle);
+		return nullptr;
+	}
+	return m_sparse_vectors[p_handle].get();
+}
+
+void ParametricSelectorNative::set_connection_weights(const Dictionary &p_weights) {
+	m_connections.clear();
+	Array sources = p_weights.keys();
+	for (int i = 0; i < sources.size(); i++) {
+		Variant connections_var = p_weights[sources[i]];
+		if (connections_var.get_type() != Variant::DICTIONARY) {
+			continue;
+		}
+		const int source = _intern_key(sources[i]);
+		if (source >= static_cast<int>(m_connections.size())) {
+			m_connections.resize(source + 1);
+		}
+		std::vector<std::pair<int, float>> &row = m_connections[source];
+		Dictionary connections = connections_var;
+		Array targets = connections.keys();
+		for (int j = 0; j < targets.size(); j++) {
+			Variant conn_data = connections[targets[j]];
+			double weight = 0.0;
+			if (conn_data.get_type() == Variant::DICTIONARY) {
+				Dictionary conn_dict = conn_data;
+				weight = conn_dict.get("weight", 0.0);
+			} else {
+				weight = conn_data;
+			}
+			row.emplace_back(_intern_key(targets[j]), static_cast<float>(weight));
+		}
+		std::sort(row.begin(), row.end());
+	}
+}
+
+double ParametricSelectorNative::_sparse_dot(const SparseVector &p_a, const SparseVector &p_b) {
+	double dot = 0.0;
+	size_t i = 0;
+	size_t j = 0;
+	while (i < p_a.ids.size() && j < p_b.ids.size()) {
+		if (p_a.ids[i] < p_b.ids[j]) {
+			i++;
+		} else if (p_b.ids[j] < p_a.ids[i]) {
+			j++;
+		} else {
+			dot += static_cast<double>(p_a.values[i++]) * p_b.values[j++];
+		}
+	}
+	return dot;
+}
+
+double ParametricSelectorNative::_sparse_connection(const SparseVector &p_a, const SparseVector &p_b) const {
+	// Mean weight over (a key, b key) pairs with a connection, as
+	// _connection_similarity
+	double total_weight = 0.0;
+	int connection_count = 0;
+	for (int source : p_a.ids) {
+		if (source >= static_cast<int>(m_connections.size())) {
+			break;  // Ids ascend: no later key has connections either
+		}
+		const std::vector<std::pair<int, float>> &row = m_connections[source];
+		size_t r = 0;
+		size_t j = 0;
+		while (r < row.size() && j < p_b.ids.size()) {
+			if (row[r].first < p_b.ids[j]) {
+				r++;
+			} else if (p_b.ids[j] < row[r].first) {
+				j++;
+			} else {
+				total_weight += row[r++].second;
+				connection_count++;
+				j++;
+			}
+		}
+	}
+	return connection_count > 0 ? total_weight / static_cast<double>(connection_count) : 0.0;
+}
+
+double ParametricSelectorNative::sparse_similarity(int p_a, int p_b, int p_metric, const Dictionary &p_params) const {
+	const SparseVector *a = _checked_sparse(p_a, "sparse_similarity");
+	const SparseVector *b = _checked_sparse(p_b, "sparse_similarity");
+	if (!a || !b) {
+		return 0.0;
+	}
+
+	switch (p_metric) {
+		case METRIC_COSINE: {
+			if (a->ids.empty() || b->ids.empty() || a->norm_sq < 1e-9 || b->norm_sq < 1e-9) {
+				return 0.0;
+			}
+			const double cos_theta = _sparse_dot(*a, *b) / std::sqrt(a->norm_sq * b->norm_sq);
+			return cos_theta * cos_theta;
+		}
+
+		case METRIC_CONNECTION:
+			if (a->ids.empty() || b->ids.empty()) {
+				return 0.0;
+			}
+			return _sparse_connection(*a, *b);
+
+		case METRIC_LOGARITHMIC: {
+			double total_weight = 0.0;
+			for (float amount : a->values) {
+				if (amount > 0.0f) {
+					total_weight += 1.0 + std::log(1.0 + amount) / 3.0;
+				}
+			}
+			return total_weight;
+		}
+
+		case METRIC_GAUSSIAN: {
+			if (a->ids.empty() || b->ids.empty()) {
+				return 0.0;
+			}
+			// ||a - b||² over the key union = ||a||² + ||b||² - 2 a·b
+			const double sigma = p_params.get("sigma", 0.3);
+			const double dist_sq = std::max(0.0, a->norm_sq + b->norm_sq - 2.0 * _sparse_dot(*a, *b));
+			return std::exp(-dist_sq / (2.0 * sigma * sigma));
+		}
+
+		default:
+			UtilityFunctions::push_error("ParametricSelectorNative: Unknown metric " + String::num_int64(p_metric));
+			return 0.0;
+	}
+}
+
+// ============================================================================
+// ALIAS TABLES (WEIGHTED SAMPLING)
+// ============================================================================
+
+void ParametricSelectorNative::AliasTable::build(const std::vector<double> &p_weights) {
+	const int count = static_cast<int>(p_weights.size());
+	double total = 0.0;
+	for (double weight : p_weights) {
+		total += std::max(weight, 0.0);
+	}
+	prob.clear();
+	alias.clear();
+	if (count == 0 || total < 1e-9) {
+		return;  // Nothing to draw (same cut-off as select_weighted_random)
+	}
+
+	// Vose: scale weights to mean 1, pair each under-full bucket with an
+	// over-full one that tops it up
+	prob.resize(count);
+	alias.resize(count);
+	std::vector<double> scaled(count);
+	std::vector<int> small;
+	std::vector<int> large;
+	for (int i = 0; i < count; i++) {
+		scaled[i] = std::max(p_weights[i], 0.0) * count / total;
+		(scaled[i] < 1.0 ? small : large).push_back(i);
+	}
+	while (!small.empty() && !large.empty()) {
+		const int s = small.back();
+		small.pop_back();
+		const int l = large.back();
+		prob[s] = scaled[s];
+		alias[s] = l;
+		scaled[l] -= 1.0 - scaled[s];
+		if (scaled[l] < 1.0) {
+			large.pop_back();
+			small.push_back(l);
+		}
+	}
+	// Leftovers are full up to rounding
+	for (int i : large) {
+		prob[i] = 1.0;
+		alias[i] = i;
+	}
+	for (int i : small) {
+		prob[i] = 1.0;
+		alias[i] = i;
+	}
+}
+
+int ParametricSelectorNative::build_alias_table(const Array &p_candidates) {
+	std::vector<double> weights(p_candidates.size());
+	for (int i = 0; i < p_candidates.size(); i++) {
+		Dictionary candidate = p_candidates[i];
+		weights[i] = candidate.get("weight", 0.0);
+	}
+	auto table = std::make_unique<AliasTable>();
+	table->build(weights);
+	return store_handle(m_alias_tables, m_free_alias_tables, std::move(table));
+}
+
+void ParametricSelectorNative::release_alias_table(int p_handle) {
+	if (p_handle < 0 || p_handle >= static_cast<int>(m_alias_tables.size()) || !m_alias_tables[p_handle]) {
+		UtilityFunctions::push_warning("ParametricSelectorNative: Invalid alias table handle for release_alias_table ", p_handle);
+		return;
+	}
+	m_alias_tables[p_handle].reset();
+	m_free_alias_tables.push_back(p_handle);
+}
+
+PackedInt32Array ParametricSelectorNative::sample(int p_handle, int p_count) {
+	PackedInt32Array indices;
+	if (p_handle < 0 || p_handle >= static_cast<int>(m_alias_tables.size()) || !m_alias_tables[p_handle]) {
+		UtilityFunctions::push_warning("ParametricSelectorNative: Invalid alias table handle for sample ", p_handle);
+		return indices;
+	}
+	const AliasTable &table = *m_alias_tables[p_handle];
+	if (table.prob.empty() || p_count <= 0) {
+		return indices;
+	}
+
+	// One bucket pick and one coin per draw
+	const uint32_t buckets = static_cast<uint32_t>(table.prob.size());
+	indices.resize(p_count);
+	int32_t *out = indices.ptrw();
+	for (int i = 0; i < p_count; i++) {
+		const int b = static_cast<int>(m_rng.next_below(buckets));
+		out[i] = m_rng.next_double() < table.prob[b] ? b : table.alias[b];
+	}
+	return indices;
+}
+
 // ============================================================================
 // HELPER FUNCTIONS
 // ============================================================================
@@ -458,18 +1540,53 @@ void ParametricSelectorNative::_bind_methods() {
 	BIND_ENUM_CONSTANT(METRIC_GAUSSIAN);
 
 	// Main API
-	ClassDB::bind_static_method("ParametricSelectorNative", D_METHOD("compute_similarity", "vector1", "vector2", "metric", "params"), &ParametricSelectorNative::compute_similarity);
-	ClassDB::bind_static_method("ParametricSelectorNative", D_METHOD("select_best", "vector", "candidates", "metric", "params"), &ParametricSelectorNative::select_best);
-	ClassDB::bind_static_method("ParametricSelectorNative", D_METHOD("select_top_k", "vector", "candidates", "metric", "k", "params"), &ParametricSelectorNative::select_top_k);
-	ClassDB::bind_static_method("ParametricSelectorNative", D_METHOD("select_weighted_random", "candidates"), &ParametricSelectorNative::select_weighted_random);
-	ClassDB::bind_static_method("ParametricSelectorNative", D_METHOD("select_weighted_random_full", "candidates"), &ParametricSelectorNative::select_weighted_random_full);
+	BIND_TIMED_STATIC_METHOD("ParametricSelectorNative", D_METHOD("compute_similarity", "vector1", "vector2", "metric", "params"), &ParametricSelectorNative::compute_similarity);
+	BIND_TIMED_STATIC_METHOD("ParametricSelectorNative", D_METHOD("select_best", "vector", "candidates", "metric", "params"), &ParametricSelectorNative::select_best);
+	BIND_TIMED_STATIC_METHOD("ParametricSelectorNative", D_METHOD("select_top_k", "vector", "candidates", "metric", "k", "params"), &ParametricSelectorNative::select_top_k);
+	BIND_TIMED_STATIC_METHOD("ParametricSelectorNative", D_METHOD("select_weighted_random", "candidates"), &ParametricSelectorNative::select_weighted_random);
+	BIND_TIMED_STATIC_METHOD("ParametricSelectorNative", D_METHOD("select_weighted_random_full", "candidates"), &ParametricSelectorNative::select_weighted_random_full);
+
+	// Registered libraries
+	BIND_TIMED_METHOD(D_METHOD("register_library", "candidates"), &ParametricSelectorNative::register_library);
+	BIND_TIMED_METHOD(D_METHOD("unregister_library", "handle"), &ParametricSelectorNative::unregister_library);
+	BIND_TIMED_METHOD(D_METHOD("get_library_size", "handle"), &ParametricSelectorNative::get_library_size);
+	BIND_TIMED_METHOD(D_METHOD("library_select_best", "handle", "vector", "metric", "params"), &ParametricSelectorNative::library_select_best, DEFVAL(METRIC_COSINE), DEFVAL(Dictionary()));
+	BIND_TIMED_METHOD(D_METHOD("library_select_top_k", "handle", "vector", "k", "metric", "params"), &ParametricSelectorNative::library_select_top_k, DEFVAL(METRIC_COSINE), DEFVAL(Dictionary()));
+	BIND_TIMED_METHOD(D_METHOD("select_best_batch", "queries", "library_handle", "metric", "params"), &ParametricSelectorNative::select_best_batch, DEFVAL(Dictionary()));
+	BIND_TIMED_METHOD(D_METHOD("library_add", "handle", "candidate"), &ParametricSelectorNative::library_add);
+	BIND_TIMED_METHOD(D_METHOD("library_remove", "handle", "index"), &ParametricSelectorNative::library_remove);
+	BIND_TIMED_METHOD(D_METHOD("library_update_weight", "handle", "index", "weight"), &ParametricSelectorNative::library_update_weight);
+	BIND_TIMED_METHOD(D_METHOD("library_sample", "handle", "count"), &ParametricSelectorNative::library_sample);
+	BIND_TIMED_METHOD(D_METHOD("library_build_index", "handle", "tables", "bits", "probes", "seed"), &ParametricSelectorNative::library_build_index, DEFVAL(8), DEFVAL(12), DEFVAL(2), DEFVAL(1));
+	BIND_TIMED_METHOD(D_METHOD("library_clear_index", "handle"), &ParametricSelectorNative::library_clear_index);
+
+	// Selector sessions
+	BIND_TIMED_METHOD(D_METHOD("create_selector_session", "library_handle", "metric", "params"), &ParametricSelectorNative::create_selector_session, DEFVAL(METRIC_COSINE), DEFVAL(Dictionary()));
+	BIND_TIMED_METHOD(D_METHOD("release_selector_session", "session"), &ParametricSelectorNative::release_selector_session);
+	BIND_TIMED_METHOD(D_METHOD("session_select_best", "session", "vector"), &ParametricSelectorNative::session_select_best);
+	BIND_TIMED_METHOD(D_METHOD("get_session_stats", "session"), &ParametricSelectorNative::get_session_stats);
+
+	// Sparse vectors
+	BIND_TIMED_METHOD(D_METHOD("create_sparse_vector", "vector"), &ParametricSelectorNative::create_sparse_vector);
+	BIND_TIMED_METHOD(D_METHOD("release_sparse_vector", "handle"), &ParametricSelectorNative::release_sparse_vector);
+	BIND_TIMED_METHOD(D_METHOD("sparse_similarity", "a", "b", "metric", "params"), &ParametricSelectorNative::sparse_similarity, DEFVAL(Dictionary()));
+	BIND_TIMED_METHOD(D_METHOD("set_connection_weights", "weights"), &ParametricSelectorNative::set_connection_weights);
+
+	// Alias-table weighted sampling
+	BIND_TIMED_METHOD(D_METHOD("build_alias_table", "candidates"), &ParametricSelectorNative::build_alias_table);
+	BIND_TIMED_METHOD(D_METHOD("release_alias_table", "handle"), &ParametricSelectorNative::release_alias_table);
+	BIND_TIMED_METHOD(D_METHOD("sample", "handle", "count"), &ParametricSelectorNative::sample);
+
+	// RNG streams
+	BIND_TIMED_STATIC_METHOD("ParametricSelectorNative", D_METHOD("seed_thread_rng", "seed"), &ParametricSelectorNative::seed_thread_rng);
+	BIND_TIMED_METHOD(D_METHOD("set_seed", "seed"), &ParametricSelectorNative::set_seed);
 
 	// Helpers
-	ClassDB::bind_static_method("ParametricSelectorNative", D_METHOD("normalize", "vector"), &ParametricSelectorNative::normalize);
-	ClassDB::bind_static_method("ParametricSelectorNative", D_METHOD("magnitude", "vector"), &ParametricSelectorNative::magnitude);
-	ClassDB::bind_static_method("ParametricSelectorNative", D_METHOD("dot_product", "v1", "v2"), &ParametricSelectorNative::dot_product);
-	ClassDB::bind_static_method("ParametricSelectorNative", D_METHOD("logarithmic_weight", "amount"), &ParametricSelectorNative::logarithmic_weight);
-	ClassDB::bind_static_method("ParametricSelectorNative", D_METHOD("gaussian_match_1d", "preference", "actual", "sigma"), &ParametricSelectorNative::gaussian_match_1d);
+	BIND_TIMED_STATIC_METHOD("ParametricSelectorNative", D_METHOD("normalize", "vector"), &ParametricSelectorNative::normalize);
+	BIND_TIMED_STATIC_METHOD("ParametricSelectorNative", D_METHOD("magnitude", "vector"), &ParametricSelectorNative::magnitude);
+	BIND_TIMED_STATIC_METHOD("ParametricSelectorNative", D_METHOD("dot_product", "v1", "v2"), &ParametricSelectorNative::dot_product);
+	BIND_TIMED_STATIC_METHOD("ParametricSelectorNative", D_METHOD("logarithmic_weight", "amount"), &ParametricSelectorNative::logarithmic_weight);
+	BIND_TIMED_STATIC_METHOD("ParametricSelectorNative", D_METHOD("gaussian_match_1d", "preference", "actual", "sigma"), &ParametricSelectorNative::gaussian_match_1d);
 }
 
 } // namespace godot
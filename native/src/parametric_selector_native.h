@@ -6,10 +6,39 @@
 #include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/string.hpp>
 #include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+
+#include "latency_histograms.h"
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
 
 namespace godot {
 
-class ParametricSelectorNative : public RefCounted {
+/**
+ * SelectorRng - xoshiro256** stream (seeded through SplitMix64)
+ *
+ * Small, fast and fully determined by its seed, so a replay that seeds the
+ * same way draws the same selections. Not thread-safe: each instance (and,
+ * for the static API, each thread) owns one.
+ */
+struct SelectorRng {
+	uint64_t state[4];
+
+	explicit SelectorRng(uint64_t p_seed = 0) { seed(p_seed); }
+	void seed(uint64_t p_seed);
+	uint64_t next();
+	// Uniform in [0, 1) with 53 random bits
+	double next_double() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+	// Uniform in [0, p_bound) by multiply-shift (bias < p_bound / 2^32)
+	uint32_t next_below(uint32_t p_bound) { return static_cast<uint32_t>(((next() >> 32) * p_bound) >> 32); }
+};
+
+class ParametricSelectorNative : public RefCounted, public LatencyTracked<ParametricSelectorNative> {
 	GDCLASS(ParametricSelectorNative, RefCounted);
 
 public:
@@ -50,9 +79,16 @@ public:
 		const Dictionary &p_params
 	);
 
+	// Static draws use the calling thread's stream (seeded from
+	// random_device on first use unless seed_thread_rng was called)
 	static String select_weighted_random(const Array &p_candidates);
 	static Dictionary select_weighted_random_full(const Array &p_candidates);
 
+	// Reseed the calling thread's stream for the static API
+	static void seed_thread_rng(int64_t p_seed);
+	// Reseed this instance's stream (used by sample)
+	void set_seed(int64_t p_seed);
+
 	// Helpers
 	static Dictionary normalize(const Dictionary &p_vector);
 	static double magnitude(const Dictionary &p_vector);
@@ -60,12 +96,239 @@ public:
 	static double logarithmic_weight(double p_amount);
 	static double gaussian_match_1d(double p_preference, double p_actual, double p_sigma);
 
+	// Registered libraries (stateful mode). register_library() interns the
+	// candidates' vector keys into this instance's vocabulary and stores every
+	// candidate vector as one row of a dense float matrix, normalized, so a
+	// cosine query is one matrix-vector product plus an argmax instead of
+	// per-candidate Dictionary work. Handles stay valid until
+	// unregister_library; the candidate Dictionaries are shared, not copied.
+	int register_library(const Array &p_candidates);
+	void unregister_library(int p_handle);
+	int get_library_size(int p_handle) const;
+	// Best match under METRIC_COSINE or METRIC_GAUSSIAN (similarities as
+	// compute_similarity; p_params is read for "sigma"): the candidate
+	// Dictionary plus "similarity" and "index"; empty for an empty library.
+	// Gaussian ranks by ||q - v||² = |q|² + |v|² - 2|q||v|cos from the same
+	// matrix product as cosine, and only the winners go through exp.
+	Dictionary library_select_best(int p_handle, const Dictionary &p_vector, int p_metric = METRIC_COSINE, const Dictionary &p_params = Dictionary()) const;
+	// The k best (all if k <= 0), best first, same entries as library_select_best
+	Array library_select_top_k(int p_handle, const Dictionary &p_vector, int p_k, int p_metric = METRIC_COSINE, const Dictionary &p_params = Dictionary()) const;
+	// Best candidate for each query Dictionary in one call: {"indices":
+	// PackedInt32Array, "similarities": PackedFloat64Array}, one entry per
+	// query (-1 / 0.0 for an empty library). Scored as a blocked float
+	// matrix-matrix product, query blocks spread over the native thread pool.
+	// Supports METRIC_COSINE and METRIC_GAUSSIAN.
+	Dictionary select_best_batch(const Array &p_queries, int p_handle, int p_metric, const Dictionary &p_params = Dictionary()) const;
+
+	// Incremental edits, each O(dims) amortized plus O(log n) for the weight
+	// tree (and O(tables * bits * dims) when an index is built, to rehash the
+	// rows involved). library_add appends the candidate (its new keys widen
+	// the library, with spare capacity) and returns its index;
+	// library_remove moves the last candidate into the removed index.
+	int library_add(int p_handle, const Dictionary &p_candidate);
+	void library_remove(int p_handle, int p_index);
+	// Sets the candidate's "weight" (in the shared Dictionary too)
+	void library_update_weight(int p_handle, int p_index, double p_weight);
+	// count candidate indices drawn by "weight", as select_weighted_random
+	// (O(log n) each, kept current by the edits above); empty if every
+	// weight is zero
+	PackedInt32Array library_sample(int p_handle, int p_count);
+
+	// Approximate nearest-neighbour index for library_select_best (cosine):
+	// random-hyperplane LSH with p_tables hash tables of p_bits sign bits
+	// each. A query scores only candidates sharing a bucket with it (or with
+	// its negation, since cos² ranks v and -v alike) in some table, plus
+	// p_probes extra buckets per table reached by flipping its least certain
+	// bits. More tables / probes = better recall, slower queries. Libraries
+	// under 256 candidates, and queries whose buckets are all empty, use the
+	// exact scan. Gaussian queries always use the exact scan. Deterministic
+	// for a given p_seed.
+	void library_build_index(int p_handle, int p_tables = 8, int p_bits = 12, int p_probes = 2, int p_seed = 1);
+	void library_clear_index(int p_handle);
+
+	// Selector sessions: library_select_best for a query that drifts slowly
+	// from call to call (music layers re-querying a near-constant mood
+	// vector every frame). Each rescore also keeps the winner's margin over
+	// the runner-up; rows are unit vectors, so moving the query by δ moves
+	// every cosine (gaussian: every distance) by at most δ, and while the
+	// query stays within half the margin of the last rescored one the
+	// cached winner is returned with only its own similarity recomputed.
+	// Rescores are always the exact scan (the margin needs every score).
+	// Library edits (add / remove) force a rescore; p_params ("sigma") is
+	// fixed per session.
+	int create_selector_session(int p_library, int p_metric = METRIC_COSINE, const Dictionary &p_params = Dictionary());
+	void release_selector_session(int p_session);
+	// Same result as library_select_best on the session's library
+	Dictionary session_select_best(int p_session, const Dictionary &p_vector);
+	// {"queries", "rescored"}: calls so far and how many ran the full scan
+	Dictionary get_session_stats(int p_session) const;
+
+	// Weighted sampling by Vose alias table: build_alias_table() reads each
+	// candidate's "weight" once (O(n)); sample() then draws count candidate
+	// indices in O(1) each, with the same distribution as
+	// select_weighted_random. Rebuild the table when weights change.
+	int build_alias_table(const Array &p_candidates);
+	void release_alias_table(int p_handle);
+	// Empty if every weight is zero
+	PackedInt32Array sample(int p_handle, int p_count);
+
+	// Sparse vectors over the interned key vocabulary: sorted key ids and
+	// float values, built once from a Dictionary. sparse_similarity gives the
+	// same values as compute_similarity but by merge-joining the two sorted
+	// id arrays, with no Dictionary or hash lookups; METRIC_CONNECTION uses
+	// the weights interned by set_connection_weights (p_params is only read
+	// for "sigma").
+	int create_sparse_vector(const Dictionary &p_vector);
+	void release_sparse_vector(int p_handle);
+	double sparse_similarity(int p_a, int p_b, int p_metric, const Dictionary &p_params) const;
+	// Intern a connection_weights Dictionary ({emoji: {emoji: weight or
+	// {"weight": w}}}) for sparse METRIC_CONNECTION
+	void set_connection_weights(const Dictionary &p_weights);
+
 private:
+	SelectorRng m_rng;
+	static SelectorRng &_thread_rng();
+
+	struct SparseVector {
+		std::vector<int> ids;  // Ascending
+		std::vector<float> values;
+		double norm_sq = 0.0;
+	};
+	std::vector<std::unique_ptr<SparseVector>> m_sparse_vectors;
+	std::vector<int> m_free_sparse_vectors;
+	// Interned connection weights: per key id, (target id, weight) ascending
+	std::vector<std::vector<std::pair<int, float>>> m_connections;
+	const SparseVector *_checked_sparse(int p_handle, const char *p_method) const;
+	static double _sparse_dot(const SparseVector &p_a, const SparseVector &p_b);
+	double _sparse_connection(const SparseVector &p_a, const SparseVector &p_b) const;
+
+	struct AliasTable {
+		std::vector<double> prob;  // Chance of keeping bucket i (else take alias[i])
+		std::vector<int> alias;
+		// Negative weights count as zero; empty if the total is ~0
+		void build(const std::vector<double> &p_weights);
+	};
+	std::vector<std::unique_ptr<AliasTable>> m_alias_tables;
+	std::vector<int> m_free_alias_tables;
+
+	struct LshIndex {
+		int tables = 0;
+		int bits = 0;
+		int probes = 0;
+		// (tables * bits) × dims: row t * bits + b is bit b's hyperplane in table t
+		Eigen::MatrixXf planes;
+		std::vector<std::unordered_map<uint32_t, std::vector<int>>> buckets;  // Per table
+		std::mt19937 rng;  // Draws hyperplane columns for new keys
+
+		uint32_t hash(const Eigen::VectorXf &p_projections, int p_table) const;
+		void insert(int p_row, const Eigen::VectorXf &p_projections);
+		void erase(int p_row, const Eigen::VectorXf &p_projections);
+		// Candidate rows for a query (unsorted, may repeat)
+		void gather(const Eigen::VectorXf &p_projections, std::vector<int> &r_rows) const;
+	};
+
+	// Fenwick tree over candidate weights: O(log n) append, pop, update and
+	// weighted lookup
+	struct WeightTree {
+		std::vector<double> weights;  // Clamped at 0
+		std::vector<double> tree;  // tree[i - 1] sums weights (i - lowbit(i), i]
+
+		void push_back(double p_weight);
+		void pop_back();
+		void set(int p_index, double p_weight);
+		double total() const;
+		// First index whose running sum exceeds p_target (0 <= p_target < total)
+		int find(double p_target) const;
+	};
+
+	struct Library {
+		typedef Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> Matrix;
+
+		Array candidates;
+		// At least candidates × dims, each row divided by its norm (all-zero
+		// for a zero vector). Rows past the candidate count and columns past
+		// the vocabulary are spare capacity for library_add (zero columns do
+		// not change any score)
+		Matrix vectors;
+		Eigen::VectorXf norms;  // ||v|| of each candidate before normalization
+		// ||v||², +inf for an all-zero row so it scores 0 under gaussian (as an
+		// empty vector does in compute_similarity)
+		Eigen::VectorXf norms_sq;
+		WeightTree weights;
+		std::unique_ptr<LshIndex> index;  // library_build_index, else nullptr
+		// Changes on every add / remove; drawn from one instance-wide counter
+		// so a library registered under a reused handle never matches either
+		uint64_t version = 0;
+
+		int size() const { return candidates.size(); }
+		Matrix::ConstRowsBlockXpr rows() const { return vectors.topRows(size()); }
+		// Writes row p_row from (key id, value) pairs (ids < vectors.cols())
+		void set_row(int p_row, const std::vector<std::pair<int, float>> &p_entries);
+		Eigen::VectorXf projections(int p_row) const { return index->planes * vectors.row(p_row).transpose(); }
+	};
+
+	// Key vocabulary shared by all libraries: key -> id and id -> key
+	Dictionary m_key_ids;
+	Array m_keys;
+	std::vector<std::unique_ptr<Library>> m_libraries;
+	std::vector<int> m_free_libraries;
+	uint64_t m_library_version = 0;
+
+	struct SelectorSession {
+		int library = -1;
+		int metric = METRIC_COSINE;
+		double sigma = 0.3;
+		// Cache of the last rescore; winner < 0 when there is none
+		uint64_t library_version = 0;
+		int winner = -1;
+		// Cosine: the normalized query over the library's columns.
+		// Gaussian: the unnormalized one, plus the norm of the keys the
+		// library has no column for (a coordinate every row has at 0)
+		Eigen::VectorXf query;
+		float query_rest = 0.0f;
+		float radius = 0.0f;  // Query drift that cannot change the winner
+		int64_t queries = 0;
+		int64_t rescored = 0;
+	};
+	std::vector<std::unique_ptr<SelectorSession>> m_sessions;
+	std::vector<int> m_free_sessions;
+	SelectorSession *_checked_session(int p_handle, const char *p_method);
+	const SelectorSession *_checked_session(int p_handle, const char *p_method) const;
+
+	int _intern_key(const Variant &p_key);
+	// (key id, value) pairs of p_vector, interning new keys
+	void _intern_vector(const Dictionary &p_vector, std::vector<std::pair<int, float>> &r_entries);
+	Library *_checked_library(int p_handle, const char *p_method);
+	const Library *_checked_library(int p_handle, const char *p_method) const;
+	// Normalized dense copy of p_vector over the library's columns; keys the
+	// library has no column for still count toward the norm (written to
+	// r_norm if given). False for a zero vector
+	bool _dense_query(const Library &p_library, const Dictionary &p_vector, Eigen::VectorXf &r_query, float *r_norm = nullptr) const;
+	// METRIC_COSINE and METRIC_GAUSSIAN run on libraries; warns otherwise
+	static bool _check_library_metric(int p_metric, const char *p_method);
+	// rows() · p_query through the host's widest SIMD kernel
+	static Eigen::VectorXf _library_scores(const Library &p_library, const Eigen::VectorXf &p_query);
+	// Per-row squared distance to a query of norm p_query_norm from its
+	// cosines against the library rows (clamped at 0; +inf for zero rows)
+	static void _gaussian_distances(const Library &p_library, const Eigen::Ref<const Eigen::VectorXf> &p_cosines, float p_query_norm, Eigen::VectorXf &r_dist_sq);
+	// Candidate Dictionary with "similarity" and "index" added
+	static Dictionary _library_result(const Library &p_library, int p_index, double p_similarity);
+
+
 	// Internal implementations
 	static double _cosine_similarity(const Dictionary &p_v1, const Dictionary &p_v2);
+	// cos² against a query whose norm² is already known: one pass over the
+	// candidate's keys for both its norm and the dot product
+	static double _cosine_similarity_prepared(const Dictionary &p_query, double p_query_norm_sq, const Dictionary &p_candidate);
+	// compute_similarity for a query scored against many candidates
+	// (p_query_norm_sq: ||query||², only read for METRIC_COSINE)
+	static double _candidate_similarity(const Dictionary &p_query, double p_query_norm_sq, const Dictionary &p_candidate, int p_metric, const Dictionary &p_params);
 	static double _connection_similarity(const Dictionary &p_v1, const Dictionary &p_v2, const Dictionary &p_weights);
 	static double _logarithmic_total_weight(const Dictionary &p_vector);
 	static double _gaussian_similarity(const Dictionary &p_v1, const Dictionary &p_v2, double p_sigma);
+	// Indices of the k highest scores (all if k <= 0), descending, ties in
+	// index order; O(n log k)
+	static std::vector<int> _top_k_indices(const std::vector<double> &p_scores, int p_k);
 };
 
 } // namespace godot
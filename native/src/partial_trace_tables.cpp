@@ -0,0 +1,58 @@
+#include "partial_trace_tables.h"
+
+#include <map>
+#include <mutex>
+
+using namespace godot;
+
+namespace {
+
+// Insert a zero at bit position `bit` of k (bits >= bit shift up by one)
+inline int32_t insert_zero_bit(int32_t k, int bit) {
+    const int32_t low = k & ((1 << bit) - 1);
+    return ((k >> bit) << (bit + 1)) | low;
+}
+
+}  // namespace
+
+PartialTraceTables::PartialTraceTables(int num_qubits)
+    : m_num_qubits(num_qubits) {
+    const int n = num_qubits;
+    m_single_size = n >= 1 ? (1 << (n - 1)) : 0;
+    m_pair_size = n >= 2 ? (1 << (n - 2)) : 0;
+
+    m_singles.resize(static_cast<size_t>(n) * m_single_size);
+    for (int b = 0; b < n; b++) {
+        int32_t* out = m_singles.data() + static_cast<size_t>(b) * m_single_size;
+        for (int32_t k = 0; k < m_single_size; k++) {
+            out[k] = insert_zero_bit(k, b);
+        }
+    }
+
+    m_pairs.resize(static_cast<size_t>(n) * (n - 1) / 2 * m_pair_size);
+    int32_t* out = m_pairs.data();
+    for (int p = 0; p < n; p++) {
+        for (int q = p + 1; q < n; q++) {
+            // Lower bit first, so q's position is unaffected by p's insertion
+            for (int32_t k = 0; k < m_pair_size; k++) {
+                *out++ = insert_zero_bit(insert_zero_bit(k, p), q);
+            }
+        }
+    }
+}
+
+std::shared_ptr<const PartialTraceTables> PartialTraceTables::get(int num_qubits) {
+    if (num_qubits < 1 || num_qubits > MAX_QUBITS) {
+        return nullptr;
+    }
+
+    static std::mutex registry_mutex;
+    static std::map<int, std::shared_ptr<const PartialTraceTables>> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<const PartialTraceTables>& entry = registry[num_qubits];
+    if (!entry) {
+        entry = std::make_shared<const PartialTraceTables>(num_qubits);
+    }
+    return entry;
+}
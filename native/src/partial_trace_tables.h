@@ -0,0 +1,58 @@
+#ifndef PARTIAL_TRACE_TABLES_H
+#define PARTIAL_TRACE_TABLES_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+namespace godot {
+
+/**
+ * PartialTraceTables - Gather index tables for single-qubit and pairwise traces
+ *
+ * Tracing out everything but bit b (or bits p < q) sums ρ over all basis
+ * states whose kept bits are fixed. Instead of rebuilding those indices bit by
+ * bit in the inner loop, each table lists the "base" indices once: all
+ * 2^(n-1) (or 2^(n-2)) basis states with the kept bits zero, ascending. A trace
+ * then becomes a straight gather:
+ *
+ *   ρ_b(a, c) = Σ_k ρ(base[k] | a<<b, base[k] | c<<b)
+ *
+ * Tables are indexed by basis bit (callers map qubits to bits in their own
+ * convention), built once per qubit count and shared by every engine through
+ * a process-wide registry. Immutable after construction, so safe to read from
+ * any thread.
+ */
+class PartialTraceTables {
+public:
+    static constexpr int MAX_QUBITS = 16;  // n·2^(n-1) + n(n-1)/2·2^(n-2) ints ≈ 10 MB at 16
+
+    // Shared tables for num_qubits (built on first request, thread-safe).
+    // Returns nullptr outside [1, MAX_QUBITS].
+    static std::shared_ptr<const PartialTraceTables> get(int num_qubits);
+
+    int num_qubits() const { return m_num_qubits; }
+    int single_size() const { return m_single_size; }  // 2^(n-1)
+    int pair_size() const { return m_pair_size; }      // 2^(n-2)
+
+    // Base indices with `bit` zero
+    const int32_t* single(int bit) const { return m_singles.data() + static_cast<size_t>(bit) * m_single_size; }
+    // Base indices with bits p and q zero (p < q)
+    const int32_t* pair(int p, int q) const {
+        const int idx = p * m_num_qubits - p * (p + 1) / 2 + (q - p - 1);
+        return m_pairs.data() + static_cast<size_t>(idx) * m_pair_size;
+    }
+
+    explicit PartialTraceTables(int num_qubits);
+
+private:
+    int m_num_qubits = 0;
+    int m_single_size = 0;
+    int m_pair_size = 0;
+    std::vector<int32_t> m_singles;  // [bit][k]
+    std::vector<int32_t> m_pairs;    // [pair_index(p, q)][k], same pair order as ReducedStates
+};
+
+}  // namespace godot
+
+#endif  // PARTIAL_TRACE_TABLES_H
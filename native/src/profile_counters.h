@@ -0,0 +1,64 @@
+#ifndef PROFILE_COUNTERS_H
+#define PROFILE_COUNTERS_H
+
+#include <godot_cpp/variant/dictionary.hpp>
+#include <chrono>
+#include <cstdint>
+
+namespace godot {
+
+/**
+ * ProfileStage / ScopedProfile - Always-on hot-path timers
+ *
+ * A stage is a call count plus accumulated nanoseconds; a ScopedProfile adds
+ * one call and its wall time when it leaves scope (two steady_clock reads,
+ * tens of ns, so stages wrap whole steps or sweeps, never inner loops).
+ *
+ * Counters are plain integers: each stage is written by one thread at a time
+ * (a biome's task, or the caller holding the owning engine's lock) and read
+ * under the same lock by get_profile_stats.
+ */
+struct ProfileStage {
+    uint64_t calls = 0;
+    uint64_t nanos = 0;
+
+    void add(uint64_t ns) {
+        calls++;
+        nanos += ns;
+    }
+    void merge(const ProfileStage& other) {
+        calls += other.calls;
+        nanos += other.nanos;
+    }
+
+    // {"calls", "usec", "avg_usec"}
+    Dictionary to_dict() const {
+        Dictionary d;
+        const double usec = static_cast<double>(nanos) / 1000.0;
+        d["calls"] = static_cast<int64_t>(calls);
+        d["usec"] = usec;
+        d["avg_usec"] = calls > 0 ? usec / static_cast<double>(calls) : 0.0;
+        return d;
+    }
+};
+
+class ScopedProfile {
+public:
+    explicit ScopedProfile(ProfileStage& stage)
+        : m_stage(stage), m_start(std::chrono::steady_clock::now()) {}
+    ~ScopedProfile() {
+        m_stage.add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_start).count()));
+    }
+
+private:
+    ScopedProfile(const ScopedProfile&) = delete;
+    ScopedProfile& operator=(const ScopedProfile&) = delete;
+
+    ProfileStage& m_stage;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+}  // namespace godot
+
+#endif  // PROFILE_COUNTERS_H
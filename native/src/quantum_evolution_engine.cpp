@@ -1,16 +1,30 @@
 #include "quantum_evolution_engine.h"
+#include "emoji_registry.h"
+#include "partial_trace_tables.h"
+#include "native_thread_pool.h"
+#include "native_counters.h"
+#include "memory_bytes.h"
+#include "simd_dispatch.h"
+#include "trace_zones.h"
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/string.hpp>
 #include <godot_cpp/variant/variant.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <Eigen/SparseLU>
+#include <unsupported/Eigen/MatrixFunctions>
 #include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <random>
 
 using namespace godot;
 
 namespace {
-inline void cap_trace_and_clamp_diag(Eigen::MatrixXcd &rho) {
+inline void cap_trace_and_clamp_diag(QuantumEvolutionEngine::RhoRef rho) {
     const double eps = 1e-12;
     const int dim = std::min(rho.rows(), rho.cols());
     double trace = 0.0;
@@ -31,61 +45,415 @@ inline void cap_trace_and_clamp_diag(Eigen::MatrixXcd &rho) {
         rho *= (1.0 / trace);
     }
 }
+
+typedef Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> SparseCM;
+
+// compute_eigenstate_similarity_matrix: Gram products below this many
+// complex multiply-adds (count² · dim) stay on the calling thread
+constexpr int64_t SIMILARITY_PARALLEL_MIN_WORK = int64_t(1) << 18;
+
+// Kernels shared with the Godot-free core (lindblad_core.h)
+using lindblad::local_apply_left;
+using lindblad::local_apply_right_adjoint;
+using lindblad::hermitian_eigenvalues_2x2;
+using lindblad::hermitian_eigenvalues_4x4;
+using lindblad::entropy_from_eigenvalues;
+
+// Stored (r, c) entry of a compressed row-major matrix, or nullptr when the
+// sparsity pattern doesn't hold it
+inline std::complex<double>* find_entry(SparseCM& m, int r, int c) {
+    if (r < 0 || r >= m.outerSize() || !m.isCompressed()) {
+        return nullptr;
+    }
+    const int* inner = m.innerIndexPtr();
+    const int* begin = inner + m.outerIndexPtr()[r];
+    const int* end = inner + m.outerIndexPtr()[r + 1];
+    const int* it = std::lower_bound(begin, end, c);
+    return (it != end && *it == c) ? m.valuePtr() + (it - inner) : nullptr;
+}
+
+// Identical compressed sparsity patterns
+inline bool same_pattern(const SparseCM& a, const SparseCM& b) {
+    if (a.rows() != b.rows() || a.cols() != b.cols() || a.nonZeros() != b.nonZeros() ||
+        !a.isCompressed() || !b.isCompressed()) {
+        return false;
+    }
+    return std::equal(a.outerIndexPtr(), a.outerIndexPtr() + a.outerSize() + 1, b.outerIndexPtr()) &&
+           std::equal(a.innerIndexPtr(), a.innerIndexPtr() + a.nonZeros(), b.innerIndexPtr());
+}
+
+// Append scale * (B ⊗ A) to a triplet list (both operands sparse, dim×dim)
+inline void append_kron(std::vector<Eigen::Triplet<std::complex<double>>> &out,
+                        const SparseCM &B, const SparseCM &A,
+                        std::complex<double> scale, int dim) {
+    for (int p = 0; p < B.outerSize(); ++p) {
+        for (SparseCM::InnerIterator itB(B, p); itB; ++itB) {
+            const int q = static_cast<int>(itB.col());
+            const std::complex<double> b = scale * itB.value();
+            for (int i = 0; i < A.outerSize(); ++i) {
+                for (SparseCM::InnerIterator itA(A, i); itA; ++itA) {
+                    out.emplace_back(p * dim + i, q * dim + static_cast<int>(itA.col()),
+                                     b * itA.value());
+                }
+            }
+        }
+    }
+}
+
+// Embed a local operator as a full dim×dim sparse matrix (Liouvillian assembly)
+SparseCM expand_local(const Eigen::Matrix4cd &op, int size, int mask, const int *offsets, int dim) {
+    std::vector<Eigen::Triplet<std::complex<double>>> triplets;
+    triplets.reserve(static_cast<size_t>(dim) * size);
+    for (int base = 0; base < dim; base++) {
+        if (base & mask) {
+            continue;
+        }
+        for (int a = 0; a < size; a++) {
+            for (int b = 0; b < size; b++) {
+                if (std::abs(op(a, b)) > 1e-15) {
+                    triplets.emplace_back(base + offsets[a], base + offsets[b], op(a, b));
+                }
+            }
+        }
+    }
+    SparseCM out(dim, dim);
+    out.setFromTriplets(triplets.begin(), triplets.end());
+    out.makeCompressed();
+    return out;
+}
+
+// Scatter the low bits of v into the set bits of mask (ascending)
+inline int deposit_bits(int v, int mask) {
+    int out = 0;
+    for (int bit = 0; mask != 0; mask &= mask - 1, bit++) {
+        if ((v >> bit) & 1) {
+            out |= mask & -mask;
+        }
+    }
+    return out;
+}
+
+// Gather the bits of v selected by mask into the low bits (inverse of deposit_bits)
+inline int compress_bits(int v, int mask) {
+    int out = 0;
+    for (int bit = 0; mask != 0; mask &= mask - 1, bit++) {
+        if (v & mask & -mask) {
+            out |= 1 << bit;
+        }
+    }
+    return out;
+}
+
+// Reduced state of the bits in keep_mask of a 2^src_bits square matrix: kept
+// bits become the local index in ascending order, so reducing a reduction
+// composes (child mask taken via compress_bits in the parent's frame)
+template <typename Src>
+Eigen::MatrixXcd reduce_to_bits(const Src& src, int src_bits, int keep_mask) {
+    const int sub = 1 << __builtin_popcount(keep_mask);
+    const int rest_mask = ((1 << src_bits) - 1) & ~keep_mask;
+    std::vector<int> offsets(sub);
+    for (int a = 0; a < sub; a++) {
+        offsets[a] = deposit_bits(a, keep_mask);
+    }
+    Eigen::MatrixXcd out = Eigen::MatrixXcd::Zero(sub, sub);
+    int base = 0;
+    do {
+        for (int a = 0; a < sub; a++) {
+            for (int b = 0; b < sub; b++) {
+                out(a, b) += src(base + offsets[a], base + offsets[b]);
+            }
+        }
+        base = (base - rest_mask) & rest_mask;  // Next configuration of the traced bits
+    } while (base != 0);
+    return out;
+}
 }  // namespace
 
 void QuantumEvolutionEngine::_bind_methods() {
-    ClassDB::bind_method(D_METHOD("set_dimension", "dim"),
-                         &QuantumEvolutionEngine::set_dimension);
-    ClassDB::bind_method(D_METHOD("set_hamiltonian", "H_packed"),
-                         &QuantumEvolutionEngine::set_hamiltonian);
-    ClassDB::bind_method(D_METHOD("add_lindblad_triplets", "triplets"),
-                         &QuantumEvolutionEngine::add_lindblad_triplets);
-    ClassDB::bind_method(D_METHOD("clear_operators"),
-                         &QuantumEvolutionEngine::clear_operators);
-    ClassDB::bind_method(D_METHOD("finalize"),
-                         &QuantumEvolutionEngine::finalize);
-
-    ClassDB::bind_method(D_METHOD("get_dimension"),
-                         &QuantumEvolutionEngine::get_dimension);
-    ClassDB::bind_method(D_METHOD("get_lindblad_count"),
-                         &QuantumEvolutionEngine::get_lindblad_count);
-    ClassDB::bind_method(D_METHOD("is_finalized"),
-                         &QuantumEvolutionEngine::is_finalized);
-
-    ClassDB::bind_method(D_METHOD("evolve_step", "rho_data", "dt"),
-                         &QuantumEvolutionEngine::evolve_step);
-    ClassDB::bind_method(D_METHOD("evolve", "rho_data", "dt", "max_dt"),
-                         &QuantumEvolutionEngine::evolve);
+    BIND_TIMED_METHOD(D_METHOD("set_dimension", "dim"),
+                      &QuantumEvolutionEngine::set_dimension);
+    BIND_TIMED_METHOD(D_METHOD("set_hamiltonian", "H_packed"),
+                      &QuantumEvolutionEngine::set_hamiltonian);
+    BIND_TIMED_METHOD(D_METHOD("add_lindblad_triplets", "triplets"),
+                      &QuantumEvolutionEngine::add_lindblad_triplets);
+    BIND_TIMED_METHOD(D_METHOD("set_hamiltonian_terms", "terms"),
+                      &QuantumEvolutionEngine::set_hamiltonian_terms);
+    BIND_TIMED_METHOD(D_METHOD("add_lindblad_terms", "terms"),
+                      &QuantumEvolutionEngine::add_lindblad_terms);
+    BIND_TIMED_METHOD(D_METHOD("add_local_hamiltonian", "op_packed", "qubits"),
+                      &QuantumEvolutionEngine::add_local_hamiltonian);
+    BIND_TIMED_METHOD(D_METHOD("add_local_lindblad", "op_packed", "qubits"),
+                      &QuantumEvolutionEngine::add_local_lindblad);
+    BIND_TIMED_METHOD(D_METHOD("get_local_operator_count"),
+                      &QuantumEvolutionEngine::get_local_operator_count);
+    BIND_TIMED_METHOD(D_METHOD("get_operator_forms"),
+                      &QuantumEvolutionEngine::get_operator_forms);
+    BIND_TIMED_METHOD(D_METHOD("clear_operators"),
+                      &QuantumEvolutionEngine::clear_operators);
+    BIND_TIMED_METHOD(D_METHOD("finalize"),
+                      &QuantumEvolutionEngine::finalize);
+    BIND_TIMED_METHOD(D_METHOD("update_hamiltonian_entries", "triplets"),
+                      &QuantumEvolutionEngine::update_hamiltonian_entries);
+    BIND_TIMED_METHOD(D_METHOD("replace_lindblad", "k", "triplets"),
+                      &QuantumEvolutionEngine::replace_lindblad);
+    BIND_TIMED_METHOD(D_METHOD("set_use_liouvillian", "enabled"),
+                      &QuantumEvolutionEngine::set_use_liouvillian);
+    BIND_TIMED_METHOD(D_METHOD("get_use_liouvillian"),
+                      &QuantumEvolutionEngine::get_use_liouvillian);
+    BIND_TIMED_METHOD(D_METHOD("has_liouvillian"),
+                      &QuantumEvolutionEngine::has_liouvillian);
+    BIND_TIMED_METHOD(D_METHOD("get_liouvillian_nnz"),
+                      &QuantumEvolutionEngine::get_liouvillian_nnz);
+    BIND_TIMED_METHOD(D_METHOD("get_operator_nnz"), &QuantumEvolutionEngine::get_operator_nnz);
+    BIND_TIMED_METHOD(D_METHOD("set_multirate_rate_gap", "ratio"),
+                      &QuantumEvolutionEngine::set_multirate_rate_gap);
+    BIND_TIMED_METHOD(D_METHOD("get_multirate_rate_gap"),
+                      &QuantumEvolutionEngine::get_multirate_rate_gap);
+    BIND_TIMED_METHOD(D_METHOD("get_fast_channel_count"),
+                      &QuantumEvolutionEngine::get_fast_channel_count);
+    BIND_TIMED_METHOD(D_METHOD("set_propagator_dt", "dt"),
+                      &QuantumEvolutionEngine::set_propagator_dt);
+    BIND_TIMED_METHOD(D_METHOD("get_propagator_dt"),
+                      &QuantumEvolutionEngine::get_propagator_dt);
+    BIND_TIMED_METHOD(D_METHOD("has_propagator"),
+                      &QuantumEvolutionEngine::has_propagator);
+    BIND_TIMED_METHOD(D_METHOD("set_use_symmetry_sectors", "enabled"),
+                      &QuantumEvolutionEngine::set_use_symmetry_sectors);
+    BIND_TIMED_METHOD(D_METHOD("get_use_symmetry_sectors"),
+                      &QuantumEvolutionEngine::get_use_symmetry_sectors);
+    BIND_TIMED_METHOD(D_METHOD("get_symmetry_sector_count"),
+                      &QuantumEvolutionEngine::get_symmetry_sector_count);
+    BIND_TIMED_METHOD(D_METHOD("set_population_mode_threshold", "threshold"),
+                      &QuantumEvolutionEngine::set_population_mode_threshold);
+    BIND_TIMED_METHOD(D_METHOD("get_population_mode_threshold"),
+                      &QuantumEvolutionEngine::get_population_mode_threshold);
+    BIND_TIMED_METHOD(D_METHOD("is_population_mode_eligible"),
+                      &QuantumEvolutionEngine::is_population_mode_eligible);
+    BIND_TIMED_METHOD(D_METHOD("get_last_population_step"),
+                      &QuantumEvolutionEngine::get_last_population_step);
+    BIND_TIMED_METHOD(D_METHOD("set_sparse_rho_threshold", "threshold"),
+                      &QuantumEvolutionEngine::set_sparse_rho_threshold);
+    BIND_TIMED_METHOD(D_METHOD("get_sparse_rho_threshold"),
+                      &QuantumEvolutionEngine::get_sparse_rho_threshold);
+    BIND_TIMED_METHOD(D_METHOD("get_last_sparse_rho_nnz"),
+                      &QuantumEvolutionEngine::get_last_sparse_rho_nnz);
+    BIND_TIMED_METHOD(D_METHOD("set_analytic_evolution", "enabled"),
+                      &QuantumEvolutionEngine::set_analytic_evolution);
+    BIND_TIMED_METHOD(D_METHOD("get_analytic_evolution"),
+                      &QuantumEvolutionEngine::get_analytic_evolution);
+    BIND_TIMED_METHOD(D_METHOD("is_analytic_eligible"),
+                      &QuantumEvolutionEngine::is_analytic_eligible);
+    BIND_TIMED_METHOD(D_METHOD("get_last_analytic_step"),
+                      &QuantumEvolutionEngine::get_last_analytic_step);
+    BIND_TIMED_METHOD(D_METHOD("get_symmetry_sector_sizes"),
+                      &QuantumEvolutionEngine::get_symmetry_sector_sizes);
+    BIND_TIMED_METHOD(D_METHOD("compute_steady_state"),
+                      &QuantumEvolutionEngine::compute_steady_state);
+
+    BIND_TIMED_METHOD(D_METHOD("get_dimension"),
+                      &QuantumEvolutionEngine::get_dimension);
+    BIND_TIMED_METHOD(D_METHOD("get_lindblad_count"),
+                      &QuantumEvolutionEngine::get_lindblad_count);
+    BIND_TIMED_METHOD(D_METHOD("is_finalized"),
+                      &QuantumEvolutionEngine::is_finalized);
+
+    BIND_TIMED_METHOD(D_METHOD("evolve_step", "rho_data", "dt"),
+                      &QuantumEvolutionEngine::evolve_step);
+    BIND_TIMED_METHOD(D_METHOD("evolve", "rho_data", "dt", "max_dt"),
+                      &QuantumEvolutionEngine::evolve);
+    BIND_TIMED_METHOD(D_METHOD("evolve_trajectory", "rho_data", "steps", "dt", "max_dt"),
+                      &QuantumEvolutionEngine::evolve_trajectory);
+    BIND_TIMED_METHOD(D_METHOD("apply_operator", "rho_data", "op_packed"),
+                      &QuantumEvolutionEngine::apply_operator);
+    BIND_TIMED_METHOD(D_METHOD("apply_gate_1q", "rho_data", "qubit", "U2"),
+                      &QuantumEvolutionEngine::apply_gate_1q);
+    BIND_TIMED_METHOD(D_METHOD("apply_gate_2q", "rho_data", "qubit_a", "qubit_b", "U4"),
+                      &QuantumEvolutionEngine::apply_gate_2q);
+    BIND_TIMED_METHOD(D_METHOD("apply_controlled_gate", "rho_data", "control", "target", "U2"),
+                      &QuantumEvolutionEngine::apply_controlled_gate);
+    BIND_TIMED_METHOD(D_METHOD("measure_qubit", "rho_data", "qubit", "rng_seed"),
+                      &QuantumEvolutionEngine::measure_qubit);
+    BIND_TIMED_METHOD(D_METHOD("measure_basis", "rho_data", "qubits", "rng_seed"),
+                      &QuantumEvolutionEngine::measure_basis);
+
+    // Per-channel population flux
+    BIND_TIMED_METHOD(D_METHOD("set_flux_tracking", "metadata"),
+                      &QuantumEvolutionEngine::set_flux_tracking);
+    BIND_TIMED_METHOD(D_METHOD("is_flux_tracking"),
+                      &QuantumEvolutionEngine::is_flux_tracking);
+    BIND_TIMED_METHOD(D_METHOD("get_flux_emoji_ids"),
+                      &QuantumEvolutionEngine::get_flux_emoji_ids);
+    BIND_TIMED_METHOD(D_METHOD("take_channel_flux"),
+                      &QuantumEvolutionEngine::take_channel_flux);
+
+    // Hermitian half-storage I/O
+    BIND_TIMED_METHOD(D_METHOD("evolve_hermitian", "rho_herm", "dt", "max_dt"),
+                      &QuantumEvolutionEngine::evolve_hermitian);
+    BIND_TIMED_METHOD(D_METHOD("pack_hermitian", "rho_data"),
+                      &QuantumEvolutionEngine::pack_hermitian);
+    BIND_TIMED_METHOD(D_METHOD("unpack_hermitian", "rho_herm"),
+                      &QuantumEvolutionEngine::unpack_hermitian);
+    BIND_TIMED_METHOD(D_METHOD("compute_purity_from_hermitian", "rho_herm"),
+                      &QuantumEvolutionEngine::compute_purity_from_hermitian);
+
+    // Integrator selection
+    BIND_ENUM_CONSTANT(INTEGRATOR_EULER);
+    BIND_ENUM_CONSTANT(INTEGRATOR_DOPRI5);
+    BIND_ENUM_CONSTANT(INTEGRATOR_KRYLOV);
+    BIND_ENUM_CONSTANT(INTEGRATOR_STRANG);
+    BIND_ENUM_CONSTANT(INTEGRATOR_MULTIRATE);
+    BIND_ENUM_CONSTANT(INTEGRATOR_KRAUS);
+
+    BIND_ENUM_CONSTANT(OBSERVABLE_BLOCH);
+    BIND_ENUM_CONSTANT(OBSERVABLE_PURITY);
+    BIND_ENUM_CONSTANT(OBSERVABLE_TRACE);
+    BIND_ENUM_CONSTANT(OBSERVABLE_MI);
+    BIND_ENUM_CONSTANT(OBSERVABLE_ALL);
+    BIND_ENUM_CONSTANT(OBSERVABLE_CONCURRENCE);
+    BIND_ENUM_CONSTANT(OBSERVABLE_NEGATIVITY);
+    BIND_TIMED_METHOD(D_METHOD("set_integrator", "integrator"),
+                      &QuantumEvolutionEngine::set_integrator);
+    BIND_TIMED_METHOD(D_METHOD("get_integrator"),
+                      &QuantumEvolutionEngine::get_integrator);
+    BIND_TIMED_METHOD(D_METHOD("set_integrator_tolerance", "rtol", "atol"),
+                      &QuantumEvolutionEngine::set_integrator_tolerance);
+    BIND_TIMED_METHOD(D_METHOD("get_last_substep_count"),
+                      &QuantumEvolutionEngine::get_last_substep_count);
+    BIND_TIMED_METHOD(D_METHOD("get_last_rhs_evaluations"),
+                      &QuantumEvolutionEngine::get_last_rhs_evaluations);
+    BIND_TIMED_METHOD(D_METHOD("get_last_step_truncated"),
+                      &QuantumEvolutionEngine::get_last_step_truncated);
+    BIND_TIMED_METHOD(D_METHOD("set_krylov_dimension", "m"),
+                      &QuantumEvolutionEngine::set_krylov_dimension);
+    BIND_TIMED_METHOD(D_METHOD("get_krylov_dimension"),
+                      &QuantumEvolutionEngine::get_krylov_dimension);
+    BIND_TIMED_METHOD(D_METHOD("set_single_precision", "enabled"),
+                      &QuantumEvolutionEngine::set_single_precision);
+    BIND_TIMED_METHOD(D_METHOD("get_single_precision"),
+                      &QuantumEvolutionEngine::get_single_precision);
+    BIND_TIMED_METHOD(D_METHOD("set_precision_resync_interval", "steps"),
+                      &QuantumEvolutionEngine::set_precision_resync_interval);
+    BIND_TIMED_METHOD(D_METHOD("get_precision_resync_interval"),
+                      &QuantumEvolutionEngine::get_precision_resync_interval);
+    BIND_TIMED_METHOD(D_METHOD("set_drift_monitor", "interval", "pairs"),
+                      &QuantumEvolutionEngine::set_drift_monitor, DEFVAL(16));
+    BIND_TIMED_METHOD(D_METHOD("set_drift_thresholds", "trace_error", "hermiticity_error", "negative_mass"),
+                      &QuantumEvolutionEngine::set_drift_thresholds);
+    BIND_TIMED_METHOD(D_METHOD("set_drift_fallback_enabled", "enabled"),
+                      &QuantumEvolutionEngine::set_drift_fallback_enabled);
+    BIND_TIMED_METHOD(D_METHOD("is_drift_fallback_enabled"),
+                      &QuantumEvolutionEngine::is_drift_fallback_enabled);
+    BIND_TIMED_METHOD(D_METHOD("get_drift_level"), &QuantumEvolutionEngine::get_drift_level);
+    BIND_TIMED_METHOD(D_METHOD("get_drift_stats"), &QuantumEvolutionEngine::get_drift_stats);
+    BIND_TIMED_METHOD(D_METHOD("reset_drift_monitor"), &QuantumEvolutionEngine::reset_drift_monitor);
 
     // MI computation methods
-    ClassDB::bind_method(D_METHOD("compute_all_mutual_information", "rho_data", "num_qubits"),
-                         &QuantumEvolutionEngine::compute_all_mutual_information);
-    ClassDB::bind_method(D_METHOD("compute_mi_adaptive", "rho_data", "num_qubits", "biome_purity", "force_full_scan"),
-                         &QuantumEvolutionEngine::compute_mi_adaptive);
-    ClassDB::bind_method(D_METHOD("clear_mi_candidates"),
-                         &QuantumEvolutionEngine::clear_mi_candidates);
-    ClassDB::bind_method(D_METHOD("evolve_with_mi", "rho_data", "dt", "max_dt", "num_qubits"),
-                         &QuantumEvolutionEngine::evolve_with_mi);
+    BIND_TIMED_METHOD(D_METHOD("compute_all_mutual_information", "rho_data", "num_qubits"),
+                      &QuantumEvolutionEngine::compute_all_mutual_information);
+    BIND_TIMED_METHOD(D_METHOD("compute_subsystem_entropies", "rho_data", "num_qubits", "subsets"),
+                      &QuantumEvolutionEngine::compute_subsystem_entropies);
+    BIND_TIMED_METHOD(D_METHOD("compute_mi_adaptive", "rho_data", "num_qubits", "biome_purity", "force_full_scan"),
+                      &QuantumEvolutionEngine::compute_mi_adaptive);
+    BIND_TIMED_METHOD(D_METHOD("clear_mi_candidates"),
+                      &QuantumEvolutionEngine::clear_mi_candidates);
+    BIND_TIMED_METHOD(D_METHOD("get_mi_candidate_count"),
+                      &QuantumEvolutionEngine::get_mi_candidate_count);
+    BIND_TIMED_METHOD(D_METHOD("get_mi_edges", "mi_values", "num_qubits"),
+                      &QuantumEvolutionEngine::get_mi_edges);
+    BIND_TIMED_METHOD(D_METHOD("set_mi_rescreen_budget", "pairs_per_call"),
+                      &QuantumEvolutionEngine::set_mi_rescreen_budget);
+    BIND_TIMED_METHOD(D_METHOD("get_mi_rescreen_budget"),
+                      &QuantumEvolutionEngine::get_mi_rescreen_budget);
+    BIND_TIMED_METHOD(D_METHOD("set_mi_rescreen_drift", "drift"),
+                      &QuantumEvolutionEngine::set_mi_rescreen_drift);
+    BIND_TIMED_METHOD(D_METHOD("get_mi_rescreen_drift"),
+                      &QuantumEvolutionEngine::get_mi_rescreen_drift);
+    BIND_TIMED_METHOD(D_METHOD("set_mi_force_linear", "force_linear"),
+                      &QuantumEvolutionEngine::set_mi_force_linear);
+    BIND_TIMED_METHOD(D_METHOD("get_mi_force_linear"), &QuantumEvolutionEngine::get_mi_force_linear);
+    BIND_TIMED_METHOD(D_METHOD("set_mi_audit_interval", "calls"),
+                      &QuantumEvolutionEngine::set_mi_audit_interval);
+    BIND_TIMED_METHOD(D_METHOD("get_mi_audit_interval"), &QuantumEvolutionEngine::get_mi_audit_interval);
+    BIND_TIMED_METHOD(D_METHOD("get_mi_screen_stats"), &QuantumEvolutionEngine::get_mi_screen_stats);
+    BIND_TIMED_METHOD(D_METHOD("reset_mi_screen_stats"), &QuantumEvolutionEngine::reset_mi_screen_stats);
+    BIND_TIMED_METHOD(D_METHOD("set_mi_parallel_threshold", "min_pairs"),
+                      &QuantumEvolutionEngine::set_mi_parallel_threshold);
+    BIND_TIMED_METHOD(D_METHOD("get_mi_parallel_threshold"),
+                      &QuantumEvolutionEngine::get_mi_parallel_threshold);
+    BIND_TIMED_METHOD(D_METHOD("set_observable_reuse_tolerance", "tolerance"),
+                      &QuantumEvolutionEngine::set_observable_reuse_tolerance);
+    BIND_TIMED_METHOD(D_METHOD("get_observable_reuse_tolerance"),
+                      &QuantumEvolutionEngine::get_observable_reuse_tolerance);
+    BIND_TIMED_METHOD(D_METHOD("clear_observable_cache"),
+                      &QuantumEvolutionEngine::clear_observable_cache);
+    BIND_TIMED_METHOD(D_METHOD("get_last_reused_observable_count"),
+                      &QuantumEvolutionEngine::get_last_reused_observable_count);
+    BIND_TIMED_METHOD(D_METHOD("get_profile_stats"),
+                      &QuantumEvolutionEngine::get_profile_stats);
+    BIND_TIMED_METHOD(D_METHOD("reset_profile_stats"),
+                      &QuantumEvolutionEngine::reset_profile_stats);
+    BIND_TIMED_METHOD(D_METHOD("get_operator_registry_stats"),
+                      &QuantumEvolutionEngine::get_operator_registry_stats);
+    BIND_TIMED_METHOD(D_METHOD("get_memory_stats"),
+                      &QuantumEvolutionEngine::get_memory_stats);
+    BIND_TIMED_METHOD(D_METHOD("evolve_with_mi", "rho_data", "dt", "max_dt", "num_qubits"),
+                      &QuantumEvolutionEngine::evolve_with_mi);
 
     // Basic observables from packed data
-    ClassDB::bind_method(D_METHOD("compute_purity_from_packed", "rho_data"),
-                         &QuantumEvolutionEngine::compute_purity_from_packed);
-    ClassDB::bind_method(D_METHOD("compute_bloch_metrics_from_packed", "rho_data", "num_qubits"),
-                         &QuantumEvolutionEngine::compute_bloch_metrics_from_packed);
+    BIND_TIMED_METHOD(D_METHOD("compute_purity_from_packed", "rho_data"),
+                      &QuantumEvolutionEngine::compute_purity_from_packed);
+    BIND_TIMED_METHOD(D_METHOD("compute_bloch_metrics_from_packed", "rho_data", "num_qubits"),
+                      &QuantumEvolutionEngine::compute_bloch_metrics_from_packed);
+    BIND_TIMED_METHOD(D_METHOD("compute_observables_from_packed", "rho_data", "num_qubits", "mask"),
+                      &QuantumEvolutionEngine::compute_observables_from_packed, DEFVAL(OBSERVABLE_ALL));
+    BIND_TIMED_METHOD(D_METHOD("set_low_rank_truncation", "max_rank", "tolerance"),
+                      &QuantumEvolutionEngine::set_low_rank_truncation, DEFVAL(8), DEFVAL(1e-10));
+    BIND_TIMED_METHOD(D_METHOD("get_low_rank_max_rank"),
+                      &QuantumEvolutionEngine::get_low_rank_max_rank);
+    BIND_TIMED_METHOD(D_METHOD("get_low_rank_tolerance"),
+                      &QuantumEvolutionEngine::get_low_rank_tolerance);
+    BIND_TIMED_METHOD(D_METHOD("factor_low_rank", "rho_data"),
+                      &QuantumEvolutionEngine::factor_low_rank);
+    BIND_TIMED_METHOD(D_METHOD("expand_low_rank", "factor"),
+                      &QuantumEvolutionEngine::expand_low_rank);
+    BIND_TIMED_METHOD(D_METHOD("evolve_low_rank", "factor", "dt", "max_dt"),
+                      &QuantumEvolutionEngine::evolve_low_rank);
+    BIND_TIMED_METHOD(D_METHOD("compute_observables_low_rank", "factor", "num_qubits", "mask"),
+                      &QuantumEvolutionEngine::compute_observables_low_rank, DEFVAL(OBSERVABLE_ALL));
 
     // Eigenstate analysis methods
-    ClassDB::bind_method(D_METHOD("compute_eigenstates", "rho_data"),
-                         &QuantumEvolutionEngine::compute_eigenstates);
-    ClassDB::bind_method(D_METHOD("compute_dominant_eigenvector", "rho_data"),
-                         &QuantumEvolutionEngine::compute_dominant_eigenvector);
-    ClassDB::bind_method(D_METHOD("compute_eigenvalues", "rho_data"),
-                         &QuantumEvolutionEngine::compute_eigenvalues);
-    ClassDB::bind_method(D_METHOD("compute_cos2_similarity", "state_a", "state_b"),
-                         &QuantumEvolutionEngine::compute_cos2_similarity);
-    ClassDB::bind_method(D_METHOD("compute_batch_eigenstates", "biome_rhos"),
-                         &QuantumEvolutionEngine::compute_batch_eigenstates);
-    ClassDB::bind_method(D_METHOD("compute_eigenstate_similarity_matrix", "eigenvectors"),
-                         &QuantumEvolutionEngine::compute_eigenstate_similarity_matrix);
+    BIND_TIMED_METHOD(D_METHOD("compute_eigenstates", "rho_data"),
+                      &QuantumEvolutionEngine::compute_eigenstates);
+    BIND_TIMED_METHOD(D_METHOD("compute_dominant_eigenvector", "rho_data"),
+                      &QuantumEvolutionEngine::compute_dominant_eigenvector);
+    BIND_TIMED_METHOD(D_METHOD("track_dominant_eigenvector", "rho_data"),
+                      &QuantumEvolutionEngine::track_dominant_eigenvector);
+    BIND_TIMED_METHOD(D_METHOD("get_tracked_dominant_eigenvalue"),
+                      &QuantumEvolutionEngine::get_tracked_dominant_eigenvalue);
+    BIND_TIMED_METHOD(D_METHOD("get_last_eigen_iterations"),
+                      &QuantumEvolutionEngine::get_last_eigen_iterations);
+    BIND_TIMED_METHOD(D_METHOD("set_eigen_tracking_tolerance", "tolerance"),
+                      &QuantumEvolutionEngine::set_eigen_tracking_tolerance);
+    BIND_TIMED_METHOD(D_METHOD("get_eigen_tracking_tolerance"),
+                      &QuantumEvolutionEngine::get_eigen_tracking_tolerance);
+    BIND_TIMED_METHOD(D_METHOD("set_eigen_tracking_max_iterations", "iterations"),
+                      &QuantumEvolutionEngine::set_eigen_tracking_max_iterations);
+    BIND_TIMED_METHOD(D_METHOD("get_eigen_tracking_max_iterations"),
+                      &QuantumEvolutionEngine::get_eigen_tracking_max_iterations);
+    BIND_TIMED_METHOD(D_METHOD("reset_eigen_tracking"),
+                      &QuantumEvolutionEngine::reset_eigen_tracking);
+    BIND_TIMED_METHOD(D_METHOD("track_eigen_subspace", "rho_data", "k", "tolerance"),
+                      &QuantumEvolutionEngine::track_eigen_subspace, DEFVAL(1e-8));
+    BIND_TIMED_METHOD(D_METHOD("compute_eigenvalues", "rho_data"),
+                      &QuantumEvolutionEngine::compute_eigenvalues);
+    BIND_TIMED_METHOD(D_METHOD("compute_cos2_similarity", "state_a", "state_b"),
+                      &QuantumEvolutionEngine::compute_cos2_similarity);
+    BIND_TIMED_METHOD(D_METHOD("compute_batch_eigenstates", "biome_rhos"),
+                      &QuantumEvolutionEngine::compute_batch_eigenstates);
+    BIND_TIMED_METHOD(D_METHOD("compute_batch_eigenstates_packed", "rhos"),
+                      &QuantumEvolutionEngine::compute_batch_eigenstates_packed);
+    BIND_TIMED_METHOD(D_METHOD("compute_eigenstate_similarity_matrix", "eigenvectors"),
+                      &QuantumEvolutionEngine::compute_eigenstate_similarity_matrix);
 }
 
 QuantumEvolutionEngine::QuantumEvolutionEngine()
@@ -96,6 +464,7 @@ QuantumEvolutionEngine::~QuantumEvolutionEngine() {}
 void QuantumEvolutionEngine::set_dimension(int dim) {
     m_dim = dim;
     m_finalized = false;
+    m_operator_version++;  // Invalidates the coupling payload cache
 }
 
 void QuantumEvolutionEngine::set_hamiltonian(const PackedFloat64Array& H_packed) {
@@ -130,14 +499,10 @@ void QuantumEvolutionEngine::set_hamiltonian(const PackedFloat64Array& H_packed)
 
     m_has_hamiltonian = true;
     m_finalized = false;
+    m_operator_version++;  // Invalidates the coupling payload cache
 }
 
-void QuantumEvolutionEngine::add_lindblad_triplets(const PackedFloat64Array& triplets) {
-    if (m_dim == 0) {
-        UtilityFunctions::push_warning("QuantumEvolutionEngine: set_dimension first!");
-        return;
-    }
-
+bool QuantumEvolutionEngine::parse_triplets(const PackedFloat64Array& triplets, SparseCM& out) const {
     // Parse triplets: [row0, col0, re0, im0, row1, col1, re1, im1, ...]
     int num_entries = triplets.size() / 4;
     std::vector<Eigen::Triplet<std::complex<double>>> eigen_triplets;
@@ -149,152 +514,2895 @@ void QuantumEvolutionEngine::add_lindblad_triplets(const PackedFloat64Array& tri
         int col = static_cast<int>(ptr[i * 4 + 1]);
         double re = ptr[i * 4 + 2];
         double im = ptr[i * 4 + 3];
+        if (row < 0 || row >= m_dim || col < 0 || col >= m_dim) {
+            UtilityFunctions::push_warning("QuantumEvolutionEngine: triplet index out of range (", row, ", ", col, ")");
+            return false;
+        }
 
         if (std::abs(re) > 1e-15 || std::abs(im) > 1e-15) {
             eigen_triplets.emplace_back(row, col, std::complex<double>(re, im));
         }
     }
 
+    out.resize(m_dim, m_dim);
+    out.setFromTriplets(eigen_triplets.begin(), eigen_triplets.end());
+    out.makeCompressed();
+    return true;
+}
+
+void QuantumEvolutionEngine::add_lindblad_triplets(const PackedFloat64Array& triplets) {
+    if (m_dim == 0) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: set_dimension first!");
+        return;
+    }
+
     Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> L(m_dim, m_dim);
-    L.setFromTriplets(eigen_triplets.begin(), eigen_triplets.end());
-    L.makeCompressed();
+    if (!parse_triplets(triplets, L)) {
+        return;
+    }
+
+    m_lindblads.push_back(OperatorRegistry::intern(L));
+    m_finalized = false;
+    m_operator_version++;  // Invalidates the coupling payload cache
+}
+
+bool QuantumEvolutionEngine::build_operator_terms(const Array& terms, SparseCM& out) const {
+    if (m_dim == 0) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: set_dimension first!");
+        return false;
+    }
+    int num_qubits = 0;
+    while ((1 << num_qubits) < m_dim) {
+        num_qubits++;
+    }
+    if ((1 << num_qubits) != m_dim) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: operator terms need dim = 2^n");
+        return false;
+    }
+
+    const std::complex<double> i_unit(0.0, 1.0);
+    std::vector<Eigen::Triplet<std::complex<double>>> eigen_triplets;
+    for (int t = 0; t < terms.size(); t++) {
+        const Array term = terms[t];
+        if (term.size() < 2) {
+            UtilityFunctions::push_warning("QuantumEvolutionEngine: operator term ", t, " needs [ops, re, im]");
+            return false;
+        }
+        const std::complex<double> coef((double)term[1], term.size() > 2 ? (double)term[2] : 0.0);
+        const Variant::Type ops_type = term[0].get_type();
+
+        if (ops_type == Variant::STRING || ops_type == Variant::STRING_NAME) {
+            // A Pauli string maps |j⟩ to ±(i^nY)|j ^ x_mask⟩: X and Y flip their
+            // bit, Z and Y contribute (-1)^bit (Y|b⟩ = i(-1)^b |1-b⟩)
+            const String pauli = term[0];
+            if (pauli.length() != num_qubits) {
+                UtilityFunctions::push_warning("QuantumEvolutionEngine: Pauli string '", pauli, "' needs ",
+                                               num_qubits, " characters");
+                return false;
+            }
+            int x_mask = 0;
+            int sign_mask = 0;
+            std::complex<double> phase = coef;
+            for (int q = 0; q < num_qubits; q++) {
+                switch (pauli[q]) {
+                    case 'I':
+                        break;
+                    case 'X':
+                        x_mask |= 1 << q;
+                        break;
+                    case 'Y':
+                        x_mask |= 1 << q;
+                        sign_mask |= 1 << q;
+                        phase *= i_unit;
+                        break;
+                    case 'Z':
+                        sign_mask |= 1 << q;
+                        break;
+                    default:
+                        UtilityFunctions::push_warning("QuantumEvolutionEngine: bad Pauli string '", pauli, "'");
+                        return false;
+                }
+            }
+            eigen_triplets.reserve(eigen_triplets.size() + m_dim);
+            for (int j = 0; j < m_dim; j++) {
+                const bool negate = __builtin_popcount(j & sign_mask) & 1;
+                eigen_triplets.emplace_back(j ^ x_mask, j, negate ? -phase : phase);
+            }
+        } else if (ops_type == Variant::DICTIONARY) {
+            // Kronecker product of local 2×2 factors: column j spreads over
+            // the 2^k output patterns of the factor qubits
+            const Dictionary factors = term[0];
+            const Array keys = factors.keys();
+            const int k = keys.size();
+            std::vector<int> qubits(k);
+            std::vector<Eigen::Matrix2cd> mats(k);
+            int mask = 0;
+            for (int f = 0; f < k; f++) {
+                qubits[f] = keys[f];
+                const PackedFloat64Array packed = factors[keys[f]];
+                if (qubits[f] < 0 || qubits[f] >= num_qubits || packed.size() != 8) {
+                    UtilityFunctions::push_warning("QuantumEvolutionEngine: local factor needs a qubit in range and a packed 2×2");
+                    return false;
+                }
+                for (int r = 0; r < 2; r++) {
+                    for (int c = 0; c < 2; c++) {
+                        mats[f](r, c) = std::complex<double>(packed[(r * 2 + c) * 2], packed[(r * 2 + c) * 2 + 1]);
+                    }
+                }
+                mask |= 1 << qubits[f];
+            }
+            eigen_triplets.reserve(eigen_triplets.size() + ((size_t)m_dim << k));
+            for (int j = 0; j < m_dim; j++) {
+                for (int pattern = 0; pattern < (1 << k); pattern++) {
+                    std::complex<double> value = coef;
+                    int row = j & ~mask;
+                    for (int f = 0; f < k; f++) {
+                        const int in_bit = (j >> qubits[f]) & 1;
+                        const int out_bit = (pattern >> f) & 1;
+                        value *= mats[f](out_bit, in_bit);
+                        row |= out_bit << qubits[f];
+                    }
+                    if (value != std::complex<double>(0.0, 0.0)) {
+                        eigen_triplets.emplace_back(row, j, value);
+                    }
+                }
+            }
+        } else {
+            UtilityFunctions::push_warning("QuantumEvolutionEngine: operator term ", t,
+                                           " needs a Pauli string or a {qubit: 2×2} Dictionary");
+            return false;
+        }
+    }
+
+    // Duplicates sum; terms that cancel are dropped with the usual cut-off
+    out.resize(m_dim, m_dim);
+    out.setFromTriplets(eigen_triplets.begin(), eigen_triplets.end());
+    out.prune([](int, int, const std::complex<double>& value) {
+        return std::abs(value.real()) > 1e-15 || std::abs(value.imag()) > 1e-15;
+    });
+    out.makeCompressed();
+    return true;
+}
+
+void QuantumEvolutionEngine::set_hamiltonian_terms(const Array& terms) {
+    SparseCM H;
+    if (!build_operator_terms(terms, H)) {
+        return;
+    }
+    m_hamiltonian = std::move(H);
+
+    m_has_hamiltonian = true;
+    m_finalized = false;
+    m_operator_version++;  // Invalidates the coupling payload cache
+}
+
+void QuantumEvolutionEngine::add_lindblad_terms(const Array& terms) {
+    SparseCM L;
+    if (!build_operator_terms(terms, L)) {
+        return;
+    }
 
-    m_lindblads.push_back(L);
+    m_lindblads.push_back(OperatorRegistry::intern(L));
     m_finalized = false;
+    m_operator_version++;  // Invalidates the coupling payload cache
+}
+
+bool QuantumEvolutionEngine::parse_local_operator(
+    const PackedFloat64Array& op_packed, const PackedInt32Array& qubits, LocalOperator& out) const {
+    if (m_dim == 0) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: set_dimension first!");
+        return false;
+    }
+    int num_qubits = 0;
+    while ((1 << num_qubits) < m_dim) {
+        num_qubits++;
+    }
+    if ((1 << num_qubits) != m_dim) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: local operators need dim = 2^n");
+        return false;
+    }
+
+    const int k = qubits.size();
+    if (k < 1 || k > 2) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: local operators act on 1 or 2 qubits");
+        return false;
+    }
+    const int size = 1 << k;
+    if (op_packed.size() != size * size * 2) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: local operator must be packed 2×2 or 4×4");
+        return false;
+    }
+    for (int t = 0; t < k; t++) {
+        if (qubits[t] < 0 || qubits[t] >= num_qubits) {
+            UtilityFunctions::push_warning("QuantumEvolutionEngine: local operator qubit out of range");
+            return false;
+        }
+    }
+    if (k == 2 && qubits[0] == qubits[1]) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: local operator qubits must differ");
+        return false;
+    }
+
+    out = LocalOperator();
+    out.size = size;
+    for (int t = 0; t < k; t++) {
+        out.mask |= (1 << qubits[t]);
+    }
+    for (int a = 0; a < size; a++) {
+        // Local index digits: qubits[0] is the high digit
+        int offset = 0;
+        for (int t = 0; t < k; t++) {
+            int bit = (a >> (k - 1 - t)) & 1;
+            offset |= (bit << qubits[t]);
+        }
+        out.offsets[a] = offset;
+    }
+
+    const double* ptr = op_packed.ptr();
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            int idx = (i * size + j) * 2;
+            out.op(i, j) = std::complex<double>(ptr[idx], ptr[idx + 1]);
+        }
+    }
+    return true;
+}
+
+void QuantumEvolutionEngine::add_local_hamiltonian(
+    const PackedFloat64Array& op_packed, const PackedInt32Array& qubits) {
+    LocalOperator local;
+    if (!parse_local_operator(op_packed, qubits, local)) {
+        return;
+    }
+    m_local_hamiltonians.push_back(local);
+    m_finalized = false;
+    m_operator_version++;  // Invalidates the coupling payload cache
+}
+
+void QuantumEvolutionEngine::add_local_lindblad(
+    const PackedFloat64Array& op_packed, const PackedInt32Array& qubits) {
+    LocalOperator local;
+    if (!parse_local_operator(op_packed, qubits, local)) {
+        return;
+    }
+    m_local_lindblads.push_back(local);
+    m_finalized = false;
+    m_operator_version++;  // Invalidates the coupling payload cache
+}
+
+int QuantumEvolutionEngine::get_local_operator_count() const {
+    return static_cast<int>(m_local_hamiltonians.size() + m_local_lindblads.size());
+}
+
+Dictionary QuantumEvolutionEngine::get_operator_forms() const {
+    Dictionary d;
+    d["heff"] = m_has_heff ? OperatorForm::kind_name(m_heff_form.kind) : "";
+    Array lindblads;
+    for (const auto& L : m_lindblads) {
+        lindblads.append(OperatorForm::kind_name(L->L_form.kind));
+    }
+    d["lindblads"] = lindblads;
+    return d;
 }
 
 void QuantumEvolutionEngine::clear_operators() {
+    m_local_hamiltonians.clear();
+    m_local_lindblads.clear();
+    m_local_heff.clear();
     m_lindblads.clear();
-    m_lindblad_dags.clear();
-    m_LdagLs.clear();
     m_hamiltonian.resize(0, 0);
     m_has_hamiltonian = false;
+    m_heff.resize(0, 0);
+    m_has_heff = false;
+    m_heff_form = OperatorForm();
+    m_liouvillian.resize(0, 0);
+    m_has_liouvillian = false;
     m_finalized = false;
+    m_operator_version++;  // Invalidates the coupling payload cache
 }
 
 void QuantumEvolutionEngine::finalize() {
-    // Precompute L†, L†L for each Lindblad operator
-    m_lindblad_dags.clear();
-    m_LdagLs.clear();
-
-    m_lindblad_dags.reserve(m_lindblads.size());
-    m_LdagLs.reserve(m_lindblads.size());
-
-    for (const auto& L : m_lindblads) {
-        // L† (adjoint)
-        Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> L_dag = L.adjoint();
-        m_lindblad_dags.push_back(L_dag);
+    // L† and L†L come precomputed with each registered Lindblad operator
+    build_heff();
+    m_liouvillian.resize(0, 0);
+    m_has_liouvillian = false;
+    finalize_derived();
+}
 
-        // L†L
-        Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> LdagL = L_dag * L;
-        LdagL.makeCompressed();
-        m_LdagLs.push_back(LdagL);
+void QuantumEvolutionEngine::finalize_derived() {
+    // Same fold for local terms, merging operators that share a target set
+    m_local_heff.clear();
+    auto fold_local_heff = [this](const LocalOperator& src, const Eigen::Matrix4cd& term) {
+        for (auto& entry : m_local_heff) {
+            if (entry.size == src.size && entry.mask == src.mask &&
+                std::equal(entry.offsets, entry.offsets + 4, src.offsets)) {
+                entry.op += term;
+                return;
+            }
+        }
+        LocalOperator entry = src;
+        entry.op = term;
+        m_local_heff.push_back(entry);
+    };
+    for (const auto& H_loc : m_local_hamiltonians) {
+        fold_local_heff(H_loc, H_loc.op);
+    }
+    for (const auto& L_loc : m_local_lindblads) {
+        fold_local_heff(L_loc, std::complex<double>(0.0, -0.5) * (L_loc.op.adjoint() * L_loc.op));
     }
+    for (auto& entry : m_local_heff) {
+        entry.op_f = entry.op.cast<std::complex<float>>();
+    }
+    for (auto& L_loc : m_local_lindblads) {
+        L_loc.op_f = L_loc.op.cast<std::complex<float>>();
+    }
+    build_symmetry_sectors();
+    classify_channel_rates();
 
     // Pre-allocate scratch buffers to avoid per-frame allocation
     if (m_dim > 0) {
-        m_drho_buffer = Eigen::MatrixXcd::Zero(m_dim, m_dim);
-        m_temp_buffer = Eigen::MatrixXcd::Zero(m_dim, m_dim);
+        m_drho_buffer = RhoMatrix::Zero(m_dim, m_dim);
+        m_temp_buffer = RhoMatrix::Zero(m_dim, m_dim);
+    }
+    // Adaptive MI scratch for the qubits this dimension holds
+    int qubits = 0;
+    while ((2 << qubits) <= m_dim) {
+        qubits++;
+    }
+    reserve_mi_scratch(qubits);
+    m_stage_buffers.clear();  // Allocated lazily by integrate_dopri5()
+    m_dopri_h = 0.0;
+    m_krylov_basis.resize(0, 0);  // Allocated lazily by integrate_krylov()
+    m_krylov_tau = 0.0;
+    m_has_strang_basis = false;  // Rediagonalized on the next Strang step
+
+    // Assemble the vectorized Liouvillian once (one SpMV per step afterwards)
+    if (!m_has_liouvillian && m_use_liouvillian && m_dim > 0 && m_dim <= LIOUVILLIAN_MAX_DIM) {
+        build_liouvillian();
+    }
+    build_propagator();
+
+    if (m_single_precision) {
+        build_single_precision_operators();
     }
 
     m_finalized = true;
+    build_analytic_form();
 }
 
-int QuantumEvolutionEngine::get_dimension() const {
-    return m_dim;
+void QuantumEvolutionEngine::build_heff() {
+    // Fold every anticommutator into H_eff = H - (i/2) Σ L†L
+    m_heff.resize(m_dim, m_dim);
+    m_heff.setZero();
+    if (m_has_hamiltonian) {
+        m_heff = m_hamiltonian;
+    }
+    for (const auto& L : m_lindblads) {
+        m_heff += std::complex<double>(0.0, -0.5) * L->LdagL;
+    }
+    m_heff.prune(std::complex<double>(0.0, 0.0), 1e-15);
+    m_heff.makeCompressed();
+    m_has_heff = (m_heff.nonZeros() > 0);
+    build_heff_form();
 }
 
-int QuantumEvolutionEngine::get_lindblad_count() const {
-    return static_cast<int>(m_lindblads.size());
+void QuantumEvolutionEngine::build_heff_form() {
+    // Only H_eff·ρ runs in the drift (X + X† with X = -i H_eff ρ)
+    m_heff_form = m_has_heff ? OperatorForm::build(m_heff, true) : OperatorForm();
 }
 
-bool QuantumEvolutionEngine::is_finalized() const {
-    return m_finalized;
+bool QuantumEvolutionEngine::patch_liouvillian_drift(int r, int c, std::complex<double> delta) {
+    // build_liouvillian's drift is -i (H_eff ⊗ I) + i (I ⊗ H̄_eff), so H_eff(r, c)
+    // appears at (r·n + k, c·n + k) and, conjugated, at (k·n + r, k·n + c)
+    const int n = m_dim;
+    const std::complex<double> minus_i(0.0, -1.0);
+    for (int k = 0; k < n; k++) {
+        std::complex<double>* left = find_entry(m_liouvillian, r * n + k, c * n + k);
+        std::complex<double>* right = find_entry(m_liouvillian, k * n + r, k * n + c);
+        if (!left || !right) {
+            return false;
+        }
+        *left += minus_i * delta;
+        *right -= minus_i * std::conj(delta);
+    }
+    return true;
+}
+
+bool QuantumEvolutionEngine::update_hamiltonian_entries(const PackedFloat64Array& triplets) {
+    if (m_dim == 0) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: set_dimension first!");
+        return false;
+    }
+    if (triplets.size() % 4 != 0) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: update_hamiltonian_entries expects [row, col, re, im] quadruples");
+        return false;
+    }
+    const int num_entries = triplets.size() / 4;
+    const double* ptr = triplets.ptr();
+    for (int i = 0; i < num_entries; i++) {
+        const int row = static_cast<int>(ptr[i * 4]);
+        const int col = static_cast<int>(ptr[i * 4 + 1]);
+        if (row < 0 || row >= m_dim || col < 0 || col >= m_dim) {
+            UtilityFunctions::push_warning("QuantumEvolutionEngine: triplet index out of range (", row, ", ", col, ")");
+            return false;
+        }
+    }
+
+    if (!m_has_hamiltonian) {
+        m_hamiltonian.resize(m_dim, m_dim);
+        m_has_hamiltonian = true;
+    }
+    m_hamiltonian.makeCompressed();
+
+    // Each in-place patch below stays valid while every delta lands inside its pattern
+    bool heff_patched = m_finalized;
+    bool liouvillian_patched = m_finalized && m_has_liouvillian;
+    for (int i = 0; i < num_entries; i++) {
+        const int row = static_cast<int>(ptr[i * 4]);
+        const int col = static_cast<int>(ptr[i * 4 + 1]);
+        const std::complex<double> value(ptr[i * 4 + 2], ptr[i * 4 + 3]);
+
+        std::complex<double> old(0.0, 0.0);
+        if (std::complex<double>* h = find_entry(m_hamiltonian, row, col)) {
+            old = *h;
+            *h = value;
+        } else {
+            m_hamiltonian.coeffRef(row, col) = value;  // New nonzero: pattern grows
+            m_hamiltonian.makeCompressed();
+        }
+        const std::complex<double> delta = value - old;
+        if (delta == std::complex<double>(0.0, 0.0)) {
+            continue;
+        }
+
+        if (heff_patched) {
+            std::complex<double>* e = find_entry(m_heff, row, col);
+            if (e) {
+                *e += delta;
+            } else {
+                heff_patched = false;
+            }
+        }
+        if (liouvillian_patched) {
+            liouvillian_patched = heff_patched && patch_liouvillian_drift(row, col, delta);
+        }
+    }
+
+    if (m_finalized) {
+        if (!heff_patched) {
+            build_heff();
+        } else {
+            build_heff_form();
+        }
+        if (m_has_liouvillian && !liouvillian_patched) {
+            build_liouvillian();
+        }
+        if (m_single_precision) {
+            m_heff_f = m_heff.cast<std::complex<float>>();
+            if (m_has_liouvillian) {
+                m_liouvillian_f = m_liouvillian.cast<std::complex<float>>();
+            }
+        }
+        build_symmetry_sectors();
+        build_propagator();
+    }
+    m_operator_version++;  // Invalidates the coupling payload cache
+    return true;
+}
+
+bool QuantumEvolutionEngine::replace_lindblad(int k, const PackedFloat64Array& triplets) {
+    if (k < 0 || k >= static_cast<int>(m_lindblads.size())) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: replace_lindblad index ", k, " out of range");
+        return false;
+    }
+    SparseCM L(m_dim, m_dim);
+    if (!parse_triplets(triplets, L)) {
+        return false;
+    }
+    // Interning yields L_k's L† and L†L (shared if another biome holds the same operator)
+    std::shared_ptr<const SharedLindblad> old_entry = m_lindblads[k];
+    m_lindblads[k] = OperatorRegistry::intern(L);
+    m_operator_version++;  // Invalidates the coupling payload cache
+    if (!m_finalized) {
+        return true;  // finalize() derives everything later
+    }
+
+    // Same L†L pattern: shift H_eff in place by -(i/2)(L†L_new - L†L_old)
+    const SparseCM& LdagL = m_lindblads[k]->LdagL;
+    bool heff_patched = same_pattern(LdagL, old_entry->LdagL);
+    if (heff_patched) {
+        const std::complex<double> minus_half_i(0.0, -0.5);
+        const SparseCM& old = old_entry->LdagL;
+        for (int r = 0; r < LdagL.outerSize() && heff_patched; r++) {
+            SparseCM::InnerIterator it_old(old, r);
+            for (SparseCM::InnerIterator it(LdagL, r); it; ++it, ++it_old) {
+                std::complex<double>* e = find_entry(m_heff, r, static_cast<int>(it.col()));
+                if (!e) {
+                    heff_patched = false;  // Pruned by cancellation: rebuild below
+                    break;
+                }
+                *e += minus_half_i * (it.value() - it_old.value());
+            }
+        }
+    }
+    if (!heff_patched) {
+        build_heff();
+    } else {
+        build_heff_form();
+    }
+
+    // The jump block L ⊗ L̄ changes with L itself: reassemble the superoperator
+    if (m_has_liouvillian) {
+        build_liouvillian();
+    }
+    if (m_single_precision) {
+        m_heff_f = m_heff.cast<std::complex<float>>();
+        if (m_has_liouvillian) {
+            m_liouvillian_f = m_liouvillian.cast<std::complex<float>>();
+        }
+    }
+    build_symmetry_sectors();
+    classify_channel_rates();
+    build_propagator();
+    return true;
+}
+
+void QuantumEvolutionEngine::build_single_precision_operators() {
+    m_heff_f = m_heff.cast<std::complex<float>>();
+    if (m_has_liouvillian) {
+        m_liouvillian_f = m_liouvillian.cast<std::complex<float>>();
+    } else {
+        m_liouvillian_f.resize(0, 0);
+    }
+    m_rho_f = RhoMatrixF::Zero(m_dim, m_dim);
+    m_drho_f = RhoMatrixF::Zero(m_dim, m_dim);
+    m_temp_f = RhoMatrixF::Zero(m_dim, m_dim);
+    m_steps_since_resync = 0;
+}
+
+void QuantumEvolutionEngine::euler_step_single(RhoRef rho, double dt) {
+    if (++m_steps_since_resync >= m_resync_interval) {
+        // Resync: one full double step, then remove the anti-Hermitian part and
+        // trace error that float rounding accumulated over the last interval
+        m_steps_since_resync = 0;
+        compute_drho(rho, m_drho_buffer);
+        rho += dt * m_drho_buffer;
+        lindblad::hermitian_sum(rho, m_temp_buffer);
+        rho = 0.5 * m_temp_buffer;
+        double trace = rho.diagonal().real().sum();
+        if (std::isfinite(trace) && trace > 1e-12) {
+            rho *= (1.0 / trace);
+        }
+        cap_trace_and_clamp_diag(rho);
+        return;
+    }
+
+    const bool sample_drift = drift_sample_due();
+    const double trace_before = sample_drift ? rho.trace().real() : 0.0;
+    m_rho_f = rho.cast<std::complex<float>>();
+    const std::complex<float> minus_i(0.0f, -1.0f);
+
+    if (m_has_liouvillian) {
+        const int n2 = m_dim * m_dim;
+        Eigen::Map<const Eigen::VectorXcf> rho_vec(m_rho_f.data(), n2);
+        Eigen::Map<Eigen::VectorXcf> drho_vec(m_drho_f.data(), n2);
+        drho_vec.noalias() = m_liouvillian_f * rho_vec;
+    } else {
+        if (m_has_heff || !m_local_heff.empty()) {
+            if (m_has_heff) {
+                m_temp_f.noalias() = minus_i * (m_heff_f * m_rho_f);
+            } else {
+                m_temp_f.setZero();
+            }
+            for (const auto& entry : m_local_heff) {
+                local_apply_left(entry.op_f, entry.size, entry.mask, entry.offsets, minus_i, m_rho_f, m_temp_f);
+            }
+            lindblad::hermitian_sum(m_temp_f, m_drho_f);
+        } else {
+            m_drho_f.setZero();
+        }
+        for (const auto& L : m_lindblads) {
+            m_temp_f.noalias() = L->lindblad_f() * m_rho_f;
+            m_drho_f.noalias() += m_temp_f * L->lindblad_dag_f();
+        }
+        const std::complex<float> one(1.0f, 0.0f);
+        for (const auto& L_loc : m_local_lindblads) {
+            m_temp_f.setZero();
+            local_apply_left(L_loc.op_f, L_loc.size, L_loc.mask, L_loc.offsets, one, m_rho_f, m_temp_f);
+            local_apply_right_adjoint(L_loc.op_f, L_loc.size, L_loc.mask, L_loc.offsets, one, m_temp_f, m_drho_f);
+        }
+    }
+
+    m_rho_f += static_cast<float>(dt) * m_drho_f;
+    rho = m_rho_f.cast<std::complex<double>>();
+    if (sample_drift) {
+        record_drift(rho, trace_before);
+    }
+    cap_trace_and_clamp_diag(rho);
+}
+
+void QuantumEvolutionEngine::set_single_precision(bool enabled) {
+    if (m_single_precision == enabled) {
+        return;
+    }
+    m_single_precision = enabled;
+    if (!enabled) {
+        m_heff_f.resize(0, 0);
+        m_liouvillian_f.resize(0, 0);
+        m_rho_f.resize(0, 0);
+        m_drho_f.resize(0, 0);
+        m_temp_f.resize(0, 0);
+    } else if (m_finalized) {
+        build_single_precision_operators();
+    }
+}
+
+bool QuantumEvolutionEngine::get_single_precision() const {
+    return m_single_precision;
+}
+
+void QuantumEvolutionEngine::set_precision_resync_interval(int steps) {
+    m_resync_interval = std::max(1, steps);
+}
+
+int QuantumEvolutionEngine::get_precision_resync_interval() const {
+    return m_resync_interval;
+}
+
+void QuantumEvolutionEngine::set_drift_monitor(int interval, int pairs) {
+    m_drift_interval = std::max(0, interval);
+    m_drift_pairs = std::max(0, pairs);
+    m_drift_countdown = 0;
+}
+
+void QuantumEvolutionEngine::set_drift_thresholds(double trace_error, double hermiticity_error,
+                                                  double negative_mass) {
+    m_drift_threshold[0] = std::max(0.0, trace_error);
+    m_drift_threshold[1] = std::max(0.0, hermiticity_error);
+    m_drift_threshold[2] = std::max(0.0, negative_mass);
+}
+
+void QuantumEvolutionEngine::set_drift_fallback_enabled(bool enabled) {
+    m_drift_fallback = enabled;
 }
 
-PackedFloat64Array QuantumEvolutionEngine::evolve_step(const PackedFloat64Array& rho_data, float dt) {
-    if (!m_finalized) {
-        UtilityFunctions::push_warning("QuantumEvolutionEngine: call finalize() first!");
-        return rho_data;  // Return unchanged
+bool QuantumEvolutionEngine::is_drift_fallback_enabled() const {
+    return m_drift_fallback;
+}
+
+int QuantumEvolutionEngine::get_drift_level() const {
+    return m_drift_level;
+}
+
+Dictionary QuantumEvolutionEngine::get_drift_stats() const {
+    Dictionary stats;
+    stats["trace_error"] = m_drift_last[0];
+    stats["hermiticity_error"] = m_drift_last[1];
+    stats["negative_mass"] = m_drift_last[2];
+    stats["max_trace_error"] = m_drift_max[0];
+    stats["max_hermiticity_error"] = m_drift_max[1];
+    stats["max_negative_mass"] = m_drift_max[2];
+    stats["samples"] = m_drift_samples;
+    stats["escalations"] = m_drift_escalations;
+    stats["level"] = m_drift_level;
+    return stats;
+}
+
+void QuantumEvolutionEngine::reset_drift_monitor() {
+    for (int k = 0; k < 3; k++) {
+        m_drift_last[k] = 0.0;
+        m_drift_max[k] = 0.0;
+    }
+    m_drift_samples = 0;
+    m_drift_escalations = 0;
+    m_drift_level = DRIFT_EULER;
+    m_drift_countdown = 0;
+}
+
+bool QuantumEvolutionEngine::drift_sample_due() {
+    if (m_drift_interval == 0 || --m_drift_countdown > 0) {
+        return false;
+    }
+    m_drift_countdown = m_drift_interval;
+    return true;
+}
+
+void QuantumEvolutionEngine::record_drift(RhoConstRef rho, double trace_before) {
+    const int64_t dim = rho.rows();
+    if (dim == 0) {
+        return;
+    }
+
+    // Diagonal terms are O(dim); Hermiticity is sampled on rotating pairs
+    double trace = 0.0;
+    double negative = 0.0;
+    for (int64_t i = 0; i < dim; i++) {
+        const double re = rho(i, i).real();
+        trace += re;
+        negative += std::max(0.0, -re);
+    }
+    double hermiticity = 0.0;
+    const uint64_t elements = static_cast<uint64_t>(dim) * static_cast<uint64_t>(dim);
+    for (int k = 0; k < m_drift_pairs; k++) {
+        // Odd multiplier of the golden ratio: consecutive samples spread over ρ
+        const uint64_t flat = (m_drift_cursor++ * 0x9E3779B97F4A7C15ull) % elements;
+        const int64_t i = static_cast<int64_t>(flat / dim);
+        const int64_t j = static_cast<int64_t>(flat % dim);
+        hermiticity = std::max(hermiticity, std::abs(rho(i, j) - std::conj(rho(j, i))));
+    }
+
+    const double sample[3] = {std::abs(trace - trace_before), hermiticity, negative};
+    bool exceeded = false;
+    for (int k = 0; k < 3; k++) {
+        m_drift_last[k] = sample[k];
+        m_drift_max[k] = std::max(m_drift_max[k], sample[k]);
+        exceeded = exceeded || !(sample[k] <= m_drift_threshold[k]);
+    }
+    m_drift_samples++;
+    if (exceeded && m_drift_fallback && m_drift_level < DRIFT_KRAUS) {
+        m_drift_level++;
+        m_drift_escalations++;
+    }
+}
+
+void QuantumEvolutionEngine::build_liouvillian() {
+    // Row-stacked vectorization (RhoMatrix storage): vec(A X B) = (A ⊗ Bᵀ) vec(X)
+    //   -i(H_eff ρ - ρ H_eff†) → -i (H_eff ⊗ I) + i (I ⊗ H̄_eff)
+    //   L ρ L†                  → (L ⊗ L̄)
+    const int n = m_dim;
+    SparseCM identity(n, n);
+    identity.setIdentity();
+
+    std::vector<Eigen::Triplet<std::complex<double>>> triplets;
+    size_t estimate = 0;
+    if (m_has_heff) {
+        estimate += 2 * static_cast<size_t>(m_heff.nonZeros()) * n;
+    }
+    for (const auto& L : m_lindblads) {
+        size_t nnz_l = static_cast<size_t>(L->L.nonZeros());
+        estimate += nnz_l * nnz_l;
+    }
+    triplets.reserve(estimate);
+
+    const std::complex<double> minus_i(0.0, -1.0);
+    if (m_has_heff) {
+        SparseCM heff_conj = m_heff.conjugate();
+        append_kron(triplets, m_heff, identity, minus_i, n);
+        append_kron(triplets, identity, heff_conj, -minus_i, n);
+    }
+
+    for (const auto& L : m_lindblads) {
+        SparseCM L_conj = L->L.conjugate();
+        append_kron(triplets, L->L, L_conj, 1.0, n);
+    }
+
+    // Local terms are small enough at this dim to embed as sparse operators
+    for (const auto& entry : m_local_heff) {
+        SparseCM heff_loc = expand_local(entry.op, entry.size, entry.mask, entry.offsets, n);
+        SparseCM heff_loc_conj = heff_loc.conjugate();
+        append_kron(triplets, heff_loc, identity, minus_i, n);
+        append_kron(triplets, identity, heff_loc_conj, -minus_i, n);
+    }
+    for (const auto& L_loc : m_local_lindblads) {
+        SparseCM L = expand_local(L_loc.op, L_loc.size, L_loc.mask, L_loc.offsets, n);
+        SparseCM L_conj = L.conjugate();
+        append_kron(triplets, L, L_conj, 1.0, n);
+    }
+
+    // setFromTriplets sums duplicates, merging the overlapping Kronecker terms
+    m_liouvillian.resize(n * n, n * n);
+    m_liouvillian.setFromTriplets(triplets.begin(), triplets.end());
+    m_liouvillian.prune(std::complex<double>(0.0, 0.0), 1e-15);
+    m_liouvillian.makeCompressed();
+    m_has_liouvillian = true;
+}
+
+void QuantumEvolutionEngine::compute_drho(RhoConstRef rho, RhoRef drho) {
+    if (m_sector_step) {
+        compute_drho_sectors(rho, drho);
+        return;
+    }
+    if (m_has_liouvillian) {
+        // RhoMatrix is row-major, so its (contiguous) storage already is vec(ρ)
+        const int n2 = m_dim * m_dim;
+        Eigen::Map<const Eigen::VectorXcd> rho_vec(rho.data(), n2);
+        Eigen::Map<Eigen::VectorXcd> drho_vec(drho.data(), n2);
+        drho_vec.noalias() = m_liouvillian * rho_vec;
+        return;
+    }
+
+    lindblad::Generator gen;
+    gen.heff = m_has_heff ? &m_heff : nullptr;
+    gen.heff_form = &m_heff_form;
+    gen.local_heff = &m_local_heff;
+    gen.lindblads = &m_lindblads;
+    gen.local_lindblads = &m_local_lindblads;
+    lindblad::compute_drho(gen, rho, drho, m_temp_buffer);
+}
+
+void QuantumEvolutionEngine::compute_drho_general(RhoConstRef x, RhoRef drho) {
+    if (m_has_liouvillian) {
+        compute_drho(x, drho);  // The SpMV makes no Hermiticity assumption
+        return;
+    }
+
+    // -i H_eff X + i X H_eff† + Σ_k L_k X L_k†, without the X + X† shortcut
+    const std::complex<double> minus_i(0.0, -1.0);
+    const std::complex<double> plus_i(0.0, 1.0);
+    const std::complex<double> one(1.0, 0.0);
+    drho.setZero();
+    if (m_has_heff && !m_heff_form.is_csr()) {
+        m_heff_form.apply_left(minus_i, x, drho);
+        m_heff_form.apply_right_adjoint(plus_i, x, drho);
+    } else if (m_has_heff) {
+        drho.noalias() += minus_i * (m_heff * x);
+        drho.noalias() += plus_i * (x * m_heff.adjoint());
+    }
+    for (const auto& entry : m_local_heff) {
+        local_apply_left(entry.op, entry.size, entry.mask, entry.offsets, minus_i, x, drho);
+        local_apply_right_adjoint(entry.op, entry.size, entry.mask, entry.offsets, plus_i, x, drho);
+    }
+    for (const auto& L : m_lindblads) {
+        if (!L->L_form.is_csr()) {
+            L->L_form.apply_sandwich(one, x, drho, m_temp_buffer);
+            continue;
+        }
+        m_temp_buffer.noalias() = L->L * x;
+        drho.noalias() += m_temp_buffer * L->L_dag;
+    }
+    for (const auto& L_loc : m_local_lindblads) {
+        m_temp_buffer.setZero();
+        local_apply_left(L_loc.op, L_loc.size, L_loc.mask, L_loc.offsets, one, x, m_temp_buffer);
+        local_apply_right_adjoint(L_loc.op, L_loc.size, L_loc.mask, L_loc.offsets, one, m_temp_buffer, drho);
+    }
+}
+
+void QuantumEvolutionEngine::build_propagator() {
+    m_propagator.resize(0, 0);
+    m_propagator_work.resize(0);
+    m_has_propagator = false;
+    if (m_propagator_dt <= 0.0 || m_dim <= 0 || m_dim > PROPAGATOR_MAX_DIM) {
+        return;
+    }
+    const bool kept = m_has_liouvillian;
+    if (!kept) {
+        build_liouvillian();
+    }
+    const Eigen::MatrixXcd generator = Eigen::MatrixXcd(m_liouvillian) * m_propagator_dt;
+    m_propagator = generator.exp();
+    if (!kept) {
+        m_liouvillian.resize(0, 0);
+        m_has_liouvillian = false;
+    }
+    m_propagator_work.resize(static_cast<Eigen::Index>(m_dim) * m_dim);
+    m_has_propagator = true;
+}
+
+void QuantumEvolutionEngine::set_propagator_dt(double dt) {
+    const double value = std::max(0.0, dt);
+    if (value == m_propagator_dt) {
+        return;
+    }
+    m_propagator_dt = value;
+    if (m_finalized) {
+        build_propagator();
+    }
+}
+
+double QuantumEvolutionEngine::get_propagator_dt() const {
+    return m_propagator_dt;
+}
+
+bool QuantumEvolutionEngine::has_propagator() const {
+    return m_has_propagator;
+}
+
+void QuantumEvolutionEngine::build_symmetry_sectors() {
+    m_sectors.clear();
+    m_sector_of.clear();
+    m_sector_step = false;
+    if (!m_use_symmetry_sectors || m_dim < 2) {
+        return;
+    }
+
+    // Every term as a full sparse operator (local terms expanded)
+    const int n = m_dim;
+    SparseCM heff = m_has_heff ? m_heff : SparseCM(n, n);
+    for (const auto& entry : m_local_heff) {
+        heff += expand_local(entry.op, entry.size, entry.mask, entry.offsets, n);
+    }
+    std::vector<const SparseCM*> jumps;
+    std::vector<SparseCM> local_jumps;
+    local_jumps.reserve(m_local_lindblads.size());
+    for (const auto& L : m_lindblads) {
+        jumps.push_back(&L->L);
+    }
+    for (const auto& L_loc : m_local_lindblads) {
+        local_jumps.push_back(expand_local(L_loc.op, L_loc.size, L_loc.mask, L_loc.offsets, n));
+        jumps.push_back(&local_jumps.back());
+    }
+
+    // Connected components of the union sparsity graph (union-find)
+    std::vector<int> parent(n);
+    for (int i = 0; i < n; i++) {
+        parent[i] = i;
+    }
+    auto find = [&parent](int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    auto link = [&](const SparseCM& m) {
+        for (int r = 0; r < m.outerSize(); r++) {
+            for (SparseCM::InnerIterator it(m, r); it; ++it) {
+                const int a = find(r);
+                const int b = find(static_cast<int>(it.col()));
+                if (a != b) {
+                    parent[std::max(a, b)] = std::min(a, b);
+                }
+            }
+        }
+    };
+    link(heff);
+    for (const SparseCM* L : jumps) {
+        link(*L);
+    }
+
+    // Sectors numbered by their lowest basis state
+    std::vector<int> sector_of(n, -1);
+    std::vector<int> local_index(n, 0);
+    std::vector<std::vector<int>> states;
+    for (int i = 0; i < n; i++) {
+        const int root = find(i);
+        if (sector_of[root] < 0) {
+            sector_of[root] = static_cast<int>(states.size());
+            states.emplace_back();
+        }
+        sector_of[i] = sector_of[root];
+        local_index[i] = static_cast<int>(states[sector_of[i]].size());
+        states[sector_of[i]].push_back(i);
+    }
+    if (states.size() < 2) {
+        return;
+    }
+
+    // Restrict each operator to its blocks (no term crosses sectors by construction)
+    const int count = static_cast<int>(states.size());
+    typedef std::vector<Eigen::Triplet<std::complex<double>>> TripletList;
+    auto split = [&](const SparseCM& m) {
+        std::vector<TripletList> blocks(count);
+        for (int r = 0; r < m.outerSize(); r++) {
+            for (SparseCM::InnerIterator it(m, r); it; ++it) {
+                blocks[sector_of[r]].emplace_back(local_index[r], local_index[it.col()], it.value());
+            }
+        }
+        return blocks;
+    };
+    auto to_sparse = [](const TripletList& triplets, int size) {
+        SparseCM out(size, size);
+        out.setFromTriplets(triplets.begin(), triplets.end());
+        out.makeCompressed();
+        return out;
+    };
+    m_sectors.resize(count);
+    for (int s = 0; s < count; s++) {
+        m_sectors[s].states = std::move(states[s]);
+    }
+    const std::vector<TripletList> heff_blocks = split(heff);
+    for (int s = 0; s < count; s++) {
+        SymmetrySector& sector = m_sectors[s];
+        const int size = static_cast<int>(sector.states.size());
+        sector.heff = to_sparse(heff_blocks[s], size);
+        sector.rho = RhoMatrix::Zero(size, size);
+        sector.drho = RhoMatrix::Zero(size, size);
+        sector.temp = RhoMatrix::Zero(size, size);
+    }
+    for (const SparseCM* L : jumps) {
+        const std::vector<TripletList> blocks = split(*L);
+        for (int s = 0; s < count; s++) {
+            if (!blocks[s].empty()) {
+                const int size = static_cast<int>(m_sectors[s].states.size());
+                m_sectors[s].jumps.push_back(OperatorRegistry::intern(to_sparse(blocks[s], size)));
+            }
+        }
+    }
+    m_sector_of = std::move(sector_of);
+}
+
+bool QuantumEvolutionEngine::is_sector_diagonal(RhoConstRef rho) const {
+    const std::complex<double> zero(0.0, 0.0);
+    for (int i = 0; i < m_dim; i++) {
+        const int sector = m_sector_of[i];
+        for (int j = 0; j < m_dim; j++) {
+            if (m_sector_of[j] != sector && rho(i, j) != zero) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void QuantumEvolutionEngine::compute_drho_sectors(RhoConstRef rho, RhoRef drho) {
+    static const std::vector<LocalOperator> no_local_terms;
+    drho.setZero();
+    auto sector_range = [&](int begin, int end) {
+        for (int s = begin; s < end; s++) {
+            SymmetrySector& sector = m_sectors[s];
+            const std::vector<int>& states = sector.states;
+            const int size = static_cast<int>(states.size());
+            for (int a = 0; a < size; a++) {
+                for (int b = 0; b < size; b++) {
+                    sector.rho(a, b) = rho(states[a], states[b]);
+                }
+            }
+            lindblad::Generator gen;
+            gen.heff = sector.heff.nonZeros() > 0 ? &sector.heff : nullptr;
+            gen.local_heff = &no_local_terms;
+            gen.lindblads = &sector.jumps;
+            gen.local_lindblads = &no_local_terms;
+            lindblad::compute_drho(gen, sector.rho, sector.drho, sector.temp);
+            // Sectors own disjoint elements of drho
+            for (int a = 0; a < size; a++) {
+                for (int b = 0; b < size; b++) {
+                    drho(states[a], states[b]) = sector.drho(a, b);
+                }
+            }
+        }
+    };
+    const int count = static_cast<int>(m_sectors.size());
+    if (m_dim >= SECTOR_PARALLEL_MIN_DIM && NativeThreadPool::shared().thread_count() > 1) {
+        NativeThreadPool::shared().parallel_for(0, count, 0, sector_range);
+    } else {
+        sector_range(0, count);
+    }
+}
+
+void QuantumEvolutionEngine::set_use_symmetry_sectors(bool enabled) {
+    if (m_use_symmetry_sectors == enabled) {
+        return;
+    }
+    m_use_symmetry_sectors = enabled;
+    if (m_finalized) {
+        build_symmetry_sectors();
+    }
+}
+
+bool QuantumEvolutionEngine::get_use_symmetry_sectors() const {
+    return m_use_symmetry_sectors;
+}
+
+int QuantumEvolutionEngine::get_symmetry_sector_count() const {
+    return static_cast<int>(m_sectors.size());
+}
+
+PackedInt32Array QuantumEvolutionEngine::get_symmetry_sector_sizes() const {
+    PackedInt32Array sizes;
+    sizes.resize(static_cast<int64_t>(m_sectors.size()));
+    for (size_t s = 0; s < m_sectors.size(); s++) {
+        sizes.set(static_cast<int64_t>(s), static_cast<int32_t>(m_sectors[s].states.size()));
+    }
+    return sizes;
+}
+
+void QuantumEvolutionEngine::build_rate_matrix() {
+    m_rate_built = m_finalized;
+    m_rate_version = m_operator_version;
+    m_rate_eligible = false;
+    m_rate_matrix.resize(0, 0);
+    m_rate_out.resize(0);
+    m_rate_max = 0.0;
+    if (!m_finalized || m_dim <= 0) {
+        return;
+    }
+    const int n = m_dim;
+
+    // Every jump as a full matrix (local ones embedded)
+    std::vector<SparseCM> local_jumps;
+    local_jumps.reserve(m_local_lindblads.size());
+    std::vector<const SparseCM*> jumps;
+    for (const auto& L : m_lindblads) {
+        jumps.push_back(&L->L);
+    }
+    for (const auto& L_loc : m_local_lindblads) {
+        local_jumps.push_back(expand_local(L_loc.op, L_loc.size, L_loc.mask, L_loc.offsets, n));
+        jumps.push_back(&local_jumps.back());
+    }
+
+    // Transitions, column norms (L†L)(j, j) for the coherence decay, and
+    // the diagonal entries that keep a coherence alive under dephasing
+    std::vector<Eigen::Triplet<double>> rates;
+    Eigen::VectorXd out_rate = Eigen::VectorXd::Zero(n);
+    Eigen::VectorXd decay = Eigen::VectorXd::Zero(n);
+    std::vector<Eigen::VectorXcd> diagonals;
+    std::vector<int> column_count(n);
+    for (const SparseCM* L : jumps) {
+        std::fill(column_count.begin(), column_count.end(), 0);
+        Eigen::VectorXcd diagonal = Eigen::VectorXcd::Zero(n);
+        bool has_diagonal = false;
+        for (int i = 0; i < n; i++) {
+            for (SparseCM::InnerIterator it(*L, i); it; ++it) {
+                const int j = static_cast<int>(it.col());
+                const double w = std::norm(it.value());
+                if (w == 0.0) {
+                    continue;
+                }
+                if (++column_count[j] > 1) {
+                    return;  // Maps a basis state onto a superposition
+                }
+                decay(j) += w;
+                if (i == j) {
+                    diagonal(i) = it.value();
+                    has_diagonal = true;
+                } else {
+                    rates.emplace_back(i, j, w);
+                    out_rate(j) += w;
+                }
+            }
+        }
+        if (has_diagonal) {
+            diagonals.push_back(std::move(diagonal));
+        }
+    }
+
+    // Coherent couplings, each eliminated into a symmetric hopping rate
+    SparseCM H(n, n);
+    if (m_has_hamiltonian) {
+        H = m_hamiltonian;
+    }
+    for (const auto& H_loc : m_local_hamiltonians) {
+        H += expand_local(H_loc.op, H_loc.size, H_loc.mask, H_loc.offsets, n);
+    }
+    const Eigen::VectorXd energy = Eigen::VectorXcd(H.diagonal()).real();
+    for (int i = 0; i < n; i++) {
+        for (SparseCM::InnerIterator it(H, i); it; ++it) {
+            const int j = static_cast<int>(it.col());
+            const double coupling = std::abs(it.value());
+            if (j <= i || coupling <= 1e-15) {
+                continue;
+            }
+            double gamma = 0.5 * (decay(i) + decay(j));
+            for (const auto& diagonal : diagonals) {
+                gamma -= (diagonal(i) * std::conj(diagonal(j))).real();
+            }
+            if (gamma < POPULATION_MIN_DEPHASING_RATIO * coupling) {
+                return;  // Coherent enough to matter
+            }
+            const double delta = energy(i) - energy(j);
+            const double kappa = 2.0 * coupling * coupling * gamma / (gamma * gamma + delta * delta);
+            rates.emplace_back(i, j, kappa);
+            rates.emplace_back(j, i, kappa);
+            out_rate(i) += kappa;
+            out_rate(j) += kappa;
+        }
+    }
+
+    m_rate_matrix.resize(n, n);
+    m_rate_matrix.setFromTriplets(rates.begin(), rates.end());
+    m_rate_matrix.makeCompressed();
+    m_rate_out = out_rate;
+    m_rate_max = out_rate.maxCoeff();
+    m_population.resize(n);
+    m_population_next.resize(n);
+    m_rate_eligible = true;
+}
+
+bool QuantumEvolutionEngine::coherences_below(RhoConstRef rho, double threshold) const {
+    const double limit = threshold * threshold;
+    const int n = static_cast<int>(rho.rows());
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            if (std::norm(rho(i, j)) > limit) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void QuantumEvolutionEngine::evolve_populations(RhoRef rho, double covered, double h_max) {
+    double h_limit = h_max;
+    if (m_rate_max > 0.0) {
+        h_limit = std::min(h_limit, POPULATION_SUBSTEP_CFL / m_rate_max);
+    }
+    const int steps = std::max(1, static_cast<int>(std::ceil(covered / h_limit - 1e-9)));
+    const double h = covered / steps;
+    m_population = rho.diagonal().real();
+    for (int s = 0; s < steps; s++) {
+        // W's columns sum to zero with the out-rates, so Σp is conserved
+        m_population_next = m_population - h * m_rate_out.cwiseProduct(m_population);
+        m_population_next.noalias() += h * (m_rate_matrix * m_population);
+        m_population.swap(m_population_next);
+    }
+    rho.setZero();
+    rho.diagonal() = m_population.cast<std::complex<double>>();
+    m_last_substeps = steps;
+    m_last_rhs_evals = steps;
+}
+
+void QuantumEvolutionEngine::set_population_mode_threshold(double threshold) {
+    m_population_threshold = std::max(0.0, threshold);
+}
+
+double QuantumEvolutionEngine::get_population_mode_threshold() const {
+    return m_population_threshold;
+}
+
+bool QuantumEvolutionEngine::is_population_mode_eligible() {
+    if (!m_rate_built || m_rate_version != m_operator_version) {
+        build_rate_matrix();
+    }
+    return m_rate_eligible;
+}
+
+bool QuantumEvolutionEngine::get_last_population_step() const {
+    return m_last_population_step;
+}
+
+void QuantumEvolutionEngine::build_sparse_rho_operators() {
+    const int n = m_dim;
+    SparseCM heff = m_heff;
+    for (const auto& entry : m_local_heff) {
+        heff += expand_local(entry.op, entry.size, entry.mask, entry.offsets, n);
+    }
+    m_sparse_heff_adj = SparseCM(heff.adjoint());
+    m_sparse_local_jumps_adj.clear();
+    m_sparse_local_jumps_adj.reserve(m_local_lindblads.size());  // Pointers below stay valid
+    m_sparse_jumps_adj.clear();
+    for (const auto& L : m_lindblads) {
+        m_sparse_jumps_adj.push_back(&L->L_dag);
+    }
+    for (const auto& L_loc : m_local_lindblads) {
+        const SparseCM L = expand_local(L_loc.op, L_loc.size, L_loc.mask, L_loc.offsets, n);
+        m_sparse_local_jumps_adj.push_back(SparseCM(L.adjoint()));
+        m_sparse_jumps_adj.push_back(&m_sparse_local_jumps_adj.back());
+    }
+    m_sparse_ops_version = m_operator_version;
+    m_sparse_ops_built = true;
+}
+
+bool QuantumEvolutionEngine::sparse_euler_step(RhoRef rho, double h) {
+    m_last_sparse_rho_nnz = 0;
+    if (m_drift_interval != 0 && m_drift_countdown <= 1) {
+        return false;  // The drift monitor samples this step
+    }
+    if (!m_sparse_ops_built || m_sparse_ops_version != m_operator_version) {
+        build_sparse_rho_operators();
+    }
+    const int n = m_dim;
+    const double limit = m_sparse_rho_threshold * m_sparse_rho_threshold;
+    const size_t max_nnz = static_cast<size_t>(SPARSE_RHO_MAX_FILL * n * n);
+    m_sparse_rho.clear();
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (std::norm(rho(i, j)) > limit) {
+                if (m_sparse_rho.size() == max_nnz) {
+                    return false;  // Fill-in guard: this step runs dense
+                }
+                m_sparse_rho.push_back({i, j, rho(i, j)});
+            }
+        }
+    }
+    drift_sample_due();  // Counts the step (not due, checked above)
+
+    // Column a of A is row a of A†: A(r, i) = conj(A†(i, r)). Each entry
+    // v = ρ(i, j) adds X(r, j) += -i H_eff(r, i) v and its mirror X†(j, r),
+    // and L(a, i) v conj(L(b, j)) for every jump
+    const std::complex<double> minus_i(0.0, -1.0);
+    m_drho_buffer.setZero();
+    for (const RhoEntry& e : m_sparse_rho) {
+        for (SparseCM::InnerIterator it(m_sparse_heff_adj, e.row); it; ++it) {
+            const std::complex<double> x = minus_i * std::conj(it.value()) * e.value;
+            m_drho_buffer(it.col(), e.col) += x;
+            m_drho_buffer(e.col, it.col()) += std::conj(x);
+        }
+        for (const SparseCM* L_adj : m_sparse_jumps_adj) {
+            for (SparseCM::InnerIterator a(*L_adj, e.row); a; ++a) {
+                const std::complex<double> left = std::conj(a.value()) * e.value;
+                for (SparseCM::InnerIterator b(*L_adj, e.col); b; ++b) {
+                    m_drho_buffer(a.col(), b.col()) += left * b.value();
+                }
+            }
+        }
+    }
+
+    // ρ ← pruned ρ + h dρ
+    rho.setZero();
+    for (const RhoEntry& e : m_sparse_rho) {
+        rho(e.row, e.col) = e.value;
+    }
+    rho += h * m_drho_buffer;
+    cap_trace_and_clamp_diag(rho);
+    m_last_sparse_rho_nnz = static_cast<int>(m_sparse_rho.size());
+    return true;
+}
+
+void QuantumEvolutionEngine::set_sparse_rho_threshold(double threshold) {
+    m_sparse_rho_threshold = std::max(0.0, threshold);
+}
+
+double QuantumEvolutionEngine::get_sparse_rho_threshold() const {
+    return m_sparse_rho_threshold;
+}
+
+int QuantumEvolutionEngine::get_last_sparse_rho_nnz() const {
+    return m_last_sparse_rho_nnz;
+}
+
+void QuantumEvolutionEngine::build_analytic_form() {
+    m_analytic_built = m_finalized;
+    m_analytic_version = m_operator_version;
+    m_analytic_eligible = false;
+    m_analytic_dephasing.clear();
+    m_analytic_damped.clear();
+    m_analytic_factors.resize(0, 0);
+    m_analytic_t = -1.0;
+    if (!m_finalized || m_dim <= 0) {
+        return;
+    }
+    const int n = m_dim;
+
+    // H diagonal: only the energies survive
+    SparseCM H(n, n);
+    if (m_has_hamiltonian) {
+        H = m_hamiltonian;
+    }
+    for (const auto& H_loc : m_local_hamiltonians) {
+        H += expand_local(H_loc.op, H_loc.size, H_loc.mask, H_loc.offsets, n);
+    }
+    m_analytic_energy = Eigen::VectorXd::Zero(n);
+    for (int i = 0; i < n; i++) {
+        for (SparseCM::InnerIterator it(H, i); it; ++it) {
+            if (it.col() == i) {
+                m_analytic_energy(i) = it.value().real();
+            } else if (std::abs(it.value()) > 1e-15) {
+                return;
+            }
+        }
+    }
+
+    // Every jump as a full matrix (local ones embedded), classified as a
+    // dephasing diagonal or a single-bit lowering operator
+    std::vector<SparseCM> local_jumps;
+    local_jumps.reserve(m_local_lindblads.size());
+    std::vector<const SparseCM*> jumps;
+    for (const auto& L : m_lindblads) {
+        jumps.push_back(&L->L);
+    }
+    for (const auto& L_loc : m_local_lindblads) {
+        local_jumps.push_back(expand_local(L_loc.op, L_loc.size, L_loc.mask, L_loc.offsets, n));
+        jumps.push_back(&local_jumps.back());
+    }
+    m_analytic_decay = Eigen::VectorXd::Zero(n);
+    for (const SparseCM* L : jumps) {
+        Eigen::VectorXcd diagonal = Eigen::VectorXcd::Zero(n);
+        int mask = 0;
+        int lowering = 0;
+        bool has_diagonal = false;
+        std::complex<double> c(0.0, 0.0);
+        for (int i = 0; i < n; i++) {
+            for (SparseCM::InnerIterator it(*L, i); it; ++it) {
+                const int j = static_cast<int>(it.col());
+                if (std::abs(it.value()) <= 1e-15) {
+                    continue;
+                }
+                if (i == j) {
+                    diagonal(i) = it.value();
+                    has_diagonal = true;
+                    continue;
+                }
+                // |i⟩⟨i | q| with one bit q, the same q and value throughout
+                const int bit = i ^ j;
+                if ((bit & (bit - 1)) != 0 || (i & bit) != 0 || (mask != 0 && bit != mask) ||
+                    (mask != 0 && std::abs(it.value() - c) > 1e-12 * std::abs(c))) {
+                    return;
+                }
+                mask = bit;
+                c = it.value();
+                lowering++;
+            }
+        }
+        if (mask != 0) {
+            if (has_diagonal || lowering != n / 2) {
+                return;  // Mixed, or σ⁻ on only part of the space
+            }
+            const double gamma = std::norm(c);
+            auto same = std::find_if(m_analytic_damped.begin(), m_analytic_damped.end(),
+                                     [mask](const DampedBit& b) { return b.mask == mask; });
+            if (same != m_analytic_damped.end()) {
+                same->gamma += gamma;
+            } else {
+                m_analytic_damped.push_back({mask, gamma, 0.0});
+            }
+            for (int a = 0; a < n; a++) {
+                if (a & mask) {
+                    m_analytic_decay(a) += gamma;  // L†L = γ |1⟩⟨1| on bit q
+                }
+            }
+        } else if (has_diagonal) {
+            m_analytic_decay += diagonal.cwiseAbs2();
+            m_analytic_dephasing.push_back(std::move(diagonal));
+        }
+    }
+
+    // Each damped bit's transfer (a | q, b | q) → (a, b) must commute with
+    // the rest of the diagonal generator: the H phase and the dephasing
+    // rates the same with q set in both indices as with it clear
+    auto rest = [this](int a, int b) {
+        std::complex<double> f(0.0, -(m_analytic_energy(a) - m_analytic_energy(b)));
+        for (const Eigen::VectorXcd& d : m_analytic_dephasing) {
+            f += d(a) * std::conj(d(b)) - 0.5 * (std::norm(d(a)) + std::norm(d(b)));
+        }
+        return f;
+    };
+    double scale = 1.0;
+    for (int a = 0; a < n; a++) {
+        scale = std::max(scale, std::abs(m_analytic_energy(a)) + m_analytic_decay(a));
+    }
+    for (const DampedBit& bit : m_analytic_damped) {
+        for (int a = 0; a < n; a++) {
+            if (a & bit.mask) {
+                continue;
+            }
+            for (int b = 0; b < n; b++) {
+                if (!(b & bit.mask) && std::abs(rest(a | bit.mask, b | bit.mask) - rest(a, b)) > 1e-12 * scale) {
+                    m_analytic_damped.clear();
+                    m_analytic_dephasing.clear();
+                    return;
+                }
+            }
+        }
+    }
+    m_analytic_eligible = true;
+}
+
+void QuantumEvolutionEngine::evolve_analytic(RhoRef rho, double t) {
+    const int n = m_dim;
+    if (t != m_analytic_t) {
+        m_analytic_factors.resize(n, n);
+        for (int a = 0; a < n; a++) {
+            for (int b = 0; b < n; b++) {
+                std::complex<double> f(-0.5 * (m_analytic_decay(a) + m_analytic_decay(b)),
+                                       -(m_analytic_energy(a) - m_analytic_energy(b)));
+                for (const Eigen::VectorXcd& d : m_analytic_dephasing) {
+                    f += d(a) * std::conj(d(b));
+                }
+                m_analytic_factors(a, b) = std::exp(t * f);
+            }
+        }
+        for (DampedBit& bit : m_analytic_damped) {
+            bit.transfer = -std::expm1(-bit.gamma * t);
+        }
+        m_analytic_t = t;
+    }
+
+    // Damped bits first (they commute with each other and with the factors),
+    // each reading the state the previous one left
+    for (const DampedBit& bit : m_analytic_damped) {
+        for (int a = 0; a < n; a++) {
+            if (a & bit.mask) {
+                continue;
+            }
+            for (int b = 0; b < n; b++) {
+                if (!(b & bit.mask)) {
+                    rho(a, b) += bit.transfer * rho(a | bit.mask, b | bit.mask);
+                }
+            }
+        }
+    }
+    rho.array() *= m_analytic_factors.array();
+    m_last_substeps = 1;
+    m_last_rhs_evals = 0;
+}
+
+void QuantumEvolutionEngine::set_analytic_evolution(bool enabled) {
+    m_use_analytic = enabled;
+}
+
+bool QuantumEvolutionEngine::get_analytic_evolution() const {
+    return m_use_analytic;
+}
+
+bool QuantumEvolutionEngine::is_analytic_eligible() {
+    if (!m_analytic_built || m_analytic_version != m_operator_version) {
+        build_analytic_form();
+    }
+    return m_analytic_eligible;
+}
+
+bool QuantumEvolutionEngine::get_last_analytic_step() const {
+    return m_last_analytic_step;
+}
+
+bool QuantumEvolutionEngine::get_last_step_truncated() const {
+    return m_last_step_truncated;
+}
+
+void QuantumEvolutionEngine::set_use_liouvillian(bool enabled) {
+    if (m_use_liouvillian == enabled) {
+        return;
+    }
+    m_use_liouvillian = enabled;
+
+    // Already finalized: build or drop the superoperator right away
+    if (m_finalized) {
+        m_liouvillian.resize(0, 0);
+        m_has_liouvillian = false;
+        if (m_use_liouvillian && m_dim > 0 && m_dim <= LIOUVILLIAN_MAX_DIM) {
+            build_liouvillian();
+        }
+        if (m_single_precision) {
+            build_single_precision_operators();
+        }
+    }
+}
+
+bool QuantumEvolutionEngine::get_use_liouvillian() const {
+    return m_use_liouvillian;
+}
+
+bool QuantumEvolutionEngine::has_liouvillian() const {
+    return m_has_liouvillian;
+}
+
+int QuantumEvolutionEngine::get_liouvillian_nnz() const {
+    return m_has_liouvillian ? static_cast<int>(m_liouvillian.nonZeros()) : 0;
+}
+
+int64_t QuantumEvolutionEngine::get_operator_nnz() const {
+    if (m_has_liouvillian) {
+        return m_liouvillian.nonZeros();
+    }
+    int64_t nnz = m_heff.nonZeros();
+    for (const std::shared_ptr<const SharedLindblad>& jump : m_lindblads) {
+        nnz += jump->L.nonZeros();
+    }
+    return nnz;
+}
+
+PackedFloat64Array QuantumEvolutionEngine::compute_steady_state() {
+    if (!m_finalized || m_dim <= 0) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: finalize() before compute_steady_state");
+        return PackedFloat64Array();
+    }
+    if (m_dim > LIOUVILLIAN_MAX_DIM) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: compute_steady_state needs dim <= ",
+                                       LIOUVILLIAN_MAX_DIM, " (got ", m_dim, ")");
+        return PackedFloat64Array();
+    }
+    const bool kept = m_has_liouvillian;
+    if (!kept) {
+        build_liouvillian();
+    }
+
+    // The ρ_00 equation is redundant with the others (𝓛 is trace-preserving),
+    // so its row is replaced by the trace condition Σ ρ_ii = 1
+    const int n = m_dim;
+    const int n2 = n * n;
+    std::vector<Eigen::Triplet<std::complex<double>>> triplets;
+    triplets.reserve(static_cast<size_t>(m_liouvillian.nonZeros()) + n);
+    for (int r = 1; r < n2; r++) {
+        for (SparseCM::InnerIterator it(m_liouvillian, r); it; ++it) {
+            triplets.emplace_back(r, static_cast<int>(it.col()), it.value());
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        triplets.emplace_back(0, i * n + i, 1.0);
+    }
+    if (!kept) {
+        m_liouvillian.resize(0, 0);
+        m_has_liouvillian = false;
+    }
+
+    Eigen::SparseMatrix<std::complex<double>, Eigen::ColMajor> system(n2, n2);
+    system.setFromTriplets(triplets.begin(), triplets.end());
+    system.makeCompressed();
+    Eigen::SparseLU<Eigen::SparseMatrix<std::complex<double>, Eigen::ColMajor>> lu;
+    lu.analyzePattern(system);
+    lu.factorize(system);
+    if (lu.info() != Eigen::Success) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: compute_steady_state found no unique steady state");
+        return PackedFloat64Array();
+    }
+    Eigen::VectorXcd rhs = Eigen::VectorXcd::Zero(n2);
+    rhs(0) = 1.0;
+    const Eigen::VectorXcd solution = lu.solve(rhs);
+
+    // Row-stacked vec(ρ) is RhoMatrix storage; clean up rounding in the
+    // Hermiticity and trace
+    RhoMatrix rho = Eigen::Map<const RhoMatrix>(solution.data(), n, n);
+    rho = 0.5 * (rho + rho.adjoint()).eval();
+    const double trace = rho.trace().real();
+    if (!std::isfinite(trace) || trace <= 0.0) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: compute_steady_state solution is not a density matrix");
+        return PackedFloat64Array();
+    }
+    rho /= trace;
+    return pack_dense(rho);
+}
+
+void QuantumEvolutionEngine::set_low_rank_truncation(int max_rank, double tolerance) {
+    m_low_rank_max_rank = std::max(1, max_rank);
+    m_low_rank_tol = std::max(0.0, tolerance);
+}
+
+int QuantumEvolutionEngine::get_low_rank_max_rank() const {
+    return m_low_rank_max_rank;
+}
+
+double QuantumEvolutionEngine::get_low_rank_tolerance() const {
+    return m_low_rank_tol;
+}
+
+int QuantumEvolutionEngine::factor_rank(const PackedFloat64Array& factor) const {
+    const int64_t row_doubles = 2 * static_cast<int64_t>(m_dim);
+    if (m_dim <= 0 || factor.size() % row_doubles != 0) {
+        return -1;
+    }
+    return static_cast<int>(factor.size() / row_doubles);
+}
+
+PackedFloat64Array QuantumEvolutionEngine::pack_factor(const lindblad::FactorMatrix& V) const {
+    PackedFloat64Array out;
+    out.resize(V.size() * 2);
+    if (V.size() > 0) {
+        std::memcpy(out.ptrw(), V.data(), static_cast<size_t>(V.size()) * sizeof(std::complex<double>));
+    }
+    return out;
+}
+
+PackedFloat64Array QuantumEvolutionEngine::factor_low_rank(const PackedFloat64Array& rho_data) const {
+    if (!is_packed_valid(rho_data)) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: factor_low_rank size mismatch");
+        return PackedFloat64Array();
+    }
+    lindblad::FactorMatrix V;
+    lindblad::factor_low_rank(map_packed(rho_data), m_low_rank_max_rank, m_low_rank_tol, V);
+    return pack_factor(V);
+}
+
+PackedFloat64Array QuantumEvolutionEngine::expand_low_rank(const PackedFloat64Array& factor) const {
+    const int rank = factor_rank(factor);
+    if (rank < 0) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: expand_low_rank size mismatch");
+        return PackedFloat64Array();
+    }
+    Eigen::Map<const lindblad::FactorMatrix> V(reinterpret_cast<const std::complex<double>*>(factor.ptr()),
+                                               m_dim, rank);
+    RhoMatrix rho(m_dim, m_dim);
+    rho.noalias() = V * V.adjoint();
+    return pack_dense(rho);
+}
+
+PackedFloat64Array QuantumEvolutionEngine::evolve_low_rank(const PackedFloat64Array& factor, float dt,
+                                                           float max_dt) {
+    if (!m_finalized) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: call finalize() first!");
+        return factor;
+    }
+    const int rank = factor_rank(factor);
+    if (rank <= 0) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: evolve_low_rank size mismatch");
+        return factor;
+    }
+    ScopedProfile profile(m_profile_evolve);
+    NATIVE_TRACE_ZONE("evolve");
+
+    m_low_rank_factor = Eigen::Map<const lindblad::FactorMatrix>(
+        reinterpret_cast<const std::complex<double>*>(factor.ptr()), m_dim, rank);
+    lindblad::Generator gen;
+    gen.heff = m_has_heff ? &m_heff : nullptr;
+    gen.heff_form = &m_heff_form;
+    gen.local_heff = &m_local_heff;
+    gen.lindblads = &m_lindblads;
+    gen.local_lindblads = &m_local_lindblads;
+
+    // Equal substeps of at most max_dt covering dt
+    const double total = std::max(0.0, static_cast<double>(dt));
+    const double h_max = max_dt > 0.0f ? static_cast<double>(max_dt) : total;
+    const int steps = (total > 0.0 && h_max > 0.0) ? static_cast<int>(std::ceil(total / h_max - 1e-9)) : 0;
+    const double h = steps > 0 ? total / steps : 0.0;
+    for (int s = 0; s < steps; s++) {
+        lindblad::low_rank_step(gen, m_low_rank_factor, h, m_low_rank_max_rank, m_low_rank_tol, m_low_rank_work);
+    }
+    m_last_substeps = steps;
+    m_last_rhs_evals = steps;
+    return pack_factor(m_low_rank_factor);
+}
+
+PackedFloat64Array QuantumEvolutionEngine::compute_observables_low_rank(const PackedFloat64Array& factor,
+                                                                        int num_qubits, int mask) {
+    const int rank = factor_rank(factor);
+    if (rank < 0 || num_qubits < 0 || num_qubits > 30 || (1 << num_qubits) > m_dim) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: compute_observables_low_rank size mismatch");
+        return PackedFloat64Array();
+    }
+    PackedFloat64Array out;
+    out.resize(observables_size(num_qubits, mask));
+    if (out.size() == 0) {
+        return out;
+    }
+
+    const bool want_pairs = wants_pair_reductions(num_qubits, mask);
+    m_low_rank_factor = Eigen::Map<const lindblad::FactorMatrix>(
+        reinterpret_cast<const std::complex<double>*>(factor.ptr()), m_dim, rank);
+    double purity = 0.0;
+    std::complex<double> trace(0.0, 0.0);
+    {
+        ScopedProfile profile(m_profile_reduce);
+        NATIVE_TRACE_ZONE("reduce");
+        lindblad::compute_reduced_states_low_rank(m_low_rank_factor, num_qubits, want_pairs, m_observable_states,
+                                                  &purity, &trace);
+    }
+    observables_from_states(m_observable_states, num_qubits, mask, purity, trace, out.ptrw());
+    return out;
+}
+
+int QuantumEvolutionEngine::get_dimension() const {
+    return m_dim;
+}
+
+int QuantumEvolutionEngine::get_lindblad_count() const {
+    return static_cast<int>(m_lindblads.size());
+}
+
+bool QuantumEvolutionEngine::is_finalized() const {
+    return m_finalized;
+}
+
+PackedFloat64Array QuantumEvolutionEngine::evolve_step(const PackedFloat64Array& rho_data, float dt) {
+    if (!m_finalized) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: call finalize() first!");
+        return rho_data;  // Return unchanged
+    }
+
+    if (!is_packed_valid(rho_data)) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: rho size does not match dimension");
+        return rho_data;
+    }
+
+    // Copy-on-write gives us our own buffer; evolve it in place
+    PackedFloat64Array out = rho_data;
+    Eigen::Map<RhoMatrix> rho(reinterpret_cast<std::complex<double>*>(out.ptrw()), m_dim, m_dim);
+    euler_step(rho, static_cast<double>(dt));
+    return out;
+}
+
+PackedFloat64Array QuantumEvolutionEngine::evolve(const PackedFloat64Array& rho_data, float dt, float max_dt) {
+    if (!m_finalized) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: call finalize() first!");
+        return rho_data;
+    }
+
+    PackedFloat64Array out = rho_data;
+    evolve_inplace(out, dt, max_dt);
+    return out;
+}
+
+void QuantumEvolutionEngine::apply_local_gate(const lindblad::LocalOperator& gate, RhoRef rho, RhoMatrix& work) {
+    const std::complex<double> one(1.0, 0.0);
+    work.setZero(rho.rows(), rho.cols());
+    local_apply_left(gate.op, gate.size, gate.mask, gate.offsets, one, rho, work);
+    rho.setZero();
+    local_apply_right_adjoint(gate.op, gate.size, gate.mask, gate.offsets, one, work, rho);
+}
+
+PackedFloat64Array QuantumEvolutionEngine::apply_packed_gate(const PackedFloat64Array& rho_data,
+                                                             const PackedFloat64Array& op_packed,
+                                                             const PackedInt32Array& qubits,
+                                                             const char* caller) const {
+    if (!is_packed_valid(rho_data)) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: ", caller, " size does not match dimension");
+        return PackedFloat64Array();
+    }
+    LocalOperator gate;
+    if (!parse_local_operator(op_packed, qubits, gate)) {
+        return PackedFloat64Array();
+    }
+    PackedFloat64Array out = rho_data;
+    Eigen::Map<RhoMatrix> rho(reinterpret_cast<std::complex<double>*>(out.ptrw()), m_dim, m_dim);
+    RhoMatrix work;
+    apply_local_gate(gate, rho, work);
+    return out;
+}
+
+PackedFloat64Array QuantumEvolutionEngine::apply_gate_1q(const PackedFloat64Array& rho_data, int qubit,
+                                                         const PackedFloat64Array& U2) const {
+    PackedInt32Array qubits;
+    qubits.push_back(qubit);
+    return apply_packed_gate(rho_data, U2, qubits, "apply_gate_1q");
+}
+
+PackedFloat64Array QuantumEvolutionEngine::apply_gate_2q(const PackedFloat64Array& rho_data, int qubit_a,
+                                                         int qubit_b, const PackedFloat64Array& U4) const {
+    PackedInt32Array qubits;
+    qubits.push_back(qubit_a);
+    qubits.push_back(qubit_b);
+    return apply_packed_gate(rho_data, U4, qubits, "apply_gate_2q");
+}
+
+PackedFloat64Array QuantumEvolutionEngine::apply_controlled_gate(const PackedFloat64Array& rho_data, int control,
+                                                                 int target, const PackedFloat64Array& U2) const {
+    if (U2.size() != 8) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: apply_controlled_gate expects a packed 2×2 gate");
+        return PackedFloat64Array();
+    }
+    // |0⟩⟨0| ⊗ I + |1⟩⟨1| ⊗ U2 on (control, target), control the high digit
+    PackedFloat64Array U4;
+    U4.resize(32);
+    double* u = U4.ptrw();
+    std::fill(u, u + 32, 0.0);
+    u[(0 * 4 + 0) * 2] = 1.0;
+    u[(1 * 4 + 1) * 2] = 1.0;
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            u[((2 + i) * 4 + 2 + j) * 2] = U2[(i * 2 + j) * 2];
+            u[((2 + i) * 4 + 2 + j) * 2 + 1] = U2[(i * 2 + j) * 2 + 1];
+        }
+    }
+    PackedInt32Array qubits;
+    qubits.push_back(control);
+    qubits.push_back(target);
+    return apply_packed_gate(rho_data, U4, qubits, "apply_controlled_gate");
+}
+
+int QuantumEvolutionEngine::measure_inplace(RhoRef rho, int mask, double u, double* probability) {
+    // Outcome weights from the diagonal, accumulated per basis pattern of mask
+    const int dim = static_cast<int>(rho.rows());
+    double total = 0.0;
+    for (int i = 0; i < dim; i++) {
+        total += std::max(0.0, rho(i, i).real());
+    }
+    if (!(total > 0.0)) {
+        return -1;
+    }
+    const double target = u * total;
+    double running = 0.0;
+    int pattern = -1;
+    for (int i = 0; i < dim && pattern < 0; i++) {
+        running += std::max(0.0, rho(i, i).real());
+        if (running > target) {
+            pattern = i & mask;
+        }
+    }
+    if (pattern < 0) {
+        pattern = (dim - 1) & mask;  // u·total rounded past the last weight
+    }
+    double weight = 0.0;
+    for (int i = 0; i < dim; i++) {
+        if ((i & mask) == pattern) {
+            weight += std::max(0.0, rho(i, i).real());
+        }
+    }
+
+    // Keep the rows and columns matching the pattern, renormalized
+    const double scale = weight > 0.0 ? 1.0 / weight : 0.0;
+    for (int i = 0; i < dim; i++) {
+        auto row = rho.row(i);
+        if ((i & mask) != pattern) {
+            row.setZero();
+            continue;
+        }
+        for (int j = 0; j < dim; j++) {
+            row(j) = ((j & mask) == pattern) ? row(j) * scale : std::complex<double>(0.0, 0.0);
+        }
+    }
+    if (probability) {
+        *probability = weight / total;
+    }
+    return pattern;
+}
+
+Dictionary QuantumEvolutionEngine::measure_basis(const PackedFloat64Array& rho_data, const PackedInt32Array& qubits,
+                                                 int64_t rng_seed) const {
+    Dictionary result;
+    if (!is_packed_valid(rho_data)) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: measure size does not match dimension");
+        return result;
+    }
+    int mask = 0;
+    for (int t = 0; t < qubits.size(); t++) {
+        if (qubits[t] < 0 || qubits[t] > 30 || (1 << qubits[t]) >= m_dim) {
+            UtilityFunctions::push_warning("QuantumEvolutionEngine: measure qubit ", qubits[t], " out of range");
+            return result;
+        }
+        mask |= 1 << qubits[t];
+    }
+    if (qubits.is_empty()) {
+        mask = m_dim - 1;
+    }
+
+    std::mt19937_64 rng(static_cast<uint64_t>(rng_seed));
+    const double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    PackedFloat64Array out = rho_data;
+    Eigen::Map<RhoMatrix> rho(reinterpret_cast<std::complex<double>*>(out.ptrw()), m_dim, m_dim);
+    double probability = 0.0;
+    const int pattern = measure_inplace(rho, mask, u, &probability);
+    if (pattern < 0) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: measure on a zero-trace state");
+        return result;
+    }
+
+    // Basis pattern → outcome digits in qubit-list order
+    int outcome = pattern;
+    if (!qubits.is_empty()) {
+        outcome = 0;
+        for (int t = 0; t < qubits.size(); t++) {
+            outcome |= ((pattern >> qubits[t]) & 1) << t;
+        }
+    }
+    result["outcome"] = outcome;
+    result["probability"] = probability;
+    result["rho"] = out;
+    return result;
+}
+
+Dictionary QuantumEvolutionEngine::measure_qubit(const PackedFloat64Array& rho_data, int qubit,
+                                                 int64_t rng_seed) const {
+    PackedInt32Array qubits;
+    qubits.push_back(qubit);
+    return measure_basis(rho_data, qubits, rng_seed);
+}
+
+PackedFloat64Array QuantumEvolutionEngine::apply_operator(const PackedFloat64Array& rho_data,
+                                                          const PackedFloat64Array& op_packed) const {
+    if (!is_packed_valid(rho_data) || !is_packed_valid(op_packed)) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: apply_operator size does not match dimension");
+        return PackedFloat64Array();
+    }
+
+    Eigen::Map<const RhoMatrix> rho = map_packed(rho_data);
+    Eigen::Map<const RhoMatrix> op = map_packed(op_packed);
+    RhoMatrix out = op * rho * op.adjoint();
+
+    const double trace = out.trace().real();
+    if (!(trace > 1e-12)) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: apply_operator result has zero trace");
+        return PackedFloat64Array();
+    }
+    out /= trace;
+    return pack_dense(out);
+}
+
+bool QuantumEvolutionEngine::evolve_inplace(PackedFloat64Array& rho_data, float dt, float max_dt) {
+    if (!m_finalized) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: call finalize() first!");
+        return false;
+    }
+    if (!is_packed_valid(rho_data)) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: rho size does not match dimension");
+        return false;
+    }
+
+    // std::complex<double> is layout-compatible with double[2], and the packed
+    // format is row-major, so this view aliases the array storage directly
+    Eigen::Map<RhoMatrix> rho(reinterpret_cast<std::complex<double>*>(rho_data.ptrw()), m_dim, m_dim);
+    evolve_matrix(rho, dt, max_dt);
+    return true;
+}
+
+bool QuantumEvolutionEngine::begin_sliced_step(const PackedFloat64Array& rho_data, float dt, float max_dt,
+                                               SlicedStep& step) const {
+    if (!is_batchable() || !is_packed_valid(rho_data)) {
+        return false;
+    }
+    step.rho = map_packed(rho_data);
+    step.drho.resize(m_dim, m_dim);
+    step.temp.resize(m_dim, m_dim);
+    // Legacy Euler: one step of max_dt, as evolve_matrix
+    step.h = (max_dt > 0.0f) ? static_cast<double>(max_dt) : static_cast<double>(dt);
+    step.next_unit = 0;
+    step.unit_count = 0;
+    step.operator_version = m_operator_version;
+    step.complete = false;
+    return true;
+}
+
+bool QuantumEvolutionEngine::continue_sliced_step(SlicedStep& step, int max_units) const {
+    if (step.complete) {
+        return true;
+    }
+    if (step.operator_version != m_operator_version || step.rho.rows() != m_dim) {
+        // Operators changed since the step began: its partial sum is stale
+        if (step.rho.rows() != m_dim || !is_batchable()) {
+            step.complete = true;  // Nothing sensible left to do; keep the input
+            return true;
+        }
+        step.next_unit = 0;
+        step.operator_version = m_operator_version;
+    }
+
+    lindblad::Generator gen;
+    gen.heff = m_has_heff ? &m_heff : nullptr;
+    gen.heff_form = &m_heff_form;
+    gen.local_heff = &m_local_heff;
+    gen.lindblads = &m_lindblads;
+    gen.local_lindblads = &m_local_lindblads;
+    step.unit_count = m_has_liouvillian ? m_dim : lindblad::generator_unit_count(gen);
+
+    const int end = std::min(step.unit_count, step.next_unit + std::max(max_units, 1));
+    if (m_has_liouvillian) {
+        // Unit r: ρ row r of vec(dρ) = 𝓛 vec(ρ) (row-major storage is vec(ρ))
+        const int n2 = m_dim * m_dim;
+        Eigen::Map<const Eigen::VectorXcd> rho_vec(step.rho.data(), n2);
+        Eigen::Map<Eigen::VectorXcd> drho_vec(step.drho.data(), n2);
+        const Eigen::Index first = static_cast<Eigen::Index>(step.next_unit) * m_dim;
+        const Eigen::Index rows = static_cast<Eigen::Index>(end - step.next_unit) * m_dim;
+        drho_vec.segment(first, rows).noalias() = m_liouvillian.middleRows(first, rows) * rho_vec;
+    } else {
+        lindblad::compute_drho_units(gen, step.rho, step.drho, step.temp, step.next_unit, end);
+    }
+    step.next_unit = end;
+    if (step.next_unit < step.unit_count) {
+        return false;
+    }
+
+    // Same update as euler_step
+    simd_kernels().axpy_c64(step.h, reinterpret_cast<const double*>(step.drho.data()),
+                            reinterpret_cast<double*>(step.rho.data()), step.rho.size());
+    cap_trace_and_clamp_diag(step.rho);
+    step.complete = true;
+    return true;
+}
+
+void QuantumEvolutionEngine::begin_sliced_observables(int num_qubits, int mask, SlicedObservables& obs) const {
+    obs.num_qubits = num_qubits;
+    obs.mask = mask;
+    obs.next_row = 0;
+    obs.purity = 0.0;
+    obs.trace = std::complex<double>(0.0, 0.0);
+    lindblad::reset_reduced_states(num_qubits, wants_pair_reductions(num_qubits, mask), obs.states);
+}
+
+bool QuantumEvolutionEngine::continue_sliced_observables(RhoConstRef rho, SlicedObservables& obs,
+                                                         int max_rows) const {
+    const int rows = (obs.num_qubits > 0 && (1 << obs.num_qubits) <= rho.rows()) ? (1 << obs.num_qubits) : 0;
+    if (obs.next_row >= rows) {
+        return true;
+    }
+    const int end = std::min(rows, obs.next_row + std::max(max_rows, 1));
+    const bool want_purity = (obs.mask & (OBSERVABLE_PURITY | OBSERVABLE_MI)) != 0;
+    const bool want_trace = (obs.mask & OBSERVABLE_TRACE) != 0;
+    lindblad::accumulate_reduced_states(rho, obs.next_row, end, obs.states, want_purity ? &obs.purity : nullptr,
+                                        want_trace ? &obs.trace : nullptr);
+    obs.next_row = end;
+    return obs.next_row >= rows;
+}
+
+void QuantumEvolutionEngine::finish_sliced_observables(const SlicedObservables& obs, double* out) {
+    observables_from_states(obs.states, obs.num_qubits, obs.mask, obs.purity, obs.trace, out);
+}
+
+Dictionary QuantumEvolutionEngine::evolve_trajectory(
+    const PackedFloat64Array& rho_data, int steps, float dt, float max_dt) {
+    Dictionary result;
+    PackedFloat64Array frames;
+    PackedFloat64Array trajectory_flux;
+    if (!evolve_trajectory_into(rho_data, steps, dt, max_dt, frames, m_flux_tracking ? &trajectory_flux : nullptr)) {
+        return result;
+    }
+
+    const int64_t stride = static_cast<int64_t>(m_dim) * m_dim * 2;
+    PackedInt64Array offsets;
+    offsets.resize(steps);
+    int64_t* offsets_w = offsets.ptrw();
+    for (int k = 0; k < steps; k++) {
+        offsets_w[k] = k * stride;
+    }
+
+    result["frames"] = frames;
+    result["stride"] = stride;
+    result["offsets"] = offsets;
+    result["steps"] = steps;
+    if (m_flux_tracking) {
+        result["channel_flux"] = trajectory_flux;
+    }
+    return result;
+}
+
+bool QuantumEvolutionEngine::evolve_trajectory_into(
+    const PackedFloat64Array& rho_data, int steps, float dt, float max_dt,
+    PackedFloat64Array& frames, PackedFloat64Array* channel_flux) {
+    if (!m_finalized) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: call finalize() first!");
+        return false;
+    }
+    if (!is_packed_valid(rho_data)) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: rho size does not match dimension");
+        return false;
+    }
+    if (steps <= 0) {
+        frames.resize(0);
+        return true;
+    }
+
+    const int64_t stride = static_cast<int64_t>(m_dim) * m_dim * 2;
+    frames.resize(stride * steps);
+    double* base = frames.ptrw();
+
+    // Per-step flux is the running tally's growth over the step (the tally
+    // itself keeps accumulating for take_channel_flux)
+    const bool flux = channel_flux != nullptr && m_flux_tracking;
+    const int64_t flux_stride = flux ? static_cast<int64_t>(flux_channel_count()) * m_flux_emoji_ids.size() : 0;
+    std::vector<double> flux_before;
+    if (flux) {
+        channel_flux->resize(flux_stride * steps);
+        NATIVE_ALLOC_PACKED(*channel_flux);
+        m_channel_flux.resize(flux_stride, 0.0);
+    }
+
+    const double* prev = rho_data.ptr();
+    for (int k = 0; k < steps; k++) {
+        double* frame = base + k * stride;
+        std::memcpy(frame, prev, sizeof(double) * stride);
+        Eigen::Map<RhoMatrix> rho(reinterpret_cast<std::complex<double>*>(frame), m_dim, m_dim);
+        if (flux) {
+            flux_before = m_channel_flux;
+        }
+        evolve_matrix(rho, dt, max_dt);
+        if (flux) {
+            double* out = channel_flux->ptrw() + k * flux_stride;
+            for (int64_t c = 0; c < flux_stride; c++) {
+                out[c] = m_channel_flux[c] - flux_before[c];
+            }
+        }
+        prev = frame;
+    }
+    return true;
+}
+
+PackedFloat64Array QuantumEvolutionEngine::evolve_hermitian(
+    const PackedFloat64Array& rho_herm, float dt, float max_dt) {
+    if (!m_finalized) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: call finalize() first!");
+        return rho_herm;
+    }
+    if (rho_herm.size() != m_dim * m_dim) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: Hermitian-packed rho must have dim² values");
+        return rho_herm;
+    }
+
+    RhoMatrix rho = unpack_hermitian_matrix(rho_herm);
+    evolve_matrix(rho, dt, max_dt);
+    return pack_hermitian_matrix(rho);
+}
+
+PackedFloat64Array QuantumEvolutionEngine::pack_hermitian(const PackedFloat64Array& rho_data) const {
+    if (rho_data.size() != m_dim * m_dim * 2) {
+        return PackedFloat64Array();
+    }
+    return pack_hermitian_matrix(unpack_dense(rho_data));
+}
+
+PackedFloat64Array QuantumEvolutionEngine::unpack_hermitian(const PackedFloat64Array& rho_herm) const {
+    if (rho_herm.size() != m_dim * m_dim) {
+        return PackedFloat64Array();
+    }
+    return pack_dense(unpack_hermitian_matrix(rho_herm));
+}
+
+double QuantumEvolutionEngine::compute_purity_from_hermitian(const PackedFloat64Array& rho_herm) const {
+    // Tr(ρ²) = Σ_i ρ_ii² + 2 Σ_{i<j} |ρ_ij|², read straight from the half storage
+    if (rho_herm.size() != m_dim * m_dim) {
+        return 0.0;
+    }
+    const double* ptr = rho_herm.ptr();
+    double diag = 0.0;
+    double off = 0.0;
+    int idx = 0;
+    for (int i = 0; i < m_dim; i++) {
+        diag += ptr[idx] * ptr[idx];
+        idx++;
+        for (int j = i + 1; j < m_dim; j++) {
+            off += ptr[idx] * ptr[idx] + ptr[idx + 1] * ptr[idx + 1];
+            idx += 2;
+        }
+    }
+    return diag + 2.0 * off;
+}
+
+void QuantumEvolutionEngine::euler_step(RhoRef rho, double dt) {
+    const bool sample_drift = drift_sample_due();
+    const double trace_before = sample_drift ? rho.trace().real() : 0.0;
+
+    // dρ/dt = -i[H, ρ] + Σ_k (L_k ρ L_k† - ½{L_k†L_k, ρ})
+    compute_drho(rho, m_drho_buffer);
+
+    // =========================================================================
+    // Euler integration: ρ(t+dt) = ρ(t) + dt * dρ/dt
+    // =========================================================================
+    if (rho.outerStride() == rho.cols()) {
+        simd_kernels().axpy_c64(dt, reinterpret_cast<const double*>(m_drho_buffer.data()),
+                                reinterpret_cast<double*>(rho.data()), rho.size());
+    } else {
+        rho += dt * m_drho_buffer;
+    }
+    if (sample_drift) {
+        record_drift(rho, trace_before);
+    }
+    cap_trace_and_clamp_diag(rho);
+}
+
+bool QuantumEvolutionEngine::is_batchable() const {
+    return m_finalized && m_dim > 0 && m_integrator == INTEGRATOR_EULER && !m_single_precision &&
+           !m_has_propagator && m_drift_level == DRIFT_EULER;
+}
+
+std::shared_ptr<const QuantumEvolutionEngine::BatchedOperators>
+QuantumEvolutionEngine::build_batched_operators(const std::vector<const QuantumEvolutionEngine*>& engines) {
+    if (engines.empty()) {
+        return nullptr;
+    }
+    const int d = engines[0]->m_dim;
+    size_t max_jumps = 0;
+    for (const QuantumEvolutionEngine* engine : engines) {
+        if (!engine || !engine->is_batchable() || engine->m_dim != d) {
+            return nullptr;
+        }
+        max_jumps = std::max(max_jumps, engine->m_lindblads.size() + engine->m_local_lindblads.size());
+    }
+
+    typedef std::vector<Eigen::Triplet<std::complex<double>>> TripletList;
+    auto append_block = [](TripletList& out, const SparseCM& m, int offset) {
+        for (int r = 0; r < m.outerSize(); ++r) {
+            for (SparseCM::InnerIterator it(m, r); it; ++it) {
+                out.emplace_back(offset + r, offset + static_cast<int>(it.col()), it.value());
+            }
+        }
+    };
+
+    auto ops = std::make_shared<BatchedOperators>();
+
+    // Registered jump k held by every biome (same handle) needs no blockdiag:
+    // it is applied once per block with the shared dim×dim operator
+    std::vector<bool> slot_shared(max_jumps, false);
+    for (size_t k = 0; k < engines[0]->m_lindblads.size(); k++) {
+        const SharedLindblad* handle = engines[0]->m_lindblads[k].get();
+        bool shared = true;
+        for (const QuantumEvolutionEngine* engine : engines) {
+            if (k >= engine->m_lindblads.size() || engine->m_lindblads[k].get() != handle) {
+                shared = false;
+                break;
+            }
+        }
+        if (shared) {
+            slot_shared[k] = true;
+            ops->shared_jumps.push_back(engines[0]->m_lindblads[k]);
+        }
+    }
+
+    // Same terms compute_drho applies: H_eff (with the folded anticommutators)
+    // and the jumps, local operators expanded to sparse
+    TripletList heff_triplets;
+    std::vector<TripletList> jump_triplets(max_jumps);
+    for (size_t b = 0; b < engines.size(); b++) {
+        const QuantumEvolutionEngine& e = *engines[b];
+        const int offset = static_cast<int>(b) * d;
+        if (e.m_has_heff) {
+            append_block(heff_triplets, e.m_heff, offset);
+        }
+        for (const auto& entry : e.m_local_heff) {
+            append_block(heff_triplets, expand_local(entry.op, entry.size, entry.mask, entry.offsets, d), offset);
+        }
+        size_t k = 0;
+        for (const auto& L : e.m_lindblads) {
+            if (!slot_shared[k]) {
+                append_block(jump_triplets[k], L->L, offset);
+            }
+            k++;
+        }
+        for (const auto& L_loc : e.m_local_lindblads) {
+            append_block(jump_triplets[k++], expand_local(L_loc.op, L_loc.size, L_loc.mask, L_loc.offsets, d), offset);
+        }
+    }
+
+    ops->dim = d;
+    ops->count = static_cast<int>(engines.size());
+    const int rows = ops->count * d;
+    ops->heff.resize(rows, rows);
+    ops->heff.setFromTriplets(heff_triplets.begin(), heff_triplets.end());
+    ops->heff.makeCompressed();
+    ops->jumps.reserve(max_jumps - ops->shared_jumps.size());
+    for (size_t k = 0; k < max_jumps; k++) {
+        if (slot_shared[k]) {
+            continue;
+        }
+        ops->jumps.emplace_back(rows, rows);
+        ops->jumps.back().setFromTriplets(jump_triplets[k].begin(), jump_triplets[k].end());
+        ops->jumps.back().makeCompressed();
+    }
+    return ops;
+}
+
+void QuantumEvolutionEngine::euler_step_batched(const BatchedOperators& ops, RhoMatrix& stack, double dt,
+                                                BatchedWorkspace& work) {
+    const int d = ops.dim;
+    const int rows = ops.count * d;
+    if (work.drho.rows() != rows || work.drho.cols() != d) {
+        work.x.resize(rows, d);
+        work.y.resize(rows, d);
+        work.drho.resize(rows, d);
+    }
+
+    // Drift: X + X† per block, X = -i H_eff ρ
+    const std::complex<double> minus_i(0.0, -1.0);
+    work.x.noalias() = minus_i * (ops.heff * stack);
+    for (int b = 0; b < ops.count; b++) {
+        work.drho.middleRows(b * d, d) = work.x.middleRows(b * d, d) + work.x.middleRows(b * d, d).adjoint();
+    }
+
+    // Jumps: L ρ L† = (L (L ρ)†)† per block
+    for (const auto& J : ops.jumps) {
+        work.x.noalias() = J * stack;
+        for (int b = 0; b < ops.count; b++) {
+            work.x.middleRows(b * d, d).adjointInPlace();
+        }
+        work.y.noalias() = J * work.x;
+        for (int b = 0; b < ops.count; b++) {
+            work.drho.middleRows(b * d, d) += work.y.middleRows(b * d, d).adjoint();
+        }
+    }
+    for (const auto& L : ops.shared_jumps) {
+        for (int b = 0; b < ops.count; b++) {
+            work.x.middleRows(b * d, d).noalias() = L->L * stack.middleRows(b * d, d);
+            work.drho.middleRows(b * d, d).noalias() += work.x.middleRows(b * d, d) * L->L_dag;
+        }
+    }
+
+    stack += dt * work.drho;
+    for (int b = 0; b < ops.count; b++) {
+        cap_trace_and_clamp_diag(stack.middleRows(b * d, d));
+    }
+}
+
+void QuantumEvolutionEngine::evolve_matrix(RhoRef rho, float dt, float max_dt) {
+    ScopedProfile profile(m_profile_evolve);
+    ScopedCounterNanos evolve_counter(COUNTER_EVOLVE_NANOS);
+    NATIVE_TRACE_ZONE("evolve");
+    // The call covers max_dt in legacy Euler mode and dt otherwise; when that
+    // is the propagator's dt, the whole call is vec(ρ) ← P vec(ρ)
+    const float covered = (m_integrator == INTEGRATOR_EULER && max_dt > 0.0f) ? max_dt : dt;
+    if (m_flux_tracking) {
+        accumulate_channel_flux(rho, static_cast<double>(covered));
+    }
+    m_last_population_step = false;
+    m_last_sparse_rho_nnz = 0;
+    m_last_analytic_step = false;
+    m_last_step_truncated = false;
+    // Dephasing / decay only: the closed form covers the whole call exactly
+    if (m_use_analytic && covered > 0.0f && is_analytic_eligible()) {
+        evolve_analytic(rho, static_cast<double>(covered));
+        m_last_analytic_step = true;
+        return;
+    }
+    if (m_has_propagator && covered > 0.0f &&
+        std::abs(static_cast<double>(covered) - m_propagator_dt) <= 1e-6 * m_propagator_dt) {
+        const int n2 = m_dim * m_dim;
+        for (int i = 0; i < m_dim; i++) {
+            m_propagator_work.segment(static_cast<Eigen::Index>(i) * m_dim, m_dim) = rho.row(i).transpose();
+        }
+        m_temp_buffer.resize(m_dim, m_dim);
+        Eigen::Map<Eigen::VectorXcd>(m_temp_buffer.data(), n2).noalias() = m_propagator * m_propagator_work;
+        rho = m_temp_buffer;
+        m_last_substeps = 1;
+        m_last_rhs_evals = 0;
+        return;
+    }
+
+    // Dephased to (near) diagonal: the rate equation on the populations
+    if (m_population_threshold > 0.0 && covered > 0.0f && is_population_mode_eligible() &&
+        coherences_below(rho, m_population_threshold)) {
+        const double h_max = (max_dt > 0.0f) ? static_cast<double>(max_dt) : static_cast<double>(covered);
+        evolve_populations(rho, static_cast<double>(covered), h_max);
+        m_last_population_step = true;
+        return;
+    }
+
+    // Blockwise 𝓛 for the whole call when ρ lies inside the sectors (Krylov
+    // and single-precision steps work on their own operator copies)
+    struct SectorStepScope {
+        bool& flag;
+        ~SectorStepScope() { flag = false; }
+    } sector_scope{m_sector_step};
+    m_sector_step = !m_sectors.empty() &&
+                    (m_integrator == INTEGRATOR_DOPRI5 || (m_integrator == INTEGRATOR_EULER && !m_single_precision)) &&
+                    is_sector_diagonal(rho);
+    if (m_integrator == INTEGRATOR_DOPRI5 && dt > 0.0f) {
+        // Adaptive path: integrate the whole frame dt, never stepping past max_dt
+        double h_max = (max_dt > 0.0f) ? static_cast<double>(max_dt) : static_cast<double>(dt);
+        integrate_dopri5(rho, static_cast<double>(dt), h_max);
+        cap_trace_and_clamp_diag(rho);
+        return;
+    }
+
+    if (m_integrator == INTEGRATOR_KRAUS && dt > 0.0f) {
+        // Stays physical on its own: no trace cap or diagonal clamp
+        double h_max = (max_dt > 0.0f) ? static_cast<double>(max_dt) : static_cast<double>(dt);
+        integrate_kraus(rho, static_cast<double>(dt), h_max);
+        return;
+    }
+
+    if (m_integrator == INTEGRATOR_MULTIRATE && dt > 0.0f) {
+        double h_max = (max_dt > 0.0f) ? static_cast<double>(max_dt) : static_cast<double>(dt);
+        integrate_multirate(rho, static_cast<double>(dt), h_max);
+        cap_trace_and_clamp_diag(rho);
+        return;
+    }
+
+    if (m_integrator == INTEGRATOR_STRANG && dt > 0.0f) {
+        // Coherent part exact, so h_max is bounded by the dissipation rates only
+        double h_max = (max_dt > 0.0f) ? static_cast<double>(max_dt) : static_cast<double>(dt);
+        integrate_strang(rho, static_cast<double>(dt), h_max);
+        cap_trace_and_clamp_diag(rho);
+        return;
+    }
+
+    if (m_integrator == INTEGRATOR_KRYLOV && dt > 0.0f) {
+        // Exponential integrator: exact in time up to the Krylov tolerance,
+        // so stiff rates no longer dictate the step size
+        integrate_krylov(rho, static_cast<double>(dt));
+        cap_trace_and_clamp_diag(rho);
+        return;
+    }
+
+    // Single evolution step using max_dt as the actual timestep (no subcycling)
+    // max_dt is the granularity setting (user-adjustable)
+    // dt parameter is ignored (legacy from subcycling era)
+    float actual_dt = (max_dt > 0.0f) ? max_dt : dt;
+    if (m_drift_level == DRIFT_KRAUS && actual_dt > 0.0f) {
+        // Drift fallback: same interval, completely positive map
+        integrate_kraus(rho, static_cast<double>(actual_dt), static_cast<double>(actual_dt));
+        m_last_substeps = 1;
+        m_last_rhs_evals = 1;
+        return;
+    }
+    // Drift levels 1-2 split the step into 2 / 4 Euler substeps
+    const int substeps = 1 << std::min(m_drift_level, static_cast<int>(DRIFT_MAX_SUBSTEP_LEVEL));
+    const double h = static_cast<double>(actual_dt) / substeps;
+    m_last_substeps = substeps;
+    m_last_rhs_evals = substeps;
+    const bool try_sparse = m_sparse_rho_threshold > 0.0 && !m_single_precision && !m_sector_step;
+    for (int s = 0; s < substeps; s++) {
+        if (m_single_precision) {
+            euler_step_single(rho, h);
+        } else if (!try_sparse || !sparse_euler_step(rho, h)) {
+            euler_step(rho, h);
+        }
+    }
+}
+
+void QuantumEvolutionEngine::set_integrator(int integrator) {
+    if (integrator != INTEGRATOR_EULER && integrator != INTEGRATOR_DOPRI5 &&
+        integrator != INTEGRATOR_KRYLOV && integrator != INTEGRATOR_STRANG &&
+        integrator != INTEGRATOR_MULTIRATE && integrator != INTEGRATOR_KRAUS) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: unknown integrator ", integrator);
+        return;
+    }
+    m_integrator = integrator;
+    m_dopri_h = 0.0;
+    m_krylov_tau = 0.0;
+    m_drift_level = DRIFT_EULER;
+}
+
+int QuantumEvolutionEngine::get_integrator() const {
+    return m_integrator;
+}
+
+void QuantumEvolutionEngine::set_integrator_tolerance(double rtol, double atol) {
+    m_rtol = std::max(rtol, 1e-14);
+    m_atol = std::max(atol, 1e-16);
+}
+
+int QuantumEvolutionEngine::get_last_substep_count() const {
+    return m_last_substeps;
+}
+
+int QuantumEvolutionEngine::get_last_rhs_evaluations() const {
+    return m_last_rhs_evals;
+}
+
+void QuantumEvolutionEngine::set_krylov_dimension(int m) {
+    m_krylov_dim = std::max(2, std::min(m, 100));
+    m_krylov_basis.resize(0, 0);
+}
+
+int QuantumEvolutionEngine::get_krylov_dimension() const {
+    return m_krylov_dim;
+}
+
+void QuantumEvolutionEngine::integrate_dopri5(RhoRef rho, double T, double h_max) {
+    m_last_substeps = 0;
+    m_last_rhs_evals = 0;
+    if (T <= 0.0 || m_dim <= 0) {
+        return;
+    }
+    const lindblad::Dopri5Result result = lindblad::integrate_dopri5(
+        [this](RhoConstRef y, RhoRef dy) { compute_drho(y, dy); }, rho, T, h_max, m_atol, m_rtol, m_dopri_h,
+        m_stage_buffers);
+    m_last_substeps = result.substeps;
+    m_last_rhs_evals = result.rhs_evals;
+    if (!result.reached) {
+        // Out of attempts (stiff 𝓛 against tight tolerances): ρ stops short of T
+        m_last_step_truncated = true;
+        WARN_PRINT_ONCE("QuantumEvolutionEngine: DOPRI5 hit its substep attempt limit before covering dt; "
+                        "see get_last_step_truncated()");
+    }
+}
+
+void QuantumEvolutionEngine::apply_liouvillian_vec(const std::complex<double>* in,
+                                                   std::complex<double>* out) {
+    const int n2 = m_dim * m_dim;
+    if (m_has_liouvillian) {
+        Eigen::Map<const Eigen::VectorXcd> in_vec(in, n2);
+        Eigen::Map<Eigen::VectorXcd> out_vec(out, n2);
+        out_vec.noalias() = m_liouvillian * in_vec;
+        return;
+    }
+
+    // Operator-sum fallback: view the vector as a row-major dim×dim ρ
+    RhoMatrix& rho_view = m_stage_buffers[0];
+    RhoMatrix& drho_view = m_stage_buffers[1];
+    std::copy(in, in + n2, rho_view.data());
+    compute_drho_general(rho_view, drho_view);
+    std::copy(drho_view.data(), drho_view.data() + n2, out);
+}
+
+void QuantumEvolutionEngine::compute_dissipator(RhoConstRef rho, RhoRef out, bool fast_only) {
+    const std::complex<double> one(1.0, 0.0);
+    const std::complex<double> minus_half(-0.5, 0.0);
+    out.setZero();
+    for (size_t k = 0; k < m_lindblads.size(); k++) {
+        if (fast_only && !m_fast_lindblads[k]) {
+            continue;
+        }
+        const auto& L = m_lindblads[k];
+        m_temp_buffer.noalias() = L->L * rho;
+        out.noalias() += m_temp_buffer * L->L_dag;
+        out.noalias() -= 0.5 * (L->LdagL * rho);
+        out.noalias() -= 0.5 * (rho * L->LdagL);
+    }
+    for (size_t k = 0; k < m_local_lindblads.size(); k++) {
+        if (fast_only && !m_fast_local_lindblads[k]) {
+            continue;
+        }
+        const LocalOperator& L_loc = m_local_lindblads[k];
+        m_temp_buffer.setZero();
+        local_apply_left(L_loc.op, L_loc.size, L_loc.mask, L_loc.offsets, one, rho, m_temp_buffer);
+        local_apply_right_adjoint(L_loc.op, L_loc.size, L_loc.mask, L_loc.offsets, one, m_temp_buffer, out);
+        const Eigen::Matrix4cd LdagL = L_loc.op.adjoint() * L_loc.op;  // Hermitian: right_adjoint applies ρ·L†L
+        local_apply_left(LdagL, L_loc.size, L_loc.mask, L_loc.offsets, minus_half, rho, out);
+        local_apply_right_adjoint(LdagL, L_loc.size, L_loc.mask, L_loc.offsets, minus_half, rho, out);
+    }
+}
+
+void QuantumEvolutionEngine::classify_channel_rates() {
+    // Rate bound per channel: ||L†L||_∞ (max absolute row sum)
+    struct Channel {
+        double rate;
+        bool local;
+        size_t index;
+    };
+    std::vector<Channel> channels;
+    channels.reserve(m_lindblads.size() + m_local_lindblads.size());
+    for (size_t k = 0; k < m_lindblads.size(); k++) {
+        const SparseCM& LdagL = m_lindblads[k]->LdagL;
+        double rate = 0.0;
+        for (int r = 0; r < LdagL.outerSize(); r++) {
+            double row = 0.0;
+            for (SparseCM::InnerIterator it(LdagL, r); it; ++it) {
+                row += std::abs(it.value());
+            }
+            rate = std::max(rate, row);
+        }
+        channels.push_back({rate, false, k});
+    }
+    for (size_t k = 0; k < m_local_lindblads.size(); k++) {
+        const Eigen::Matrix4cd LdagL = m_local_lindblads[k].op.adjoint() * m_local_lindblads[k].op;
+        channels.push_back({LdagL.cwiseAbs().rowwise().sum().maxCoeff(), true, k});
+    }
+    std::sort(channels.begin(), channels.end(),
+              [](const Channel& a, const Channel& b) { return a.rate < b.rate; });
+
+    // Split above the widest neighbouring gap, if it is at least m_multirate_gap wide
+    size_t split = channels.size();
+    double widest = m_multirate_gap;
+    for (size_t i = 1; i < channels.size(); i++) {
+        const double below = std::max(channels[i - 1].rate, 1e-300);
+        if (channels[i].rate / below >= widest) {
+            widest = channels[i].rate / below;
+            split = i;
+        }
+    }
+
+    m_fast_lindblads.assign(m_lindblads.size(), false);
+    m_fast_local_lindblads.assign(m_local_lindblads.size(), false);
+    m_fast_channel_count = static_cast<int>(channels.size() - split);
+    m_fast_rate = 0.0;
+    for (size_t i = split; i < channels.size(); i++) {
+        (channels[i].local ? m_fast_local_lindblads : m_fast_lindblads)[channels[i].index] = true;
+        m_fast_rate = std::max(m_fast_rate, channels[i].rate);
+    }
+}
+
+void QuantumEvolutionEngine::integrate_multirate(RhoRef rho, double T, double h_max) {
+    const int steps = std::max(1, static_cast<int>(std::ceil(T / std::max(h_max, 1e-12) - 1e-9)));
+    const double h = T / steps;
+    const int fast_steps = m_fast_channel_count > 0
+        ? std::max(1, static_cast<int>(std::ceil(0.5 * h * m_fast_rate / MULTIRATE_SUBSTEP_CFL)))
+        : 0;
+    const double h_fast = fast_steps > 0 ? 0.5 * h / fast_steps : 0.0;
+    auto fast_half = [&]() {
+        for (int f = 0; f < fast_steps; f++) {
+            compute_dissipator(rho, m_drho_buffer, true);
+            rho += h_fast * m_drho_buffer;
+        }
+    };
+
+    // Outer Euler step on 𝓛 - D_fast; the stage buffer holds D_fast(ρ)
+    if (fast_steps > 0 && (m_stage_buffers.empty() || m_stage_buffers[0].rows() != m_dim)) {
+        m_stage_buffers.assign(1, RhoMatrix::Zero(m_dim, m_dim));
+    }
+    for (int s = 0; s < steps; s++) {
+        fast_half();
+        compute_drho(rho, m_drho_buffer);
+        if (fast_steps > 0) {
+            compute_dissipator(rho, m_stage_buffers[0], true);
+            m_drho_buffer -= m_stage_buffers[0];
+        }
+        rho += h * m_drho_buffer;
+        fast_half();
+    }
+    m_last_substeps = steps * (1 + 2 * fast_steps);
+    m_last_rhs_evals = steps;
+}
+
+void QuantumEvolutionEngine::integrate_kraus(RhoRef rho, double T, double h_max) {
+    const int steps = std::max(1, static_cast<int>(std::ceil(T / std::max(h_max, 1e-12) - 1e-9)));
+    const double h = T / steps;
+    const std::complex<double> one(1.0, 0.0);
+    if (m_stage_buffers.empty() || m_stage_buffers[0].rows() != m_dim) {
+        m_stage_buffers.assign(1, RhoMatrix::Zero(m_dim, m_dim));
+    }
+    RhoMatrix& drift = m_stage_buffers[0];  // H_eff ρ H_eff†
+    for (int s = 0; s < steps; s++) {
+        const double trace = rho.trace().real();
+        compute_drho(rho, m_drho_buffer);
+
+        // m_temp_buffer = H_eff ρ, drift = m_temp_buffer H_eff†
+        m_temp_buffer.setZero();
+        if (m_has_heff) {
+            m_temp_buffer.noalias() = m_heff * rho;
+        }
+        for (const auto& entry : m_local_heff) {
+            local_apply_left(entry.op, entry.size, entry.mask, entry.offsets, one, rho, m_temp_buffer);
+        }
+        drift.setZero();
+        if (m_has_heff) {
+            drift.noalias() = m_temp_buffer * m_heff.adjoint();
+        }
+        for (const auto& entry : m_local_heff) {
+            local_apply_right_adjoint(entry.op, entry.size, entry.mask, entry.offsets, one, m_temp_buffer, drift);
+        }
+
+        rho += h * m_drho_buffer;
+        rho += (h * h) * drift;
+        const double new_trace = rho.trace().real();
+        if (std::isfinite(new_trace) && new_trace > 1e-300 && trace > 0.0) {
+            rho *= trace / new_trace;
+        }
+    }
+    m_last_substeps = steps;
+    m_last_rhs_evals = steps;
+}
+
+void QuantumEvolutionEngine::set_multirate_rate_gap(double ratio) {
+    m_multirate_gap = std::max(1.0, ratio);
+    if (m_finalized) {
+        classify_channel_rates();
+    }
+}
+
+double QuantumEvolutionEngine::get_multirate_rate_gap() const {
+    return m_multirate_gap;
+}
+
+int QuantumEvolutionEngine::get_fast_channel_count() const {
+    return m_fast_channel_count;
+}
+
+void QuantumEvolutionEngine::update_strang_propagators(double h) {
+    if (!m_has_strang_basis || m_strang_version != m_operator_version) {
+        // H (global plus local terms) diagonalized once per operator version;
+        // every step size after that is two dense products
+        Eigen::MatrixXcd H = Eigen::MatrixXcd::Zero(m_dim, m_dim);
+        if (m_has_hamiltonian) {
+            H += Eigen::MatrixXcd(m_hamiltonian);
+        }
+        for (const auto& H_loc : m_local_hamiltonians) {
+            H += Eigen::MatrixXcd(expand_local(H_loc.op, H_loc.size, H_loc.mask, H_loc.offsets, m_dim));
+        }
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> solver(0.5 * (H + H.adjoint()));
+        m_strang_basis = solver.eigenvectors();
+        m_strang_energies = solver.eigenvalues();
+        m_strang_version = m_operator_version;
+        m_has_strang_basis = true;
+        m_strang_h = -1.0;
+    }
+    if (h == m_strang_h) {
+        return;
+    }
+    auto propagator = [this](double t, RhoMatrix& out) {
+        Eigen::VectorXcd phases(m_dim);
+        for (int i = 0; i < m_dim; i++) {
+            phases(i) = std::polar(1.0, -m_strang_energies(i) * t);
+        }
+        out.noalias() = m_strang_basis * phases.asDiagonal() * m_strang_basis.adjoint();
+    };
+    propagator(0.5 * h, m_strang_half);
+    propagator(h, m_strang_full);
+    m_strang_h = h;
+}
+
+void QuantumEvolutionEngine::integrate_strang(RhoRef rho, double T, double h_max) {
+    const int steps = std::max(1, static_cast<int>(std::ceil(T / std::max(h_max, 1e-12) - 1e-9)));
+    const double h = T / steps;
+    update_strang_propagators(h);
+
+    // U_½ D U_½ per step; the closing and opening half steps of neighbouring
+    // steps merge into one full U, so n steps cost n + 1 conjugations
+    auto conjugate = [this, &rho](const RhoMatrix& U) {
+        m_temp_buffer.noalias() = U * rho;
+        rho.noalias() = m_temp_buffer * U.adjoint();
+    };
+    conjugate(m_strang_half);
+    for (int s = 0; s < steps; s++) {
+        compute_dissipator(rho, m_drho_buffer);
+        rho += h * m_drho_buffer;
+        conjugate(s + 1 < steps ? m_strang_full : m_strang_half);
+    }
+    m_last_substeps = steps;
+    m_last_rhs_evals = steps;
+}
+
+void QuantumEvolutionEngine::integrate_krylov(RhoRef rho, double T) {
+    // Arnoldi expmv: v(t+τ) ≈ β V_m exp(τ H_m) e₁ with β = ||v||.
+    // The basis does not depend on τ, so a rejected τ only re-exponentiates
+    // the small m×m Hessenberg matrix.
+    static constexpr int MAX_SUBSTEPS = 1000;
+
+    m_last_substeps = 0;
+    m_last_rhs_evals = 0;
+    if (T <= 0.0 || m_dim <= 0) {
+        return;
+    }
+
+    const int n2 = m_dim * m_dim;
+    const int m_max = std::min(m_krylov_dim, n2);
+    if (m_krylov_basis.rows() != n2 || m_krylov_basis.cols() != m_max + 1) {
+        m_krylov_basis.resize(n2, m_max + 1);
+    }
+    if (!m_has_liouvillian &&
+        (static_cast<int>(m_stage_buffers.size()) < 2 || m_stage_buffers[0].rows() != m_dim)) {
+        m_stage_buffers.assign(9, RhoMatrix::Zero(m_dim, m_dim));
     }
 
-    Eigen::MatrixXcd rho = unpack_dense(rho_data);
-    Eigen::MatrixXcd drho = Eigen::MatrixXcd::Zero(m_dim, m_dim);
+    Eigen::Map<Eigen::VectorXcd> v(rho.data(), n2);
+    Eigen::MatrixXcd hessenberg(m_max + 1, m_max);
+    double t = 0.0;
+    double tau = (m_krylov_tau > 0.0) ? std::min(m_krylov_tau, T) : T;
 
-    // =========================================================================
-    // Term 1: Hamiltonian evolution -i[H, ρ]
-    // =========================================================================
-    if (m_has_hamiltonian) {
-        // [H, ρ] = Hρ - ρH
-        Eigen::MatrixXcd commutator = m_hamiltonian * rho - rho * m_hamiltonian;
-        drho += std::complex<double>(0.0, -1.0) * commutator;
-    }
+    for (int sub = 0; sub < MAX_SUBSTEPS && t < T * (1.0 - 1e-12); sub++) {
+        double beta = v.norm();
+        if (beta <= 0.0 || !std::isfinite(beta)) {
+            break;
+        }
 
-    // =========================================================================
-    // Term 2: Lindblad dissipation Σ_k (L_k ρ L_k† - ½{L_k†L_k, ρ})
-    // =========================================================================
-    for (size_t k = 0; k < m_lindblads.size(); k++) {
-        const auto& L = m_lindblads[k];
-        const auto& L_dag = m_lindblad_dags[k];
-        const auto& LdagL = m_LdagLs[k];
+        // Arnoldi with modified Gram–Schmidt
+        m_krylov_basis.col(0) = v / beta;
+        hessenberg.setZero();
+        int m = m_max;
+        bool happy_breakdown = false;
+        for (int j = 0; j < m_max; j++) {
+            apply_liouvillian_vec(m_krylov_basis.col(j).data(), m_krylov_basis.col(j + 1).data());
+            m_last_rhs_evals++;
+            for (int i = 0; i <= j; i++) {
+                std::complex<double> h = m_krylov_basis.col(i).dot(m_krylov_basis.col(j + 1));
+                hessenberg(i, j) = h;
+                m_krylov_basis.col(j + 1) -= h * m_krylov_basis.col(i);
+            }
+            double h_next = m_krylov_basis.col(j + 1).norm();
+            hessenberg(j + 1, j) = h_next;
+            if (h_next < 1e-12) {
+                // Invariant subspace found: the projection is exact for any τ
+                m = j + 1;
+                happy_breakdown = true;
+                break;
+            }
+            m_krylov_basis.col(j + 1) /= h_next;
+        }
 
-        // L ρ L† (sparse × dense × sparse)
-        Eigen::MatrixXcd L_rho = L * rho;           // Sparse × Dense
-        Eigen::MatrixXcd L_rho_Ldag = L_rho * L_dag; // Dense × Sparse
+        double remaining = T - t;
+        tau = happy_breakdown ? remaining : std::min(tau, remaining);
+        const double tol = m_rtol * beta;
+        Eigen::MatrixXcd expH;
+        double err = 0.0;
+        for (int shrink = 0; shrink < 30; shrink++) {
+            Eigen::MatrixXcd tauH = tau * hessenberg.topLeftCorner(m, m);
+            expH = tauH.exp();
+            // Saad's a-posteriori estimate: β h_{m+1,m} |e_mᵀ exp(τH_m) e₁|
+            err = happy_breakdown ? 0.0
+                                  : beta * std::abs(hessenberg(m, m - 1)) * std::abs(expH(m - 1, 0));
+            if (err <= tol) {
+                break;
+            }
+            tau *= 0.5;
+        }
 
-        // {L†L, ρ} = L†L ρ + ρ L†L (anticommutator with sparse L†L)
-        Eigen::MatrixXcd LdagL_rho = LdagL * rho;   // Sparse × Dense
-        Eigen::MatrixXcd rho_LdagL = rho * LdagL;   // Dense × Sparse
+        v.noalias() = beta * (m_krylov_basis.leftCols(m) * expH.col(0));
+        t += tau;
+        m_last_substeps++;
 
-        // Dissipator: L ρ L† - 0.5 * (L†L ρ + ρ L†L)
-        drho += L_rho_Ldag - 0.5 * (LdagL_rho + rho_LdagL);
+        m_krylov_tau = tau;
+        if (err < 0.1 * tol) {
+            tau *= 2.0;  // Comfortably accurate: try a longer substep next
+        }
     }
+}
 
-    // =========================================================================
-    // Euler integration: ρ(t+dt) = ρ(t) + dt * dρ/dt
-    // =========================================================================
-    rho += static_cast<double>(dt) * drho;
-    cap_trace_and_clamp_diag(rho);
+bool QuantumEvolutionEngine::is_packed_valid(const PackedFloat64Array& data) const {
+    return m_dim > 0 && data.size() == static_cast<int64_t>(m_dim) * m_dim * 2;
+}
 
-    return pack_dense(rho);
+Eigen::Map<const QuantumEvolutionEngine::RhoMatrix> QuantumEvolutionEngine::map_packed(
+    const PackedFloat64Array& data) const {
+    // Read-only zero-copy view (packed row-major [re, im] == RhoMatrix storage)
+    return Eigen::Map<const RhoMatrix>(
+        reinterpret_cast<const std::complex<double>*>(data.ptr()), m_dim, m_dim);
 }
 
-PackedFloat64Array QuantumEvolutionEngine::evolve(const PackedFloat64Array& rho_data, float dt, float max_dt) {
-    if (!m_finalized) {
-        UtilityFunctions::push_warning("QuantumEvolutionEngine: call finalize() first!");
-        return rho_data;
-    }
+QuantumEvolutionEngine::RhoMatrix QuantumEvolutionEngine::unpack_dense(const PackedFloat64Array& data) const {
+    return RhoMatrix(map_packed(data));
+}
 
-    // Single evolution step using max_dt as the actual timestep (no subcycling)
-    // max_dt is the granularity setting (user-adjustable)
-    // dt parameter is ignored (legacy from subcycling era)
-    float actual_dt = (max_dt > 0.0f) ? max_dt : dt;
-    return evolve_step(rho_data, actual_dt);
+PackedFloat64Array QuantumEvolutionEngine::pack_dense(RhoConstRef mat) const {
+    PackedFloat64Array packed;
+    packed.resize(m_dim * m_dim * 2);
+    NATIVE_ALLOC_PACKED(packed);
+    Eigen::Map<RhoMatrix>(reinterpret_cast<std::complex<double>*>(packed.ptrw()), m_dim, m_dim) = mat;
+    return packed;
 }
 
-Eigen::MatrixXcd QuantumEvolutionEngine::unpack_dense(const PackedFloat64Array& data) const {
-    Eigen::MatrixXcd mat(m_dim, m_dim);
+QuantumEvolutionEngine::RhoMatrix QuantumEvolutionEngine::unpack_hermitian_matrix(const PackedFloat64Array& data) const {
+    RhoMatrix mat(m_dim, m_dim);
     const double* ptr = data.ptr();
+    int idx = 0;
 
     for (int i = 0; i < m_dim; i++) {
-        for (int j = 0; j < m_dim; j++) {
-            int idx = (i * m_dim + j) * 2;
-            mat(i, j) = std::complex<double>(ptr[idx], ptr[idx + 1]);
+        mat(i, i) = std::complex<double>(ptr[idx], 0.0);
+        idx++;
+        for (int j = i + 1; j < m_dim; j++) {
+            std::complex<double> v(ptr[idx], ptr[idx + 1]);
+            mat(i, j) = v;
+            mat(j, i) = std::conj(v);
+            idx += 2;
         }
     }
     return mat;
 }
 
-PackedFloat64Array QuantumEvolutionEngine::pack_dense(const Eigen::MatrixXcd& mat) const {
+PackedFloat64Array QuantumEvolutionEngine::pack_hermitian_matrix(RhoConstRef mat) const {
     PackedFloat64Array packed;
-    packed.resize(m_dim * m_dim * 2);
+    packed.resize(m_dim * m_dim);
+    NATIVE_ALLOC_PACKED(packed);
     double* ptr = packed.ptrw();
+    int idx = 0;
 
     for (int i = 0; i < m_dim; i++) {
-        for (int j = 0; j < m_dim; j++) {
-            int idx = (i * m_dim + j) * 2;
-            ptr[idx] = mat(i, j).real();
-            ptr[idx + 1] = mat(i, j).imag();
+        ptr[idx++] = mat(i, i).real();
+        for (int j = i + 1; j < m_dim; j++) {
+            ptr[idx++] = mat(i, j).real();
+            ptr[idx++] = mat(i, j).imag();
         }
     }
     return packed;
@@ -305,37 +3413,26 @@ PackedFloat64Array QuantumEvolutionEngine::pack_dense(const Eigen::MatrixXcd& ma
 // ============================================================================
 
 Eigen::MatrixXcd QuantumEvolutionEngine::partial_trace_single(
-    const Eigen::MatrixXcd& rho, int qubit, int num_qubits) const {
+    RhoConstRef rho, int qubit, int num_qubits) const {
     // Trace out all qubits except 'qubit', returning 2×2 reduced density matrix
     // Uses the formula: ρ_A = Tr_B(ρ) where B is the complement of qubit A
-
-    int dim = 1 << num_qubits;
     Eigen::MatrixXcd reduced = Eigen::MatrixXcd::Zero(2, 2);
+    std::shared_ptr<const PartialTraceTables> tables = PartialTraceTables::get(num_qubits);
+    if (!tables || (1 << num_qubits) > rho.rows() || qubit < 0 || qubit >= num_qubits) {
+        return reduced;
+    }
 
-    // For each element (a, b) of the 2×2 reduced matrix (a, b ∈ {0, 1})
+    // Gather over the shared base table (all other bits enumerated, qubit = 0)
+    const int32_t* base = tables->single(qubit);
+    const int count = tables->single_size();
+    const int32_t bit = 1 << qubit;
     for (int a = 0; a < 2; a++) {
         for (int b = 0; b < 2; b++) {
+            const int32_t row_off = a ? bit : 0;
+            const int32_t col_off = b ? bit : 0;
             std::complex<double> sum(0.0, 0.0);
-
-            // Sum over all basis states where qubit has value a (row) and b (col)
-            // and all other qubits have the same value (trace condition)
-            for (int other_bits = 0; other_bits < (1 << (num_qubits - 1)); other_bits++) {
-                // Construct full basis state index with qubit at position 'qubit'
-                // Insert 'a' at position qubit for row, 'b' for column
-                int row_idx = 0, col_idx = 0;
-                int bit_pos = 0;
-                for (int q = 0; q < num_qubits; q++) {
-                    if (q == qubit) {
-                        row_idx |= (a << q);
-                        col_idx |= (b << q);
-                    } else {
-                        int other_bit = (other_bits >> bit_pos) & 1;
-                        row_idx |= (other_bit << q);
-                        col_idx |= (other_bit << q);  // Same value for trace
-                        bit_pos++;
-                    }
-                }
-                sum += rho(row_idx, col_idx);
+            for (int k = 0; k < count; k++) {
+                sum += rho(base[k] + row_off, base[k] + col_off);
             }
             reduced(a, b) = sum;
         }
@@ -344,50 +3441,35 @@ Eigen::MatrixXcd QuantumEvolutionEngine::partial_trace_single(
 }
 
 Eigen::MatrixXcd QuantumEvolutionEngine::partial_trace_complement(
-    const Eigen::MatrixXcd& rho, int qubit_a, int qubit_b, int num_qubits) const {
+    RhoConstRef rho, int qubit_a, int qubit_b, int num_qubits) const {
     // Trace out all qubits except qubit_a and qubit_b, returning 4×4 reduced matrix
-    // Basis order: |00⟩, |01⟩, |10⟩, |11⟩ where first digit is qubit_a, second is qubit_b
-
-    int dim = 1 << num_qubits;
+    // Basis order: |00⟩, |01⟩, |10⟩, |11⟩ where first digit is the lower qubit
     Eigen::MatrixXcd reduced = Eigen::MatrixXcd::Zero(4, 4);
+    std::shared_ptr<const PartialTraceTables> tables = PartialTraceTables::get(num_qubits);
+    if (!tables || num_qubits < 2 || (1 << num_qubits) > rho.rows() || qubit_a == qubit_b ||
+        qubit_a < 0 || qubit_b < 0 || qubit_a >= num_qubits || qubit_b >= num_qubits) {
+        return reduced;
+    }
 
-    // Ensure qubit_a < qubit_b for consistent ordering
-    int q_lo = std::min(qubit_a, qubit_b);
-    int q_hi = std::max(qubit_a, qubit_b);
-    bool swapped = (qubit_a > qubit_b);
+    // Local index l -> offset of the kept bits in the full index. The lower
+    // qubit is always the high digit (qubit_a when qubit_a < qubit_b).
+    const int q_lo = std::min(qubit_a, qubit_b);
+    const int q_hi = std::max(qubit_a, qubit_b);
+    int32_t offsets[4];
+    for (int l = 0; l < 4; l++) {
+        offsets[l] = (((l >> 1) & 1) << q_lo) | ((l & 1) << q_hi);
+    }
 
-    // For each element of the 4×4 reduced matrix
+    // Gather over the shared base table (both kept bits zero)
+    const int32_t* base = tables->pair(q_lo, q_hi);
+    const int count = tables->pair_size();
     for (int row_ab = 0; row_ab < 4; row_ab++) {
         for (int col_ab = 0; col_ab < 4; col_ab++) {
-            // Extract qubit values from 2-bit indices
-            int a_row = swapped ? (row_ab & 1) : ((row_ab >> 1) & 1);
-            int b_row = swapped ? ((row_ab >> 1) & 1) : (row_ab & 1);
-            int a_col = swapped ? (col_ab & 1) : ((col_ab >> 1) & 1);
-            int b_col = swapped ? ((col_ab >> 1) & 1) : (col_ab & 1);
-
+            const int32_t row_off = offsets[row_ab];
+            const int32_t col_off = offsets[col_ab];
             std::complex<double> sum(0.0, 0.0);
-
-            // Sum over all other qubits (trace condition: same value in row and col)
-            int other_qubits = num_qubits - 2;
-            for (int other_bits = 0; other_bits < (1 << other_qubits); other_bits++) {
-                int row_idx = 0, col_idx = 0;
-                int bit_pos = 0;
-
-                for (int q = 0; q < num_qubits; q++) {
-                    if (q == qubit_a) {
-                        row_idx |= (a_row << q);
-                        col_idx |= (a_col << q);
-                    } else if (q == qubit_b) {
-                        row_idx |= (b_row << q);
-                        col_idx |= (b_col << q);
-                    } else {
-                        int other_bit = (other_bits >> bit_pos) & 1;
-                        row_idx |= (other_bit << q);
-                        col_idx |= (other_bit << q);  // Same for trace
-                        bit_pos++;
-                    }
-                }
-                sum += rho(row_idx, col_idx);
+            for (int k = 0; k < count; k++) {
+                sum += rho(base[k] + row_off, base[k] + col_off);
             }
             reduced(row_ab, col_ab) = sum;
         }
@@ -395,6 +3477,97 @@ Eigen::MatrixXcd QuantumEvolutionEngine::partial_trace_complement(
     return reduced;
 }
 
+PackedFloat64Array QuantumEvolutionEngine::compute_subsystem_entropies(
+    const PackedFloat64Array& rho_data, int num_qubits, const Array& subsets) {
+    // S(ρ_S) in bits for each subset S (qubit q = basis bit q, as
+    // compute_all_mutual_information), in input order
+    PackedFloat64Array entropies;
+    entropies.resize(subsets.size());
+    if (subsets.is_empty()) {
+        return entropies;
+    }
+    if (!is_packed_valid(rho_data) || num_qubits <= 0 || num_qubits > 30 || (1 << num_qubits) != m_dim) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: compute_subsystem_entropies needs dim == 2^num_qubits");
+        entropies.fill(0.0);
+        return entropies;
+    }
+    Eigen::Map<const RhoMatrix> rho = map_packed(rho_data);
+    double* ptr = entropies.ptrw();
+
+    // Subsets as bitmasks (0 = invalid)
+    const int count = subsets.size();
+    std::vector<int> masks(count, 0);
+    for (int s = 0; s < count; s++) {
+        Variant entry = subsets[s];
+        PackedInt32Array qubits;
+        if (entry.get_type() == Variant::PACKED_INT32_ARRAY) {
+            qubits = entry;
+        } else if (entry.get_type() == Variant::ARRAY || entry.get_type() == Variant::PACKED_INT64_ARRAY) {
+            Array items = entry;
+            for (int k = 0; k < items.size(); k++) {
+                qubits.push_back(static_cast<int>(items[k]));
+            }
+        }
+        int mask = 0;
+        bool valid = !qubits.is_empty() && qubits.size() <= SUBSYSTEM_MAX_QUBITS;
+        for (int k = 0; valid && k < qubits.size(); k++) {
+            const int q = qubits[k];
+            valid = q >= 0 && q < num_qubits && !(mask & (1 << q));
+            mask |= 1 << q;
+        }
+        if (!valid) {
+            UtilityFunctions::push_warning("QuantumEvolutionEngine: Invalid subsystem at index " + String::num_int64(s));
+            continue;
+        }
+        masks[s] = mask;
+    }
+
+    // Largest subsets first, so smaller ones can be traced down from a cached
+    // superset (2^|T| × 2^|T|) instead of from the full ρ (dim × dim)
+    std::vector<int> order(count);
+    for (int s = 0; s < count; s++) {
+        order[s] = s;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return __builtin_popcount(masks[a]) > __builtin_popcount(masks[b]);
+    });
+
+    std::map<int, Eigen::MatrixXcd> reduced_cache;  // mask -> ρ_mask
+    for (int s : order) {
+        const int mask = masks[s];
+        if (mask == 0) {
+            ptr[s] = 0.0;
+            continue;
+        }
+
+        auto hit = reduced_cache.find(mask);
+        if (hit == reduced_cache.end()) {
+            // Smallest cached superset, else the full state
+            int parent = 0;
+            for (const auto& entry : reduced_cache) {
+                if ((entry.first & mask) == mask &&
+                    (parent == 0 || __builtin_popcount(entry.first) < __builtin_popcount(parent))) {
+                    parent = entry.first;
+                }
+            }
+            Eigen::MatrixXcd reduced = (parent != 0)
+                ? reduce_to_bits(reduced_cache[parent], __builtin_popcount(parent), compress_bits(mask, parent))
+                : reduce_to_bits(rho, num_qubits, mask);
+            hit = reduced_cache.emplace(mask, std::move(reduced)).first;
+        }
+
+        const Eigen::MatrixXcd& reduced = hit->second;
+        if (reduced.rows() == 2) {
+            ptr[s] = von_neumann_entropy_2x2(reduced);
+        } else if (reduced.rows() == 4) {
+            ptr[s] = von_neumann_entropy_4x4(reduced);
+        } else {
+            ptr[s] = von_neumann_entropy(reduced);
+        }
+    }
+    return entropies;
+}
+
 double QuantumEvolutionEngine::von_neumann_entropy(const Eigen::MatrixXcd& reduced_rho) const {
     // S(ρ) = -Tr(ρ log ρ) = -Σ λ_i log λ_i (in bits)
     // Use eigenvalue decomposition
@@ -416,8 +3589,22 @@ double QuantumEvolutionEngine::von_neumann_entropy(const Eigen::MatrixXcd& reduc
     return std::max(entropy, 0.0);  // Ensure non-negative due to numerical errors
 }
 
+double QuantumEvolutionEngine::von_neumann_entropy_2x2(
+    const Eigen::Matrix<std::complex<double>, 2, 2>& reduced_rho) const {
+    double lambda[2];
+    hermitian_eigenvalues_2x2(reduced_rho, lambda);
+    return entropy_from_eigenvalues(lambda, 2);
+}
+
+double QuantumEvolutionEngine::von_neumann_entropy_4x4(
+    const Eigen::Matrix<std::complex<double>, 4, 4>& reduced_rho) const {
+    double lambda[4];
+    hermitian_eigenvalues_4x4(reduced_rho, lambda);
+    return entropy_from_eigenvalues(lambda, 4);
+}
+
 double QuantumEvolutionEngine::mutual_information(
-    const Eigen::MatrixXcd& rho, int qubit_a, int qubit_b, int num_qubits) const {
+    RhoConstRef rho, int qubit_a, int qubit_b, int num_qubits) const {
     // I(A:B) = S(A) + S(B) - S(AB)
 
     Eigen::MatrixXcd rho_a = partial_trace_single(rho, qubit_a, num_qubits);
@@ -445,37 +3632,45 @@ PackedFloat64Array QuantumEvolutionEngine::compute_all_mutual_information(
     int num_pairs = num_qubits * (num_qubits - 1) / 2;
     PackedFloat64Array mi_values;
     mi_values.resize(num_pairs);
+    NATIVE_ALLOC_PACKED(mi_values);
 
     if (num_qubits < 2) {
         return mi_values;  // No pairs for 0 or 1 qubit
     }
 
-    Eigen::MatrixXcd rho = unpack_dense(rho_data);
+    Eigen::Map<const RhoMatrix> rho = map_packed(rho_data);
     double* ptr = mi_values.ptrw();
 
-    // Pre-compute all single-qubit reduced density matrices and entropies
-    std::vector<Eigen::MatrixXcd> single_rhos(num_qubits);
+    // All single and pair reduced matrices from one sweep over ρ
+    // (this path numbers qubit q as basis bit q)
+    ReducedStates reduced;
+    compute_reduced_states(rho, num_qubits, true, reduced);
     std::vector<double> single_entropies(num_qubits);
 
     for (int q = 0; q < num_qubits; q++) {
-        single_rhos[q] = partial_trace_single(rho, q, num_qubits);
-        single_entropies[q] = von_neumann_entropy(single_rhos[q]);
+        single_entropies[q] = von_neumann_entropy_2x2(reduced.singles[q]);
     }
 
     // Now compute MI for each pair using cached single-qubit entropies
     // I(A:B) = S(A) + S(B) - S(AB)
-    int idx = 0;
-    for (int i = 0; i < num_qubits; i++) {
-        for (int j = i + 1; j < num_qubits; j++) {
+    // Pairs are independent: large biomes split them across the shared pool
+    // (upper-triangular idx equals pair_index(i, j) in this bit convention)
+    std::vector<int> pair_i, pair_j;
+    enumerate_pairs(num_qubits, pair_i, pair_j);
+    auto pair_range = [&](int begin, int end) {
+        for (int idx = begin; idx < end; idx++) {
             // Only need to compute S(AB) - the two-qubit joint entropy
-            Eigen::MatrixXcd rho_ab = partial_trace_complement(rho, i, j, num_qubits);
-            double S_ab = von_neumann_entropy(rho_ab);
+            double S_ab = von_neumann_entropy_4x4(reduced.pairs[idx]);
 
             // MI = S(i) + S(j) - S(ij) using cached single-qubit entropies
-            double mi = single_entropies[i] + single_entropies[j] - S_ab;
+            double mi = single_entropies[pair_i[idx]] + single_entropies[pair_j[idx]] - S_ab;
             ptr[idx] = std::max(mi, 0.0);  // Ensure non-negative
-            idx++;
         }
+    };
+    if (use_parallel_mi(num_pairs)) {
+        NativeThreadPool::shared().parallel_for(0, num_pairs, 0, pair_range);
+    } else {
+        pair_range(0, num_pairs);
     }
 
     return mi_values;
@@ -485,84 +3680,10 @@ PackedFloat64Array QuantumEvolutionEngine::compute_all_mutual_information(
 // OPTIMIZED ADAPTIVE MI COMPUTATION
 // ============================================================================
 
-Eigen::Matrix<std::complex<double>, 2, 2> QuantumEvolutionEngine::partial_trace_single_2x2(
-    const Eigen::MatrixXcd& rho, int qubit, int num_qubits) const {
-    // Trace out all qubits except 'qubit', return fixed 2x2 matrix
-    Eigen::Matrix<std::complex<double>, 2, 2> result;
-    result.setZero();
-
-    int dim = 1 << num_qubits;
-    int qubit_mask = 1 << (num_qubits - 1 - qubit);
-
-    for (int i = 0; i < dim; i++) {
-        for (int j = 0; j < dim; j++) {
-            // Check if indices differ only in the target qubit position
-            int other_bits_i = i & ~qubit_mask;
-            int other_bits_j = j & ~qubit_mask;
-            if (other_bits_i != other_bits_j) continue;
-
-            int qi = (i & qubit_mask) ? 1 : 0;
-            int qj = (j & qubit_mask) ? 1 : 0;
-            result(qi, qj) += rho(i, j);
-        }
-    }
-    return result;
-}
-
-Eigen::Matrix<std::complex<double>, 4, 4> QuantumEvolutionEngine::partial_trace_pair_4x4(
-    const Eigen::MatrixXcd& rho, int qa, int qb, int num_qubits) const {
-    // Trace out all qubits except qa and qb, return fixed 4x4 matrix
-    // Uses smart algorithm: O(4 × 2^(n-2)) instead of O(4^n)
-    Eigen::Matrix<std::complex<double>, 4, 4> result;
-    result.setZero();
-
-    // Ensure consistent ordering
-    int q_lo = std::min(qa, qb);
-    int q_hi = std::max(qa, qb);
-    bool swapped = (qa > qb);
-
-    int other_qubits = num_qubits - 2;
-    int other_dim = 1 << other_qubits;
-
-    // For each element of the 4×4 reduced matrix
-    for (int row_ab = 0; row_ab < 4; row_ab++) {
-        for (int col_ab = 0; col_ab < 4; col_ab++) {
-            // Extract qubit values from 2-bit indices
-            int a_row = swapped ? (row_ab & 1) : ((row_ab >> 1) & 1);
-            int b_row = swapped ? ((row_ab >> 1) & 1) : (row_ab & 1);
-            int a_col = swapped ? (col_ab & 1) : ((col_ab >> 1) & 1);
-            int b_col = swapped ? ((col_ab >> 1) & 1) : (col_ab & 1);
-
-            std::complex<double> sum(0.0, 0.0);
-
-            // Sum over all other qubits (trace condition: same value in row and col)
-            for (int other_bits = 0; other_bits < other_dim; other_bits++) {
-                int row_idx = 0, col_idx = 0;
-                int bit_pos = 0;
-
-                for (int q = 0; q < num_qubits; q++) {
-                    int bit_val;
-                    if (q == q_lo) {
-                        row_idx |= (a_row << (num_qubits - 1 - q));
-                        col_idx |= (a_col << (num_qubits - 1 - q));
-                    } else if (q == q_hi) {
-                        row_idx |= (b_row << (num_qubits - 1 - q));
-                        col_idx |= (b_col << (num_qubits - 1 - q));
-                    } else {
-                        bit_val = (other_bits >> bit_pos) & 1;
-                        row_idx |= (bit_val << (num_qubits - 1 - q));
-                        col_idx |= (bit_val << (num_qubits - 1 - q));
-                        bit_pos++;
-                    }
-                }
-
-                sum += rho(row_idx, col_idx);
-            }
-
-            result(row_ab, col_ab) = sum;
-        }
-    }
-    return result;
+void QuantumEvolutionEngine::compute_reduced_states(
+    RhoConstRef rho, int num_qubits, bool with_pairs, ReducedStates& out,
+    double* purity, std::complex<double>* trace) const {
+    lindblad::compute_reduced_states(rho, num_qubits, with_pairs, out, purity, trace);
 }
 
 double QuantumEvolutionEngine::trace_rho_squared_2x2(
@@ -626,100 +3747,647 @@ PackedFloat64Array QuantumEvolutionEngine::compute_mi_adaptive(
     const PackedFloat64Array& rho_data, int num_qubits,
     double biome_purity, bool force_full_scan) {
     // OPTIMIZED MI computation:
-    // 1. On first call (force_full_scan): Screen all pairs to find candidates
-    // 2. On subsequent calls: Only compute for candidates
+    // 1. First call (or force_full_scan): Screen all pairs to find candidates
+    // 2. Subsequent calls: candidates (with exit hysteresis) + a budgeted
+    //    rotating re-screen of non-candidates
     // 3. Use linear entropy (no eigendecomp) when purity > 0.9
 
     int num_pairs = num_qubits * (num_qubits - 1) / 2;
     PackedFloat64Array mi_values;
     mi_values.resize(num_pairs);
+    NATIVE_ALLOC_PACKED(mi_values);
 
     if (num_qubits < 2) {
         return mi_values;
     }
 
-    Eigen::MatrixXcd rho = unpack_dense(rho_data);
-    double* ptr = mi_values.ptrw();
+    // Every single and pair reduced matrix from one sweep over ρ
+    ReducedStates reduced;
+    compute_reduced_states(map_packed(rho_data), num_qubits, true, reduced);
+    m_last_reused_observables = 0;
+    mi_adaptive_from_states(reduced, num_qubits, biome_purity, force_full_scan, mi_values.ptrw());
+    return mi_values;
+}
+
+void QuantumEvolutionEngine::mi_adaptive_from_states(
+    const ReducedStates& reduced, int num_qubits, double biome_purity,
+    bool force_full_scan, double* ptr) {
+    const int num_pairs = num_qubits * (num_qubits - 1) / 2;
+
+    // This path numbers qubits MSB-first (qubit q = basis bit n-1-q), so
+    // qubit i < j is the bit pair (n-1-j, n-1-i) with qubit i as the high
+    // local digit.
+    // Per-call lists live in m_mi_scratch (sized by finalize()), so a steady
+    // call does not touch the heap
+    MiScratch& scratch = m_mi_scratch;
+    reserve_mi_scratch(num_qubits);
+    std::vector<Eigen::Matrix<std::complex<double>, 2, 2>>& single_rhos = scratch.singles;
+    for (int q = 0; q < num_qubits; q++) {
+        single_rhos[q] = reduced.singles[num_qubits - 1 - q];
+    }
+
+    // Decide if we use linear approximation (cheap) or full eigendecomp
+    bool use_linear = m_mi_force_linear || (biome_purity > PURITY_HIGH_THRESHOLD);
+    MiScreenStats& screen_stats = m_mi_screen_stats;
+    screen_stats.calls++;
+    const uint64_t kept_before = screen_stats.candidates_kept;
+    (use_linear ? screen_stats.linear_calls : screen_stats.eigen_calls)++;
+
+    // Single-qubit entropies once per call (not once per pair) on the exact path
+    std::vector<double>& single_entropies = scratch.entropies;
+    if (!use_linear) {
+        for (int q = 0; q < num_qubits; q++) {
+            single_entropies[q] = von_neumann_entropy_2x2(single_rhos[q]);
+        }
+    }
+
+    // Candidate bitset persists across calls; a size mismatch (first call, or a
+    // different qubit count) forces a full screen, as does force_full_scan
+    const bool full_scan = force_full_scan ||
+                           static_cast<int>(m_mi_candidates.size()) != num_pairs;
+    if (full_scan) {
+        m_mi_candidates.assign(num_pairs, false);
+        m_mi_rescreen_cursor = 0;
+        m_mi_screen_marginals.assign(single_rhos.begin(), single_rhos.begin() + num_qubits);
+        screen_stats.full_scans++;
+    }
+
+    // Warm start: qubits whose marginal drifted since their last screen get
+    // every non-candidate pair re-screened this call (and a new snapshot)
+    const bool drift_check = !full_scan && m_mi_rescreen_drift > 0.0;
+    char* drifted = scratch.drifted.data();
+    std::fill(drifted, drifted + num_qubits, 0);
+    if (drift_check) {
+        if (static_cast<int>(m_mi_screen_marginals.size()) != num_qubits) {
+            m_mi_screen_marginals.assign(single_rhos.begin(), single_rhos.begin() + num_qubits);
+        }
+        for (int q = 0; q < num_qubits; q++) {
+            if (!within_tolerance<2>(single_rhos[q], m_mi_screen_marginals[q], m_mi_rescreen_drift)) {
+                drifted[q] = 1;
+                m_mi_screen_marginals[q] = single_rhos[q];
+            }
+        }
+    }
+
+    // Background re-screen: a rotating window of up to m_mi_rescreen_budget
+    // non-candidate pairs per call, so newly correlating pairs enter within
+    // ceil(pairs / budget) calls without a full-scan spike
+    char* rescreen = scratch.rescreen.data();
+    std::fill(rescreen, rescreen + num_pairs, 0);
+    if (!full_scan && m_mi_rescreen_budget > 0) {
+        int picked = 0;
+        int cursor = m_mi_rescreen_cursor % num_pairs;
+        for (int visited = 0; visited < num_pairs && picked < m_mi_rescreen_budget; visited++) {
+            if (!m_mi_candidates[cursor]) {
+                rescreen[cursor] = 1;
+                picked++;
+            }
+            cursor = (cursor + 1) % num_pairs;
+        }
+        m_mi_rescreen_cursor = cursor;
+    }
+
+    // Change tracking: a candidate pair's MI is reused while its 4×4 input is
+    // within tolerance of the snapshot (its single-qubit marginals then are
+    // too). Switching entropy mode invalidates every entry.
+    const bool tracking = m_observable_reuse_tol > 0.0;
+    if (tracking && (static_cast<int>(m_mi_cache.size()) != num_pairs || m_mi_cache_linear != use_linear)) {
+        m_mi_inputs.assign(num_pairs, Eigen::Matrix<std::complex<double>, 4, 4>::Zero());
+        m_mi_cache.assign(num_pairs, 0.0);
+        m_mi_cache_valid.assign(num_pairs, false);
+        m_mi_cache_linear = use_linear;
+    }
+
+    // Screening pass (serial: it advances the candidate state); pairs that
+    // need a fresh MI value are queued for the entropy pass below
+    std::vector<int>& work_idx = scratch.work_idx;
+    std::vector<int>& work_i = scratch.work_i;
+    std::vector<int>& work_j = scratch.work_j;
+    std::vector<const Eigen::Matrix<std::complex<double>, 4, 4>*>& work_rho = scratch.work_rho;
+    work_idx.clear();
+    work_i.clear();
+    work_j.clear();
+    work_rho.clear();
+
+    int idx = 0;
+    for (int i = 0; i < num_qubits; i++) {
+        for (int j = i + 1; j < num_qubits; j++) {
+            const bool was_candidate = m_mi_candidates[idx];
+            const bool drift_screen = !was_candidate && (drifted[i] || drifted[j]);
+            const bool screened = full_scan || drift_screen || rescreen[idx];
+            if (!was_candidate && !screened) {
+                ptr[idx] = 0.0;
+                screen_stats.pairs_skipped++;
+                idx++;
+                continue;
+            }
+            if (screened) {
+                screen_stats.pairs_screened++;
+                if (drift_screen) {
+                    screen_stats.pairs_drift_screened++;
+                }
+            }
+
+            const auto& rho_ab = reduced.pairs[reduced.pair_index(num_qubits - 1 - j, num_qubits - 1 - i)];
+            double deviation = screen_product_deviation(rho_ab, single_rhos[i], single_rhos[j]);
+
+            // Hysteresis: enter above MI_SCREEN_THRESHOLD, leave only below
+            // MI_EXIT_THRESHOLD, so pairs near the boundary don't flicker
+            bool is_candidate = was_candidate ? (deviation >= MI_EXIT_THRESHOLD)
+                                              : (deviation >= MI_SCREEN_THRESHOLD);
+            m_mi_candidates[idx] = is_candidate;
+            if (!is_candidate) {
+                // Not a candidate - MI is negligible
+                ptr[idx] = 0.0;
+                idx++;
+                continue;
+            }
+            screen_stats.candidates_kept++;
+
+            if (tracking && m_mi_cache_valid[idx] &&
+                within_tolerance<4>(rho_ab, m_mi_inputs[idx], m_observable_reuse_tol)) {
+                ptr[idx] = m_mi_cache[idx];
+                m_last_reused_observables++;
+                screen_stats.pairs_reused++;
+                idx++;
+                continue;
+            }
+
+            work_idx.push_back(idx);
+            work_i.push_back(i);
+            work_j.push_back(j);
+            work_rho.push_back(&rho_ab);
+            idx++;
+        }
+    }
+
+    m_mi_last_candidates = static_cast<int>(screen_stats.candidates_kept - kept_before);
+
+    // Entropy evaluation of the surviving candidates: independent per pair,
+    // split across the shared pool for large biomes; results land in ptr
+    // by pair index, so the output order is unchanged
+    const int work_count = static_cast<int>(work_idx.size());
+    auto work_range = [&](int begin, int end) {
+        for (int w = begin; w < end; w++) {
+            const int i = work_i[w];
+            const int j = work_j[w];
+            if (use_linear) {
+                ptr[work_idx[w]] = compute_mi_linear(*work_rho[w], single_rhos[i], single_rhos[j]);
+            } else {
+                // Exact entropies (closed-form fixed-size eigenvalues)
+                double S_ab = von_neumann_entropy_4x4(*work_rho[w]);
+                ptr[work_idx[w]] = std::max(0.0, single_entropies[i] + single_entropies[j] - S_ab);
+            }
+        }
+    };
+    NativeCounters::add(COUNTER_MI_PAIRS_EVALUATED, static_cast<uint64_t>(work_count));
+    NativeCounters::add(COUNTER_MI_PAIRS_SKIPPED, static_cast<uint64_t>(num_pairs - work_count));
+    if (use_parallel_mi(work_count)) {
+        NativeThreadPool::shared().parallel_for(0, work_count, 0, work_range);
+    } else {
+        work_range(0, work_count);
+    }
+
+    if (tracking) {
+        for (int w = 0; w < work_count; w++) {
+            m_mi_inputs[work_idx[w]] = *work_rho[w];
+            m_mi_cache[work_idx[w]] = ptr[work_idx[w]];
+            m_mi_cache_valid[work_idx[w]] = true;
+        }
+    }
+
+    // Screening audit: exact MI of every pair the screen left at zero
+    if (m_mi_audit_interval > 0 && --m_mi_audit_countdown <= 0) {
+        m_mi_audit_countdown = m_mi_audit_interval;
+        screen_stats.audits++;
+        std::vector<double>& audit_entropies = scratch.audit_entropies;
+        for (int q = 0; q < num_qubits; q++) {
+            audit_entropies[q] = use_linear ? von_neumann_entropy_2x2(single_rhos[q]) : single_entropies[q];
+        }
+        int audit_idx = 0;
+        for (int i = 0; i < num_qubits; i++) {
+            for (int j = i + 1; j < num_qubits; j++, audit_idx++) {
+                if (m_mi_candidates[audit_idx]) {
+                    continue;
+                }
+                const auto& rho_ab = reduced.pairs[reduced.pair_index(num_qubits - 1 - j, num_qubits - 1 - i)];
+                const double mi = audit_entropies[i] + audit_entropies[j] - von_neumann_entropy_4x4(rho_ab);
+                screen_stats.audit_pairs++;
+                if (mi >= MI_AUDIT_THRESHOLD) {
+                    screen_stats.audit_false_negatives++;
+                }
+            }
+        }
+    }
+}
+
+void QuantumEvolutionEngine::reserve_mi_scratch(int num_qubits) {
+    MiScratch& scratch = m_mi_scratch;
+    if (static_cast<int>(scratch.singles.size()) >= num_qubits) {
+        return;
+    }
+    const int num_pairs = num_qubits * (num_qubits - 1) / 2;
+    scratch.singles.resize(num_qubits);
+    scratch.entropies.resize(num_qubits);
+    scratch.audit_entropies.resize(num_qubits);
+    scratch.drifted.resize(num_qubits);
+    scratch.rescreen.resize(num_pairs);
+    scratch.work_idx.reserve(num_pairs);
+    scratch.work_i.reserve(num_pairs);
+    scratch.work_j.reserve(num_pairs);
+    scratch.work_rho.reserve(num_pairs);
+    m_mi_screen_marginals.reserve(num_qubits);
+}
+
+void QuantumEvolutionEngine::clear_mi_candidates() {
+    m_mi_candidates.clear();
+    m_mi_screen_marginals.clear();
+    m_mi_rescreen_cursor = 0;
+}
+
+int QuantumEvolutionEngine::get_mi_candidate_count() const {
+    return static_cast<int>(std::count(m_mi_candidates.begin(), m_mi_candidates.end(), true));
+}
+
+PackedFloat64Array QuantumEvolutionEngine::get_mi_edges(const PackedFloat64Array& mi_values, int num_qubits) const {
+    std::vector<double> list;
+    mi_edges_into(mi_values.ptr(), static_cast<int>(mi_values.size()), num_qubits, list);
+    PackedFloat64Array edges;
+    edges.resize(static_cast<int64_t>(list.size()));
+    std::copy(list.begin(), list.end(), edges.ptrw());
+    return edges;
+}
+
+void QuantumEvolutionEngine::mi_edges_into(const double* mi, int count, int num_qubits,
+                                           std::vector<double>& out) const {
+    out.clear();
+    const int num_pairs = std::min(count, num_qubits * (num_qubits - 1) / 2);
+    if (num_pairs <= 0) {
+        return;
+    }
+    const bool use_candidates = static_cast<int>(m_mi_candidates.size()) == num_qubits * (num_qubits - 1) / 2;
+    int idx = 0;
+    for (int i = 0; i < num_qubits && idx < num_pairs; i++) {
+        for (int j = i + 1; j < num_qubits && idx < num_pairs; j++, idx++) {
+            if ((!use_candidates || m_mi_candidates[idx]) && mi[idx] > 0.0) {
+                out.push_back(i);
+                out.push_back(j);
+                out.push_back(mi[idx]);
+            }
+        }
+    }
+}
+
+void QuantumEvolutionEngine::set_mi_rescreen_budget(int pairs_per_call) {
+    m_mi_rescreen_budget = std::max(0, pairs_per_call);
+}
+
+int QuantumEvolutionEngine::get_mi_rescreen_budget() const {
+    return m_mi_rescreen_budget;
+}
+
+void QuantumEvolutionEngine::set_mi_rescreen_drift(double drift) {
+    m_mi_rescreen_drift = std::max(0.0, drift);
+}
+
+double QuantumEvolutionEngine::get_mi_rescreen_drift() const {
+    return m_mi_rescreen_drift;
+}
+
+void QuantumEvolutionEngine::set_mi_force_linear(bool force_linear) {
+    m_mi_force_linear = force_linear;
+}
+
+bool QuantumEvolutionEngine::get_mi_force_linear() const {
+    return m_mi_force_linear;
+}
+
+void QuantumEvolutionEngine::set_mi_audit_interval(int calls) {
+    m_mi_audit_interval = std::max(0, calls);
+    m_mi_audit_countdown = m_mi_audit_interval;
+}
+
+int QuantumEvolutionEngine::get_mi_audit_interval() const {
+    return m_mi_audit_interval;
+}
+
+Dictionary QuantumEvolutionEngine::get_mi_screen_stats() const {
+    const MiScreenStats& st = m_mi_screen_stats;
+    Dictionary d;
+    d["calls"] = static_cast<int64_t>(st.calls);
+    d["full_scans"] = static_cast<int64_t>(st.full_scans);
+    d["linear_calls"] = static_cast<int64_t>(st.linear_calls);
+    d["eigen_calls"] = static_cast<int64_t>(st.eigen_calls);
+    d["pairs_screened"] = static_cast<int64_t>(st.pairs_screened);
+    d["pairs_drift_screened"] = static_cast<int64_t>(st.pairs_drift_screened);
+    d["candidates_kept"] = static_cast<int64_t>(st.candidates_kept);
+    d["pairs_skipped"] = static_cast<int64_t>(st.pairs_skipped);
+    d["pairs_reused"] = static_cast<int64_t>(st.pairs_reused);
+    d["audits"] = static_cast<int64_t>(st.audits);
+    d["audit_pairs"] = static_cast<int64_t>(st.audit_pairs);
+    d["audit_false_negatives"] = static_cast<int64_t>(st.audit_false_negatives);
+    d["false_negative_rate"] = st.audit_pairs > 0 ? static_cast<double>(st.audit_false_negatives) /
+                                                        static_cast<double>(st.audit_pairs)
+                                                  : 0.0;
+    return d;
+}
+
+void QuantumEvolutionEngine::reset_mi_screen_stats() {
+    m_mi_screen_stats = MiScreenStats();
+}
+
+void QuantumEvolutionEngine::set_mi_parallel_threshold(int min_pairs) {
+    m_mi_parallel_threshold = std::max(0, min_pairs);
+}
+
+int QuantumEvolutionEngine::get_mi_parallel_threshold() const {
+    return m_mi_parallel_threshold;
+}
+
+bool QuantumEvolutionEngine::use_parallel_mi(int pair_count) const {
+    return m_mi_parallel_threshold > 0 && pair_count >= m_mi_parallel_threshold &&
+           NativeThreadPool::shared().thread_count() > 1;
+}
+
+void QuantumEvolutionEngine::enumerate_pairs(int num_qubits, std::vector<int>& pair_i, std::vector<int>& pair_j) {
+    pair_i.clear();
+    pair_j.clear();
+    for (int i = 0; i < num_qubits; i++) {
+        for (int j = i + 1; j < num_qubits; j++) {
+            pair_i.push_back(i);
+            pair_j.push_back(j);
+        }
+    }
+}
+
+void QuantumEvolutionEngine::set_observable_reuse_tolerance(double tolerance) {
+    m_observable_reuse_tol = std::max(0.0, tolerance);
+    clear_observable_cache();
+}
+
+double QuantumEvolutionEngine::get_observable_reuse_tolerance() const {
+    return m_observable_reuse_tol;
+}
+
+void QuantumEvolutionEngine::clear_observable_cache() {
+    m_bloch_inputs.clear();
+    m_bloch_cache.clear();
+    m_mi_inputs.clear();
+    m_mi_cache.clear();
+    m_mi_cache_valid.clear();
+    m_last_reused_observables = 0;
+}
+
+int QuantumEvolutionEngine::get_last_reused_observable_count() const {
+    return m_last_reused_observables;
+}
+
+Dictionary QuantumEvolutionEngine::get_profile_stats() const {
+    Dictionary stats;
+    stats["evolve"] = m_profile_evolve.to_dict();
+    stats["reduce"] = m_profile_reduce.to_dict();
+    stats["bloch"] = m_profile_bloch.to_dict();
+    stats["mi"] = m_profile_mi.to_dict();
+    stats["entanglement"] = m_profile_entanglement.to_dict();
+    return stats;
+}
+
+void QuantumEvolutionEngine::reset_profile_stats() {
+    m_profile_evolve = ProfileStage();
+    m_profile_reduce = ProfileStage();
+    m_profile_bloch = ProfileStage();
+    m_profile_mi = ProfileStage();
+    m_profile_entanglement = ProfileStage();
+}
+
+Dictionary QuantumEvolutionEngine::get_operator_registry_stats() const {
+    const OperatorRegistry::Stats registry = OperatorRegistry::stats();
+    Dictionary stats;
+    stats["live"] = registry.live;
+    stats["hits"] = static_cast<int64_t>(registry.hits);
+    stats["misses"] = static_cast<int64_t>(registry.misses);
+    stats["bytes"] = registry.bytes;
+    return stats;
+}
+
+Dictionary QuantumEvolutionEngine::get_memory_stats() const {
+    Dictionary stats;
+    collect_memory_stats(stats, nullptr);
+    return stats;
+}
+
+int64_t QuantumEvolutionEngine::collect_memory_stats(
+    Dictionary& out, std::unordered_set<const SharedLindblad*>* shared_seen) const {
+    using namespace memory_bytes;
+
+    int64_t lindblad_operators = vector(m_lindblads);
+    int64_t lindblad_cache = 0;
+    for (const auto& L : m_lindblads) {
+        if (shared_seen != nullptr && !shared_seen->insert(L.get()).second) {
+            continue;
+        }
+        lindblad_operators += L->operator_bytes();
+        lindblad_cache += L->derived_bytes();
+    }
+
+    int64_t scratch = dense(m_drho_buffer) + dense(m_temp_buffer) + dense(m_krylov_basis) +
+                      dense(m_tracked_vec) + dense(m_tracked_work) + vector(m_stage_buffers) +
+                      dense(m_low_rank_factor) + dense(m_low_rank_work) + vector(m_observable_states.singles) +
+                      vector(m_observable_states.pairs) + vector(m_sectors) + vector(m_sector_of) +
+                      dense(m_strang_basis) + dense(m_strang_energies) + dense(m_strang_half) + dense(m_strang_full);
+    for (const RhoMatrix& stage : m_stage_buffers) {
+        scratch += dense(stage);
+    }
+    int64_t sector_operators = 0;
+    for (const SymmetrySector& sector : m_sectors) {
+        scratch += vector(sector.states) + dense(sector.rho) + dense(sector.drho) + dense(sector.temp);
+        sector_operators += sparse(sector.heff) + vector(sector.jumps);
+        for (const auto& L : sector.jumps) {
+            if (shared_seen != nullptr && !shared_seen->insert(L.get()).second) {
+                continue;
+            }
+            lindblad_operators += L->operator_bytes();
+            lindblad_cache += L->derived_bytes();
+        }
+    }
+
+    const int64_t categories[] = {
+        sparse(m_hamiltonian) + sparse(m_heff) + m_heff_form.bytes() + sector_operators,
+        vector(m_local_hamiltonians) + vector(m_local_lindblads) + vector(m_local_heff),
+        lindblad_operators,
+        lindblad_cache,
+        sparse(m_liouvillian) + sparse(m_liouvillian_f) + dense(m_propagator) + dense(m_propagator_work),
+        sparse(m_heff_f) + dense(m_rho_f) + dense(m_drho_f) + dense(m_temp_f),
+        scratch,
+        vector(m_mi_candidates) + vector(m_mi_screen_marginals) + vector(m_bloch_inputs) + vector(m_bloch_cache) +
+            vector(m_mi_inputs) + vector(m_mi_cache) + vector(m_mi_cache_valid),
+    };
+    const char* names[] = {"hamiltonian", "local_operators", "lindblad_operators", "lindblad_cache",
+                           "liouvillian", "single_precision", "scratch", "observable_cache"};
+    int64_t total = 0;
+    for (size_t i = 0; i < sizeof(categories) / sizeof(categories[0]); i++) {
+        out[names[i]] = categories[i];
+        total += categories[i];
+    }
+    out["total"] = total;
+    return total;
+}
+
+namespace {
 
-    // Pre-compute single-qubit reduced density matrices (2x2 fixed size)
-    std::vector<Eigen::Matrix<std::complex<double>, 2, 2>> single_rhos(num_qubits);
-    for (int q = 0; q < num_qubits; q++) {
-        single_rhos[q] = partial_trace_single_2x2(rho, q, num_qubits);
-    }
+constexpr uint32_t STATE_MAX_OPERATORS = 1 << 16;  // Sanity bound on stored operator counts
 
-    // Decide if we use linear approximation (cheap) or full eigendecomp
-    bool use_linear = (biome_purity > PURITY_HIGH_THRESHOLD);
+void write_local(EngineStateWriter& out, const lindblad::LocalOperator& local) {
+    out.write_i32(local.size);
+    out.write_i32(local.mask);
+    out.write_raw(local.offsets, sizeof(local.offsets));
+    out.write_raw(local.op.data(), sizeof(std::complex<double>) * 16);
+}
 
-    // If force_full_scan, clear and rebuild candidates
-    if (force_full_scan) {
-        m_mi_candidates.clear();
+bool read_local(EngineStateReader& in, int dim, lindblad::LocalOperator& local) {
+    if (!in.read_i32(local.size) || !in.read_i32(local.mask) || !in.read_raw(local.offsets, sizeof(local.offsets)) ||
+        !in.read_raw(local.op.data(), sizeof(std::complex<double>) * 16)) {
+        return false;
     }
+    bool valid = (local.size == 2 || local.size == 4) && local.mask >= 0 && local.mask < dim;
+    for (int k = 0; valid && k < 4; k++) {
+        valid = local.offsets[k] >= 0 && local.offsets[k] < dim;
+    }
+    if (!valid) {
+        in.fail();
+    }
+    return valid;
+}
 
-    int idx = 0;
-    for (int i = 0; i < num_qubits; i++) {
-        for (int j = i + 1; j < num_qubits; j++) {
-            if (force_full_scan) {
-                // SCREENING PHASE: Check if pair is a candidate
-                auto rho_ab = partial_trace_pair_4x4(rho, i, j, num_qubits);
-                double deviation = screen_product_deviation(rho_ab, single_rhos[i], single_rhos[j]);
-
-                if (deviation < MI_SCREEN_THRESHOLD) {
-                    // Not a candidate - MI is negligible
-                    ptr[idx] = 0.0;
-                    idx++;
-                    continue;
-                }
-
-                // Mark as candidate
-                m_mi_candidates.push_back(idx);
+}  // namespace
 
-                // Compute MI for this candidate
-                if (use_linear) {
-                    ptr[idx] = compute_mi_linear(rho_ab, single_rhos[i], single_rhos[j]);
-                } else {
-                    // Fallback to full eigendecomp
-                    double S_a = von_neumann_entropy(single_rhos[i]);
-                    double S_b = von_neumann_entropy(single_rhos[j]);
-                    double S_ab = von_neumann_entropy(rho_ab);
-                    ptr[idx] = std::max(0.0, S_a + S_b - S_ab);
-                }
-            } else {
-                // SUBSEQUENT FRAMES: Only compute for known candidates
-                bool is_candidate = std::find(m_mi_candidates.begin(), m_mi_candidates.end(), idx)
-                                    != m_mi_candidates.end();
+void QuantumEvolutionEngine::write_state(EngineStateWriter& out) const {
+    out.write_i32(m_dim);
+    out.write_u8(m_use_liouvillian ? 1 : 0);
+    out.write_u8(m_single_precision ? 1 : 0);
+    out.write_i32(m_resync_interval);
+    out.write_i32(m_integrator);
+    out.write_f64(m_rtol);
+    out.write_f64(m_atol);
+    out.write_i32(m_krylov_dim);
+    out.write_f64(m_observable_reuse_tol);
+
+    out.write_u8(m_has_hamiltonian ? 1 : 0);
+    if (m_has_hamiltonian) {
+        out.write_sparse(m_hamiltonian);
+    }
+    out.write_u32(static_cast<uint32_t>(m_lindblads.size()));
+    for (const auto& L : m_lindblads) {
+        out.write_sparse(L->L);
+        out.write_sparse(L->L_dag);
+        out.write_sparse(L->LdagL);
+    }
+    out.write_u32(static_cast<uint32_t>(m_local_hamiltonians.size()));
+    for (const LocalOperator& local : m_local_hamiltonians) {
+        write_local(out, local);
+    }
+    out.write_u32(static_cast<uint32_t>(m_local_lindblads.size()));
+    for (const LocalOperator& local : m_local_lindblads) {
+        write_local(out, local);
+    }
 
-                if (!is_candidate) {
-                    ptr[idx] = 0.0;
-                    idx++;
-                    continue;
-                }
+    out.write_u8(m_finalized ? 1 : 0);
+    if (m_finalized) {
+        out.write_sparse(m_heff);
+        out.write_u8(m_has_liouvillian ? 1 : 0);
+        if (m_has_liouvillian) {
+            out.write_sparse(m_liouvillian);
+        }
+    }
+}
 
-                // Compute MI for candidate
-                auto rho_ab = partial_trace_pair_4x4(rho, i, j, num_qubits);
+bool QuantumEvolutionEngine::read_state(EngineStateReader& in) {
+    int32_t dim = 0, resync = 0, integrator = 0, krylov_dim = 0;
+    uint8_t use_liouvillian = 0, single_precision = 0, has_hamiltonian = 0, finalized = 0, has_liouvillian = 0;
+    double rtol = 0.0, atol = 0.0, reuse_tol = 0.0;
+    in.read_i32(dim);
+    in.read_u8(use_liouvillian);
+    in.read_u8(single_precision);
+    in.read_i32(resync);
+    in.read_i32(integrator);
+    in.read_f64(rtol);
+    in.read_f64(atol);
+    in.read_i32(krylov_dim);
+    in.read_f64(reuse_tol);
+    if (!in.ok() || dim <= 0 || dim > (1 << 15) ||
+        (integrator != INTEGRATOR_EULER && integrator != INTEGRATOR_DOPRI5 && integrator != INTEGRATOR_KRYLOV &&
+         integrator != INTEGRATOR_STRANG && integrator != INTEGRATOR_MULTIRATE && integrator != INTEGRATOR_KRAUS)) {
+        in.fail();
+        return false;
+    }
 
-                if (use_linear) {
-                    ptr[idx] = compute_mi_linear(rho_ab, single_rhos[i], single_rhos[j]);
-                } else {
-                    double S_a = von_neumann_entropy(single_rhos[i]);
-                    double S_b = von_neumann_entropy(single_rhos[j]);
-                    double S_ab = von_neumann_entropy(rho_ab);
-                    ptr[idx] = std::max(0.0, S_a + S_b - S_ab);
-                }
+    SparseCM hamiltonian;
+    if (in.read_u8(has_hamiltonian) && has_hamiltonian) {
+        in.read_sparse(hamiltonian, dim, dim);
+    }
+    uint32_t count = 0;
+    std::vector<std::shared_ptr<const SharedLindblad>> lindblads;
+    if (in.read_u32(count) && count <= STATE_MAX_OPERATORS) {
+        lindblads.reserve(count);
+        for (uint32_t k = 0; k < count && in.ok(); k++) {
+            SparseCM L, L_dag, LdagL;
+            if (in.read_sparse(L, dim, dim) && in.read_sparse(L_dag, dim, dim) && in.read_sparse(LdagL, dim, dim)) {
+                lindblads.push_back(
+                    OperatorRegistry::intern_with_products(std::move(L), std::move(L_dag), std::move(LdagL)));
+            }
+        }
+    } else {
+        in.fail();
+    }
+    std::vector<LocalOperator> locals[2];
+    for (auto& list : locals) {
+        if (!in.read_u32(count) || count > STATE_MAX_OPERATORS || !in.has(static_cast<int64_t>(count) * 280)) {
+            in.fail();  // 280 bytes per local operator (see write_local)
+            break;
+        }
+        list.resize(count);
+        for (uint32_t k = 0; k < count; k++) {
+            if (!read_local(in, dim, list[k])) {
+                break;
             }
-            idx++;
         }
     }
+    SparseCM heff, liouvillian;
+    if (in.read_u8(finalized) && finalized && in.read_sparse(heff, dim, dim) && in.read_u8(has_liouvillian) &&
+        has_liouvillian) {
+        in.read_sparse(liouvillian, dim * dim, dim * dim);
+    }
 
-    // Debug: Report candidate count on full scan (disabled - too spammy for main game)
-    // if (force_full_scan) {
-    //     UtilityFunctions::print(String("[TEST] [MI_ADAPTIVE] q=") + String::num_int64(num_qubits) +
-    //         String(" candidates=") + String::num_int64((int64_t)m_mi_candidates.size()) +
-    //         String("/") + String::num_int64(num_pairs) +
-    //         String(" purity=") + String::num(biome_purity, 3) +
-    //         String(" linear=") + (use_linear ? String("Y") : String("N")));
-    // }
+    clear_operators();
+    if (!in.ok()) {
+        return false;
+    }
 
-    return mi_values;
+    m_dim = dim;
+    set_use_liouvillian(use_liouvillian != 0);
+    set_precision_resync_interval(resync);
+    set_single_precision(single_precision != 0);
+    set_integrator(integrator);
+    set_integrator_tolerance(rtol, atol);
+    set_krylov_dimension(krylov_dim);
+    set_observable_reuse_tolerance(reuse_tol);
+
+    m_hamiltonian = std::move(hamiltonian);
+    m_has_hamiltonian = has_hamiltonian != 0;
+    m_lindblads = std::move(lindblads);
+    m_local_hamiltonians = std::move(locals[0]);
+    m_local_lindblads = std::move(locals[1]);
+    if (finalized) {
+        m_heff = std::move(heff);
+        m_has_heff = m_heff.nonZeros() > 0;
+        build_heff_form();
+        if (has_liouvillian) {
+            m_liouvillian = std::move(liouvillian);
+            m_has_liouvillian = true;
+        }
+        finalize_derived();
+    }
+    return true;
 }
 
 Dictionary QuantumEvolutionEngine::evolve_with_mi(
@@ -738,7 +4406,7 @@ Dictionary QuantumEvolutionEngine::evolve_with_mi(
     result["mi"] = mi_values;
 
     // Compute purity and trace on the evolved state
-    Eigen::MatrixXcd rho = unpack_dense(evolved_rho);
+    Eigen::Map<const RhoMatrix> rho = map_packed(evolved_rho);
     result["purity"] = compute_purity(rho);
     std::complex<double> tr = compute_trace(rho);
     result["trace_re"] = tr.real();
@@ -748,19 +4416,134 @@ Dictionary QuantumEvolutionEngine::evolve_with_mi(
     return result;
 }
 
-double QuantumEvolutionEngine::compute_purity(const Eigen::MatrixXcd& rho) const {
-    // Tr(rho^2) = sum_ij |rho_ij|^2 for Hermitian rho
+int QuantumEvolutionEngine::observables_size(int num_qubits, int mask) {
+    // Sections in fixed order, each present only if selected:
+    // [bloch n·8][purity 1][trace_re, trace_im 2][mi n(n-1)/2]
+    // [concurrence n(n-1)/2][negativity n(n-1)/2]
+    const bool want_bloch = (mask & OBSERVABLE_BLOCH) && num_qubits > 0;
+    const int pair_sections = (num_qubits >= 2) ? ((mask & OBSERVABLE_MI) ? 1 : 0) +
+                                                      ((mask & OBSERVABLE_CONCURRENCE) ? 1 : 0) +
+                                                      ((mask & OBSERVABLE_NEGATIVITY) ? 1 : 0)
+                                                : 0;
+    return (want_bloch ? num_qubits * 8 : 0) + ((mask & OBSERVABLE_PURITY) ? 1 : 0) +
+           ((mask & OBSERVABLE_TRACE) ? 2 : 0) + pair_sections * (num_qubits * (num_qubits - 1) / 2);
+}
+
+PackedFloat64Array QuantumEvolutionEngine::compute_observables(
+    RhoConstRef rho, int num_qubits, int mask) {
+    PackedFloat64Array out;
+    out.resize(observables_size(num_qubits, mask));
+    NATIVE_ALLOC_PACKED(out);
+    if (out.size() > 0) {
+        compute_observables_into(rho, num_qubits, mask, out.ptrw());
+    }
+    return out;
+}
+
+void QuantumEvolutionEngine::compute_observables_into(
+    RhoConstRef rho, int num_qubits, int mask, double* ptr) {
+    const bool want_bloch = (mask & OBSERVABLE_BLOCH) && num_qubits > 0;
+    const bool want_purity = (mask & OBSERVABLE_PURITY) != 0;
+    const bool want_trace = (mask & OBSERVABLE_TRACE) != 0;
+    const bool want_pairs = wants_pair_reductions(num_qubits, mask);
+    if (!want_bloch && !want_purity && !want_trace && !want_pairs) {
+        return;
+    }
+
+    // One row-by-row sweep: reductions (pairs only for MI and the
+    // entanglement measures), purity (also needed by MI to pick the entropy
+    // mode) and trace. The reductions land in member scratch, so
+    // steady-state calls don't allocate.
+    ReducedStates& states = m_observable_states;
     double purity = 0.0;
-    for (int i = 0; i < rho.rows(); i++) {
-        for (int j = 0; j < rho.cols(); j++) {
-            const auto& c = rho(i, j);
-            purity += std::norm(c);
+    std::complex<double> trace(0.0, 0.0);
+    {
+        ScopedProfile profile(m_profile_reduce);
+        NATIVE_TRACE_ZONE("reduce");
+        compute_reduced_states(rho, num_qubits, want_pairs, states,
+                               (want_purity || (mask & OBSERVABLE_MI)) ? &purity : nullptr,
+                               want_trace ? &trace : nullptr);
+    }
+    observables_from_states(states, num_qubits, mask, purity, trace, ptr);
+}
+
+void QuantumEvolutionEngine::observables_from_states(const ReducedStates& states, int num_qubits, int mask,
+                                                     double purity, std::complex<double> trace, double* ptr) {
+    const bool want_bloch = (mask & OBSERVABLE_BLOCH) && num_qubits > 0;
+    const bool want_purity = (mask & OBSERVABLE_PURITY) != 0;
+    const bool want_trace = (mask & OBSERVABLE_TRACE) != 0;
+    const bool want_mi = (mask & OBSERVABLE_MI) && num_qubits >= 2;
+    m_last_reused_observables = 0;
+
+    if (want_bloch) {
+        ScopedProfile profile(m_profile_bloch);
+        NATIVE_TRACE_ZONE("bloch");
+        bloch_from_states(states, num_qubits, ptr);
+        ptr += num_qubits * 8;
+    }
+    if (want_purity) {
+        *ptr++ = purity;
+    }
+    if (want_trace) {
+        *ptr++ = trace.real();
+        *ptr++ = trace.imag();
+    }
+    if (want_mi) {
+        ScopedProfile profile(m_profile_mi);
+        NATIVE_TRACE_ZONE("mi");
+        mi_adaptive_from_states(states, num_qubits, purity, false, ptr);
+        ptr += num_qubits * (num_qubits - 1) / 2;
+    }
+    if (num_qubits >= 2 && (mask & (OBSERVABLE_CONCURRENCE | OBSERVABLE_NEGATIVITY))) {
+        ScopedProfile profile(m_profile_entanglement);
+        NATIVE_TRACE_ZONE("entanglement");
+        entanglement_from_states(states, num_qubits, mask, ptr);
+    }
+}
+
+void QuantumEvolutionEngine::entanglement_from_states(const ReducedStates& states, int num_qubits, int mask,
+                                                      double* ptr) {
+    // Qubit i < j is the bit pair (n-1-j, n-1-i), as in the MI path; both
+    // measures are symmetric in the two qubits, so the local digit order
+    // doesn't matter
+    const int num_pairs = num_qubits * (num_qubits - 1) / 2;
+    const bool want_concurrence = (mask & OBSERVABLE_CONCURRENCE) != 0;
+    double* concurrence = ptr;
+    double* negativity = ptr + (want_concurrence ? num_pairs : 0);
+    int idx = 0;
+    for (int i = 0; i < num_qubits; i++) {
+        for (int j = i + 1; j < num_qubits; j++, idx++) {
+            const auto& rho_ab = states.pairs[states.pair_index(num_qubits - 1 - j, num_qubits - 1 - i)];
+            if (want_concurrence) {
+                concurrence[idx] = lindblad::concurrence_4x4(rho_ab);
+            }
+            if (mask & OBSERVABLE_NEGATIVITY) {
+                negativity[idx] = lindblad::log_negativity_4x4(rho_ab);
+            }
         }
     }
+}
+
+PackedFloat64Array QuantumEvolutionEngine::compute_observables_from_packed(
+    const PackedFloat64Array& rho_data, int num_qubits, int mask) {
+    if (!is_packed_valid(rho_data)) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: compute_observables_from_packed size mismatch");
+        return PackedFloat64Array();
+    }
+    return compute_observables(map_packed(rho_data), num_qubits, mask);
+}
+
+double QuantumEvolutionEngine::compute_purity(RhoConstRef rho) const {
+    // Tr(rho^2) = sum_ij |rho_ij|^2 for Hermitian rho (rows are contiguous)
+    const SimdKernels& simd = simd_kernels();
+    double purity = 0.0;
+    for (int i = 0; i < rho.rows(); i++) {
+        purity += simd.norm_sq_c64(reinterpret_cast<const double*>(rho.row(i).data()), rho.cols());
+    }
     return purity;
 }
 
-std::complex<double> QuantumEvolutionEngine::compute_trace(const Eigen::MatrixXcd& rho) const {
+std::complex<double> QuantumEvolutionEngine::compute_trace(RhoConstRef rho) const {
     std::complex<double> tr(0.0, 0.0);
     int n = std::min(rho.rows(), rho.cols());
     for (int i = 0; i < n; i++) {
@@ -770,29 +4553,52 @@ std::complex<double> QuantumEvolutionEngine::compute_trace(const Eigen::MatrixXc
 }
 
 double QuantumEvolutionEngine::compute_purity_from_packed(const PackedFloat64Array& rho_data) const {
-    Eigen::MatrixXcd rho = unpack_dense(rho_data);
+    Eigen::Map<const RhoMatrix> rho = map_packed(rho_data);
     return compute_purity(rho);
 }
 
 PackedFloat64Array QuantumEvolutionEngine::compute_bloch_metrics_from_packed(
     const PackedFloat64Array& rho_data, int num_qubits) const {
-    Eigen::MatrixXcd rho = unpack_dense(rho_data);
+    Eigen::Map<const RhoMatrix> rho = map_packed(rho_data);
     return compute_bloch_metrics(rho, num_qubits);
 }
 
 PackedFloat64Array QuantumEvolutionEngine::compute_bloch_metrics(
-    const Eigen::MatrixXcd& rho, int num_qubits) const {
+    RhoConstRef rho, int num_qubits) const {
     // Returns packed [p0,p1,x,y,z,r,theta,phi] per qubit
     PackedFloat64Array out;
     if (num_qubits <= 0) {
         return out;
     }
     out.resize(num_qubits * 8);
-    double* ptr = out.ptrw();
+    NATIVE_ALLOC_PACKED(out);
+
+    // Single-qubit reductions only (qubit q = basis bit q), one sweep over ρ
+    ReducedStates states;
+    compute_reduced_states(rho, num_qubits, false, states);
+    m_last_reused_observables = 0;
+    bloch_from_states(states, num_qubits, out.ptrw());
+    return out;
+}
+
+void QuantumEvolutionEngine::bloch_from_states(
+    const ReducedStates& states, int num_qubits, double* ptr) const {
+    // Change tracking: reuse a qubit's packet while its 2×2 input is still
+    // within tolerance of the snapshot it was computed from
+    const bool tracking = m_observable_reuse_tol > 0.0;
+    const bool cache_ok = tracking && static_cast<int>(m_bloch_inputs.size()) == num_qubits;
+    if (tracking && !cache_ok) {
+        m_bloch_inputs.assign(num_qubits, Eigen::Matrix<std::complex<double>, 2, 2>::Zero());
+        m_bloch_cache.assign(num_qubits * 8, 0.0);
+    }
 
     for (int q = 0; q < num_qubits; q++) {
-        Eigen::MatrixXcd reduced = partial_trace_single(rho, q, num_qubits);
-        // reduced is 2x2
+        const Eigen::Matrix<std::complex<double>, 2, 2>& reduced = states.singles[q];
+        if (cache_ok && within_tolerance<2>(reduced, m_bloch_inputs[q], m_observable_reuse_tol)) {
+            std::memcpy(ptr + q * 8, m_bloch_cache.data() + q * 8, 8 * sizeof(double));
+            m_last_reused_observables++;
+            continue;
+        }
         std::complex<double> rho00 = reduced(0, 0);
         std::complex<double> rho11 = reduced(1, 1);
         std::complex<double> rho01 = reduced(0, 1);
@@ -823,12 +4629,34 @@ PackedFloat64Array QuantumEvolutionEngine::compute_bloch_metrics(
         ptr[base + 5] = r;
         ptr[base + 6] = theta;
         ptr[base + 7] = phi;
+
+        if (tracking) {
+            m_bloch_inputs[q] = reduced;
+            std::memcpy(m_bloch_cache.data() + base, ptr + base, 8 * sizeof(double));
+        }
     }
 
-    return out;
 }
 
 Dictionary QuantumEvolutionEngine::compute_coupling_payload(const Dictionary& metadata) const {
+    // Same operators + same metadata → same payload; the O(E²) scan only
+    // reruns after an operator mutation or a metadata change
+    const uint32_t metadata_hash = metadata.hash();
+    if (m_coupling_cache_valid && m_coupling_cache_version == m_operator_version &&
+        m_coupling_cache_hash == metadata_hash && m_coupling_cache_metadata == metadata) {
+        return m_coupling_cache;
+    }
+
+    Dictionary payload = build_coupling_payload(metadata);
+    m_coupling_cache = payload;
+    m_coupling_cache_metadata = metadata.duplicate(true);
+    m_coupling_cache_hash = metadata_hash;
+    m_coupling_cache_version = m_operator_version;
+    m_coupling_cache_valid = true;
+    return payload;
+}
+
+Dictionary QuantumEvolutionEngine::build_coupling_payload(const Dictionary& metadata) const {
     Dictionary payload;
     Dictionary hamiltonian_map;
     Dictionary lindblad_map;
@@ -838,14 +4666,13 @@ Dictionary QuantumEvolutionEngine::compute_coupling_payload(const Dictionary& me
         return payload;
     }
 
-    Dictionary emoji_to_qubit = metadata.get("emoji_to_qubit", Dictionary());
-    Dictionary emoji_to_pole = metadata.get("emoji_to_pole", Dictionary());
-    Array emoji_list = metadata.get("emoji_list", Array());
     int num_qubits = metadata.get("num_qubits", 0);
-
-    if (num_qubits <= 0 || emoji_list.is_empty()) {
+    EmojiLayout layout;
+    const bool has_layout = resolve_emoji_layout(metadata, layout);
+    if (num_qubits <= 0 || (!has_layout && Array(metadata.get("emoji_list", Array())).is_empty())) {
         return payload;
     }
+    const bool ids_only = metadata.get("ids_only", false);
 
     const int dim = m_dim;
     const double eps = 1e-12;
@@ -866,33 +4693,39 @@ Dictionary QuantumEvolutionEngine::compute_coupling_payload(const Dictionary& me
         }
     };
 
-    for (int idx_a = 0; idx_a < emoji_list.size(); idx_a++) {
-        Variant emoji_a_var = emoji_list[idx_a];
-        if (emoji_a_var.get_type() != Variant::STRING) {
-            continue;
-        }
-        String emoji_a = emoji_a_var;
-        int q_a = emoji_to_qubit.get(emoji_a, -1);
-        int p_a = emoji_to_pole.get(emoji_a, -1);
-        if (q_a < 0 || p_a < 0) {
+    // Resolved emojis only; names are looked up once, and not at all with ids_only
+    std::vector<int> ids;
+    std::vector<String> names;
+    std::vector<int> qubits;
+    std::vector<int> poles;
+    for (size_t idx = 0; idx < layout.ids.size(); idx++) {
+        if (layout.ids[idx] < 0 || layout.qubits[idx] < 0 || layout.poles[idx] < 0) {
             continue;
         }
+        ids.push_back(layout.ids[idx]);
+        names.push_back(ids_only ? String() : EmojiRegistry::get_emoji(layout.ids[idx]));
+        qubits.push_back(layout.qubits[idx]);
+        poles.push_back(layout.poles[idx]);
+    }
+    const int num_emojis = static_cast<int>(ids.size());
+
+    // Integer edge lists (registry ids), one entry per nonzero coupling
+    PackedInt32Array h_source, h_target, l_source, l_target, sink_ids;
+    PackedFloat64Array h_strength_out, l_rate_out, sink_values;
+
+    for (int idx_a = 0; idx_a < num_emojis; idx_a++) {
+        const String& emoji_a = names[idx_a];
+        const int q_a = qubits[idx_a];
+        const int p_a = poles[idx_a];
 
         Dictionary h_targets;
         Dictionary l_targets;
         double sink = 0.0;
 
-        for (int idx_b = 0; idx_b < emoji_list.size(); idx_b++) {
-            Variant emoji_b_var = emoji_list[idx_b];
-            if (emoji_b_var.get_type() != Variant::STRING) {
-                continue;
-            }
-            String emoji_b = emoji_b_var;
-            int q_b = emoji_to_qubit.get(emoji_b, -1);
-            int p_b = emoji_to_pole.get(emoji_b, -1);
-            if (q_b < 0 || p_b < 0) {
-                continue;
-            }
+        for (int idx_b = 0; idx_b < num_emojis; idx_b++) {
+            const String& emoji_b = names[idx_b];
+            const int q_b = qubits[idx_b];
+            const int p_b = poles[idx_b];
 
             if (q_a == q_b && p_a == p_b) {
                 continue;
@@ -909,12 +4742,18 @@ Dictionary QuantumEvolutionEngine::compute_coupling_payload(const Dictionary& me
                 std::complex<double> h_val = m_hamiltonian.coeff(i, j);
                 double h_strength = std::abs(h_val);
                 if (h_strength > eps) {
-                    h_targets[emoji_b] = h_strength;
+                    h_source.push_back(ids[idx_a]);
+                    h_target.push_back(ids[idx_b]);
+                    h_strength_out.push_back(h_strength);
+                    if (!ids_only) {
+                        h_targets[emoji_b] = h_strength;
+                    }
                 }
             }
 
             double rate = 0.0;
-            for (const auto &L : m_lindblads) {
+            for (const auto &entry : m_lindblads) {
+                const SparseCM &L = entry->L;
                 if (L.rows() <= j || L.cols() <= i) {
                     continue;
                 }
@@ -924,7 +4763,12 @@ Dictionary QuantumEvolutionEngine::compute_coupling_payload(const Dictionary& me
                 }
             }
             if (rate > eps) {
-                l_targets[emoji_b] = rate;
+                l_source.push_back(ids[idx_a]);
+                l_target.push_back(ids[idx_b]);
+                l_rate_out.push_back(rate);
+                if (!ids_only) {
+                    l_targets[emoji_b] = rate;
+                }
                 sink += rate;
             }
         }
@@ -936,16 +4780,156 @@ Dictionary QuantumEvolutionEngine::compute_coupling_payload(const Dictionary& me
             lindblad_map[emoji_a] = l_targets;
         }
         if (sink > eps) {
-            sink_fluxes[emoji_a] = sink;
+            sink_ids.push_back(ids[idx_a]);
+            sink_values.push_back(sink);
+            if (!ids_only) {
+                sink_fluxes[emoji_a] = sink;
+            }
         }
     }
 
     payload["hamiltonian"] = hamiltonian_map;
     payload["lindblad"] = lindblad_map;
     payload["sink_fluxes"] = sink_fluxes;
+    payload["hamiltonian_source_ids"] = h_source;
+    payload["hamiltonian_target_ids"] = h_target;
+    payload["hamiltonian_strengths"] = h_strength_out;
+    payload["lindblad_source_ids"] = l_source;
+    payload["lindblad_target_ids"] = l_target;
+    payload["lindblad_rates"] = l_rate_out;
+    payload["sink_ids"] = sink_ids;
+    payload["sink_values"] = sink_values;
     return payload;
 }
 
+void QuantumEvolutionEngine::set_flux_tracking(const Dictionary& metadata) {
+    m_flux_tracking = false;
+    m_flux_emoji_ids.clear();
+    m_flux_bits.clear();
+    m_flux_poles.clear();
+    m_channel_flux.clear();
+    if (metadata.is_empty()) {
+        return;
+    }
+
+    const int num_qubits = metadata.get("num_qubits", 0);
+    EmojiLayout layout;
+    if (num_qubits <= 0 || (1 << num_qubits) > m_dim || !resolve_emoji_layout(metadata, layout)) {
+        UtilityFunctions::push_warning("QuantumEvolutionEngine: set_flux_tracking needs num_qubits and an emoji layout");
+        return;
+    }
+    // Same qubit → basis bit convention as build_coupling_payload
+    for (size_t idx = 0; idx < layout.ids.size(); idx++) {
+        const int q = layout.qubits[idx];
+        if (layout.ids[idx] < 0 || q < 0 || q >= num_qubits || layout.poles[idx] < 0) {
+            continue;
+        }
+        m_flux_emoji_ids.push_back(layout.ids[idx]);
+        m_flux_bits.push_back(num_qubits - 1 - q);
+        m_flux_poles.push_back(layout.poles[idx] != 0 ? 1 : 0);
+    }
+    m_flux_tracking = true;
+}
+
+bool QuantumEvolutionEngine::is_flux_tracking() const {
+    return m_flux_tracking;
+}
+
+PackedInt32Array QuantumEvolutionEngine::get_flux_emoji_ids() const {
+    PackedInt32Array ids;
+    for (int id : m_flux_emoji_ids) {
+        ids.push_back(id);
+    }
+    return ids;
+}
+
+PackedFloat64Array QuantumEvolutionEngine::take_channel_flux() {
+    PackedFloat64Array out;
+    if (!m_flux_tracking) {
+        return out;
+    }
+    const size_t size = static_cast<size_t>(flux_channel_count()) * m_flux_emoji_ids.size();
+    m_channel_flux.resize(size, 0.0);
+    out.resize(static_cast<int64_t>(size));
+    NATIVE_ALLOC_PACKED(out);
+    std::copy(m_channel_flux.begin(), m_channel_flux.end(), out.ptrw());
+    std::fill(m_channel_flux.begin(), m_channel_flux.end(), 0.0);
+    return out;
+}
+
+void QuantumEvolutionEngine::accumulate_channel_flux(RhoConstRef rho, double interval) {
+    const int channels = flux_channel_count();
+    const int emojis = static_cast<int>(m_flux_emoji_ids.size());
+    const size_t size = static_cast<size_t>(channels) * emojis;
+    if (m_channel_flux.size() != size) {
+        m_channel_flux.assign(size, 0.0);  // Channels changed: restart the tally
+    }
+    if (emojis == 0 || !(interval > 0.0)) {
+        return;
+    }
+    const int dim = m_dim;
+    m_flux_diag.resize(dim);
+    const int num_global = static_cast<int>(m_lindblads.size());
+    for (int k = 0; k < channels; k++) {
+        // diag D_k(ρ)(i) = (L ρ L†)(i, i) - Re (L†L ρ)(i, i): only the row-i
+        // nonzeros of L and L†L, O(nnz) per channel
+        std::fill(m_flux_diag.begin(), m_flux_diag.end(), 0.0);
+        if (k < num_global) {
+            const SharedLindblad& entry = *m_lindblads[k];
+            for (int i = 0; i < dim; i++) {
+                double gain = 0.0;
+                for (SparseCM::InnerIterator a(entry.L, i); a; ++a) {
+                    std::complex<double> acc(0.0, 0.0);
+                    for (SparseCM::InnerIterator b(entry.L, i); b; ++b) {
+                        acc += rho(a.col(), b.col()) * std::conj(b.value());
+                    }
+                    gain += (a.value() * acc).real();
+                }
+                double loss = 0.0;
+                for (SparseCM::InnerIterator c(entry.LdagL, i); c; ++c) {
+                    loss += (c.value() * rho(c.col(), i)).real();
+                }
+                m_flux_diag[i] = gain - loss;
+            }
+        } else {
+            const LocalOperator& L_loc = m_local_lindblads[k - num_global];
+            const Eigen::Matrix4cd LdagL = L_loc.op.adjoint() * L_loc.op;
+            for (int base = 0; base < dim; base++) {
+                if (base & L_loc.mask) {
+                    continue;
+                }
+                for (int a = 0; a < L_loc.size; a++) {
+                    const int i = base + L_loc.offsets[a];
+                    double gain = 0.0;
+                    double loss = 0.0;
+                    for (int b = 0; b < L_loc.size; b++) {
+                        std::complex<double> acc(0.0, 0.0);
+                        for (int d = 0; d < L_loc.size; d++) {
+                            acc += rho(base + L_loc.offsets[b], base + L_loc.offsets[d]) * std::conj(L_loc.op(a, d));
+                        }
+                        gain += (L_loc.op(a, b) * acc).real();
+                        loss += (LdagL(a, b) * rho(base + L_loc.offsets[b], i)).real();
+                    }
+                    m_flux_diag[i] = gain - loss;
+                }
+            }
+        }
+
+        double* row = m_channel_flux.data() + static_cast<size_t>(k) * emojis;
+        for (int e = 0; e < emojis; e++) {
+            const int bit = m_flux_bits[e];
+            const int pole = m_flux_poles[e];
+            double sum = 0.0;
+            for (int i = 0; i < dim; i++) {
+                if (((i >> bit) & 1) == pole) {
+                    sum += m_flux_diag[i];
+                }
+            }
+            row[e] += interval * sum;
+        }
+    }
+}
+
 // ============================================================================
 // EIGENSTATE ANALYSIS (CPU-only, Eigen SelfAdjointEigenSolver)
 // ============================================================================
@@ -959,7 +4943,7 @@ Dictionary QuantumEvolutionEngine::compute_eigenstates(const PackedFloat64Array&
     }
 
     // Unpack density matrix
-    Eigen::MatrixXcd rho = unpack_dense(rho_data);
+    Eigen::Map<const RhoMatrix> rho = map_packed(rho_data);
 
     // Density matrices are Hermitian, use SelfAdjointEigenSolver for efficiency
     Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> solver(rho);
@@ -1010,7 +4994,7 @@ PackedFloat64Array QuantumEvolutionEngine::compute_dominant_eigenvector(const Pa
         return result;
     }
 
-    Eigen::MatrixXcd rho = unpack_dense(rho_data);
+    Eigen::Map<const RhoMatrix> rho = map_packed(rho_data);
     Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> solver(rho);
 
     if (solver.info() != Eigen::Success) {
@@ -1032,6 +5016,208 @@ PackedFloat64Array QuantumEvolutionEngine::compute_dominant_eigenvector(const Pa
     return result;
 }
 
+PackedFloat64Array QuantumEvolutionEngine::track_dominant_eigenvector(const PackedFloat64Array& rho_data) {
+    PackedFloat64Array result;
+    if (m_dim <= 0 || !is_packed_valid(rho_data)) {
+        return result;
+    }
+    Eigen::Map<const RhoMatrix> rho = map_packed(rho_data);
+
+    bool converged = false;
+    if (m_has_tracked && m_tracked_vec.size() == m_dim) {
+        // Warm-started power iteration: v ← ρv/‖ρv‖ until the residual is small
+        Eigen::VectorXcd& v = m_tracked_vec;
+        Eigen::VectorXcd& w = m_tracked_work;
+        w.resize(m_dim);
+        double prev_residual = -1.0;
+        int it = 0;
+        for (; it < m_eigen_max_iterations; it++) {
+            w.noalias() = rho * v;
+            const double lambda = v.dot(w).real();  // Rayleigh quotient (‖v‖ = 1)
+            const double residual = (w - lambda * v).norm();
+            if (lambda > 0.0 && residual <= m_eigen_tolerance * lambda) {
+                m_tracked_value = lambda;
+                converged = true;
+                break;
+            }
+            // The residual contracts by ≈ λ₂/λ₁ per step: near 1 means the
+            // gap has collapsed and power iteration won't get there
+            if (prev_residual > 0.0 && it >= 2 && residual > EIGEN_GAP_COLLAPSE_RATIO * prev_residual) {
+                break;
+            }
+            prev_residual = residual;
+            const double norm = w.norm();
+            if (norm <= 1e-300) {
+                break;
+            }
+            v = w / norm;
+        }
+        m_last_eigen_iterations = it + (converged ? 1 : 0);
+    }
+
+    if (!converged) {
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> solver(rho);
+        if (solver.info() != Eigen::Success) {
+            m_has_tracked = false;
+            return result;
+        }
+        Eigen::VectorXcd fresh = solver.eigenvectors().col(m_dim - 1);
+        // Keep the phase continuous with the previous frame
+        if (m_has_tracked && m_tracked_vec.size() == m_dim) {
+            const std::complex<double> overlap = fresh.dot(m_tracked_vec);
+            if (std::abs(overlap) > 1e-12) {
+                fresh *= overlap / std::abs(overlap);
+            }
+        }
+        m_tracked_vec = fresh;
+        m_tracked_value = solver.eigenvalues()(m_dim - 1);
+        m_has_tracked = true;
+        m_last_eigen_iterations = -1;
+    }
+
+    // Pack as [re0, im0, re1, im1, ...]
+    result.resize(m_dim * 2);
+    double* ptr = result.ptrw();
+    for (int i = 0; i < m_dim; i++) {
+        ptr[i * 2] = m_tracked_vec(i).real();
+        ptr[i * 2 + 1] = m_tracked_vec(i).imag();
+    }
+    return result;
+}
+
+double QuantumEvolutionEngine::get_tracked_dominant_eigenvalue() const {
+    return m_has_tracked ? m_tracked_value : 0.0;
+}
+
+int QuantumEvolutionEngine::get_last_eigen_iterations() const {
+    return m_last_eigen_iterations;
+}
+
+void QuantumEvolutionEngine::set_eigen_tracking_tolerance(double tolerance) {
+    m_eigen_tolerance = std::max(1e-15, tolerance);
+}
+
+double QuantumEvolutionEngine::get_eigen_tracking_tolerance() const {
+    return m_eigen_tolerance;
+}
+
+void QuantumEvolutionEngine::set_eigen_tracking_max_iterations(int iterations) {
+    m_eigen_max_iterations = std::max(0, iterations);
+}
+
+int QuantumEvolutionEngine::get_eigen_tracking_max_iterations() const {
+    return m_eigen_max_iterations;
+}
+
+void QuantumEvolutionEngine::reset_eigen_tracking() {
+    m_has_tracked = false;
+    m_tracked_vec.resize(0);
+    m_tracked_value = 0.0;
+    m_last_eigen_iterations = 0;
+    m_subspace.resize(0, 0);
+    m_subspace_values.resize(0);
+}
+
+Dictionary QuantumEvolutionEngine::track_eigen_subspace(const PackedFloat64Array& rho_data, int k,
+                                                        double tolerance) {
+    Dictionary result;
+    if (m_dim <= 0 || k <= 0 || !is_packed_valid(rho_data)) {
+        return result;
+    }
+    k = std::min(k, m_dim);
+    const int block = std::min(m_dim, k + EIGEN_SUBSPACE_GUARD);
+    tolerance = std::max(1e-15, tolerance);
+    Eigen::Map<const RhoMatrix> rho = map_packed(rho_data);
+
+    // Last frame's block, for warm start and phase alignment
+    const bool warm = m_subspace.rows() == m_dim && m_subspace.cols() == block;
+    const Eigen::MatrixXcd previous = warm ? m_subspace : Eigen::MatrixXcd();
+
+    bool converged = false;
+    double residual = 0.0;
+    int iterations = -1;
+    if (warm && block < m_dim) {
+        Eigen::MatrixXcd& V = m_subspace;
+        Eigen::MatrixXcd& Z = m_subspace_work;
+        double prev_residual = -1.0;
+        int it = 0;
+        for (; it < m_eigen_max_iterations; it++) {
+            Z.noalias() = rho * V;
+            // Rayleigh–Ritz on span(V) (orthonormal): Ritz pairs, descending
+            const Eigen::MatrixXcd T = V.adjoint() * Z;
+            Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> ritz(T);
+            if (ritz.info() != Eigen::Success) {
+                break;
+            }
+            const Eigen::MatrixXcd Y = ritz.eigenvectors().rowwise().reverse();
+            m_subspace_values = ritz.eigenvalues().reverse();
+            V = V * Y;
+            Z = Z * Y;
+            residual = 0.0;
+            for (int i = 0; i < k; i++) {
+                residual = std::max(residual, (Z.col(i) - m_subspace_values(i) * V.col(i)).norm());
+            }
+            const double scale = m_subspace_values(0);
+            if (scale > 0.0 && residual <= tolerance * scale) {
+                converged = true;
+                break;
+            }
+            // Residuals contract by ≈ λ_{block+1}/λ_k per step (see track_dominant_eigenvector)
+            if (prev_residual > 0.0 && it >= 2 && residual > EIGEN_GAP_COLLAPSE_RATIO * prev_residual) {
+                break;
+            }
+            prev_residual = residual;
+            // Subspace step: V ← orth(ρV)
+            Eigen::HouseholderQR<Eigen::MatrixXcd> qr(Z);
+            V = qr.householderQ() * Eigen::MatrixXcd::Identity(m_dim, block);
+        }
+        iterations = it + (converged ? 1 : 0);
+    }
+
+    if (!converged) {
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> solver(rho);
+        if (solver.info() != Eigen::Success) {
+            m_subspace.resize(0, 0);
+            return result;
+        }
+        m_subspace = solver.eigenvectors().rightCols(block).rowwise().reverse();
+        m_subspace_values = solver.eigenvalues().tail(block).reverse();
+        residual = 0.0;
+        iterations = -1;
+    }
+
+    // Keep each vector's phase continuous with the previous frame
+    if (warm) {
+        for (int i = 0; i < block; i++) {
+            const std::complex<double> overlap = m_subspace.col(i).dot(previous.col(i));
+            if (std::abs(overlap) > 1e-12) {
+                m_subspace.col(i) *= overlap / std::abs(overlap);
+            }
+        }
+    }
+
+    PackedFloat64Array values;
+    values.resize(k);
+    PackedFloat64Array vectors;
+    vectors.resize(static_cast<int64_t>(k) * m_dim * 2);
+    double* value_ptr = values.ptrw();
+    double* vector_ptr = vectors.ptrw();
+    for (int i = 0; i < k; i++) {
+        value_ptr[i] = m_subspace_values(i);
+        for (int r = 0; r < m_dim; r++) {
+            const std::complex<double> c = m_subspace(r, i);
+            vector_ptr[(static_cast<int64_t>(i) * m_dim + r) * 2] = c.real();
+            vector_ptr[(static_cast<int64_t>(i) * m_dim + r) * 2 + 1] = c.imag();
+        }
+    }
+    m_last_eigen_iterations = iterations;
+    result["eigenvalues"] = values;
+    result["eigenvectors"] = vectors;
+    result["iterations"] = iterations;
+    result["residual"] = residual;
+    return result;
+}
+
 PackedFloat64Array QuantumEvolutionEngine::compute_eigenvalues(const PackedFloat64Array& rho_data) const {
     PackedFloat64Array result;
 
@@ -1039,7 +5225,7 @@ PackedFloat64Array QuantumEvolutionEngine::compute_eigenvalues(const PackedFloat
         return result;
     }
 
-    Eigen::MatrixXcd rho = unpack_dense(rho_data);
+    Eigen::Map<const RhoMatrix> rho = map_packed(rho_data);
     Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> solver(rho);
 
     if (solver.info() != Eigen::Success) {
@@ -1166,43 +5352,176 @@ Dictionary QuantumEvolutionEngine::compute_batch_eigenstates(const Dictionary& b
     return results;
 }
 
-PackedFloat64Array QuantumEvolutionEngine::compute_eigenstate_similarity_matrix(
-    const Array& eigenvectors) const {
-    // Compute pairwise cos² similarities for an array of eigenvectors
-    // Returns upper triangular matrix in packed form: [sim_01, sim_02, ..., sim_12, ...]
+Dictionary QuantumEvolutionEngine::compute_batch_eigenstates_packed(const Array& rhos) const {
+    EigenBatch batch;
+    begin_eigen_batch(rhos, batch);
+    // Biomes are independent; a single biome runs inline
+    run_eigen_batch(batch, 0, batch.count(), true);
+    return eigen_batch_result(batch);
+}
 
-    int n = eigenvectors.size();
-    int num_pairs = n * (n - 1) / 2;
+void QuantumEvolutionEngine::begin_eigen_batch(const Array& rhos, EigenBatch& batch) {
+    const int count = rhos.size();
+
+    // Validate and lay out first: every biome writes a disjoint span
+    batch.inputs.assign(count, PackedFloat64Array());
+    batch.dims.assign(count, 0);
+    batch.offsets.resize(count + 1);
+    int64_t total = 0;
+    for (int b = 0; b < count; b++) {
+        batch.offsets.set(b, total);
+        Variant rho_var = rhos[b];
+        if (rho_var.get_type() != Variant::PACKED_FLOAT64_ARRAY) {
+            continue;
+        }
+        batch.inputs[b] = rho_var;
+        const int64_t data_size = batch.inputs[b].size();
+        const int dim = static_cast<int>(std::sqrt(static_cast<double>(data_size / 2)));
+        if (dim <= 0 || static_cast<int64_t>(dim) * dim * 2 != data_size) {
+            continue;
+        }
+        batch.dims[b] = dim;
+        total += dim;
+    }
+    batch.offsets.set(count, total);
+
+    batch.eigenvalues.resize(total);
+    batch.dominant_vectors.resize(total * 2);
+    batch.dominant_values.resize(count);
+    batch.purities.resize(count);
+    batch.dominant_values.fill(0.0);
+    batch.purities.fill(0.0);
+}
 
-    PackedFloat64Array result;
-    result.resize(num_pairs);
+void QuantumEvolutionEngine::run_eigen_batch(EigenBatch& batch, int begin, int end, bool parallel) {
+    begin = std::max(begin, 0);
+    end = std::min(end, batch.count());
+    if (begin >= end) {
+        return;
+    }
+    // Pointers taken once, before any worker writes through them
+    const int64_t* off = batch.offsets.ptr();
+    double* ev_ptr = batch.eigenvalues.ptrw();
+    double* vec_ptr = batch.dominant_vectors.ptrw();
+    double* dom_ptr = batch.dominant_values.ptrw();
+    double* pur_ptr = batch.purities.ptrw();
+    const SimdKernels& simd = simd_kernels();
+    const std::vector<int>& dims = batch.dims;
+    const std::vector<PackedFloat64Array>& inputs = batch.inputs;
+
+    auto biome_range = [&](int range_begin, int range_end) {
+        // One solver per chunk: its workspace is reused across same-size biomes
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> solver;
+        for (int b = range_begin; b < range_end; b++) {
+            const int dim = dims[b];
+            if (dim == 0) {
+                continue;
+            }
+            Eigen::Map<const RhoMatrix> rho(
+                reinterpret_cast<const std::complex<double>*>(inputs[b].ptr()), dim, dim);
+            // Tr(ρ²) = Σ |ρ_ij|², row by row as compute_purity
+            double purity = 0.0;
+            for (int i = 0; i < dim; i++) {
+                purity += simd.norm_sq_c64(reinterpret_cast<const double*>(rho.row(i).data()), dim);
+            }
+            pur_ptr[b] = purity;
+            solver.compute(rho);
+            if (solver.info() != Eigen::Success) {
+                // Leave the span zeroed; purity is still meaningful
+                std::fill(ev_ptr + off[b], ev_ptr + off[b] + dim, 0.0);
+                std::fill(vec_ptr + 2 * off[b], vec_ptr + 2 * off[b] + 2 * dim, 0.0);
+                continue;
+            }
+            const Eigen::VectorXd& values = solver.eigenvalues();
+            for (int j = 0; j < dim; j++) {
+                ev_ptr[off[b] + j] = values(dim - 1 - j);  // Descending
+            }
+            const auto dominant = solver.eigenvectors().col(dim - 1);
+            double* vec = vec_ptr + 2 * off[b];
+            for (int j = 0; j < dim; j++) {
+                vec[j * 2] = dominant(j).real();
+                vec[j * 2 + 1] = dominant(j).imag();
+            }
+            dom_ptr[b] = values(dim - 1);
+        }
+    };
+    if (parallel) {
+        NativeThreadPool::shared().parallel_for(begin, end, 0, biome_range);
+    } else {
+        biome_range(begin, end);
+    }
+}
+
+Dictionary QuantumEvolutionEngine::eigen_batch_result(const EigenBatch& batch) {
+    Dictionary result;
+    result["offsets"] = batch.offsets;
+    result["eigenvalues"] = batch.eigenvalues;
+    result["dominant_eigenvectors"] = batch.dominant_vectors;
+    result["dominant_eigenvalues"] = batch.dominant_values;
+    result["purity"] = batch.purities;
+    return result;
+}
 
+PackedFloat64Array QuantumEvolutionEngine::compute_eigenstate_similarity_matrix(
+    const Array& eigenvectors) const {
+    // Pairwise cos² = |⟨ψ_i|ψ_j⟩|², upper triangle packed: [sim_01, sim_02, ..., sim_12, ...]
+    // Vectors of one length are unboxed once into the columns of a complex
+    // matrix V, and every pair among them is read off the Gram matrix Vᴴ·V
+    // (one matrix product; column blocks split across the pool when large).
+    // Pairs of different lengths, or with a non-array or empty entry, are 0
+    // (as compute_cos2_similarity).
+    const int n = eigenvectors.size();
+    PackedFloat64Array result;
+    result.resize(n >= 2 ? static_cast<int64_t>(n) * (n - 1) / 2 : 0);
     if (n < 2) {
         return result;
     }
-
     double* ptr = result.ptrw();
-    int idx = 0;
+    std::fill(ptr, ptr + result.size(), 0.0);
 
+    std::vector<PackedFloat64Array> states(n);
+    std::map<int64_t, std::vector<int>> by_length;  // Members ascending
     for (int i = 0; i < n; i++) {
-        Variant vi = eigenvectors[i];
-        if (vi.get_type() != Variant::PACKED_FLOAT64_ARRAY) {
-            for (int j = i + 1; j < n; j++) {
-                ptr[idx++] = 0.0;
-            }
+        const Variant v = eigenvectors[i];
+        if (v.get_type() != Variant::PACKED_FLOAT64_ARRAY) {
             continue;
         }
-        PackedFloat64Array state_i = vi;
+        states[i] = v;
+        if (!states[i].is_empty()) {
+            by_length[states[i].size()].push_back(i);
+        }
+    }
 
-        for (int j = i + 1; j < n; j++) {
-            Variant vj = eigenvectors[j];
-            if (vj.get_type() != Variant::PACKED_FLOAT64_ARRAY) {
-                ptr[idx++] = 0.0;
-                continue;
-            }
-            PackedFloat64Array state_j = vj;
+    for (const auto& group : by_length) {
+        const std::vector<int>& members = group.second;
+        const int count = static_cast<int>(members.size());
+        if (count < 2) {
+            continue;
+        }
+        const int dim = static_cast<int>(group.first / 2);
+        Eigen::MatrixXcd V(dim, count);
+        for (int c = 0; c < count; c++) {
+            V.col(c) = Eigen::Map<const Eigen::VectorXcd>(
+                reinterpret_cast<const std::complex<double>*>(states[members[c]].ptr()), dim);
+        }
+
+        Eigen::MatrixXcd gram(count, count);
+        auto column_range = [&](int begin, int end) {
+            gram.middleCols(begin, end - begin).noalias() = V.adjoint() * V.middleCols(begin, end - begin);
+        };
+        if (static_cast<int64_t>(count) * count * dim >= SIMILARITY_PARALLEL_MIN_WORK) {
+            NativeThreadPool::shared().parallel_for(0, count, 0, column_range);
+        } else {
+            column_range(0, count);
+        }
 
-            ptr[idx++] = compute_cos2_similarity(state_i, state_j);
+        // Packed index of (i, j), i < j: rows before i hold n-1, n-2, ... pairs
+        for (int a = 0; a < count; a++) {
+            const int64_t i = members[a];
+            const int64_t row = i * n - i * (i + 1) / 2 - i - 1;
+            for (int b = a + 1; b < count; b++) {
+                ptr[row + members[b]] = std::norm(gram(a, b));
+            }
         }
     }
 
@@ -3,12 +3,21 @@
 
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/array.hpp>
+#include "latency_histograms.h"
+#include "profile_counters.h"
+#include "operator_registry.h"
+#include "lindblad_core.h"
+#include "engine_state_blob.h"
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 #include <vector>
 #include <complex>
+#include <memory>
+#include <unordered_set>
 
 namespace godot {
 
@@ -22,10 +31,37 @@ namespace godot {
  *
  * Expected speedup: 10-20× for typical biomes (Forest: 130ms → 7ms)
  */
-class QuantumEvolutionEngine : public RefCounted {
+class QuantumEvolutionEngine : public RefCounted, public LatencyTracked<QuantumEvolutionEngine> {
     GDCLASS(QuantumEvolutionEngine, RefCounted)
 
 public:
+    enum Integrator {
+        INTEGRATOR_EULER = 0,    // Legacy: one forward-Euler step of max_dt per evolve()
+        INTEGRATOR_DOPRI5 = 1,   // Adaptive Dormand–Prince 5(4) over dt, substeps <= max_dt
+        INTEGRATOR_KRYLOV = 2,   // exp(𝓛·dt) vec(ρ) via Arnoldi expmv (stiff biomes)
+        INTEGRATOR_STRANG = 3,   // U ρ U† half steps around an Euler dissipator step, over dt, steps <= max_dt
+        INTEGRATOR_MULTIRATE = 4, // Fast jump channels substepped inside slow Euler steps, over dt, steps <= max_dt
+        INTEGRATOR_KRAUS = 5      // Completely positive first-order Kraus map, over dt, steps <= max_dt
+    };
+
+    // Field mask for compute_observables
+    enum ObservableMask {
+        OBSERVABLE_BLOCH = 1,   // [p0,p1,x,y,z,r,theta,phi] per qubit
+        OBSERVABLE_PURITY = 2,  // Tr(ρ²)
+        OBSERVABLE_TRACE = 4,   // Re, Im of Tr(ρ)
+        OBSERVABLE_MI = 8,      // Adaptive MI, upper-triangular pair order
+        OBSERVABLE_ALL = 15,    // The four above; the entanglement measures are opt-in
+        OBSERVABLE_CONCURRENCE = 16,  // Wootters concurrence per pair, same order as MI
+        OBSERVABLE_NEGATIVITY = 32    // Logarithmic negativity per pair, same order as MI
+    };
+
+    // Row-major complex matrix: identical memory layout to the packed bridge
+    // format [re00, im00, re01, im01, ...], so packed buffers map without copying.
+    typedef lindblad::RhoMatrix RhoMatrix;
+    typedef lindblad::RhoRef RhoRef;
+    typedef lindblad::RhoConstRef RhoConstRef;
+    typedef Eigen::Matrix<std::complex<float>, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> RhoMatrixF;
+
     QuantumEvolutionEngine();
     ~QuantumEvolutionEngine();
 
@@ -33,35 +69,447 @@ public:
     void set_dimension(int dim);
     void set_hamiltonian(const PackedFloat64Array& H_packed);
     void add_lindblad_triplets(const PackedFloat64Array& triplets);
+    // Operators from a sum of weighted qubit terms, built straight into
+    // sparse storage (dim = 2^n; qubit q is bit q of the basis index). Each
+    // term is [ops, re, im = 0] where ops is either a Pauli string with one
+    // of I/X/Y/Z per qubit (character q acts on qubit q), or a Dictionary
+    // {qubit: packed 2×2} of local factors (identity on the other qubits).
+    // A Pauli string adds dim entries; k local factors add up to dim·2^k.
+    void set_hamiltonian_terms(const Array& terms);
+    void add_lindblad_terms(const Array& terms);
     void clear_operators();
     void finalize();  // Precompute all cached values
 
+    // Patch operators of a finalized engine without a full finalize().
+    // update_hamiltonian_entries assigns H(row, col) = re + i·im for each
+    // [row, col, re, im] quadruple (pass both halves to keep H Hermitian);
+    // replace_lindblad swaps L_k for new triplets. Values are written into
+    // the existing compressed storage of H, H_eff and the Liouvillian when
+    // the sparsity pattern already holds them; only L_k's own L†, L†L and
+    // whatever cache a pattern change actually invalidates are rebuilt.
+    bool update_hamiltonian_entries(const PackedFloat64Array& triplets);
+    bool replace_lindblad(int k, const PackedFloat64Array& triplets);
+
+    // k-local operators (1 or 2 qubits): op_packed is the 2×2 or 4×4 matrix in
+    // packed row-major [re, im] form, qubits the target indices (qubit q is bit q
+    // of the basis index; with two targets qubits[0] is the high local digit,
+    // matching compute_2qubit_reduced). Applied with bit-stride kernels over ρ
+    // instead of a full dim×dim sparse product.
+    void add_local_hamiltonian(const PackedFloat64Array& op_packed, const PackedInt32Array& qubits);
+    void add_local_lindblad(const PackedFloat64Array& op_packed, const PackedInt32Array& qubits);
+    int get_local_operator_count() const;
+    // Representation each operator's products run in, picked by a cost
+    // model when the operators are set (operator_form.h):
+    // {"heff": "csr" | "dia" | "dense", "lindblads": [same, or "diagonal" |
+    // "scatter"]}
+    Dictionary get_operator_forms() const;
+
+    // Liouvillian superoperator mode: finalize() assembles one sparse
+    // dim²×dim² matrix 𝓛 acting on vec(ρ) (column-stacked), so each step is
+    // a single SpMV instead of the per-operator Lindblad sum.
+    // Only assembled when dim <= LIOUVILLIAN_MAX_DIM (memory grows as dim²).
+    void set_use_liouvillian(bool enabled);
+    bool get_use_liouvillian() const;
+    bool has_liouvillian() const;
+    int get_liouvillian_nnz() const;
+    // Stored nonzeros one evolve step multiplies: 𝓛 when assembled, else
+    // H_eff plus every jump operator
+    int64_t get_operator_nnz() const;
+
+    // Precomputed propagator for small engines: with a declared dt > 0 and
+    // dim <= PROPAGATOR_MAX_DIM (4 qubits), finalize() stores the dense
+    // dim² × dim² superoperator exp(𝓛·dt). Any evolve call that would cover
+    // exactly that dt (max_dt for legacy Euler, dt otherwise) is then one
+    // dense matrix-vector product, exact for that dt. Rebuilt whenever the
+    // operators change; 0 disables (default).
+    void set_propagator_dt(double dt);
+    double get_propagator_dt() const;
+    bool has_propagator() const;
+
+    // Symmetry sectors: finalize() splits the basis into the connected
+    // components of the H_eff and L_k sparsity graphs (e.g. total excitation
+    // number when every term conserves it). With two or more sectors, Euler
+    // and DOPRI5 steps on a ρ whose cross-sector elements are exactly zero
+    // (they then stay zero) evaluate 𝓛 block by block on dim_s × dim_s
+    // blocks, in parallel for larger engines, and never touch the rest.
+    // Other states take the full path. On by default.
+    void set_use_symmetry_sectors(bool enabled);
+    bool get_use_symmetry_sectors() const;
+    int get_symmetry_sector_count() const;  // 0 when the operators don't split
+    PackedInt32Array get_symmetry_sector_sizes() const;
+
+    // Population (classical rate-equation) mode for heavily dephased engines.
+    // Eligible when every jump maps basis states to basis states (at most one
+    // nonzero per column, so a diagonal ρ stays diagonal) and every coherent
+    // coupling H_ij is outpaced by the dephasing of its coherence,
+    // Γ_ij >= POPULATION_MIN_DEPHASING_RATIO·|H_ij|. The diagonal then obeys
+    //   dp/dt = W p,  W(i←j) = Σ_k |L_k(i, j)|² + 2|H_ij|² Γ_ij / (Γ_ij² + Δ_ij²)
+    // (the coherences adiabatically eliminated; Δ_ij = H_ii - H_jj), with W
+    // rebuilt lazily after any operator change. An evolve call whose input
+    // has every |ρ_ij| (i ≠ j) at or below the threshold evolves p alone,
+    // O(nnz(W)) per substep, and returns a diagonal ρ; once a gate or drive
+    // puts coherence above the threshold the next call takes the full path
+    // again, and re-enters once dephasing has brought it back down. Drops
+    // coherences of at most the threshold, so keep it above the quasi-static
+    // |H_ij|·|p_i - p_j| / Γ_ij. 0 disables (default).
+    void set_population_mode_threshold(double threshold);
+    double get_population_mode_threshold() const;
+    bool is_population_mode_eligible();  // Rebuilds W first if operators changed
+    bool get_last_population_step() const;  // The last evolve call ran in population mode
+
+    // Sparse-ρ mode for legacy Euler steps: each substep prunes ρ to the
+    // elements with |ρ_ij| above the threshold (the rest are zeroed) and, if
+    // at most SPARSE_RHO_MAX_FILL of the dim² survive, computes dρ from that
+    // entry list alone, scattering each entry through the columns of H_eff
+    // and of every jump (local ones embedded): O(nnz(ρ)·column fill) instead
+    // of dense products over all dim² elements. A step that fills in past
+    // the limit (the fill-in guard) or samples the drift monitor runs dense.
+    // 0 disables (default).
+    void set_sparse_rho_threshold(double threshold);
+    double get_sparse_rho_threshold() const;
+    int get_last_sparse_rho_nnz() const;  // Entries of the last sparse step; 0 when the call ended dense
+
+    // Analytic path for dephasing / decay-only biomes: H diagonal (or
+    // absent) and every jump (local ones embedded) either diagonal
+    // (dephasing) or c·σ⁻ on one basis bit q (amplitude damping: exactly
+    // the entries (a, a | q) for a without q, all equal). If, besides, each
+    // damped bit's transfer commutes with the diagonal part (the rates
+    // below are unchanged by setting q in both indices), exp(𝓛t) has the
+    // closed form
+    //   ρ(a, b) += (1 - e^{-γ_q t}) ρ(a | q, b | q)   for each damped bit q,
+    //   ρ(a, b) *= exp(t·f(a, b)),
+    //   f(a, b) = -i(H_aa - H_bb) + Σ_k d_k(a) d̄_k(b) - ½(g_a + g_b)
+    // (d_k the dephasing diagonals, g_a the total decay rate out of a), so
+    // an evolve call of any integrator is one pass per damped bit plus one
+    // elementwise multiply: exact, O(dim²), no sparse products. Detected by
+    // finalize() and again after any operator change; the factors are cached
+    // for the last interval. On by default.
+    void set_analytic_evolution(bool enabled);
+    bool get_analytic_evolution() const;
+    bool is_analytic_eligible();  // Rebuilds the form first if operators changed
+    bool get_last_analytic_step() const;  // The last evolve call ran analytically
+
+    // Direct steady state: solves 𝓛 vec(ρ) = 0 with Tr ρ = 1 by sparse LU
+    // on the Liouvillian (assembled temporarily if not kept), returning the
+    // packed Hermitian, unit-trace ρ_ss. Empty (with a warning) when not
+    // finalized, above LIOUVILLIAN_MAX_DIM, or when the steady state is not
+    // unique (singular system).
+    PackedFloat64Array compute_steady_state();
+
     // Query methods
     int get_dimension() const;
     int get_lindblad_count() const;
     bool is_finalized() const;
+    // Native view of the operators (H is nullptr if none was set), e.g. for
+    // a trajectory ensemble mirroring this engine
+    const Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor>* hamiltonian_operator() const {
+        return m_has_hamiltonian ? &m_hamiltonian : nullptr;
+    }
+    const std::vector<std::shared_ptr<const SharedLindblad>>& lindblad_operators() const { return m_lindblads; }
 
     // Evolution (single call per frame!)
     PackedFloat64Array evolve_step(const PackedFloat64Array& rho_data, float dt);
 
-    // Single evolution step (max_dt kept for API compatibility, not used)
+    // Single evolution call. EULER: one step of max_dt (dt ignored, legacy).
+    // DOPRI5: integrates the full dt with error-controlled substeps capped at max_dt.
     PackedFloat64Array evolve(const PackedFloat64Array& rho_data, float dt, float max_dt);
 
+    // Zero-copy variant for native callers: maps rho_data as an Eigen::Map and
+    // evolves it in place (no unpack/pack, no per-step heap allocation once
+    // the buffer is uniquely owned). Returns false if not finalized / wrong size.
+    bool evolve_inplace(PackedFloat64Array& rho_data, float dt, float max_dt);
+
+    // Resumable evolve() for time-sliced callers whose single step exceeds a
+    // frame budget. The step is split into work units (the drift, then one
+    // unit per jump operator; with a built Liouvillian, one unit per ρ row
+    // of the SpMV) that can be spread over any number of calls. Only plain
+    // double-precision Euler engines (is_batchable()) support it; the result
+    // equals one evolve_inplace(). Operators changed mid-step restart it.
+    struct SlicedStep {
+        RhoMatrix rho;   // Input state; the evolved state once complete
+        RhoMatrix drho;
+        RhoMatrix temp;
+        double h = 0.0;
+        int next_unit = 0;
+        int unit_count = 0;
+        uint64_t operator_version = 0;
+        bool complete = false;
+    };
+    bool begin_sliced_step(const PackedFloat64Array& rho_data, float dt, float max_dt, SlicedStep& step) const;
+    // Runs up to max_units units; true once step.rho holds the evolved state
+    bool continue_sliced_step(SlicedStep& step, int max_units) const;
+
+    // Resumable compute_observables_into: the reduction sweep is split into
+    // row ranges (pair reductions for MI ride along), then
+    // finish_sliced_observables writes the usual [bloch][purity][trace][mi]
+    struct SlicedObservables {
+        lindblad::ReducedStates states;
+        double purity = 0.0;
+        std::complex<double> trace = std::complex<double>(0.0, 0.0);
+        int num_qubits = 0;
+        int mask = 0;
+        int next_row = 0;
+    };
+    void begin_sliced_observables(int num_qubits, int mask, SlicedObservables& obs) const;
+    // Sweeps up to max_rows more rows of rho; true once every row is in
+    bool continue_sliced_observables(RhoConstRef rho, SlicedObservables& obs, int max_rows) const;
+    // observables_size(num_qubits, mask) doubles into out
+    void finish_sliced_observables(const SlicedObservables& obs, double* out);
+
+    // Multi-step trajectory: evolves `steps` times (each step == one evolve()
+    // call) and writes every state into one contiguous buffer. Frame k lives at
+    // [k * stride, (k + 1) * stride), stride = 2·dim². The state stays native
+    // between steps (each frame is evolved in place from a copy of the last).
+    // Returns Dictionary with "frames", "stride", "offsets" (PackedInt64Array), "steps";
+    // with flux tracking on, also "channel_flux": each step's flux (as
+    // take_channel_flux lays it out) at k·channels·emojis, without taking it.
+    Dictionary evolve_trajectory(const PackedFloat64Array& rho_data, int steps, float dt, float max_dt);
+    // Native variant: resizes `frames` to steps·stride and fills it (and
+    // channel_flux, when given and tracking is on, like "channel_flux").
+    bool evolve_trajectory_into(const PackedFloat64Array& rho_data, int steps,
+                                float dt, float max_dt, PackedFloat64Array& frames,
+                                PackedFloat64Array* channel_flux = nullptr);
+
+    // Equal-dimension batching: the operators of several engines stacked
+    // block-diagonally. With the biomes' ρ stacked vertically (count·dim × dim),
+    // every term of the RHS is one sparse × tall-dense product for the whole
+    // group instead of one small product per biome. Right products use
+    // X L† = (L X†)†, so they're left products too.
+    struct BatchedOperators {
+        int dim = 0;
+        int count = 0;
+        Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> heff;  // blockdiag(H_eff), local terms expanded
+        std::vector<Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor>> jumps;  // blockdiag(L^(k)), zero blocks past a biome's count
+        // Jump slots where every biome holds the same registered operator:
+        // applied block by block with the one dim×dim L, no blockdiag copy
+        std::vector<std::shared_ptr<const SharedLindblad>> shared_jumps;
+    };
+    struct BatchedWorkspace {
+        RhoMatrix x, y, drho;  // count·dim × dim each, sized on first step
+    };
+    // True if evolve() is a plain double-precision Euler step (the batched kernel's scope)
+    bool is_batchable() const;
+    // Bumped by every operator mutation: equal versions mean the same generator
+    uint64_t get_operator_version() const { return m_operator_version; }
+    // nullptr unless every engine is batchable and all dimensions agree
+    static std::shared_ptr<const BatchedOperators> build_batched_operators(
+        const std::vector<const QuantumEvolutionEngine*>& engines);
+    // One Euler step of dt on every block of stack, same as euler_step() per biome
+    static void euler_step_batched(const BatchedOperators& ops, RhoMatrix& stack, double dt,
+                                   BatchedWorkspace& work);
+
+    // Apply an action operator A (dense packed, same layout as H_packed):
+    // ρ' = A ρ A† / Tr(A ρ A†). Covers unitaries, projectors and Kraus ops.
+    // Returns an empty array (with a warning) on size mismatch or if the
+    // result has zero trace (projector orthogonal to ρ).
+    PackedFloat64Array apply_operator(const PackedFloat64Array& rho_data, const PackedFloat64Array& op_packed) const;
+
+    // Gates on ρ without building a dim×dim unitary: ρ' = U ρ U† with U a
+    // packed 2×2 / 4×4 acting on the given qubits (same qubit convention and
+    // packing as add_local_hamiltonian; qubit_a is the high local digit),
+    // applied by bit-stride sweeps in O(dim²) per gate. The controlled form
+    // applies U2 on target only where control is |1⟩. Empty (with a
+    // warning) on a size or qubit mismatch.
+    PackedFloat64Array apply_gate_1q(const PackedFloat64Array& rho_data, int qubit, const PackedFloat64Array& U2) const;
+    PackedFloat64Array apply_gate_2q(const PackedFloat64Array& rho_data, int qubit_a, int qubit_b,
+                                     const PackedFloat64Array& U4) const;
+    PackedFloat64Array apply_controlled_gate(const PackedFloat64Array& rho_data, int control, int target,
+                                             const PackedFloat64Array& U2) const;
+    // Native form on a dim×dim ρ in place; work is dim×dim scratch
+    static void apply_local_gate(const lindblad::LocalOperator& gate, RhoRef rho, RhoMatrix& work);
+
+    // Projective measurement in the computational basis (qubit q is basis
+    // bit q, as for gates): samples an outcome from ρ's diagonal with a
+    // generator seeded by rng_seed, projects and renormalizes. Returns
+    // {"outcome", "probability", "rho"}; measure_basis measures the listed
+    // qubits jointly (all when empty) with outcome bit t = qubits[t].
+    // Empty (with a warning) on a size mismatch or a zero-trace ρ.
+    Dictionary measure_qubit(const PackedFloat64Array& rho_data, int qubit, int64_t rng_seed) const;
+    Dictionary measure_basis(const PackedFloat64Array& rho_data, const PackedInt32Array& qubits,
+                             int64_t rng_seed) const;
+    // Native form: collapses rho in place onto the basis-bit pattern picked
+    // by u ∈ [0, 1) among the bits of mask; returns the pattern (-1 if Tr ρ
+    // has no weight) and its probability
+    static int measure_inplace(RhoRef rho, int mask, double u, double* probability);
+
+    // Hermitian half-storage I/O: per row i, [Re ρ_ii, Re ρ_i(i+1), Im ρ_i(i+1), ..., Re ρ_i(n-1), Im ρ_i(n-1)]
+    // i.e. real diagonal + upper triangle, dim² doubles instead of 2·dim².
+    PackedFloat64Array evolve_hermitian(const PackedFloat64Array& rho_herm, float dt, float max_dt);
+    PackedFloat64Array pack_hermitian(const PackedFloat64Array& rho_data) const;    // dense → half
+    PackedFloat64Array unpack_hermitian(const PackedFloat64Array& rho_herm) const;  // half → dense
+    double compute_purity_from_hermitian(const PackedFloat64Array& rho_herm) const;
+
+    // Integrator selection (per engine) and DOPRI5 error tolerances
+    void set_integrator(int integrator);
+    int get_integrator() const;
+    void set_integrator_tolerance(double rtol, double atol);
+    int get_last_substep_count() const;  // Accepted substeps in the last evolve()
+    int get_last_rhs_evaluations() const;  // Liouvillian applications in the last evolve()
+    bool get_last_step_truncated() const;  // DOPRI5 ran out of attempts short of dt in the last evolve()
+    void set_krylov_dimension(int m);  // Arnoldi basis size for INTEGRATOR_KRYLOV
+    int get_krylov_dimension() const;
+
+    // INTEGRATOR_MULTIRATE: finalize() ranks every jump channel by the rate
+    // bound ||L†L||_∞ and marks the channels above the largest gap of at
+    // least rate_gap× between neighbouring rates as fast. Each outer step h
+    // is a symmetric split: fast dissipator over h/2 in Euler substeps of
+    // rate·h_sub <= 0.1, the remaining generator (H and slow channels) by
+    // one Euler step of h, fast dissipator over h/2 again. Without such a
+    // gap every channel is slow and the mode is plain Euler over dt.
+    void set_multirate_rate_gap(double ratio);
+    double get_multirate_rate_gap() const;
+    int get_fast_channel_count() const;
+
+    // Single-precision mode (render-only lookahead): Euler steps run on
+    // complex<float> copies of ρ and the operators. Every resync_interval-th
+    // step runs in double and re-Hermitizes / renormalizes ρ to bound drift.
+    // DOPRI5 and Krylov always run in double (their error control needs it).
+    void set_single_precision(bool enabled);
+    bool get_single_precision() const;
+    void set_precision_resync_interval(int steps);
+    int get_precision_resync_interval() const;
+
+    // Drift monitor for INTEGRATOR_EULER (double and single precision): every
+    // interval-th Euler step samples, before the trace cap / diagonal clamp
+    // hides them, the step's trace change, the largest |ρ_ij - conj(ρ_ji)| over `pairs`
+    // rotating element pairs, and the negative population mass
+    // Σ max(0, -Re ρ_ii). When fallback is on and a sample exceeds a
+    // threshold the engine escalates one drift level:
+    //   0 = one Euler step of max_dt, 1 = 2 substeps, 2 = 4 substeps,
+    //   3 = INTEGRATOR_KRAUS over max_dt (completely positive, stays physical)
+    // Levels stick until reset_drift_monitor() or set_integrator(); an
+    // escalated engine leaves equal-dimension batching. Default: every 8th
+    // step, 16 pairs, every threshold 1e-5, fallback on.
+    void set_drift_monitor(int interval, int pairs = 16);  // interval 0 = off
+    void set_drift_thresholds(double trace_error, double hermiticity_error, double negative_mass);
+    void set_drift_fallback_enabled(bool enabled);
+    bool is_drift_fallback_enabled() const;
+    int get_drift_level() const;
+    // {"trace_error", "hermiticity_error", "negative_mass"} of the last sample,
+    // "max_trace_error" / "max_hermiticity_error" / "max_negative_mass" since
+    // the last reset, "samples", "escalations", "level"
+    Dictionary get_drift_stats() const;
+    void reset_drift_monitor();  // Clears the stats and returns to level 0
+
     // Mutual information computation (piggybacks on evolution)
     // Returns: [mi_01, mi_02, ..., mi_0n, mi_12, mi_13, ..., mi_(n-1)n] for all pairs
     // Format: num_qubits * (num_qubits - 1) / 2 values in upper triangular order
     PackedFloat64Array compute_all_mutual_information(const PackedFloat64Array& rho_data, int num_qubits);
 
+    // Von Neumann entropy S(ρ_S) in bits of each qubit subset (qubit q = basis
+    // bit q). subsets: Array of qubit index arrays (up to 10 qubits each).
+    // Returns one value per subset in input order (0.0 for invalid subsets).
+    // Reduced states are cached for the call and smaller subsets are traced
+    // down from a cached superset, so nested groups cost far less than a
+    // reduction from the full ρ each.
+    PackedFloat64Array compute_subsystem_entropies(const PackedFloat64Array& rho_data, int num_qubits,
+                                                   const Array& subsets);
+
     // OPTIMIZED: Adaptive MI computation with screening and high-purity approximation
-    // - First call (force_full_scan=true): Screens ALL pairs to find candidates
-    // - Subsequent calls: Only computes MI for candidates
+    // - First call (or force_full_scan=true): Screens ALL pairs to find candidates
+    // - Subsequent calls: Computes MI for candidates (which leave the set only
+    //   below a lower exit threshold) and re-screens a rotating window of
+    //   non-candidates, so new correlations are picked up without a full scan
     // - Uses linear entropy approximation when purity > 0.9 (no eigendecomp!)
     PackedFloat64Array compute_mi_adaptive(
         const PackedFloat64Array& rho_data, int num_qubits,
         double biome_purity, bool force_full_scan = false);
 
     // Clear MI candidates (call when biome state changes significantly)
-    void clear_mi_candidates() { m_mi_candidates.clear(); }
+    void clear_mi_candidates();
+    int get_mi_candidate_count() const;
+    // Sparse view of an MI array for ForceGraphEngine: [i, j, mi, ...] for the
+    // current candidate pairs with mi > 0, pair order preserved. Without a
+    // candidate set of the right size (e.g. values from
+    // compute_all_mutual_information) every nonzero entry is listed.
+    PackedFloat64Array get_mi_edges(const PackedFloat64Array& mi_values, int num_qubits) const;
+    // get_mi_edges into a caller buffer (replaced), so the lookahead force
+    // step reuses one allocation across steps
+    void mi_edges_into(const double* mi_values, int count, int num_qubits, std::vector<double>& out) const;
+    void set_mi_rescreen_budget(int pairs_per_call);  // Default 4; 0 = candidates only
+    int get_mi_rescreen_budget() const;
+    // Change-driven re-screen on top of the rotating window: a non-candidate
+    // pair is also screened when either qubit's reduced state has moved more
+    // than drift (max-abs element delta) since that qubit's last screen, so
+    // the candidate set follows the state across calls and lookahead refills
+    // without full scans. Default 0.01; 0 = rotating window only
+    void set_mi_rescreen_drift(double drift);
+    double get_mi_rescreen_drift() const;
+    // Use the linear-entropy MI approximation at every purity, not only above
+    // PURITY_HIGH_THRESHOLD (cheaper, less exact for mixed states)
+    void set_mi_force_linear(bool force_linear);
+    bool get_mi_force_linear() const;
+
+    // Screening effectiveness of the adaptive MI path, for tuning
+    // MI_SCREEN_THRESHOLD and PURITY_HIGH_THRESHOLD:
+    //   "calls", "full_scans", "linear_calls" / "eigen_calls" (entropy path)
+    //   "pairs_screened": product deviation computed (full scans + re-screens)
+    //   "pairs_drift_screened": the re-screens triggered by marginal drift
+    //   "candidates_kept": candidates after screening, summed over calls
+    //   "pairs_skipped": non-candidates neither screened nor evaluated
+    //   "pairs_reused": candidates served from the change-tracking cache
+    //   "audits", "audit_pairs", "audit_false_negatives",
+    //   "false_negative_rate": every interval-th call (0 = off, the default)
+    //   also computes the exact MI of each non-candidate pair, without
+    //   changing the output, and counts those at or above
+    //   MI_AUDIT_THRESHOLD bits as misses
+    void set_mi_audit_interval(int calls);
+    int get_mi_audit_interval() const;
+    Dictionary get_mi_screen_stats() const;
+    void reset_mi_screen_stats();
+    // Candidates after the most recent adaptive MI call (no bitset walk)
+    int last_mi_candidate_count() const { return m_mi_last_candidates; }
+
+    // Pair evaluation in compute_all_mutual_information / compute_mi_adaptive
+    // runs on the shared native pool once at least min_pairs pairs need an
+    // entropy (default 28, i.e. 8+ qubits); 0 = always serial
+    void set_mi_parallel_threshold(int min_pairs);
+    int get_mi_parallel_threshold() const;
+
+    // Change tracking for settled biomes: each per-qubit Bloch entry and each
+    // adaptive MI pair remembers the reduced matrix it was computed from, and
+    // is reused while the new reduced matrix stays within the tolerance
+    // (max-abs element delta) of that snapshot. Deltas are measured against
+    // the snapshot, not the previous step, so drift never accumulates past
+    // the tolerance. Purity is always exact. 0 disables (default).
+    void set_observable_reuse_tolerance(double tolerance);
+    double get_observable_reuse_tolerance() const;
+    void clear_observable_cache();
+    int get_last_reused_observable_count() const;  // Entries served from cache by the last call
+
+    // Hot-path timers (always on): {"evolve", "reduce", "bloch", "mi",
+    // "entanglement"} -> {"calls", "usec", "avg_usec"}. "reduce" is the fused
+    // reduction sweep that also yields purity and trace.
+    Dictionary get_profile_stats() const;
+    void reset_profile_stats();
+    // Raw cumulative stages, for callers diffing them around their own calls
+    const ProfileStage& evolve_profile() const { return m_profile_evolve; }
+    const ProfileStage& mi_profile() const { return m_profile_mi; }
+
+    // Lindblad operators are interned in a process-wide content-hashed
+    // registry, so identical operators across biomes share one L, L†, L†L.
+    // Returns {"live", "hits", "misses", "bytes"} for the whole process.
+    Dictionary get_operator_registry_stats() const;
+
+    // Heap bytes by category: "hamiltonian" (H, H_eff), "local_operators",
+    // "lindblad_operators" (L), "lindblad_cache" (L†, L†L, f32 copies),
+    // "liouvillian" (with the propagator), "single_precision", "scratch", "observable_cache",
+    // plus "total". Lindblad operators are shared through the registry, so
+    // engines holding the same operator each report it.
+    Dictionary get_memory_stats() const;
+    // Same breakdown into out, returning the total. With shared_seen,
+    // operators already in the set are skipped (and new ones added), so a
+    // caller summing several engines counts each shared operator once.
+    int64_t collect_memory_stats(Dictionary& out, std::unordered_set<const SharedLindblad*>* shared_seen) const;
+
+    // Binary state block for MultiBiomeLookaheadEngine snapshots: settings,
+    // compressed H, Lindblad operators with their cached L†/L†L, local
+    // terms and, once finalized, H_eff and the Liouvillian. read_state
+    // replaces this engine's operators and settings and finalizes without
+    // recomputing any of the stored products; false on a malformed block
+    // (the engine is then left unfinalized).
+    void write_state(EngineStateWriter& out) const;
+    bool read_state(EngineStateReader& in);
 
     // Combined evolution + MI computation (single call for both)
     // Returns Dictionary with "rho" (evolved state), "mi" (mutual information array),
@@ -70,13 +518,72 @@ public:
     Dictionary evolve_with_mi(const PackedFloat64Array& rho_data, float dt, float max_dt, int num_qubits);
 
     // Basic observables
-    double compute_purity(const Eigen::MatrixXcd& rho) const;
-    std::complex<double> compute_trace(const Eigen::MatrixXcd& rho) const;
-    PackedFloat64Array compute_bloch_metrics(const Eigen::MatrixXcd& rho, int num_qubits) const;
+    double compute_purity(RhoConstRef rho) const;
+    std::complex<double> compute_trace(RhoConstRef rho) const;
+    PackedFloat64Array compute_bloch_metrics(RhoConstRef rho, int num_qubits) const;
     double compute_purity_from_packed(const PackedFloat64Array& rho_data) const;
     PackedFloat64Array compute_bloch_metrics_from_packed(const PackedFloat64Array& rho_data, int num_qubits) const;
+
+    // Fused observables: one sweep over ρ fills every selected field into one
+    // flat buffer of sections [bloch n·8][purity][trace_re, trace_im][mi n(n-1)/2]
+    // [concurrence n(n-1)/2][negativity n(n-1)/2] in that order, unselected
+    // sections omitted. The entanglement measures read the same 4×4 pair
+    // reductions as MI (every pair, not only MI candidates). MI is the adaptive path
+    // (candidate state advances) with its entropy mode picked by the purity
+    // from the same sweep.
+    PackedFloat64Array compute_observables(RhoConstRef rho, int num_qubits, int mask = OBSERVABLE_ALL);
+    PackedFloat64Array compute_observables_from_packed(const PackedFloat64Array& rho_data, int num_qubits,
+                                                       int mask = OBSERVABLE_ALL);
+    // compute_observables into a caller buffer of observables_size() doubles
+    static int observables_size(int num_qubits, int mask);
+    void compute_observables_into(RhoConstRef rho, int num_qubits, int mask, double* out);
+
+    // Low-rank mode for high-purity biomes: ρ = V V† carried as its factor V
+    // (dim × r, packed row-major [re, im], r = size / (2·dim)), so memory,
+    // evolution and observables cost O(dim·r) per operator term instead of
+    // O(dim²). Steps are first-order Kraus updates, positive by construction;
+    // the rank grows as the state mixes and is truncated back to the
+    // eigen-directions above tolerance·λ_max, at most max_rank of them.
+    // The dense-ρ paths are untouched; callers opt in per biome.
+    void set_low_rank_truncation(int max_rank, double tolerance);
+    int get_low_rank_max_rank() const;
+    double get_low_rank_tolerance() const;
+    // Dense ρ → V under the current truncation (one eigensolve)
+    PackedFloat64Array factor_low_rank(const PackedFloat64Array& rho_data) const;
+    // V V† → dense ρ (e.g. when leaving low-rank mode)
+    PackedFloat64Array expand_low_rank(const PackedFloat64Array& factor) const;
+    // Integrates dt in substeps of at most max_dt; returns the new factor,
+    // whose rank may differ from the input's
+    PackedFloat64Array evolve_low_rank(const PackedFloat64Array& factor, float dt, float max_dt);
+    // compute_observables on V V† (same packet layout), without forming ρ
+    PackedFloat64Array compute_observables_low_rank(const PackedFloat64Array& factor, int num_qubits,
+                                                    int mask = OBSERVABLE_ALL);
+
+    // Cached: recomputed only when operators change (any set_/add_/clear_ call)
+    // or metadata differs from the cached payload's. Metadata may use either
+    // emoji form of resolve_emoji_layout (emoji_registry.h). Besides the
+    // String-keyed "hamiltonian"/"lindblad"/"sink_fluxes" maps (empty with
+    // metadata "ids_only"), edges come as parallel arrays of EmojiRegistry ids:
+    // "hamiltonian_source_ids"/"_target_ids"/"hamiltonian_strengths",
+    // "lindblad_source_ids"/"_target_ids"/"lindblad_rates", "sink_ids"/"sink_values"
     Dictionary compute_coupling_payload(const Dictionary& metadata) const;
 
+    // Population flux per jump channel, accumulated natively while ρ evolves
+    // (the measured counterpart of the payload's static rates). Metadata
+    // names "num_qubits" and the emojis as for compute_coupling_payload; an
+    // empty Dictionary turns tracking off. Every dense evolve call (evolve,
+    // evolve_step, evolve_inplace, evolve_hermitian, evolve_trajectory) then
+    // adds, per channel k (global jumps, then local ones) and tracked emoji,
+    // the population D_k(ρ) = L ρ L† - ½{L†L, ρ} moves into the emoji's
+    // basis states over the call's interval, from the input state: exactly
+    // the channel's share of an Euler step, first order for the multi-stage
+    // integrators. Negative values are population leaving the emoji.
+    void set_flux_tracking(const Dictionary& metadata);
+    bool is_flux_tracking() const;
+    PackedInt32Array get_flux_emoji_ids() const;  // Column order of the flux arrays
+    // Flux since the last take, channels × emojis row-major; resets it
+    PackedFloat64Array take_channel_flux();
+
     // Eigenstate analysis (CPU-only, uses Eigen)
     // Returns Dictionary with "eigenvalues", "dominant_eigenvector", "dominant_eigenvalue"
     Dictionary compute_eigenstates(const PackedFloat64Array& rho_data) const;
@@ -84,17 +591,79 @@ public:
     // Returns just the dominant eigenvector (largest eigenvalue) as PackedFloat64Array [re0, im0, re1, im1, ...]
     PackedFloat64Array compute_dominant_eigenvector(const PackedFloat64Array& rho_data) const;
 
+    // Stateful dominant-eigenvector tracking across frames (same packed format).
+    // Power iteration warm-started from the previous frame's vector: O(k·dim²)
+    // per call instead of an O(dim³) decomposition. A full decomposition runs
+    // on the first call, when the per-iteration contraction (≈ λ₂/λ₁) shows the
+    // gap has collapsed, or when max_iterations pass without reaching the
+    // residual tolerance ‖ρv − λv‖ <= tol·λ. Results are phase-aligned with the
+    // previous frame so the tracked vector is continuous.
+    PackedFloat64Array track_dominant_eigenvector(const PackedFloat64Array& rho_data);
+    double get_tracked_dominant_eigenvalue() const;
+    int get_last_eigen_iterations() const;  // Power iterations of the last track call (-1 = full decomposition)
+    void set_eigen_tracking_tolerance(double tolerance);  // Default 1e-8
+    double get_eigen_tracking_tolerance() const;
+    void set_eigen_tracking_max_iterations(int iterations);  // Default 32
+    int get_eigen_tracking_max_iterations() const;
+    void reset_eigen_tracking();  // Also drops the track_eigen_subspace block
+
+    // Stateful top-k tracking, the block form of track_dominant_eigenvector:
+    // subspace iteration with Rayleigh–Ritz on k + EIGEN_SUBSPACE_GUARD
+    // vectors, warm-started from the previous frame's block, so a frame
+    // costs O(k·dim²) per iteration. Converged once every leading Ritz pair
+    // has ‖ρv − θv‖ <= tolerance·θ₀; the same gap-collapse and
+    // max_iterations fallbacks to a full decomposition apply (as does the
+    // first call, or a change of k). Each vector is phase-aligned with its
+    // previous-frame counterpart. Returns Dictionary:
+    //   "eigenvalues":  PackedFloat64Array(k), descending
+    //   "eigenvectors": PackedFloat64Array(k·dim·2), vector i packed
+    //                   [re, im] at 2·dim·i
+    //   "iterations":   int (-1 = full decomposition)
+    //   "residual":     largest ‖ρv − θv‖ of the returned pairs
+    Dictionary track_eigen_subspace(const PackedFloat64Array& rho_data, int k, double tolerance = 1e-8);
+
     // Returns all eigenvalues sorted descending as PackedFloat64Array
     PackedFloat64Array compute_eigenvalues(const PackedFloat64Array& rho_data) const;
 
     // Compute cos²(θ) = |⟨ψ₁|ψ₂⟩|² similarity between two state vectors
     // state_a and state_b are packed as [re0, im0, re1, im1, ...]
+    // (matching one state against many targets: ReferenceStateLibrary)
     double compute_cos2_similarity(const PackedFloat64Array& state_a, const PackedFloat64Array& state_b) const;
 
     // Batch eigenstate analysis: returns Dictionary with biome_name -> eigenstate data
     // Input: Dictionary of biome_name -> rho_packed
     Dictionary compute_batch_eigenstates(const Dictionary& biome_rhos) const;
 
+    // Flat batch variant for many biomes: Array of packed rhos (any mix of
+    // dimensions; no engine state used), decomposed in parallel on the shared
+    // pool straight from the packed buffers. Returns Dictionary:
+    //   "offsets":   PackedInt64Array(count + 1); biome b's eigenvalues are
+    //                [offsets[b], offsets[b+1]) (empty span = invalid input)
+    //   "eigenvalues":           all eigenvalues, descending per biome
+    //   "dominant_eigenvectors": packed [re, im] vectors at 2·offsets[b]
+    //   "dominant_eigenvalues", "purity": one value per biome
+    Dictionary compute_batch_eigenstates_packed(const Array& rhos) const;
+
+    // compute_batch_eigenstates_packed in resumable pieces (the sliced and
+    // async eigenstate analysis of MultiBiomeLookaheadEngine): begin
+    // validates the rhos and lays out the outputs, run decomposes biomes
+    // [begin, end) into them (across the shared pool if parallel), and
+    // result packs the Dictionary. Biomes are independent, so any split of
+    // the range gives the one-call result.
+    struct EigenBatch {
+        std::vector<PackedFloat64Array> inputs;
+        std::vector<int> dims;  // 0 = invalid input (empty span)
+        PackedInt64Array offsets;
+        PackedFloat64Array eigenvalues;
+        PackedFloat64Array dominant_vectors;
+        PackedFloat64Array dominant_values;
+        PackedFloat64Array purities;
+        int count() const { return static_cast<int>(dims.size()); }
+    };
+    static void begin_eigen_batch(const Array& rhos, EigenBatch& batch);
+    static void run_eigen_batch(EigenBatch& batch, int begin, int end, bool parallel);
+    static Dictionary eigen_batch_result(const EigenBatch& batch);
+
     // Compute pairwise cos² similarity matrix for multiple eigenstates
     // Input: Array of PackedFloat64Array eigenvectors
     // Returns: PackedFloat64Array in upper triangular order [sim_01, sim_02, ..., sim_12, ...]
@@ -106,37 +675,375 @@ protected:
 private:
     int m_dim;
     bool m_finalized;
+    uint64_t m_operator_version = 0;  // Bumped by every operator mutation
+
+    // compute_coupling_payload cache, keyed by operator version + metadata
+    Dictionary build_coupling_payload(const Dictionary& metadata) const;
+    mutable Dictionary m_coupling_cache;
+    mutable Dictionary m_coupling_cache_metadata;
+    mutable uint32_t m_coupling_cache_hash = 0;
+    mutable uint64_t m_coupling_cache_version = 0;
+    mutable bool m_coupling_cache_valid = false;
+
+    // set_flux_tracking state: tracked emojis and the flux since the last take
+    bool m_flux_tracking = false;
+    std::vector<int> m_flux_emoji_ids;
+    std::vector<int> m_flux_bits;   // Basis bit of each tracked emoji's qubit
+    std::vector<int> m_flux_poles;  // Bit value of its pole
+    std::vector<double> m_channel_flux;  // Channels × emojis
+    std::vector<double> m_flux_diag;     // Scratch: diag D_k(ρ)
+    int flux_channel_count() const { return static_cast<int>(m_lindblads.size() + m_local_lindblads.size()); }
+    // m_channel_flux += interval · (emoji populations of D_k(ρ)) for every k
+    void accumulate_channel_flux(RhoConstRef rho, double interval);
     int m_num_qubits;  // Cached for MI computation
 
     // Sparse Hamiltonian (optional) - exploits ~99% sparsity in quantum coupling matrices
     Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> m_hamiltonian;
     bool m_has_hamiltonian;
 
-    // Sparse Lindblad operators
-    std::vector<Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor>> m_lindblads;
+    // Sparse Lindblad operators: handles into the shared OperatorRegistry,
+    // which also holds each operator's L† and L†L
+    std::vector<std::shared_ptr<const SharedLindblad>> m_lindblads;
 
-    // Cached values for efficiency
-    std::vector<Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor>> m_lindblad_dags;  // L†
-    std::vector<Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor>> m_LdagLs;        // L†L
+    // k-local operators (2×2 ops live in the top-left block of op)
+    typedef lindblad::LocalOperator LocalOperator;
+    std::vector<LocalOperator> m_local_hamiltonians;
+    std::vector<LocalOperator> m_local_lindblads;
+    std::vector<LocalOperator> m_local_heff;  // finalize(): H_loc - (i/2) Σ L†L, merged per target set
+
+    // Effective non-Hermitian Hamiltonian H_eff = H - (i/2) Σ_k L_k†L_k (built in finalize()).
+    // Drift -i(H_eff ρ - ρ H_eff†) replaces the Hamiltonian and all anticommutator terms.
+    Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> m_heff;
+    bool m_has_heff = false;
+    // m_heff in its cheapest form for H_eff·ρ (operator_form.h); the
+    // generator kernels use it unless it is CSR
+    OperatorForm m_heff_form;
 
     // Pre-allocated scratch buffers for evolution (avoid per-frame allocation)
-    Eigen::MatrixXcd m_drho_buffer;      // Scratch for drho computation
-    Eigen::MatrixXcd m_temp_buffer;      // Scratch for intermediate results
+    RhoMatrix m_drho_buffer;      // Scratch for drho computation
+    RhoMatrix m_temp_buffer;      // Scratch for intermediate results
+
+    // Vectorized Liouvillian acting on row-stacked vec(ρ), i.e. directly on the
+    // RhoMatrix / packed storage (built in finalize() when enabled and dim is small enough)
+    Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> m_liouvillian;
+    bool m_use_liouvillian = true;
+    bool m_has_liouvillian = false;
+    static constexpr int LIOUVILLIAN_MAX_DIM = 128;  // 7 qubits → 16384² sparse
+
+    // exp(𝓛·dt) on row-stacked vec(ρ) (see set_propagator_dt)
+    Eigen::Matrix<std::complex<double>, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> m_propagator;
+    Eigen::VectorXcd m_propagator_work;
+    double m_propagator_dt = 0.0;
+    bool m_has_propagator = false;
+    static constexpr int PROPAGATOR_MAX_DIM = 16;  // 256² dense, 1 MiB
+
+    // Population mode (see set_population_mode_threshold): off-diagonal
+    // rates W(i←j) by row, total out-rate per state, valid for m_rate_version
+    double m_population_threshold = 0.0;
+    Eigen::SparseMatrix<double, Eigen::RowMajor> m_rate_matrix;
+    Eigen::VectorXd m_rate_out;
+    Eigen::VectorXd m_population;
+    Eigen::VectorXd m_population_next;
+    double m_rate_max = 0.0;  // max_i m_rate_out(i)
+    bool m_rate_eligible = false;
+    bool m_rate_built = false;
+    uint64_t m_rate_version = 0;
+    bool m_last_population_step = false;
+    static constexpr double POPULATION_MIN_DEPHASING_RATIO = 10.0;
+    static constexpr double POPULATION_SUBSTEP_CFL = 0.5;  // h·max out-rate (keeps p >= 0)
+
+    // Sparse-ρ mode (see set_sparse_rho_threshold): the pruned state, and
+    // the operators' columns as CSR adjoints for m_sparse_ops_version
+    struct RhoEntry {
+        int row;
+        int col;
+        std::complex<double> value;
+    };
+    double m_sparse_rho_threshold = 0.0;
+    std::vector<RhoEntry> m_sparse_rho;
+    lindblad::SparseCM m_sparse_heff_adj;  // (H_eff plus the local H_eff terms)†
+    std::vector<lindblad::SparseCM> m_sparse_local_jumps_adj;  // Embedded local L†
+    std::vector<const lindblad::SparseCM*> m_sparse_jumps_adj;  // Every L_k†
+    uint64_t m_sparse_ops_version = 0;
+    bool m_sparse_ops_built = false;
+    int m_last_sparse_rho_nnz = 0;
+    static constexpr double SPARSE_RHO_MAX_FILL = 0.05;
+
+    // Analytic path (see set_analytic_evolution), valid for
+    // m_analytic_version: energies, dephasing diagonals, total decay per
+    // state and the damped bits, then the factors for m_analytic_t
+    struct DampedBit {
+        int mask;
+        double gamma;
+        double transfer;  // 1 - e^{-γ t} for m_analytic_t
+    };
+    bool m_use_analytic = true;
+    bool m_analytic_eligible = false;
+    bool m_analytic_built = false;
+    uint64_t m_analytic_version = 0;
+    Eigen::VectorXd m_analytic_energy;
+    std::vector<Eigen::VectorXcd> m_analytic_dephasing;
+    Eigen::VectorXd m_analytic_decay;  // g_a
+    std::vector<DampedBit> m_analytic_damped;
+    RhoMatrix m_analytic_factors;  // exp(t·f(a, b))
+    double m_analytic_t = -1.0;
+    bool m_last_analytic_step = false;
+
+    // Single-precision mirrors of the evolution operators and scratch
+    typedef Eigen::SparseMatrix<std::complex<float>, Eigen::RowMajor> SparseMatrixF;
+    bool m_single_precision = false;
+    int m_resync_interval = 8;
+    int m_steps_since_resync = 0;
+    SparseMatrixF m_heff_f;  // Jump mirrors live on the shared SharedLindblad entries
+    SparseMatrixF m_liouvillian_f;
+    RhoMatrixF m_rho_f;
+    RhoMatrixF m_drho_f;
+    RhoMatrixF m_temp_f;
+
+    // Adaptive integrator state
+    int m_integrator = INTEGRATOR_EULER;
+    double m_rtol = 1e-6;
+    double m_atol = 1e-9;
+    double m_dopri_h = 0.0;          // Last accepted substep (warm start for next call)
+    int m_last_substeps = 0;
+    int m_last_rhs_evals = 0;
+    bool m_last_step_truncated = false;
+
+    // Euler drift monitor (set_drift_monitor)
+    enum DriftLevel { DRIFT_EULER = 0, DRIFT_MAX_SUBSTEP_LEVEL = 2, DRIFT_KRAUS = 3 };
+    int m_drift_interval = 8;          // Euler steps between samples, 0 = off
+    int m_drift_pairs = 16;
+    int m_drift_countdown = 0;
+    uint64_t m_drift_cursor = 0;       // Rotates the sampled element pairs
+    double m_drift_threshold[3] = {1e-5, 1e-5, 1e-5};  // trace, hermiticity, negative mass
+    double m_drift_last[3] = {0.0, 0.0, 0.0};
+    double m_drift_max[3] = {0.0, 0.0, 0.0};
+    int64_t m_drift_samples = 0;
+    int m_drift_escalations = 0;
+    int m_drift_level = DRIFT_EULER;
+    bool m_drift_fallback = true;
+    std::vector<RhoMatrix> m_stage_buffers;  // k1..k7, y_stage, y_new
+
+    // Krylov expmv state (basis columns are vec(ρ)-sized, never a dense propagator)
+    int m_krylov_dim = 20;
+    double m_krylov_tau = 0.0;       // Last accepted substep (warm start)
+    Eigen::MatrixXcd m_krylov_basis;  // dim² × (m+1)
+
+    // Multi-rate channel split (see set_multirate_rate_gap)
+    double m_multirate_gap = 10.0;
+    std::vector<bool> m_fast_lindblads;        // [k] for m_lindblads
+    std::vector<bool> m_fast_local_lindblads;  // [k] for m_local_lindblads
+    int m_fast_channel_count = 0;
+    double m_fast_rate = 0.0;  // Largest rate bound among fast channels
+    static constexpr double MULTIRATE_SUBSTEP_CFL = 0.1;
+
+    // Strang splitting state: H = V Λ V† (rebuilt when the operator version
+    // changes) and the propagators exp(-iH·h/2), exp(-iH·h) for the last h
+    Eigen::MatrixXcd m_strang_basis;
+    Eigen::VectorXd m_strang_energies;
+    uint64_t m_strang_version = 0;
+    bool m_has_strang_basis = false;
+    RhoMatrix m_strang_half;
+    RhoMatrix m_strang_full;
+    double m_strang_h = -1.0;
+
+    // Symmetry sectors (see set_use_symmetry_sectors)
+    struct SymmetrySector {
+        std::vector<int> states;  // Basis states of the block, ascending
+        Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> heff;  // H_eff block, local terms expanded
+        std::vector<std::shared_ptr<const SharedLindblad>> jumps;        // Nonzero L_k blocks (interned)
+        RhoMatrix rho, drho, temp;  // Block scratch
+    };
+    bool m_use_symmetry_sectors = true;
+    std::vector<SymmetrySector> m_sectors;  // Empty unless the operators split into >= 2 blocks
+    std::vector<int> m_sector_of;           // Basis state → sector index
+    bool m_sector_step = false;             // Set for the duration of a blockwise evolve_matrix call
+    static constexpr int SECTOR_PARALLEL_MIN_DIM = 64;
+
+    // Low-rank mode (see set_low_rank_truncation)
+    int m_low_rank_max_rank = 8;
+    double m_low_rank_tol = 1e-10;
+    lindblad::FactorMatrix m_low_rank_factor;  // evolve_low_rank state and Kraus scratch
+    lindblad::FactorMatrix m_low_rank_work;
 
     // Adaptive MI optimization
-    std::vector<int> m_mi_candidates;    // Pair indices with significant MI
-    static constexpr double MI_SCREEN_THRESHOLD = 0.001;   // Product deviation threshold
+    std::vector<bool> m_mi_candidates;   // Bitset over pair indices with significant MI
+    int m_mi_rescreen_cursor = 0;        // Next pair of the rotating re-screen
+    int m_mi_rescreen_budget = 4;        // Non-candidate pairs re-screened per call
+    double m_mi_rescreen_drift = 0.01;   // Marginal change that re-screens a qubit's pairs
+    // Each qubit's reduced state when its pairs were last screened (by a full
+    // scan or a drift re-screen)
+    std::vector<Eigen::Matrix<std::complex<double>, 2, 2>> m_mi_screen_marginals;
+    // Per-call lists of mi_adaptive_from_states, sized for the engine's qubit
+    // count by finalize() (grown by reserve_mi_scratch for a larger count)
+    struct MiScratch {
+        std::vector<Eigen::Matrix<std::complex<double>, 2, 2>> singles;  // [qubit]
+        std::vector<double> entropies;        // [qubit], exact path
+        std::vector<double> audit_entropies;  // [qubit]
+        std::vector<char> drifted;            // [qubit]: marginal moved past m_mi_rescreen_drift
+        std::vector<char> rescreen;           // [pair]: in this call's rotating window
+        std::vector<int> work_idx, work_i, work_j;
+        std::vector<const Eigen::Matrix<std::complex<double>, 4, 4>*> work_rho;
+    };
+    MiScratch m_mi_scratch;
+    void reserve_mi_scratch(int num_qubits);
+    bool m_mi_force_linear = false;      // Linear entropy regardless of purity
+    int m_mi_audit_interval = 0;         // Calls between screening audits, 0 = off
+    int m_mi_audit_countdown = 0;
+    struct MiScreenStats {
+        uint64_t calls = 0;
+        uint64_t full_scans = 0;
+        uint64_t linear_calls = 0;
+        uint64_t eigen_calls = 0;
+        uint64_t pairs_screened = 0;
+        uint64_t pairs_drift_screened = 0;
+        uint64_t candidates_kept = 0;
+        uint64_t pairs_skipped = 0;
+        uint64_t pairs_reused = 0;
+        uint64_t audits = 0;
+        uint64_t audit_pairs = 0;
+        uint64_t audit_false_negatives = 0;
+    };
+    MiScreenStats m_mi_screen_stats;
+    int m_mi_last_candidates = 0;
+    static constexpr double MI_SCREEN_THRESHOLD = 0.001;   // Product deviation to enter
+    static constexpr double MI_EXIT_THRESHOLD = 0.0004;    // ... and to leave (hysteresis)
     static constexpr double PURITY_HIGH_THRESHOLD = 0.9;   // Use linear approx above this
+    static constexpr double MI_AUDIT_THRESHOLD = 0.01;     // Audited non-candidate MI that counts as missed
+    static constexpr int SUBSYSTEM_MAX_QUBITS = 10;        // compute_subsystem_entropies (1024² eigensolve)
+
+    // Dominant-eigenvector tracking (track_dominant_eigenvector)
+    Eigen::VectorXcd m_tracked_vec;
+    Eigen::VectorXcd m_tracked_work;
+    double m_tracked_value = 0.0;
+    bool m_has_tracked = false;
+    int m_last_eigen_iterations = 0;
+    double m_eigen_tolerance = 1e-8;
+    int m_eigen_max_iterations = 32;
+    static constexpr double EIGEN_GAP_COLLAPSE_RATIO = 0.9;  // Contraction above this → full solve
+    // track_eigen_subspace block (dim × (k + guard), Ritz order) and scratch
+    Eigen::MatrixXcd m_subspace;
+    Eigen::MatrixXcd m_subspace_work;
+    Eigen::VectorXd m_subspace_values;
+    static constexpr int EIGEN_SUBSPACE_GUARD = 2;  // Extra vectors: convergence goes as λ_{k+guard+1}/λ_k
+    int m_mi_parallel_threshold = 28;    // Min pairs for pool dispatch (0 = serial)
+
+    // Observable change tracking (see set_observable_reuse_tolerance).
+    // Mutable: filled by the const observable methods.
+    double m_observable_reuse_tol = 0.0;
+    mutable std::vector<Eigen::Matrix<std::complex<double>, 2, 2>> m_bloch_inputs;  // [qubit]
+    mutable std::vector<double> m_bloch_cache;       // 8 values per qubit
+    mutable std::vector<Eigen::Matrix<std::complex<double>, 4, 4>> m_mi_inputs;     // [pair]
+    mutable std::vector<double> m_mi_cache;          // MI per pair
+    mutable std::vector<bool> m_mi_cache_valid;
+    mutable bool m_mi_cache_linear = false;          // Entropy mode the MI cache holds
+    mutable int m_last_reused_observables = 0;
+
+    // get_profile_stats stages
+    ProfileStage m_profile_evolve;
+    ProfileStage m_profile_reduce;
+    ProfileStage m_profile_bloch;
+    ProfileStage m_profile_mi;
+    ProfileStage m_profile_entanglement;  // Concurrence / log-negativity, kept out of "mi" and COST_MI
+
+    // Evolution helpers
+    void build_liouvillian();
+    void build_heff();  // H_eff = H - (i/2) Σ L†L from the cached L†L
+    void build_heff_form();  // m_heff_form from m_heff (after any change to it)
+    void build_propagator();  // exp(𝓛·dt) for the declared dt, or drop it
+    // Everything finalize() does after H_eff: local folds, scratch, the
+    // Liouvillian (unless already present) and single-precision mirrors
+    void finalize_derived();
+    // Add delta at H_eff(r, c) inside the Liouvillian's drift blocks; false if
+    // the pattern lacks one of the 2·dim entries (caller rebuilds)
+    bool patch_liouvillian_drift(int r, int c, std::complex<double> delta);
+    // Parse [row, col, re, im, ...] into a compressed dim×dim sparse operator
+    bool parse_triplets(const PackedFloat64Array& triplets,
+                        Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor>& out) const;
+    // Sum set_hamiltonian_terms / add_lindblad_terms terms into a compressed
+    // dim×dim sparse operator
+    bool build_operator_terms(const Array& terms,
+                              Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor>& out) const;
+    // One forward-Euler step (with trace cap / diagonal clamp), in place
+    void euler_step(RhoRef rho, double dt);
+    // Drift monitor: counts down to the next sample; record_drift scores a raw
+    // Euler result (before the clamp) and escalates the drift level
+    bool drift_sample_due();
+    void record_drift(RhoConstRef rho, double trace_before);
+    // Same step on the complex<float> mirrors (periodic double resync)
+    void euler_step_single(RhoRef rho, double dt);
+    void build_single_precision_operators();
+    // Integrator dispatch shared by every evolve_* entry point, in place
+    void evolve_matrix(RhoRef rho, float dt, float max_dt);
+    // drho = 𝓛(ρ); both contiguous dim×dim, drho may not alias rho
+    void compute_drho(RhoConstRef rho, RhoRef drho);
+    // Sector detection and block extraction (finalize and operator patches)
+    void build_symmetry_sectors();
+    // True if every cross-sector element of rho is exactly zero
+    bool is_sector_diagonal(RhoConstRef rho) const;
+    void build_rate_matrix();  // W and eligibility for the current operators
+    // Every |ρ_ij| (i ≠ j) <= threshold; stops at the first one above
+    bool coherences_below(RhoConstRef rho, double threshold) const;
+    // Population-mode evolve of covered in substeps of at most h_max
+    void evolve_populations(RhoRef rho, double covered, double h_max);
+    void build_sparse_rho_operators();
+    void build_analytic_form();  // Eligibility and rates for the current operators
+    // Closed-form exp(𝓛t) of an eligible generator, in place
+    void evolve_analytic(RhoRef rho, double t);
+    // One legacy Euler step of h in sparse-ρ mode; false (rho untouched) if
+    // the pruned ρ is too dense or the step samples the drift monitor
+    bool sparse_euler_step(RhoRef rho, double h);
+    // compute_drho block by block; drho's cross-sector elements are zeroed
+    void compute_drho_sectors(RhoConstRef rho, RhoRef drho);
+    // Same 𝓛(X) for arbitrary (non-Hermitian) X, e.g. Krylov basis vectors
+    void compute_drho_general(RhoConstRef x, RhoRef drho);
+    bool parse_local_operator(const PackedFloat64Array& op_packed, const PackedInt32Array& qubits,
+                              LocalOperator& out) const;
+    // parse_local_operator + apply_local_gate on a copy of rho_data
+    PackedFloat64Array apply_packed_gate(const PackedFloat64Array& rho_data, const PackedFloat64Array& op_packed,
+                                         const PackedInt32Array& qubits, const char* caller) const;
+    // Integrate ρ over [0, T] with embedded RK5(4), substeps capped at h_max
+    void integrate_dopri5(RhoRef rho, double T, double h_max);
+    // ρ ← exp(𝓛·T) ρ with Arnoldi expmv, substepping by the Saad error estimate
+    void integrate_krylov(RhoRef rho, double T);
+    // Strang split over [0, T] in equal steps h <= h_max: the coherent part
+    // exactly (cached unitaries), the dissipator by one Euler step per h
+    void integrate_strang(RhoRef rho, double T, double h_max);
+    void update_strang_propagators(double h);
+    // Σ_k L_k ρ L_k† - ½{L_k†L_k, ρ} (global and local jumps, or only the
+    // multi-rate fast ones), out may not alias rho
+    void compute_dissipator(RhoConstRef rho, RhoRef out, bool fast_only = false);
+    void classify_channel_rates();  // Fast/slow split for INTEGRATOR_MULTIRATE
+    // Multi-rate split over [0, T] in equal outer steps h <= h_max
+    void integrate_multirate(RhoRef rho, double T, double h_max);
+    // Kraus map ρ ← K_0 ρ K_0† + h Σ_k L_k ρ L_k† with K_0 = I - i h H_eff, i.e.
+    // the Euler step plus h² H_eff ρ H_eff†: positive by construction, then
+    // rescaled to the incoming trace (no clamping), equal steps h <= h_max
+    void integrate_kraus(RhoRef rho, double T, double h_max);
+    // out = 𝓛 in, both vec(ρ)-sized column-stacked vectors
+    void apply_liouvillian_vec(const std::complex<double>* in, std::complex<double>* out);
 
     // Helper methods
-    Eigen::MatrixXcd unpack_dense(const PackedFloat64Array& data) const;
-    PackedFloat64Array pack_dense(const Eigen::MatrixXcd& mat) const;
+    bool is_packed_valid(const PackedFloat64Array& data) const;  // size == 2·dim²
+    Eigen::Map<const RhoMatrix> map_packed(const PackedFloat64Array& data) const;
+    RhoMatrix unpack_dense(const PackedFloat64Array& data) const;
+    PackedFloat64Array pack_dense(RhoConstRef mat) const;
+    RhoMatrix unpack_hermitian_matrix(const PackedFloat64Array& data) const;
+    PackedFloat64Array pack_hermitian_matrix(RhoConstRef mat) const;
 
     // MI computation helpers (original)
-    Eigen::MatrixXcd partial_trace_single(const Eigen::MatrixXcd& rho, int qubit, int num_qubits) const;
-    Eigen::MatrixXcd partial_trace_complement(const Eigen::MatrixXcd& rho, int qubit_a, int qubit_b, int num_qubits) const;
+    Eigen::MatrixXcd partial_trace_single(RhoConstRef rho, int qubit, int num_qubits) const;
+    Eigen::MatrixXcd partial_trace_complement(RhoConstRef rho, int qubit_a, int qubit_b, int num_qubits) const;
     double von_neumann_entropy(const Eigen::MatrixXcd& reduced_rho) const;
-    double mutual_information(const Eigen::MatrixXcd& rho, int qubit_a, int qubit_b, int num_qubits) const;
+    // Fixed-size closed-form paths (no allocation, no general solver):
+    // quadratic formula for 2×2, cyclic complex Jacobi for Hermitian 4×4
+    double von_neumann_entropy_2x2(const Eigen::Matrix<std::complex<double>, 2, 2>& reduced_rho) const;
+    double von_neumann_entropy_4x4(const Eigen::Matrix<std::complex<double>, 4, 4>& reduced_rho) const;
+    double mutual_information(RhoConstRef rho, int qubit_a, int qubit_b, int num_qubits) const;
+
+    bool use_parallel_mi(int pair_count) const;
+    // Upper-triangular (i, j) for each pair index
+    static void enumerate_pairs(int num_qubits, std::vector<int>& pair_i, std::vector<int>& pair_j);
 
     // Adaptive MI helpers (new - optimized)
     double screen_product_deviation(
@@ -149,12 +1056,49 @@ private:
         const Eigen::Matrix<std::complex<double>, 2, 2>& rho_b) const;
     double trace_rho_squared_2x2(const Eigen::Matrix<std::complex<double>, 2, 2>& rho) const;
     double trace_rho_squared_4x4(const Eigen::Matrix<std::complex<double>, 4, 4>& rho) const;
-    Eigen::Matrix<std::complex<double>, 2, 2> partial_trace_single_2x2(
-        const Eigen::MatrixXcd& rho, int qubit, int num_qubits) const;
-    Eigen::Matrix<std::complex<double>, 4, 4> partial_trace_pair_4x4(
-        const Eigen::MatrixXcd& rho, int qa, int qb, int num_qubits) const;
+
+    // All reduced density matrices from one sweep over ρ, indexed by basis
+    // bit (see lindblad::compute_reduced_states)
+    typedef lindblad::ReducedStates ReducedStates;
+    ReducedStates m_observable_states;  // compute_observables scratch, reused across calls
+    // purity / trace (optional) accumulate Tr(ρ²) and Tr(ρ) in the same row pass
+    void compute_reduced_states(RhoConstRef rho, int num_qubits, bool with_pairs, ReducedStates& out,
+                                double* purity = nullptr, std::complex<double>* trace = nullptr) const;
+    // Observable kernels on precomputed reductions (shared by the single-field
+    // entry points and compute_observables)
+    void bloch_from_states(const ReducedStates& states, int num_qubits, double* out) const;
+    void mi_adaptive_from_states(const ReducedStates& states, int num_qubits, double biome_purity,
+                                 bool force_full_scan, double* out);
+    // Concurrence / log-negativity sections of the mask, every pair
+    static void entanglement_from_states(const ReducedStates& states, int num_qubits, int mask, double* out);
+    // True if the mask has a section read from the 4×4 pair reductions
+    static bool wants_pair_reductions(int num_qubits, int mask) {
+        return num_qubits >= 2 && (mask & (OBSERVABLE_MI | OBSERVABLE_CONCURRENCE | OBSERVABLE_NEGATIVITY));
+    }
+    // Second half of compute_observables_into: writes the mask's sections
+    // from reductions, purity and trace already computed
+    void observables_from_states(const ReducedStates& states, int num_qubits, int mask, double purity,
+                                 std::complex<double> trace, double* out);
+    // Rank r of a packed dim × r factor, -1 unless its size is a multiple of 2·dim
+    int factor_rank(const PackedFloat64Array& factor) const;
+    PackedFloat64Array pack_factor(const lindblad::FactorMatrix& V) const;
+
+    // max |a - b| over elements, with early exit once tol is reached
+    template <int N>
+    static bool within_tolerance(const Eigen::Matrix<std::complex<double>, N, N>& a,
+                                 const Eigen::Matrix<std::complex<double>, N, N>& b, double tol) {
+        for (int k = 0; k < N * N; k++) {
+            if (std::abs(a.data()[k] - b.data()[k]) >= tol) {
+                return false;
+            }
+        }
+        return true;
+    }
 };
 
 }  // namespace godot
 
+VARIANT_ENUM_CAST(godot::QuantumEvolutionEngine::Integrator);
+VARIANT_ENUM_CAST(godot::QuantumEvolutionEngine::ObservableMask);
+
 #endif  // QUANTUM_EVOLUTION_ENGINE_H
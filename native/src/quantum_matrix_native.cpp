@@ -1,16 +1,92 @@
 #include "quantum_matrix_native.h"
+#include "native_thread_pool.h"
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <Eigen/Eigenvalues>
 #include <unsupported/Eigen/MatrixFunctions>
 #include <complex>
 #include <cmath>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 using namespace godot;
 
+namespace {
+
+// Free dense buffers keyed by dim. Capped per dim and in total bytes so a
+// burst of large temporaries does not stay pinned.
+struct BufferPool {
+    static const int MAX_PER_DIM = 32;
+    static const size_t MAX_BYTES = size_t(64) << 20;
+
+    std::mutex mutex;
+    std::unordered_map<int, std::vector<Eigen::MatrixXcd>> free;
+    size_t bytes = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+
+BufferPool& buffer_pool() {
+    static BufferPool instance;
+    return instance;
+}
+
+// One packed matrix viewed in place: rows of interleaved (re, im) pairs
+// have std::complex<double>'s layout
+typedef Eigen::Matrix<std::complex<double>, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> RowMatrixXcd;
+typedef Eigen::Map<const RowMatrixXcd> ConstPackedMap;
+typedef Eigen::Map<RowMatrixXcd> PackedMap;
+
+inline ConstPackedMap packed_view(const double* data, int index, int dim) {
+    return ConstPackedMap(reinterpret_cast<const std::complex<double>*>(data) + (size_t)index * dim * dim, dim, dim);
+}
+
+inline PackedMap packed_view(double* data, int index, int dim) {
+    return PackedMap(reinterpret_cast<std::complex<double>*>(data) + (size_t)index * dim * dim, dim, dim);
+}
+
+template <typename Derived>
+PackedFloat64Array pack_dense(const Eigen::MatrixBase<Derived>& mat) {
+    const int dim = (int)mat.rows();
+    PackedFloat64Array packed;
+    packed.resize(dim * dim * 2);
+    packed_view(packed.ptrw(), 0, dim) = mat;
+    return packed;
+}
+
+// Small dimensions get compile-time-sized kernels: stack storage and fully
+// unrolled products. fn receives std::integral_constant<int, N> with N one
+// of 2, 4, 8, 16, or Eigen::Dynamic for any other dim.
+template <int N>
+using SquareMatrixcd = Eigen::Matrix<std::complex<double>, N, N>;
+
+template <typename Fn>
+auto with_fixed_dim(int dim, Fn&& fn) -> decltype(fn(std::integral_constant<int, Eigen::Dynamic>())) {
+    switch (dim) {
+        case 2:
+            return fn(std::integral_constant<int, 2>());
+        case 4:
+            return fn(std::integral_constant<int, 4>());
+        case 8:
+            return fn(std::integral_constant<int, 8>());
+        case 16:
+            return fn(std::integral_constant<int, 16>());
+        default:
+            return fn(std::integral_constant<int, Eigen::Dynamic>());
+    }
+}
+
+}  // namespace
+
 void QuantumMatrixNative::_bind_methods() {
     ClassDB::bind_method(D_METHOD("from_packed", "data", "dim"), &QuantumMatrixNative::from_packed);
     ClassDB::bind_method(D_METHOD("to_packed"), &QuantumMatrixNative::to_packed);
+    ClassDB::bind_static_method("QuantumMatrixNative", D_METHOD("acquire", "dim"), &QuantumMatrixNative::acquire);
+    ClassDB::bind_method(D_METHOD("release"), &QuantumMatrixNative::release);
+    ClassDB::bind_static_method("QuantumMatrixNative", D_METHOD("get_pool_stats"), &QuantumMatrixNative::get_pool_stats);
+    ClassDB::bind_static_method("QuantumMatrixNative", D_METHOD("clear_pool"), &QuantumMatrixNative::clear_pool);
     ClassDB::bind_method(D_METHOD("get_dimension"), &QuantumMatrixNative::get_dimension);
 
     ClassDB::bind_method(D_METHOD("mul", "other", "dim"), &QuantumMatrixNative::mul);
@@ -24,19 +100,209 @@ void QuantumMatrixNative::_bind_methods() {
     ClassDB::bind_method(D_METHOD("dagger"), &QuantumMatrixNative::dagger);
     ClassDB::bind_method(D_METHOD("commutator", "other", "dim"), &QuantumMatrixNative::commutator);
 
+    ClassDB::bind_method(D_METHOD("mul_into", "other", "out"), &QuantumMatrixNative::mul_into);
+    ClassDB::bind_method(D_METHOD("add_into", "other", "out"), &QuantumMatrixNative::add_into);
+    ClassDB::bind_method(D_METHOD("sub_into", "other", "out"), &QuantumMatrixNative::sub_into);
+    ClassDB::bind_method(D_METHOD("commutator_into", "other", "out"), &QuantumMatrixNative::commutator_into);
+    ClassDB::bind_method(D_METHOD("scale_into", "re", "im", "out"), &QuantumMatrixNative::scale_into);
+    ClassDB::bind_method(D_METHOD("dagger_into", "out"), &QuantumMatrixNative::dagger_into);
+
+    ClassDB::bind_method(D_METHOD("batch_mul", "a", "b", "dim"), &QuantumMatrixNative::batch_mul);
+    ClassDB::bind_method(D_METHOD("batch_dagger", "data", "dim"), &QuantumMatrixNative::batch_dagger);
+    ClassDB::bind_method(D_METHOD("batch_trace", "data", "dim"), &QuantumMatrixNative::batch_trace);
+    ClassDB::bind_method(D_METHOD("batch_eigensystem", "data", "dim"), &QuantumMatrixNative::batch_eigensystem);
+    ClassDB::bind_method(D_METHOD("set_batch_parallel_threshold", "min_matrices"), &QuantumMatrixNative::set_batch_parallel_threshold);
+    ClassDB::bind_method(D_METHOD("get_batch_parallel_threshold"), &QuantumMatrixNative::get_batch_parallel_threshold);
+
+    ClassDB::bind_method(D_METHOD("evaluate", "ops"), &QuantumMatrixNative::evaluate);
+    ClassDB::bind_method(D_METHOD("evaluate_into", "ops", "out"), &QuantumMatrixNative::evaluate_into);
+
+    ClassDB::bind_method(D_METHOD("prepare_propagator"), &QuantumMatrixNative::prepare_propagator);
+    ClassDB::bind_method(D_METHOD("has_propagator"), &QuantumMatrixNative::has_propagator);
+    ClassDB::bind_method(D_METHOD("propagator", "t"), &QuantumMatrixNative::propagator);
+    ClassDB::bind_method(D_METHOD("propagator_into", "t", "out"), &QuantumMatrixNative::propagator_into);
+    ClassDB::bind_method(D_METHOD("set_propagator_cache_size", "size"), &QuantumMatrixNative::set_propagator_cache_size);
+    ClassDB::bind_method(D_METHOD("get_propagator_cache_size"), &QuantumMatrixNative::get_propagator_cache_size);
+
     ClassDB::bind_method(D_METHOD("trace_real"), &QuantumMatrixNative::trace_real);
     ClassDB::bind_method(D_METHOD("trace_imag"), &QuantumMatrixNative::trace_imag);
     ClassDB::bind_method(D_METHOD("is_hermitian", "tolerance"), &QuantumMatrixNative::is_hermitian);
+    ClassDB::bind_method(D_METHOD("get_hermitian"), &QuantumMatrixNative::get_hermitian);
+    ClassDB::bind_method(D_METHOD("set_hermitian", "hermitian"), &QuantumMatrixNative::set_hermitian);
 
     // Sparse matrix support
     ClassDB::bind_method(D_METHOD("from_packed_csr", "csr_data"), &QuantumMatrixNative::from_packed_csr);
+    ClassDB::bind_method(D_METHOD("is_sparse"), &QuantumMatrixNative::is_sparse);
     ClassDB::bind_method(D_METHOD("to_packed_csr", "threshold"), &QuantumMatrixNative::to_packed_csr);
     ClassDB::bind_method(D_METHOD("get_sparsity_ratio", "threshold"), &QuantumMatrixNative::get_sparsity_ratio);
     ClassDB::bind_method(D_METHOD("count_nonzeros", "threshold"), &QuantumMatrixNative::count_nonzeros);
 }
 
 QuantumMatrixNative::QuantumMatrixNative() : m_dim(0) {}
-QuantumMatrixNative::~QuantumMatrixNative() {}
+QuantumMatrixNative::~QuantumMatrixNative() {
+    invalidate_propagator();
+    recycle_buffer(m_matrix);
+}
+
+Eigen::MatrixXcd QuantumMatrixNative::take_buffer(int dim) {
+    if (dim <= 0) {
+        return Eigen::MatrixXcd();
+    }
+    BufferPool& pool = buffer_pool();
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        auto it = pool.free.find(dim);
+        if (it != pool.free.end() && !it->second.empty()) {
+            Eigen::MatrixXcd buffer = std::move(it->second.back());
+            it->second.pop_back();
+            pool.bytes -= (size_t)dim * dim * sizeof(std::complex<double>);
+            pool.hits++;
+            return buffer;
+        }
+        pool.misses++;
+    }
+    return Eigen::MatrixXcd(dim, dim);
+}
+
+void QuantumMatrixNative::recycle_buffer(Eigen::MatrixXcd& buffer) {
+    const int dim = (int)buffer.rows();
+    if (dim == 0 || buffer.cols() != dim) {
+        buffer.resize(0, 0);
+        return;
+    }
+    const size_t size = (size_t)dim * dim * sizeof(std::complex<double>);
+    BufferPool& pool = buffer_pool();
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        std::vector<Eigen::MatrixXcd>& list = pool.free[dim];
+        if ((int)list.size() < BufferPool::MAX_PER_DIM && pool.bytes + size <= BufferPool::MAX_BYTES) {
+            list.push_back(std::move(buffer));
+            pool.bytes += size;
+        }
+    }
+    buffer.resize(0, 0);  // Freed here when the pool is full
+}
+
+Ref<QuantumMatrixNative> QuantumMatrixNative::acquire(int dim) {
+    Ref<QuantumMatrixNative> mat;
+    mat.instantiate();
+    Eigen::MatrixXcd buffer = take_buffer(dim);
+    buffer.setZero();
+    mat->set_dense(std::move(buffer), HERMITIAN_YES);
+    return mat;
+}
+
+void QuantumMatrixNative::release() {
+    set_dense(Eigen::MatrixXcd(), HERMITIAN_YES);
+}
+
+Dictionary QuantumMatrixNative::get_pool_stats() {
+    BufferPool& pool = buffer_pool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    int buffers = 0;
+    for (const auto& entry : pool.free) {
+        buffers += (int)entry.second.size();
+    }
+    Dictionary stats;
+    stats["buffers"] = buffers;
+    stats["bytes"] = (int64_t)pool.bytes;
+    stats["hits"] = (int64_t)pool.hits;
+    stats["misses"] = (int64_t)pool.misses;
+    return stats;
+}
+
+void QuantumMatrixNative::clear_pool() {
+    BufferPool& pool = buffer_pool();
+    std::unordered_map<int, std::vector<Eigen::MatrixXcd>> dropped;
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        dropped.swap(pool.free);
+        pool.bytes = 0;
+    }
+}
+
+const Eigen::MatrixXcd& QuantumMatrixNative::dense() const {
+    if (!m_dense_ready) {
+        m_matrix = take_buffer(m_dim);
+        m_matrix = m_sparse;
+        m_dense_ready = true;
+    }
+    return m_matrix;
+}
+
+void QuantumMatrixNative::set_dense(Eigen::MatrixXcd mat, int hermitian_state) {
+    invalidate_propagator();
+    m_hermitian = hermitian_state;
+    m_dim = (int)mat.rows();
+    recycle_buffer(m_matrix);
+    m_matrix = std::move(mat);
+    m_dense_ready = true;
+    m_sparse = SparseCM();
+    m_is_sparse = false;
+}
+
+void QuantumMatrixNative::set_sparse(SparseCM mat, int hermitian_state) {
+    invalidate_propagator();
+    m_hermitian = hermitian_state;
+    m_dim = (int)mat.rows();
+    m_sparse = std::move(mat);
+    // No explicit zeros: a stored entry is a nonzero (hermitian_defect_sq
+    // relies on it)
+    m_sparse.prune([](Eigen::Index, Eigen::Index, const std::complex<double>& value) {
+        return value != std::complex<double>(0.0, 0.0);
+    });
+    m_sparse.makeCompressed();
+    m_is_sparse = true;
+    recycle_buffer(m_matrix);
+    m_dense_ready = false;
+}
+
+bool QuantumMatrixNative::is_sparse() const {
+    return m_is_sparse;
+}
+
+double QuantumMatrixNative::hermitian_defect_sq(double limit_sq) const {
+    double sum = 0.0;
+    if (m_is_sparse) {
+        for (int i = 0; i < m_dim && sum < limit_sq; i++) {
+            for (SparseCM::InnerIterator it(m_sparse, i); it; ++it) {
+                const int j = (int)it.col();
+                const std::complex<double> mirror = m_sparse.coeff(j, i);
+                // A missing mirror entry stands for both (i, j) and (j, i)
+                const double weight = (mirror == std::complex<double>(0.0, 0.0) && i != j) ? 2.0 : 1.0;
+                sum += weight * std::norm(it.value() - std::conj(mirror));
+            }
+        }
+        return sum;
+    }
+
+    // Each off-diagonal pair contributes twice
+    for (int j = 0; j < m_dim && sum < limit_sq; j++) {
+        sum += 4.0 * m_matrix(j, j).imag() * m_matrix(j, j).imag();
+        for (int i = j + 1; i < m_dim; i++) {
+            sum += 2.0 * std::norm(m_matrix(i, j) - std::conj(m_matrix(j, i)));
+        }
+    }
+    return sum;
+}
+
+bool QuantumMatrixNative::hermitian() const {
+    if (m_hermitian == HERMITIAN_UNKNOWN) {
+        // Relative to the matrix scale, as prepare_propagator used to check
+        const double norm = m_is_sparse ? m_sparse.norm() : m_matrix.norm();
+        const double tolerance = 1e-10 * std::max(1.0, norm);
+        m_hermitian = hermitian_defect_sq(tolerance * tolerance) < tolerance * tolerance ? HERMITIAN_YES : HERMITIAN_NO;
+    }
+    return m_hermitian == HERMITIAN_YES;
+}
+
+bool QuantumMatrixNative::get_hermitian() const {
+    return hermitian();
+}
+
+void QuantumMatrixNative::set_hermitian(bool value) {
+    m_hermitian = value ? HERMITIAN_YES : HERMITIAN_NO;
+}
 
 PackedFloat64Array QuantumMatrixNative::pack_matrix(const Eigen::MatrixXcd& mat, int dim) const {
     PackedFloat64Array packed;
@@ -53,37 +319,55 @@ PackedFloat64Array QuantumMatrixNative::pack_matrix(const Eigen::MatrixXcd& mat,
     return packed;
 }
 
+PackedFloat64Array QuantumMatrixNative::pack_sparse(const SparseCM& mat) const {
+    const int dim = (int)mat.rows();
+    PackedFloat64Array packed;
+    packed.resize(dim * dim * 2);
+    packed.fill(0.0);
+    double* ptr = packed.ptrw();
+
+    for (int i = 0; i < dim; i++) {
+        for (SparseCM::InnerIterator it(mat, i); it; ++it) {
+            int idx = (i * dim + (int)it.col()) * 2;
+            ptr[idx] = it.value().real();
+            ptr[idx + 1] = it.value().imag();
+        }
+    }
+    return packed;
+}
+
 void QuantumMatrixNative::from_packed(const PackedFloat64Array& data, int dim) {
     // Validate input size: need dim*dim*2 elements (real + imag for each element)
     int required_size = dim * dim * 2;
     if ((int)data.size() < required_size) {
         // Size mismatch - avoid buffer overflow by returning early
         // This prevents segfault when array is too small
-        m_dim = 0;
-        m_matrix.resize(0, 0);
+        set_dense(Eigen::MatrixXcd());
         return;
     }
 
-    m_dim = dim;
-    m_matrix.resize(dim, dim);
-
     const double* ptr = data.ptr();
     if (ptr == nullptr) {
         // Null pointer - bail out safely
-        m_dim = 0;
-        m_matrix.resize(0, 0);
+        set_dense(Eigen::MatrixXcd());
         return;
     }
 
+    Eigen::MatrixXcd mat = take_buffer(dim);
     for (int i = 0; i < dim; i++) {
         for (int j = 0; j < dim; j++) {
             int idx = (i * dim + j) * 2;
-            m_matrix(i, j) = std::complex<double>(ptr[idx], ptr[idx + 1]);
+            mat(i, j) = std::complex<double>(ptr[idx], ptr[idx + 1]);
         }
     }
+    set_dense(std::move(mat));
+    hermitian();  // Measured once at load, then sticky
 }
 
 PackedFloat64Array QuantumMatrixNative::to_packed() const {
+    if (m_is_sparse) {
+        return pack_sparse(m_sparse);
+    }
     return pack_matrix(m_matrix, m_dim);
 }
 
@@ -92,6 +376,17 @@ int QuantumMatrixNative::get_dimension() const {
 }
 
 PackedFloat64Array QuantumMatrixNative::mul(const PackedFloat64Array& other_data, int dim) const {
+    if (!m_is_sparse && dim == m_dim && (int)other_data.size() >= dim * dim * 2) {
+        // Read other in place; fixed-size product for small dims
+        const double* other_ptr = other_data.ptr();
+        return with_fixed_dim(m_dim, [&](auto n) {
+            typedef SquareMatrixcd<decltype(n)::value> Matrix;
+            const Matrix& lhs = m_matrix;  // Stack copy when fixed-size
+            const Matrix result = lhs * packed_view(other_ptr, 0, m_dim);
+            return pack_dense(result);
+        });
+    }
+
     // Unpack other matrix
     Eigen::MatrixXcd other(dim, dim);
     const double* ptr = other_data.ptr();
@@ -102,8 +397,9 @@ PackedFloat64Array QuantumMatrixNative::mul(const PackedFloat64Array& other_data
         }
     }
 
-    // Eigen matrix multiplication (SIMD optimized)
-    Eigen::MatrixXcd result = m_matrix * other;
+    // Eigen matrix multiplication (SIMD optimized; sparse × dense when
+    // this matrix is sparse)
+    Eigen::MatrixXcd result = m_is_sparse ? Eigen::MatrixXcd(m_sparse * other) : Eigen::MatrixXcd(m_matrix * other);
 
     return pack_matrix(result, dim);
 }
@@ -111,33 +407,53 @@ PackedFloat64Array QuantumMatrixNative::mul(const PackedFloat64Array& other_data
 PackedFloat64Array QuantumMatrixNative::expm() const {
     // Matrix exponential using Eigen's unsupported module
     // Uses Pade approximation with scaling-squaring internally
-    Eigen::MatrixXcd result = m_matrix.exp();
-    return pack_matrix(result, m_dim);
+    return with_fixed_dim(m_dim, [&](auto n) {
+        typedef SquareMatrixcd<decltype(n)::value> Matrix;
+        const Matrix& mat = dense();
+        if (hermitian()) {
+            // exp(H) = V·diag(e^λ)·V†: one eigensolve instead of Padé
+            // scaling-and-squaring, and exactly Hermitian
+            Eigen::SelfAdjointEigenSolver<Matrix> solver(mat);
+            const Matrix scaled = solver.eigenvectors() * solver.eigenvalues().array().exp().matrix().asDiagonal();
+            const Matrix result = scaled * solver.eigenvectors().adjoint();
+            return pack_dense(result);
+        }
+        const Matrix result = mat.exp();
+        return pack_dense(result);
+    });
 }
 
 PackedFloat64Array QuantumMatrixNative::inverse() const {
-    // LU decomposition based inverse
-    Eigen::MatrixXcd result = m_matrix.inverse();
-    return pack_matrix(result, m_dim);
+    // LU decomposition based inverse (closed form for 2×2 and 4×4)
+    return with_fixed_dim(m_dim, [&](auto n) {
+        typedef SquareMatrixcd<decltype(n)::value> Matrix;
+        const Matrix& mat = dense();
+        const Matrix result = mat.inverse();
+        return pack_dense(result);
+    });
 }
 
 Dictionary QuantumMatrixNative::eigensystem() const {
     // Use SelfAdjointEigenSolver for Hermitian matrices (faster and more stable)
-    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> solver(m_matrix);
+    return with_fixed_dim(m_dim, [&](auto n) {
+        typedef SquareMatrixcd<decltype(n)::value> Matrix;
+        const Matrix& mat = dense();
+        Eigen::SelfAdjointEigenSolver<Matrix> solver(mat);
 
-    // Eigenvalues (real for Hermitian)
-    Array eigenvalues;
-    for (int i = 0; i < m_dim; i++) {
-        eigenvalues.push_back(solver.eigenvalues()(i));
-    }
+        // Eigenvalues (real for Hermitian)
+        Array eigenvalues;
+        for (int i = 0; i < m_dim; i++) {
+            eigenvalues.push_back(solver.eigenvalues()(i));
+        }
 
-    // Eigenvectors as packed array
-    PackedFloat64Array packed_vecs = pack_matrix(solver.eigenvectors(), m_dim);
+        // Eigenvectors as packed array
+        PackedFloat64Array packed_vecs = pack_dense(solver.eigenvectors());
 
-    Dictionary result;
-    result["eigenvalues"] = eigenvalues;
-    result["eigenvectors"] = packed_vecs;
-    return result;
+        Dictionary result;
+        result["eigenvalues"] = eigenvalues;
+        result["eigenvectors"] = packed_vecs;
+        return result;
+    });
 }
 
 PackedFloat64Array QuantumMatrixNative::add(const PackedFloat64Array& other_data, int dim) const {
@@ -150,7 +466,12 @@ PackedFloat64Array QuantumMatrixNative::add(const PackedFloat64Array& other_data
         }
     }
 
-    Eigen::MatrixXcd result = m_matrix + other;
+    Eigen::MatrixXcd result = other;
+    if (m_is_sparse) {
+        result += m_sparse;
+    } else {
+        result += m_matrix;
+    }
     return pack_matrix(result, dim);
 }
 
@@ -164,17 +485,28 @@ PackedFloat64Array QuantumMatrixNative::sub(const PackedFloat64Array& other_data
         }
     }
 
-    Eigen::MatrixXcd result = m_matrix - other;
+    Eigen::MatrixXcd result = -other;
+    if (m_is_sparse) {
+        result += m_sparse;
+    } else {
+        result += m_matrix;
+    }
     return pack_matrix(result, dim);
 }
 
 PackedFloat64Array QuantumMatrixNative::scale(double re, double im) const {
     std::complex<double> scalar(re, im);
+    if (m_is_sparse) {
+        return pack_sparse(SparseCM(m_sparse * scalar));
+    }
     Eigen::MatrixXcd result = m_matrix * scalar;
     return pack_matrix(result, m_dim);
 }
 
 PackedFloat64Array QuantumMatrixNative::dagger() const {
+    if (m_is_sparse) {
+        return pack_sparse(SparseCM(m_sparse.adjoint()));
+    }
     Eigen::MatrixXcd result = m_matrix.adjoint();
     return pack_matrix(result, m_dim);
 }
@@ -190,20 +522,532 @@ PackedFloat64Array QuantumMatrixNative::commutator(const PackedFloat64Array& oth
     }
 
     // [A, B] = AB - BA
-    Eigen::MatrixXcd result = m_matrix * other - other * m_matrix;
+    Eigen::MatrixXcd result;
+    if (m_is_sparse) {
+        result = m_sparse * other;
+        result -= other * m_sparse;
+    } else {
+        result = m_matrix * other - other * m_matrix;
+    }
     return pack_matrix(result, dim);
 }
 
+// Handle-to-handle operations (no packing)
+
+bool QuantumMatrixNative::check_handle(const Ref<QuantumMatrixNative>& mat, const char* method, bool match_dim) const {
+    if (mat.is_null()) {
+        UtilityFunctions::push_warning("QuantumMatrixNative: null matrix passed to ", method);
+        return false;
+    }
+    if (match_dim && mat->m_dim != m_dim) {
+        UtilityFunctions::push_warning("QuantumMatrixNative: dimension mismatch in ", method, " (",
+                                       m_dim, " vs ", mat->m_dim, ")");
+        return false;
+    }
+    return true;
+}
+
+void QuantumMatrixNative::mul_into(const Ref<QuantumMatrixNative>& other, const Ref<QuantumMatrixNative>& out) const {
+    if (!check_handle(other, "mul_into", true) || !check_handle(out, "mul_into", false)) {
+        return;
+    }
+    // Results are fully evaluated (into a fresh pooled buffer) before set_*,
+    // so out may alias an operand
+    if (m_is_sparse && other->m_is_sparse) {
+        out->set_sparse(SparseCM(m_sparse * other->m_sparse));
+    } else if (m_is_sparse) {
+        out->store_dense(m_sparse * other->m_matrix);
+    } else if (other->m_is_sparse) {
+        out->store_dense(m_matrix * other->m_sparse);
+    } else {
+        out->store_dense(m_matrix * other->m_matrix);
+    }
+}
+
+void QuantumMatrixNative::add_into(const Ref<QuantumMatrixNative>& other, const Ref<QuantumMatrixNative>& out) const {
+    if (!check_handle(other, "add_into", true) || !check_handle(out, "add_into", false)) {
+        return;
+    }
+    // Sums of Hermitian matrices stay Hermitian
+    const int hermitian_state = (m_hermitian == HERMITIAN_YES && other->m_hermitian == HERMITIAN_YES) ? HERMITIAN_YES : HERMITIAN_UNKNOWN;
+    if (m_is_sparse && other->m_is_sparse) {
+        out->set_sparse(SparseCM(m_sparse + other->m_sparse), hermitian_state);
+    } else if (m_is_sparse) {
+        Eigen::MatrixXcd result = take_buffer(m_dim);
+        result = other->m_matrix;
+        result += m_sparse;
+        out->set_dense(std::move(result), hermitian_state);
+    } else if (other->m_is_sparse) {
+        Eigen::MatrixXcd result = take_buffer(m_dim);
+        result = m_matrix;
+        result += other->m_sparse;
+        out->set_dense(std::move(result), hermitian_state);
+    } else {
+        out->store_dense(m_matrix + other->m_matrix, hermitian_state);
+    }
+}
+
+void QuantumMatrixNative::sub_into(const Ref<QuantumMatrixNative>& other, const Ref<QuantumMatrixNative>& out) const {
+    if (!check_handle(other, "sub_into", true) || !check_handle(out, "sub_into", false)) {
+        return;
+    }
+    // Sums of Hermitian matrices stay Hermitian
+    const int hermitian_state = (m_hermitian == HERMITIAN_YES && other->m_hermitian == HERMITIAN_YES) ? HERMITIAN_YES : HERMITIAN_UNKNOWN;
+    if (m_is_sparse && other->m_is_sparse) {
+        out->set_sparse(SparseCM(m_sparse - other->m_sparse), hermitian_state);
+    } else if (m_is_sparse) {
+        Eigen::MatrixXcd result = take_buffer(m_dim);
+        result = -other->m_matrix;
+        result += m_sparse;
+        out->set_dense(std::move(result), hermitian_state);
+    } else if (other->m_is_sparse) {
+        Eigen::MatrixXcd result = take_buffer(m_dim);
+        result = m_matrix;
+        result -= other->m_sparse;
+        out->set_dense(std::move(result), hermitian_state);
+    } else {
+        out->store_dense(m_matrix - other->m_matrix, hermitian_state);
+    }
+}
+
+void QuantumMatrixNative::commutator_into(const Ref<QuantumMatrixNative>& other, const Ref<QuantumMatrixNative>& out) const {
+    if (!check_handle(other, "commutator_into", true) || !check_handle(out, "commutator_into", false)) {
+        return;
+    }
+    // [A, B] = AB - BA
+    if (m_is_sparse && other->m_is_sparse) {
+        out->set_sparse(SparseCM(SparseCM(m_sparse * other->m_sparse) - SparseCM(other->m_sparse * m_sparse)));
+    } else if (m_is_sparse) {
+        Eigen::MatrixXcd result = take_buffer(m_dim);
+        result.noalias() = m_sparse * other->m_matrix;
+        result.noalias() -= other->m_matrix * m_sparse;
+        out->set_dense(std::move(result));
+    } else if (other->m_is_sparse) {
+        Eigen::MatrixXcd result = take_buffer(m_dim);
+        result.noalias() = m_matrix * other->m_sparse;
+        result.noalias() -= other->m_sparse * m_matrix;
+        out->set_dense(std::move(result));
+    } else {
+        Eigen::MatrixXcd result = take_buffer(m_dim);
+        result.noalias() = m_matrix * other->m_matrix;
+        result.noalias() -= other->m_matrix * m_matrix;
+        out->set_dense(std::move(result));
+    }
+}
+
+void QuantumMatrixNative::scale_into(double re, double im, const Ref<QuantumMatrixNative>& out) const {
+    if (!check_handle(out, "scale_into", false)) {
+        return;
+    }
+    const std::complex<double> scalar(re, im);
+    // Real multiples of a Hermitian matrix stay Hermitian
+    const int hermitian_state = (im == 0.0 && m_hermitian == HERMITIAN_YES) ? HERMITIAN_YES : HERMITIAN_UNKNOWN;
+    if (m_is_sparse) {
+        out->set_sparse(SparseCM(m_sparse * scalar), hermitian_state);
+    } else {
+        out->store_dense(m_matrix * scalar, hermitian_state);
+    }
+}
+
+void QuantumMatrixNative::dagger_into(const Ref<QuantumMatrixNative>& out) const {
+    if (!check_handle(out, "dagger_into", false)) {
+        return;
+    }
+    // X† is Hermitian exactly when X is
+    const int hermitian_state = m_hermitian;
+    if (m_is_sparse) {
+        out->set_sparse(SparseCM(m_sparse.adjoint()), hermitian_state);
+    } else {
+        out->store_dense(m_matrix.adjoint(), hermitian_state);
+    }
+}
+
+// Batched operations
+
+int QuantumMatrixNative::batch_count(const PackedFloat64Array& data, int dim, const char* method) const {
+    const int64_t stride = (int64_t)dim * dim * 2;
+    if (dim <= 0 || data.size() % stride != 0) {
+        UtilityFunctions::push_warning("QuantumMatrixNative: ", method, " buffer of ", data.size(),
+                                       " values is not a whole number of ", dim, "x", dim, " matrices");
+        return 0;
+    }
+    return (int)(data.size() / stride);
+}
+
+void QuantumMatrixNative::run_batch(int count, const std::function<void(int, int)>& fn) const {
+    if (count >= m_batch_parallel_threshold && count > 1) {
+        NativeThreadPool::shared().parallel_for(0, count, 0, fn);
+    } else {
+        fn(0, count);
+    }
+}
+
+PackedFloat64Array QuantumMatrixNative::batch_mul(const PackedFloat64Array& a, const PackedFloat64Array& b, int dim) const {
+    PackedFloat64Array result;
+    const int count = batch_count(a, dim, "batch_mul");
+    const int count_b = batch_count(b, dim, "batch_mul");
+    if (count == 0 || (count_b != count && count_b != 1)) {
+        if (count > 0 && count_b > 0) {
+            UtilityFunctions::push_warning("QuantumMatrixNative: batch_mul needs one b or one per a (",
+                                           count, " vs ", count_b, ")");
+        }
+        return result;
+    }
+
+    result.resize(a.size());
+    const double* a_data = a.ptr();
+    const double* b_data = b.ptr();
+    double* out_data = result.ptrw();
+    run_batch(count, [&](int begin, int end) {
+        for (int k = begin; k < end; k++) {
+            packed_view(out_data, k, dim).noalias() =
+                packed_view(a_data, k, dim) * packed_view(b_data, count_b == 1 ? 0 : k, dim);
+        }
+    });
+    return result;
+}
+
+PackedFloat64Array QuantumMatrixNative::batch_dagger(const PackedFloat64Array& data, int dim) const {
+    PackedFloat64Array result;
+    const int count = batch_count(data, dim, "batch_dagger");
+    if (count == 0) {
+        return result;
+    }
+
+    result.resize(data.size());
+    const double* in_data = data.ptr();
+    double* out_data = result.ptrw();
+    run_batch(count, [&](int begin, int end) {
+        for (int k = begin; k < end; k++) {
+            packed_view(out_data, k, dim) = packed_view(in_data, k, dim).adjoint();
+        }
+    });
+    return result;
+}
+
+PackedFloat64Array QuantumMatrixNative::batch_trace(const PackedFloat64Array& data, int dim) const {
+    PackedFloat64Array result;
+    const int count = batch_count(data, dim, "batch_trace");
+    if (count == 0) {
+        return result;
+    }
+
+    // O(dim) per matrix: never worth the pool
+    result.resize(count * 2);
+    const double* in_data = data.ptr();
+    double* out_data = result.ptrw();
+    for (int k = 0; k < count; k++) {
+        const std::complex<double> trace = packed_view(in_data, k, dim).trace();
+        out_data[2 * k] = trace.real();
+        out_data[2 * k + 1] = trace.imag();
+    }
+    return result;
+}
+
+Dictionary QuantumMatrixNative::batch_eigensystem(const PackedFloat64Array& data, int dim) const {
+    Dictionary result;
+    const int count = batch_count(data, dim, "batch_eigensystem");
+    if (count == 0) {
+        return result;
+    }
+
+    PackedFloat64Array eigenvalues;
+    PackedFloat64Array eigenvectors;
+    eigenvalues.resize(count * dim);
+    eigenvectors.resize(data.size());
+    const double* in_data = data.ptr();
+    double* values_data = eigenvalues.ptrw();
+    double* vectors_data = eigenvectors.ptrw();
+    run_batch(count, [&](int begin, int end) {
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> solver(dim);
+        Eigen::MatrixXcd mat(dim, dim);
+        for (int k = begin; k < end; k++) {
+            mat = packed_view(in_data, k, dim);
+            solver.compute(mat);
+            Eigen::Map<Eigen::VectorXd>(values_data + (size_t)k * dim, dim) = solver.eigenvalues();
+            packed_view(vectors_data, k, dim) = solver.eigenvectors();
+        }
+    });
+
+    result["eigenvalues"] = eigenvalues;
+    result["eigenvectors"] = eigenvectors;
+    return result;
+}
+
+void QuantumMatrixNative::set_batch_parallel_threshold(int min_matrices) {
+    m_batch_parallel_threshold = std::max(1, min_matrices);
+}
+
+int QuantumMatrixNative::get_batch_parallel_threshold() const {
+    return m_batch_parallel_threshold;
+}
+
+// Fused op-list evaluation
+
+bool QuantumMatrixNative::resolve_operand(const Variant& value, const String& op, Operand& r_operand) const {
+    if (value.get_type() == Variant::PACKED_FLOAT64_ARRAY) {
+        const PackedFloat64Array data = value;
+        if ((int)data.size() < m_dim * m_dim * 2) {
+            UtilityFunctions::push_warning("QuantumMatrixNative: evaluate '", op, "' operand is too small for dim ", m_dim);
+            return false;
+        }
+        const double* ptr = data.ptr();
+        r_operand.owned.resize(m_dim, m_dim);
+        for (int i = 0; i < m_dim; i++) {
+            for (int j = 0; j < m_dim; j++) {
+                int idx = (i * m_dim + j) * 2;
+                r_operand.owned(i, j) = std::complex<double>(ptr[idx], ptr[idx + 1]);
+            }
+        }
+        r_operand.dense = &r_operand.owned;
+        return true;
+    }
+
+    const QuantumMatrixNative* other = Object::cast_to<QuantumMatrixNative>(value);
+    if (other == nullptr) {
+        UtilityFunctions::push_warning("QuantumMatrixNative: evaluate '", op, "' needs a QuantumMatrixNative or packed array");
+        return false;
+    }
+    if (other->m_dim != m_dim) {
+        UtilityFunctions::push_warning("QuantumMatrixNative: dimension mismatch in evaluate '", op, "' (",
+                                       m_dim, " vs ", other->m_dim, ")");
+        return false;
+    }
+    if (other->m_is_sparse) {
+        r_operand.sparse = &other->m_sparse;
+    } else {
+        r_operand.dense = &other->m_matrix;
+    }
+    return true;
+}
+
+bool QuantumMatrixNative::evaluate_ops(const Array& ops, Eigen::MatrixXcd& acc) const {
+    typedef std::complex<double> Complex;
+    const Complex one(1.0, 0.0);
+
+    // The running value is alpha·acc + Σ coef·operand; the scale and the
+    // pending terms are only applied when a product or the end needs acc
+    acc = m_is_sparse ? Eigen::MatrixXcd(m_sparse) : m_matrix;
+    Complex alpha = one;
+    std::vector<std::pair<Complex, const Operand*>> terms;
+    std::deque<Operand> operands;  // Stable addresses for pending terms
+    Eigen::MatrixXcd product;
+
+    auto flush = [&]() {
+        if (terms.empty()) {
+            return;
+        }
+        // One pass per column: every dense term is added while the column
+        // is in cache
+        for (int j = 0; j < m_dim; j++) {
+            auto column = acc.col(j);
+            if (alpha != one) {
+                column *= alpha;
+            }
+            for (const std::pair<Complex, const Operand*>& term : terms) {
+                if (term.second->dense) {
+                    column += term.first * term.second->dense->col(j);
+                }
+            }
+        }
+        for (const std::pair<Complex, const Operand*>& term : terms) {
+            if (term.second->sparse) {
+                acc += term.first * *term.second->sparse;
+            }
+        }
+        alpha = one;
+        terms.clear();
+    };
+
+    for (int i = 0; i < ops.size(); i++) {
+        const Array step = ops[i];
+        const String op = step.is_empty() ? String() : String(step[0]);
+
+        if (op == "scale") {
+            if (step.size() < 2) {
+                UtilityFunctions::push_warning("QuantumMatrixNative: evaluate 'scale' needs re[, im]");
+                return false;
+            }
+            const Complex scalar((double)step[1], step.size() > 2 ? (double)step[2] : 0.0);
+            alpha *= scalar;
+            for (std::pair<Complex, const Operand*>& term : terms) {
+                term.first *= scalar;
+            }
+            continue;
+        }
+        if (op == "dagger") {
+            // (alpha·X)† = conj(alpha)·X†
+            flush();
+            acc.adjointInPlace();
+            alpha = std::conj(alpha);
+            continue;
+        }
+        if (op != "add" && op != "sub" && op != "mul" && op != "comm") {
+            UtilityFunctions::push_warning("QuantumMatrixNative: evaluate has unknown op '", op, "'");
+            return false;
+        }
+        if (step.size() < 2) {
+            UtilityFunctions::push_warning("QuantumMatrixNative: evaluate '", op, "' needs an operand");
+            return false;
+        }
+        operands.emplace_back();
+        if (!resolve_operand(step[1], op, operands.back())) {
+            return false;
+        }
+        const Operand& operand = operands.back();
+
+        if (op == "add" || op == "sub") {
+            terms.emplace_back(op == "add" ? one : -one, &operand);
+            continue;
+        }
+
+        // Products: the pending scale rides along as the GEMM's alpha
+        flush();
+        if (operand.dense) {
+            const Eigen::MatrixXcd& m = *operand.dense;
+            product.noalias() = alpha * acc * m;
+            if (op == "comm") {
+                product.noalias() -= alpha * m * acc;
+            }
+        } else {
+            const SparseCM& m = *operand.sparse;
+            product.noalias() = acc * m;
+            if (op == "comm") {
+                product.noalias() -= m * acc;
+            }
+            if (alpha != one) {
+                product *= alpha;
+            }
+        }
+        acc.swap(product);
+        alpha = one;
+    }
+
+    flush();
+    if (alpha != one) {
+        acc *= alpha;
+    }
+    return true;
+}
+
+PackedFloat64Array QuantumMatrixNative::evaluate(const Array& ops) const {
+    Eigen::MatrixXcd result;
+    if (!evaluate_ops(ops, result)) {
+        return PackedFloat64Array();
+    }
+    return pack_matrix(result, m_dim);
+}
+
+void QuantumMatrixNative::evaluate_into(const Array& ops, const Ref<QuantumMatrixNative>& out) const {
+    if (!check_handle(out, "evaluate_into", false)) {
+        return;
+    }
+    Eigen::MatrixXcd result;
+    if (evaluate_ops(ops, result)) {
+        out->set_dense(std::move(result));
+    }
+}
+
+// Cached unitary propagators
+
+void QuantumMatrixNative::invalidate_propagator() {
+    m_propagator_ready = false;
+    for (auto& entry : m_propagator_cache) {
+        recycle_buffer(entry.second);
+    }
+    m_propagator_cache.clear();
+}
+
+bool QuantumMatrixNative::prepare_propagator() {
+    invalidate_propagator();
+    if (m_dim == 0 || !hermitian()) {
+        UtilityFunctions::push_warning("QuantumMatrixNative: prepare_propagator needs a Hermitian matrix");
+        return false;
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> solver(dense());
+    if (solver.info() != Eigen::Success) {
+        UtilityFunctions::push_warning("QuantumMatrixNative: prepare_propagator eigendecomposition failed");
+        return false;
+    }
+    m_eigenvalues = solver.eigenvalues();
+    m_eigenvectors = solver.eigenvectors();
+    m_propagator_ready = true;
+    return true;
+}
+
+bool QuantumMatrixNative::has_propagator() const {
+    return m_propagator_ready;
+}
+
+const Eigen::MatrixXcd& QuantumMatrixNative::propagator_matrix(double t) {
+    for (auto it = m_propagator_cache.begin(); it != m_propagator_cache.end(); ++it) {
+        if (it->first == t) {
+            m_propagator_cache.splice(m_propagator_cache.begin(), m_propagator_cache, it);
+            return m_propagator_cache.front().second;
+        }
+    }
+
+    // U(t) = V·diag(e^{-iλt})·V†: scale V's columns, then one product
+    Eigen::VectorXcd phases(m_dim);
+    for (int k = 0; k < m_dim; k++) {
+        phases(k) = std::polar(1.0, -m_eigenvalues(k) * t);
+    }
+    const Eigen::MatrixXcd scaled = m_eigenvectors * phases.asDiagonal();
+    Eigen::MatrixXcd unitary = take_buffer(m_dim);
+    unitary.noalias() = scaled * m_eigenvectors.adjoint();
+
+    if ((int)m_propagator_cache.size() >= m_propagator_cache_size) {
+        recycle_buffer(m_propagator_cache.back().second);
+        m_propagator_cache.pop_back();
+    }
+    m_propagator_cache.emplace_front(t, std::move(unitary));
+    return m_propagator_cache.front().second;
+}
+
+PackedFloat64Array QuantumMatrixNative::propagator(double t) {
+    if (!m_propagator_ready) {
+        UtilityFunctions::push_warning("QuantumMatrixNative: propagator called before prepare_propagator");
+        return PackedFloat64Array();
+    }
+    return pack_matrix(propagator_matrix(t), m_dim);
+}
+
+void QuantumMatrixNative::propagator_into(double t, const Ref<QuantumMatrixNative>& out) {
+    if (!m_propagator_ready) {
+        UtilityFunctions::push_warning("QuantumMatrixNative: propagator_into called before prepare_propagator");
+        return;
+    }
+    if (!check_handle(out, "propagator_into", false)) {
+        return;
+    }
+    // Copy before invalidating: out may be this matrix (H replaced by U)
+    Eigen::MatrixXcd unitary = take_buffer(m_dim);
+    unitary = propagator_matrix(t);
+    out->set_dense(std::move(unitary));
+}
+
+void QuantumMatrixNative::set_propagator_cache_size(int size) {
+    m_propagator_cache_size = std::max(1, size);  // The newest U(t) is always kept
+    while ((int)m_propagator_cache.size() > m_propagator_cache_size) {
+        recycle_buffer(m_propagator_cache.back().second);
+        m_propagator_cache.pop_back();
+    }
+}
+
+int QuantumMatrixNative::get_propagator_cache_size() const {
+    return m_propagator_cache_size;
+}
+
 double QuantumMatrixNative::trace_real() const {
-    return m_matrix.trace().real();
+    return (m_is_sparse ? m_sparse.diagonal().sum() : m_matrix.trace()).real();
 }
 
 double QuantumMatrixNative::trace_imag() const {
-    return m_matrix.trace().imag();
+    return (m_is_sparse ? m_sparse.diagonal().sum() : m_matrix.trace()).imag();
 }
 
 bool QuantumMatrixNative::is_hermitian(double tolerance) const {
-    return (m_matrix - m_matrix.adjoint()).norm() < tolerance;
+    return hermitian_defect_sq(tolerance * tolerance) < tolerance * tolerance;
 }
 
 // Sparse matrix support (CSR format)
@@ -217,36 +1061,34 @@ void QuantumMatrixNative::from_packed_csr(const Dictionary& csr_data) {
     PackedFloat64Array values_real = csr_data["values_real"];
     PackedFloat64Array values_imag = csr_data["values_imag"];
 
-    // Initialize matrix with zeros
-    m_dim = dim;
-    m_matrix = Eigen::MatrixXcd::Zero(dim, dim);
-
-    // Fill from CSR data
+    // Fill sparse storage directly from CSR data (no dense intermediate)
     const int32_t* row_ptr_data = row_ptr.ptr();
     const int32_t* col_idx_data = col_idx.ptr();
     const double* real_data = values_real.ptr();
     const double* imag_data = values_imag.ptr();
 
+    std::vector<Eigen::Triplet<std::complex<double>>> triplets;
+    triplets.reserve(nnz);
     for (int i = 0; i < dim; i++) {
         int row_start = row_ptr_data[i];
         int row_end = row_ptr_data[i + 1];
         for (int k = row_start; k < row_end; k++) {
             int j = col_idx_data[k];
-            m_matrix(i, j) = std::complex<double>(real_data[k], imag_data[k]);
+            triplets.emplace_back(i, j, std::complex<double>(real_data[k], imag_data[k]));
         }
     }
+
+    SparseCM mat(dim, dim);
+    // Repeated (i, j) entries keep the last value, as the dense fill did
+    mat.setFromTriplets(triplets.begin(), triplets.end(),
+                        [](const std::complex<double>&, const std::complex<double>& b) { return b; });
+    set_sparse(std::move(mat));
+    hermitian();  // Measured once at load, then sticky
 }
 
 Dictionary QuantumMatrixNative::to_packed_csr(double threshold) const {
     // Count non-zeros first
-    int nnz = 0;
-    for (int i = 0; i < m_dim; i++) {
-        for (int j = 0; j < m_dim; j++) {
-            if (std::abs(m_matrix(i, j)) > threshold) {
-                nnz++;
-            }
-        }
-    }
+    int nnz = count_nonzeros(threshold);
 
     // Allocate arrays
     PackedInt32Array row_ptr;
@@ -268,6 +1110,17 @@ Dictionary QuantumMatrixNative::to_packed_csr(double threshold) const {
     int current_nnz = 0;
     for (int i = 0; i < m_dim; i++) {
         row_ptr_data[i] = current_nnz;
+        if (m_is_sparse) {
+            for (SparseCM::InnerIterator it(m_sparse, i); it; ++it) {
+                if (std::abs(it.value()) > threshold) {
+                    col_idx_data[current_nnz] = (int)it.col();
+                    real_data[current_nnz] = it.value().real();
+                    imag_data[current_nnz] = it.value().imag();
+                    current_nnz++;
+                }
+            }
+            continue;
+        }
         for (int j = 0; j < m_dim; j++) {
             if (std::abs(m_matrix(i, j)) > threshold) {
                 col_idx_data[current_nnz] = j;
@@ -299,6 +1152,14 @@ double QuantumMatrixNative::get_sparsity_ratio(double threshold) const {
 
 int QuantumMatrixNative::count_nonzeros(double threshold) const {
     int count = 0;
+    if (m_is_sparse) {
+        for (int k = 0; k < m_sparse.nonZeros(); k++) {
+            if (std::abs(m_sparse.valuePtr()[k]) > threshold) {
+                count++;
+            }
+        }
+        return count;
+    }
     for (int i = 0; i < m_dim; i++) {
         for (int j = 0; j < m_dim; j++) {
             if (std::abs(m_matrix(i, j)) > threshold) {
@@ -6,19 +6,101 @@
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/array.hpp>
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 #include <complex>
+#include <deque>
+#include <functional>
+#include <list>
+#include <utility>
 
 namespace godot {
 
 class QuantumMatrixNative : public RefCounted {
     GDCLASS(QuantumMatrixNative, RefCounted)
 
+public:
+    typedef Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> SparseCM;
+
 private:
-    Eigen::MatrixXcd m_matrix;
+    // Backing store: dense m_matrix, or m_sparse when m_is_sparse (loaded by
+    // from_packed_csr, or a sparse-only result). A sparse matrix is
+    // densified into m_matrix only when an operation needs dense storage.
+    mutable Eigen::MatrixXcd m_matrix;
+    SparseCM m_sparse;
+    bool m_is_sparse = false;
+    mutable bool m_dense_ready = true;
     int m_dim;
 
+    // Sticky Hermitian flag: measured when a matrix is loaded, carried
+    // through operations that preserve Hermiticity, else measured on first
+    // use. Routes expm and propagators to the Hermitian eigensolver.
+    enum HermitianState {
+        HERMITIAN_UNKNOWN = -1,
+        HERMITIAN_NO = 0,
+        HERMITIAN_YES = 1
+    };
+    mutable int m_hermitian = HERMITIAN_YES;  // The empty matrix
+
+    const Eigen::MatrixXcd& dense() const;
+    // Replace the contents (also drops any prepared propagator)
+    void set_dense(Eigen::MatrixXcd mat, int hermitian_state = HERMITIAN_UNKNOWN);
+    void set_sparse(SparseCM mat, int hermitian_state = HERMITIAN_UNKNOWN);
+    bool hermitian() const;
+    // Σ |m_ij - conj(m_ji)|² = ||M - M†||²_F without forming M - M†; stops
+    // early once the sum reaches limit_sq
+    double hermitian_defect_sq(double limit_sq) const;
+
+    // Dense storage is recycled through a process-wide free list keyed by
+    // dim (see acquire()): take_buffer hands out an uninitialized dim×dim
+    // buffer, recycle_buffer returns one (leaving it empty)
+    static Eigen::MatrixXcd take_buffer(int dim);
+    static void recycle_buffer(Eigen::MatrixXcd& buffer);
+    // set_dense of a dense-only expression, evaluated into a pooled buffer
+    template <typename Expr>
+    void store_dense(const Expr& expr, int hermitian_state = HERMITIAN_UNKNOWN) {
+        Eigen::MatrixXcd buffer = take_buffer((int)expr.rows());
+        buffer.noalias() = expr;
+        set_dense(std::move(buffer), hermitian_state);
+    }
+
+    // prepare_propagator() state: m_matrix = V·diag(λ)·V†, plus the most
+    // recently built U(t) (front = newest). Cleared whenever m_matrix changes.
+    bool m_propagator_ready = false;
+    Eigen::VectorXd m_eigenvalues;
+    Eigen::MatrixXcd m_eigenvectors;
+    std::list<std::pair<double, Eigen::MatrixXcd>> m_propagator_cache;
+    int m_propagator_cache_size = 8;
+
+    // Batches of at least this many matrices are split across the native
+    // thread pool
+    int m_batch_parallel_threshold = 32;
+    // Matrices in a batch buffer (0 with a warning if it is not a whole
+    // number of dim×dim matrices)
+    int batch_count(const PackedFloat64Array& data, int dim, const char* method) const;
+    void run_batch(int count, const std::function<void(int, int)>& fn) const;
+
+    void invalidate_propagator();
+    // U(t) from the cached decomposition (LRU lookup first)
+    const Eigen::MatrixXcd& propagator_matrix(double t);
+
     // Helper to pack matrix to array
     PackedFloat64Array pack_matrix(const Eigen::MatrixXcd& mat, int dim) const;
+    PackedFloat64Array pack_sparse(const SparseCM& mat) const;
+    // Operand of an evaluate() step: another matrix's storage, or a packed
+    // array unpacked into owned
+    struct Operand {
+        const Eigen::MatrixXcd* dense = nullptr;
+        const SparseCM* sparse = nullptr;
+        Eigen::MatrixXcd owned;
+    };
+    bool resolve_operand(const Variant& value, const String& op, Operand& r_operand) const;
+    // Runs an op list over a copy of this matrix; false (with a warning) on
+    // a malformed step
+    bool evaluate_ops(const Array& ops, Eigen::MatrixXcd& acc) const;
+
+    // Warns and returns false unless mat is non-null and, when match_dim is
+    // set, has this matrix's dimension
+    bool check_handle(const Ref<QuantumMatrixNative>& mat, const char* method, bool match_dim) const;
 
 protected:
     static void _bind_methods();
@@ -29,6 +111,16 @@ public:
 
     // Load/store from GDScript
     void from_packed(const PackedFloat64Array& data, int dim);
+
+    // Pooled instances for per-frame scratch matrices: acquire(dim) returns
+    // a zeroed dim×dim matrix built on a recycled buffer, release() hands
+    // the storage back and leaves the matrix empty. Storage dropped any
+    // other way (results overwriting out, sparse loads, destruction) is
+    // recycled too. Stats: {"buffers", "bytes", "hits", "misses"}.
+    static Ref<QuantumMatrixNative> acquire(int dim);
+    void release();
+    static Dictionary get_pool_stats();
+    static void clear_pool();
     PackedFloat64Array to_packed() const;
     int get_dimension() const;
 
@@ -45,13 +137,69 @@ public:
     PackedFloat64Array dagger() const;
     PackedFloat64Array commutator(const PackedFloat64Array& other, int dim) const;
 
+    // Handle-to-handle variants: the result is written into out's Eigen
+    // storage (out may be this or other), so a chain such as U·ρ·U† never
+    // packs its intermediates. Call out.to_packed() on the final result.
+    void mul_into(const Ref<QuantumMatrixNative>& other, const Ref<QuantumMatrixNative>& out) const;
+    void add_into(const Ref<QuantumMatrixNative>& other, const Ref<QuantumMatrixNative>& out) const;
+    void sub_into(const Ref<QuantumMatrixNative>& other, const Ref<QuantumMatrixNative>& out) const;
+    void commutator_into(const Ref<QuantumMatrixNative>& other, const Ref<QuantumMatrixNative>& out) const;
+    void scale_into(double re, double im, const Ref<QuantumMatrixNative>& out) const;
+    void dagger_into(const Ref<QuantumMatrixNative>& out) const;
+
+    // Batched operations over N matrices of equal dim packed back to back
+    // (each in the to_packed layout), one call and one result buffer per
+    // batch. batch_mul multiplies pairwise, or every a by a single b;
+    // batch_trace returns [re, im] per matrix; batch_eigensystem (Hermitian
+    // inputs) returns {"eigenvalues": N·dim ascending per matrix,
+    // "eigenvectors": N packed matrices}. Empty on a malformed buffer.
+    PackedFloat64Array batch_mul(const PackedFloat64Array& a, const PackedFloat64Array& b, int dim) const;
+    PackedFloat64Array batch_dagger(const PackedFloat64Array& data, int dim) const;
+    PackedFloat64Array batch_trace(const PackedFloat64Array& data, int dim) const;
+    Dictionary batch_eigensystem(const PackedFloat64Array& data, int dim) const;
+    void set_batch_parallel_threshold(int min_matrices);
+    int get_batch_parallel_threshold() const;
+
+    // Fused evaluation of an op list applied left to right to this matrix
+    // (which is not modified), e.g. [["comm", B], ["scale", 0.0, -1.0],
+    // ["add", C]] for -i[A, B] + C. Steps: ["mul", M] (X·M), ["comm", M]
+    // ([X, M]), ["add", M], ["sub", M], ["scale", re, im = 0] and
+    // ["dagger"]; M is a QuantumMatrixNative of the same dimension or a
+    // packed array. Scales are folded into the next product or pass, and
+    // runs of add/sub are applied in one column-blocked pass, so no
+    // intermediate is materialized per step. Empty / untouched on error.
+    PackedFloat64Array evaluate(const Array& ops) const;
+    void evaluate_into(const Array& ops, const Ref<QuantumMatrixNative>& out) const;
+
+    // Unitary propagators U(t) = exp(-i·H·t) for a Hermitian H (this
+    // matrix): prepare_propagator() diagonalizes H once (false, with a
+    // warning, if it is not Hermitian), after which each new t costs one
+    // matrix product, V·diag(e^{-iλt})·V†, instead of a Padé expm. The last
+    // few t values are kept in an LRU cache.
+    bool prepare_propagator();
+    bool has_propagator() const;
+    PackedFloat64Array propagator(double t);
+    void propagator_into(double t, const Ref<QuantumMatrixNative>& out);
+    void set_propagator_cache_size(int size);
+    int get_propagator_cache_size() const;
+
     // Utilities
     double trace_real() const;
     double trace_imag() const;
+    // ||M - M†||_F < tolerance, without a temporary (exits early)
     bool is_hermitian(double tolerance) const;
+    // Sticky flag (see m_hermitian); set_hermitian overrides it, e.g. for a
+    // generator known to be Hermitian up to rounding
+    bool get_hermitian() const;
+    void set_hermitian(bool value);
 
-    // Sparse matrix support (CSR format)
+    // Sparse matrix support (CSR format). from_packed_csr keeps the matrix
+    // in sparse storage: mul/add/sub/commutator/scale/dagger, traces and
+    // the CSR/nonzero queries then cost in proportion to the nonzeros, and
+    // the *_into variants keep a sparse result when both operands are
+    // sparse. expm/inverse/eigensystem/propagators densify on first use.
     void from_packed_csr(const Dictionary& csr_data);
+    bool is_sparse() const;
     Dictionary to_packed_csr(double threshold) const;
     double get_sparsity_ratio(double threshold) const;
     int count_nonzeros(double threshold) const;
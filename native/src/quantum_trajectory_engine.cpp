@@ -0,0 +1,658 @@
+#include "quantum_trajectory_engine.h"
+#include "partial_trace_tables.h"
+#include "native_thread_pool.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+
+using namespace godot;
+
+namespace {
+// Entropy in bits from the eigenvalues of a small Hermitian matrix
+template <typename Mat>
+double entropy_bits(const Mat& reduced) {
+    Eigen::SelfAdjointEigenSolver<Mat> solver(reduced);
+    const double log2_e = 1.0 / std::log(2.0);
+    double entropy = 0.0;
+    for (int i = 0; i < solver.eigenvalues().size(); i++) {
+        double lambda = solver.eigenvalues()(i);
+        if (lambda > 1e-15) {
+            entropy -= lambda * std::log(lambda) * log2_e;
+        }
+    }
+    return std::max(entropy, 0.0);
+}
+}  // namespace
+
+void QuantumTrajectoryEngine::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_dimension", "dim"),
+                         &QuantumTrajectoryEngine::set_dimension);
+    ClassDB::bind_method(D_METHOD("set_hamiltonian", "H_packed"),
+                         &QuantumTrajectoryEngine::set_hamiltonian);
+    ClassDB::bind_method(D_METHOD("add_lindblad_triplets", "triplets"),
+                         &QuantumTrajectoryEngine::add_lindblad_triplets);
+    ClassDB::bind_method(D_METHOD("clear_operators"),
+                         &QuantumTrajectoryEngine::clear_operators);
+    ClassDB::bind_method(D_METHOD("finalize"),
+                         &QuantumTrajectoryEngine::finalize);
+
+    ClassDB::bind_method(D_METHOD("set_trajectory_count", "count"),
+                         &QuantumTrajectoryEngine::set_trajectory_count);
+    ClassDB::bind_method(D_METHOD("get_trajectory_count"),
+                         &QuantumTrajectoryEngine::get_trajectory_count);
+    ClassDB::bind_method(D_METHOD("set_worker_count", "count"),
+                         &QuantumTrajectoryEngine::set_worker_count);
+    ClassDB::bind_method(D_METHOD("get_worker_count"),
+                         &QuantumTrajectoryEngine::get_worker_count);
+    ClassDB::bind_method(D_METHOD("set_mi_parallel_threshold", "min_pairs"),
+                         &QuantumTrajectoryEngine::set_mi_parallel_threshold);
+    ClassDB::bind_method(D_METHOD("get_mi_parallel_threshold"),
+                         &QuantumTrajectoryEngine::get_mi_parallel_threshold);
+    ClassDB::bind_method(D_METHOD("set_seed", "seed"),
+                         &QuantumTrajectoryEngine::set_seed);
+
+    ClassDB::bind_method(D_METHOD("get_dimension"),
+                         &QuantumTrajectoryEngine::get_dimension);
+    ClassDB::bind_method(D_METHOD("is_finalized"),
+                         &QuantumTrajectoryEngine::is_finalized);
+    ClassDB::bind_method(D_METHOD("has_ensemble"),
+                         &QuantumTrajectoryEngine::has_ensemble);
+    ClassDB::bind_method(D_METHOD("get_last_jump_count"),
+                         &QuantumTrajectoryEngine::get_last_jump_count);
+
+    ClassDB::bind_method(D_METHOD("initialize_from_rho", "rho_data"),
+                         &QuantumTrajectoryEngine::initialize_from_rho);
+    ClassDB::bind_method(D_METHOD("initialize_from_state", "psi_data"),
+                         &QuantumTrajectoryEngine::initialize_from_state);
+    ClassDB::bind_method(D_METHOD("evolve", "dt", "max_dt"),
+                         &QuantumTrajectoryEngine::evolve);
+
+    ClassDB::bind_method(D_METHOD("get_density_matrix"),
+                         &QuantumTrajectoryEngine::get_density_matrix);
+    ClassDB::bind_method(D_METHOD("compute_purity"),
+                         &QuantumTrajectoryEngine::compute_purity);
+    ClassDB::bind_method(D_METHOD("compute_bloch_metrics", "num_qubits"),
+                         &QuantumTrajectoryEngine::compute_bloch_metrics);
+    ClassDB::bind_method(D_METHOD("compute_all_mutual_information", "num_qubits"),
+                         &QuantumTrajectoryEngine::compute_all_mutual_information);
+}
+
+QuantumTrajectoryEngine::QuantumTrajectoryEngine() {}
+
+QuantumTrajectoryEngine::~QuantumTrajectoryEngine() {}
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+void QuantumTrajectoryEngine::set_dimension(int dim) {
+    m_dim = dim;
+    m_finalized = false;
+    m_has_ensemble = false;
+}
+
+void QuantumTrajectoryEngine::set_hamiltonian(const PackedFloat64Array& H_packed) {
+    if (m_dim == 0) {
+        UtilityFunctions::push_warning("QuantumTrajectoryEngine: set_dimension first!");
+        return;
+    }
+    if (H_packed.size() != static_cast<int64_t>(m_dim) * m_dim * 2) {
+        UtilityFunctions::push_warning("QuantumTrajectoryEngine: Hamiltonian size does not match dimension");
+        return;
+    }
+
+    // Same packed row-major dense format as QuantumEvolutionEngine
+    const double* ptr = H_packed.ptr();
+    std::vector<Eigen::Triplet<std::complex<double>>> triplets;
+    triplets.reserve(m_dim * 4);
+    for (int i = 0; i < m_dim; i++) {
+        for (int j = 0; j < m_dim; j++) {
+            int idx = (i * m_dim + j) * 2;
+            double re = ptr[idx];
+            double im = ptr[idx + 1];
+            if (std::abs(re) > 1e-15 || std::abs(im) > 1e-15) {
+                triplets.emplace_back(i, j, std::complex<double>(re, im));
+            }
+        }
+    }
+
+    m_hamiltonian.resize(m_dim, m_dim);
+    m_hamiltonian.setFromTriplets(triplets.begin(), triplets.end());
+    m_hamiltonian.makeCompressed();
+    m_has_hamiltonian = true;
+    m_finalized = false;
+}
+
+void QuantumTrajectoryEngine::add_lindblad_triplets(const PackedFloat64Array& triplets) {
+    if (m_dim == 0) {
+        UtilityFunctions::push_warning("QuantumTrajectoryEngine: set_dimension first!");
+        return;
+    }
+
+    // Triplets: [row0, col0, re0, im0, row1, col1, re1, im1, ...]
+    int num_entries = triplets.size() / 4;
+    std::vector<Eigen::Triplet<std::complex<double>>> eigen_triplets;
+    eigen_triplets.reserve(num_entries);
+
+    const double* ptr = triplets.ptr();
+    for (int i = 0; i < num_entries; i++) {
+        int row = static_cast<int>(ptr[i * 4]);
+        int col = static_cast<int>(ptr[i * 4 + 1]);
+        double re = ptr[i * 4 + 2];
+        double im = ptr[i * 4 + 3];
+        if (row < 0 || row >= m_dim || col < 0 || col >= m_dim) {
+            continue;
+        }
+        if (std::abs(re) > 1e-15 || std::abs(im) > 1e-15) {
+            eigen_triplets.emplace_back(row, col, std::complex<double>(re, im));
+        }
+    }
+
+    SparseCM L(m_dim, m_dim);
+    L.setFromTriplets(eigen_triplets.begin(), eigen_triplets.end());
+    L.makeCompressed();
+    m_lindblads.push_back(OperatorRegistry::intern(L));
+    m_finalized = false;
+}
+
+void QuantumTrajectoryEngine::clear_operators() {
+    m_hamiltonian.resize(0, 0);
+    m_has_hamiltonian = false;
+    m_lindblads.clear();
+    m_heff.resize(0, 0);
+    m_finalized = false;
+}
+
+void QuantumTrajectoryEngine::set_operators(const SparseCM* hamiltonian,
+                                            const std::vector<std::shared_ptr<const SharedLindblad>>& lindblads) {
+    clear_operators();
+    if (hamiltonian != nullptr) {
+        m_hamiltonian = *hamiltonian;
+        m_has_hamiltonian = true;
+    }
+    m_lindblads = lindblads;
+}
+
+void QuantumTrajectoryEngine::finalize() {
+    // H_eff = H - (i/2) Σ L†L drives the no-jump evolution
+    m_heff.resize(m_dim, m_dim);
+    m_heff.setZero();
+    if (m_has_hamiltonian) {
+        m_heff = m_hamiltonian;
+    }
+    for (const auto& L : m_lindblads) {
+        m_heff += std::complex<double>(0.0, -0.5) * L->LdagL;
+    }
+    m_heff.prune(std::complex<double>(0.0, 0.0), 1e-15);
+    m_heff.makeCompressed();
+
+    m_finalized = (m_dim > 0);
+}
+
+void QuantumTrajectoryEngine::set_trajectory_count(int count) {
+    m_trajectory_count = std::max(1, count);
+}
+
+int QuantumTrajectoryEngine::get_trajectory_count() const {
+    return m_trajectory_count;
+}
+
+void QuantumTrajectoryEngine::set_worker_count(int count) {
+    m_worker_count = std::max(0, count);
+}
+
+int QuantumTrajectoryEngine::get_worker_count() const {
+    return m_worker_count;
+}
+
+void QuantumTrajectoryEngine::set_mi_parallel_threshold(int min_pairs) {
+    m_mi_parallel_threshold = std::max(0, min_pairs);
+}
+
+int QuantumTrajectoryEngine::get_mi_parallel_threshold() const {
+    return m_mi_parallel_threshold;
+}
+
+void QuantumTrajectoryEngine::set_seed(int64_t seed) {
+    m_seed = static_cast<uint64_t>(seed);
+}
+
+int QuantumTrajectoryEngine::get_dimension() const {
+    return m_dim;
+}
+
+bool QuantumTrajectoryEngine::is_finalized() const {
+    return m_finalized;
+}
+
+bool QuantumTrajectoryEngine::has_ensemble() const {
+    return m_has_ensemble;
+}
+
+int QuantumTrajectoryEngine::get_last_jump_count() const {
+    return m_last_jumps;
+}
+
+// ============================================================================
+// ENSEMBLE STATE
+// ============================================================================
+
+void QuantumTrajectoryEngine::reset_ensemble(int count) {
+    m_psi.resize(m_dim, count);
+    m_weights.assign(count, 1.0);
+    m_thresholds.assign(count, 0.0);
+    m_rngs.clear();
+    m_rngs.reserve(count);
+
+    // One independent stream per trajectory: results don't depend on how the
+    // trajectories are split across workers
+    std::seed_seq base_seq{static_cast<uint32_t>(m_seed), static_cast<uint32_t>(m_seed >> 32)};
+    std::mt19937_64 seeder(base_seq);
+    for (int a = 0; a < count; a++) {
+        m_rngs.emplace_back(seeder());
+    }
+
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (int a = 0; a < count; a++) {
+        m_thresholds[a] = uniform(m_rngs[a]);
+    }
+    m_factor_dirty = true;
+}
+
+bool QuantumTrajectoryEngine::initialize_from_rho(const PackedFloat64Array& rho_data) {
+    if (!m_finalized) {
+        UtilityFunctions::push_warning("QuantumTrajectoryEngine: call finalize() first!");
+        return false;
+    }
+    if (rho_data.size() != static_cast<int64_t>(m_dim) * m_dim * 2) {
+        UtilityFunctions::push_warning("QuantumTrajectoryEngine: rho size does not match dimension");
+        return false;
+    }
+
+    // Packed row-major [re, im] → Hermitian part of ρ
+    const double* ptr = rho_data.ptr();
+    Eigen::MatrixXcd rho(m_dim, m_dim);
+    for (int i = 0; i < m_dim; i++) {
+        for (int j = 0; j < m_dim; j++) {
+            int idx = (i * m_dim + j) * 2;
+            rho(i, j) = std::complex<double>(ptr[idx], ptr[idx + 1]);
+        }
+    }
+    Eigen::MatrixXcd rho_h = 0.5 * (rho + rho.adjoint());
+
+    // ρ = Pᵀ L D L† P → B = Pᵀ L D^{1/2} with B B† = ρ (D clamped at 0 for PSD noise)
+    Eigen::LDLT<Eigen::MatrixXcd> ldlt(rho_h);
+    Eigen::VectorXd sqrt_d = ldlt.vectorD().real().cwiseMax(0.0).cwiseSqrt();
+    Eigen::MatrixXcd lower = ldlt.matrixL();
+    Eigen::MatrixXcd B = ldlt.transpositionsP().transpose() * (lower * sqrt_d.asDiagonal());
+
+    reset_ensemble(m_trajectory_count);
+
+    // ψ_a = B ξ_a, ξ complex Gaussian with E[ξ ξ†] = I ⇒ E[ψ_a ψ_a†] = ρ
+    std::normal_distribution<double> gauss(0.0, std::sqrt(0.5));
+    Eigen::MatrixXcd xi(m_dim, m_trajectory_count);
+    for (int a = 0; a < m_trajectory_count; a++) {
+        for (int i = 0; i < m_dim; i++) {
+            double re = gauss(m_rngs[a]);
+            double im = gauss(m_rngs[a]);
+            xi(i, a) = std::complex<double>(re, im);
+        }
+    }
+    m_psi.noalias() = B * xi;
+
+    for (int a = 0; a < m_trajectory_count; a++) {
+        double norm2 = m_psi.col(a).squaredNorm();
+        if (norm2 > 1e-300) {
+            m_psi.col(a) /= std::sqrt(norm2);
+            m_weights[a] = norm2;
+        } else {
+            // Degenerate draw: keep a valid state with no weight
+            m_psi.col(a).setZero();
+            m_psi(0, a) = 1.0;
+            m_weights[a] = 0.0;
+        }
+    }
+
+    m_has_ensemble = true;
+    m_factor_dirty = true;
+    return true;
+}
+
+bool QuantumTrajectoryEngine::initialize_from_state(const PackedFloat64Array& psi_data) {
+    if (!m_finalized) {
+        UtilityFunctions::push_warning("QuantumTrajectoryEngine: call finalize() first!");
+        return false;
+    }
+    if (psi_data.size() != static_cast<int64_t>(m_dim) * 2) {
+        UtilityFunctions::push_warning("QuantumTrajectoryEngine: psi size does not match dimension");
+        return false;
+    }
+
+    Eigen::VectorXcd psi(m_dim);
+    const double* ptr = psi_data.ptr();
+    for (int i = 0; i < m_dim; i++) {
+        psi(i) = std::complex<double>(ptr[i * 2], ptr[i * 2 + 1]);
+    }
+    double norm = psi.norm();
+    if (norm < 1e-150) {
+        UtilityFunctions::push_warning("QuantumTrajectoryEngine: psi has zero norm");
+        return false;
+    }
+    psi /= norm;
+
+    reset_ensemble(m_trajectory_count);
+    m_psi.colwise() = psi;
+    m_has_ensemble = true;
+    m_factor_dirty = true;
+    return true;
+}
+
+// ============================================================================
+// EVOLUTION
+// ============================================================================
+
+void QuantumTrajectoryEngine::evolve(float dt, float max_dt) {
+    m_last_jumps = 0;
+    if (!m_finalized || !m_has_ensemble) {
+        UtilityFunctions::push_warning("QuantumTrajectoryEngine: finalize() and initialize_* first!");
+        return;
+    }
+    if (!(dt > 0.0f)) {
+        return;
+    }
+
+    const double T = static_cast<double>(dt);
+    const double h_max = (max_dt > 0.0f) ? static_cast<double>(max_dt) : T;
+    const int count = static_cast<int>(m_psi.cols());
+
+    // Disjoint column ranges on the shared native pool: each trajectory owns
+    // its state, RNG and threshold (m_worker_count caps the chunk count)
+    std::atomic<int> jumps(0);
+    NativeThreadPool::shared().parallel_for(0, count, m_worker_count, [&](int begin, int end) {
+        int range_jumps = 0;
+        evolve_range(begin, end, T, h_max, range_jumps);
+        jumps.fetch_add(range_jumps);
+    });
+    m_last_jumps = jumps.load();
+    m_factor_dirty = true;
+}
+
+void QuantumTrajectoryEngine::evolve_range(int begin, int end, double T, double h_max, int& jumps) {
+    const std::complex<double> minus_i(0.0, -1.0);
+    const bool can_jump = !m_lindblads.empty();
+
+    Eigen::VectorXcd k1(m_dim), k2(m_dim), k3(m_dim), k4(m_dim), stage(m_dim);
+
+    for (int a = begin; a < end; a++) {
+        auto psi = m_psi.col(a);
+        double t = 0.0;
+        while (t < T * (1.0 - 1e-12)) {
+            const double h = std::min(h_max, T - t);
+
+            // RK4 on dψ/dt = -i H_eff ψ (norm decays with the jump probability)
+            k1.noalias() = minus_i * (m_heff * psi);
+            stage = psi + (0.5 * h) * k1;
+            k2.noalias() = minus_i * (m_heff * stage);
+            stage = psi + (0.5 * h) * k2;
+            k3.noalias() = minus_i * (m_heff * stage);
+            stage = psi + h * k3;
+            k4.noalias() = minus_i * (m_heff * stage);
+            psi += (h / 6.0) * (k1 + 2.0 * k2 + 2.0 * k3 + k4);
+            t += h;
+
+            if (can_jump && psi.squaredNorm() < m_thresholds[a]) {
+                jump(a, stage);
+                jumps++;
+            }
+        }
+    }
+}
+
+void QuantumTrajectoryEngine::jump(int a, Eigen::VectorXcd& scratch) {
+    auto psi = m_psi.col(a);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    // Channel k with probability ∝ ‖L_k ψ‖²
+    double total = 0.0;
+    std::vector<double> rates(m_lindblads.size());
+    for (size_t k = 0; k < m_lindblads.size(); k++) {
+        scratch.noalias() = m_lindblads[k]->L * psi;
+        rates[k] = scratch.squaredNorm();
+        total += rates[k];
+    }
+
+    if (total > 1e-300) {
+        double pick = uniform(m_rngs[a]) * total;
+        size_t chosen = m_lindblads.size() - 1;
+        for (size_t k = 0; k < rates.size(); k++) {
+            pick -= rates[k];
+            if (pick <= 0.0) {
+                chosen = k;
+                break;
+            }
+        }
+        scratch.noalias() = m_lindblads[chosen]->L * psi;
+        psi = scratch / std::sqrt(rates[chosen]);
+    } else {
+        // Dark state: nothing to jump with, just renormalize
+        psi.normalize();
+    }
+    m_thresholds[a] = uniform(m_rngs[a]);
+}
+
+// ============================================================================
+// ENSEMBLE ESTIMATORS
+// ============================================================================
+
+const QuantumTrajectoryEngine::FactorMatrix& QuantumTrajectoryEngine::factor() const {
+    if (!m_factor_dirty) {
+        return m_factor;
+    }
+
+    // X = [√(w_a / Σw) ψ_a / ‖ψ_a‖] so that ρ ≈ X X†
+    const int count = static_cast<int>(m_psi.cols());
+    double total_weight = 0.0;
+    for (double w : m_weights) {
+        total_weight += w;
+    }
+
+    m_factor.resize(m_dim, count);
+    for (int a = 0; a < count; a++) {
+        double norm = m_psi.col(a).norm();
+        double scale = (total_weight > 0.0 && norm > 0.0)
+            ? std::sqrt(m_weights[a] / total_weight) / norm : 0.0;
+        m_factor.col(a) = scale * m_psi.col(a);
+    }
+    m_factor_dirty = false;
+    return m_factor;
+}
+
+bool QuantumTrajectoryEngine::has_qubit_layout(int num_qubits) const {
+    return num_qubits > 0 && num_qubits < 31 && (1 << num_qubits) == m_dim;
+}
+
+PackedFloat64Array QuantumTrajectoryEngine::get_density_matrix() const {
+    PackedFloat64Array out;
+    if (!m_has_ensemble) {
+        return out;
+    }
+
+    const FactorMatrix& X = factor();
+    Eigen::Matrix<std::complex<double>, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> rho(m_dim, m_dim);
+    rho.noalias() = X * X.adjoint();
+
+    // Row-major complex storage is the packed [re, im] layout
+    out.resize(static_cast<int64_t>(m_dim) * m_dim * 2);
+    const double* src = reinterpret_cast<const double*>(rho.data());
+    std::copy(src, src + out.size(), out.ptrw());
+    return out;
+}
+
+double QuantumTrajectoryEngine::compute_purity() const {
+    if (!m_has_ensemble) {
+        return 0.0;
+    }
+    // Tr(ρ²) = Tr(X X† X X†) = ‖X† X‖²_F = ‖X X†‖²_F: take the smaller side
+    // (the N×N overlap Gram matrix for large biomes)
+    const FactorMatrix& X = factor();
+    if (X.cols() <= X.rows()) {
+        Eigen::MatrixXcd gram = X.adjoint() * X;
+        return gram.squaredNorm();
+    }
+    Eigen::MatrixXcd rho = X * X.adjoint();
+    return rho.squaredNorm();
+}
+
+Eigen::Matrix2cd QuantumTrajectoryEngine::reduced_single(int qubit, const PartialTraceTables* tables) const {
+    // ρ_q(a, b) = Σ_{rest} Σ_c X(rest|a, c) X̄(rest|b, c)
+    const FactorMatrix& X = factor();
+    const int bit = 1 << qubit;
+    Eigen::Matrix2cd reduced = Eigen::Matrix2cd::Zero();
+    auto accumulate = [&](int base) {
+        auto r0 = X.row(base);
+        auto r1 = X.row(base | bit);
+        reduced(0, 0) += r0.squaredNorm();
+        reduced(1, 1) += r1.squaredNorm();
+        reduced(0, 1) += r1.dot(r0);  // Σ_c X(0,c) X̄(1,c) (dot conjugates its left side)
+    };
+
+    // Shared gather table of base rows; masked scan beyond its qubit range
+    if (tables) {
+        const int32_t* bases = tables->single(qubit);
+        for (int k = 0; k < tables->single_size(); k++) {
+            accumulate(bases[k]);
+        }
+    } else {
+        for (int base = 0; base < m_dim; base++) {
+            if (!(base & bit)) {
+                accumulate(base);
+            }
+        }
+    }
+    reduced(1, 0) = std::conj(reduced(0, 1));
+    return reduced;
+}
+
+Eigen::Matrix4cd QuantumTrajectoryEngine::reduced_pair(int qubit_a, int qubit_b,
+                                                      const PartialTraceTables* tables) const {
+    // Basis |ab⟩ with qubit_a as the high digit (matches partial_trace_complement)
+    const FactorMatrix& X = factor();
+    const int mask = (1 << qubit_a) | (1 << qubit_b);
+    int offsets[4];
+    for (int l = 0; l < 4; l++) {
+        offsets[l] = (((l >> 1) & 1) << qubit_a) | ((l & 1) << qubit_b);
+    }
+
+    Eigen::Matrix4cd reduced = Eigen::Matrix4cd::Zero();
+    auto accumulate = [&](int base) {
+        for (int l = 0; l < 4; l++) {
+            auto row_l = X.row(base + offsets[l]);
+            for (int m = l; m < 4; m++) {
+                // row_l · conj(row_m) summed over trajectories
+                reduced(l, m) += X.row(base + offsets[m]).dot(row_l);
+            }
+        }
+    };
+
+    if (tables) {
+        const int32_t* bases = tables->pair(std::min(qubit_a, qubit_b), std::max(qubit_a, qubit_b));
+        for (int k = 0; k < tables->pair_size(); k++) {
+            accumulate(bases[k]);
+        }
+    } else {
+        for (int base = 0; base < m_dim; base++) {
+            if (!(base & mask)) {
+                accumulate(base);
+            }
+        }
+    }
+    for (int l = 0; l < 4; l++) {
+        for (int m = 0; m < l; m++) {
+            reduced(l, m) = std::conj(reduced(m, l));
+        }
+    }
+    return reduced;
+}
+
+PackedFloat64Array QuantumTrajectoryEngine::compute_bloch_metrics(int num_qubits) const {
+    // Packed [p0,p1,x,y,z,r,theta,phi] per qubit, as QuantumEvolutionEngine
+    PackedFloat64Array out;
+    if (!m_has_ensemble || !has_qubit_layout(num_qubits)) {
+        return out;
+    }
+    out.resize(num_qubits * 8);
+    double* ptr = out.ptrw();
+    std::shared_ptr<const PartialTraceTables> tables = PartialTraceTables::get(num_qubits);
+
+    for (int q = 0; q < num_qubits; q++) {
+        Eigen::Matrix2cd reduced = reduced_single(q, tables.get());
+        double p0 = reduced(0, 0).real();
+        double p1 = reduced(1, 1).real();
+        double x = 2.0 * reduced(0, 1).real();
+        double y = -2.0 * reduced(0, 1).imag();
+        double z = p0 - p1;
+
+        double r = std::sqrt(x * x + y * y + z * z);
+        double theta = 0.0;
+        double phi = 0.0;
+        if (r > 1e-12) {
+            double cz = std::max(-1.0, std::min(1.0, z / r));
+            theta = std::acos(cz);
+            phi = std::atan2(y, x);
+        }
+
+        int base = q * 8;
+        ptr[base + 0] = p0;
+        ptr[base + 1] = p1;
+        ptr[base + 2] = x;
+        ptr[base + 3] = y;
+        ptr[base + 4] = z;
+        ptr[base + 5] = r;
+        ptr[base + 6] = theta;
+        ptr[base + 7] = phi;
+    }
+    return out;
+}
+
+PackedFloat64Array QuantumTrajectoryEngine::compute_all_mutual_information(int num_qubits) const {
+    // Upper triangular order [mi_01, mi_02, ..., mi_(n-2)(n-1)], as QuantumEvolutionEngine
+    PackedFloat64Array mi_values;
+    if (!m_has_ensemble || !has_qubit_layout(num_qubits) || num_qubits < 2) {
+        return mi_values;
+    }
+    mi_values.resize(num_qubits * (num_qubits - 1) / 2);
+    double* ptr = mi_values.ptrw();
+
+    std::shared_ptr<const PartialTraceTables> tables = PartialTraceTables::get(num_qubits);
+    std::vector<double> single_entropies(num_qubits);
+    for (int q = 0; q < num_qubits; q++) {
+        single_entropies[q] = entropy_bits(reduced_single(q, tables.get()));
+    }
+
+    // Each pair reduction is an O(dim·N) pass over the factor: split the
+    // pairs across the shared pool (output stays in upper-triangular order)
+    const int num_pairs = num_qubits * (num_qubits - 1) / 2;
+    std::vector<int> pair_i, pair_j;
+    for (int i = 0; i < num_qubits; i++) {
+        for (int j = i + 1; j < num_qubits; j++) {
+            pair_i.push_back(i);
+            pair_j.push_back(j);
+        }
+    }
+    auto pair_range = [&](int begin, int end) {
+        for (int idx = begin; idx < end; idx++) {
+            const int i = pair_i[idx];
+            const int j = pair_j[idx];
+            double S_ab = entropy_bits(reduced_pair(i, j, tables.get()));
+            ptr[idx] = std::max(single_entropies[i] + single_entropies[j] - S_ab, 0.0);
+        }
+    };
+    if (m_mi_parallel_threshold > 0 && num_pairs >= m_mi_parallel_threshold) {
+        NativeThreadPool::shared().parallel_for(0, num_pairs, m_worker_count, pair_range);
+    } else {
+        pair_range(0, num_pairs);
+    }
+    return mi_values;
+}
@@ -0,0 +1,129 @@
+#ifndef QUANTUM_TRAJECTORY_ENGINE_H
+#define QUANTUM_TRAJECTORY_ENGINE_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include "operator_registry.h"
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <vector>
+#include <complex>
+#include <random>
+#include <cstdint>
+
+namespace godot {
+
+class PartialTraceTables;
+
+/**
+ * QuantumTrajectoryEngine - Monte Carlo wavefunction evolution for large biomes
+ *
+ * Beyond ~8 qubits the dense dim×dim ρ of QuantumEvolutionEngine is too big in
+ * both memory and time. This engine evolves an ensemble of N pure states
+ * instead (O(dim) memory each) under the same Hamiltonian + Lindblad operators:
+ * 1. Same operator setup API as QuantumEvolutionEngine
+ * 2. Trajectories run in parallel on the shared native thread pool
+ * 3. Bloch, purity and MI are estimated from the ensemble
+ *
+ * Unravelling (waiting-time MCWF): each trajectory integrates the unnormalized
+ * no-jump evolution dψ/dt = -i H_eff ψ (RK4, H_eff = H - (i/2) Σ L†L) until
+ * ‖ψ‖² drops below a uniform random threshold, then jumps ψ → L_k ψ with
+ * probability ∝ ‖L_k ψ‖².
+ *
+ * Estimator: ρ ≈ Σ_a w_a |ψ̂_a⟩⟨ψ̂_a| / Σ_a w_a (ψ̂_a normalized, w_a the
+ * sampling weight from initialize_from_rho). Statistical error ~ 1/√N.
+ */
+class QuantumTrajectoryEngine : public RefCounted {
+    GDCLASS(QuantumTrajectoryEngine, RefCounted)
+
+public:
+    QuantumTrajectoryEngine();
+    ~QuantumTrajectoryEngine();
+
+    // Setup methods (mirror QuantumEvolutionEngine)
+    void set_dimension(int dim);
+    void set_hamiltonian(const PackedFloat64Array& H_packed);
+    void add_lindblad_triplets(const PackedFloat64Array& triplets);
+    void clear_operators();
+    // Native: adopt already-built operators (H may be nullptr), e.g. from a
+    // restored QuantumEvolutionEngine; set_dimension first
+    void set_operators(const Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor>* hamiltonian,
+                       const std::vector<std::shared_ptr<const SharedLindblad>>& lindblads);
+    void finalize();  // Precompute H_eff
+
+    // Ensemble configuration
+    void set_trajectory_count(int count);  // Default 64; takes effect on next initialize_*
+    int get_trajectory_count() const;
+    void set_worker_count(int count);  // Max parallel chunks on the shared pool; 0 = pool size
+    int get_worker_count() const;
+    void set_mi_parallel_threshold(int min_pairs);  // Pool dispatch from this many pairs (default 6; 0 = serial)
+    int get_mi_parallel_threshold() const;
+    void set_seed(int64_t seed);  // Per-trajectory RNG streams derive from this
+
+    // Query methods
+    int get_dimension() const;
+    bool is_finalized() const;
+    bool has_ensemble() const;
+    int get_last_jump_count() const;  // Quantum jumps during the last evolve()
+
+    // Ensemble state
+    // Samples ψ_a = B ξ_a with ρ = B B† (pivoted LDLT) and ξ_a complex Gaussian,
+    // so E[ψ_a ψ_a†] = ρ. O(dim³) once per call.
+    bool initialize_from_rho(const PackedFloat64Array& rho_data);
+    // Every trajectory starts in ψ (packed [re0, im0, re1, im1, ...])
+    bool initialize_from_state(const PackedFloat64Array& psi_data);
+
+    // Integrates the full dt with substeps <= max_dt (max_dt <= 0: one substep)
+    void evolve(float dt, float max_dt);
+
+    // Ensemble estimators (same packed formats as QuantumEvolutionEngine)
+    PackedFloat64Array get_density_matrix() const;  // Dense ρ estimate, O(N·dim²)
+    double compute_purity() const;                  // Tr(ρ²) from the smaller Gram matrix (N×N or dim×dim)
+    PackedFloat64Array compute_bloch_metrics(int num_qubits) const;
+    PackedFloat64Array compute_all_mutual_information(int num_qubits) const;
+
+protected:
+    static void _bind_methods();
+
+private:
+    typedef Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor> SparseCM;
+    // Row-major dim×N estimator factor X (ρ ≈ X X†): basis rows are contiguous
+    typedef Eigen::Matrix<std::complex<double>, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> FactorMatrix;
+
+    int m_dim = 0;
+    bool m_finalized = false;
+
+    SparseCM m_hamiltonian;
+    bool m_has_hamiltonian = false;
+    std::vector<std::shared_ptr<const SharedLindblad>> m_lindblads;  // OperatorRegistry handles
+    SparseCM m_heff;  // H - (i/2) Σ L†L (finalize)
+
+    // Ensemble: column a is trajectory a (unnormalized during no-jump evolution)
+    int m_trajectory_count = 64;
+    int m_worker_count = 0;
+    int m_mi_parallel_threshold = 6;  // Pair reductions are O(dim·N) each, so parallel pays early
+    uint64_t m_seed = 0x5eedULL;
+    Eigen::MatrixXcd m_psi;
+    std::vector<double> m_weights;     // Sampling weight w_a
+    std::vector<double> m_thresholds;  // Waiting-time jump threshold r_a
+    std::vector<std::mt19937_64> m_rngs;
+    bool m_has_ensemble = false;
+    int m_last_jumps = 0;
+
+    // Cached estimator factor, rebuilt lazily after evolve()/initialize_*
+    mutable FactorMatrix m_factor;
+    mutable bool m_factor_dirty = true;
+
+    void reset_ensemble(int count);
+    void evolve_range(int begin, int end, double T, double h_max, int& jumps);
+    void jump(int a, Eigen::VectorXcd& scratch);
+    const FactorMatrix& factor() const;
+    bool has_qubit_layout(int num_qubits) const;  // dim == 2^num_qubits
+    // tables: shared gather indices for this qubit count (nullptr = masked scan)
+    Eigen::Matrix2cd reduced_single(int qubit, const PartialTraceTables* tables) const;
+    Eigen::Matrix4cd reduced_pair(int qubit_a, int qubit_b, const PartialTraceTables* tables) const;
+};
+
+}  // namespace godot
+
+#endif  // QUANTUM_TRAJECTORY_ENGINE_H
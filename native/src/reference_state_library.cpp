@@ -0,0 +1,192 @@
+#include "reference_state_library.h"
+#include "native_thread_pool.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <complex>
+#include <numeric>
+#include <vector>
+
+using namespace godot;
+
+namespace {
+
+// Queries (count · states · dim complex multiply-adds) below this stay on
+// the calling thread
+constexpr int64_t BATCH_PARALLEL_MIN_WORK = int64_t(1) << 18;
+
+Eigen::Map<const Eigen::VectorXcd> map_state(const PackedFloat64Array& state) {
+    return Eigen::Map<const Eigen::VectorXcd>(reinterpret_cast<const std::complex<double>*>(state.ptr()),
+                                              state.size() / 2);
+}
+
+// Indices of the k largest fidelities, best first (ties keep index order)
+void select_best(const double* fidelities, int count, int k, std::vector<int>& order) {
+    order.resize(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::partial_sort(order.begin(), order.begin() + k, order.end(), [fidelities](int a, int b) {
+        return fidelities[a] > fidelities[b] || (fidelities[a] == fidelities[b] && a < b);
+    });
+}
+
+}  // namespace
+
+void ReferenceStateLibrary::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_states", "packed_states", "dim"), &ReferenceStateLibrary::set_states);
+    ClassDB::bind_method(D_METHOD("add_state", "state"), &ReferenceStateLibrary::add_state);
+    ClassDB::bind_method(D_METHOD("clear"), &ReferenceStateLibrary::clear);
+    ClassDB::bind_method(D_METHOD("get_count"), &ReferenceStateLibrary::get_count);
+    ClassDB::bind_method(D_METHOD("get_dimension"), &ReferenceStateLibrary::get_dimension);
+    ClassDB::bind_method(D_METHOD("get_state", "index"), &ReferenceStateLibrary::get_state);
+    ClassDB::bind_method(D_METHOD("compute_fidelities", "state"), &ReferenceStateLibrary::compute_fidelities);
+    ClassDB::bind_method(D_METHOD("best_matches", "state", "k"), &ReferenceStateLibrary::best_matches);
+    ClassDB::bind_method(D_METHOD("best_matches_batch", "states", "k"), &ReferenceStateLibrary::best_matches_batch);
+}
+
+bool ReferenceStateLibrary::set_states(const PackedFloat64Array& packed_states, int dim) {
+    const int64_t stride = static_cast<int64_t>(dim) * 2;
+    if (dim <= 0 || packed_states.size() % stride != 0) {
+        UtilityFunctions::push_warning("ReferenceStateLibrary: set_states size ", packed_states.size(),
+                                       " is not a multiple of 2·dim (dim ", dim, ")");
+        return false;
+    }
+    const int count = static_cast<int>(packed_states.size() / stride);
+    m_states = Eigen::Map<const Eigen::MatrixXcd>(
+        reinterpret_cast<const std::complex<double>*>(packed_states.ptr()), dim, count);
+    return true;
+}
+
+int ReferenceStateLibrary::add_state(const PackedFloat64Array& state) {
+    const int dim = static_cast<int>(state.size() / 2);
+    if (dim <= 0 || state.size() % 2 != 0 || (m_states.cols() > 0 && dim != m_states.rows())) {
+        UtilityFunctions::push_warning("ReferenceStateLibrary: add_state dimension ", dim,
+                                       " does not match the library (", get_dimension(), ")");
+        return -1;
+    }
+    const int index = static_cast<int>(m_states.cols());
+    m_states.conservativeResize(dim, index + 1);
+    m_states.col(index) = map_state(state);
+    return index;
+}
+
+void ReferenceStateLibrary::clear() {
+    m_states.resize(0, 0);
+}
+
+int ReferenceStateLibrary::get_count() const {
+    return static_cast<int>(m_states.cols());
+}
+
+int ReferenceStateLibrary::get_dimension() const {
+    return m_states.cols() > 0 ? static_cast<int>(m_states.rows()) : 0;
+}
+
+PackedFloat64Array ReferenceStateLibrary::get_state(int index) const {
+    PackedFloat64Array state;
+    if (index < 0 || index >= m_states.cols()) {
+        return state;
+    }
+    state.resize(m_states.rows() * 2);
+    Eigen::Map<Eigen::VectorXcd>(reinterpret_cast<std::complex<double>*>(state.ptrw()), m_states.rows()) =
+        m_states.col(index);
+    return state;
+}
+
+PackedFloat64Array ReferenceStateLibrary::compute_fidelities(const PackedFloat64Array& state) const {
+    PackedFloat64Array fidelities;
+    if (m_states.cols() == 0 || state.size() != m_states.rows() * 2) {
+        return fidelities;
+    }
+    // One matrix-vector product: ⟨r_i|ψ⟩ for every reference state
+    const Eigen::VectorXcd overlaps = m_states.adjoint() * map_state(state);
+    fidelities.resize(overlaps.size());
+    double* ptr = fidelities.ptrw();
+    for (int i = 0; i < overlaps.size(); i++) {
+        ptr[i] = std::norm(overlaps(i));
+    }
+    return fidelities;
+}
+
+Dictionary ReferenceStateLibrary::best_matches(const PackedFloat64Array& state, int k) const {
+    Dictionary result;
+    const PackedFloat64Array fidelities = compute_fidelities(state);
+    const int count = static_cast<int>(fidelities.size());
+    k = std::max(0, std::min(k, count));
+
+    std::vector<int> order;
+    select_best(fidelities.ptr(), count, k, order);
+    PackedInt32Array indices;
+    PackedFloat64Array best;
+    indices.resize(k);
+    best.resize(k);
+    for (int j = 0; j < k; j++) {
+        indices[j] = order[j];
+        best[j] = fidelities[order[j]];
+    }
+    result["indices"] = indices;
+    result["fidelities"] = best;
+    return result;
+}
+
+Dictionary ReferenceStateLibrary::best_matches_batch(const Array& states, int k) const {
+    Dictionary result;
+    const int num_queries = states.size();
+    const int count = static_cast<int>(m_states.cols());
+    const int64_t dim = m_states.rows();
+    k = std::max(0, k);
+
+    PackedInt32Array indices;
+    PackedFloat64Array best;
+    indices.resize(static_cast<int64_t>(num_queries) * k);
+    best.resize(static_cast<int64_t>(num_queries) * k);
+    indices.fill(-1);
+    best.fill(0.0);
+
+    // Valid queries become the columns of Ψ
+    std::vector<int> valid;
+    valid.reserve(num_queries);
+    for (int q = 0; q < num_queries; q++) {
+        const Variant v = states[q];
+        if (count > 0 && v.get_type() == Variant::PACKED_FLOAT64_ARRAY &&
+            static_cast<PackedFloat64Array>(v).size() == dim * 2) {
+            valid.push_back(q);
+        }
+    }
+    const int kept = std::min(k, count);
+    if (!valid.empty() && kept > 0) {
+        Eigen::MatrixXcd queries(dim, static_cast<int64_t>(valid.size()));
+        for (size_t c = 0; c < valid.size(); c++) {
+            const PackedFloat64Array state = states[valid[c]];
+            queries.col(c) = map_state(state);
+        }
+        // Every fidelity of every query from one product: |Rᴴ·Ψ|²
+        const Eigen::MatrixXd fidelities = (m_states.adjoint() * queries).cwiseAbs2();
+
+        int32_t* index_ptr = indices.ptrw();
+        double* best_ptr = best.ptrw();
+        auto query_range = [&](int begin, int end) {
+            std::vector<int> order;
+            for (int c = begin; c < end; c++) {
+                const double* column = fidelities.col(c).data();
+                select_best(column, count, kept, order);
+                const int64_t row = static_cast<int64_t>(valid[c]) * k;
+                for (int j = 0; j < kept; j++) {
+                    index_ptr[row + j] = order[j];
+                    best_ptr[row + j] = column[order[j]];
+                }
+            }
+        };
+        const int num_valid = static_cast<int>(valid.size());
+        if (static_cast<int64_t>(num_valid) * count * dim >= BATCH_PARALLEL_MIN_WORK) {
+            NativeThreadPool::shared().parallel_for(0, num_valid, 0, query_range);
+        } else {
+            query_range(0, num_valid);
+        }
+    }
+
+    result["indices"] = indices;
+    result["fidelities"] = best;
+    return result;
+}
@@ -0,0 +1,72 @@
+#ifndef REFERENCE_STATE_LIBRARY_H
+#define REFERENCE_STATE_LIBRARY_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+
+#include <Eigen/Dense>
+
+namespace godot {
+
+/**
+ * ReferenceStateLibrary - Registered target states for cos² matching
+ *
+ * Quest and recipe matching score a state against many targets. Instead of
+ * one QuantumEvolutionEngine.compute_cos2_similarity call per target, the
+ * targets are registered once as the columns of a complex matrix R
+ * (dim × count), so every fidelity |⟨r_i|ψ⟩|² of a query comes from one
+ * matrix-vector product Rᴴψ, and the best k are picked with a partial heap
+ * sort. best_matches_batch stacks many query states (e.g. one per biome) and
+ * scores them all with one matrix product, heap selection split across the
+ * shared native pool.
+ *
+ * States use the packed [re0, im0, re1, im1, ...] format. Fidelities are
+ * raw |⟨r|ψ⟩|², as compute_cos2_similarity (normalize inputs for cos²).
+ *
+ *   var library := ReferenceStateLibrary.new()
+ *   library.set_states(recipe_vectors, 16)
+ *   var top := library.best_matches(engine.compute_dominant_eigenvector(rho), 3)
+ */
+class ReferenceStateLibrary : public RefCounted {
+    GDCLASS(ReferenceStateLibrary, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    // Replace the library: packed_states holds count·dim complex values,
+    // state i at [2·dim·i, 2·dim·(i+1)). False (library unchanged) on a size
+    // that isn't a whole number of states.
+    bool set_states(const PackedFloat64Array& packed_states, int dim);
+    // Append one state; returns its index, or -1 if its dimension differs
+    // from the library's (the first state of an empty library sets it)
+    int add_state(const PackedFloat64Array& state);
+    void clear();
+    int get_count() const;
+    int get_dimension() const;  // 0 while empty
+    PackedFloat64Array get_state(int index) const;
+
+    // |⟨r_i|ψ⟩|² for every registered state, in index order (empty on a
+    // dimension mismatch)
+    PackedFloat64Array compute_fidelities(const PackedFloat64Array& state) const;
+
+    // The k best matches, highest fidelity first:
+    //   "indices": PackedInt32Array, "fidelities": PackedFloat64Array
+    // (min(k, count) entries; empty on a dimension mismatch)
+    Dictionary best_matches(const PackedFloat64Array& state, int k) const;
+
+    // best_matches for many states at once, one product for all of them.
+    // Entry q·k + j is query q's j-th best match; rows of invalid queries
+    // (wrong type or dimension) and slots past count are index -1, fidelity 0.
+    Dictionary best_matches_batch(const Array& states, int k) const;
+
+private:
+    Eigen::MatrixXcd m_states;  // dim × count, one reference state per column
+};
+
+}  // namespace godot
+
+#endif  // REFERENCE_STATE_LIBRARY_H
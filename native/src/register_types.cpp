@@ -2,9 +2,18 @@
 #include "quantum_matrix_native.h"
 #include "quantum_evolution_engine.h"        // RE-ENABLED: Pure CPU Eigen code
 #include "multi_biome_lookahead_engine.h"    // RE-ENABLED: Pure CPU Eigen code
+#include "world_batch.h"                     // Many headless worlds stepped per call
+#include "emoji_registry.h"                  // Interned emoji String <-> int ids
+#include "reference_state_library.h"         // Registered target states for cos² matching
+#include "quantum_trajectory_engine.h"       // NEW: Monte Carlo wavefunction engine (large biomes)
 #include "force_graph_engine.h"              // NEW: Native force graph calculations
 // DISABLED: batched_bubble_renderer.h - BubbleAtlasBatcher.gd always used instead
 #include "parametric_selector_native.h"      // NEW: Fast parametric music selection (100× speedup)
+#include "native_thread_pool.h"              // Shared worker pool (joined on uninitialize)
+#include "native_worker_pool.h"              // GDScript settings + WorkerThreadPool executor
+#include "native_trace.h"                    // Trace-zone capture (make TRACE=1)
+#include "native_monitors.h"                 // Performance custom monitors (native counters)
+#include "simd_dispatch.h"                   // Per-ISA kernel tables (picked on initialize)
 
 // DISABLED HEADERS: GPU-dependent and dead code classes
 // #include "quantum_sparse_native.h"
@@ -22,12 +31,21 @@ void initialize_quantum_matrix_module(ModuleInitializationLevel p_level) {
         return;
     }
 
+    // Widest kernel variant this host supports (AVX-512 / AVX2 / baseline)
+    select_simd_isa();
+
     // Core CPU-based classes
     ClassDB::register_class<QuantumMatrixNative>();
 
     // RE-ENABLED: Pure CPU evolution engines (10-20× speedup via Eigen)
     ClassDB::register_class<QuantumEvolutionEngine>();
     ClassDB::register_class<MultiBiomeLookaheadEngine>();
+    ClassDB::register_class<WorldBatch>();
+    ClassDB::register_class<EmojiRegistry>();
+    ClassDB::register_class<ReferenceStateLibrary>();
+
+    // NEW: Quantum-trajectory ensemble for biomes beyond ~8 qubits
+    ClassDB::register_class<QuantumTrajectoryEngine>();
 
     // NEW: Native force graph calculations (3-5× speedup)
     ClassDB::register_class<ForceGraphEngine>();
@@ -38,6 +56,19 @@ void initialize_quantum_matrix_module(ModuleInitializationLevel p_level) {
     // NEW: Fast parametric selection for music Layer 4/5 (100× speedup over GDScript)
     ClassDB::register_class<ParametricSelectorNative>();
 
+    // Settings for the shared native worker pool (worker count, Godot pool)
+    ClassDB::register_class<NativeWorkerPool>();
+#ifdef __EMSCRIPTEN_PTHREADS__
+    // Each std::thread on the web takes a Web Worker from the page's
+    // pre-spawned pool, which Godot sizes for its own threads: share
+    // WorkerThreadPool instead of competing for it
+    NativeWorkerPool::set_use_godot_pool(true);
+#endif
+    ClassDB::register_class<NativeTrace>();
+
+    // Native work counters in the debugger's Monitors tab
+    register_native_monitors();
+
     // DISABLED: Causes crashes in WSL due to platform/GPU dependencies
     // - QuantumSolverCPUNative (replaced by integrated QuantumComputer._apply_phase_lnn)
     // - QuantumSparseMatrixNative (GPU-optimized)
@@ -48,6 +79,12 @@ void uninitialize_quantum_matrix_module(ModuleInitializationLevel p_level) {
     if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
         return;
     }
+
+    // Monitor callables point into this library: drop them before unload
+    unregister_native_monitors();
+
+    // Join pool workers before the library can be unloaded
+    NativeThreadPool::shutdown();
 }
 
 extern "C" {
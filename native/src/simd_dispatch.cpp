@@ -0,0 +1,114 @@
+#include "simd_dispatch.h"
+
+#include <atomic>
+#include <cstring>
+
+using namespace godot;
+
+namespace {
+
+std::atomic<const SimdKernels*> g_active{nullptr};
+std::atomic<int> g_active_isa{SIMD_BASELINE};
+
+bool host_supports(SimdIsa isa) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    switch (isa) {
+        case SIMD_AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+                   __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case SIMD_AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        default:
+            return true;
+    }
+#else
+    return isa == SIMD_BASELINE;
+#endif
+}
+
+const SimdKernels* table_for(SimdIsa isa) {
+    switch (isa) {
+        case SIMD_AVX512:
+            return simd_kernels_avx512();
+        case SIMD_AVX2:
+            return simd_kernels_avx2();
+        default:
+            return simd_kernels_baseline();
+    }
+}
+
+}  // namespace
+
+const SimdKernels& godot::simd_kernels() {
+    const SimdKernels* table = g_active.load(std::memory_order_acquire);
+    return table != nullptr ? *table : *simd_kernels_baseline();
+}
+
+SimdIsa godot::detect_simd_isa() {
+    for (int isa = SIMD_AVX512; isa > SIMD_BASELINE; isa--) {
+        if (table_for(static_cast<SimdIsa>(isa)) != nullptr && host_supports(static_cast<SimdIsa>(isa))) {
+            return static_cast<SimdIsa>(isa);
+        }
+    }
+    return SIMD_BASELINE;
+}
+
+SimdIsa godot::select_simd_isa(SimdIsa max_isa) {
+    SimdIsa isa = detect_simd_isa();
+    if (isa > max_isa) {
+        isa = max_isa;
+    }
+    // A capped ISA may not be built here; fall back until one is
+    while (isa > SIMD_BASELINE && table_for(isa) == nullptr) {
+        isa = static_cast<SimdIsa>(isa - 1);
+    }
+    g_active.store(table_for(isa), std::memory_order_release);
+    g_active_isa.store(isa);
+    return isa;
+}
+
+SimdIsa godot::active_simd_isa() {
+    return static_cast<SimdIsa>(g_active_isa.load());
+}
+
+const char* godot::simd_isa_name(SimdIsa isa) {
+    switch (isa) {
+        case SIMD_AVX512:
+            return "avx512";
+        case SIMD_AVX2:
+            return "avx2";
+        default:
+#ifdef __wasm_simd128__
+            return "wasm-simd128";  // The baseline, auto-vectorized (make web)
+#else
+            return "baseline";
+#endif
+    }
+}
+
+bool godot::simd_isa_available(SimdIsa isa) {
+    return isa >= SIMD_BASELINE && isa <= SIMD_AVX512 && table_for(isa) != nullptr && host_supports(isa);
+}
+
+bool godot::force_simd_isa(SimdIsa isa) {
+    if (!simd_isa_available(isa)) {
+        return false;
+    }
+    g_active.store(table_for(isa), std::memory_order_release);
+    g_active_isa.store(isa);
+    return true;
+}
+
+bool godot::simd_isa_from_name(const char* name, SimdIsa* isa) {
+    for (int i = SIMD_BASELINE; i <= SIMD_AVX512; i++) {
+        if (std::strcmp(name, simd_isa_name(static_cast<SimdIsa>(i))) == 0) {
+            *isa = static_cast<SimdIsa>(i);
+            return true;
+        }
+    }
+    if (std::strcmp(name, "baseline") == 0) {
+        *isa = SIMD_BASELINE;  // Also accepted where the baseline has another name
+        return true;
+    }
+    return false;
+}
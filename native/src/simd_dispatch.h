@@ -0,0 +1,63 @@
+#ifndef SIMD_DISPATCH_H
+#define SIMD_DISPATCH_H
+
+#include <cstdint>
+
+namespace godot {
+
+/**
+ * SimdKernels - Hot inner loops compiled once per instruction set
+ *
+ * The library is built for baseline x86-64 (SSE2). The loops below are also
+ * compiled into AVX2+FMA and AVX-512 translation units (simd_kernels_*.cpp,
+ * with their own -m flags from the Makefile), and select_simd_isa() picks the
+ * widest variant the host supports when the module initializes. Every
+ * variant accumulates in the same fixed lane order and FP contraction is off
+ * in ISO C++ mode, so all of them return bit-identical results.
+ *
+ * The web build (make web) compiles everything with -msimd128, so there the
+ * baseline table is the WASM SIMD one and the x86 variants are nullptr.
+ *
+ * Eigen's own kernels stay at the baseline ISA: instantiating them under
+ * several -m flags in one library would give the linker differently compiled
+ * copies of the same inline symbols to choose from.
+ */
+struct SimdKernels {
+    // out[r] = Σ_k rows[r·stride + k]·q[k], r < count, k < dim (row-major scores)
+    void (*gemv_f32)(const float* rows, int count, int dim, int64_t stride, const float* q, float* out);
+    // Σ |z_k|² over n interleaved complex<double> values
+    double (*norm_sq_c64)(const double* z, int64_t n);
+    // y += a·x over n interleaved complex<double> values, real a
+    void (*axpy_c64)(double a, const double* x, double* y, int64_t n);
+};
+
+enum SimdIsa {
+    SIMD_BASELINE = 0,
+    SIMD_AVX2 = 1,
+    SIMD_AVX512 = 2
+};
+
+// Active table (the baseline one until select_simd_isa runs)
+const SimdKernels& simd_kernels();
+// Widest ISA both the host and this build support
+SimdIsa detect_simd_isa();
+// Switch the active table to the widest supported ISA up to max_isa
+SimdIsa select_simd_isa(SimdIsa max_isa = SIMD_AVX512);
+SimdIsa active_simd_isa();
+const char* simd_isa_name(SimdIsa isa);
+// Built for this target and supported by the host
+bool simd_isa_available(SimdIsa isa);
+// Switch to exactly isa (A/B testing); false, table unchanged, if unavailable
+bool force_simd_isa(SimdIsa isa);
+// Inverse of simd_isa_name ("baseline", "avx2", "avx512"; "wasm-simd128" is
+// the baseline); false for an unknown name
+bool simd_isa_from_name(const char* name, SimdIsa* isa);
+
+// Per-ISA tables (nullptr when the variant is not built for this target)
+const SimdKernels* simd_kernels_baseline();
+const SimdKernels* simd_kernels_avx2();
+const SimdKernels* simd_kernels_avx512();
+
+}  // namespace godot
+
+#endif  // SIMD_DISPATCH_H
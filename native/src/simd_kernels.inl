@@ -0,0 +1,72 @@
+// Kernel bodies shared by simd_kernels_*.cpp: each includes this file once
+// with SIMD_NS set to its own namespace, so every ISA gets distinct symbols.
+// Plain loops over raw pointers only: an inline library template used here
+// would be emitted under this TU's -m flags and could be picked by the
+// linker for baseline callers.
+
+namespace godot {
+namespace SIMD_NS {
+namespace {
+
+// Fixed lane counts: wide enough for one AVX-512 register of each type, and
+// the same partial-sum order whichever ISA vectorizes them
+constexpr int F32_LANES = 16;
+constexpr int F64_LANES = 8;
+
+void gemv_f32(const float* rows, int count, int dim, int64_t stride, const float* q, float* out) {
+    for (int r = 0; r < count; r++) {
+        const float* row = rows + r * stride;
+        float acc[F32_LANES] = {};
+        int k = 0;
+        for (; k + F32_LANES <= dim; k += F32_LANES) {
+            for (int l = 0; l < F32_LANES; l++) {
+                acc[l] += row[k + l] * q[k + l];
+            }
+        }
+        float tail = 0.0f;
+        for (; k < dim; k++) {
+            tail += row[k] * q[k];
+        }
+        for (int width = F32_LANES / 2; width > 0; width /= 2) {
+            for (int l = 0; l < width; l++) {
+                acc[l] += acc[l + width];
+            }
+        }
+        out[r] = acc[0] + tail;
+    }
+}
+
+double norm_sq_c64(const double* z, int64_t n) {
+    const int64_t count = 2 * n;
+    double acc[F64_LANES] = {};
+    int64_t k = 0;
+    for (; k + F64_LANES <= count; k += F64_LANES) {
+        for (int l = 0; l < F64_LANES; l++) {
+            acc[l] += z[k + l] * z[k + l];
+        }
+    }
+    double tail = 0.0;
+    for (; k < count; k++) {
+        tail += z[k] * z[k];
+    }
+    for (int width = F64_LANES / 2; width > 0; width /= 2) {
+        for (int l = 0; l < width; l++) {
+            acc[l] += acc[l + width];
+        }
+    }
+    return acc[0] + tail;
+}
+
+void axpy_c64(double a, const double* x, double* y, int64_t n) {
+    const int64_t count = 2 * n;
+    for (int64_t k = 0; k < count; k++) {
+        y[k] += a * x[k];
+    }
+}
+
+}  // namespace
+
+const SimdKernels TABLE = {gemv_f32, norm_sq_c64, axpy_c64};
+
+}  // namespace SIMD_NS
+}  // namespace godot
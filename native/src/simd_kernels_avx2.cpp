@@ -0,0 +1,20 @@
+// Built with -mavx2 -mfma (see the Makefile); selected at load time only on
+// hosts that support it
+#include "simd_dispatch.h"
+
+#if defined(__AVX2__)
+
+#define SIMD_NS simd_avx2
+#include "simd_kernels.inl"
+
+const godot::SimdKernels* godot::simd_kernels_avx2() {
+    return &simd_avx2::TABLE;
+}
+
+#else
+
+const godot::SimdKernels* godot::simd_kernels_avx2() {
+    return nullptr;  // Not an x86 build (or built without the ISA flags)
+}
+
+#endif
@@ -0,0 +1,20 @@
+// Built with -mavx512f -mavx512vl -mavx2 -mfma (see the Makefile); selected
+// at load time only on hosts that support it
+#include "simd_dispatch.h"
+
+#if defined(__AVX512F__)
+
+#define SIMD_NS simd_avx512
+#include "simd_kernels.inl"
+
+const godot::SimdKernels* godot::simd_kernels_avx512() {
+    return &simd_avx512::TABLE;
+}
+
+#else
+
+const godot::SimdKernels* godot::simd_kernels_avx512() {
+    return nullptr;  // Not an x86 build (or built without the ISA flags)
+}
+
+#endif
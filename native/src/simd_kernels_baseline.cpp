@@ -0,0 +1,8 @@
+#include "simd_dispatch.h"
+
+#define SIMD_NS simd_baseline
+#include "simd_kernels.inl"
+
+const godot::SimdKernels* godot::simd_kernels_baseline() {
+    return &simd_baseline::TABLE;
+}
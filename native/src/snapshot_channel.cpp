@@ -0,0 +1,111 @@
+#include "snapshot_channel.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace godot;
+
+void SnapshotChannel::set_capacity(int frames) {
+    frames = std::max(0, frames);
+    const size_t slot_bytes = m_current ? m_current->slot_bytes : 0;
+    m_capacity = frames;
+    if (frames == 0) {
+        install(nullptr);
+        return;
+    }
+
+    std::unique_ptr<Storage> storage(new Storage());
+    storage->slot_count = frames;
+    storage->slot_bytes = slot_bytes;
+    storage->slots.reset(new Slot[frames]);
+    storage->bytes.resize(static_cast<size_t>(frames) * slot_bytes);
+    install(std::move(storage));
+}
+
+void SnapshotChannel::grow(size_t frame_bytes) {
+    std::unique_ptr<Storage> storage(new Storage());
+    storage->slot_count = m_capacity;
+    storage->slot_bytes = std::max(frame_bytes, m_current ? m_current->slot_bytes * 2 : 0);
+    storage->slots.reset(new Slot[m_capacity]);
+    storage->bytes.resize(static_cast<size_t>(m_capacity) * storage->slot_bytes);
+    install(std::move(storage));
+}
+
+void SnapshotChannel::install(std::unique_ptr<Storage> storage) {
+    // seq_cst against read(): a reader counted after reclaim_retired's check
+    // loads the new pointer, so it can't be holding a retired one
+    m_storage.store(storage.get(), std::memory_order_seq_cst);
+    if (m_current) {
+        m_retired.push_back(std::move(m_current));
+    }
+    m_current = std::move(storage);
+    reclaim_retired();
+}
+
+void SnapshotChannel::reclaim_retired() {
+    if (!m_retired.empty() && m_readers.load(std::memory_order_seq_cst) == 0) {
+        m_retired.clear();
+    }
+}
+
+uint64_t SnapshotChannel::publish(const uint8_t* data, size_t size) {
+    if (m_capacity <= 0) {
+        return 0;
+    }
+    reclaim_retired();
+    Storage* storage = m_storage.load(std::memory_order_relaxed);
+    if (!storage || size > storage->slot_bytes) {
+        grow(size);
+        storage = m_storage.load(std::memory_order_relaxed);
+    }
+
+    const uint64_t seq = m_next++;
+    const size_t index = static_cast<size_t>(seq % storage->slot_count);
+    Slot& slot = storage->slots[index];
+
+    slot.lock.store(seq * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);  // Odd word visible before the bytes change
+    std::memcpy(storage->bytes.data() + index * storage->slot_bytes, data, size);
+    slot.size.store(size, std::memory_order_relaxed);
+    slot.lock.store(seq * 2, std::memory_order_release);
+
+    m_latest.store(seq, std::memory_order_release);
+    return seq;
+}
+
+bool SnapshotChannel::read(uint64_t sequence, std::vector<uint8_t>& out) const {
+    // Counted before the storage load: the producer frees nothing while this is nonzero
+    m_readers.fetch_add(1, std::memory_order_seq_cst);
+    const Storage* storage = m_storage.load(std::memory_order_seq_cst);
+    bool ok = false;
+    if (storage && sequence != 0 && storage->slot_count > 0) {
+        const size_t index = static_cast<size_t>(sequence % storage->slot_count);
+        const Slot& slot = storage->slots[index];
+
+        const uint64_t before = slot.lock.load(std::memory_order_acquire);
+        if (before == sequence * 2) {
+            const size_t size = std::min(slot.size.load(std::memory_order_relaxed), storage->slot_bytes);
+            out.resize(size);
+            std::memcpy(out.data(), storage->bytes.data() + index * storage->slot_bytes, size);
+            std::atomic_thread_fence(std::memory_order_acquire);  // Copy completes before the recheck
+            ok = slot.lock.load(std::memory_order_relaxed) == before;
+        }
+    }
+    m_readers.fetch_sub(1, std::memory_order_release);
+    return ok;
+}
+
+uint64_t SnapshotChannel::read_latest(std::vector<uint8_t>& out) const {
+    // A failed read means the producer lapped us; the newer frame is just as good
+    for (int attempt = 0; attempt < 4; attempt++) {
+        const uint64_t seq = latest_sequence();
+        if (seq == 0) {
+            return 0;
+        }
+        if (read(seq, out)) {
+            return seq;
+        }
+    }
+    out.clear();
+    return 0;
+}
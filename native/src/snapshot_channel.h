@@ -0,0 +1,93 @@
+#ifndef SNAPSHOT_CHANNEL_H
+#define SNAPSHOT_CHANNEL_H
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace godot {
+
+/**
+ * SnapshotChannel - Single-producer / multi-consumer ring of byte frames
+ *
+ * The producer publishes numbered frames (1, 2, 3, ...) into a fixed ring of
+ * slots; frame seq lives in slot seq % capacity until it is lapped. Each slot
+ * carries a seqlock word (odd while being written), so readers never block
+ * the producer or each other: a read copies the slot and succeeds only if
+ * the word was unchanged across the copy.
+ *
+ * Slots are sized to the largest frame seen. A frame that doesn't fit moves
+ * the ring to larger storage (as does set_capacity). The old storage is
+ * retired rather than freed, since a reader may still be copying out of it.
+ * Every read() is counted in m_readers for as long as it touches a storage,
+ * and the producer frees the retired storages at the next publish() or
+ * set_capacity() that sees no read in flight. A reader that starts after
+ * the swap always loads the new storage, so reads that are still running
+ * are the only ones that can hold a retired one. Reads are a single copy,
+ * so retired storage lasts a frame or so, not the channel's lifetime.
+ *
+ * publish() and set_capacity() must be serialized by the owner (one producer);
+ * latest_sequence() and read() are safe from any thread at any time.
+ */
+class SnapshotChannel {
+public:
+    SnapshotChannel() = default;
+
+    // Frames kept before the oldest is overwritten (0 disables the channel).
+    // Drops every buffered frame; sequence numbers keep counting.
+    void set_capacity(int frames);
+    int capacity() const { return m_capacity; }
+    bool enabled() const { return m_capacity > 0; }
+
+    // Copy `size` bytes in as the next frame; returns its sequence (0 if disabled)
+    uint64_t publish(const uint8_t* data, size_t size);
+
+    // Sequence the next publish() will assign (producer side)
+    uint64_t next_sequence() const { return m_next; }
+
+    // Sequence of the newest complete frame (0 before the first publish)
+    uint64_t latest_sequence() const { return m_latest.load(std::memory_order_acquire); }
+
+    // Copy frame `sequence` into out; false if it was lapped, never published,
+    // or is being rewritten right now
+    bool read(uint64_t sequence, std::vector<uint8_t>& out) const;
+
+    // Newest frame (retries if the producer laps the reader mid-copy);
+    // returns its sequence, 0 if nothing could be read
+    uint64_t read_latest(std::vector<uint8_t>& out) const;
+
+private:
+    SnapshotChannel(const SnapshotChannel&) = delete;
+    SnapshotChannel& operator=(const SnapshotChannel&) = delete;
+
+    struct Slot {
+        std::atomic<uint64_t> lock{0};  // 2·seq when complete, 2·seq + 1 while writing
+        std::atomic<size_t> size{0};
+    };
+    struct Storage {
+        int slot_count = 0;
+        size_t slot_bytes = 0;
+        std::unique_ptr<Slot[]> slots;
+        std::vector<uint8_t> bytes;  // slot_count · slot_bytes
+    };
+
+    void grow(size_t frame_bytes);
+    // Make storage (possibly null) current and retire the previous one
+    void install(std::unique_ptr<Storage> storage);
+    // Free retired storages if no read() is in flight (producer side)
+    void reclaim_retired();
+
+    int m_capacity = 0;
+    uint64_t m_next = 1;                     // Producer-only
+    std::atomic<uint64_t> m_latest{0};
+    std::atomic<Storage*> m_storage{nullptr};
+    std::unique_ptr<Storage> m_current;                // Owns *m_storage
+    std::vector<std::unique_ptr<Storage>> m_retired;  // Swapped out, possibly still being read
+    mutable std::atomic<int> m_readers{0};            // read() calls between storage load and last copy
+};
+
+}  // namespace godot
+
+#endif  // SNAPSHOT_CHANNEL_H
@@ -0,0 +1,92 @@
+#include "telemetry_ring.h"
+
+#include <atomic>
+#include <cstring>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define TELEMETRY_RING_MMAP 1
+#endif
+
+using namespace godot;
+
+namespace {
+
+constexpr size_t NEXT_FRAME_OFFSET = 16;
+
+// Lock-free 64-bit atomics are address-free, so they work on shared pages
+std::atomic<uint64_t>* atomic_at(uint8_t* base, size_t offset) {
+    return reinterpret_cast<std::atomic<uint64_t>*>(base + offset);
+}
+
+}  // namespace
+
+bool TelemetryRing::open(const std::string& path, int capacity) {
+    close();
+    m_error.clear();
+    if (capacity < 1) {
+        m_error = "capacity must be at least 1";
+        return false;
+    }
+#ifdef TELEMETRY_RING_MMAP
+    const size_t bytes = HEADER_BYTES + static_cast<size_t>(capacity) * SLOT_BYTES;
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        m_error = std::string("cannot open ") + path + ": " + std::strerror(errno);
+        return false;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        m_error = std::string("cannot size ") + path + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping keeps the file
+    if (mapping == MAP_FAILED) {
+        m_error = std::string("cannot map ") + path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    m_base = static_cast<uint8_t*>(mapping);
+    m_bytes = bytes;
+    m_capacity = static_cast<uint32_t>(capacity);
+    m_next = 1;
+    const uint32_t header[4] = {MAGIC, VERSION, static_cast<uint32_t>(sizeof(FrameTelemetry)), m_capacity};
+    std::memcpy(m_base, header, sizeof(header));
+    atomic_at(m_base, NEXT_FRAME_OFFSET)->store(m_next, std::memory_order_release);
+    return true;
+#else
+    (void)path;
+    m_error = "memory-mapped telemetry is not supported on this platform";
+    return false;
+#endif
+}
+
+void TelemetryRing::close() {
+#ifdef TELEMETRY_RING_MMAP
+    if (m_base != nullptr) {
+        ::munmap(m_base, m_bytes);
+    }
+#endif
+    m_base = nullptr;
+    m_bytes = 0;
+    m_capacity = 0;
+}
+
+void TelemetryRing::write(FrameTelemetry record) {
+    if (m_base == nullptr) {
+        return;
+    }
+    const uint64_t frame = m_next++;
+    record.frame = frame;
+    uint8_t* slot = m_base + HEADER_BYTES + static_cast<size_t>(frame % m_capacity) * SLOT_BYTES;
+    std::atomic<uint64_t>* lock = atomic_at(slot, 0);
+    lock->store(2 * frame + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(slot + 8, &record, sizeof(record));
+    lock->store(2 * frame + 2, std::memory_order_release);
+    atomic_at(m_base, NEXT_FRAME_OFFSET)->store(m_next, std::memory_order_release);
+}
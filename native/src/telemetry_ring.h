@@ -0,0 +1,82 @@
+#ifndef TELEMETRY_RING_H
+#define TELEMETRY_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace godot {
+
+// One lookahead call as written to the telemetry ring (little-endian, 80 bytes)
+struct FrameTelemetry {
+    uint64_t frame = 0;         // 1, 2, 3, ... since the ring was opened
+    uint64_t timestamp_ns = 0;  // steady_clock at the start of the call
+    double total_ms = 0.0;      // Whole call, marshalling included
+    double evolve_ms = 0.0;     // Evolution and observables (what the governor sees)
+    double batched_ms = 0.0;    // Equal-dimension batched kernel (part of evolve_ms)
+    double marshal_ms = 0.0;    // Result assembly
+    double governor_ms = 0.0;   // Governor's smoothed call time
+    int32_t steps = 0;          // After any governor halving
+    int32_t biomes = 0;
+    int32_t active_biomes = 0;
+    int32_t governor_level = 0;
+    int32_t mi_candidates = 0;  // Adaptive MI candidates summed over active biomes
+    int32_t reserved = 0;
+};
+static_assert(sizeof(FrameTelemetry) == 80, "FrameTelemetry is a file format");
+
+/**
+ * TelemetryRing - Memory-mapped ring of per-frame records for soak tests
+ *
+ * The file is the ring, so an external tool can map (or just re-read) it
+ * while the game runs, with no GDScript involved:
+ *
+ *   header (64 bytes): u32 magic 'SWTL' (0x4C545753), u32 version (1),
+ *                      u32 record bytes (80), u32 capacity,
+ *                      u64 next frame (frames 1 .. next - 1 written), zeros
+ *   slot i (88 bytes each, from offset 64): u64 lock, FrameTelemetry
+ *
+ * Frame f lives in slot f % capacity until it is lapped. The lock is a
+ * seqlock word, 2f + 1 while frame f is being written and 2f + 2 once it
+ * is complete: a reader copies the slot and keeps the copy only if the lock
+ * read 2f + 2 both before and after.
+ *
+ * write() is one memcpy into the mapping plus three stores, well under a
+ * microsecond; the kernel flushes pages on its own schedule. One writer
+ * (the owner serializes it). POSIX desktop only: open() fails elsewhere,
+ * including the web build.
+ */
+class TelemetryRing {
+public:
+    static constexpr uint32_t MAGIC = 0x4C545753;  // "SWTL" read little-endian
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t HEADER_BYTES = 64;
+    static constexpr size_t SLOT_BYTES = 8 + sizeof(FrameTelemetry);
+
+    TelemetryRing() = default;
+    ~TelemetryRing() { close(); }
+
+    // Creates / truncates the file and maps it; false (error set) on failure
+    bool open(const std::string& path, int capacity);
+    void close();
+    bool is_open() const { return m_base != nullptr; }
+    const std::string& error() const { return m_error; }
+
+    // Stamps record.frame and appends it
+    void write(FrameTelemetry record);
+    uint64_t frames_written() const { return m_next - 1; }
+
+private:
+    TelemetryRing(const TelemetryRing&) = delete;
+    TelemetryRing& operator=(const TelemetryRing&) = delete;
+
+    uint8_t* m_base = nullptr;
+    size_t m_bytes = 0;
+    uint32_t m_capacity = 0;
+    uint64_t m_next = 1;
+    std::string m_error;
+};
+
+}  // namespace godot
+
+#endif  // TELEMETRY_RING_H
@@ -0,0 +1,164 @@
+#include "trace_zones.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace godot;
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    int64_t id;
+    uint64_t start_ns;
+    uint64_t dur_ns;
+};
+
+// One per thread that has recorded; owned by the registry so events survive
+// the thread
+struct ThreadBuffer {
+    std::mutex mutex;
+    uint32_t tid = 0;
+    std::vector<TraceEvent> events;
+    uint64_t dropped = 0;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::atomic<bool> capturing{false};
+    std::atomic<int> max_events{0};
+    uint64_t origin_ns = 0;  // Capture start: timestamps are exported relative to it
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+ThreadBuffer& thread_buffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffer->tid = static_cast<uint32_t>(reg.buffers.size()) + 1;
+        reg.buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void append_escaped(std::string& out, const char* text) {
+    for (const char* c = text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            out += '\\';
+        }
+        out += *c;
+    }
+}
+
+}  // namespace
+
+bool TraceRecorder::compiled_in() {
+#ifdef SPACEWHEAT_TRACE_ZONES
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t TraceRecorder::now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void TraceRecorder::start(int max_events_per_thread) {
+    clear();
+    Registry& reg = registry();
+    reg.max_events.store(std::max(1, max_events_per_thread));
+    reg.origin_ns = now_ns();
+    reg.capturing.store(true);
+}
+
+void TraceRecorder::stop() {
+    registry().capturing.store(false);
+}
+
+bool TraceRecorder::capturing() {
+    return registry().capturing.load(std::memory_order_relaxed);
+}
+
+void TraceRecorder::clear() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        buffer->events.clear();
+        buffer->events.shrink_to_fit();
+        buffer->dropped = 0;
+    }
+}
+
+void TraceRecorder::record(const char* name, int64_t id, uint64_t start_ns, uint64_t end_ns) {
+    ThreadBuffer& buffer = thread_buffer();
+    const size_t cap = static_cast<size_t>(registry().max_events.load(std::memory_order_relaxed));
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.events.size() >= cap) {
+        buffer.dropped++;
+        return;
+    }
+    buffer.events.push_back({name, id, start_ns, end_ns - start_ns});
+}
+
+uint64_t TraceRecorder::event_count() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    uint64_t count = 0;
+    for (const auto& buffer : reg.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        count += buffer->events.size();
+    }
+    return count;
+}
+
+uint64_t TraceRecorder::dropped_count() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    uint64_t count = 0;
+    for (const auto& buffer : reg.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        count += buffer->dropped;
+    }
+    return count;
+}
+
+std::string TraceRecorder::chrome_json() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    char number[96];
+    for (const auto& buffer : reg.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        for (const TraceEvent& e : buffer->events) {
+            out += first ? "{\"name\":\"" : ",\n{\"name\":\"";
+            first = false;
+            append_escaped(out, e.name);
+            const double ts = static_cast<double>(e.start_ns - std::min(e.start_ns, reg.origin_ns)) / 1000.0;
+            std::snprintf(number, sizeof(number), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                          buffer->tid, ts, static_cast<double>(e.dur_ns) / 1000.0);
+            out += number;
+            if (e.id >= 0) {
+                std::snprintf(number, sizeof(number), ",\"args\":{\"id\":%lld}", static_cast<long long>(e.id));
+                out += number;
+            }
+            out += '}';
+        }
+    }
+    out += "]}\n";
+    return out;
+}
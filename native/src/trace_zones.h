@@ -0,0 +1,79 @@
+#ifndef TRACE_ZONES_H
+#define TRACE_ZONES_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace godot {
+
+/**
+ * TraceRecorder / TraceZone - Optional per-stage timeline for external profilers
+ *
+ * NATIVE_TRACE_ZONE("name") opens a zone for the rest of the scope; while a
+ * capture is running each zone records (name, thread, start, duration), and
+ * chrome_json() exports the capture in Chrome trace event format (load it in
+ * chrome://tracing or Perfetto, or convert with Tracy's import-chrome). With
+ * a profiler attached this shows each stage of a call per thread, which the
+ * single opaque block in Godot's profiler can't.
+ *
+ * Zones are compiled in only with -DSPACEWHEAT_TRACE_ZONES (make TRACE=1);
+ * otherwise the macros expand to nothing and cost nothing. Each thread
+ * appends to its own buffer (uncontended lock), so zones wrap stages
+ * (a biome, a step, an evolve, an MI sweep), never inner loops. Names must
+ * be string literals (only the pointer is kept).
+ */
+class TraceRecorder {
+public:
+    static bool compiled_in();
+    // Clears previous events; each thread keeps at most max_events_per_thread
+    static void start(int max_events_per_thread);
+    static void stop();
+    static bool capturing();
+    static void clear();
+
+    static uint64_t event_count();
+    static uint64_t dropped_count();  // Events past a thread's cap
+    // {"traceEvents": [...]} with complete ("X") events, times in µs
+    static std::string chrome_json();
+
+    static uint64_t now_ns();
+    static void record(const char* name, int64_t id, uint64_t start_ns, uint64_t end_ns);
+};
+
+class TraceZone {
+public:
+    explicit TraceZone(const char* name, int64_t id = -1)
+        : m_name(TraceRecorder::capturing() ? name : nullptr), m_id(id),
+          m_start(m_name != nullptr ? TraceRecorder::now_ns() : 0) {}
+    ~TraceZone() {
+        if (m_name != nullptr) {
+            TraceRecorder::record(m_name, m_id, m_start, TraceRecorder::now_ns());
+        }
+    }
+
+private:
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+    const char* m_name;
+    int64_t m_id;
+    uint64_t m_start;
+};
+
+}  // namespace godot
+
+#define NATIVE_TRACE_CONCAT_INNER(a, b) a##b
+#define NATIVE_TRACE_CONCAT(a, b) NATIVE_TRACE_CONCAT_INNER(a, b)
+
+#ifdef SPACEWHEAT_TRACE_ZONES
+// Zone over the rest of the scope; the _ID form tags it (biome id, step)
+#define NATIVE_TRACE_ZONE(name) ::godot::TraceZone NATIVE_TRACE_CONCAT(trace_zone_, __LINE__)(name)
+#define NATIVE_TRACE_ZONE_ID(name, id) \
+    ::godot::TraceZone NATIVE_TRACE_CONCAT(trace_zone_, __LINE__)(name, static_cast<int64_t>(id))
+#else
+#define NATIVE_TRACE_ZONE(name) ((void)0)
+#define NATIVE_TRACE_ZONE_ID(name, id) ((void)0)
+#endif
+
+#endif  // TRACE_ZONES_H
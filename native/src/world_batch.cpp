@@ -0,0 +1,190 @@
+#include "world_batch.h"
+#include "native_thread_pool.h"
+#include "trace_zones.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+#include <algorithm>
+
+using namespace godot;
+
+namespace {
+
+// Concatenate one packed field of every world's result; offsets (one per
+// entry plus the end) are rebased onto the merged array
+template <typename PackedT>
+PackedT concat_worlds(const std::vector<Dictionary>& parts, const char* key, const char* offsets_key,
+                      PackedInt64Array& offsets) {
+    int64_t total = 0;
+    int64_t entries = 0;
+    for (const Dictionary& part : parts) {
+        total += PackedT(part[key]).size();
+        entries += std::max<int64_t>(PackedInt64Array(part[offsets_key]).size() - 1, 0);
+    }
+    PackedT flat;
+    flat.resize(total);
+    offsets.resize(entries + 1);
+    auto* dst = flat.ptrw();
+    int64_t* off = offsets.ptrw();
+    int64_t base = 0;
+    int64_t entry = 0;
+    for (const Dictionary& part : parts) {
+        const PackedT data = part[key];
+        const PackedInt64Array part_offsets = part[offsets_key];
+        for (int64_t i = 0; i + 1 < part_offsets.size(); i++) {
+            off[entry++] = base + part_offsets[i];
+        }
+        std::copy(data.ptr(), data.ptr() + data.size(), dst);
+        dst += data.size();
+        base += data.size();
+    }
+    off[entries] = base;
+    return flat;
+}
+
+// Visual fields arrive as PackedFloat32Array from worlds set to
+// OUTPUT_PRECISION_FLOAT; stay single precision only if every world does
+Variant concat_visual(const std::vector<Dictionary>& parts, const char* key, const char* offsets_key,
+                      PackedInt64Array& offsets) {
+    bool narrow = !parts.empty();
+    for (const Dictionary& part : parts) {
+        narrow = narrow && Variant(part[key]).get_type() == Variant::PACKED_FLOAT32_ARRAY;
+    }
+    if (narrow) {
+        return concat_worlds<PackedFloat32Array>(parts, key, offsets_key, offsets);
+    }
+    return concat_worlds<PackedFloat64Array>(parts, key, offsets_key, offsets);
+}
+
+}  // namespace
+
+void WorldBatch::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("add_world", "world"), &WorldBatch::add_world);
+    ClassDB::bind_method(D_METHOD("get_world", "world_id"), &WorldBatch::get_world);
+    ClassDB::bind_method(D_METHOD("get_world_count"), &WorldBatch::get_world_count);
+    ClassDB::bind_method(D_METHOD("clear_worlds"), &WorldBatch::clear_worlds);
+    ClassDB::bind_method(D_METHOD("step_worlds", "steps", "dt", "max_dt", "advance"),
+                         &WorldBatch::step_worlds, DEFVAL(true));
+}
+
+int WorldBatch::add_world(const Ref<MultiBiomeLookaheadEngine>& world) {
+    if (world.is_null()) {
+        UtilityFunctions::push_warning("WorldBatch: add_world needs a MultiBiomeLookaheadEngine");
+        return -1;
+    }
+    m_worlds.push_back(world);
+    return static_cast<int>(m_worlds.size()) - 1;
+}
+
+Ref<MultiBiomeLookaheadEngine> WorldBatch::get_world(int world_id) const {
+    if (world_id < 0 || world_id >= static_cast<int>(m_worlds.size())) {
+        UtilityFunctions::push_warning("WorldBatch: Invalid world_id ", world_id);
+        return Ref<MultiBiomeLookaheadEngine>();
+    }
+    return m_worlds[world_id];
+}
+
+int WorldBatch::get_world_count() const {
+    return static_cast<int>(m_worlds.size());
+}
+
+void WorldBatch::clear_worlds() {
+    m_worlds.clear();
+}
+
+Dictionary WorldBatch::step_worlds(int steps, float dt, float max_dt, bool advance) {
+    NATIVE_TRACE_ZONE("world_batch");
+    steps = std::max(steps, 0);
+    const int num_worlds = static_cast<int>(m_worlds.size());
+    std::vector<Dictionary> parts(num_worlds);
+
+    // One world per task: worlds share nothing, and the nested per-biome
+    // parallel_for inside each world runs inline on its task's thread
+    auto world_range = [&](int begin, int end) {
+        const Array from_resident;
+        for (int w = begin; w < end; w++) {
+            const Ref<MultiBiomeLookaheadEngine>& world = m_worlds[w];
+            Dictionary part = world->evolve_all_lookahead_packed(from_resident, steps, dt, max_dt);
+            if (advance && steps > 0) {
+                // Last produced state of each biome becomes its resident state
+                const PackedInt32Array counts = part["step_counts"];
+                const PackedFloat64Array rho = part["rho"];
+                const PackedInt64Array offsets = part["rho_offsets"];
+                for (int b = 0; b < counts.size(); b++) {
+                    if (counts[b] <= 0) {
+                        continue;
+                    }
+                    const int64_t entry = static_cast<int64_t>(b) * steps + counts[b] - 1;
+                    if (offsets[entry + 1] > offsets[entry]) {
+                        world->set_biome_rho(b, rho.slice(offsets[entry], offsets[entry + 1]));
+                    } else if (part.has("rho_deltas")) {
+                        // RHO_STORAGE_DELTA: the last state only exists as a delta chain
+                        const Array decoded = world->decode_rho_steps(part, b);
+                        const PackedFloat64Array last = decoded.is_empty() ? PackedFloat64Array() : PackedFloat64Array(decoded.back());
+                        if (!last.is_empty()) {
+                            world->set_biome_rho(b, last);
+                        }
+                    }
+                }
+            }
+            parts[w] = part;
+        }
+    };
+    NativeThreadPool::shared().parallel_for(0, num_worlds, num_worlds, world_range);
+
+    // Merge into one evolve_all_lookahead_packed layout over all biomes
+    PackedInt32Array world_biome_offsets;
+    world_biome_offsets.resize(num_worlds + 1);
+    PackedInt32Array step_counts;
+    PackedFloat64Array purity;
+    PackedFloat32Array purity_narrow;
+    bool narrow_purity = num_worlds > 0;
+    Array icon_maps;
+    int num_biomes = 0;
+    for (int w = 0; w < num_worlds; w++) {
+        world_biome_offsets.set(w, num_biomes);
+        const Dictionary& part = parts[w];
+        num_biomes += static_cast<int>(part.get("num_biomes", 0));
+        step_counts.append_array(part.get("step_counts", PackedInt32Array()));
+        const Variant part_purity = part.get("purity", PackedFloat64Array());
+        narrow_purity = narrow_purity && part_purity.get_type() == Variant::PACKED_FLOAT32_ARRAY;
+        purity.append_array(part_purity);
+        purity_narrow.append_array(part_purity);
+        icon_maps.append_array(part.get("icon_maps", Array()));
+    }
+    world_biome_offsets.set(num_worlds, num_biomes);
+
+    PackedInt64Array rho_offsets, mi_offsets, bloch_offsets, node_offsets, unused_offsets;
+    Dictionary result;
+    result["num_worlds"] = num_worlds;
+    result["world_biome_offsets"] = world_biome_offsets;
+    result["num_biomes"] = num_biomes;
+    result["steps"] = steps;
+    result["step_counts"] = step_counts;
+    result["rho"] = concat_worlds<PackedFloat64Array>(parts, "rho", "rho_offsets", rho_offsets);
+    result["rho_offsets"] = rho_offsets;
+    result["mi"] = concat_visual(parts, "mi", "mi_offsets", mi_offsets);
+    result["mi_offsets"] = mi_offsets;
+    result["bloch"] = concat_visual(parts, "bloch", "bloch_offsets", bloch_offsets);
+    result["bloch_offsets"] = bloch_offsets;
+    result["purity"] = narrow_purity ? Variant(purity_narrow) : Variant(purity);
+    result["positions"] = concat_worlds<PackedVector2Array>(parts, "positions", "node_offsets", node_offsets);
+    result["velocities"] = concat_worlds<PackedVector2Array>(parts, "velocities", "node_offsets", unused_offsets);
+    result["node_offsets"] = node_offsets;  // Velocities share the position layout
+    result["icon_maps"] = icon_maps;
+
+    // Delta-encoded ρ merges only when every world uses RHO_STORAGE_DELTA
+    bool all_deltas = num_worlds > 0;
+    PackedFloat64Array delta_scales;
+    for (const Dictionary& part : parts) {
+        all_deltas = all_deltas && part.has("rho_deltas");
+        delta_scales.append_array(part.get("rho_delta_scales", PackedFloat64Array()));
+    }
+    if (all_deltas) {
+        PackedInt64Array delta_offsets;
+        result["rho_deltas"] = concat_worlds<PackedByteArray>(parts, "rho_deltas", "rho_delta_offsets", delta_offsets);
+        result["rho_delta_offsets"] = delta_offsets;
+        result["rho_delta_scales"] = delta_scales;
+    }
+    return result;
+}
@@ -0,0 +1,64 @@
+#ifndef WORLD_BATCH_H
+#define WORLD_BATCH_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include "multi_biome_lookahead_engine.h"
+
+#include <vector>
+
+namespace godot {
+
+/**
+ * WorldBatch - Many independent farms stepped from one call
+ *
+ * Headless simulation and server-side validation hold one
+ * MultiBiomeLookaheadEngine per world (each with its biomes' resident
+ * states, see set_biome_rho). step_worlds advances every world on the
+ * shared native pool (one world per task; each world's own per-biome
+ * parallelism runs inline inside its task) and returns one flat packed
+ * result, so a process driving hundreds of farms makes one bridge call
+ * per tick instead of one per world.
+ *
+ *   var batch := WorldBatch.new()
+ *   for farm in farms: batch.add_world(farm.lookahead_engine)
+ *   var out := batch.step_worlds(4, 0.1, 0.02)
+ */
+class WorldBatch : public RefCounted {
+    GDCLASS(WorldBatch, RefCounted)
+
+protected:
+    static void _bind_methods();
+
+public:
+    /**
+     * Add a world (its resident biome states are what step_worlds evolves).
+     * @return World index, -1 if the engine is null
+     */
+    int add_world(const Ref<MultiBiomeLookaheadEngine>& world);
+    Ref<MultiBiomeLookaheadEngine> get_world(int world_id) const;
+    int get_world_count() const;
+    void clear_worlds();
+
+    /**
+     * Evolve every world's resident states steps·dt (evolve_all_lookahead_packed
+     * with an empty biome_rhos Array) and, with advance, make each biome's last
+     * produced state its new resident state (set_biome_rho).
+     *
+     * @return evolve_all_lookahead_packed layout over the concatenated biomes of
+     *         all worlds (global biome g = world_biome_offsets[w] + local id;
+     *         entry i = g·steps + step), plus:
+     *   "num_worlds": int
+     *   "world_biome_offsets": PackedInt32Array (W+1)
+     * "rho_deltas" (set_rho_storage) is merged only when every world uses
+     * RHO_STORAGE_DELTA.
+     */
+    Dictionary step_worlds(int steps, float dt, float max_dt, bool advance = true);
+
+private:
+    std::vector<Ref<MultiBiomeLookaheadEngine>> m_worlds;
+};
+
+}  // namespace godot
+
+#endif  // WORLD_BATCH_H